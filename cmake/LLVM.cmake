@@ -63,7 +63,7 @@ function(fetch_or_build_slang_llvm)
         find_package(LLVM 13.0 REQUIRED CONFIG)
         find_package(Clang REQUIRED CONFIG)
 
-        llvm_target_from_components(llvm-dep filecheck native orcjit)
+        llvm_target_from_components(llvm-dep filecheck native orcjit passes)
         clang_target_from_libs(
             clang-dep
             clangBasic
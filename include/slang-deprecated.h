@@ -502,6 +502,9 @@ extern "C"
 
     SLANG_API SlangReflectionType* spReflectionTypeLayout_GetType(SlangReflectionTypeLayout* type);
     SLANG_API SlangTypeKind spReflectionTypeLayout_getKind(SlangReflectionTypeLayout* type);
+    SLANG_API SlangUInt spReflectionTypeLayout_getFlattenedTree(
+        SlangReflectionTypeLayout* type,
+        SlangReflectionFlattenedTypeLayout* outTree);
     SLANG_API size_t spReflectionTypeLayout_GetSize(
         SlangReflectionTypeLayout* type,
         SlangParameterCategory category);
@@ -858,6 +861,13 @@ extern "C"
         SlangCompileRequest* request,
         ISlangBlob** outBlob);
 
+    /// Write the reflection information in the binary format of `slang-reflection-blob.h`.
+    SLANG_API SlangResult spReflection_ToBlob(SlangReflection* reflection, ISlangBlob** outBlob);
+
+    SLANG_API SlangUInt spReflection_getFlattenedBindings(
+        SlangReflection* reflection,
+        SlangReflectionFlattenedBindings* outBindings);
+
     SLANG_API unsigned spReflection_GetParameterCount(SlangReflection* reflection);
     SLANG_API SlangReflectionParameter* spReflection_GetParameterByIndex(
         SlangReflection* reflection,
@@ -874,6 +884,12 @@ extern "C"
     SLANG_API SlangReflectionType* spReflection_FindTypeByName(
         SlangReflection* reflection,
         char const* name);
+    /// Like `spReflection_FindTypeByName`, with the `spComputeStringHash` of `name`
+    /// computed ahead of time.
+    SLANG_API SlangReflectionType* spReflection_FindTypeByNameHashed(
+        SlangReflection* reflection,
+        char const* name,
+        SlangUInt32 nameHash);
     SLANG_API SlangReflectionTypeLayout* spReflection_GetTypeLayout(
         SlangReflection* reflection,
         SlangReflectionType* reflectionType,
@@ -882,6 +898,12 @@ extern "C"
     SLANG_API SlangReflectionFunction* spReflection_FindFunctionByName(
         SlangReflection* reflection,
         char const* name);
+    /// Like `spReflection_FindFunctionByName`, with the `spComputeStringHash` of `name`
+    /// computed ahead of time.
+    SLANG_API SlangReflectionFunction* spReflection_FindFunctionByNameHashed(
+        SlangReflection* reflection,
+        char const* name,
+        SlangUInt32 nameHash);
     SLANG_API SlangReflectionFunction* spReflection_FindFunctionByNameInType(
         SlangReflection* reflection,
         SlangReflectionType* reflType,
@@ -2063,6 +2063,9 @@ public:
         }                                                  \
     }
 
+// Command buffers may be submitted from several threads at once; on D3D12 and Vulkan a queue
+// serializes its submissions internally. A single submission may contain command buffers from any
+// number of transient heaps, and each of those heaps waits for it in `synchronizeAndReset()`.
 class ICommandQueue : public ISlangUnknown
 {
 public:
@@ -2109,6 +2112,9 @@ public:
         }                                                \
     }
 
+// A transient heap, and the command buffers created from it, must be used by one thread at a time.
+// To record command buffers in parallel on D3D12 and Vulkan, give each recording thread its own
+// transient heap; supporting device state such as pipeline specialization is shared safely.
 class ITransientResourceHeap : public ISlangUnknown
 {
 public:
@@ -2389,6 +2395,8 @@ public:
     struct ShaderCacheDesc
     {
         // The root directory for the shader cache. If not set, shader cache is disabled.
+        // The modules loaded from files through the device's session are also cached under
+        // this directory, so that loading them again skips parsing and checking.
         const char* shaderCachePath = nullptr;
         // The maximum number of entries stored in the cache. By default, there is no limit.
         GfxCount maxEntryCount = 0;
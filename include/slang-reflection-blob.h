@@ -0,0 +1,358 @@
+#ifndef SLANG_REFLECTION_BLOB_H
+#define SLANG_REFLECTION_BLOB_H
+
+/** \file slang-reflection-blob.h
+
+A flat binary encoding of the reflection information for a compiled program, and a reader for it.
+
+The blob is written by the compiler (see `-reflection-blob` and `ShaderReflection::toBlob`) and can
+be read in place, for example straight from a memory mapped file, without parsing, allocating or
+loading the Slang library. This header doesn't depend on `slang.h`.
+
+All values are little endian 32 bit integers. Records refer to each other by index into the
+tables listed in the `Header`, so the blob contains no pointers. Enumerated values (type kinds,
+parameter categories, stages and so on) use the numbering of the matching enums in `slang.h`.
+The version is increased whenever the layout of any record changes.
+*/
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+namespace slang
+{
+namespace ReflectionBlob
+{
+/// The first four bytes of a reflection blob, "SRFL".
+static const uint32_t kMagic = 0x4c465253;
+static const uint32_t kVersion = 1;
+
+/// Used for any index or string that isn't present.
+static const uint32_t kNone = 0xffffffff;
+/// Used for sizes and element counts that are unbounded.
+static const uint32_t kUnbounded = 0xffffffff;
+
+/// Byte offset of a zero terminated string in the string table, or `kNone`.
+typedef uint32_t StringRef;
+
+/// The `count` records starting at index `first` of one of the tables.
+struct Span
+{
+    uint32_t first;
+    uint32_t count;
+};
+
+/// The location of a table of `count` records, `offset` bytes from the start of the blob.
+struct Table
+{
+    uint32_t offset;
+    uint32_t count;
+};
+
+/// Where a variable is bound for one parameter category.
+struct Binding
+{
+    uint32_t category; ///< SlangParameterCategory
+    uint32_t offset;   ///< Register/binding index, or byte offset for uniform data
+    uint32_t space;    ///< Register space/descriptor set
+};
+
+/// How much of one parameter category a type layout uses.
+struct Size
+{
+    uint32_t category; ///< SlangParameterCategory
+    uint32_t size;     ///< May be `kUnbounded`
+};
+
+enum class AttributeArgKind : uint32_t
+{
+    Int,
+    Float,
+    String,
+};
+
+struct AttributeArg
+{
+    AttributeArgKind kind;
+    /// The bits of an `int32_t` or `float`, or a `StringRef`, depending on `kind`.
+    uint32_t value;
+};
+
+/// A user defined attribute.
+struct Attribute
+{
+    StringRef name;
+    Span args; ///< Into `Header::attributeArgs`
+};
+
+struct TypeLayout
+{
+    uint32_t kind; ///< SlangTypeKind
+    StringRef name;
+    uint32_t scalarType; ///< SlangScalarType
+    uint32_t rowCount;
+    uint32_t columnCount;
+    /// Element count of an array, which is `kUnbounded` for an unsized array.
+    uint32_t elementCount;
+    uint32_t resourceShape;     ///< SlangResourceShape
+    uint32_t resourceAccess;    ///< SlangResourceAccess
+    uint32_t parameterCategory; ///< SlangParameterCategory
+    uint32_t alignment;         ///< Uniform alignment in bytes
+    uint32_t stride;            ///< Uniform stride in bytes
+    /// Element of an array, vector, matrix, buffer or parameter group, into `typeLayouts`.
+    uint32_t elementTypeLayout;
+    /// Element and container of a parameter group, into `variables`.
+    uint32_t elementVariable;
+    uint32_t containerVariable;
+    Span sizes;      ///< Into `Header::sizes`
+    Span fields;     ///< Into `Header::variables`
+    Span attributes; ///< Into `Header::attributes`
+};
+
+/// A parameter, struct field or entry point result, with its layout.
+struct Variable
+{
+    StringRef name;
+    uint32_t typeLayout; ///< Into `Header::typeLayouts`
+    StringRef semanticName;
+    uint32_t semanticIndex;
+    uint32_t stage;  ///< SlangStage
+    Span bindings;   ///< Into `Header::bindings`
+    Span attributes; ///< Into `Header::attributes`
+};
+
+struct EntryPoint
+{
+    StringRef name;
+    StringRef nameOverride;
+    uint32_t stage; ///< SlangStage
+    uint32_t threadGroupSize[3];
+    uint32_t usesAnySampleRateInput;
+    uint32_t resultVariable; ///< Into `Header::variables`, or `kNone`
+    Span parameters;         ///< Into `Header::variables`
+    Span attributes;         ///< Into `Header::attributes`
+};
+
+struct HashedString
+{
+    StringRef string;
+    uint32_t hash;
+};
+
+struct Header
+{
+    uint32_t magic;   ///< kMagic
+    uint32_t version; ///< kVersion
+    uint32_t size;    ///< Size of the whole blob in bytes
+    Span parameters;  ///< The global parameters, into `variables`
+
+    Table strings; ///< Counted in bytes; the last byte is always zero
+    Table typeLayouts;
+    Table variables;
+    Table bindings;
+    Table sizes;
+    Table attributes;
+    Table attributeArgs;
+    Table entryPoints;
+    Table hashedStrings;
+};
+
+/// Reads a reflection blob in place.
+///
+/// The reader checks the header and the bounds of every table when it is set up, and every index
+/// when it is followed, so a truncated or corrupt blob produces null results instead of reading
+/// out of bounds.
+class Reader
+{
+public:
+    /// Set up the reader for the `size` bytes at `data`, which must be 4 byte aligned and stay
+    /// alive while the reader is used. Returns false if they are not a reflection blob of
+    /// this version.
+    bool init(const void* data, size_t size)
+    {
+        m_data = nullptr;
+        m_header = nullptr;
+
+        if (!data || (uintptr_t(data) & 3) != 0 || size < sizeof(Header))
+            return false;
+
+        const Header* header = (const Header*)data;
+        if (header->magic != kMagic || header->version != kVersion || header->size > size)
+            return false;
+
+        const size_t blobSize = header->size;
+        if (!_isTableValid(header->strings, 1, blobSize) ||
+            !_isTableValid(header->typeLayouts, sizeof(TypeLayout), blobSize) ||
+            !_isTableValid(header->variables, sizeof(Variable), blobSize) ||
+            !_isTableValid(header->bindings, sizeof(Binding), blobSize) ||
+            !_isTableValid(header->sizes, sizeof(Size), blobSize) ||
+            !_isTableValid(header->attributes, sizeof(Attribute), blobSize) ||
+            !_isTableValid(header->attributeArgs, sizeof(AttributeArg), blobSize) ||
+            !_isTableValid(header->entryPoints, sizeof(EntryPoint), blobSize) ||
+            !_isTableValid(header->hashedStrings, sizeof(HashedString), blobSize))
+        {
+            return false;
+        }
+
+        // Every string must be terminated, which is ensured by the table ending in a zero.
+        const uint8_t* bytes = (const uint8_t*)data;
+        if (header->strings.count &&
+            bytes[header->strings.offset + header->strings.count - 1] != 0)
+        {
+            return false;
+        }
+
+        m_data = bytes;
+        m_header = header;
+        return true;
+    }
+
+    const Header* getHeader() const { return m_header; }
+
+    uint32_t getParameterCount() const { return m_header ? m_header->parameters.count : 0; }
+    const Variable* getParameter(uint32_t index) const
+    {
+        return m_header ? getVariable(m_header->parameters, index) : nullptr;
+    }
+    const Variable* findParameter(const char* name) const
+    {
+        return m_header ? _findVariable(m_header->parameters, name) : nullptr;
+    }
+
+    uint32_t getEntryPointCount() const { return m_header ? m_header->entryPoints.count : 0; }
+    const EntryPoint* getEntryPoint(uint32_t index) const
+    {
+        return _get<EntryPoint>(&Header::entryPoints, index);
+    }
+    const EntryPoint* findEntryPoint(const char* name) const
+    {
+        for (uint32_t i = 0; i < getEntryPointCount(); ++i)
+        {
+            const EntryPoint* entryPoint = getEntryPoint(i);
+            if (_isNamed(entryPoint->name, name))
+                return entryPoint;
+        }
+        return nullptr;
+    }
+
+    uint32_t getHashedStringCount() const { return m_header ? m_header->hashedStrings.count : 0; }
+    const HashedString* getHashedString(uint32_t index) const
+    {
+        return _get<HashedString>(&Header::hashedStrings, index);
+    }
+
+    /// Returns null for `kNone`.
+    const char* getString(StringRef ref) const
+    {
+        if (!m_header || ref >= m_header->strings.count)
+            return nullptr;
+        return (const char*)(m_data + m_header->strings.offset + ref);
+    }
+
+    const TypeLayout* getTypeLayout(uint32_t index) const
+    {
+        return _get<TypeLayout>(&Header::typeLayouts, index);
+    }
+    const TypeLayout* getTypeLayout(const Variable* variable) const
+    {
+        return variable ? getTypeLayout(variable->typeLayout) : nullptr;
+    }
+
+    const Variable* getVariable(uint32_t index) const
+    {
+        return _get<Variable>(&Header::variables, index);
+    }
+    const Variable* getVariable(Span span, uint32_t index) const
+    {
+        return index < span.count ? getVariable(span.first + index) : nullptr;
+    }
+    const Binding* getBinding(Span span, uint32_t index) const
+    {
+        return index < span.count ? _get<Binding>(&Header::bindings, span.first + index) : nullptr;
+    }
+    const Size* getSize(Span span, uint32_t index) const
+    {
+        return index < span.count ? _get<Size>(&Header::sizes, span.first + index) : nullptr;
+    }
+    const Attribute* getAttribute(Span span, uint32_t index) const
+    {
+        return index < span.count ? _get<Attribute>(&Header::attributes, span.first + index)
+                                  : nullptr;
+    }
+    const AttributeArg* getAttributeArg(Span span, uint32_t index) const
+    {
+        return index < span.count
+                   ? _get<AttributeArg>(&Header::attributeArgs, span.first + index)
+                   : nullptr;
+    }
+
+    /// Find where `variable` is bound for `category`, or null if it doesn't use that category.
+    const Binding* findBinding(const Variable* variable, uint32_t category) const
+    {
+        for (uint32_t i = 0; variable && i < variable->bindings.count; ++i)
+        {
+            const Binding* binding = getBinding(variable->bindings, i);
+            if (binding && binding->category == category)
+                return binding;
+        }
+        return nullptr;
+    }
+
+    /// Get how much of `category` is used by `typeLayout`, which is zero if it doesn't use it.
+    uint32_t findSize(const TypeLayout* typeLayout, uint32_t category) const
+    {
+        for (uint32_t i = 0; typeLayout && i < typeLayout->sizes.count; ++i)
+        {
+            const Size* size = getSize(typeLayout->sizes, i);
+            if (size && size->category == category)
+                return size->size;
+        }
+        return 0;
+    }
+
+    const Variable* findField(const TypeLayout* typeLayout, const char* name) const
+    {
+        return typeLayout ? _findVariable(typeLayout->fields, name) : nullptr;
+    }
+
+private:
+    static bool _isTableValid(const Table& table, size_t recordSize, size_t blobSize)
+    {
+        if ((table.offset & 3) != 0 || table.offset > blobSize)
+            return false;
+        return table.count <= (blobSize - table.offset) / recordSize;
+    }
+
+    template<typename T>
+    const T* _get(Table Header::*table, uint32_t index) const
+    {
+        if (!m_header || index >= (m_header->*table).count)
+            return nullptr;
+        return (const T*)(m_data + (m_header->*table).offset) + index;
+    }
+
+    bool _isNamed(StringRef ref, const char* name) const
+    {
+        const char* string = getString(ref);
+        return string && strcmp(string, name) == 0;
+    }
+
+    const Variable* _findVariable(Span span, const char* name) const
+    {
+        for (uint32_t i = 0; i < span.count; ++i)
+        {
+            const Variable* variable = getVariable(span, i);
+            if (variable && _isNamed(variable->name, name))
+                return variable;
+        }
+        return nullptr;
+    }
+
+    const uint8_t* m_data = nullptr;
+    const Header* m_header = nullptr;
+};
+
+} // namespace ReflectionBlob
+} // namespace slang
+
+#endif
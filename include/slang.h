@@ -1006,6 +1006,29 @@ typedef uint32_t SlangSizeT;
         EmitSpirvMethod, // enum SlangEmitSpirvMethod
 
         EmitReflectionJSON, // bool
+        ModuleCachePath,    // stringValue0: directory used to cache serialized imported modules.
+        TraceJSONPath,      // stringValue0: file to write a Chrome trace of the compilation to.
+        ReportPassStats,    // bool
+        LinkTimeSpecializationConstants, // bool
+        ReflectionOnly,                  // bool
+        EmitReflectionBlob, // stringValue0: file to write the binary reflection blob to.
+        ReportMemory,       // bool
+        InputManifest,      // stringValue0: file to write the inputs of the compile and hashes to.
+        ReportUnpromotedVars, // bool
+        TieredJit,            // bool
+        AggregateUniformAtomics, // bool
+        MetalArgumentBufferTier2, // bool
+        CompactWGSL,              // bool
+        LazyImportChecking,       // bool
+        LazyImportLowering,       // bool
+        InstrumentTiming,         // stringValue0: name of the buffer to record timings in.
+        DebugInfoExternalSource,  // bool
+        ValidateIrIncremental,    // bool
+        StripNamesAndDebugInfo,   // bool
+        CacheDerivatives,         // bool
+        IRInstBudget,             // intValue0: largest number of insts in the linked IR module.
+        IRFuncInstBudget,         // intValue0: largest number of insts in a function of the IR.
+        SpecializationDepthBudget, // intValue0: how deeply generic specializations may nest.
         CountOf,
     };
 
@@ -1714,6 +1737,14 @@ public:                                                              \
         virtual SLANG_NO_THROW const char* SLANG_MCALL getEntryName(uint32_t index) = 0;
         virtual SLANG_NO_THROW long SLANG_MCALL getEntryTimeMS(uint32_t index) = 0;
         virtual SLANG_NO_THROW uint32_t SLANG_MCALL getEntryInvocationTimes(uint32_t index) = 0;
+
+        /** Get the hierarchical trace of the compilation in the Chrome trace event format
+        (as loaded by chrome://tracing or Perfetto).
+        The trace is only recorded if tracing was enabled for the compilation (for example
+        with the `-trace-json` option), otherwise the returned trace contains no events.
+        @param outTraceJSON Receives a blob holding the JSON text of the trace.
+        @returns SLANG_OK on success */
+        virtual SLANG_NO_THROW SlangResult SLANG_MCALL getTraceJSON(ISlangBlob** outTraceJSON) = 0;
     };
 #define SLANG_UUID_ISlangProfiler ISlangProfiler::getTypeGuid()
 
@@ -2108,6 +2139,53 @@ public:                                                              \
 
     typedef SlangReflectionVariableLayout SlangReflectionParameter;
 
+    // Batch Reflection
+    //
+    // These structures are filled in by a single call, as an alternative to walking a layout
+    // with one call per field or binding. The caller provides arrays of `capacity` entries,
+    // and any array that isn't needed may be null. The functions that fill them return the
+    // number of entries there are, which may be more than `capacity`; in that case only the
+    // first `capacity` entries are written, and the call can be repeated with larger arrays.
+
+    /// One entry per category of every global and entry point parameter, in the order of
+    /// `spReflection_GetParameterByIndex` and then of each entry point's parameters.
+    struct SlangReflectionFlattenedBindings
+    {
+        SlangUInt capacity;
+        SlangReflectionVariableLayout** parameters;
+        /// Index of the entry point that the parameter belongs to, or -1 for a global.
+        int32_t* entryPointIndices;
+        SlangParameterCategory* categories;
+        /// The register, binding or byte offset, as `spReflectionVariableLayout_GetOffset`.
+        size_t* indices;
+        /// The space or set, as `spReflectionVariableLayout_GetSpace`.
+        size_t* spaces;
+        /// The number of registers/bytes used, which is `SLANG_UNBOUNDED_SIZE` if unbounded.
+        size_t* counts;
+    };
+
+    /// The nodes of a type layout tree in pre-order, starting with the root type layout.
+    ///
+    /// The children of a node are the fields of a struct and the element type of an array,
+    /// constant buffer, parameter block or structured buffer.
+    struct SlangReflectionFlattenedTypeLayout
+    {
+        SlangUInt capacity;
+        SlangReflectionTypeLayout** typeLayouts;
+        /// The field that a node is the type of, or null for the root and for elements.
+        SlangReflectionVariableLayout** fields;
+        /// Index of the parent node, or -1 for the root.
+        int32_t* parentIndices;
+        SlangTypeKind* kinds;
+        /// Uniform byte offset of a field within its parent, and zero for other nodes.
+        size_t* uniformOffsets;
+        /// Uniform size in bytes, which is `SLANG_UNBOUNDED_SIZE` if unbounded.
+        size_t* uniformSizes;
+        /// Element count of an array as `spReflectionType_GetElementCount`, or zero for other
+        /// nodes.
+        size_t* elementCounts;
+    };
+
 #ifdef __cplusplus
 }
 #endif
@@ -2479,6 +2557,12 @@ struct TypeLayoutReflection
             index);
     }
 
+    /// Fill `outTree` with the nodes of this type layout tree, and return how many there are.
+    SlangUInt getFlattenedTree(SlangReflectionFlattenedTypeLayout* outTree)
+    {
+        return spReflectionTypeLayout_getFlattenedTree((SlangReflectionTypeLayout*)this, outTree);
+    }
+
     SlangInt findFieldIndexByName(char const* nameBegin, char const* nameEnd = nullptr)
     {
         return spReflectionTypeLayout_findFieldIndexByName(
@@ -3274,11 +3358,28 @@ struct ShaderReflection
         return (TypeReflection*)spReflection_FindTypeByName((SlangReflection*)this, name);
     }
 
+    /// Find a type by name, where `nameHash` is `spComputeStringHash` of the name.
+    ///
+    /// Lookups are cached by the program layout, so looking up a name again is cheap, and
+    /// with a precomputed hash it doesn't need to hash the name either.
+    TypeReflection* findTypeByName(const char* name, SlangUInt32 nameHash)
+    {
+        return (TypeReflection*)
+            spReflection_FindTypeByNameHashed((SlangReflection*)this, name, nameHash);
+    }
+
     FunctionReflection* findFunctionByName(const char* name)
     {
         return (FunctionReflection*)spReflection_FindFunctionByName((SlangReflection*)this, name);
     }
 
+    /// Find a function by name, where `nameHash` is `spComputeStringHash` of the name.
+    FunctionReflection* findFunctionByName(const char* name, SlangUInt32 nameHash)
+    {
+        return (FunctionReflection*)
+            spReflection_FindFunctionByNameHashed((SlangReflection*)this, name, nameHash);
+    }
+
     FunctionReflection* findFunctionByNameInType(TypeReflection* type, const char* name)
     {
         return (FunctionReflection*)spReflection_FindFunctionByNameInType(
@@ -3375,6 +3476,19 @@ struct ShaderReflection
     {
         return spReflection_ToJson((SlangReflection*)this, nullptr, outBlob);
     }
+
+    /// Write the reflection information in the flat binary format described in
+    /// `slang-reflection-blob.h`, which can be read in place without the Slang library.
+    SlangResult toBlob(ISlangBlob** outBlob)
+    {
+        return spReflection_ToBlob((SlangReflection*)this, outBlob);
+    }
+
+    /// Fill `outBindings` with the bindings of every parameter, and return how many there are.
+    SlangUInt getFlattenedBindings(SlangReflectionFlattenedBindings* outBindings)
+    {
+        return spReflection_getFlattenedBindings((SlangReflection*)this, outBindings);
+    }
 };
 
 
@@ -3514,6 +3628,7 @@ struct IComponentType;
 struct ITypeConformance;
 struct IGlobalSession;
 struct IModule;
+struct ITaskScheduler_Experimental;
 
 struct SessionDesc;
 struct SpecializationArg;
@@ -3844,6 +3959,14 @@ struct SessionDesc
     /** Number of additional compiler option entries.
      */
     uint32_t compilerOptionEntryCount = 0;
+
+    /** Scheduler that the session's internal parallel work (such as running downstream
+    compilers for several entry points, or writing out large SPIR-V modules) is submitted
+    to, and that asynchronous compiles run on when they don't specify one.
+
+    If null, the compiler creates threads of its own for that work.
+    */
+    ITaskScheduler_Experimental* taskScheduler = nullptr;
 };
 
 enum class ContainerType
@@ -4065,6 +4188,38 @@ struct IMetadata : public ISlangCastable
 };
     #define SLANG_UUID_IMetadata IMetadata::getTypeGuid()
 
+/** Experimental interface to find the function that each counter of `-instrument-timing`
+belongs to. Query it from the `IMetadata` of an entry point or target with `castAs`.
+
+The counters of function `index` are two `uint`s of the buffer named by the option: the time
+spent in the function at `2 * index`, in ticks of the clock of the target and wrapping on
+overflow, and the number of calls to it at `2 * index + 1`. The buffer must hold two `uint`s
+per function, and should be cleared before the shader is run.
+*/
+struct IInstrumentationMetadata_Experimental : public ISlangUnknown
+{
+    // uuidgen output:     3b5e8d2a -  7c41 -  4f0e -    9a6d -      51c2e8b7f403
+    SLANG_COM_INTERFACE(
+        0x3b5e8d2a,
+        0x7c41,
+        0x4f0e,
+        {0x9a, 0x6d, 0x51, 0xc2, 0xe8, 0xb7, 0xf4, 0x03})
+
+    /** The number of functions that were instrumented. */
+    virtual SLANG_NO_THROW SlangInt SLANG_MCALL getInstrumentedFunctionCount() = 0;
+
+    /** Get the name of function `index`, and the path and line of the source it is defined
+    in. The strings are owned by the metadata. Any of the outputs can be null.
+    */
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL getInstrumentedFunction(
+        SlangInt index,
+        const char** outName,
+        const char** outFilePath,
+        SlangInt* outLine) = 0;
+};
+    #define SLANG_UUID_IInstrumentationMetadata_Experimental \
+        IInstrumentationMetadata_Experimental::getTypeGuid()
+
 /** A component type is a unit of shader code layout, reflection, and linking.
 
 A component type is a unit of shader code that can be included into
@@ -4396,6 +4551,282 @@ struct IModulePrecompileService_Experimental : public ISlangUnknown
     #define SLANG_UUID_IModulePrecompileService_Experimental \
         IModulePrecompileService_Experimental::getTypeGuid()
 
+/** Experimental interface for a scheduler that runs compile tasks on behalf of Slang.
+
+An application that has its own thread pool can implement this interface, so that
+asynchronous compiles and the compiler's internal parallel work run on the pool
+instead of on threads created by Slang. See `SessionDesc::taskScheduler`.
+*/
+struct ITaskScheduler_Experimental : public ISlangUnknown
+{
+    // uuidgen output:     4a2f6c1e -  8b3d -  4e57 -    9c61 -      2d7e0f5a83b4
+    SLANG_COM_INTERFACE(
+        0x4a2f6c1e,
+        0x8b3d,
+        0x4e57,
+        {0x9c, 0x61, 0x2d, 0x7e, 0x0f, 0x5a, 0x83, 0xb4})
+
+    /** Run `task(context)` once, on any thread.
+
+    Every scheduled task must be run, including ones whose compile has been cancelled,
+    as the compile task waits for it when released.
+     */
+    virtual SLANG_NO_THROW void SLANG_MCALL
+    scheduleTask(void (*task)(void* context), void* context) = 0;
+};
+
+    #define SLANG_UUID_ITaskScheduler_Experimental ITaskScheduler_Experimental::getTypeGuid()
+
+/** Memory held by the caches of a session, see `ISessionMemory_Experimental`. */
+struct SessionMemoryStats
+{
+    size_t structureSize = sizeof(SessionMemoryStats);
+
+    /** The budget set with `setMemoryBudget`, or zero if there is none. */
+    size_t memoryBudget = 0;
+
+    /** The size in bytes of the compiled target code cached by the session. */
+    size_t targetCodeBytes = 0;
+
+    /** The number of cached target code results (one per entry point or whole program). */
+    SlangInt targetCodeCount = 0;
+
+    /** The number of programs (component types on a target) with cached code or caches. */
+    SlangInt cachedProgramCount = 0;
+
+    /** The number of times the caches of a program have been evicted. */
+    SlangInt evictionCount = 0;
+
+    /** The number of modules loaded into the session. */
+    SlangInt loadedModuleCount = 0;
+
+    /** The bytes allocated for the ASTs of the loaded modules. */
+    size_t astBytes = 0;
+
+    /** The bytes allocated for the IR of the loaded modules. */
+    size_t irBytes = 0;
+
+    /** The bytes held by the pool of reusable containers for IR passes on the calling thread. */
+    size_t irContainerPoolBytes = 0;
+
+    /** The bytes held by the string pools of the loaded modules and the source manager. */
+    size_t stringPoolBytes = 0;
+
+    /** The most IR allocated while linking and optimizing a single program for code
+    generation. This IR is released once the code has been generated. */
+    size_t peakCodeGenIRBytes = 0;
+
+    /** The high water mark of the total of all sizes above, sampled whenever code is
+    generated and whenever the stats are queried. */
+    size_t peakTotalBytes = 0;
+};
+
+/** Experimental interface for bounding the memory used by a long-lived session.
+
+A session caches the code compiled for each component type and target, along with the IR
+and specialization caches used to produce it. This interface is queried from `ISession`.
+*/
+struct ISessionMemory_Experimental : public ISlangUnknown
+{
+    // uuidgen output:     6d1c93a0 -  2f4b -  4c8e -    b5a7 -      0e93d4c1f268
+    SLANG_COM_INTERFACE(
+        0x6d1c93a0,
+        0x2f4b,
+        0x4c8e,
+        {0xb5, 0xa7, 0x0e, 0x93, 0xd4, 0xc1, 0xf2, 0x68})
+
+    /** Limit the compiled target code cached by the session to `budgetInBytes`, or remove
+    the limit if it is zero (the default).
+
+    Whenever code is requested through `IComponentType` and the cached code is over the
+    budget, the caches of the least recently used programs are evicted until it fits. Their
+    code is compiled again if it is requested later. The program whose code was requested
+    is never evicted, so a single program larger than the budget is still cached.
+    */
+    virtual SLANG_NO_THROW void SLANG_MCALL setMemoryBudget(size_t budgetInBytes) = 0;
+
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL
+    getMemoryStats(SessionMemoryStats* outStats) = 0;
+
+    /** Evict every cache that the session can recreate: the compiled code, IR and
+    specialization caches of every program, and the shared type layouts of each target.
+
+    Loaded modules are kept, since the types of every program refer to them.
+    */
+    virtual SLANG_NO_THROW void SLANG_MCALL trimMemory() = 0;
+};
+
+    #define SLANG_UUID_ISessionMemory_Experimental ISessionMemory_Experimental::getTypeGuid()
+
+/** Experimental interface for replacing a loaded module with a new version of it, such as
+when a shader is edited while an application is running.
+
+Reloading a module only checks and lowers the modules that are affected by the change, and
+the code cached for programs that don't use any of them is kept. This interface is queried
+from `ISession`.
+*/
+struct ISessionReload_Experimental : public ISlangUnknown
+{
+    // uuidgen output:     b3cd97d5 -  4617 -  41d1 -    a85e -      c54d341e04fd
+    SLANG_COM_INTERFACE(
+        0xb3cd97d5,
+        0x4617,
+        0x41d1,
+        {0xa8, 0x5e, 0xc5, 0x4d, 0x34, 0x1e, 0x04, 0xfd})
+
+    /** Load a new version of the module named `moduleName`, and return it.
+
+    The new version is loaded from `source`, or read again from the file of the previous
+    version when `source` is null. The previous version and every module that imports it,
+    directly or indirectly, are unloaded, and the caches of the programs that use any of
+    them are evicted. A module that was unloaded because it imports `moduleName` is loaded
+    again when it is next imported or loaded.
+
+    Every other loaded module is kept as it is, along with the code cached for programs
+    that only use such modules. Component types created from the unloaded modules stay
+    valid, but keep using the previous version; programs that should use the new version
+    are composed again from the returned module.
+
+    If the module wasn't loaded before, this is the same as loading it.
+    */
+    virtual SLANG_NO_THROW IModule* SLANG_MCALL
+    reloadModule(const char* moduleName, IBlob* source, IBlob** outDiagnostics = nullptr) = 0;
+};
+
+    #define SLANG_UUID_ISessionReload_Experimental ISessionReload_Experimental::getTypeGuid()
+
+/** Experimental interface for a compile that runs in the background.
+
+Releasing the last reference to a task that has not completed cancels it, and waits
+for it to stop.
+*/
+struct ICompileTask_Experimental : public ISlangUnknown
+{
+    // uuidgen output:     b81e9d47 -  2c6a -  4f03 -    a5d8 -      71c4e3b09f26
+    SLANG_COM_INTERFACE(
+        0xb81e9d47,
+        0x2c6a,
+        0x4f03,
+        {0xa5, 0xd8, 0x71, 0xc4, 0xe3, 0xb0, 0x9f, 0x26})
+
+    /** Ask the compile to stop.
+
+    Cancellation is cooperative: the compile stops at its next cancellation check,
+    such as between IR passes or before invoking a downstream compiler. A cancelled
+    compile produces no code, and `waitForResult` returns `SLANG_E_ABORT`.
+    */
+    virtual SLANG_NO_THROW void SLANG_MCALL cancel() = 0;
+
+    /** Returns true once the compile has finished, been cancelled, or failed.
+     */
+    virtual SLANG_NO_THROW bool SLANG_MCALL isComplete() = 0;
+
+    /** Wait for the compile to finish and get its result.
+
+    The result, `outCode` and `outDiagnostics` are the same as would have been produced
+    by the corresponding blocking `IComponentType` call.
+    */
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL
+    waitForResult(IBlob** outCode, IBlob** outDiagnostics = nullptr) = 0;
+};
+
+    #define SLANG_UUID_ICompileTask_Experimental ICompileTask_Experimental::getTypeGuid()
+
+/** Experimental interface for generating the code of a component type asynchronously.
+
+Obtained by `queryInterface` on an `IComponentType`. Compiles still hold the session's
+API lock while they run, so the session can keep being used from other threads, but
+those calls wait for the compile (or its next cancellation check) to finish.
+
+If `scheduler` is null the compile runs on the session's `SessionDesc::taskScheduler`,
+or on a thread created for the task if the session doesn't have one.
+*/
+struct IComponentTypeAsync_Experimental : public ISlangUnknown
+{
+    // uuidgen output:     e6035a92 -  71fb -  4c8e -    b2a4 -      5f9d18c6e073
+    SLANG_COM_INTERFACE(
+        0xe6035a92,
+        0x71fb,
+        0x4c8e,
+        {0xb2, 0xa4, 0x5f, 0x9d, 0x18, 0xc6, 0xe0, 0x73})
+
+    /** Start `IComponentType::getEntryPointCode` in the background.
+     */
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL getEntryPointCodeAsync(
+        SlangInt entryPointIndex,
+        SlangInt targetIndex,
+        ITaskScheduler_Experimental* scheduler,
+        ICompileTask_Experimental** outTask) = 0;
+
+    /** Start `IComponentType::getTargetCode` in the background.
+     */
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL getTargetCodeAsync(
+        SlangInt targetIndex,
+        ITaskScheduler_Experimental* scheduler,
+        ICompileTask_Experimental** outTask) = 0;
+};
+
+    #define SLANG_UUID_IComponentTypeAsync_Experimental \
+        IComponentTypeAsync_Experimental::getTypeGuid()
+
+/** Experimental interface to get the code of an `IComponentType` into memory or a stream
+provided by the caller, rather than as a blob. Query it from an `IComponentType`.
+
+The code is the same as `IComponentType::getEntryPointCode` and `getTargetCode` return, and
+is copied straight from the buffer the compiler produced it in. An application that puts the
+code in a package of its own can so write it to its final place without copying it out of a
+blob first.
+*/
+struct IComponentTypeOutput_Experimental : public ISlangUnknown
+{
+    // uuidgen output:     ee38c6b8 -  56a6 -  4120 -    8877 -      dd0057c490ff
+    SLANG_COM_INTERFACE(
+        0xee38c6b8,
+        0x56a6,
+        0x4120,
+        {0x88, 0x77, 0xdd, 0x00, 0x57, 0xc4, 0x90, 0xff})
+
+    /** Write the code of an entry point to `writer`, with one or more calls to
+    `ISlangWriter::write`. Fails with the result of the first write that fails.
+    */
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL writeEntryPointCode(
+        SlangInt entryPointIndex,
+        SlangInt targetIndex,
+        ISlangWriter* writer,
+        IBlob** outDiagnostics = nullptr) = 0;
+
+    /** Write the code of a whole target to `writer`, as for `writeEntryPointCode`.
+     */
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL writeTargetCode(
+        SlangInt targetIndex,
+        ISlangWriter* writer,
+        IBlob** outDiagnostics = nullptr) = 0;
+
+    /** Copy the code of an entry point to the `bufferSize` bytes at `buffer`, and set
+    `outCodeSize` to the size of the code. If the code doesn't fit, nothing is copied and
+    SLANG_E_BUFFER_TOO_SMALL is returned, so the size can be found with a null `buffer`.
+    */
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL copyEntryPointCode(
+        SlangInt entryPointIndex,
+        SlangInt targetIndex,
+        void* buffer,
+        size_t bufferSize,
+        size_t* outCodeSize,
+        IBlob** outDiagnostics = nullptr) = 0;
+
+    /** Copy the code of a whole target to `buffer`, as for `copyEntryPointCode`.
+     */
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL copyTargetCode(
+        SlangInt targetIndex,
+        void* buffer,
+        size_t bufferSize,
+        size_t* outCodeSize,
+        IBlob** outDiagnostics = nullptr) = 0;
+};
+
+    #define SLANG_UUID_IComponentTypeOutput_Experimental \
+        IComponentTypeOutput_Experimental::getTypeGuid()
+
 /** Argument used for specialization to types/values.
  */
 struct SpecializationArg
@@ -319,4 +319,16 @@ public:
 #define SLANG_UNROLL
 #endif
 
+// Placed on the loop over the threads of a compute group, so that the compiler vectorizes the
+// threads of the group when it can prove it is safe. The hint doesn't change what is legal, so
+// the warning for a loop that couldn't be vectorized is disabled.
+#ifndef SLANG_VECTORIZE
+#if SLANG_CLANG
+#pragma clang diagnostic ignored "-Wpass-failed"
+#define SLANG_VECTORIZE _Pragma("clang loop vectorize(enable) interleave(enable)")
+#else
+#define SLANG_VECTORIZE
+#endif
+#endif
+
 #endif
@@ -1020,6 +1020,134 @@ SLANG_FORCE_INLINE SLANG_CUDA_CALL Matrix<__half, R, C> operator%(
 #undef SLANG_MATRIX_INT_NEG_OP
 #undef SLANG_FLOAT_MATRIX_MOD
 
+// Products of floating-point vectors and matrices, for `mul`. The vector parameters can't be
+// deduced, so the element type and sizes come from the matrix.
+template<typename T, int N, int M>
+SLANG_FORCE_INLINE SLANG_CUDA_CALL Vector<T, M> _slang_mul(
+    const Vector<T, N>& left,
+    const Matrix<T, N, M>& right)
+{
+    Vector<T, M> result;
+    for (int j = 0; j < M; j++)
+    {
+        T sum = T(0);
+        for (int i = 0; i < N; i++)
+            sum += _slang_vector_get_element(left, i) *
+                   _slang_vector_get_element(right.rows[i], j);
+        *_slang_vector_get_element_ptr(&result, j) = sum;
+    }
+    return result;
+}
+
+template<typename T, int N, int M>
+SLANG_FORCE_INLINE SLANG_CUDA_CALL Vector<T, N> _slang_mul(
+    const Matrix<T, N, M>& left,
+    const Vector<T, M>& right)
+{
+    Vector<T, N> result;
+    for (int i = 0; i < N; i++)
+    {
+        T sum = T(0);
+        for (int j = 0; j < M; j++)
+            sum += _slang_vector_get_element(left.rows[i], j) *
+                   _slang_vector_get_element(right, j);
+        *_slang_vector_get_element_ptr(&result, i) = sum;
+    }
+    return result;
+}
+
+template<typename T, int R, int N, int C>
+SLANG_FORCE_INLINE SLANG_CUDA_CALL Matrix<T, R, C> _slang_mul(
+    const Matrix<T, R, N>& left,
+    const Matrix<T, N, C>& right)
+{
+    Matrix<T, R, C> result;
+    for (int r = 0; r < R; r++)
+        result.rows[r] = _slang_mul<T, N, C>(left.rows[r], right);
+    return result;
+}
+
+#if SLANG_CUDA_ENABLE_HALF
+// The `__half` products compute two outputs at a time with `__hfma2`, which does two
+// multiply-adds in one instruction. Each output still sums its terms in the same order.
+template<int N, int M>
+SLANG_FORCE_INLINE SLANG_CUDA_CALL Vector<__half, M> _slang_mul(
+    const Vector<__half, N>& left,
+    const Matrix<__half, N, M>& right)
+{
+    Vector<__half, M> result;
+    int j = 0;
+    for (; j + 1 < M; j += 2)
+    {
+        __half2 sum = __float2half2_rn(0.0f);
+        for (int i = 0; i < N; i++)
+            sum = __hfma2(
+                __half2half2(_slang_vector_get_element(left, i)),
+                __halves2half2(
+                    _slang_vector_get_element(right.rows[i], j),
+                    _slang_vector_get_element(right.rows[i], j + 1)),
+                sum);
+        *_slang_vector_get_element_ptr(&result, j) = __low2half(sum);
+        *_slang_vector_get_element_ptr(&result, j + 1) = __high2half(sum);
+    }
+    if (j < M)
+    {
+        __half sum = __float2half(0.0f);
+        for (int i = 0; i < N; i++)
+            sum = __hfma(
+                _slang_vector_get_element(left, i),
+                _slang_vector_get_element(right.rows[i], j),
+                sum);
+        *_slang_vector_get_element_ptr(&result, j) = sum;
+    }
+    return result;
+}
+
+template<int N, int M>
+SLANG_FORCE_INLINE SLANG_CUDA_CALL Vector<__half, N> _slang_mul(
+    const Matrix<__half, N, M>& left,
+    const Vector<__half, M>& right)
+{
+    Vector<__half, N> result;
+    int i = 0;
+    for (; i + 1 < N; i += 2)
+    {
+        __half2 sum = __float2half2_rn(0.0f);
+        for (int j = 0; j < M; j++)
+            sum = __hfma2(
+                __halves2half2(
+                    _slang_vector_get_element(left.rows[i], j),
+                    _slang_vector_get_element(left.rows[i + 1], j)),
+                __half2half2(_slang_vector_get_element(right, j)),
+                sum);
+        *_slang_vector_get_element_ptr(&result, i) = __low2half(sum);
+        *_slang_vector_get_element_ptr(&result, i + 1) = __high2half(sum);
+    }
+    if (i < N)
+    {
+        __half sum = __float2half(0.0f);
+        for (int j = 0; j < M; j++)
+            sum = __hfma(
+                _slang_vector_get_element(left.rows[i], j),
+                _slang_vector_get_element(right, j),
+                sum);
+        *_slang_vector_get_element_ptr(&result, i) = sum;
+    }
+    return result;
+}
+
+template<int R, int N, int C>
+SLANG_FORCE_INLINE SLANG_CUDA_CALL Matrix<__half, R, C> _slang_mul(
+    const Matrix<__half, R, N>& left,
+    const Matrix<__half, N, C>& right)
+{
+    Matrix<__half, R, C> result;
+    for (int r = 0; r < R; r++)
+        result.rows[r] = _slang_mul<N, C>(left.rows[r], right);
+    return result;
+}
+#endif
+
 #define SLANG_SELECT_IMPL(T, N)                                                                  \
     SLANG_FORCE_INLINE SLANG_CUDA_CALL Vector<T, N> _slang_select(                               \
         bool##N condition,                                                                       \
@@ -2098,6 +2226,15 @@ struct RWByteAddressBuffer
 
 // ---------------------- Wave --------------------------------------
 
+// The wave helpers are only needed by code that uses wave intrinsics. Slang defines
+// SLANG_CUDA_ENABLE_WAVE as 0 when the generated code doesn't use them.
+#ifndef SLANG_CUDA_ENABLE_WAVE
+#define SLANG_CUDA_ENABLE_WAVE 1
+#endif
+
+#if SLANG_CUDA_ENABLE_WAVE
+
+
 // TODO(JS): It appears that cuda does not have a simple way to get a lane index.
 //
 // Another approach could be...
@@ -3052,6 +3189,8 @@ __inline__ __device__ uint4 _waveMatchMultiple(WarpMask mask, const T& inVal)
     return make_uint4(matchBits, 0, 0, 0);
 }
 
+#endif // SLANG_CUDA_ENABLE_WAVE
+
 __device__ uint getAt(dim3 a, int b)
 {
     SLANG_PRELUDE_ASSERT(b >= 0 && b < 3);
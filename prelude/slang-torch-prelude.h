@@ -8,6 +8,8 @@
 #include <ATen/cuda/CUDAUtils.h>
 #include <stdexcept>
 #include <string>
+#include <tuple>
+#include <type_traits>
 #include <vector>
 
 #ifdef SLANG_LLVM
@@ -78,8 +80,17 @@ struct TensorView
 };
 
 
-TensorView make_tensor_view(
-    torch::Tensor val,
+// Kept out of line, so that the checks in `make_tensor_view` stay small enough to inline.
+[[noreturn]] static void _slang_torch_throw(const char* name, const char* message)
+{
+    throw std::runtime_error(std::string(name).append(message).c_str());
+}
+
+// Called for every tensor argument of every call, so it avoids anything that isn't needed to
+// check the tensor: the tensor isn't copied (which would touch its reference count), and its
+// sizes and strides are read once from their arrays rather than one dimension at a time.
+SLANG_FORCE_INLINE TensorView make_tensor_view(
+    const torch::Tensor& val,
     const char* name,
     torch::ScalarType targetScalarType,
     bool requireContiguous)
@@ -91,91 +102,82 @@ TensorView make_tensor_view(
 
     // Expect tensors to be on CUDA device
     if (!val.device().is_cuda())
-        throw std::runtime_error(
-            std::string(name).append(": tensor is not on CUDA device.").c_str());
+        _slang_torch_throw(name, ": tensor is not on CUDA device.");
 
     // Expect tensors to be the right type.
-    if (val.dtype() != targetScalarType)
-        throw std::runtime_error(
-            std::string(name).append(": tensor is not of the expected type.").c_str());
+    if (val.scalar_type() != targetScalarType)
+        _slang_torch_throw(name, ": tensor is not of the expected type.");
 
     // Check that the tensor is contiguous
     if (requireContiguous && !val.is_contiguous())
-        throw std::runtime_error(std::string(name).append(": tensor is not contiguous.").c_str());
-
-    TensorView res = {};
-    res.dimensionCount = val.dim();
-    res.data = nullptr;
-    size_t elementSize = 4;
+        _slang_torch_throw(name, ": tensor is not contiguous.");
 
-    switch (val.scalar_type())
-    {
-    case torch::kInt8:
-    case torch::kUInt8:
-        elementSize = 1;
-        res.data = (uint8_t*)val.data_ptr<uint8_t>();
-        break;
-    case torch::kBFloat16:
-        elementSize = 2;
-        res.data = (uint8_t*)val.data_ptr<torch::BFloat16>();
-        break;
-    case torch::kFloat16:
-        elementSize = 2;
-        res.data = (uint8_t*)val.data_ptr<at::Half>();
-        break;
-    case torch::kInt16:
-        elementSize = 2;
-        res.data = (uint8_t*)val.data_ptr<int16_t>();
-        break;
-    case torch::kFloat32:
-        elementSize = 4;
-        res.data = (uint8_t*)val.data_ptr<float>();
-        break;
-    case torch::kInt32:
-        elementSize = 4;
-        res.data = (uint8_t*)val.data_ptr<int32_t>();
-        break;
-    case torch::kFloat64:
-        elementSize = 8;
-        res.data = (uint8_t*)val.data_ptr<double>();
-        break;
-    case torch::kInt64:
-        elementSize = 8;
-        res.data = (uint8_t*)val.data_ptr<int64_t>();
-        break;
-    case torch::kBool:
-        elementSize = 1;
-        res.data = (uint8_t*)val.data_ptr<bool>();
-        break;
-    }
-
-    if (val.dim() > kSlangTorchTensorMaxDim)
+    const auto dimensionCount = val.dim();
+    if (dimensionCount > kSlangTorchTensorMaxDim)
         throw std::runtime_error(std::string(name)
                                      .append(": number of dimensions exceeds limit (")
                                      .append(std::to_string(kSlangTorchTensorMaxDim))
                                      .append(")")
                                      .c_str());
 
+    TensorView res = {};
+    res.dimensionCount = uint32_t(dimensionCount);
+
+    // The type was checked above, so the typed accessors would only check it again.
+    res.data = (uint8_t*)val.data_ptr();
+    const auto elementSize = val.element_size();
+
+    const auto sizes = val.sizes();
+    const auto strides = val.strides();
     bool isEmpty = true;
-    for (int i = 0; i < val.dim(); ++i)
+    for (int64_t i = 0; i < dimensionCount; ++i)
     {
-        res.strides[i] = val.stride(i) * elementSize;
+        res.strides[i] = uint32_t(strides[i] * elementSize);
         if (res.strides[i] == 0)
-            throw std::runtime_error(
-                std::string(name)
-                    .append(": tensors with broadcasted dimensions are not supported (use "
-                            "tensor.contiguous() to make tensor whole)")
-                    .c_str());
+            _slang_torch_throw(
+                name,
+                ": tensors with broadcasted dimensions are not supported (use "
+                "tensor.contiguous() to make tensor whole)");
 
-        res.sizes[i] = val.size(i);
+        res.sizes[i] = uint32_t(sizes[i]);
         if (res.sizes[i] > 0)
             isEmpty = false;
     }
 
     if (!res.data && !isEmpty)
-        throw std::runtime_error(std::string(name).append(": data pointer is invalid.").c_str());
+        _slang_torch_throw(name, ": data pointer is invalid.");
 
     return res;
 }
 
+// Calls a bound function once for each set of arguments in a list, so that Python only calls
+// into the module once for all of them. The kernels are launched in order on the current
+// stream, as they would be by separate calls, so a batch can be captured into a CUDA graph.
+template<typename Func>
+struct SlangTorchBatched;
+
+template<typename Result, typename... Params>
+struct SlangTorchBatched<Result (*)(Params...)>
+{
+    typedef std::tuple<std::decay_t<Params>...> ArgumentSet;
+
+    template<Result (*func)(Params...)>
+    static auto call(const std::vector<ArgumentSet>& argumentSets)
+    {
+        if constexpr (std::is_void_v<Result>)
+        {
+            for (const auto& arguments : argumentSets)
+                std::apply(func, arguments);
+        }
+        else
+        {
+            std::vector<Result> results;
+            results.reserve(argumentSets.size());
+            for (const auto& arguments : argumentSets)
+                results.push_back(std::apply(func, arguments));
+            return results;
+        }
+    }
+};
+
 #define SLANG_PRELUDE_EXPORT
@@ -287,6 +287,10 @@ void* ArtifactPostEmitMetadata::getInterface(const Guid& guid)
     {
         return static_cast<IArtifactPostEmitMetadata*>(this);
     }
+    if (guid == slang::IInstrumentationMetadata_Experimental::getTypeGuid())
+    {
+        return static_cast<slang::IInstrumentationMetadata_Experimental*>(this);
+    }
     return nullptr;
 }
 
@@ -320,6 +324,30 @@ Slice<String> ArtifactPostEmitMetadata::getExportedFunctionMangledNames()
         m_exportedFunctionMangledNames.getCount());
 }
 
+SlangInt ArtifactPostEmitMetadata::getInstrumentedFunctionCount()
+{
+    return m_instrumentedFunctions.getCount();
+}
+
+SlangResult ArtifactPostEmitMetadata::getInstrumentedFunction(
+    SlangInt index,
+    const char** outName,
+    const char** outFilePath,
+    SlangInt* outLine)
+{
+    if (index < 0 || index >= m_instrumentedFunctions.getCount())
+        return SLANG_E_INVALID_ARG;
+
+    const auto& function = m_instrumentedFunctions[index];
+    if (outName)
+        *outName = function.name.getBuffer();
+    if (outFilePath)
+        *outFilePath = function.filePath.getBuffer();
+    if (outLine)
+        *outLine = function.line;
+    return SLANG_OK;
+}
+
 SlangResult ArtifactPostEmitMetadata::isParameterLocationUsed(
     SlangParameterCategory category,
     SlangUInt spaceIndex,
@@ -170,7 +170,17 @@ struct ShaderBindingRange
     }
 };
 
-class ArtifactPostEmitMetadata : public ComBaseObject, public IArtifactPostEmitMetadata
+/// A function that `-instrument-timing` added counters to
+struct InstrumentedFunction
+{
+    String name;
+    String filePath;
+    Int line = 0;
+};
+
+class ArtifactPostEmitMetadata : public ComBaseObject,
+                                 public IArtifactPostEmitMetadata,
+                                 public slang::IInstrumentationMetadata_Experimental
 {
 public:
     typedef ArtifactPostEmitMetadata ThisType;
@@ -195,6 +205,14 @@ public:
         SlangUInt registerIndex,         // `register` for D3D12, `binding` for Vulkan
         bool& outUsed) SLANG_OVERRIDE;
 
+    // IInstrumentationMetadata_Experimental
+    SLANG_NO_THROW virtual SlangInt SLANG_MCALL getInstrumentedFunctionCount() SLANG_OVERRIDE;
+    SLANG_NO_THROW virtual SlangResult SLANG_MCALL getInstrumentedFunction(
+        SlangInt index,
+        const char** outName,
+        const char** outFilePath,
+        SlangInt* outLine) SLANG_OVERRIDE;
+
     void* getInterface(const Guid& uuid);
     void* getObject(const Guid& uuid);
 
@@ -205,6 +223,7 @@ public:
 
     List<ShaderBindingRange> m_usedBindings;
     List<String> m_exportedFunctionMangledNames;
+    List<InstrumentedFunction> m_instrumentedFunctions;
 };
 
 } // namespace Slang
@@ -22,6 +22,11 @@ public:
 
     // IArtifactHandler
     SLANG_NO_THROW SlangResult SLANG_MCALL expandChildren(IArtifact* container) SLANG_OVERRIDE;
+
+    /// Representations share storage where they can. A blob of a large temporary file is a
+    /// mapping of it, and a file is only written from a blob if the artifact has no file already.
+    /// The conversions that copy are blob to file, file to blob for files the artifact doesn't
+    /// own, and source maps to and from blobs.
     SLANG_NO_THROW SlangResult SLANG_MCALL getOrCreateRepresentation(
         IArtifact* artifact,
         const Guid& guid,
@@ -178,8 +178,24 @@ SlangResult OSFileArtifactRepresentation::createRepresentation(
 
     ComPtr<ISlangBlob> blob;
 
-    auto fileSystem = _getFileSystem();
-    SLANG_RETURN_ON_FAIL(fileSystem->loadFile(m_path.getBuffer(), blob.writeRef()));
+    // An owned file is a temporary, such as the output of a downstream compiler, that nothing
+    // else writes to. Large ones are mapped rather than read, so the contents aren't copied. The
+    // blob keeps this representation alive, so the file is only removed once it is unmapped.
+    if (_isOwned())
+    {
+        ComPtr<ISlangBlob> mappedBlob;
+        if (SLANG_SUCCEEDED(File::map(m_path, mappedBlob)) &&
+            mappedBlob->getBufferSize() >= kMinMappedFileSize)
+        {
+            blob = ScopeBlob::create(mappedBlob, static_cast<IOSFileArtifactRepresentation*>(this));
+        }
+    }
+
+    if (!blob)
+    {
+        auto fileSystem = _getFileSystem();
+        SLANG_RETURN_ON_FAIL(fileSystem->loadFile(m_path.getBuffer(), blob.writeRef()));
+    }
 
     *outCastable = CastableUtil::getCastable(blob).detach();
     return SLANG_OK;
@@ -72,6 +72,9 @@ protected:
     /// True if the file is owned
     bool _isOwned() const { return Index(m_kind) >= Index(Kind::Owned); }
 
+    /// Owned files at least this large are mapped into memory when loaded as a blob.
+    static const size_t kMinMappedFileSize = 64 * 1024;
+
     static ISlangMutableFileSystem* _getFileSystem();
 
     Kind m_kind;
@@ -0,0 +1,42 @@
+#ifndef SLANG_COMPILER_CORE_COMPILE_SERVER_PROTOCOL_H
+#define SLANG_COMPILER_CORE_COMPILE_SERVER_PROTOCOL_H
+
+#include "../core/slang-rtti-info.h"
+#include "slang-com-helper.h"
+#include "slang-com-ptr.h"
+#include "slang.h"
+
+/* The JSON-RPC methods understood by `slangc -daemon`, which compiles with the same global
+session (and so the same loaded core module) for every request sent to it. */
+namespace CompileServerProtocol
+{
+
+using namespace Slang;
+
+struct CompileArgs
+{
+    List<String> args;       ///< The slangc command line arguments, without the executable name
+    String workingDirectory; ///< If set, relative paths in `args` are relative to this directory
+
+    static const UnownedStringSlice g_methodName;
+    static const StructRttiInfo g_rttiInfo;
+};
+
+struct QuitArgs
+{
+    static const UnownedStringSlice g_methodName;
+};
+
+struct CompileResult
+{
+    String stdOut;
+    String stdError; ///< Includes the diagnostics
+    int32_t result = SLANG_OK;
+    int32_t returnCode = 0; ///< As slangc would return if invoked as command line
+
+    static const StructRttiInfo g_rttiInfo;
+};
+
+} // namespace CompileServerProtocol
+
+#endif // SLANG_COMPILER_CORE_COMPILE_SERVER_PROTOCOL_H
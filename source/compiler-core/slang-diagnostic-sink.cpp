@@ -534,6 +534,10 @@ void DiagnosticSink::reset()
     m_internalErrorLocsNoted = 0;
 
     outputBuffer.clear();
+
+    m_warningHashes.clear();
+    m_noteHashes.clear();
+    m_isDroppingNotes = false;
 }
 
 
@@ -644,11 +648,28 @@ bool DiagnosticSink::diagnoseImpl(
     if (info.severity == Severity::Disable)
         return false;
 
+    // If nothing will read the text, the message doesn't need to be formatted, which saves
+    // looking up and formatting locations and source lines. A fatal error is still formatted,
+    // as the message goes with aborting the compile.
+    if (isFlagSet(Flag::CountOnly) && !writer && !m_parentSink && info.severity < Severity::Fatal)
+    {
+        if (info.severity >= Severity::Error)
+        {
+            m_errorCount++;
+        }
+        return true;
+    }
+
     StringBuilder messageBuilder;
     {
         StringBuilder sb;
         formatDiagnosticMessage(sb, info.messageFormat, argCount, args);
 
+        if (_isRepeat(pos, info, sb.getUnownedSlice()))
+        {
+            return false;
+        }
+
         Diagnostic diagnostic;
         diagnostic.ErrorID = info.id;
         diagnostic.Message = sb.produceString();
@@ -662,6 +683,31 @@ bool DiagnosticSink::diagnoseImpl(
     return diagnoseImpl(info, messageBuilder.getUnownedSlice());
 }
 
+bool DiagnosticSink::_isRepeat(
+    SourceLoc const& pos,
+    DiagnosticInfo const& info,
+    UnownedStringSlice message)
+{
+    const HashCode64 hash = combineHash(
+        Slang::getHashCode(info.id),
+        Slang::getHashCode(pos.getRaw()),
+        message.getHashCode());
+
+    switch (info.severity)
+    {
+    case Severity::Note:
+        return m_isDroppingNotes || !m_noteHashes.add(hash);
+    case Severity::Warning:
+        m_noteHashes.clear();
+        m_isDroppingNotes = !m_warningHashes.add(hash);
+        return m_isDroppingNotes;
+    default:
+        m_noteHashes.clear();
+        m_isDroppingNotes = false;
+        return false;
+    }
+}
+
 void DiagnosticSink::diagnoseRaw(Severity severity, char const* message)
 {
     return diagnoseRaw(severity, UnownedStringSlice(message));
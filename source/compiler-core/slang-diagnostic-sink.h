@@ -162,6 +162,8 @@ public:
                                          ///< overrides) into Error type messages
             LanguageServer =
                 0x10, ///< If set will format message in a way that is suitable for language server
+            CountOnly = 0x20, ///< If set diagnostics are only counted, and not formatted, as
+                              ///< nothing will read them. Ignored if there is a writer or parent.
         };
     };
 
@@ -213,6 +215,14 @@ public:
     /// *note* only works if writer is not set, the blob is created from outputBuffer
     SlangResult getBlobIfNeeded(ISlangBlob** outBlob);
 
+    /// If outBlob, as will be passed to getBlobIfNeeded, is nullptr nothing reads the diagnostics,
+    /// so they are only counted.
+    void setCountOnlyIfNoBlob(ISlangBlob** outBlob)
+    {
+        if (!outBlob)
+            setFlag(Flag::CountOnly);
+    }
+
     /// Get the source manager used
     SourceManager* getSourceManager() const { return m_sourceManager; }
     /// Set the source manager used for lookup of source locs
@@ -250,7 +260,7 @@ public:
     DiagnosticSink* getParentSink() const { return m_parentSink; }
 
     /// Reset state.
-    /// Resets error counts. Resets the output buffer.
+    /// Resets error counts. Resets the output buffer, and what has been output for deduplication.
     void reset();
 
     /// Initialize state.
@@ -285,6 +295,13 @@ protected:
 
     Severity getEffectiveMessageSeverity(DiagnosticInfo const& info);
 
+    /// Returns true if the diagnostic repeats what has already been output, so can be dropped.
+    ///
+    /// A warning is a repeat if the same warning was output at the same location before, and
+    /// the notes that follow a repeat are repeats too. A note is also a repeat if it is the same
+    /// as another note of the diagnostic it follows. Errors are never repeats.
+    bool _isRepeat(SourceLoc const& pos, DiagnosticInfo const& info, UnownedStringSlice message);
+
     /// If set all diagnostics (as formatted by *this* sink, will be routed to the parent).
     DiagnosticSink* m_parentSink = nullptr;
 
@@ -304,6 +321,13 @@ protected:
 
     // Configuration that allows the user to control the severity of certain diagnostic messages
     Dictionary<int, Severity> m_severityOverrides;
+
+    /// Hashes of the warnings that have been output.
+    HashSet<HashCode64> m_warningHashes;
+    /// Hashes of the notes output since the last warning or error.
+    HashSet<HashCode64> m_noteHashes;
+    /// Set while the notes that follow a repeated warning are being dropped.
+    bool m_isDroppingNotes = false;
 };
 
 /// An `ISlangWriter` that writes directly to a diagnostic sink.
@@ -152,7 +152,25 @@ SlangResult CommandLineDownstreamCompiler::compile(
     }
 #endif
 
-    SLANG_RETURN_ON_FAIL(ProcessUtil::execute(cmdLine, exeRes));
+    // Source that only exists in memory can be passed without writing it to a temporary file.
+    ComPtr<ISlangBlob> standardInput;
+    if (auto standardInputSource = findStandardInputSource(options))
+    {
+        SLANG_RETURN_ON_FAIL(
+            standardInputSource->loadBlob(ArtifactKeep::No, standardInput.writeRef()));
+    }
+
+    if (standardInput)
+    {
+        const auto standardInputView = makeConstArrayView(
+            (const Byte*)standardInput->getBufferPointer(),
+            Count(standardInput->getBufferSize()));
+        SLANG_RETURN_ON_FAIL(ProcessUtil::execute(cmdLine, standardInputView, exeRes));
+    }
+    else
+    {
+        SLANG_RETURN_ON_FAIL(ProcessUtil::execute(cmdLine, exeRes));
+    }
 
 #if 0
     {
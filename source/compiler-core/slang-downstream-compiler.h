@@ -170,6 +170,8 @@ struct DownstreamCompileOptions
             EnableSecurityChecks = 0x04, ///< Enable runtime security checks (such as for buffer
                                          ///< overruns) - enabling typically decreases performance
             EnableFloat16 = 0x08,        ///< If set compiles with support for float16/half
+            TieredOptimization = 0x10,   ///< Make JIT compiled code callable before it is
+                                         ///< optimized, and optimize it in the background
         };
     };
 
@@ -409,6 +411,16 @@ public:
         List<ComPtr<IArtifact>>& outArtifacts) = 0;
 
     virtual SlangResult calcArgs(const CompileOptions& options, CommandLine& cmdLine) = 0;
+
+    /// Returns the source artifact, if any, to be passed to the compiler through its standard
+    /// input rather than as a file. If there is one, `calcArgs` must name standard input as
+    /// the file to compile in its place.
+    virtual IArtifact* findStandardInputSource(const CompileOptions& options)
+    {
+        SLANG_UNUSED(options);
+        return nullptr;
+    }
+
     virtual SlangResult parseOutput(
         const ExecuteResult& exeResult,
         IArtifactDiagnostics* diagnostics) = 0;
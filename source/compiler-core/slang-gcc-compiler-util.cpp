@@ -487,6 +487,27 @@ static SlangResult _parseGCCFamilyLine(
     return SLANG_OK;
 }
 
+/* static */ IArtifact* GCCDownstreamCompilerUtil::findStandardInputSource(
+    const CompileOptions& options)
+{
+    if (options.sourceArtifacts.count != 1)
+        return nullptr;
+    if (options.sourceLanguage != SLANG_SOURCE_LANGUAGE_C &&
+        options.sourceLanguage != SLANG_SOURCE_LANGUAGE_CPP)
+        return nullptr;
+
+    // Debug info refers to the source by path, so the source needs to be kept as a file.
+    if (options.debugInfoType != DebugInfoType::None)
+        return nullptr;
+
+    // Source that is already a file is compiled from there, so that includes relative to it
+    // keep working.
+    IArtifact* sourceArtifact = options.sourceArtifacts[0];
+    if (findRepresentation<IOSFileArtifactRepresentation>(sourceArtifact))
+        return nullptr;
+    return sourceArtifact;
+}
+
 /* static */ SlangResult GCCDownstreamCompilerUtil::calcArgs(
     const CompileOptions& options,
     CommandLine& cmdLine)
@@ -517,6 +538,13 @@ static SlangResult _parseGCCFamilyLine(
     // speaking UB, and GCC 10+ is happy to take advantage of this, stop it.
     cmdLine.addArg("-fno-strict-aliasing");
 
+    // Pass the output of each compilation stage to the next through pipes, rather than
+    // through temporary files, so a compile doesn't write and read back its intermediates.
+    if (targetDesc.payload != ArtifactDesc::Payload::MetalAIR)
+    {
+        cmdLine.addArg("-pipe");
+    }
+
     // TODO(JS): Here we always set -m32 on x86. It could be argued it is only necessary when
     // creating a shared library but if we create an object file, we don't know what to choose
     // because we don't know what final usage is. It could also be argued that the platformKind
@@ -667,9 +695,19 @@ static SlangResult _parseGCCFamilyLine(
         }
     }
 
-    // Files to compile, need to be on the file system.
+    // Files to compile, need to be on the file system, unless passed through standard input.
+    IArtifact* standardInputSource = findStandardInputSource(options);
     for (IArtifact* sourceArtifact : options.sourceArtifacts)
     {
+        if (sourceArtifact == standardInputSource)
+        {
+            // Standard input has no extension to infer the language from.
+            cmdLine.addArg("-x");
+            cmdLine.addArg(options.sourceLanguage == SLANG_SOURCE_LANGUAGE_CPP ? "c++" : "c");
+            cmdLine.addArg("-");
+            continue;
+        }
+
         ComPtr<IOSFileArtifactRepresentation> fileRep;
 
         // TODO(JS):
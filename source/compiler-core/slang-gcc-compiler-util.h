@@ -22,6 +22,10 @@ struct GCCDownstreamCompilerUtil : public DownstreamCompilerUtilBase
     /// Calculate gcc family compilers (including clang) cmdLine arguments from options
     static SlangResult calcArgs(const CompileOptions& options, CommandLine& cmdLine);
 
+    /// Returns the source artifact to pass through standard input, if there is one that
+    /// isn't already on the file system
+    static IArtifact* findStandardInputSource(const CompileOptions& options);
+
     /// Parse ExecuteResult into diagnostics
     static SlangResult parseOutput(const ExecuteResult& exeRes, IArtifactDiagnostics* diagnostics);
 
@@ -62,6 +66,10 @@ public:
     {
         return Util::calcArgs(options, cmdLine);
     }
+    virtual IArtifact* findStandardInputSource(const CompileOptions& options) SLANG_OVERRIDE
+    {
+        return Util::findStandardInputSource(options);
+    }
     virtual SlangResult parseOutput(
         const ExecuteResult& exeResult,
         IArtifactDiagnostics* diagnostics) SLANG_OVERRIDE
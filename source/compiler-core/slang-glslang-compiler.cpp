@@ -59,10 +59,18 @@ public:
 protected:
     SlangResult _invoke(glslang_CompileRequest_1_2& request);
 
+    /// Link `source` with the SPIR-V libraries in `options`, appending the result to `outSpirv`
+    SlangResult _linkSPIRV(
+        ISlangBlob* source,
+        const CompileOptions& options,
+        StringBuilder& diagnosticOutput,
+        List<uint8_t>& outSpirv);
+
     glslang_CompileFunc_1_0 m_compile_1_0 = nullptr;
     glslang_CompileFunc_1_1 m_compile_1_1 = nullptr;
     glslang_CompileFunc_1_2 m_compile_1_2 = nullptr;
     glslang_ValidateSPIRVFunc m_validate = nullptr;
+    glslang_LinkSPIRVFunc m_link = nullptr;
 
     ComPtr<ISlangSharedLibrary> m_sharedLibrary;
 
@@ -75,6 +83,7 @@ SlangResult GlslangDownstreamCompiler::init(ISlangSharedLibrary* library)
     m_compile_1_1 = (glslang_CompileFunc_1_1)library->findFuncByName("glslang_compile_1_1");
     m_compile_1_2 = (glslang_CompileFunc_1_2)library->findFuncByName("glslang_compile_1_2");
     m_validate = (glslang_ValidateSPIRVFunc)library->findFuncByName("glslang_validateSPIRV");
+    m_link = (glslang_LinkSPIRVFunc)library->findFuncByName("glslang_linkSPIRV");
 
 
     if (m_compile_1_0 == nullptr && m_compile_1_1 == nullptr && m_compile_1_2 == nullptr)
@@ -135,6 +144,57 @@ SlangResult GlslangDownstreamCompiler::_invoke(glslang_CompileRequest_1_2& reque
     return err ? SLANG_FAIL : SLANG_OK;
 }
 
+SlangResult GlslangDownstreamCompiler::_linkSPIRV(
+    ISlangBlob* source,
+    const CompileOptions& options,
+    StringBuilder& diagnosticOutput,
+    List<uint8_t>& outSpirv)
+{
+    if (!m_link)
+    {
+        return SLANG_E_NOT_AVAILABLE;
+    }
+
+    List<ComPtr<ISlangBlob>> blobs;
+    blobs.add(ComPtr<ISlangBlob>(source));
+    for (IArtifact* library : options.libraries)
+    {
+        if (library->getDesc().payload != ArtifactPayload::SPIRV)
+        {
+            continue;
+        }
+        ComPtr<ISlangBlob> blob;
+        SLANG_RETURN_ON_FAIL(library->loadBlob(ArtifactKeep::Yes, blob.writeRef()));
+        blobs.add(blob);
+    }
+
+    List<const uint32_t*> modules;
+    List<size_t> moduleWordCounts;
+    for (auto& blob : blobs)
+    {
+        modules.add((const uint32_t*)blob->getBufferPointer());
+        moduleWordCounts.add(blob->getBufferSize() / sizeof(uint32_t));
+    }
+
+    glslang_LinkRequest request;
+    memset(&request, 0, sizeof(request));
+    request.sizeInBytes = sizeof(request);
+
+    request.modules = modules.getBuffer();
+    request.moduleWordCounts = moduleWordCounts.getBuffer();
+    request.moduleCount = size_t(modules.getCount());
+
+    request.diagnosticFunc = [](void const* data, size_t size, void* userData)
+    { (*(StringBuilder*)userData).append((char const*)data, (char const*)data + size); };
+    request.diagnosticUserData = &diagnosticOutput;
+
+    request.outputFunc = [](void const* data, size_t size, void* userData)
+    { ((List<uint8_t>*)userData)->addRange((uint8_t*)data, size); };
+    request.outputUserData = &outSpirv;
+
+    return m_link(&request) ? SLANG_FAIL : SLANG_OK;
+}
+
 static SlangResult _parseDiagnosticLine(
     SliceAllocator& allocator,
     const UnownedStringSlice& line,
@@ -227,6 +287,17 @@ SlangResult GlslangDownstreamCompiler::compile(
     request.inputBegin = inputBegin;
     request.inputEnd = inputBegin + sourceBlob->getBufferSize();
 
+    // Libraries are precompiled SPIR-V that the source imports functions from,
+    // so they are linked in before anything else is done with it.
+    SlangResult linkResult = SLANG_OK;
+    List<uint8_t> linkedSpirv;
+    if (options.libraries.count && options.sourceLanguage == SLANG_SOURCE_LANGUAGE_SPIRV)
+    {
+        linkResult = _linkSPIRV(sourceBlob, options, diagnosticOutput, linkedSpirv);
+        request.inputBegin = linkedSpirv.getBuffer();
+        request.inputEnd = linkedSpirv.getBuffer() + linkedSpirv.getCount();
+    }
+
     // Find the SPIR-V version if set
     SemanticVersion spirvVersion;
     for (const auto& capabilityVersion : options.requiredCapabilityVersions)
@@ -255,7 +326,7 @@ SlangResult GlslangDownstreamCompiler::compile(
 
     request.entryPointName = options.entryPointName.begin();
 
-    const SlangResult invokeResult = _invoke(request);
+    const SlangResult invokeResult = SLANG_SUCCEEDED(linkResult) ? _invoke(request) : linkResult;
 
     auto artifact = ArtifactUtil::createArtifactForCompileTarget(options.targetType);
 
@@ -14,10 +14,12 @@ namespace Slang
 IncludeSystem::IncludeSystem(
     SearchDirectoryList* searchDirectories,
     ISlangFileSystemExt* fileSystemExt,
-    SourceManager* sourceManager)
+    SourceManager* sourceManager,
+    HashSet<String>* missingPaths)
     : m_searchDirectories(searchDirectories)
     , m_fileSystemExt(fileSystemExt)
     , m_sourceManager(sourceManager)
+    , m_missingPaths(missingPaths)
 {
 }
 
@@ -52,10 +54,15 @@ SlangResult IncludeSystem::findFile(
 
     // This checks the path exists
     SlangPathType pathType;
-    SLANG_RETURN_ON_FAIL(m_fileSystemExt->getPathType(combinedPath.begin(), &pathType));
-    if (pathType != SLANG_PATH_TYPE_FILE)
+    const SlangResult pathTypeRes = m_fileSystemExt->getPathType(combinedPath.begin(), &pathType);
+    if (SLANG_FAILED(pathTypeRes) || pathType != SLANG_PATH_TYPE_FILE)
     {
-        return SLANG_E_NOT_FOUND;
+        // A file created here later could change what the search finds
+        if (m_missingPaths)
+        {
+            m_missingPaths->add(combinedPath);
+        }
+        return SLANG_FAILED(pathTypeRes) ? pathTypeRes : SLANG_E_NOT_FOUND;
     }
 
     // Get the uniqueIdentity
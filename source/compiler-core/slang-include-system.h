@@ -3,6 +3,7 @@
 // slang-include-system.h
 
 #include "../compiler-core/slang-source-loc.h"
+#include "../core/slang-dictionary.h"
 
 namespace Slang
 {
@@ -67,16 +68,19 @@ struct IncludeSystem
 
     /// Ctor
     IncludeSystem() = default;
+    /// If `missingPaths` is set, every path probed that didn't name a file is added to it.
     IncludeSystem(
         SearchDirectoryList* searchDirectories,
         ISlangFileSystemExt* fileSystemExt,
-        SourceManager* sourceManager = nullptr);
+        SourceManager* sourceManager = nullptr,
+        HashSet<String>* missingPaths = nullptr);
 
 protected:
     SearchDirectoryList* m_searchDirectories;
     ISlangFileSystemExt* m_fileSystemExt;
     SourceManager*
         m_sourceManager; ///< If not set, will not look up the content in the source manager
+    HashSet<String>* m_missingPaths = nullptr; ///< If set, paths probed without finding a file
 };
 
 } // namespace Slang
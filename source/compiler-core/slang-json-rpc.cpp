@@ -1,5 +1,6 @@
 #include "slang-json-rpc.h"
 
+#include "../core/slang-blob.h"
 #include "slang-com-helper.h"
 #include "slang-json-native.h"
 
@@ -117,10 +118,12 @@ static const StructRttiInfo _makeJSONResultResponseResponseRtti()
 {
     SourceManager* sourceManager = sink->getSourceManager();
 
-    // Now need to parse as JSON
+    // Now need to parse as JSON. The message is copied once into a terminated blob, which the
+    // source file then uses directly, rather than being copied again on the way in.
     String contents(slice);
+    ComPtr<ISlangBlob> contentsBlob = StringBlob::moveCreate(contents);
     SourceFile* sourceFile =
-        sourceManager->createSourceFileWithString(PathInfo::makeUnknown(), contents);
+        sourceManager->createSourceFileWithBlob(PathInfo::makeUnknown(), contentsBlob);
     SourceView* sourceView = sourceManager->createSourceView(sourceFile, nullptr, SourceLoc());
 
     JSONLexer lexer;
@@ -98,6 +98,16 @@ struct SemanticTokensLegend
 };
 
 
+struct SemanticTokensFullOptions
+{
+    /**
+     * The server supports deltas for full documents.
+     */
+    bool delta = false;
+
+    static const StructRttiInfo g_rttiInfo;
+};
+
 struct SemanticTokensOptions
 {
     /**
@@ -114,7 +124,7 @@ struct SemanticTokensOptions
     /**
      * Server supports providing semantic tokens for a full document.
      */
-    bool full = false;
+    SemanticTokensFullOptions full;
 
     static const StructRttiInfo g_rttiInfo;
 };
@@ -287,6 +297,7 @@ struct ServerCapabilities
     bool hoverProvider = false;
     bool definitionProvider = false;
     bool documentSymbolProvider = false;
+    bool workspaceSymbolProvider = false;
     bool documentFormattingProvider = false;
     bool documentRangeFormattingProvider = false;
     DocumentOnTypeFormattingOptions documentOnTypeFormattingProvider;
@@ -676,6 +687,25 @@ struct TextEditCompletionItem
     static const StructRttiInfo g_rttiInfo;
 };
 
+/**
+ * Represents a collection of completion items to be presented in the editor.
+ */
+struct CompletionList
+{
+    /**
+     * This list is not complete. Further typing should result in recomputing
+     * this list.
+     */
+    bool isIncomplete = false;
+
+    /**
+     * The completion items.
+     */
+    List<CompletionItem> items;
+
+    static const StructRttiInfo g_rttiInfo;
+};
+
 struct SemanticTokensParams : WorkDoneProgressParams
 {
     TextDocumentIdentifier textDocument;
@@ -704,6 +734,54 @@ struct SemanticTokens
     static const StructRttiInfo g_rttiInfo;
 };
 
+struct SemanticTokensDeltaParams : WorkDoneProgressParams
+{
+    TextDocumentIdentifier textDocument;
+
+    /**
+     * The result id of a previous response. The result Id can either point to
+     * a full response or a delta response depending on what was received last.
+     */
+    String previousResultId;
+
+    static const UnownedStringSlice methodName;
+
+    static const StructRttiInfo g_rttiInfo;
+};
+
+struct SemanticTokensEdit
+{
+    /**
+     * The start offset of the edit.
+     */
+    uint32_t start = 0;
+
+    /**
+     * The count of elements to remove.
+     */
+    uint32_t deleteCount = 0;
+
+    /**
+     * The elements to insert.
+     */
+    List<uint32_t> data;
+
+    static const StructRttiInfo g_rttiInfo;
+};
+
+struct SemanticTokensDelta
+{
+    String resultId;
+
+    /**
+     * The semantic token edits to transform a previous result into a new
+     * result.
+     */
+    List<SemanticTokensEdit> edits;
+
+    static const StructRttiInfo g_rttiInfo;
+};
+
 struct SignatureHelpParams : WorkDoneProgressParams, TextDocumentPositionParams
 {
     static const UnownedStringSlice methodName;
@@ -969,6 +1047,50 @@ struct DocumentSymbol
     static const StructRttiInfo g_rttiInfo;
 };
 
+/**
+ * The parameters of a Workspace Symbol Request.
+ */
+struct WorkspaceSymbolParams : WorkDoneProgressParams
+{
+    /**
+     * A query string to filter symbols by. Clients may send an empty
+     * string here to request all symbols.
+     */
+    String query;
+
+    static const StructRttiInfo g_rttiInfo;
+    static const UnownedStringSlice methodName;
+};
+
+/**
+ * Represents information about programming constructs like variables, classes,
+ * interfaces etc.
+ */
+struct SymbolInformation
+{
+    /**
+     * The name of this symbol.
+     */
+    String name;
+
+    /**
+     * The kind of this symbol.
+     */
+    SymbolKind kind = 0;
+
+    /**
+     * The location of this symbol.
+     */
+    Location location;
+
+    /**
+     * The name of the symbol containing this symbol.
+     */
+    String containerName;
+
+    static const StructRttiInfo g_rttiInfo;
+};
+
 /**
  * A parameter literal used in inlay hint requests.
  *
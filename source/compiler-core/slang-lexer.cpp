@@ -10,6 +10,16 @@
 #include "slang-name.h"
 #include "slang-source-loc.h"
 
+#if SLANG_PROCESSOR_X86_64
+#include <emmintrin.h>
+#define SLANG_LEXER_SIMD 1
+#elif SLANG_PROCESSOR_ARM_64
+#include <arm_neon.h>
+#define SLANG_LEXER_SIMD 1
+#else
+#define SLANG_LEXER_SIMD 0
+#endif
+
 namespace Slang
 {
 Token TokenReader::getEndOfFileToken()
@@ -285,10 +295,183 @@ static void _handleNewLine(Lexer* lexer)
     _handleNewLineInner(lexer, c);
 }
 
+// The kinds of run of input bytes that `_skipPlainBytes` can skip over.
+//
+// A byte is only "plain" if the slow path (`_peek`/`_advance`) would consume it
+// as a single ASCII code point with no other effect, so escaped newlines
+// (a `\`) and non-ASCII bytes always end a run.
+enum class PlainByteKind
+{
+    HorizontalSpace,  ///< ` ` and `\t`
+    LineCommentText,  ///< Anything but an end of line
+    BlockCommentText, ///< Anything but an end of line or `*`
+    IdentifierChar,   ///< `[a-zA-Z0-9_]`
+    DecimalDigit,     ///< `[0-9]`
+    HexDigit,         ///< `[0-9a-fA-F]`
+};
+
+static SLANG_FORCE_INLINE bool _isInRange(Byte c, char lo, char hi)
+{
+    return Byte(lo) <= c && c <= Byte(hi);
+}
+
+template<PlainByteKind kKind>
+static SLANG_FORCE_INLINE bool _isPlainByte(Byte c)
+{
+    switch (kKind)
+    {
+    case PlainByteKind::HorizontalSpace:
+        return c == ' ' || c == '\t';
+    case PlainByteKind::LineCommentText:
+        return c < 0x80 && c != '\n' && c != '\r' && c != '\\';
+    case PlainByteKind::BlockCommentText:
+        return c < 0x80 && c != '\n' && c != '\r' && c != '\\' && c != '*';
+    case PlainByteKind::IdentifierChar:
+        return _isInRange(c, 'a', 'z') || _isInRange(c, 'A', 'Z') || _isInRange(c, '0', '9') ||
+               c == '_';
+    case PlainByteKind::DecimalDigit:
+        return _isInRange(c, '0', '9');
+    case PlainByteKind::HexDigit:
+        return _isInRange(c, '0', '9') || _isInRange(c, 'a', 'f') || _isInRange(c, 'A', 'F');
+    }
+    return false;
+}
+
+#if SLANG_LEXER_SIMD
+// A minimal set of 16-byte vector operations, where each lane of a mask is
+// either all ones (true) or all zeros (false).
+//
+// Byte comparisons are signed, so non-ASCII bytes (>= 0x80) are never in
+// an ASCII range.
+enum
+{
+    kLexerSimdWidth = 16
+};
+
+#if SLANG_PROCESSOR_X86_64
+typedef __m128i LexerSimdVec;
+
+static SLANG_FORCE_INLINE LexerSimdVec _simdLoad(const char* p)
+{
+    return _mm_loadu_si128((const __m128i*)p);
+}
+static SLANG_FORCE_INLINE LexerSimdVec _simdEq(LexerSimdVec v, char c)
+{
+    return _mm_cmpeq_epi8(v, _mm_set1_epi8(c));
+}
+static SLANG_FORCE_INLINE LexerSimdVec _simdInRange(LexerSimdVec v, char lo, char hi)
+{
+    return _mm_and_si128(
+        _mm_cmpgt_epi8(v, _mm_set1_epi8(char(lo - 1))),
+        _mm_cmplt_epi8(v, _mm_set1_epi8(char(hi + 1))));
+}
+static SLANG_FORCE_INLINE LexerSimdVec _simdIsNonAscii(LexerSimdVec v)
+{
+    return _mm_cmplt_epi8(v, _mm_setzero_si128());
+}
+static SLANG_FORCE_INLINE LexerSimdVec _simdOr(LexerSimdVec a, LexerSimdVec b)
+{
+    return _mm_or_si128(a, b);
+}
+static SLANG_FORCE_INLINE bool _simdAllTrue(LexerSimdVec mask)
+{
+    return _mm_movemask_epi8(mask) == 0xFFFF;
+}
+static SLANG_FORCE_INLINE bool _simdAnyTrue(LexerSimdVec mask)
+{
+    return _mm_movemask_epi8(mask) != 0;
+}
+#else
+typedef uint8x16_t LexerSimdVec;
+
+static SLANG_FORCE_INLINE LexerSimdVec _simdLoad(const char* p)
+{
+    return vld1q_u8((const uint8_t*)p);
+}
+static SLANG_FORCE_INLINE LexerSimdVec _simdEq(LexerSimdVec v, char c)
+{
+    return vceqq_u8(v, vdupq_n_u8(uint8_t(c)));
+}
+static SLANG_FORCE_INLINE LexerSimdVec _simdInRange(LexerSimdVec v, char lo, char hi)
+{
+    const int8x16_t s = vreinterpretq_s8_u8(v);
+    return vandq_u8(vcgeq_s8(s, vdupq_n_s8(int8_t(lo))), vcleq_s8(s, vdupq_n_s8(int8_t(hi))));
+}
+static SLANG_FORCE_INLINE LexerSimdVec _simdIsNonAscii(LexerSimdVec v)
+{
+    return vcltq_s8(vreinterpretq_s8_u8(v), vdupq_n_s8(0));
+}
+static SLANG_FORCE_INLINE LexerSimdVec _simdOr(LexerSimdVec a, LexerSimdVec b)
+{
+    return vorrq_u8(a, b);
+}
+static SLANG_FORCE_INLINE bool _simdAllTrue(LexerSimdVec mask)
+{
+    return vminvq_u8(mask) == 0xFF;
+}
+static SLANG_FORCE_INLINE bool _simdAnyTrue(LexerSimdVec mask)
+{
+    return vmaxvq_u8(mask) != 0;
+}
+#endif
+
+// Returns true if all of the bytes in `v` are plain for `kKind`.
+template<PlainByteKind kKind>
+static SLANG_FORCE_INLINE bool _isPlainChunk(LexerSimdVec v)
+{
+    switch (kKind)
+    {
+    case PlainByteKind::HorizontalSpace:
+        return _simdAllTrue(_simdOr(_simdEq(v, ' '), _simdEq(v, '\t')));
+    case PlainByteKind::LineCommentText:
+        return !_simdAnyTrue(_simdOr(
+            _simdOr(_simdEq(v, '\n'), _simdEq(v, '\r')),
+            _simdOr(_simdEq(v, '\\'), _simdIsNonAscii(v))));
+    case PlainByteKind::BlockCommentText:
+        return !_simdAnyTrue(_simdOr(
+            _simdOr(_simdOr(_simdEq(v, '\n'), _simdEq(v, '\r')), _simdEq(v, '*')),
+            _simdOr(_simdEq(v, '\\'), _simdIsNonAscii(v))));
+    case PlainByteKind::IdentifierChar:
+        return _simdAllTrue(_simdOr(
+            _simdOr(_simdInRange(v, 'a', 'z'), _simdInRange(v, 'A', 'Z')),
+            _simdOr(_simdInRange(v, '0', '9'), _simdEq(v, '_'))));
+    case PlainByteKind::DecimalDigit:
+        return _simdAllTrue(_simdInRange(v, '0', '9'));
+    case PlainByteKind::HexDigit:
+        return _simdAllTrue(_simdOr(
+            _simdInRange(v, '0', '9'),
+            _simdOr(_simdInRange(v, 'a', 'f'), _simdInRange(v, 'A', 'F'))));
+    }
+    return false;
+}
+#endif
+
+// Advance the cursor past a run of plain bytes of the given kind, a whole
+// vector at a time where possible. This is purely an optimization: the
+// caller's ordinary per-code-point loop handles whatever ends the run.
+template<PlainByteKind kKind>
+static void _skipPlainBytes(Lexer* lexer)
+{
+    const char* cursor = lexer->m_cursor;
+    const char* const end = lexer->m_end;
+
+#if SLANG_LEXER_SIMD
+    while (end - cursor >= kLexerSimdWidth && _isPlainChunk<kKind>(_simdLoad(cursor)))
+        cursor += kLexerSimdWidth;
+#endif
+
+    while (cursor != end && _isPlainByte<kKind>(Byte(*cursor)))
+        cursor++;
+
+    lexer->m_cursor = cursor;
+}
+
 static void _lexLineComment(Lexer* lexer)
 {
     for (;;)
     {
+        _skipPlainBytes<PlainByteKind::LineCommentText>(lexer);
+
         switch (_peek(lexer))
         {
         case '\n':
@@ -307,6 +490,8 @@ static void _lexBlockComment(Lexer* lexer)
 {
     for (;;)
     {
+        _skipPlainBytes<PlainByteKind::BlockCommentText>(lexer);
+
         switch (_peek(lexer))
         {
         case kEOF:
@@ -341,6 +526,8 @@ static void _lexHorizontalSpace(Lexer* lexer)
 {
     for (;;)
     {
+        _skipPlainBytes<PlainByteKind::HorizontalSpace>(lexer);
+
         switch (_peek(lexer))
         {
         case ' ':
@@ -363,6 +550,8 @@ static void _lexIdentifier(Lexer* lexer)
 {
     for (;;)
     {
+        _skipPlainBytes<PlainByteKind::IdentifierChar>(lexer);
+
         int c = _peek(lexer);
         if (('a' <= c) && (c <= 'z') || ('A' <= c) && (c <= 'Z') || ('0' <= c) && (c <= '9') ||
             (c == '_') || isNonAsciiCodePoint((unsigned int)c))
@@ -383,6 +572,12 @@ static void _lexDigits(Lexer* lexer, int base)
 {
     for (;;)
     {
+        // Every digit is valid for these bases, so runs of them can be skipped.
+        if (base == 10)
+            _skipPlainBytes<PlainByteKind::DecimalDigit>(lexer);
+        else if (base == 16)
+            _skipPlainBytes<PlainByteKind::HexDigit>(lexer);
+
         int c = _peek(lexer);
 
         int digitVal = 0;
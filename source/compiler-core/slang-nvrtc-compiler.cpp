@@ -109,6 +109,8 @@ public:
     canConvert(const ArtifactDesc& from, const ArtifactDesc& to) SLANG_OVERRIDE;
     virtual SLANG_NO_THROW SlangResult SLANG_MCALL
     convert(IArtifact* from, const ArtifactDesc& to, IArtifact** outArtifact) SLANG_OVERRIDE;
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL getVersionString(slang::IBlob** outVersionString)
+        SLANG_OVERRIDE;
 
     /// Must be called before use
     SlangResult init(ISlangSharedLibrary* library);
@@ -1108,6 +1110,20 @@ SlangResult NVRTCDownstreamCompiler::compile(
     return SLANG_OK;
 }
 
+SlangResult NVRTCDownstreamCompiler::getVersionString(slang::IBlob** outVersionString)
+{
+    StringBuilder versionString;
+    m_desc.version.append(versionString);
+
+    // The version is only major/minor, so the library timestamp is used to tell builds apart.
+    versionString << " "
+                  << SharedLibraryUtils::getSharedLibraryTimestamp(
+                         reinterpret_cast<void*>(m_nvrtcCreateProgram));
+
+    *outVersionString = StringBlob::moveCreate(versionString).detach();
+    return SLANG_OK;
+}
+
 bool NVRTCDownstreamCompiler::canConvert(const ArtifactDesc& from, const ArtifactDesc& to)
 {
     return ArtifactDescUtil::isDisassembly(from, to) || ArtifactDescUtil::isDisassembly(to, from);
@@ -50,8 +50,11 @@ SlangResult writePerfectHashLookupCppFile(
     String enumName,
     String enumerantPrefix,
     String enumHeaderFile,
-    DiagnosticSink* sink)
+    DiagnosticSink* sink,
+    const List<String>& enumerants)
 {
+    SLANG_ASSERT(enumerants.getCount() == 0 || enumerants.getCount() == opnames.getCount());
+
     HashParams hashParams;
     auto r = minimalPerfectHash(opnames, hashParams);
     switch (r)
@@ -76,7 +79,10 @@ SlangResult writePerfectHashLookupCppFile(
     List<String> values;
     values.reserve(hashParams.destTable.getCount());
     for (const auto& v : hashParams.destTable)
-        values.add(enumerantPrefix + v);
+    {
+        const Index index = enumerants.getCount() ? opnames.indexOf(v) : -1;
+        values.add(enumerantPrefix + (index >= 0 ? enumerants[index] : v));
+    }
     return writeHashFile(
         fileName,
         enumName,
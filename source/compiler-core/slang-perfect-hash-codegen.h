@@ -5,11 +5,15 @@
 
 namespace Slang
 {
+/// Write a function `lookup<enumName>` that finds the enumerant of each of `opnames`. The
+/// enumerant of a name is `enumPrefix` followed by its entry in `enumerants`, or by the name
+/// itself if `enumerants` is empty.
 SlangResult writePerfectHashLookupCppFile(
     String fileName,
     List<String> opnames,
     String enumName,
     String enumPrefix,
     String enumHeaderFile,
-    DiagnosticSink* sink);
+    DiagnosticSink* sink,
+    const List<String>& enumerants = List<String>());
 }
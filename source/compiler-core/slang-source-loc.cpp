@@ -468,6 +468,7 @@ void SourceFile::setLineBreakOffsets(const uint32_t* offsets, UInt numOffsets)
 {
     m_lineBreakOffsets.clear();
     m_lineBreakOffsets.addRange(offsets, numOffsets);
+    m_lastLineIndex = 0;
 }
 
 const List<uint32_t>& SourceFile::getLineBreakOffsets()
@@ -549,10 +550,27 @@ int SourceFile::calcLineIndexFromOffset(int offset)
     const auto& lineBreakOffsets = getLineBreakOffsets();
 
     // At this point we can assume the `lineBreakOffsets` array has been filled in.
-    // We will use a binary search to find the line index that contains our
+    // Try the line of the previous lookup and the one after it first, as locations
+    // are mostly mapped in source order.
+    const Index lineCount = lineBreakOffsets.getCount();
+    const auto isOnLine = [&](Index lineIndex)
+    {
+        return lineIndex < lineCount && lineBreakOffsets[lineIndex] <= uint32_t(offset) &&
+               (lineIndex + 1 == lineCount || uint32_t(offset) < lineBreakOffsets[lineIndex + 1]);
+    };
+    if (isOnLine(m_lastLineIndex))
+    {
+        return int(m_lastLineIndex);
+    }
+    if (isOnLine(m_lastLineIndex + 1))
+    {
+        return int(++m_lastLineIndex);
+    }
+
+    // Otherwise we will use a binary search to find the line index that contains our
     // chosen offset.
     Index lo = 0;
-    Index hi = lineBreakOffsets.getCount();
+    Index hi = lineCount;
 
     while (lo + 1 < hi)
     {
@@ -568,6 +586,7 @@ int SourceFile::calcLineIndexFromOffset(int offset)
         }
     }
 
+    m_lastLineIndex = lo;
     return int(lo);
 }
 
@@ -611,6 +630,16 @@ int SourceFile::calcColumnIndex(int lineIndex, int offset, int tabSize)
 
 /* !!!!!!!!!!!!!!!!!!!!!!!!! SourceFile !!!!!!!!!!!!!!!!!!!!!!!!!!!! */
 
+static bool _isTerminated(ISlangBlob* blob)
+{
+    ComPtr<ICastable> castable;
+    if (SLANG_SUCCEEDED(blob->queryInterface(SLANG_IID_PPV_ARGS(castable.writeRef()))))
+    {
+        return castable->castAs(SlangTerminatedChars::getTypeGuid()) != nullptr;
+    }
+    return false;
+}
+
 void SourceFile::setContents(ISlangBlob* blob)
 {
     const UInt rawContentSize = blob->getBufferSize();
@@ -624,13 +653,22 @@ void SourceFile::setContents(ISlangBlob* blob)
     auto type = CharEncoding::determineEncoding(rawContentBegin, rawContentSize, offset);
     SLANG_ASSERT(rawContentSize >= offset);
 
-    List<char> decodedBuffer;
-    CharEncoding::getEncoding(type)->decode(
-        rawContentBegin + offset,
-        int(rawContentSize - offset),
-        decodedBuffer);
+    if (type == CharEncodeType::UTF8 && offset == 0 && _isTerminated(blob))
+    {
+        // Decoding UTF-8 without a BOM is just a copy, so if the blob is already terminated
+        // its contents can be used as they are.
+        m_contentBlob = blob;
+    }
+    else
+    {
+        List<char> decodedBuffer;
+        CharEncoding::getEncoding(type)->decode(
+            rawContentBegin + offset,
+            int(rawContentSize - offset),
+            decodedBuffer);
 
-    m_contentBlob = RawBlob::create(decodedBuffer.getBuffer(), decodedBuffer.getCount());
+        m_contentBlob = RawBlob::create(decodedBuffer.getBuffer(), decodedBuffer.getCount());
+    }
 
     char const* decodedContentBegin = (char const*)m_contentBlob->getBufferPointer();
     const UInt decodedContentSize = m_contentBlob->getBufferSize();
@@ -737,6 +775,7 @@ void SourceManager::_resetSource()
     }
 
     m_sourceViews.clear();
+    m_viewPageTable.clear();
     m_sourceFiles.clear();
 
     m_sourceFileMap.clear();
@@ -819,6 +858,15 @@ SourceView* SourceManager::createSourceView(
         sourceView = new SourceView(sourceFile, range, nullptr, initiatingSourceLoc);
     }
 
+    // Every page up to the end of the new view that doesn't have an entry yet has no
+    // view that ends in it before this one.
+    const Index viewIndex = m_sourceViews.getCount();
+    const Index lastPageIndex = _getViewPageIndex(range.end);
+    while (m_viewPageTable.getCount() <= lastPageIndex)
+    {
+        m_viewPageTable.add(viewIndex);
+    }
+
     m_sourceViews.add(sourceView);
 
     return sourceView;
@@ -826,17 +874,29 @@ SourceView* SourceManager::createSourceView(
 
 SourceView* SourceManager::findSourceView(SourceLoc loc) const
 {
-    Index hi = m_sourceViews.getCount();
     // It must be in the range of this manager and have associated views for it to possibly be a hit
-    if (!getSourceRange().contains(loc) || hi == 0)
+    if (!getSourceRange().contains(loc) || m_sourceViews.getCount() == 0)
+    {
+        return nullptr;
+    }
+
+    // Locations after the end of the last view don't have a page entry
+    const Index pageIndex = _getViewPageIndex(loc);
+    if (pageIndex >= m_viewPageTable.getCount())
     {
         return nullptr;
     }
 
+    // Only the views from the first one that reaches this page, up to and including the
+    // first one that reaches the next page, can contain the location.
+    Index lo = m_viewPageTable[pageIndex];
+    Index hi = (pageIndex + 1 < m_viewPageTable.getCount()) ? m_viewPageTable[pageIndex + 1] + 1
+                                                            : m_sourceViews.getCount();
+
     // If we don't have very many, we may as well just linearly search
-    if (hi <= 8)
+    if (hi - lo <= 8)
     {
-        for (int i = 0; i < hi; ++i)
+        for (Index i = lo; i < hi; ++i)
         {
             SourceView* view = m_sourceViews[i];
             if (view->getRange().contains(loc))
@@ -850,7 +910,6 @@ SourceView* SourceManager::findSourceView(SourceLoc loc) const
     const SourceLoc::RawValue rawLoc = loc.getRaw();
 
     // Binary chop to see if we can find the associated SourceUnit
-    Index lo = 0;
     while (lo + 1 < hi)
     {
         Index mid = (hi + lo) >> 1;
@@ -992,6 +1051,11 @@ void SourceManager::addSourceFileIfNotExist(const String& uniqueIdentity, Source
     m_sourceFileMap.addIfNotExists(uniqueIdentity, sourceFile);
 }
 
+void SourceManager::removeSourceFile(const String& uniqueIdentity)
+{
+    m_sourceFileMap.remove(uniqueIdentity);
+}
+
 HumaneSourceLoc SourceManager::getHumaneLoc(SourceLoc loc, SourceLocType type)
 {
     SourceView* sourceView = findSourceViewRecursively(loc);
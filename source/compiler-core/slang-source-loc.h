@@ -351,6 +351,10 @@ protected:
     // the input file:
     List<uint32_t> m_lineBreakOffsets;
 
+    // The line found by the last call to `calcLineIndexFromOffset`. Locations are mostly
+    // looked up in source order, so the next offset is usually on the same or the next line.
+    Index m_lastLineIndex = 0;
+
     // If set then the locations in this file are really from locations from elsewhere,
     // where the SourceMap specifies that mapping
     ComPtr<IBoxValue<SourceMap>> m_sourceMap;
@@ -563,6 +567,10 @@ struct SourceManager
     /// Add a source file, uniqueIdentity must be unique for this manager AND any parents
     void addSourceFile(const String& uniqueIdentity, SourceFile* sourceFile);
     void addSourceFileIfNotExist(const String& uniqueIdentity, SourceFile* sourceFile);
+    /// Stop finding the source file with `uniqueIdentity` on this manager, so that the next
+    /// load of it reads its contents again. The SourceFile itself stays owned by the manager,
+    /// so existing locations into it remain valid.
+    void removeSourceFile(const String& uniqueIdentity);
 
     /// Get the slice pool
     StringSlicePool& getStringSlicePool() { return m_slicePool; }
@@ -610,9 +618,23 @@ protected:
     // The location to be used by the next source file to be loaded
     SourceLoc m_nextLoc;
 
+    /// Every page of this many locations, from `m_startLoc` on, has an entry in
+    /// `m_viewPageTable`.
+    static const int kViewPageShift = 12;
+
+    Index _getViewPageIndex(SourceLoc loc) const
+    {
+        return Index((loc.getRaw() - m_startLoc.getRaw()) >> kViewPageShift);
+    }
+
     // All of the SourceViews constructed on this SourceManager. These are held in increasing order
     // of range, so can find by doing a binary chop.
     List<SourceView*> m_sourceViews;
+
+    // For each page of locations, the index in `m_sourceViews` of the first view that ends
+    // in or after that page. The view containing a location is therefore between the entries
+    // of its page and the next page, which bounds the search to the few views in one page.
+    List<Index> m_viewPageTable;
     // All of the SourceFiles constructed on this SourceManager. This owns the SourceFile.
     List<SourceFile*> m_sourceFiles;
 
@@ -19,9 +19,10 @@
 namespace Slang
 {
 
-SlangResult loadArchiveFileSystem(
+static SlangResult _createArchiveFileSystemFor(
     const void* data,
     size_t dataSizeInBytes,
+    ComPtr<IArchiveFileSystem>& outArchiveFileSystem,
     ComPtr<ISlangFileSystemExt>& outFileSystem)
 {
     ComPtr<ISlangMutableFileSystem> fileSystem;
@@ -46,12 +47,55 @@ SlangResult loadArchiveFileSystem(
         return SLANG_FAIL;
     }
 
+    outArchiveFileSystem = archiveFileSystem;
+    outFileSystem = fileSystem;
+    return SLANG_OK;
+}
+
+SlangResult loadArchiveFileSystem(
+    const void* data,
+    size_t dataSizeInBytes,
+    ComPtr<ISlangFileSystemExt>& outFileSystem)
+{
+    ComPtr<IArchiveFileSystem> archiveFileSystem;
+    ComPtr<ISlangFileSystemExt> fileSystem;
+    SLANG_RETURN_ON_FAIL(
+        _createArchiveFileSystemFor(data, dataSizeInBytes, archiveFileSystem, fileSystem));
     SLANG_RETURN_ON_FAIL(archiveFileSystem->loadArchive(data, dataSizeInBytes));
 
     outFileSystem = fileSystem;
     return SLANG_OK;
 }
 
+SlangResult loadArchiveFileSystem(ISlangBlob* archive, ComPtr<ISlangFileSystemExt>& outFileSystem)
+{
+    if (!archive)
+    {
+        return SLANG_E_INVALID_ARG;
+    }
+
+    ComPtr<IArchiveFileSystem> archiveFileSystem;
+    ComPtr<ISlangFileSystemExt> fileSystem;
+    SLANG_RETURN_ON_FAIL(_createArchiveFileSystemFor(
+        archive->getBufferPointer(),
+        archive->getBufferSize(),
+        archiveFileSystem,
+        fileSystem));
+    SLANG_RETURN_ON_FAIL(archiveFileSystem->loadArchiveInPlace(archive));
+
+    outFileSystem = fileSystem;
+    return SLANG_OK;
+}
+
+SlangResult loadArchiveFileSystemFromFile(
+    const String& path,
+    ComPtr<ISlangFileSystemExt>& outFileSystem)
+{
+    ComPtr<ISlangBlob> archive;
+    SLANG_RETURN_ON_FAIL(File::map(path, archive));
+    return loadArchiveFileSystem(archive, outFileSystem);
+}
+
 SlangResult createArchiveFileSystem(
     SlangArchiveType type,
     ComPtr<ISlangMutableFileSystem>& outFileSystem)
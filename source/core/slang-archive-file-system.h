@@ -19,6 +19,9 @@ class IArchiveFileSystem : public ISlangCastable
     /// Loads an archive.
     SLANG_NO_THROW virtual SlangResult SLANG_MCALL
     loadArchive(const void* archive, size_t archiveSizeInBytes) = 0;
+    /// Loads an archive without copying it. The file system keeps a reference to the blob, and
+    /// reads the archive from its contents in place for as long as it needs them.
+    SLANG_NO_THROW virtual SlangResult SLANG_MCALL loadArchiveInPlace(ISlangBlob* archive) = 0;
     /// Get as an archive (that can be saved to disk)
     /// NOTE! If the blob is not owned, it's contents can be invalidated by any call to a method of
     /// the file system or loss of scope
@@ -32,6 +35,13 @@ SlangResult loadArchiveFileSystem(
     const void* data,
     size_t dataSizeInBytes,
     ComPtr<ISlangFileSystemExt>& outFileSystem);
+/// Load an archive file system that reads the archive blob in place
+SlangResult loadArchiveFileSystem(ISlangBlob* archive, ComPtr<ISlangFileSystemExt>& outFileSystem);
+/// Load an archive file system from the archive file at path. The file is mapped into memory
+/// rather than read, so with an uncompressed archive only the files that are used are read.
+SlangResult loadArchiveFileSystemFromFile(
+    const String& path,
+    ComPtr<ISlangFileSystemExt>& outFileSystem);
 SlangResult createArchiveFileSystem(
     SlangArchiveType type,
     ComPtr<ISlangMutableFileSystem>& outFileSystem);
@@ -0,0 +1,329 @@
+#include "slang-block-compression-util.h"
+
+#include "slang-math.h"
+#include "slang-task-util.h"
+
+#include <atomic>
+#include <string.h>
+
+namespace Slang
+{
+
+namespace
+{
+
+struct BlockHeader
+{
+    uint32_t uncompressedSize; ///< 0 for the block that ends the sequence
+    uint32_t compressedSize;   ///< The same as uncompressedSize if the block is stored as is
+};
+
+/// A block to decompress
+struct BlockInfo
+{
+    BlockHeader header;
+    size_t srcOffset; ///< Offset of the compressed data
+    size_t dstOffset; ///< Offset the block decompresses to
+};
+
+} // namespace
+
+/// The number of blocks of a stream that are worth processing together, so every thread used
+/// has a block to work on.
+static size_t _calcStreamBatchBlockCount()
+{
+    const Index kMaxBatchBlockCount = 16;
+    return size_t(TaskUtil::calcExtraWorkerCount(kMaxBatchBlockCount) + 1);
+}
+
+static SlangResult _checkBlockHeader(const BlockHeader& header)
+{
+    return (header.uncompressedSize <= BlockCompressionUtil::kMaxBlockSize &&
+            header.compressedSize <= header.uncompressedSize && header.compressedSize > 0)
+               ? SLANG_OK
+               : SLANG_FAIL;
+}
+
+static void _addBlock(List<uint8_t>& ioCompressed, const BlockHeader& header, const void* data)
+{
+    ioCompressed.addRange((const uint8_t*)&header, Index(sizeof(header)));
+    ioCompressed.addRange((const uint8_t*)data, Index(header.compressedSize));
+}
+
+/// Compress srcSize bytes at src as blocks of blockSize, appending them to ioCompressed
+static SlangResult _compressBlocks(
+    ICompressionSystem* system,
+    const CompressionStyle* style,
+    const uint8_t* src,
+    size_t srcSize,
+    size_t blockSize,
+    List<uint8_t>& ioCompressed)
+{
+    const Index blockCount = Index((srcSize + blockSize - 1) / blockSize);
+
+    List<ComPtr<ISlangBlob>> blobs;
+    blobs.setCount(blockCount);
+    List<SlangResult> results;
+    results.setCount(blockCount);
+
+    std::atomic<Index> nextBlockIndex(0);
+    auto worker = [&]()
+    {
+        for (Index i = nextBlockIndex++; i < blockCount; i = nextBlockIndex++)
+        {
+            const size_t offset = size_t(i) * blockSize;
+            results[i] = system->compress(
+                style,
+                src + offset,
+                Math::Min(blockSize, srcSize - offset),
+                blobs[i].writeRef());
+        }
+    };
+    TaskUtil::runWorkers(nullptr, TaskUtil::calcExtraWorkerCount(blockCount), worker);
+
+    for (Index i = 0; i < blockCount; ++i)
+    {
+        SLANG_RETURN_ON_FAIL(results[i]);
+
+        const size_t offset = size_t(i) * blockSize;
+        BlockHeader header;
+        header.uncompressedSize = uint32_t(Math::Min(blockSize, srcSize - offset));
+
+        // Data that doesn't compress is stored as is
+        ISlangBlob* blob = blobs[i];
+        if (blob->getBufferSize() < header.uncompressedSize)
+        {
+            header.compressedSize = uint32_t(blob->getBufferSize());
+            _addBlock(ioCompressed, header, blob->getBufferPointer());
+        }
+        else
+        {
+            header.compressedSize = header.uncompressedSize;
+            _addBlock(ioCompressed, header, src + offset);
+        }
+    }
+    return SLANG_OK;
+}
+
+static void _addEndBlock(List<uint8_t>& ioCompressed)
+{
+    const BlockHeader header = {0, 0};
+    ioCompressed.addRange((const uint8_t*)&header, Index(sizeof(header)));
+}
+
+static SlangResult _decompressBlocks(
+    ICompressionSystem* system,
+    const uint8_t* src,
+    const List<BlockInfo>& blocks,
+    uint8_t* dst)
+{
+    const Index blockCount = blocks.getCount();
+
+    List<SlangResult> results;
+    results.setCount(blockCount);
+
+    std::atomic<Index> nextBlockIndex(0);
+    auto worker = [&]()
+    {
+        for (Index i = nextBlockIndex++; i < blockCount; i = nextBlockIndex++)
+        {
+            const BlockInfo& block = blocks[i];
+            if (block.header.compressedSize == block.header.uncompressedSize)
+            {
+                ::memcpy(dst + block.dstOffset, src + block.srcOffset, block.header.compressedSize);
+                results[i] = SLANG_OK;
+            }
+            else
+            {
+                results[i] = system->decompress(
+                    src + block.srcOffset,
+                    block.header.compressedSize,
+                    block.header.uncompressedSize,
+                    dst + block.dstOffset);
+            }
+        }
+    };
+    TaskUtil::runWorkers(nullptr, TaskUtil::calcExtraWorkerCount(blockCount), worker);
+
+    for (auto result : results)
+    {
+        SLANG_RETURN_ON_FAIL(result);
+    }
+    return SLANG_OK;
+}
+
+/// Read up to size bytes, stopping early only at the end of the stream
+static SlangResult _read(Stream* stream, uint8_t* dst, size_t size, size_t& outReadSize)
+{
+    outReadSize = 0;
+    while (outReadSize < size && !stream->isEnd())
+    {
+        size_t readSize = 0;
+        SLANG_RETURN_ON_FAIL(stream->read(dst + outReadSize, size - outReadSize, readSize));
+        outReadSize += readSize;
+    }
+    return SLANG_OK;
+}
+
+/* static */ SlangResult BlockCompressionUtil::compress(
+    ICompressionSystem* system,
+    const CompressionStyle* style,
+    const void* src,
+    size_t srcSize,
+    List<uint8_t>& outCompressed,
+    size_t blockSize)
+{
+    if (blockSize == 0 || blockSize > kMaxBlockSize)
+    {
+        return SLANG_E_INVALID_ARG;
+    }
+
+    outCompressed.clear();
+    SLANG_RETURN_ON_FAIL(
+        _compressBlocks(system, style, (const uint8_t*)src, srcSize, blockSize, outCompressed));
+    _addEndBlock(outCompressed);
+    return SLANG_OK;
+}
+
+/* static */ SlangResult BlockCompressionUtil::decompress(
+    ICompressionSystem* system,
+    const void* compressed,
+    size_t compressedSize,
+    List<uint8_t>& outDecompressed)
+{
+    const uint8_t* const src = (const uint8_t*)compressed;
+
+    // Find all of the blocks first, so they can be decompressed in place, and at the same time
+    List<BlockInfo> blocks;
+    size_t srcOffset = 0;
+    size_t dstOffset = 0;
+    for (;;)
+    {
+        BlockInfo block;
+        if (compressedSize - srcOffset < sizeof(block.header))
+        {
+            return SLANG_FAIL;
+        }
+        ::memcpy(&block.header, src + srcOffset, sizeof(block.header));
+        srcOffset += sizeof(block.header);
+
+        if (block.header.uncompressedSize == 0)
+        {
+            break;
+        }
+        SLANG_RETURN_ON_FAIL(_checkBlockHeader(block.header));
+        if (compressedSize - srcOffset < block.header.compressedSize)
+        {
+            return SLANG_FAIL;
+        }
+
+        block.srcOffset = srcOffset;
+        block.dstOffset = dstOffset;
+        blocks.add(block);
+
+        srcOffset += block.header.compressedSize;
+        dstOffset += block.header.uncompressedSize;
+    }
+
+    outDecompressed.setCount(Index(dstOffset));
+    return _decompressBlocks(system, src, blocks, outDecompressed.getBuffer());
+}
+
+/* static */ SlangResult BlockCompressionUtil::compress(
+    ICompressionSystem* system,
+    const CompressionStyle* style,
+    Stream* src,
+    Stream* dst,
+    size_t blockSize)
+{
+    if (blockSize == 0 || blockSize > kMaxBlockSize)
+    {
+        return SLANG_E_INVALID_ARG;
+    }
+
+    const size_t batchSize = blockSize * _calcStreamBatchBlockCount();
+
+    List<uint8_t> uncompressed;
+    uncompressed.setCount(Index(batchSize));
+    List<uint8_t> compressed;
+
+    for (;;)
+    {
+        size_t readSize = 0;
+        SLANG_RETURN_ON_FAIL(_read(src, uncompressed.getBuffer(), batchSize, readSize));
+
+        compressed.clear();
+        SLANG_RETURN_ON_FAIL(_compressBlocks(
+            system,
+            style,
+            uncompressed.getBuffer(),
+            readSize,
+            blockSize,
+            compressed));
+
+        // Reading less than asked for means the end of the stream was reached
+        const bool isLastBatch = readSize < batchSize;
+        if (isLastBatch)
+        {
+            _addEndBlock(compressed);
+        }
+
+        SLANG_RETURN_ON_FAIL(dst->write(compressed.getBuffer(), size_t(compressed.getCount())));
+        if (isLastBatch)
+        {
+            return SLANG_OK;
+        }
+    }
+}
+
+/* static */ SlangResult BlockCompressionUtil::decompress(
+    ICompressionSystem* system,
+    Stream* src,
+    Stream* dst)
+{
+    const size_t batchBlockCount = _calcStreamBatchBlockCount();
+
+    List<BlockInfo> blocks;
+    List<uint8_t> compressed;
+    List<uint8_t> decompressed;
+
+    for (bool isAtEnd = false; !isAtEnd;)
+    {
+        blocks.clear();
+        compressed.clear();
+        size_t dstOffset = 0;
+
+        while (size_t(blocks.getCount()) < batchBlockCount)
+        {
+            BlockInfo block;
+            SLANG_RETURN_ON_FAIL(src->readExactly(&block.header, sizeof(block.header)));
+            if (block.header.uncompressedSize == 0)
+            {
+                isAtEnd = true;
+                break;
+            }
+            SLANG_RETURN_ON_FAIL(_checkBlockHeader(block.header));
+
+            block.srcOffset = size_t(compressed.getCount());
+            block.dstOffset = dstOffset;
+            compressed.setCount(compressed.getCount() + Index(block.header.compressedSize));
+            SLANG_RETURN_ON_FAIL(src->readExactly(
+                compressed.getBuffer() + block.srcOffset,
+                block.header.compressedSize));
+
+            blocks.add(block);
+            dstOffset += block.header.uncompressedSize;
+        }
+
+        decompressed.setCount(Index(dstOffset));
+        SLANG_RETURN_ON_FAIL(
+            _decompressBlocks(system, compressed.getBuffer(), blocks, decompressed.getBuffer()));
+        if (dstOffset)
+        {
+            SLANG_RETURN_ON_FAIL(dst->write(decompressed.getBuffer(), dstOffset));
+        }
+    }
+    return SLANG_OK;
+}
+
+} // namespace Slang
@@ -0,0 +1,60 @@
+#ifndef SLANG_BLOCK_COMPRESSION_UTIL_H
+#define SLANG_BLOCK_COMPRESSION_UTIL_H
+
+#include "slang-basic.h"
+#include "slang-compression-system.h"
+#include "slang-stream.h"
+
+namespace Slang
+{
+
+/* Compresses data as a sequence of blocks that are each compressed on their own.
+
+As a block only needs itself to be decompressed, the blocks of a buffer are compressed and
+decompressed on several threads, and a stream can be processed a few blocks at a time, rather
+than needing all of its input and output in memory.
+
+Each block is a header of two uint32_t, its size uncompressed and its size compressed, followed
+by the compressed data. A block that doesn't get smaller is stored as is, which is the case
+exactly when the two sizes are the same. The sequence ends with a block whose size uncompressed
+is 0, so a stream can be read up to the end of the data without knowing its size. */
+struct BlockCompressionUtil
+{
+    /// The size of the uncompressed blocks if no other size is given
+    static const size_t kDefaultBlockSize = 1024 * 1024;
+    /// The largest size of a block uncompressed. Reading a block that is larger fails.
+    static const size_t kMaxBlockSize = 64 * 1024 * 1024;
+
+    /// Compress srcSize bytes at src into outCompressed
+    static SlangResult compress(
+        ICompressionSystem* system,
+        const CompressionStyle* style,
+        const void* src,
+        size_t srcSize,
+        List<uint8_t>& outCompressed,
+        size_t blockSize = kDefaultBlockSize);
+
+    /// Decompress data produced by compress into outDecompressed
+    static SlangResult decompress(
+        ICompressionSystem* system,
+        const void* compressed,
+        size_t compressedSize,
+        List<uint8_t>& outDecompressed);
+
+    /// Compress everything that can be read from src, writing the blocks to dst.
+    /// At most a few blocks, one for each thread used, are held in memory at a time.
+    static SlangResult compress(
+        ICompressionSystem* system,
+        const CompressionStyle* style,
+        Stream* src,
+        Stream* dst,
+        size_t blockSize = kDefaultBlockSize);
+
+    /// Decompress blocks read from src, up to and including the block that ends them, writing
+    /// the decompressed data to dst.
+    static SlangResult decompress(ICompressionSystem* system, Stream* src, Stream* dst);
+};
+
+} // namespace Slang
+
+#endif
@@ -11,6 +11,9 @@
 #include "slang-crypto.h"
 
 #include "../core/slang-char-util.h"
+#include "../core/slang-math.h"
+
+#include <string.h>
 
 namespace Slang
 {
@@ -340,13 +343,23 @@ void SHA1::update(const void* data, SlangSizeT len)
     }
 
     const uint8_t* ptr = reinterpret_cast<const uint8_t*>(data);
+    m_bits += uint64_t(len) * 8;
 
-    // Fill up buffer if not full.
-    while (len > 0 && m_index != 0)
+    // Fill up buffer if not full. Most updates are small, so they are copied in bulk
+    // rather than a byte at a time.
+    if (m_index != 0)
     {
-        addByte(*ptr++);
-        m_bits += 8;
-        len--;
+        const SlangSizeT count = Math::Min(len, SlangSizeT(sizeof(m_buf) - m_index));
+        memcpy(m_buf + m_index, ptr, count);
+        m_index += uint32_t(count);
+        ptr += count;
+        len -= count;
+        if (m_index < sizeof(m_buf))
+        {
+            return;
+        }
+        m_index = 0;
+        processBlock(m_buf);
     }
 
     // Process full blocks.
@@ -355,16 +368,11 @@ void SHA1::update(const void* data, SlangSizeT len)
         processBlock(ptr);
         ptr += sizeof(m_buf);
         len -= sizeof(m_buf);
-        m_bits += sizeof(m_buf) * 8;
     }
 
-    // Process remaining bytes.
-    while (len > 0)
-    {
-        addByte(*ptr++);
-        m_bits += 8;
-        len--;
-    }
+    // Keep the remaining bytes for the next block.
+    memcpy(m_buf, ptr, len);
+    m_index = uint32_t(len);
 }
 
 SHA1::Digest SHA1::finalize()
@@ -419,6 +419,35 @@ void CacheFileSystem::clearCache()
     }
 }
 
+void CacheFileSystem::invalidateChanged()
+{
+    for (const auto& [_, pathInfo] : m_uniqueIdentityMap)
+    {
+        if (pathInfo->m_loadFileResult == CompressedResult::Ok &&
+            pathInfo->m_loadedPath.getLength())
+        {
+            uint64_t time = 0;
+            if (SLANG_SUCCEEDED(File::getModificationTime(pathInfo->m_loadedPath, time)) &&
+                time == pathInfo->m_modificationTime)
+            {
+                continue;
+            }
+        }
+        pathInfo->reset();
+    }
+
+    // A path that wasn't found may have been created since
+    List<String> missingPaths;
+    for (const auto& [path, pathInfo] : m_pathMap)
+    {
+        if (!pathInfo)
+            missingPaths.add(path);
+    }
+    for (const auto& path : missingPaths)
+    {
+        m_pathMap.remove(path);
+    }
+}
 
 // Determines if we can simplify a path for a given mode
 static bool _canSimplifyPath(CacheFileSystem::UniqueIdentityMode mode)
@@ -695,6 +724,12 @@ SlangResult CacheFileSystem::loadFile(char const* pathIn, ISlangBlob** blobOut)
 
     if (info->m_loadFileResult == CompressedResult::Uninitialized)
     {
+        // Get the time first, so that a change while loading is seen as a change
+        if (m_trackModificationTimes &&
+            SLANG_SUCCEEDED(File::getModificationTime(path, info->m_modificationTime)))
+        {
+            info->m_loadedPath = path;
+        }
         info->m_loadFileResult = toCompressedResult(
             m_fileSystem->loadFile(path.getBuffer(), info->m_fileBlob.writeRef()));
     }
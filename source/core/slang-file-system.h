@@ -143,6 +143,19 @@ public:
             m_pathType = SLANG_PATH_TYPE_FILE;
         }
 
+        /// Forget everything found out about the file, other than its unique identity
+        void reset()
+        {
+            m_loadFileResult = CompressedResult::Uninitialized;
+            m_getPathTypeResult = CompressedResult::Uninitialized;
+            m_getCanonicalPathResult = CompressedResult::Uninitialized;
+            m_pathType = SLANG_PATH_TYPE_FILE;
+            m_fileBlob.setNull();
+            m_canonicalPath = String();
+            m_loadedPath = String();
+            m_modificationTime = 0;
+        }
+
         /// Get the unique identity path as a string
         const String& getUniqueIdentity() const { return m_uniqueIdentity; }
 
@@ -154,6 +167,9 @@ public:
         SlangPathType m_pathType;
         ComPtr<ISlangBlob> m_fileBlob;
         String m_canonicalPath;
+
+        String m_loadedPath;             ///< Path the file was loaded from, if times are tracked
+        uint64_t m_modificationTime = 0; ///< Its modification time when it was loaded
     };
 
     Dictionary<String, PathInfo*>& getPathMap() { return m_pathMap; }
@@ -192,6 +208,16 @@ public:
         return m_osPathKind;
     }
 
+    /// When set, the modification time of every file loaded is recorded, so that
+    /// `invalidateChanged` can tell if it changed. Requires the inner file system to be the OS
+    /// file system.
+    void setTrackModificationTimes(bool track) { m_trackModificationTimes = track; }
+
+    /// Forget the results that may no longer hold, so the cache can be reused for a later
+    /// compile: files whose modification time changed since they were loaded, the types of paths
+    /// that weren't loaded, and paths that weren't found. Unique identities are kept.
+    void invalidateChanged();
+
     /// Get the unique identity mode
     UniqueIdentityMode getUniqueIdentityMode() const { return m_uniqueIdentityMode; }
     /// Get the path style
@@ -266,6 +292,8 @@ protected:
                          ///< emulate all the other methods of ISlangFileSystemExt
 
     OSPathKind m_osPathKind = OSPathKind::None; ///< OS path kind
+
+    bool m_trackModificationTimes = false; ///< Record modification times of loaded files
 };
 
 class RelativeFileSystem : public ISlangMutableFileSystem, public ComBaseObject
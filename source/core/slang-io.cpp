@@ -30,6 +30,7 @@
 #include <fnmatch.h>
 #include <ftw.h> // for nftw
 #include <sys/file.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #endif
 
@@ -194,6 +195,118 @@ bool File::exists(const String& fileName)
 #endif
 }
 
+SlangResult File::getModificationTime(const String& fileName, uint64_t& outTime)
+{
+    std::error_code ec;
+    const auto time =
+        std::filesystem::last_write_time(std::filesystem::u8path(fileName.getBuffer()), ec);
+    if (ec)
+    {
+        return SLANG_E_NOT_FOUND;
+    }
+    outTime = uint64_t(time.time_since_epoch().count());
+    return SLANG_OK;
+}
+
+namespace
+{
+/// A blob whose contents are a read only view of a file mapped into memory. The mapping is
+/// released when the blob is.
+class MappedFileBlob : public BlobBase
+{
+public:
+    // ISlangBlob
+    SLANG_NO_THROW void const* SLANG_MCALL getBufferPointer() SLANG_OVERRIDE { return m_data; }
+    SLANG_NO_THROW size_t SLANG_MCALL getBufferSize() SLANG_OVERRIDE { return m_dataSizeInBytes; }
+
+    MappedFileBlob(const void* data, size_t size)
+        : m_data(data), m_dataSizeInBytes(size)
+    {
+    }
+
+    ~MappedFileBlob()
+    {
+#ifdef _WIN32
+        UnmapViewOfFile(m_data);
+#else
+        munmap(const_cast<void*>(m_data), m_dataSizeInBytes);
+#endif
+    }
+
+protected:
+    const void* m_data;
+    size_t m_dataSizeInBytes;
+};
+} // namespace
+
+/* static */ SlangResult File::map(const String& fileName, ComPtr<ISlangBlob>& outBlob)
+{
+    uint64_t sizeInBytes = 0;
+    {
+        std::error_code ec;
+        sizeInBytes = std::filesystem::file_size(std::filesystem::u8path(fileName.getBuffer()), ec);
+        if (ec)
+        {
+            return SLANG_E_NOT_FOUND;
+        }
+    }
+    if (sizeInBytes > uint64_t(~size_t(0)))
+    {
+        // It's too large to fit in the address space.
+        return SLANG_FAIL;
+    }
+    // An empty file can't be mapped
+    if (sizeInBytes == 0)
+    {
+        outBlob = RawBlob::create("", 0);
+        return SLANG_OK;
+    }
+
+#ifdef _WIN32
+    const HANDLE file = CreateFileW(
+        fileName.toWString(),
+        GENERIC_READ,
+        FILE_SHARE_READ,
+        nullptr,
+        OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL,
+        nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return SLANG_E_CANNOT_OPEN;
+    }
+    const HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    // The view keeps the mapping alive, so the handles aren't needed once it is made
+    CloseHandle(file);
+    if (!mapping)
+    {
+        return SLANG_FAIL;
+    }
+    void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (!data)
+    {
+        return SLANG_FAIL;
+    }
+#else
+    const int fd = ::open(fileName.getBuffer(), O_RDONLY);
+    if (fd < 0)
+    {
+        return SLANG_E_CANNOT_OPEN;
+    }
+    void* data = ::mmap(nullptr, size_t(sizeInBytes), PROT_READ, MAP_PRIVATE, fd, 0);
+    // The mapping stays valid after the file is closed
+    ::close(fd);
+    if (data == MAP_FAILED)
+    {
+        return SLANG_FAIL;
+    }
+#endif
+
+    outBlob = new MappedFileBlob(data, size_t(sizeInBytes));
+    return SLANG_OK;
+}
+
 String Path::replaceExt(const String& path, const char* newExt)
 {
     StringBuilder sb(path.getLength() + 10);
@@ -744,6 +857,13 @@ String Path::getCurrentPath()
     return path;
 }
 
+SlangResult Path::setCurrentPath(const String& path)
+{
+    std::error_code ec;
+    std::filesystem::current_path(std::filesystem::u8path(path.getBuffer()), ec);
+    return ec ? SLANG_FAIL : SLANG_OK;
+}
+
 String Path::getRelativePath(String base, String path)
 {
     std::filesystem::path p1(base.getBuffer());
@@ -14,11 +14,20 @@ class File
 public:
     static bool exists(const String& fileName);
 
+    /// Get the time the file was last modified, in units that are only meaningful to compare
+    /// with other times returned by this function.
+    static SlangResult getModificationTime(const String& fileName, uint64_t& outTime);
+
     static SlangResult readAllText(const String& fileName, String& outString);
 
     static SlangResult readAllBytes(const String& fileName, List<unsigned char>& out);
     static SlangResult readAllBytes(const String& fileName, ScopedAllocation& out);
 
+    /// Map the contents of the file into memory, read only. Pages are only read from the file
+    /// when they are accessed, and the mapping lasts as long as the blob.
+    /// NOTE! Unlike the blobs from readAllBytes, the contents are not zero terminated.
+    static SlangResult map(const String& fileName, ComPtr<ISlangBlob>& outBlob);
+
     static SlangResult writeAllText(const String& fileName, const String& text);
 
     static SlangResult writeAllTextIfChanged(const String& fileName, UnownedStringSlice text);
@@ -228,6 +237,9 @@ public:
     /// @return The path in platform native format. Returns empty string if failed.
     static String getCurrentPath();
 
+    /// Sets the current working directory of the process to `path`
+    static SlangResult setCurrentPath(const String& path);
+
     /// Returns the executable path
     /// @return The path in platform native format. Returns empty string if failed.
     static String getExecutablePath();
@@ -64,6 +64,10 @@ SlangResult LZ4CompressionSystemImpl::compress(
         (char*)compressedData,
         int(srcSizeInBytes),
         int(compressedBound));
+    if (compressedSize <= 0)
+    {
+        return SLANG_FAIL;
+    }
     alloc.reallocate(compressedSize);
 
     auto blob = RawBlob::moveCreate(alloc);
@@ -83,8 +87,11 @@ SlangResult LZ4CompressionSystemImpl::decompress(
         (char*)outDecompressed,
         int(compressedSizeInBytes),
         int(decompressedSizeInBytes));
-    SLANG_UNUSED(decompressedSize);
-    SLANG_ASSERT(size_t(decompressedSize) == decompressedSizeInBytes);
+    // Data that is corrupt, or not as large as expected, gives a negative or smaller size
+    if (decompressedSize < 0 || size_t(decompressedSize) != decompressedSizeInBytes)
+    {
+        return SLANG_FAIL;
+    }
     return SLANG_OK;
 }
 
@@ -1,15 +1,38 @@
 #include "slang-performance-profiler.h"
 
+#include "slang-blob.h"
 #include "slang-dictionary.h"
+#include "slang-string-escape-util.h"
+
+#include <atomic>
 
 namespace Slang
 {
 class PerformanceProfilerImpl : public PerformanceProfiler
 {
 public:
+    typedef std::chrono::high_resolution_clock Clock;
+
     OrderedDictionary<const char*, FuncProfileInfo> data;
 
-    virtual FuncProfileContext enterFunction(const char* funcName) override
+    /// Trace events recorded while tracing is enabled.
+    List<ProfileTraceEvent> traceEvents;
+    bool traceEnabled = false;
+    /// Number of spans entered but not yet exited while tracing.
+    Index traceDepth = 0;
+    std::chrono::time_point<Clock> traceStartTime;
+
+    /// Identifies the thread owning this (thread local) profiler in the trace output.
+    int threadId;
+
+    PerformanceProfilerImpl()
+    {
+        static std::atomic<int> nextThreadId{1};
+        threadId = nextThreadId++;
+    }
+
+    virtual FuncProfileContext enterFunction(const char* funcName, UnownedStringSlice tag)
+        override
     {
         auto entry = data.tryGetValue(funcName);
         if (!entry)
@@ -20,15 +43,32 @@ public:
         entry->invocationCount++;
         FuncProfileContext ctx;
         ctx.funcName = funcName;
-        ctx.startTime = std::chrono::high_resolution_clock::now();
+        ctx.startTime = Clock::now();
+        if (traceEnabled)
+        {
+            ctx.traceEventIndex = traceEvents.getCount();
+            ProfileTraceEvent event;
+            event.name = funcName;
+            event.tag = tag;
+            event.startTime = ctx.startTime - traceStartTime;
+            event.depth = traceDepth++;
+            traceEvents.add(event);
+        }
         return ctx;
     }
     virtual void exitFunction(FuncProfileContext ctx) override
     {
-        auto endTime = std::chrono::high_resolution_clock::now();
+        auto endTime = Clock::now();
         auto duration = endTime - ctx.startTime;
         auto entry = data.tryGetValue(ctx.funcName);
         entry->duration += duration;
+
+        // The events may have been discarded by re-enabling tracing while this span was open.
+        if (ctx.traceEventIndex >= 0 && ctx.traceEventIndex < traceEvents.getCount())
+        {
+            traceEvents[ctx.traceEventIndex].duration = duration;
+            traceDepth--;
+        }
     }
     virtual void getResult(StringBuilder& out) override
     {
@@ -44,8 +84,59 @@ public:
                 << static_cast<uint64_t>(milliseconds.count()) << "ms\n";
         }
     }
-    virtual void clear() override { data.clear(); }
-    virtual void dispose() override { data = decltype(data)(); }
+    virtual void clear() override
+    {
+        data.clear();
+        traceEvents.clear();
+        traceDepth = 0;
+        traceStartTime = Clock::now();
+    }
+    virtual void dispose() override
+    {
+        data = decltype(data)();
+        traceEvents = decltype(traceEvents)();
+        traceDepth = 0;
+    }
+
+    virtual void setTraceEnabled(bool enabled) override
+    {
+        if (enabled && !traceEnabled)
+        {
+            traceEvents.clear();
+            traceDepth = 0;
+            traceStartTime = Clock::now();
+        }
+        traceEnabled = enabled;
+    }
+    virtual bool isTraceEnabled() override { return traceEnabled; }
+    virtual const List<ProfileTraceEvent>& getTraceEvents() override { return traceEvents; }
+    virtual void getTraceJSON(StringBuilder& out) override
+    {
+        auto handler = StringEscapeUtil::getHandler(StringEscapeUtil::Style::JSON);
+
+        // Each span is written as a "complete" event. Viewers reconstruct the nesting
+        // from the start times and durations of the events on the same thread.
+        out << "{\"traceEvents\":[";
+        for (Index i = 0; i < traceEvents.getCount(); ++i)
+        {
+            const auto& event = traceEvents[i];
+            if (i > 0)
+                out << ",";
+            out << "\n{\"name\":";
+            StringEscapeUtil::appendQuoted(handler, UnownedStringSlice(event.name), out);
+            out << ",\"cat\":\"slang\",\"ph\":\"X\",\"pid\":1,\"tid\":" << threadId;
+            out << ",\"ts\":" << String(event.startTime.count() / 1000.0, "%.3f");
+            out << ",\"dur\":" << String(event.duration.count() / 1000.0, "%.3f");
+            if (event.tag.getLength())
+            {
+                out << ",\"args\":{\"tag\":";
+                StringEscapeUtil::appendQuoted(handler, event.tag.getUnownedSlice(), out);
+                out << "}";
+            }
+            out << "}";
+        }
+        out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+    }
 };
 
 PerformanceProfiler* Slang::PerformanceProfiler::getProfiler()
@@ -77,6 +168,10 @@ SlangProfiler::SlangProfiler(PerformanceProfiler* profiler)
         m_profilEntries.insert(index, profileEntry);
         index++;
     }
+
+    StringBuilder traceJSON;
+    profiler->getTraceJSON(traceJSON);
+    m_traceJSON = traceJSON.produceString();
 }
 
 ISlangUnknown* SlangProfiler::getInterface(const Guid& guid)
@@ -117,4 +212,13 @@ uint32_t SlangProfiler::getEntryInvocationTimes(uint32_t index)
 
     return m_profilEntries[index].invocationCount;
 }
+
+SlangResult SlangProfiler::getTraceJSON(ISlangBlob** outTraceJSON)
+{
+    if (outTraceJSON == nullptr)
+        return SLANG_E_INVALID_ARG;
+
+    *outTraceJSON = StringBlob::create(m_traceJSON).detach();
+    return SLANG_OK;
+}
 } // namespace Slang
@@ -21,17 +21,44 @@ struct FuncProfileContext
 {
     const char* funcName = nullptr;
     std::chrono::time_point<std::chrono::high_resolution_clock> startTime;
+    /// Index of the trace event recorded for this invocation, or -1 if tracing is disabled.
+    Index traceEventIndex = -1;
+};
+
+/// A single span recorded while tracing is enabled.
+struct ProfileTraceEvent
+{
+    const char* name = nullptr;
+    /// Optional tag identifying what the span worked on, e.g. a module or entry point name.
+    String tag;
+    /// Start time relative to when tracing was enabled.
+    std::chrono::nanoseconds startTime = std::chrono::nanoseconds::zero();
+    std::chrono::nanoseconds duration = std::chrono::nanoseconds::zero();
+    /// Nesting depth of the span, 0 for outermost spans.
+    Index depth = 0;
 };
 
 class PerformanceProfiler
 {
 public:
-    virtual FuncProfileContext enterFunction(const char* funcName) = 0;
+    virtual FuncProfileContext enterFunction(
+        const char* funcName,
+        UnownedStringSlice tag = UnownedStringSlice()) = 0;
     virtual void exitFunction(FuncProfileContext context) = 0;
     virtual void getResult(StringBuilder& out) = 0;
     virtual void clear() = 0;
     virtual void dispose() = 0;
 
+    /// Enable or disable recording of a hierarchical trace of all profiled spans.
+    /// Enabling tracing discards any previously recorded trace events.
+    virtual void setTraceEnabled(bool enabled) = 0;
+    virtual bool isTraceEnabled() = 0;
+    /// Get the trace events recorded since tracing was enabled, in order of their start time.
+    virtual const List<ProfileTraceEvent>& getTraceEvents() = 0;
+    /// Write the recorded trace in the Chrome trace event format, which can be
+    /// loaded by `chrome://tracing` and Perfetto.
+    virtual void getTraceJSON(StringBuilder& out) = 0;
+
 public:
     static PerformanceProfiler* getProfiler();
 };
@@ -39,9 +66,11 @@ public:
 struct PerformanceProfilerFuncRAIIContext
 {
     FuncProfileContext context;
-    PerformanceProfilerFuncRAIIContext(const char* funcName)
+    PerformanceProfilerFuncRAIIContext(
+        const char* funcName,
+        UnownedStringSlice tag = UnownedStringSlice())
     {
-        context = PerformanceProfiler::getProfiler()->enterFunction(funcName);
+        context = PerformanceProfiler::getProfiler()->enterFunction(funcName, tag);
     }
     ~PerformanceProfilerFuncRAIIContext()
     {
@@ -66,13 +95,18 @@ public:
     virtual SLANG_NO_THROW const char* SLANG_MCALL getEntryName(uint32_t index) override;
     virtual SLANG_NO_THROW long SLANG_MCALL getEntryTimeMS(uint32_t index) override;
     virtual SLANG_NO_THROW uint32_t SLANG_MCALL getEntryInvocationTimes(uint32_t index) override;
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL getTraceJSON(ISlangBlob** outTraceJSON) override;
 
 private:
     List<ProfileInfo> m_profilEntries;
+    String m_traceJSON;
 };
 
 #define SLANG_PROFILE PerformanceProfilerFuncRAIIContext _profileContext(__func__)
 #define SLANG_PROFILE_SECTION(s) PerformanceProfilerFuncRAIIContext _profileContext##s(#s)
+/// Profile the enclosing scope as section `s`, tagged with `tag` in the recorded trace.
+#define SLANG_PROFILE_SECTION_TAGGED(s, tag) \
+    PerformanceProfilerFuncRAIIContext _profileContext##s(#s, tag)
 
 } // namespace Slang
 
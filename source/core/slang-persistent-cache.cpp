@@ -2,6 +2,7 @@
 
 #include "../core/slang-blob.h"
 #include "../core/slang-io.h"
+#include "../core/slang-process.h"
 #include "../core/slang-stream.h"
 #include "../core/slang-string-util.h"
 
@@ -19,6 +20,8 @@ PersistentCache::PersistentCache(const Desc& desc)
     m_lockFile.open(m_lockFileName);
 
     m_maxEntryCount = desc.maxEntryCount;
+    m_usePackFiles = desc.usePackFiles;
+    m_packFileSize = desc.packFileSize;
 
     resetStats();
 
@@ -38,6 +41,9 @@ SlangResult PersistentCache::clear()
     std::lock_guard<std::mutex> mutexLock(m_mutex);
     LockFileGuard fileLock(m_lockFile);
 
+    // Release the mapped pack files, so that they can be removed.
+    m_packs.clear();
+
     struct Visitor : Path::Visitor
     {
         const String& directory;
@@ -63,6 +69,7 @@ SlangResult PersistentCache::clear()
     Path::find(m_cacheDirectory, nullptr, &visitor);
 
     m_stats.entryCount = 0;
+    resetSlots();
 
     return SLANG_OK;
 }
@@ -84,120 +91,325 @@ SlangResult PersistentCache::readEntry(const Key& key, ISlangBlob** outData)
         return SLANG_E_CANNOT_OPEN;
     }
 
-    // Acquire the exclusive lock.
     std::lock_guard<std::mutex> mutexLock(m_mutex);
+
+    SlangResult result = SLANG_OK;
+    {
+        // Acquire the shared lock, readers only ever write to the index in place.
+        LockFileGuard fileLock(m_lockFile, LockFile::LockType::Shared);
+
+        // Return if index does not exist.
+        if (!File::exists(m_indexFileName))
+        {
+            return SLANG_E_NOT_FOUND;
+        }
+
+        FileStream fs;
+        IndexHeader header;
+        SLANG_RETURN_ON_FAIL(openIndex(fs, header));
+        m_stats.entryCount = (Count)header.count;
+
+        // Find the entry.
+        Index slot = -1;
+        CacheEntry entry;
+        SLANG_RETURN_ON_FAIL(findEntrySlot(fs, header, key, slot, entry));
+        if (slot == -1)
+        {
+            return SLANG_E_NOT_FOUND;
+        }
+
+        // Read the entry.
+        ComPtr<ISlangBlob> data;
+        result = loadEntryData(entry, data);
+        if (result == SLANG_OK)
+        {
+            // Mark the entry as the most recently used one. If readers in other processes
+            // advance the clock at the same time, some of the accesses may get the same time,
+            // which only makes the eviction order approximate between processes.
+            const uint32_t clock = header.clock + 1;
+            const Int64 entryOffset = Int64(sizeof(IndexHeader) + slot * sizeof(CacheEntry));
+            SLANG_RETURN_ON_FAIL(fs.seek(SeekOrigin::Start, offsetof(IndexHeader, clock)));
+            SLANG_RETURN_ON_FAIL(fs.write(&clock, sizeof(clock)));
+            SLANG_RETURN_ON_FAIL(
+                fs.seek(SeekOrigin::Start, entryOffset + offsetof(CacheEntry, lastAccess)));
+            SLANG_RETURN_ON_FAIL(fs.write(&clock, sizeof(clock)));
+
+            --m_stats.missCount;
+            ++m_stats.hitCount;
+            *outData = data.detach();
+            return SLANG_OK;
+        }
+    }
+
+    // The entry data is gone, so remove the entry from the index.
+    // This needs the exclusive lock, and the index may have changed since it was released.
     LockFileGuard fileLock(m_lockFile);
+    removeEntry(key);
+
+    return result;
+}
 
-    // Return if index does not exist.
-    if (!File::exists(m_indexFileName))
+SlangResult PersistentCache::writeEntry(const Key& key, ISlangBlob* data)
+{
+    SLANG_ASSERT(data);
+
+    if (!m_lockFile.isOpen())
     {
-        return SLANG_E_NOT_FOUND;
+        return SLANG_E_CANNOT_OPEN;
     }
 
+    // Acquire the exclusive lock.
+    std::lock_guard<std::mutex> mutexLock(m_mutex);
+    LockFileGuard fileLock(m_lockFile);
+
     // Read the cache index.
+    // We ignore any errors when reading the index and just write a new one.
+    IndexHeader header;
     CacheIndex cacheIndex;
-    SLANG_RETURN_ON_FAIL(readIndex(m_indexFileName, cacheIndex));
-
-    // Increase the age of all entries in the cache.
-    for (auto& entry : cacheIndex)
+    const bool isIndexValid = SLANG_SUCCEEDED(readIndex(header, cacheIndex));
+    if (!isIndexValid)
     {
-        ++entry.age;
+        resetIndex(header, cacheIndex);
     }
 
-    // Find the entry.
-    Index entryIndex =
+    // Update the index. If the entry is already in the index its record is reused.
+    Index slot =
         cacheIndex.findFirstIndex([&key](const CacheEntry& entry) { return entry.key == key; });
-    if (entryIndex == -1)
+    if (slot == -1)
     {
-        return SLANG_E_NOT_FOUND;
+        slot = addEntrySlot(header, cacheIndex, key);
     }
+    const CacheEntry previousEntry = cacheIndex[slot];
 
-    // Read the entry.
-    String entryFileName = getEntryFileName(key);
-    ScopedAllocation data;
-    SlangResult result = File::readAllBytes(entryFileName, data);
+    // Write the cache entry.
+    PackWriter packWriter;
+    CacheEntry& entry = cacheIndex[slot];
+    entry.key = key;
+    SLANG_RETURN_ON_FAIL(storeEntryData(
+        header,
+        packWriter,
+        entry,
+        data->getBufferPointer(),
+        data->getBufferSize()));
+    packWriter.stream.close();
+
+    ++header.clock;
+    entry.lastAccess = header.clock;
+    header.count = (uint32_t)cacheIndex.getCount();
+
+    // Write the cache index. Only the header and the entry's record change, unless the
+    // index has to be written from scratch.
+    SlangResult result = isIndexValid ? writeIndexEntry(header, cacheIndex, slot)
+                                      : writeIndex(header, cacheIndex);
     if (result == SLANG_OK)
     {
-        --m_stats.missCount;
-        ++m_stats.hitCount;
-        cacheIndex[entryIndex].age = 0;
-        auto blob = RawBlob::moveCreate(data);
-        *outData = blob.detach();
+        m_stats.entryCount = (Count)cacheIndex.getCount();
+        updateSlots(header, cacheIndex);
+        // The entry that was replaced may have been the last one in its pack.
+        if (previousEntry.pack != kNoPack && previousEntry.pack != entry.pack)
+        {
+            removeUnusedPacks(header, cacheIndex);
+        }
     }
     else
     {
-        cacheIndex.removeAt(entryIndex);
+        // If writing the index failed, remove the entry file to avoid growing the cache.
+        if (entry.pack == kNoPack)
+        {
+            Path::remove(getEntryFileName(key));
+        }
+        resetSlots();
     }
 
-    // Write the cache index.
-    SLANG_RETURN_ON_FAIL(writeIndex(m_indexFileName, cacheIndex));
-    m_stats.entryCount = (Count)cacheIndex.getCount();
-
     return result;
 }
 
-SlangResult PersistentCache::writeEntry(const Key& key, ISlangBlob* data)
+// The file written by `exportEntries` has a header, then the key and size of every entry,
+// followed by the data of all entries in the same order.
+struct ExportHeader
 {
-    SLANG_ASSERT(data);
+    char magic[4];
+    uint32_t version;
+    uint32_t count;
+    uint32_t reserved;
+};
+
+struct ExportEntry
+{
+    PersistentCache::Key key;
+    uint32_t size;
+};
+
+static const char* kExportMagic = "SLSX";
+static const uint32_t kExportVersion = 1;
 
+SlangResult PersistentCache::exportEntries(const char* fileName)
+{
     if (!m_lockFile.isOpen())
     {
         return SLANG_E_CANNOT_OPEN;
     }
 
-    // Acquire the exclusive lock.
     std::lock_guard<std::mutex> mutexLock(m_mutex);
-    LockFileGuard fileLock(m_lockFile);
+    LockFileGuard fileLock(m_lockFile, LockFile::LockType::Shared);
 
-    // Read the cache index.
-    // We ignore any errors when reading the index and just write a new one.
+    IndexHeader header = {};
     CacheIndex cacheIndex;
-    readIndex(m_indexFileName, cacheIndex);
+    if (File::exists(m_indexFileName))
+    {
+        SLANG_RETURN_ON_FAIL(readIndex(header, cacheIndex));
+    }
+
+    // Write the entries from the least to the most recently used, so that importing them
+    // keeps their order.
+    cacheIndex.stableSort(
+        [&header](const CacheEntry& a, const CacheEntry& b)
+        { return header.clock - a.lastAccess > header.clock - b.lastAccess; });
 
-    // Increase the age of all entries in the cache and get the index of
-    // the oldest entry.
-    Index oldestEntryIndex = -1;
-    uint32_t oldestEntryAge = 0;
-    for (Index entryIndex = 0; entryIndex < cacheIndex.getCount(); ++entryIndex)
+    List<ExportEntry> records;
+    List<ComPtr<ISlangBlob>> blobs;
+    for (const auto& entry : cacheIndex)
     {
-        auto& entry = cacheIndex[entryIndex];
-        ++entry.age;
-        if (entry.age > oldestEntryAge)
+        // Entries whose data is gone are left out.
+        ComPtr<ISlangBlob> data;
+        if (SLANG_FAILED(loadEntryData(entry, data)) ||
+            uint64_t(data->getBufferSize()) > 0xffffffff)
         {
-            oldestEntryIndex = entryIndex;
-            oldestEntryAge = entry.age;
+            continue;
         }
+        records.add(ExportEntry{entry.key, (uint32_t)data->getBufferSize()});
+        blobs.add(data);
     }
 
-    // Write the cache entry.
-    String entryFileName = getEntryFileName(key);
+    FileStream fs;
+    SLANG_RETURN_ON_FAIL(fs.init(fileName, FileMode::Create));
+
+    ExportHeader exportHeader = {};
+    ::memcpy(exportHeader.magic, kExportMagic, 4);
+    exportHeader.version = kExportVersion;
+    exportHeader.count = (uint32_t)records.getCount();
+    SLANG_RETURN_ON_FAIL(fs.write(&exportHeader, sizeof(exportHeader)));
     SLANG_RETURN_ON_FAIL(
-        File::writeAllBytes(entryFileName, data->getBufferPointer(), data->getBufferSize()));
+        fs.write(records.getBuffer(), records.getCount() * sizeof(ExportEntry)));
+    for (const auto& blob : blobs)
+    {
+        SLANG_RETURN_ON_FAIL(fs.write(blob->getBufferPointer(), blob->getBufferSize()));
+    }
+
+    return SLANG_OK;
+}
 
-    // Update the index.
-    if (m_maxEntryCount > 0 && cacheIndex.getCount() >= m_maxEntryCount)
+SlangResult PersistentCache::importEntries(const char* fileName)
+{
+    if (!m_lockFile.isOpen())
     {
-        // Replace oldest entry.
-        SLANG_ASSERT(oldestEntryIndex >= 0);
-        File::remove(getEntryFileName(cacheIndex[oldestEntryIndex].key));
-        cacheIndex[oldestEntryIndex] = CacheEntry{key, 0};
+        return SLANG_E_CANNOT_OPEN;
     }
-    else
+
+    // Check the file before anything is added to the cache.
+    ComPtr<ISlangBlob> file;
+    SLANG_RETURN_ON_FAIL(File::map(fileName, file));
+    const uint8_t* fileData = (const uint8_t*)file->getBufferPointer();
+    const size_t fileSize = file->getBufferSize();
+
+    ExportHeader exportHeader;
+    if (fileSize < sizeof(exportHeader))
+    {
+        return SLANG_E_INTERNAL_FAIL;
+    }
+    ::memcpy(&exportHeader, fileData, sizeof(exportHeader));
+    if (::memcmp(exportHeader.magic, kExportMagic, 4) != 0 ||
+        exportHeader.version != kExportVersion ||
+        (fileSize - sizeof(exportHeader)) / sizeof(ExportEntry) < exportHeader.count)
+    {
+        return SLANG_E_INTERNAL_FAIL;
+    }
+
+    List<ExportEntry> records;
+    records.setCount(exportHeader.count);
+    ::memcpy(
+        records.getBuffer(),
+        fileData + sizeof(exportHeader),
+        records.getCount() * sizeof(ExportEntry));
+
+    size_t dataSize = sizeof(exportHeader) + records.getCount() * sizeof(ExportEntry);
+    for (const auto& exportEntry : records)
+    {
+        dataSize += exportEntry.size;
+    }
+    if (dataSize != fileSize)
     {
-        // Add new entry.
-        cacheIndex.add(CacheEntry{key, 0});
+        return SLANG_E_INTERNAL_FAIL;
+    }
+
+    // Acquire the exclusive lock.
+    std::lock_guard<std::mutex> mutexLock(m_mutex);
+    LockFileGuard fileLock(m_lockFile);
+
+    IndexHeader header;
+    CacheIndex cacheIndex;
+    if (SLANG_FAILED(readIndex(header, cacheIndex)))
+    {
+        resetIndex(header, cacheIndex);
     }
 
+    Dictionary<Key, Index> slots;
+    for (Index slot = 0; slot < cacheIndex.getCount(); ++slot)
+    {
+        slots[cacheIndex[slot].key] = slot;
+    }
+
+    // Store all entries, appending them to the same pack while it has room.
+    PackWriter packWriter;
+    bool hasReplacedPackEntry = false;
+    size_t dataOffset = sizeof(exportHeader) + records.getCount() * sizeof(ExportEntry);
+    for (const auto& exportEntry : records)
+    {
+        Index slot = -1;
+        if (Index* existingSlot = slots.tryGetValue(exportEntry.key))
+        {
+            slot = *existingSlot;
+        }
+        else
+        {
+            slot = addEntrySlot(header, cacheIndex, exportEntry.key);
+            slots.remove(cacheIndex[slot].key);
+            slots[exportEntry.key] = slot;
+        }
+        hasReplacedPackEntry = hasReplacedPackEntry || cacheIndex[slot].pack != kNoPack;
+
+        // If this fails, the index on disk is left as it was. Any entry file that was
+        // evicted on the way is then found to be missing the next time it is read.
+        CacheEntry& entry = cacheIndex[slot];
+        entry.key = exportEntry.key;
+        SlangResult result =
+            storeEntryData(header, packWriter, entry, fileData + dataOffset, exportEntry.size);
+        if (SLANG_FAILED(result))
+        {
+            resetSlots();
+            return result;
+        }
+
+        ++header.clock;
+        entry.lastAccess = header.clock;
+        dataOffset += exportEntry.size;
+    }
+    packWriter.stream.close();
+
     // Write the cache index.
-    SlangResult result = writeIndex(m_indexFileName, cacheIndex);
+    SlangResult result = writeIndex(header, cacheIndex);
     if (result == SLANG_OK)
     {
         m_stats.entryCount = (Count)cacheIndex.getCount();
+        updateSlots(header, cacheIndex);
+        if (hasReplacedPackEntry)
+        {
+            removeUnusedPacks(header, cacheIndex);
+        }
     }
     else
     {
-        // If writing the index failed, remove the entry file to avoid growing the cache.
-        Path::remove(entryFileName);
+        resetSlots();
     }
 
     return result;
@@ -210,14 +422,14 @@ SlangResult PersistentCache::initialize()
         return SLANG_E_CANNOT_OPEN;
     }
 
-    // Acquire the exclusive lock.
     std::lock_guard<std::mutex> mutexLock(m_mutex);
-    LockFileGuard fileLock(m_lockFile);
+    LockFileGuard fileLock(m_lockFile, LockFile::LockType::Shared);
 
-    CacheIndex cacheIndex;
-    if (SLANG_SUCCEEDED(readIndex(m_indexFileName, cacheIndex)))
+    FileStream fs;
+    IndexHeader header;
+    if (File::exists(m_indexFileName) && SLANG_SUCCEEDED(openIndex(fs, header)))
     {
-        m_stats.entryCount = (Count)cacheIndex.getCount();
+        m_stats.entryCount = (Count)header.count;
     }
 
     return SLANG_OK;
@@ -230,61 +442,386 @@ String PersistentCache::getEntryFileName(const Key& key)
     return str;
 }
 
-struct CacheIndexHeader
+String PersistentCache::getPackFileName(uint32_t pack)
 {
-    char magic[4];
-    uint32_t version;
-    uint32_t count;
-    uint32_t reserved;
-};
+    StringBuilder str;
+    str << m_cacheDirectory << "/pack-";
+    str.append(pack, 16);
+    return str;
+}
+
+SlangResult PersistentCache::storeEntryData(
+    IndexHeader& ioHeader,
+    PackWriter& packWriter,
+    CacheEntry& ioEntry,
+    const void* data,
+    size_t size)
+{
+    if (!m_usePackFiles || uint64_t(size) > 0xffffffff)
+    {
+        SLANG_RETURN_ON_FAIL(File::writeAllBytes(getEntryFileName(ioEntry.key), data, size));
+        ioEntry.pack = kNoPack;
+        ioEntry.offset = 0;
+        ioEntry.size = 0;
+        return SLANG_OK;
+    }
+
+    for (;;)
+    {
+        if (packWriter.pack != ioHeader.pack)
+        {
+            SLANG_RETURN_ON_FAIL(packWriter.stream.init(
+                getPackFileName(ioHeader.pack),
+                FileMode::Append,
+                FileAccess::Write,
+                FileShare::ReadWrite));
+            packWriter.pack = ioHeader.pack;
+        }
+        SLANG_RETURN_ON_FAIL(packWriter.stream.seek(SeekOrigin::End, 0));
+        const Int64 offset = packWriter.stream.getPosition();
+
+        // Start a new pack once the current one is full. An entry that is larger than a
+        // whole pack gets a pack of its own.
+        if (offset > 0 && uint64_t(offset) + size > m_packFileSize)
+        {
+            packWriter.stream.close();
+            packWriter.pack = kNoPack;
+            ++ioHeader.pack;
+            if (ioHeader.pack == kNoPack)
+            {
+                ioHeader.pack = 0;
+            }
+            continue;
+        }
+
+        SLANG_RETURN_ON_FAIL(packWriter.stream.write(data, size));
+        ioEntry.pack = ioHeader.pack;
+        ioEntry.offset = uint64_t(offset);
+        ioEntry.size = uint32_t(size);
+        return SLANG_OK;
+    }
+}
+
+SlangResult PersistentCache::loadEntryData(const CacheEntry& entry, ComPtr<ISlangBlob>& outData)
+{
+    if (entry.pack == kNoPack)
+    {
+        ScopedAllocation data;
+        SLANG_RETURN_ON_FAIL(File::readAllBytes(getEntryFileName(entry.key), data));
+        outData = RawBlob::moveCreate(data);
+        return SLANG_OK;
+    }
+
+    // Map the pack again if entries were appended to it after it was mapped.
+    const uint64_t end = entry.offset + entry.size;
+    ComPtr<ISlangBlob>* pack = m_packs.tryGetValue(entry.pack);
+    if (!pack || (*pack)->getBufferSize() < end)
+    {
+        ComPtr<ISlangBlob> blob;
+        SLANG_RETURN_ON_FAIL(File::map(getPackFileName(entry.pack), blob));
+        m_packs[entry.pack] = blob;
+        pack = m_packs.tryGetValue(entry.pack);
+    }
+    if ((*pack)->getBufferSize() < end)
+    {
+        return SLANG_E_INTERNAL_FAIL;
+    }
+
+    // The entry refers to the mapped pack, which it keeps alive.
+    const char* packData = (const char*)(*pack)->getBufferPointer();
+    outData = ScopeBlob::create(
+        UnownedRawBlob::create(packData + entry.offset, entry.size),
+        *pack);
+    return SLANG_OK;
+}
+
+Index PersistentCache::addEntrySlot(IndexHeader& ioHeader, CacheIndex& ioIndex, const Key& key)
+{
+    ++ioHeader.generation;
+
+    if (m_maxEntryCount > 0 && ioIndex.getCount() >= m_maxEntryCount)
+    {
+        // Replace the least recently used entry. The clock wraps around, so the
+        // entries are compared by the time since their last access.
+        Index slot = 0;
+        for (Index i = 1; i < ioIndex.getCount(); ++i)
+        {
+            if (ioHeader.clock - ioIndex[i].lastAccess >
+                ioHeader.clock - ioIndex[slot].lastAccess)
+            {
+                slot = i;
+            }
+        }
+        // Packs are only removed once none of their entries are left.
+        if (ioIndex[slot].pack == kNoPack)
+        {
+            File::remove(getEntryFileName(ioIndex[slot].key));
+        }
+        return slot;
+    }
+
+    // Add new entry.
+    CacheEntry entry = {};
+    entry.key = key;
+    entry.pack = kNoPack;
+    ioIndex.add(entry);
+    return ioIndex.getCount() - 1;
+}
+
+// Get the number of a pack from its file name, as written by `getPackFileName`.
+static bool _parsePackFileName(const UnownedStringSlice& fileName, uint32_t& outPack)
+{
+    const UnownedStringSlice prefix = toSlice("pack-");
+    if (!fileName.startsWith(prefix) || fileName.getLength() == prefix.getLength() ||
+        fileName.getLength() > prefix.getLength() + 8)
+    {
+        return false;
+    }
+
+    uint32_t pack = 0;
+    for (char c : fileName.tail(prefix.getLength()))
+    {
+        int digit = -1;
+        if (c >= '0' && c <= '9')
+            digit = c - '0';
+        else if (c >= 'a' && c <= 'f')
+            digit = c - 'a' + 10;
+        else if (c >= 'A' && c <= 'F')
+            digit = c - 'A' + 10;
+        else
+            return false;
+        pack = pack * 16 + uint32_t(digit);
+    }
+    outPack = pack;
+    return true;
+}
+
+void PersistentCache::removeUnusedPacks(const IndexHeader& header, const CacheIndex& index)
+{
+    HashSet<uint32_t> usedPacks;
+    usedPacks.add(header.pack);
+    for (const auto& entry : index)
+    {
+        usedPacks.add(entry.pack);
+    }
+
+    struct Visitor : Path::Visitor
+    {
+        PersistentCache* cache;
+        const HashSet<uint32_t>& usedPacks;
+
+        Visitor(PersistentCache* cache, const HashSet<uint32_t>& usedPacks)
+            : cache(cache), usedPacks(usedPacks)
+        {
+        }
+
+        void accept(Path::Type type, const UnownedStringSlice& fileName) SLANG_OVERRIDE
+        {
+            uint32_t pack = 0;
+            if (type != Path::Type::File || !_parsePackFileName(fileName, pack))
+            {
+                return;
+            }
+            if (!usedPacks.contains(pack))
+            {
+                // A pack that is still mapped can't be removed on every platform.
+                cache->m_packs.remove(pack);
+                Path::remove(cache->getPackFileName(pack));
+            }
+        }
+    };
+
+    Visitor visitor(this, usedPacks);
+    Path::find(m_cacheDirectory, "pack-*", &visitor);
+}
 
 static const char* kMagic = "SLS$";
-static const uint32_t kVersion = 1;
+static const uint32_t kVersion = 3;
 
-SlangResult PersistentCache::readIndex(const String& fileName, CacheIndex& outIndex)
+SlangResult PersistentCache::openIndex(FileStream& fs, IndexHeader& outHeader)
 {
-    FileStream fs;
-    SLANG_RETURN_ON_FAIL(fs.init(fileName, FileMode::Open));
+    SLANG_RETURN_ON_FAIL(
+        fs.init(m_indexFileName, FileMode::Open, FileAccess::ReadWrite, FileShare::ReadWrite));
 
     // Get file size.
     SLANG_RETURN_ON_FAIL(fs.seek(SeekOrigin::End, 0));
     size_t fileSize = (size_t)fs.getPosition();
     SLANG_RETURN_ON_FAIL(fs.seek(SeekOrigin::Start, 0));
 
-    CacheIndexHeader header;
-    SLANG_RETURN_ON_FAIL(fs.readExactly(&header, sizeof(header)));
-    if (::memcmp(header.magic, kMagic, 4) != 0 || header.version != kVersion)
+    if (fileSize < sizeof(outHeader))
+    {
+        return SLANG_E_INTERNAL_FAIL;
+    }
+    SLANG_RETURN_ON_FAIL(fs.readExactly(&outHeader, sizeof(outHeader)));
+    if (::memcmp(outHeader.magic, kMagic, 4) != 0 || outHeader.version != kVersion)
     {
         return SLANG_E_INTERNAL_FAIL;
     }
 
     // Return if payload does not have the right size.
-    if (header.count * sizeof(CacheEntry) != fileSize - sizeof(header))
+    if (outHeader.count * sizeof(CacheEntry) != fileSize - sizeof(outHeader))
     {
         return SLANG_E_INTERNAL_FAIL;
     }
 
-    outIndex.setCount(header.count);
-    SLANG_RETURN_ON_FAIL(fs.readExactly(outIndex.getBuffer(), header.count * sizeof(CacheEntry)));
+    return SLANG_OK;
+}
+
+SlangResult PersistentCache::readIndex(IndexHeader& outHeader, CacheIndex& outIndex)
+{
+    FileStream fs;
+    SLANG_RETURN_ON_FAIL(openIndex(fs, outHeader));
+
+    outIndex.setCount(outHeader.count);
+    SLANG_RETURN_ON_FAIL(
+        fs.readExactly(outIndex.getBuffer(), outHeader.count * sizeof(CacheEntry)));
 
     return SLANG_OK;
 }
 
-SlangResult PersistentCache::writeIndex(const String& fileName, const CacheIndex& index)
+void PersistentCache::resetIndex(IndexHeader& outHeader, CacheIndex& outIndex)
+{
+    ::memset(&outHeader, 0, sizeof(outHeader));
+    // Start from an arbitrary generation, so that a cache that read the previous index
+    // doesn't mistake the new one for it.
+    outHeader.generation = (uint32_t)Process::getClockTick();
+    // Pack files are named after the pack number, so start from an arbitrary one too.
+    // Packs of the previous index that are still mapped are then never mistaken for new ones.
+    outHeader.pack = outHeader.generation == kNoPack ? 0 : outHeader.generation;
+    outIndex.clear();
+}
+
+SlangResult PersistentCache::writeIndex(const IndexHeader& header, const CacheIndex& index)
 {
     FileStream fs;
-    SLANG_RETURN_ON_FAIL(fs.init(fileName, FileMode::Create));
+    SLANG_RETURN_ON_FAIL(fs.init(m_indexFileName, FileMode::Create));
 
-    CacheIndexHeader header;
-    ::memcpy(header.magic, kMagic, 4);
-    header.version = kVersion;
-    header.count = (uint32_t)index.getCount();
-    header.reserved = 0;
-    SLANG_RETURN_ON_FAIL(fs.write(&header, sizeof(header)));
+    IndexHeader fileHeader = header;
+    ::memcpy(fileHeader.magic, kMagic, 4);
+    fileHeader.version = kVersion;
+    fileHeader.count = (uint32_t)index.getCount();
+    SLANG_RETURN_ON_FAIL(fs.write(&fileHeader, sizeof(fileHeader)));
 
     SLANG_RETURN_ON_FAIL(fs.write(index.getBuffer(), index.getCount() * sizeof(CacheEntry)));
 
     return SLANG_OK;
 }
 
+SlangResult PersistentCache::writeIndexEntry(
+    const IndexHeader& header,
+    const CacheIndex& index,
+    Index slot)
+{
+    FileStream fs;
+    SLANG_RETURN_ON_FAIL(
+        fs.init(m_indexFileName, FileMode::Open, FileAccess::ReadWrite, FileShare::ReadWrite));
+
+    // The entry is written first, so that an index that is interrupted while growing
+    // doesn't have the right size and is discarded when it is next read.
+    const Int64 entryOffset = Int64(sizeof(IndexHeader) + slot * sizeof(CacheEntry));
+    SLANG_RETURN_ON_FAIL(fs.seek(SeekOrigin::Start, entryOffset));
+    SLANG_RETURN_ON_FAIL(fs.write(&index[slot], sizeof(CacheEntry)));
+
+    SLANG_RETURN_ON_FAIL(fs.seek(SeekOrigin::Start, 0));
+    SLANG_RETURN_ON_FAIL(fs.write(&header, sizeof(header)));
+
+    return SLANG_OK;
+}
+
+SlangResult PersistentCache::findEntrySlot(
+    FileStream& fs,
+    const IndexHeader& header,
+    const Key& key,
+    Index& outSlot,
+    CacheEntry& outEntry)
+{
+    outSlot = -1;
+
+    // Check the entry at the position this cache last saw it at. The index is only
+    // read again if it was changed by another cache, or the entry has moved.
+    if (m_hasSlots && header.generation == m_slotsGeneration && header.count == m_slotsCount)
+    {
+        Index* slot = m_slots.tryGetValue(key);
+        if (!slot)
+        {
+            return SLANG_OK;
+        }
+
+        const Int64 entryOffset = Int64(sizeof(IndexHeader) + *slot * sizeof(CacheEntry));
+        SLANG_RETURN_ON_FAIL(fs.seek(SeekOrigin::Start, entryOffset));
+        SLANG_RETURN_ON_FAIL(fs.readExactly(&outEntry, sizeof(outEntry)));
+        if (outEntry.key == key)
+        {
+            outSlot = *slot;
+            return SLANG_OK;
+        }
+    }
+
+    CacheIndex cacheIndex;
+    cacheIndex.setCount(header.count);
+    SLANG_RETURN_ON_FAIL(fs.seek(SeekOrigin::Start, sizeof(IndexHeader)));
+    SLANG_RETURN_ON_FAIL(
+        fs.readExactly(cacheIndex.getBuffer(), header.count * sizeof(CacheEntry)));
+    updateSlots(header, cacheIndex);
+
+    if (Index* slot = m_slots.tryGetValue(key))
+    {
+        outSlot = *slot;
+        outEntry = cacheIndex[*slot];
+    }
+    return SLANG_OK;
+}
+
+SlangResult PersistentCache::removeEntry(const Key& key)
+{
+    IndexHeader header;
+    CacheIndex cacheIndex;
+    SLANG_RETURN_ON_FAIL(readIndex(header, cacheIndex));
+
+    Index slot =
+        cacheIndex.findFirstIndex([&key](const CacheEntry& entry) { return entry.key == key; });
+    if (slot == -1)
+    {
+        return SLANG_OK;
+    }
+
+    const uint32_t pack = cacheIndex[slot].pack;
+    cacheIndex.removeAt(slot);
+    ++header.generation;
+
+    SlangResult result = writeIndex(header, cacheIndex);
+    if (result == SLANG_OK)
+    {
+        m_stats.entryCount = (Count)cacheIndex.getCount();
+        updateSlots(header, cacheIndex);
+        if (pack != kNoPack)
+        {
+            removeUnusedPacks(header, cacheIndex);
+        }
+    }
+    else
+    {
+        resetSlots();
+    }
+    return result;
+}
+
+void PersistentCache::updateSlots(const IndexHeader& header, const CacheIndex& index)
+{
+    m_slots.clear();
+    for (Index slot = 0; slot < index.getCount(); ++slot)
+    {
+        m_slots[index[slot].key] = slot;
+    }
+    m_slotsGeneration = header.generation;
+    m_slotsCount = header.count;
+    m_hasSlots = true;
+}
+
+void PersistentCache::resetSlots()
+{
+    m_slots.clear();
+    m_hasSlots = false;
+}
+
 } // namespace Slang
@@ -1,5 +1,6 @@
 #pragma once
 #include "../core/slang-crypto.h"
+#include "../core/slang-dictionary.h"
 #include "../core/slang-io.h"
 #include "../core/slang-string.h"
 #include "slang.h"
@@ -14,6 +15,15 @@ namespace Slang
 /// The cache is save for concurrent access from multiple threads/processes by using
 /// a lock file within the cache directory. Furthermore, the cache implements a LRU
 /// eviction policy.
+///
+/// The index is a file of fixed size records, one per entry, that store the time of the last
+/// access to the entry. Reads only hold a shared lock and update the record of the entry they
+/// found in place, so a read doesn't have to rewrite the whole index. Writes hold the exclusive
+/// lock, and only rewrite the index when it is missing or corrupted.
+///
+/// By default every entry is stored in a file of its own. With `Desc::usePackFiles`, entries are
+/// instead appended to a few large pack files that are read through memory mapping, which avoids
+/// creating and opening a file per entry. A cache can read entries stored either way.
 class PersistentCache : public RefObject
 {
 public:
@@ -23,6 +33,10 @@ public:
         const char* directory = nullptr;
         // The maximum number of entries stored in the cache. By default, there is no limit.
         Count maxEntryCount = 0;
+        // Append new entries to pack files instead of writing a file per entry.
+        bool usePackFiles = false;
+        // The size in bytes after which a new pack file is started.
+        size_t packFileSize = 64 * 1024 * 1024;
     };
 
     struct Stats
@@ -40,7 +54,7 @@ public:
     PersistentCache(const Desc& desc);
     ~PersistentCache();
 
-    /// Clear the contents of the cache by removing the cache index and all entry files.
+    /// Clear the contents of the cache by removing the cache index and all entry and pack files.
     SlangResult clear();
 
     const Stats& getStats() const { return m_stats; }
@@ -54,21 +68,91 @@ public:
     /// Returns SLANG_OK if successful.
     SlangResult writeEntry(const Key& key, ISlangBlob* data);
 
+    /// Write all entries of the cache to a single file, so that they can be imported into
+    /// another cache, for example to seed the caches of build machines.
+    SlangResult exportEntries(const char* fileName);
+
+    /// Add all entries of a file written by `exportEntries` to the cache.
+    /// The entries are stored and the index is written once for the whole file.
+    SlangResult importEntries(const char* fileName);
+
 private:
+    struct IndexHeader
+    {
+        char magic[4];
+        uint32_t version;
+        // Number of entries in the index.
+        uint32_t count;
+        // Changed whenever an entry is added to, replaced in or removed from the index.
+        uint32_t generation;
+        // Advanced on every access to an entry.
+        uint32_t clock;
+        // The pack file that new entries are appended to.
+        uint32_t pack;
+    };
+
     struct CacheEntry
     {
         Key key;
-        uint32_t age;
+        // Value of the clock at the last access to the entry.
+        uint32_t lastAccess;
+        // The pack file holding the entry, or kNoPack if the entry has a file of its own.
+        uint32_t pack;
+        // Size and offset of the entry in the pack file.
+        uint32_t size;
+        uint64_t offset;
     };
 
+    static const uint32_t kNoPack = 0xffffffff;
+
     using CacheIndex = List<CacheEntry>;
 
+    // The pack file that a batch of writes is appending to.
+    struct PackWriter
+    {
+        FileStream stream;
+        uint32_t pack = kNoPack;
+    };
+
     SlangResult initialize();
 
     String getEntryFileName(const Key& key);
-
-    SlangResult readIndex(const String& fileName, CacheIndex& outIndex);
-    SlangResult writeIndex(const String& fileName, const CacheIndex& index);
+    String getPackFileName(uint32_t pack);
+
+    /// Store the data of an entry, and set where it is stored in `ioEntry`.
+    SlangResult storeEntryData(
+        IndexHeader& ioHeader,
+        PackWriter& packWriter,
+        CacheEntry& ioEntry,
+        const void* data,
+        size_t size);
+    SlangResult loadEntryData(const CacheEntry& entry, ComPtr<ISlangBlob>& outData);
+
+    /// Find the slot for a new entry, evicting the least recently used entry if the cache is full.
+    Index addEntrySlot(IndexHeader& ioHeader, CacheIndex& ioIndex, const Key& key);
+    /// Remove the pack files that no longer hold any entry, apart from the current one.
+    void removeUnusedPacks(const IndexHeader& header, const CacheIndex& index);
+
+    /// Open the index for reading and writing, and check that it is valid.
+    SlangResult openIndex(FileStream& fs, IndexHeader& outHeader);
+    SlangResult readIndex(IndexHeader& outHeader, CacheIndex& outIndex);
+    /// Start an empty index, to replace one that is missing or corrupted.
+    void resetIndex(IndexHeader& outHeader, CacheIndex& outIndex);
+    SlangResult writeIndex(const IndexHeader& header, const CacheIndex& index);
+    /// Write the header and a single entry to a valid index.
+    SlangResult writeIndexEntry(const IndexHeader& header, const CacheIndex& index, Index slot);
+
+    /// Find the position of an entry in the open index, or -1 if it is not in the index.
+    SlangResult findEntrySlot(
+        FileStream& fs,
+        const IndexHeader& header,
+        const Key& key,
+        Index& outSlot,
+        CacheEntry& outEntry);
+    SlangResult removeEntry(const Key& key);
+
+    void updateSlots(const IndexHeader& header, const CacheIndex& index);
+    void resetSlots();
 
     String m_cacheDirectory;
     String m_lockFileName;
@@ -81,6 +165,19 @@ private:
     Slang::LockFile m_lockFile;
 
     Count m_maxEntryCount;
+    bool m_usePackFiles;
+    size_t m_packFileSize;
+
+    // The position of every entry in the index, as of the last time this cache read all of it.
+    // These are reloaded when the generation or the count of the index no longer match.
+    Dictionary<Key, Index> m_slots;
+    uint32_t m_slotsGeneration = 0;
+    uint32_t m_slotsCount = 0;
+    bool m_hasSlots = false;
+
+    // The pack files mapped by this cache. A mapping is made again if the pack has grown
+    // past the end of it since.
+    Dictionary<uint32_t, ComPtr<ISlangBlob>> m_packs;
 
     Stats m_stats;
 
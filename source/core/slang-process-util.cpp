@@ -20,6 +20,27 @@ namespace Slang
     return SLANG_OK;
 }
 
+/* static */ SlangResult ProcessUtil::execute(
+    const CommandLine& commandLine,
+    ConstArrayView<Byte> standardInput,
+    ExecuteResult& outExecuteResult)
+{
+    RefPtr<Process> process;
+    SLANG_RETURN_ON_FAIL(Process::create(commandLine, 0, process));
+
+    Stream* stdInStream = process->getStream(StdStreamType::In);
+    if (!stdInStream)
+        return SLANG_FAIL;
+
+    const SlangResult writeResult =
+        stdInStream->write(standardInput.getBuffer(), size_t(standardInput.getCount()));
+    stdInStream->close();
+
+    // Wait for the process even if the write failed, so it doesn't outlive the call.
+    SLANG_RETURN_ON_FAIL(readUntilTermination(process, outExecuteResult));
+    return writeResult;
+}
+
 static Index _getCount(List<Byte>* buf)
 {
     return buf ? buf->getCount() : 0;
@@ -28,6 +28,13 @@ struct ProcessUtil
     /// Execute the command line
     static SlangResult execute(const CommandLine& commandLine, ExecuteResult& outExecuteResult);
 
+    /// Execute the command line, writing `standardInput` to the standard input of the process.
+    /// The standard input is closed once written, so the process sees the end of its input.
+    static SlangResult execute(
+        const CommandLine& commandLine,
+        ConstArrayView<Byte> standardInput,
+        ExecuteResult& outExecuteResult);
+
     /// Read from read from streams until process terminates.
     /// Passing nullptr for a stream, will just discard what's in the stream
     static SlangResult readUntilTermination(
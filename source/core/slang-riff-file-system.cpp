@@ -3,6 +3,9 @@
 #include "slang-blob.h"
 #include "slang-com-helper.h"
 #include "slang-com-ptr.h"
+#include "slang-task-util.h"
+
+#include <atomic>
 
 // Compression systems
 #include "slang-deflate-compression-system.h"
@@ -51,6 +54,13 @@ SlangResult RiffFileSystem::loadFile(char const* path, ISlangBlob** outBlob)
 
     ISlangBlob* contents = entry->m_contents;
 
+    if (auto uncompressedContents = m_uncompressedContents.tryGetValue(entry->m_canonicalPath))
+    {
+        (*uncompressedContents)->addRef();
+        *outBlob = *uncompressedContents;
+        return SLANG_OK;
+    }
+
     if (m_compressionSystem)
     {
         // Okay lets decompress into a blob
@@ -80,6 +90,7 @@ SlangResult RiffFileSystem::saveFile(const char* path, const void* data, size_t
 {
     Entry* entry;
     SLANG_RETURN_ON_FAIL(_requireFile(path, &entry));
+    m_uncompressedContents.remove(entry->m_canonicalPath);
 
     ComPtr<ISlangBlob> contents;
     if (m_compressionSystem)
@@ -115,12 +126,30 @@ SlangResult RiffFileSystem::saveFileBlob(const char* path, ISlangBlob* dataBlob)
 }
 
 SlangResult RiffFileSystem::loadArchive(const void* archive, size_t archiveSizeInBytes)
+{
+    return _loadArchive(archive, archiveSizeInBytes, nullptr);
+}
+
+SlangResult RiffFileSystem::loadArchiveInPlace(ISlangBlob* archive)
+{
+    if (!archive)
+    {
+        return SLANG_E_INVALID_ARG;
+    }
+    return _loadArchive(archive->getBufferPointer(), archive->getBufferSize(), archive);
+}
+
+SlangResult RiffFileSystem::_loadArchive(
+    const void* archive,
+    size_t archiveSizeInBytes,
+    ISlangBlob* archiveBlob)
 {
     // Load the riff
+    //
+    // The entries are copied out of the container below, so it can simply
+    // reference the archive data in place.
     RiffContainer container;
-
-    MemoryStreamBase stream(FileAccess::Read, archive, archiveSizeInBytes);
-    SLANG_RETURN_ON_FAIL(RiffUtil::read(&stream, container));
+    SLANG_RETURN_ON_FAIL(RiffUtil::readInPlace(archive, archiveSizeInBytes, container));
 
     RiffContainer::ListChunk* rootList = container.getRoot();
     // Make sure it's the right type
@@ -131,6 +160,7 @@ SlangResult RiffFileSystem::loadArchive(const void* archive, size_t archiveSizeI
 
     // Clear the contents
     _clear();
+    m_uncompressedContents.clear();
 
     // Find the header
     const auto header = rootList->findContainedData<RiffFileSystemBinary::Header>(
@@ -206,8 +236,18 @@ SlangResult RiffFileSystem::loadArchive(const void* archive, size_t archiveSizeI
                         return SLANG_FAIL;
                     }
 
-                    // Get the compressed data
-                    dstEntry.m_contents = RawBlob::create(srcData, srcEntry->compressedSize);
+                    // Get the compressed data. When loading in place the contents reference the
+                    // archive, and keep it alive.
+                    if (archiveBlob)
+                    {
+                        dstEntry.m_contents = ScopeBlob::create(
+                            UnownedRawBlob::create(srcData, srcEntry->compressedSize),
+                            archiveBlob);
+                    }
+                    else
+                    {
+                        dstEntry.m_contents = RawBlob::create(srcData, srcEntry->compressedSize);
+                    }
                     break;
                 }
             case SLANG_PATH_TYPE_DIRECTORY:
@@ -227,6 +267,66 @@ SlangResult RiffFileSystem::loadArchive(const void* archive, size_t archiveSizeI
         }
     }
 
+    // Each file is compressed independently, so when there is more than one they can all be
+    // decompressed at the same time.
+    if (m_compressionSystem)
+    {
+        List<Entry*> fileEntries;
+        for (auto& [_, entry] : m_entries)
+        {
+            if (entry.m_type == SLANG_PATH_TYPE_FILE && entry.m_contents)
+                fileEntries.add(&entry);
+        }
+        if (fileEntries.getCount() > 1)
+        {
+            SLANG_RETURN_ON_FAIL(_decompressEntries(fileEntries));
+        }
+    }
+
+    return SLANG_OK;
+}
+
+SlangResult RiffFileSystem::_decompressEntries(const List<Entry*>& entries)
+{
+    const Index entryCount = entries.getCount();
+
+    List<ComPtr<ISlangBlob>> blobs;
+    blobs.setCount(entryCount);
+    List<SlangResult> results;
+    results.setCount(entryCount);
+
+    // Workers take the next entry to decompress until there are none left. Nothing
+    // they touch is shared apart from the counter, and the compression systems keep
+    // no state between calls.
+    std::atomic<Index> nextEntryIndex(0);
+    auto worker = [&]()
+    {
+        for (Index i = nextEntryIndex++; i < entryCount; i = nextEntryIndex++)
+        {
+            Entry* entry = entries[i];
+            ISlangBlob* contents = entry->m_contents;
+
+            ScopedAllocation alloc;
+            void* dst = alloc.allocateTerminated(entry->m_uncompressedSizeInBytes);
+            results[i] = m_compressionSystem->decompress(
+                contents->getBufferPointer(),
+                contents->getBufferSize(),
+                entry->m_uncompressedSizeInBytes,
+                dst);
+            if (SLANG_SUCCEEDED(results[i]))
+                blobs[i] = RawBlob::moveCreate(alloc);
+        }
+    };
+
+    // Archives are loaded without a session (the core module archive, say), so there is
+    // no task scheduler to hand the work to.
+    TaskUtil::runWorkers(nullptr, TaskUtil::calcExtraWorkerCount(entryCount), worker);
+
+    for (Index i = 0; i < entryCount; ++i)
+    {
+        SLANG_RETURN_ON_FAIL(results[i]);
+        m_uncompressedContents.add(entries[i]->m_canonicalPath, blobs[i]);
+    }
     return SLANG_OK;
 }
 
@@ -45,6 +45,15 @@ data is stored uncompressed. When compression is used, files 'contents' blob is
 *compressed* version of the contents. Calling loadFile/saveFile will uncompress/compress as need. If
 there is no compression contents is identical to the file contents.
 
+When a compressed archive with more than one file is loaded, all of its files are decompressed up
+front, on as many threads as there are hardware threads (each file is compressed independently). The
+decompressed contents are kept alongside the compressed ones, so that loadFile doesn't need to
+decompress again, at the cost of holding both in memory.
+
+An archive loaded with loadArchiveInPlace isn't copied: the files' (compressed) contents reference
+the archive blob directly. For an uncompressed archive mapped from disk (see
+loadArchiveFileSystemFromFile), files are then only read from disk when they are accessed.
+
 NOTE:
 * The RIFF chunk IDs are *slang specific*. It conforms to RIFF but is unlikely to be usable with
 other tooling.
@@ -74,6 +83,8 @@ public:
     // IArchiveFileSystem
     virtual SLANG_NO_THROW SlangResult SLANG_MCALL
     loadArchive(const void* archive, size_t archiveSizeInBytes) SLANG_OVERRIDE;
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL loadArchiveInPlace(ISlangBlob* archive)
+        SLANG_OVERRIDE;
     virtual SLANG_NO_THROW SlangResult SLANG_MCALL
     storeArchive(bool blobOwnsContent, ISlangBlob** outBlob) SLANG_OVERRIDE;
     virtual SLANG_NO_THROW void SLANG_MCALL setCompressionStyle(const CompressionStyle& style)
@@ -92,8 +103,21 @@ protected:
     void* getInterface(const Guid& guid);
     void* getObject(const Guid& guid);
 
+    /// Load the archive. If archiveBlob is set it holds the archive, and the contents of the files
+    /// reference it rather than being copied.
+    SlangResult _loadArchive(
+        const void* archive,
+        size_t archiveSizeInBytes,
+        ISlangBlob* archiveBlob);
+
+    /// Decompress the contents of all the given file entries into `m_uncompressedContents`
+    SlangResult _decompressEntries(const List<Entry*>& entries);
+
     ComPtr<ICompressionSystem> m_compressionSystem;
 
+    /// The decompressed contents of files loaded from a compressed archive, by canonical path
+    Dictionary<String, ComPtr<ISlangBlob>> m_uncompressedContents;
+
     CompressionStyle m_compressionStyle;
 };
 
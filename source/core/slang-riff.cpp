@@ -296,6 +296,24 @@ struct DumpVisitor : public RiffContainer::Visitor
 }
 
 /* static */ SlangResult RiffUtil::read(Stream* stream, RiffContainer& outContainer)
+{
+    return _read(stream, nullptr, 0, outContainer);
+}
+
+/* static */ SlangResult RiffUtil::readInPlace(
+    const void* data,
+    size_t dataSizeInBytes,
+    RiffContainer& outContainer)
+{
+    MemoryStreamBase stream(FileAccess::Read, data, dataSizeInBytes);
+    return _read(&stream, (const uint8_t*)data, dataSizeInBytes, outContainer);
+}
+
+/* static */ SlangResult RiffUtil::_read(
+    Stream* stream,
+    const uint8_t* inPlaceData,
+    size_t inPlaceDataSizeInBytes,
+    RiffContainer& outContainer)
 {
     typedef RiffContainer::ScopeChunk ScopeChunk;
     outContainer.reset();
@@ -368,11 +386,39 @@ struct DumpVisitor : public RiffContainer::Visitor
                 ScopeChunk scopeChunk(&outContainer, Chunk::Kind::Data, header.chunk.type);
                 RiffContainer::Data* data = outContainer.addData();
 
-                outContainer.setPayload(data, nullptr, header.chunk.size);
+                // If we are reading from memory, we can reference the payload where it is,
+                // as long as it has the same alignment an arena allocated payload would have.
+                const uint8_t* inPlacePayload = nullptr;
+                if (inPlaceData)
+                {
+                    const size_t offset = size_t(stream->getPosition());
+                    const size_t padSize = getPadSize(header.chunk.size);
+                    if (offset + padSize <= inPlaceDataSizeInBytes &&
+                        (size_t(inPlaceData + offset) &
+                         (RiffContainer::kPayloadMinAlignment - 1)) == 0)
+                    {
+                        inPlacePayload = inPlaceData + offset;
+                    }
+                }
 
                 size_t readSize;
-                SLANG_RETURN_ON_FAIL(
-                    readPayload(stream, header.chunk.size, data->getPayload(), readSize));
+                if (inPlacePayload)
+                {
+                    outContainer.setUnowned(
+                        data,
+                        const_cast<uint8_t*>(inPlacePayload),
+                        header.chunk.size);
+
+                    readSize = getPadSize(header.chunk.size);
+                    SLANG_RETURN_ON_FAIL(stream->seek(SeekOrigin::Current, Int64(readSize)));
+                }
+                else
+                {
+                    outContainer.setPayload(data, nullptr, header.chunk.size);
+
+                    SLANG_RETURN_ON_FAIL(
+                        readPayload(stream, header.chunk.size, data->getPayload(), readSize));
+                }
 
                 // All read sizes must end up aligned
                 SLANG_ASSERT((readSize & kRiffPadMask) == 0);
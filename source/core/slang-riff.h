@@ -526,6 +526,23 @@ struct RiffUtil
 
     /// Read the stream into the container
     static SlangResult read(Stream* stream, RiffContainer& outContainer);
+
+    /// Read a container held in memory.
+    ///
+    /// Unlike `read`, data chunk payloads that are suitably aligned are referenced in place
+    /// instead of being copied into the container, so `data` must remain valid (and unchanged)
+    /// for as long as the container is used.
+    static SlangResult readInPlace(
+        const void* data,
+        size_t dataSizeInBytes,
+        RiffContainer& outContainer);
+
+protected:
+    static SlangResult _read(
+        Stream* stream,
+        const uint8_t* inPlaceData,
+        size_t inPlaceDataSizeInBytes,
+        RiffContainer& outContainer);
 };
 
 } // namespace Slang
@@ -109,6 +109,12 @@ bool StringSlicePool::operator==(const ThisType& rhs) const
     return true;
 }
 
+size_t StringSlicePool::calcMemoryUsed() const
+{
+    return m_arena.calcTotalMemoryAllocated() + m_slices.getCapacity() * sizeof(Slice) +
+           m_map.getCount() * (sizeof(Slice) + sizeof(Handle));
+}
+
 void StringSlicePool::clear()
 {
     m_map.clear();
@@ -76,6 +76,9 @@ public:
     /// Empty contents
     void clear();
 
+    /// Estimate of the memory held by the pool in bytes, including the slice contents
+    size_t calcMemoryUsed() const;
+
     /// Get the slice from the handle
     const UnownedStringSlice& getSlice(Handle handle) const { return m_slices[UInt(handle)]; }
 
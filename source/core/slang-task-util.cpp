@@ -0,0 +1,109 @@
+#include "slang-task-util.h"
+
+#include "../core/slang-math.h"
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace Slang
+{
+
+namespace
+{
+
+// State shared between a call to `runWorkers` and the workers it submitted to a
+// scheduler. It is reference counted, because a submitted worker may only be started
+// by the scheduler after `runWorkers` has returned.
+struct ScheduledWorkerState
+{
+    std::mutex mutex;
+    std::condition_variable condition;
+    const std::function<void()>* worker = nullptr;
+    Index runningCount = 0;
+    bool isClosed = false;
+};
+
+struct ScheduledWorker
+{
+    std::shared_ptr<ScheduledWorkerState> state;
+
+    static void run(void* context)
+    {
+        std::unique_ptr<ScheduledWorker> scheduledWorker(static_cast<ScheduledWorker*>(context));
+        auto& state = *scheduledWorker->state;
+        {
+            std::lock_guard<std::mutex> lock(state.mutex);
+            if (state.isClosed)
+                return;
+            state.runningCount++;
+        }
+
+        (*state.worker)();
+
+        std::lock_guard<std::mutex> lock(state.mutex);
+        state.runningCount--;
+        state.condition.notify_all();
+    }
+};
+
+} // namespace
+
+/* static */ void TaskUtil::runWorkers(
+    slang::ITaskScheduler_Experimental* scheduler,
+    Index extraWorkerCount,
+    const std::function<void()>& worker)
+{
+    if (extraWorkerCount <= 0)
+    {
+        worker();
+        return;
+    }
+
+    if (!scheduler)
+    {
+        List<std::thread> threads;
+        for (Index i = 0; i < extraWorkerCount; ++i)
+        {
+            threads.add(std::thread(worker));
+        }
+        // The calling thread does its share of the work too.
+        worker();
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+        return;
+    }
+
+    auto state = std::make_shared<ScheduledWorkerState>();
+    state->worker = &worker;
+    for (Index i = 0; i < extraWorkerCount; ++i)
+    {
+        scheduler->scheduleTask(&ScheduledWorker::run, new ScheduledWorker{state});
+    }
+
+    worker();
+
+    // Workers that haven't started yet are no longer needed, but the ones that are
+    // running may still be using `worker`.
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->isClosed = true;
+    state->condition.wait(lock, [&] { return state->runningCount == 0; });
+}
+
+/* static */ Index TaskUtil::calcExtraWorkerCount(Index itemCount)
+{
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+    // WebAssembly built without threads can't start any
+    SLANG_UNUSED(itemCount);
+    return 0;
+#else
+    return Math::Max(
+        Index(0),
+        Math::Min(itemCount, Index(std::thread::hardware_concurrency())) - 1);
+#endif
+}
+
+} // namespace Slang
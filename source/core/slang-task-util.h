@@ -0,0 +1,35 @@
+#pragma once
+#include "../core/slang-basic.h"
+#include "slang.h"
+
+#include <functional>
+
+namespace Slang
+{
+
+/// Helpers for running work on several threads.
+///
+/// Parallel work inside the compiler goes through here, so that it can be handed to
+/// an application supplied `ITaskScheduler_Experimental` (see `SessionDesc::taskScheduler`)
+/// instead of oversubscribing the machine with threads of its own.
+struct TaskUtil
+{
+    /// Run `worker` on the calling thread, and at the same time on up to `extraWorkerCount`
+    /// other threads. Returns once every call of `worker` that was started has returned.
+    ///
+    /// If `scheduler` is set the other workers are submitted to it, otherwise each of them
+    /// runs on a new thread. A submitted worker that the scheduler only starts after the
+    /// calling thread's worker has returned does nothing, so a busy scheduler can't hold
+    /// up the caller. Workers should therefore share the work through something like an
+    /// atomic index, taking items until there are none left.
+    static void runWorkers(
+        slang::ITaskScheduler_Experimental* scheduler,
+        Index extraWorkerCount,
+        const std::function<void()>& worker);
+
+    /// The number of extra workers worth starting to process `itemCount` items, taking
+    /// the number of hardware threads into account.
+    static Index calcExtraWorkerCount(Index itemCount);
+};
+
+} // namespace Slang
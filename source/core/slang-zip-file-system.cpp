@@ -3,6 +3,7 @@
 #include "slang-blob.h"
 #include "slang-com-helper.h"
 #include "slang-com-ptr.h"
+#include "slang-dictionary.h"
 #include "slang-implicit-directory-collector.h"
 #include "slang-io.h"
 #include "slang-riff.h"
@@ -63,6 +64,8 @@ public:
     // IArchiveFileSystem
     virtual SLANG_NO_THROW SlangResult SLANG_MCALL
     loadArchive(const void* archive, size_t archiveSizeInBytes) SLANG_OVERRIDE;
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL loadArchiveInPlace(ISlangBlob* archive)
+        SLANG_OVERRIDE;
     virtual SLANG_NO_THROW SlangResult SLANG_MCALL
     storeArchive(bool blobOwnsContent, ISlangBlob** outBlob) SLANG_OVERRIDE;
     virtual SLANG_NO_THROW void SLANG_MCALL setCompressionStyle(const CompressionStyle& style)
@@ -99,6 +102,12 @@ protected:
 
     void _rebuildMap();
 
+    /// Initialize a reader of the archive held in m_data or m_archiveBlob
+    SlangResult _initReader(const void* archive, size_t archiveSizeInBytes);
+
+    /// True if path is a directory only because there are entries inside of it
+    bool _isImplicitDirectory(const String& fixedPath);
+
     /// Returns true if the named item is at the index
     UnownedStringSlice _getPathAtIndex(Index index);
 
@@ -113,6 +122,16 @@ protected:
     UIntSet m_removedSet;
 
     ScopedAllocation m_data;
+    // Set when the archive is read in place from a blob, rather than from m_data.
+    ComPtr<ISlangBlob> m_archiveBlob;
+
+    // The contents of files that have been loaded, by index, so each is only decompressed once
+    Dictionary<mz_uint, ComPtr<ISlangBlob>> m_contentsCache;
+
+    // The implicit directories of all the entries. Built when first needed, and cleared
+    // whenever an entry is added or removed.
+    HashSet<String> m_implicitDirectories;
+    bool m_hasImplicitDirectories = false;
 
     mz_uint m_compressionLevel = MZ_BEST_COMPRESSION;
     Mode m_mode = Mode::None;
@@ -203,6 +222,8 @@ ZipFileSystemImpl::~ZipFileSystemImpl()
 void ZipFileSystemImpl::_rebuildMap()
 {
     m_pathMap.clear();
+    m_contentsCache.clear();
+    m_hasImplicitDirectories = false;
 
     const mz_uint entryCount = mz_zip_reader_get_num_files(&m_archive);
 
@@ -329,13 +350,15 @@ SlangResult ZipFileSystemImpl::_requireModeImpl(Mode newMode)
             case Mode::None:
                 {
                     m_data.deallocate();
+                    m_archiveBlob.setNull();
                     mz_zip_end(&m_archive);
                     break;
                 }
             case Mode::ReadWrite:
                 {
-                    // If nothing is removed, we can just convert
-                    if (m_removedSet.isEmpty())
+                    // If nothing is removed, we can just convert. That isn't possible if the
+                    // archive is read in place, because the writer takes over the memory.
+                    if (m_removedSet.isEmpty() && !m_archiveBlob)
                     {
                         // Convert the reader into the writer
                         if (!mz_zip_writer_init_from_reader(&m_archive, nullptr))
@@ -355,6 +378,7 @@ SlangResult ZipFileSystemImpl::_requireModeImpl(Mode newMode)
                         m_removedSet.clear();
                         // Don't need the read data anymore
                         m_data.deallocate();
+                        m_archiveBlob.setNull();
 
                         // Free the current archive
                         mz_zip_end(&m_archive);
@@ -402,12 +426,7 @@ SlangResult ZipFileSystemImpl::_requireModeImpl(Mode newMode)
                     mz_zip_writer_end(&m_archive);
 
                     // Read
-                    mz_zip_zero_struct(&m_archive);
-                    if (!mz_zip_reader_init_mem(
-                            &m_archive,
-                            m_data.getData(),
-                            m_data.getSizeInBytes(),
-                            0))
+                    if (SLANG_FAILED(_initReader(m_data.getData(), m_data.getSizeInBytes())))
                     {
                         m_data.deallocate();
                         return SLANG_FAIL;
@@ -480,6 +499,12 @@ SlangResult ZipFileSystemImpl::loadFile(char const* path, ISlangBlob** outBlob)
     mz_uint index;
     SLANG_RETURN_ON_FAIL(_findEntryIndex(path, index));
 
+    if (auto contents = m_contentsCache.tryGetValue(index))
+    {
+        *outBlob = ComPtr<ISlangBlob>(*contents).detach();
+        return SLANG_OK;
+    }
+
     // Check it's a file
     mz_zip_archive_file_stat fileStat;
     if (!mz_zip_reader_file_stat(&m_archive, index, &fileStat) || fileStat.m_is_directory)
@@ -506,7 +531,11 @@ SlangResult ZipFileSystemImpl::loadFile(char const* path, ISlangBlob** outBlob)
         return SLANG_FAIL;
     }
 
-    *outBlob = RawBlob::moveCreate(alloc).detach();
+    // Blobs are immutable, so the same contents can be handed out by later loads
+    ComPtr<ISlangBlob> contents = RawBlob::moveCreate(alloc);
+    m_contentsCache.add(index, contents);
+
+    *outBlob = contents.detach();
     return SLANG_OK;
 }
 
@@ -536,6 +565,16 @@ SlangResult ZipFileSystemImpl::getPathType(const char* path, SlangPathType* outP
     else
     {
         // It could be an *implicit* directory (ie as part of a path). So lets look for that...
+        if (!ImplicitDirectoryCollector::isRootPath(fixedPath.getUnownedSlice()))
+        {
+            if (_isImplicitDirectory(fixedPath))
+            {
+                *outPathType = SLANG_PATH_TYPE_DIRECTORY;
+                return SLANG_OK;
+            }
+            return SLANG_E_NOT_FOUND;
+        }
+
         ImplicitDirectoryCollector collector(fixedPath);
         SLANG_RETURN_ON_FAIL(
             _getPathContents(ImplicitDirectoryCollector::State::DirectoryExists, &collector));
@@ -549,6 +588,41 @@ SlangResult ZipFileSystemImpl::getPathType(const char* path, SlangPathType* outP
     return SLANG_E_NOT_FOUND;
 }
 
+bool ZipFileSystemImpl::_isImplicitDirectory(const String& fixedPath)
+{
+    if (!m_hasImplicitDirectories)
+    {
+        m_implicitDirectories.clear();
+
+        const mz_uint entryCount = mz_zip_reader_get_num_files(&m_archive);
+        for (mz_uint i = 0; i < entryCount; ++i)
+        {
+            if (m_removedSet.contains(i))
+            {
+                continue;
+            }
+
+            mz_zip_archive_file_stat fileStat;
+            if (!mz_zip_reader_file_stat(&m_archive, i, &fileStat))
+            {
+                continue;
+            }
+
+            // Every directory the entry is inside of exists
+            const UnownedStringSlice entryPath = UnownedStringSlice(fileStat.m_filename).trim('/');
+            for (Index j = 0; j < entryPath.getLength(); ++j)
+            {
+                if (entryPath[j] == '/')
+                {
+                    m_implicitDirectories.add(String(entryPath.head(j)));
+                }
+            }
+        }
+        m_hasImplicitDirectories = true;
+    }
+    return m_implicitDirectories.contains(fixedPath);
+}
+
 SlangResult ZipFileSystemImpl::getPath(PathKind pathKind, const char* path, ISlangBlob** outPath)
 {
     switch (pathKind)
@@ -732,6 +806,7 @@ SlangResult ZipFileSystemImpl::saveFile(const char* path, const void* data, size
 
     // Set in the map
     m_pathMap.add(fixedPath.getUnownedSlice(), entryCount);
+    m_hasImplicitDirectories = false;
     return SLANG_OK;
 }
 
@@ -765,6 +840,8 @@ SlangResult ZipFileSystemImpl::remove(const char* path)
 
     // Mark as removed
     m_removedSet.add(index);
+    m_contentsCache.remove(index);
+    m_hasImplicitDirectories = false;
     return SLANG_OK;
 }
 
@@ -799,6 +876,7 @@ SlangResult ZipFileSystemImpl::createDirectory(const char* path)
 
     // Set the index, that we added at end
     m_pathMap.add(fixedPath.getUnownedSlice(), entryCount);
+    m_hasImplicitDirectories = false;
     return SLANG_OK;
 }
 
@@ -814,7 +892,15 @@ SlangResult ZipFileSystemImpl::storeArchive(bool blobOwnsContent, ISlangBlob** o
 
     ComPtr<ISlangBlob> blob;
 
-    if (blobOwnsContent)
+    if (m_archiveBlob)
+    {
+        // The archive is being read in place, so it is unchanged
+        blob = blobOwnsContent ? RawBlob::create(
+                                     m_archiveBlob->getBufferPointer(),
+                                     m_archiveBlob->getBufferSize())
+                               : m_archiveBlob;
+    }
+    else if (blobOwnsContent)
     {
         // Takes a copy
         blob = RawBlob::create(m_data.getData(), Index(m_data.getSizeInBytes()));
@@ -839,11 +925,35 @@ SlangResult ZipFileSystemImpl::loadArchive(const void* archive, size_t archiveSi
         return SLANG_E_OUT_OF_MEMORY;
     }
 
+    return _initReader(m_data.getData(), archiveSizeInBytes);
+}
+
+SlangResult ZipFileSystemImpl::loadArchiveInPlace(ISlangBlob* archive)
+{
+    if (!archive)
+    {
+        return SLANG_E_INVALID_ARG;
+    }
+
+    // Making the mode None empties the archive
+    SLANG_RETURN_ON_FAIL(_requireMode(Mode::None));
+
+    m_archiveBlob = archive;
+    const SlangResult res = _initReader(archive->getBufferPointer(), archive->getBufferSize());
+    if (SLANG_FAILED(res))
+    {
+        m_archiveBlob.setNull();
+    }
+    return res;
+}
+
+SlangResult ZipFileSystemImpl::_initReader(const void* archive, size_t archiveSizeInBytes)
+{
     // Initialize archive
     mz_zip_zero_struct(&m_archive);
 
-    // Read the contents of the archive, and make m_archive own it
-    if (!mz_zip_reader_init_mem(&m_archive, m_data.getData(), archiveSizeInBytes, 0))
+    // Read the contents of the archive
+    if (!mz_zip_reader_init_mem(&m_archive, archive, archiveSizeInBytes, 0))
     {
         return SLANG_FAIL;
     }
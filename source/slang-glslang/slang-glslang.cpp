@@ -6,10 +6,13 @@
 #include "glslang/Public/ShaderLang.h"
 #include "slang.h"
 #include "spirv-tools/libspirv.h"
+#include "spirv-tools/linker.hpp"
 #include "spirv-tools/optimizer.hpp"
 
 #ifdef _WIN32
 #include <windows.h>
+#else
+#include <dlfcn.h>
 #endif
 
 #include <cassert>
@@ -182,6 +185,56 @@ extern "C"
     return tools.Validate(contents, contentsSize, options);
 }
 
+// Link SPIR-V modules, such as an entry point and the precompiled modules it uses.
+extern "C"
+#ifdef _MSC_VER
+    _declspec(dllexport)
+#else
+    __attribute__((__visibility__("default")))
+#endif
+        int glslang_linkSPIRV(const glslang_LinkRequest* request)
+{
+    if (request->sizeInBytes < sizeof(glslang_LinkRequest))
+    {
+        return 1;
+    }
+
+    spvtools::Context context(SPV_ENV_UNIVERSAL_1_5);
+    context.SetMessageConsumer(
+        [&](spv_message_level_t level, const char*, const spv_position_t&, const char* message)
+        {
+            if (!request->diagnosticFunc || !message || level > SPV_MSG_WARNING)
+            {
+                return;
+            }
+            std::string line = message;
+            line += "\n";
+            request->diagnosticFunc(line.c_str(), line.size(), request->diagnosticUserData);
+        });
+
+    std::vector<uint32_t> linked;
+    spvtools::LinkerOptions options;
+    if (spvtools::Link(
+            context,
+            request->modules,
+            request->moduleWordCounts,
+            request->moduleCount,
+            &linked,
+            options) != SPV_SUCCESS)
+    {
+        return 1;
+    }
+
+    if (request->outputFunc)
+    {
+        request->outputFunc(
+            linked.data(),
+            linked.size() * sizeof(uint32_t),
+            request->outputUserData);
+    }
+    return 0;
+}
+
 // Apply the SPIRV-Tools optimizer to generated SPIR-V based on the desired optimization level
 // TODO: add flag for optimizing SPIR-V size as well
 static void glslang_optimizeSPIRV(
@@ -367,7 +420,9 @@ static void glslang_optimizeSPIRV(
             optimizer.RegisterPass(spvtools::CreateCFGCleanupPass());
 #endif
 
-            break;
+            // With no passes to run, running the optimizer would only parse the
+            // module and write it back out unchanged, so leave `ioSpirv` as it is.
+            return;
         }
     // TODO(JS): It would be better if we had some distinction here where 'high' meant optimize
     // 'in a reasonable time' for a better optimization, and 'maximal' meant compilation might
@@ -820,6 +875,31 @@ static int glslang_dissassembleSPIRV(const glslang_CompileRequest_1_2& request)
     return 0;
 }
 
+// Keep this library loaded until the process exits.
+//
+// glslang builds the tables of built-in symbols for a combination of version, profile, SPIR-V
+// version and stage the first time a shader needs them, and shares them across every later
+// compile until `FinalizeProcess`. Each global session loads the library, so without this the
+// tables would be built again whenever an application creates a global session after
+// releasing the last one.
+static void _keepLibraryLoaded()
+{
+#ifdef _WIN32
+    HMODULE module = nullptr;
+    GetModuleHandleExW(
+        GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS | GET_MODULE_HANDLE_EX_FLAG_PIN,
+        (LPCWSTR)&_keepLibraryLoaded,
+        &module);
+#else
+    // Opening the library again with RTLD_NODELETE stops the last dlclose from unloading it.
+    Dl_info info;
+    if (dladdr((void*)&_keepLibraryLoaded, &info) && info.dli_fname)
+    {
+        dlopen(info.dli_fname, RTLD_LAZY | RTLD_NOLOAD | RTLD_NODELETE);
+    }
+#endif
+}
+
 // We need a per process initialization
 class ProcessInitializer
 {
@@ -835,6 +915,7 @@ public:
             {
                 return false;
             }
+            _keepLibraryLoaded();
             m_isInitialized = true;
         }
         return true;
@@ -842,6 +923,7 @@ public:
 
     ~ProcessInitializer()
     {
+        // As the library is kept loaded, this is called once the process exits.
         // We *assume* will only be called once dll is detatched and that will be on a single thread
         if (m_isInitialized)
         {
@@ -157,4 +157,23 @@ typedef int (*glslang_CompileFunc_1_1)(glslang_CompileRequest_1_1* request);
 typedef int (*glslang_CompileFunc_1_2)(glslang_CompileRequest_1_2* request);
 typedef bool (*glslang_ValidateSPIRVFunc)(const uint32_t* contents, int contentsSize);
 
+/// Links SPIR-V modules into one, resolving the functions each module imports
+/// against the functions the others export, as given by their LinkageAttributes.
+struct glslang_LinkRequest
+{
+    size_t sizeInBytes; ///< Size in bytes of this structure
+
+    const uint32_t* const* modules; ///< The words of each module to link
+    const size_t* moduleWordCounts; ///< The number of words in each module
+    size_t moduleCount;
+
+    glslang_OutputFunc diagnosticFunc;
+    void* diagnosticUserData;
+
+    glslang_OutputFunc outputFunc;
+    void* outputUserData;
+};
+
+typedef int (*glslang_LinkSPIRVFunc)(const glslang_LinkRequest* request);
+
 #endif
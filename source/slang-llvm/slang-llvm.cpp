@@ -17,8 +17,10 @@
 #include "clang/FrontendTool/Utils.h"
 #include "clang/Lex/PreprocessorOptions.h"
 #include "llvm/ADT/Statistic.h"
+#include "llvm/Bitcode/BitcodeWriter.h"
 #include "llvm/Config/llvm-config.h"
 #include "llvm/LinkAllPasses.h"
+#include "llvm/Passes/PassBuilder.h"
 #include "llvm/Option/Arg.h"
 #include "llvm/Option/ArgList.h"
 #include "llvm/Option/OptTable.h"
@@ -26,6 +28,7 @@
 #include "llvm/Support/Compiler.h"
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/ManagedStatic.h"
+#include "llvm/Support/Host.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/Process.h"
 #include "llvm/Support/Signals.h"
@@ -40,6 +43,8 @@
 #include "llvm/ExecutionEngine/JITEventListener.h"
 #include "llvm/ExecutionEngine/JITLink/JITLinkMemoryManager.h"
 #include "llvm/ExecutionEngine/JITSymbol.h"
+#include "llvm/ExecutionEngine/ObjectCache.h"
+#include "llvm/ExecutionEngine/Orc/CompileUtils.h"
 #include "llvm/ExecutionEngine/Orc/ExecutionUtils.h"
 #include "llvm/ExecutionEngine/Orc/LLJIT.h"
 #include "llvm/ExecutionEngine/Orc/ThreadSafeModule.h"
@@ -57,12 +62,19 @@
 #include <compiler-core/slang-downstream-compiler.h>
 #include <compiler-core/slang-slice-allocator.h>
 #include <core/slang-com-object.h>
+#include <core/slang-crypto.h>
+#include <core/slang-dictionary.h>
 #include <core/slang-hash.h>
 #include <core/slang-list.h>
+#include <core/slang-persistent-cache.h>
+#include <core/slang-platform.h>
 #include <core/slang-shared-library.h>
 #include <core/slang-string-util.h>
 #include <core/slang-string.h>
+#include <atomic>
+#include <mutex>
 #include <stdio.h>
+#include <thread>
 
 // We want to make math functions available to the JIT
 #if SLANG_GCC_FAMILY && __GNUC__ < 6
@@ -111,6 +123,8 @@ using namespace llvm::orc;
 
 using namespace Slang;
 
+class LLVMJITSession;
+
 class LLVMDownstreamCompiler : public ComBaseObject, public IDownstreamCompiler
 {
 public:
@@ -151,9 +165,146 @@ public:
     void* getInterface(const Guid& guid);
     void* getObject(const Guid& guid);
 
+    /// Creates the artifact for a module that has been compiled to LLVM IR.
+    /// If `moduleKey` is set, the machine code of the module is kept in the persistent cache.
+    SlangResult _createArtifactForModule(
+        const CompileOptions& options,
+        const SHA1::Digest* moduleKey,
+        std::unique_ptr<llvm::Module> module,
+        std::unique_ptr<LLVMContext> llvmContext,
+        IArtifactDiagnostics* diagnostics,
+        IArtifact** outArtifact);
+
+    /// Returns the persistent cache, or nullptr if SLANG_DOWNSTREAM_CACHE_PATH isn't set.
+    PersistentCache* _getPersistentCache();
+
+    /// Returns the JIT shared by all compiles, creating it if needed.
+    std::shared_ptr<LLVMJITSession> _getJITSession(std::string& outError);
+
+    /// Returns the bitcode of an earlier compile with the same key, or nullptr.
+    ComPtr<ISlangBlob> _findCachedModule(const SHA1::Digest& key);
+    void _addCachedModule(const SHA1::Digest& key, llvm::Module* module);
+
+    /// The most modules held in the cache before it is emptied.
+    static const Index kMaxCachedModules = 256;
+
     Desc m_desc;
+
+    /// The LLVM IR of earlier compiles, as bitcode, keyed by a hash of their source and options.
+    /// Compiling the same source again only has to parse the bitcode and JIT it, which skips
+    /// running the Clang front end over the source and the prelude it contains. Compiles that
+    /// produced diagnostics aren't cached, so that a hit never loses them.
+    Dictionary<SHA1::Digest, ComPtr<ISlangBlob>> m_cachedModules;
+    std::mutex m_cachedModulesMutex;
+
+    /// Keeps the bitcode and machine code of compiles on disk, so that a later process only has
+    /// to load and link them. Uses the directory that SLANG_DOWNSTREAM_CACHE_PATH names for the
+    /// other downstream compile results.
+    RefPtr<PersistentCache> m_persistentCache;
+    std::once_flag m_persistentCacheInit;
+
+    /// Shared with the libraries it created, which can outlive the compiler.
+    std::shared_ptr<LLVMJITSession> m_jitSession;
+    std::mutex m_jitSessionMutex;
+};
+
+/* !!!!!!!!!!!!!!!!!!!!! LLVMObjectCache !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! */
+
+/* Stores the machine code the JIT compiles for a module in the persistent cache, and hands it
+back instead of compiling the module again. A module is only cached if its identifier has been
+set to the key of its compile. The object code depends on the LLVM version and the host CPU as
+well as the module, so those are part of the key. */
+class LLVMObjectCache : public llvm::ObjectCache
+{
+public:
+    LLVMObjectCache(PersistentCache* cache)
+        : m_cache(cache)
+    {
+        DigestBuilder<SHA1> builder;
+        builder.append(toSlice(LLVM_VERSION_STRING));
+        builder.append(toSlice(LLVM_DEFAULT_TARGET_TRIPLE));
+        const auto cpuName = llvm::sys::getHostCPUName();
+        builder.append(UnownedStringSlice(cpuName.data(), cpuName.size()));
+        m_targetKey = builder.finalize();
+    }
+
+    void notifyObjectCompiled(const llvm::Module* module, MemoryBufferRef object) override
+    {
+        PersistentCache::Key key;
+        if (_getKey(module, key))
+        {
+            auto blob = RawBlob::create(object.getBufferStart(), object.getBufferSize());
+            m_cache->writeEntry(key, blob);
+        }
+    }
+
+    std::unique_ptr<MemoryBuffer> getObject(const llvm::Module* module) override
+    {
+        PersistentCache::Key key;
+        ComPtr<ISlangBlob> blob;
+        if (!_getKey(module, key) || SLANG_FAILED(m_cache->readEntry(key, blob.writeRef())))
+        {
+            return nullptr;
+        }
+        StringRef data((const char*)blob->getBufferPointer(), blob->getBufferSize());
+        return MemoryBuffer::getMemBufferCopy(data);
+    }
+
+protected:
+    bool _getKey(const llvm::Module* module, PersistentCache::Key& outKey)
+    {
+        const auto& identifier = module->getModuleIdentifier();
+        if (identifier.empty())
+        {
+            return false;
+        }
+        DigestBuilder<SHA1> builder;
+        builder.append(m_targetKey);
+        builder.append(UnownedStringSlice(identifier.data(), identifier.size()));
+        outKey = builder.finalize();
+        return true;
+    }
+
+    RefPtr<PersistentCache> m_cache;
+    SHA1::Digest m_targetKey;
 };
 
+/* !!!!!!!!!!!!!!!!!!!!! LLVMJITSession !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! */
+
+/* The JIT that all of the host callable compiles of a compiler add their modules to, so that the
+execution session, the target machine and the runtime functions are only set up once. The runtime
+functions are defined in one library, that every module links against. Each module is added to a
+library of its own, so modules can define the same symbols, and is removed from the JIT when the
+shared library holding it is released. */
+class LLVMJITSession
+{
+public:
+    /// Creates the session. On failure, returns nullptr and sets `outError`.
+    /// If `persistentCache` is set, the machine code of modules is kept in it.
+    static std::shared_ptr<LLVMJITSession> create(
+        PersistentCache* persistentCache,
+        std::string& outError);
+
+    /// Adds the module in a library of its own, and runs its initializers.
+    SlangResult addModule(
+        ThreadSafeModule module,
+        JITDylib*& outLib,
+        ResourceTrackerSP& outTracker);
+    /// Runs the deinitializers of a module added with `addModule`, and frees its code.
+    void removeModule(JITDylib* lib, ResourceTrackerSP tracker);
+
+    LLJIT* getJIT() { return m_jit.get(); }
+
+protected:
+    // Declared before the JIT so that it is destroyed after it.
+    std::unique_ptr<LLVMObjectCache> m_objectCache;
+    std::unique_ptr<LLJIT> m_jit;
+    JITDylib* m_stdcLib = nullptr;
+
+    // Setting up and running the initializers of libraries isn't safe to do concurrently.
+    std::mutex m_mutex;
+    uint64_t m_nextLibIndex = 0;
+};
 
 /* !!!!!!!!!!!!!!!!!!!!! LLVMJITSharedLibrary !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! */
 
@@ -172,16 +323,45 @@ public:
     virtual SLANG_NO_THROW void* SLANG_MCALL findSymbolAddressByName(char const* name)
         SLANG_OVERRIDE;
 
-    LLVMJITSharedLibrary(std::unique_ptr<llvm::orc::LLJIT> jit)
-        : m_jit(std::move(jit))
+    LLVMJITSharedLibrary(
+        std::shared_ptr<LLVMJITSession> session,
+        JITDylib* lib,
+        ResourceTrackerSP tracker)
+        : m_session(std::move(session)), m_lib(lib), m_tracker(std::move(tracker))
     {
     }
 
+    ~LLVMJITSharedLibrary();
+
+    /// Optimizes the module on another thread, from its unoptimized `bitcode`. Once the defined
+    /// `symbolNames` of the optimized module are compiled, symbols are looked up in it instead.
+    /// Addresses looked up before then stay valid for the lifetime of the library.
+    void startOptimizing(
+        ComPtr<ISlangBlob> bitcode,
+        std::vector<std::string> symbolNames,
+        int optimizationLevel,
+        std::string moduleIdentifier);
+
 protected:
     ISlangUnknown* getInterface(const SlangUUID& uuid);
     void* getObject(const SlangUUID& uuid);
 
-    std::unique_ptr<llvm::orc::LLJIT> m_jit;
+    void _optimize(
+        ISlangBlob* bitcode,
+        const std::vector<std::string>& symbolNames,
+        int optimizationLevel,
+        const std::string& moduleIdentifier);
+
+    std::shared_ptr<LLVMJITSession> m_session;
+    JITDylib* m_lib;
+    ResourceTrackerSP m_tracker;
+
+    // Set only by the optimizing thread, before `m_isOptimized` is.
+    JITDylib* m_optimizedLib = nullptr;
+    ResourceTrackerSP m_optimizedTracker;
+    std::atomic<bool> m_isOptimized = false;
+    std::atomic<bool> m_isCancelled = false;
+    std::thread m_optimizeThread;
 };
 
 ISlangUnknown* LLVMJITSharedLibrary::getInterface(const SlangUUID& guid)
@@ -209,9 +389,132 @@ void* LLVMJITSharedLibrary::castAs(const Guid& guid)
     return getObject(guid);
 }
 
+LLVMJITSharedLibrary::~LLVMJITSharedLibrary()
+{
+    if (m_optimizeThread.joinable())
+    {
+        m_isCancelled = true;
+        m_optimizeThread.join();
+    }
+    if (m_optimizedLib)
+    {
+        m_session->removeModule(m_optimizedLib, std::move(m_optimizedTracker));
+    }
+    m_session->removeModule(m_lib, std::move(m_tracker));
+}
+
+void LLVMJITSharedLibrary::startOptimizing(
+    ComPtr<ISlangBlob> bitcode,
+    std::vector<std::string> symbolNames,
+    int optimizationLevel,
+    std::string moduleIdentifier)
+{
+    SLANG_ASSERT(!m_optimizeThread.joinable());
+    m_optimizeThread = std::thread(
+        [this,
+         bitcode = std::move(bitcode),
+         symbolNames = std::move(symbolNames),
+         optimizationLevel,
+         moduleIdentifier = std::move(moduleIdentifier)]()
+        { _optimize(bitcode, symbolNames, optimizationLevel, moduleIdentifier); });
+}
+
+void LLVMJITSharedLibrary::_optimize(
+    ISlangBlob* bitcode,
+    const std::vector<std::string>& symbolNames,
+    int optimizationLevel,
+    const std::string& moduleIdentifier)
+{
+    // Any failure leaves the unoptimized code in use, which is still correct.
+    auto llvmContext = std::make_unique<LLVMContext>();
+    StringRef data((const char*)bitcode->getBufferPointer(), bitcode->getBufferSize());
+    SMDiagnostic err;
+    auto module = llvm::parseIR(MemoryBufferRef(data, StringRef()), err, *llvmContext);
+    if (!module)
+    {
+        return;
+    }
+    module->setModuleIdentifier(moduleIdentifier);
+
+    // Optimize for the host, so that the cost models of the passes match the code the JIT makes.
+    std::unique_ptr<TargetMachine> targetMachine;
+    {
+        auto targetMachineBuilder = JITTargetMachineBuilder::detectHost();
+        if (targetMachineBuilder)
+        {
+            auto expectTargetMachine = targetMachineBuilder->createTargetMachine();
+            if (expectTargetMachine)
+            {
+                targetMachine = std::move(*expectTargetMachine);
+            }
+            else
+            {
+                consumeError(expectTargetMachine.takeError());
+            }
+        }
+        else
+        {
+            consumeError(targetMachineBuilder.takeError());
+        }
+    }
+
+    {
+        PassBuilder passBuilder(targetMachine.get());
+        LoopAnalysisManager loopAnalysis;
+        FunctionAnalysisManager functionAnalysis;
+        CGSCCAnalysisManager cgsccAnalysis;
+        ModuleAnalysisManager moduleAnalysis;
+        passBuilder.registerModuleAnalyses(moduleAnalysis);
+        passBuilder.registerCGSCCAnalyses(cgsccAnalysis);
+        passBuilder.registerFunctionAnalyses(functionAnalysis);
+        passBuilder.registerLoopAnalyses(loopAnalysis);
+        passBuilder.crossRegisterProxies(
+            loopAnalysis,
+            functionAnalysis,
+            cgsccAnalysis,
+            moduleAnalysis);
+
+        const auto level = optimizationLevel >= 3   ? PassBuilder::OptimizationLevel::O3
+                           : optimizationLevel == 2 ? PassBuilder::OptimizationLevel::O2
+                                                    : PassBuilder::OptimizationLevel::O1;
+        ModulePassManager passManager = passBuilder.buildPerModuleDefaultPipeline(level);
+        passManager.run(*module, moduleAnalysis);
+    }
+
+    if (m_isCancelled)
+    {
+        return;
+    }
+
+    JITDylib* lib = nullptr;
+    ResourceTrackerSP tracker;
+    if (SLANG_FAILED(m_session->addModule(
+            ThreadSafeModule(std::move(module), std::move(llvmContext)),
+            lib,
+            tracker)))
+    {
+        return;
+    }
+
+    // Compile everything now, rather than on the first lookup of the thread that uses it.
+    for (const auto& name : symbolNames)
+    {
+        auto symbol = m_session->getJIT()->lookup(*lib, name);
+        if (!symbol)
+        {
+            consumeError(symbol.takeError());
+        }
+    }
+
+    m_optimizedLib = lib;
+    m_optimizedTracker = std::move(tracker);
+    m_isOptimized.store(true, std::memory_order_release);
+}
+
 void* LLVMJITSharedLibrary::findSymbolAddressByName(char const* name)
 {
-    auto fnExpected = m_jit->lookup(name);
+    JITDylib* lib = m_isOptimized.load(std::memory_order_acquire) ? m_optimizedLib : m_lib;
+    auto fnExpected = m_session->getJIT()->lookup(*lib, name);
     if (fnExpected)
     {
         auto fn = std::move(*fnExpected);
@@ -548,6 +851,286 @@ static SlangResult _initLLVM()
 }
 
 
+/* static */ std::shared_ptr<LLVMJITSession> LLVMJITSession::create(
+    PersistentCache* persistentCache,
+    std::string& outError)
+{
+    std::shared_ptr<LLVMJITSession> session(new LLVMJITSession);
+
+    LLJITBuilder jitBuilder;
+    if (persistentCache)
+    {
+        session->m_objectCache.reset(new LLVMObjectCache(persistentCache));
+        llvm::ObjectCache* objectCache = session->m_objectCache.get();
+        jitBuilder.setCompileFunctionCreator(
+            [objectCache](JITTargetMachineBuilder targetMachineBuilder)
+                -> Expected<std::unique_ptr<IRCompileLayer::IRCompiler>>
+            {
+                auto targetMachine = targetMachineBuilder.createTargetMachine();
+                if (!targetMachine)
+                {
+                    return targetMachine.takeError();
+                }
+                return std::make_unique<TMOwningSimpleCompiler>(
+                    std::move(*targetMachine),
+                    objectCache);
+            });
+    }
+
+    Expected<std::unique_ptr<llvm::orc::LLJIT>> expectJit = jitBuilder.create();
+    if (!expectJit)
+    {
+        /* JS: NOTE!
+
+        It is worth saying there can be some odd issues around creating the JIT - if
+        LLVM-C is linked against.
+
+        If it is then LLVM will likely startup saying LLVM-C isn't found.
+        BUT if you have LLVM *installed* on your system (as is reasonable to do from a
+        LLVM distro, then at startup it *MIGHT* find a LLVM-C dll in that installation
+        (ie nothing to do with the version of LLVM linked with). This will likely lead
+        to an odd error saying the 'triple can't be found' and that no targets are
+        registered.
+
+        Also note that the behavior *may* be different with Debug/Release - because of
+        how the linked resolves symbols that are multiply defined.
+
+        If there are problems creating the JIT, check that LLVM-C is not linked against
+        (it should be disabled in the premake).
+        */
+
+        llvm::raw_string_ostream jitErrorStream(outError);
+        jitErrorStream << expectJit.takeError();
+        jitErrorStream.flush();
+        return nullptr;
+    }
+    session->m_jit = std::move(*expectJit);
+
+    // Used the following link to test this out
+    // https://www.llvm.org/docs/ORCv2.html
+    // https://www.llvm.org/docs/ORCv2.html#processandlibrarysymbols
+
+    auto& es = session->m_jit->getExecutionSession();
+
+    const DataLayout& dl = session->m_jit->getDataLayout();
+    MangleAndInterner mangler(es, dl);
+
+    auto stdcLibExpected = es.createJITDylib("stdc");
+    if (!stdcLibExpected)
+    {
+        llvm::raw_string_ostream jitErrorStream(outError);
+        jitErrorStream << stdcLibExpected.takeError();
+        jitErrorStream.flush();
+        return nullptr;
+    }
+    auto& stdcLib = *stdcLibExpected;
+
+    // Add all the symbolmap
+    SymbolMap symbolMap;
+
+    // symbolMap.insert(std::make_pair(mangler("sin"),
+    // JITEvaluatedSymbol::fromPointer(static_cast<double (*)(double)>(&sin))));
+
+    {
+        static const NameAndFunc funcs[] = {
+            SLANG_LLVM_FUNCS(SLANG_LLVM_FUNC) SLANG_PLATFORM_FUNCS(SLANG_LLVM_FUNC)};
+
+        for (auto& func : funcs)
+        {
+            symbolMap.insert(
+                std::make_pair(mangler(func.name), JITEvaluatedSymbol::fromPointer(func.func)));
+        }
+    }
+
+#if SLANG_PTR_IS_32 && SLANG_VC
+    {
+        // https://docs.microsoft.com/en-us/windows/win32/devnotes/-win32-alldiv
+        symbolMap.insert(std::make_pair(
+            mangler("_alldiv"),
+            JITEvaluatedSymbol::fromPointer(WinSpecific::_alldiv)));
+        symbolMap.insert(std::make_pair(
+            mangler("_allrem"),
+            JITEvaluatedSymbol::fromPointer(WinSpecific::_allrem)));
+        symbolMap.insert(std::make_pair(
+            mangler("_aullrem"),
+            JITEvaluatedSymbol::fromPointer(WinSpecific::_aullrem)));
+        symbolMap.insert(std::make_pair(
+            mangler("_aulldiv"),
+            JITEvaluatedSymbol::fromPointer(WinSpecific::_aulldiv)));
+    }
+#endif
+
+    if (auto err = stdcLib.define(absoluteSymbols(symbolMap)))
+    {
+        llvm::raw_string_ostream jitErrorStream(outError);
+        jitErrorStream << err;
+        jitErrorStream.flush();
+        return nullptr;
+    }
+    session->m_stdcLib = &stdcLib;
+
+    return session;
+}
+
+SlangResult LLVMJITSession::addModule(
+    ThreadSafeModule module,
+    JITDylib*& outLib,
+    ResourceTrackerSP& outTracker)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // The name of a library must be unique within the session.
+    const std::string libName = "module" + std::to_string(m_nextLibIndex++);
+    auto libExpected = m_jit->createJITDylib(libName);
+    if (!libExpected)
+    {
+        consumeError(libExpected.takeError());
+        return SLANG_FAIL;
+    }
+    auto& lib = *libExpected;
+
+    // Required or the runtime functions won't be found
+    lib.addToLinkOrder(*m_stdcLib);
+
+    auto tracker = lib.createResourceTracker();
+    if (auto err = m_jit->addIRModule(tracker, std::move(module)))
+    {
+        consumeError(std::move(err));
+        return SLANG_FAIL;
+    }
+
+    if (auto err = m_jit->initialize(lib))
+    {
+        consumeError(std::move(err));
+        consumeError(tracker->remove());
+        return SLANG_FAIL;
+    }
+
+    outLib = &lib;
+    outTracker = std::move(tracker);
+    return SLANG_OK;
+}
+
+void LLVMJITSession::removeModule(JITDylib* lib, ResourceTrackerSP tracker)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    consumeError(m_jit->deinitialize(*lib));
+    consumeError(tracker->remove());
+}
+
+/// True if the code of a compile is made callable before it is optimized, and is then
+/// optimized in the background.
+static bool _isTiered(const DownstreamCompileOptions& options)
+{
+    return (options.flags & DownstreamCompileOptions::Flag::TieredOptimization) &&
+           options.optimizationLevel != DownstreamCompileOptions::OptimizationLevel::None &&
+           (options.targetType == SLANG_SHADER_HOST_CALLABLE ||
+            options.targetType == SLANG_SHADER_SHARED_LIBRARY);
+}
+
+static SHA1::Digest _calcModuleKey(
+    const DownstreamCompileOptions& options,
+    const UnownedStringSlice& source)
+{
+    // Files found through the include paths are assumed not to change while the compiler is
+    // loaded, so only the paths themselves are part of the key.
+    DigestBuilder<SHA1> builder;
+    builder.append(source);
+    builder.append(options.targetType);
+    builder.append(options.sourceLanguage);
+    builder.append(options.optimizationLevel);
+    builder.append(options.floatingPointMode);
+    builder.append(options.flags);
+    for (const auto& define : options.defines)
+    {
+        builder.append(asStringSlice(define.nameWithSig));
+        builder.append(uint8_t(0));
+        builder.append(asStringSlice(define.value));
+        builder.append(uint8_t(0));
+    }
+    for (const auto& includePath : options.includePaths)
+    {
+        builder.append(asStringSlice(includePath));
+        builder.append(uint8_t(0));
+    }
+    return builder.finalize();
+}
+
+PersistentCache* LLVMDownstreamCompiler::_getPersistentCache()
+{
+    std::call_once(
+        m_persistentCacheInit,
+        [this]()
+        {
+            StringBuilder cachePath;
+            if (SLANG_SUCCEEDED(PlatformUtil::getEnvironmentVariable(
+                    toSlice("SLANG_DOWNSTREAM_CACHE_PATH"),
+                    cachePath)) &&
+                cachePath.getLength())
+            {
+                PersistentCache::Desc cacheDesc;
+                cacheDesc.directory = cachePath.getBuffer();
+                m_persistentCache = new PersistentCache(cacheDesc);
+            }
+        });
+    return m_persistentCache;
+}
+
+std::shared_ptr<LLVMJITSession> LLVMDownstreamCompiler::_getJITSession(std::string& outError)
+{
+    std::lock_guard<std::mutex> lock(m_jitSessionMutex);
+    if (!m_jitSession)
+    {
+        m_jitSession = LLVMJITSession::create(_getPersistentCache(), outError);
+    }
+    return m_jitSession;
+}
+
+ComPtr<ISlangBlob> LLVMDownstreamCompiler::_findCachedModule(const SHA1::Digest& key)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_cachedModulesMutex);
+        if (auto blob = m_cachedModules.tryGetValue(key))
+        {
+            return *blob;
+        }
+    }
+
+    ComPtr<ISlangBlob> blob;
+    if (auto persistentCache = _getPersistentCache())
+    {
+        if (SLANG_SUCCEEDED(persistentCache->readEntry(key, blob.writeRef())))
+        {
+            std::lock_guard<std::mutex> lock(m_cachedModulesMutex);
+            m_cachedModules[key] = blob;
+        }
+    }
+    return blob;
+}
+
+void LLVMDownstreamCompiler::_addCachedModule(const SHA1::Digest& key, llvm::Module* module)
+{
+    SmallVector<char> bitcode;
+    {
+        llvm::raw_svector_ostream stream(bitcode);
+        llvm::WriteBitcodeToFile(*module, stream);
+    }
+
+    auto blob = RawBlob::create(bitcode.data(), bitcode.size());
+    if (auto persistentCache = _getPersistentCache())
+    {
+        persistentCache->writeEntry(key, blob);
+    }
+
+    std::lock_guard<std::mutex> lock(m_cachedModulesMutex);
+    if (m_cachedModules.getCount() >= kMaxCachedModules)
+    {
+        m_cachedModules.clear();
+    }
+    m_cachedModules[key] = blob;
+}
+
 bool LLVMDownstreamCompiler::canConvert(const ArtifactDesc& from, const ArtifactDesc& to)
 {
     return false;
@@ -656,6 +1239,34 @@ SlangResult LLVMDownstreamCompiler::compile(
     const auto sourceSlice = StringUtil::getSlice(sourceBlob);
     StringRef sourceStringRef(sourceSlice.begin(), sourceSlice.getLength());
 
+    // Only JIT compiled results are reused, as they are what is compiled at run time.
+    const bool isCacheable = options.targetType == SLANG_SHADER_HOST_CALLABLE ||
+                             options.targetType == SLANG_SHADER_SHARED_LIBRARY;
+    SHA1::Digest moduleKey = {};
+    if (isCacheable)
+    {
+        moduleKey = _calcModuleKey(options, sourceSlice);
+        if (auto bitcode = _findCachedModule(moduleKey))
+        {
+            StringRef data((const char*)bitcode->getBufferPointer(), bitcode->getBufferSize());
+            MemoryBufferRef memoryBufferRef(data, StringRef());
+
+            std::unique_ptr<LLVMContext> cachedContext = std::make_unique<LLVMContext>();
+            SMDiagnostic err;
+            auto cachedModule = llvm::parseIR(memoryBufferRef, err, *cachedContext);
+            if (cachedModule)
+            {
+                return _createArtifactForModule(
+                    options,
+                    &moduleKey,
+                    std::move(cachedModule),
+                    std::move(cachedContext),
+                    diagnostics,
+                    outArtifact);
+            }
+        }
+    }
+
     auto sourceBuffer = llvm::MemoryBuffer::getMemBuffer(sourceStringRef);
 
     auto& invocation = clang->getInvocation();
@@ -799,8 +1410,19 @@ SlangResult LLVMDownstreamCompiler::compile(
     {
         auto& opts = invocation.getCodeGenOpts();
 
-        // Set to -O optimization level
-        opts.OptimizationLevel = _getOptimizationLevel(options.optimizationLevel);
+        if (_isTiered(options))
+        {
+            // Generate the IR without optimizing it, but without marking functions as
+            // `optnone` and `noinline` as -O0 would, so that it can be optimized later.
+            opts.OptimizationLevel = 0;
+            opts.DisableO0ImplyOptNone = 1;
+            opts.setInlining(CodeGenOptions::NormalInlining);
+        }
+        else
+        {
+            // Set to -O optimization level
+            opts.OptimizationLevel = _getOptimizationLevel(options.optimizationLevel);
+        }
 
         // Copy over the targets CodeModel
         opts.CodeModel = invocation.getTargetOpts().CodeModel;
@@ -931,6 +1553,31 @@ SlangResult LLVMDownstreamCompiler::compile(
         }
     }
 
+    // Only the results of compiles without diagnostics are kept, so a later compile that
+    // reuses them doesn't lose any.
+    const bool keepResult = isCacheable && module && diagnostics->getCount() == 0;
+    if (keepResult)
+    {
+        _addCachedModule(moduleKey, module.get());
+    }
+
+    return _createArtifactForModule(
+        options,
+        keepResult ? &moduleKey : nullptr,
+        std::move(module),
+        std::move(llvmContext),
+        diagnostics,
+        outArtifact);
+}
+
+SlangResult LLVMDownstreamCompiler::_createArtifactForModule(
+    const CompileOptions& options,
+    const SHA1::Digest* moduleKey,
+    std::unique_ptr<llvm::Module> module,
+    std::unique_ptr<LLVMContext> llvmContext,
+    IArtifactDiagnostics* diagnostics,
+    IArtifact** outArtifact)
+{
     switch (options.targetType)
     {
     // TODO(JS): Shared library may not be appropriate, but as long as the 'shared library' is
@@ -942,151 +1589,85 @@ SlangResult LLVMDownstreamCompiler::compile(
     // I guess the idea is it's 'SHADER' style, but is runnable on the host.
     case SLANG_SHADER_HOST_CALLABLE:
         {
-            // Try running something in the module on the JIT
-            std::unique_ptr<llvm::orc::LLJIT> jit;
+            std::string jitErrorString;
+            auto session = _getJITSession(jitErrorString);
+            if (!session)
             {
-                // Create the JIT
-
-                LLJITBuilder jitBuilder;
-
-                Expected<std::unique_ptr<llvm::orc::LLJIT>> expectJit = jitBuilder.create();
-                if (!expectJit)
-                {
-                    /* JS: NOTE!
+                ArtifactDiagnostic diagnostic;
 
-                    It is worth saying there can be some odd issues around creating the JIT - if
-                    LLVM-C is linked against.
+                StringBuilder buf;
+                buf << "Unable to create JIT engine: " << jitErrorString.c_str();
 
-                    If it is then LLVM will likely startup saying LLVM-C isn't found.
-                    BUT if you have LLVM *installed* on your system (as is reasonable to do from a
-                    LLVM distro, then at startup it *MIGHT* find a LLVM-C dll in that installation
-                    (ie nothing to do with the version of LLVM linked with). This will likely lead
-                    to an odd error saying the 'triple can't be found' and that no targets are
-                    registered.
+                diagnostic.severity = ArtifactDiagnostic::Severity::Error;
+                diagnostic.stage = ArtifactDiagnostic::Stage::Link;
+                diagnostic.text = TerminatedCharSlice(buf.getBuffer(), buf.getLength());
 
-                    Also note that the behavior *may* be different with Debug/Release - because of
-                    how the linked resolves symbols that are multiply defined.
+                // Add the error
+                diagnostics->add(diagnostic);
+                diagnostics->setResult(SLANG_FAIL);
 
-                    If there are problems creating the JIT, check that LLVM-C is not linked against
-                    (it should be disabled in the premake).
-                    */
+                auto artifact = ArtifactUtil::createArtifact(
+                    ArtifactDesc::make(ArtifactKind::None, ArtifactPayload::None));
+                ArtifactUtil::addAssociated(artifact, diagnostics);
 
-                    auto err = expectJit.takeError();
-
-                    std::string jitErrorString;
-                    llvm::raw_string_ostream jitErrorStream(jitErrorString);
-
-                    jitErrorStream << err;
-
-                    ArtifactDiagnostic diagnostic;
-
-                    StringBuilder buf;
-                    buf << "Unable to create JIT engine: " << jitErrorString.c_str();
-
-                    diagnostic.severity = ArtifactDiagnostic::Severity::Error;
-                    diagnostic.stage = ArtifactDiagnostic::Stage::Link;
-                    diagnostic.text = TerminatedCharSlice(buf.getBuffer(), buf.getLength());
-
-                    // Add the error
-                    diagnostics->add(diagnostic);
-                    diagnostics->setResult(SLANG_FAIL);
-
-                    auto artifact = ArtifactUtil::createArtifact(
-                        ArtifactDesc::make(ArtifactKind::None, ArtifactPayload::None));
-                    ArtifactUtil::addAssociated(artifact, diagnostics);
-
-                    *outArtifact = artifact.detach();
-                    return SLANG_OK;
-                }
-                jit = std::move(*expectJit);
+                *outArtifact = artifact.detach();
+                return SLANG_OK;
             }
 
-            // Used the following link to test this out
-            // https://www.llvm.org/docs/ORCv2.html
-            // https://www.llvm.org/docs/ORCv2.html#processandlibrarysymbols
+            // The object cache of the session identifies the modules it keeps by their
+            // identifier, which is otherwise the name Clang gave the input.
+            const std::string moduleIdentifier =
+                moduleKey ? moduleKey->toString().getBuffer() : "";
+            module->setModuleIdentifier(moduleIdentifier);
 
+            // For a tiered compile, the unoptimized module is kept to be optimized later.
+            ComPtr<ISlangBlob> tieredBitcode;
+            std::vector<std::string> symbolNames;
+            if (_isTiered(options))
             {
-                auto& es = jit->getExecutionSession();
-
-                const DataLayout& dl = jit->getDataLayout();
-                MangleAndInterner mangler(es, dl);
-
-                // The name of the lib must be unique. Should be here as we are only thing adding
-                // libs
-                auto stdcLibExpected = es.createJITDylib("stdc");
-
-                if (stdcLibExpected)
+                SmallVector<char> bitcode;
                 {
-                    auto& stdcLib = *stdcLibExpected;
-
-                    // Add all the symbolmap
-                    SymbolMap symbolMap;
-
-                    // symbolMap.insert(std::make_pair(mangler("sin"),
-                    // JITEvaluatedSymbol::fromPointer(static_cast<double (*)(double)>(&sin))));
-
-                    {
-                        static const NameAndFunc funcs[] = {SLANG_LLVM_FUNCS(
-                            SLANG_LLVM_FUNC) SLANG_PLATFORM_FUNCS(SLANG_LLVM_FUNC)};
-
-                        for (auto& func : funcs)
-                        {
-                            symbolMap.insert(std::make_pair(
-                                mangler(func.name),
-                                JITEvaluatedSymbol::fromPointer(func.func)));
-                        }
-                    }
-
-#if SLANG_PTR_IS_32 && SLANG_VC
-                    {
-                        // https://docs.microsoft.com/en-us/windows/win32/devnotes/-win32-alldiv
-                        symbolMap.insert(std::make_pair(
-                            mangler("_alldiv"),
-                            JITEvaluatedSymbol::fromPointer(WinSpecific::_alldiv)));
-                        symbolMap.insert(std::make_pair(
-                            mangler("_allrem"),
-                            JITEvaluatedSymbol::fromPointer(WinSpecific::_allrem)));
-                        symbolMap.insert(std::make_pair(
-                            mangler("_aullrem"),
-                            JITEvaluatedSymbol::fromPointer(WinSpecific::_aullrem)));
-                        symbolMap.insert(std::make_pair(
-                            mangler("_aulldiv"),
-                            JITEvaluatedSymbol::fromPointer(WinSpecific::_aulldiv)));
-                    }
-#endif
+                    llvm::raw_svector_ostream stream(bitcode);
+                    llvm::WriteBitcodeToFile(*module, stream);
+                }
+                tieredBitcode = RawBlob::create(bitcode.data(), bitcode.size());
 
-                    if (auto err = stdcLib.define(absoluteSymbols(symbolMap)))
+                for (const auto& func : module->functions())
+                {
+                    if (!func.isDeclaration() && !func.hasLocalLinkage())
                     {
-                        return SLANG_FAIL;
+                        symbolNames.push_back(func.getName().str());
                     }
-
-                    // Required or the symbols won't be found
-                    jit->getMainJITDylib().addToLinkOrder(stdcLib);
                 }
             }
 
-            ThreadSafeModule threadSafeModule(std::move(module), std::move(llvmContext));
+            JITDylib* lib = nullptr;
+            ResourceTrackerSP tracker;
+            SLANG_RETURN_ON_FAIL(session->addModule(
+                ThreadSafeModule(std::move(module), std::move(llvmContext)),
+                lib,
+                tracker));
 
-            if (auto err = jit->addIRModule(std::move(threadSafeModule)))
-            {
-                return SLANG_FAIL;
-            }
+            // Create the shared library
+            ComPtr<LLVMJITSharedLibrary> sharedLibrary(
+                new LLVMJITSharedLibrary(session, lib, std::move(tracker)));
 
-            if (auto err = jit->initialize(jit->getMainJITDylib()))
+            if (tieredBitcode)
             {
-                return SLANG_FAIL;
+                sharedLibrary->startOptimizing(
+                    tieredBitcode,
+                    std::move(symbolNames),
+                    _getOptimizationLevel(options.optimizationLevel),
+                    moduleIdentifier.empty() ? moduleIdentifier : moduleIdentifier + "-optimized");
             }
 
-            // Create the shared library
-            ComPtr<ISlangSharedLibrary> sharedLibrary(new LLVMJITSharedLibrary(std::move(jit)));
-
             // Work out the ArtifactDesc
             const auto targetDesc = ArtifactDescUtil::makeDescForCompileTarget(options.targetType);
 
             auto artifact = ArtifactUtil::createArtifact(targetDesc);
             ArtifactUtil::addAssociated(artifact, diagnostics);
 
-            artifact->addRepresentation(sharedLibrary);
+            artifact->addRepresentation(static_cast<ISlangSharedLibrary*>(sharedLibrary.get()));
 
             *outArtifact = artifact.detach();
             return SLANG_OK;
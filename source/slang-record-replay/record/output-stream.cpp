@@ -1,16 +1,22 @@
 #include "output-stream.h"
 
+#include "../../core/slang-lz4-compression-system.h"
+#include "../util/record-format.h"
 #include "../util/record-utility.h"
 
+#include <chrono>
+
 namespace SlangRecord
 {
-FileOutputStream::FileOutputStream(const Slang::String& fileName, bool append)
+static void openFileStream(
+    Slang::FileStream& fileStream,
+    const Slang::String& fileName,
+    Slang::FileMode fileMode)
 {
-    Slang::FileMode fileMode = append ? Slang::FileMode::Append : Slang::FileMode::Create;
     Slang::FileAccess fileAccess = Slang::FileAccess::Write;
     Slang::FileShare fileShare = Slang::FileShare::None;
 
-    SlangResult res = m_fileStream.init(fileName, fileMode, fileAccess, fileShare);
+    SlangResult res = fileStream.init(fileName, fileMode, fileAccess, fileShare);
 
     if (res != SLANG_OK)
     {
@@ -22,6 +28,14 @@ FileOutputStream::FileOutputStream(const Slang::String& fileName, bool append)
     }
 }
 
+FileOutputStream::FileOutputStream(const Slang::String& fileName, bool append)
+{
+    openFileStream(
+        m_fileStream,
+        fileName,
+        append ? Slang::FileMode::Append : Slang::FileMode::Create);
+}
+
 FileOutputStream::~FileOutputStream()
 {
     m_fileStream.close();
@@ -32,6 +46,101 @@ void FileOutputStream::write(const void* data, size_t len)
     SLANG_RECORD_CHECK(m_fileStream.write(data, len));
 }
 
+AsyncFileOutputStream::AsyncFileOutputStream(const Slang::String& fileName, bool compress)
+{
+    openFileStream(m_fileStream, fileName, Slang::FileMode::Create);
+    if (compress)
+    {
+        m_compressionSystem = Slang::LZ4CompressionSystem::getSingleton();
+    }
+    m_pending.reserve(Slang::Index(kBlockSize));
+    m_thread = std::thread([this]() { writerThreadMain(); });
+}
+
+AsyncFileOutputStream::~AsyncFileOutputStream()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_quit = true;
+    }
+    m_condition.notify_one();
+    m_thread.join();
+    m_fileStream.close();
+}
+
+void AsyncFileOutputStream::write(const void* data, size_t len)
+{
+    bool isBlockFull = false;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_pending.addRange((const uint8_t*)data, Slang::Index(len));
+        isBlockFull = size_t(m_pending.getCount()) >= kBlockSize;
+    }
+    if (isBlockFull)
+    {
+        m_condition.notify_one();
+    }
+}
+
+void AsyncFileOutputStream::writerThreadMain()
+{
+    // The blocks are swapped with m_pending, so the two buffers are reused rather than reallocated
+    Slang::List<uint8_t> block;
+    block.reserve(Slang::Index(kBlockSize));
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true)
+    {
+        m_condition.wait_for(
+            lock,
+            std::chrono::milliseconds(kWriteIntervalMs),
+            [this]() { return m_quit || size_t(m_pending.getCount()) >= kBlockSize; });
+
+        const bool quit = m_quit;
+        block.swapWith(m_pending);
+        lock.unlock();
+
+        if (block.getCount())
+        {
+            writeBlock(block);
+            block.clear();
+        }
+        if (quit)
+        {
+            break;
+        }
+        lock.lock();
+    }
+}
+
+void AsyncFileOutputStream::writeBlock(const Slang::List<uint8_t>& block)
+{
+    if (!m_compressionSystem)
+    {
+        SLANG_RECORD_CHECK(m_fileStream.write(block.getBuffer(), block.getCount()));
+    }
+    else
+    {
+        Slang::CompressionStyle style;
+        style.m_type = Slang::CompressionStyle::Type::BestSpeed;
+
+        Slang::ComPtr<ISlangBlob> compressed;
+        SLANG_RECORD_CHECK(m_compressionSystem->compress(
+            &style,
+            block.getBuffer(),
+            block.getCount(),
+            compressed.writeRef()));
+
+        CompressedBlockHeader header;
+        header.uncompressedSizeInBytes = block.getCount();
+        header.compressedSizeInBytes = compressed->getBufferSize();
+        SLANG_RECORD_CHECK(m_fileStream.write(&header, sizeof(header)));
+        SLANG_RECORD_CHECK(
+            m_fileStream.write(compressed->getBufferPointer(), compressed->getBufferSize()));
+    }
+    SLANG_RECORD_CHECK(m_fileStream.flush());
+}
+
 MemoryStream::MemoryStream()
     : m_memoryStream(Slang::FileAccess::Write)
 {
@@ -1,9 +1,14 @@
 #ifndef OUTPUT_STREAM_H
 #define OUTPUT_STREAM_H
 
+#include "../../core/slang-compression-system.h"
 #include "../../core/slang-stream.h"
 #include "../../core/slang-string.h"
 
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
 namespace SlangRecord
 {
 class OutputStream : public Slang::RefObject
@@ -26,6 +31,37 @@ private:
     Slang::FileStream m_fileStream;
 };
 
+// Writes to a file from a background thread, so that writing only copies the data to memory. The
+// data is handed to the thread once a block of it is full, and at the latest after
+// kWriteIntervalMs, so no more than that much of a record is lost if the process crashes.
+// If `compress` is set, each block is written LZ4 compressed after a CompressedBlockHeader.
+class AsyncFileOutputStream : public OutputStream
+{
+public:
+    AsyncFileOutputStream(const Slang::String& fileName, bool compress);
+    virtual ~AsyncFileOutputStream() override;
+    virtual void write(const void* data, size_t len) override;
+    // Doesn't wait for the data to be written, the background thread writes it soon after.
+    virtual void flush() override {}
+
+private:
+    void writerThreadMain();
+    void writeBlock(const Slang::List<uint8_t>& block);
+
+    static const size_t kBlockSize = 1024 * 1024;
+    static const int kWriteIntervalMs = 100;
+
+    Slang::FileStream m_fileStream;
+    Slang::ICompressionSystem* m_compressionSystem = nullptr;
+
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    // The data written since it was last handed to the background thread
+    Slang::List<uint8_t> m_pending;
+    bool m_quit = false;
+    std::thread m_thread;
+};
+
 // The reason we inherit from OwnedMemoryStream instead of declaring it
 // as a member is because OwnedMemoryStream lacks some of the functionality
 // of operating on the underlying buffer directly.
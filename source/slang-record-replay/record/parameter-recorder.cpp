@@ -87,11 +87,7 @@ void ParameterRecorder::recordPointer(const void* value, bool omitData, size_t s
         return;
     }
 
-    recordUint64(size);
-    if (size)
-    {
-        m_stream->write(value, size);
-    }
+    recordData(value, uint64_t(size), POINTER_DATA_STORED_FLAG, POINTER_DATA_REFERENCE_FLAG);
 }
 
 void ParameterRecorder::recordPointer(ISlangBlob* blob)
@@ -116,8 +112,40 @@ void ParameterRecorder::recordString(const char* value)
     else
     {
         uint32_t size = (uint32_t)strlen(value);
-        recordUint32(size);
-        m_stream->write(value, size);
+        recordData(value, size, STRING_STORED_FLAG, STRING_REFERENCE_FLAG);
+    }
+}
+
+template<typename SizeType>
+void ParameterRecorder::recordData(
+    const void* data,
+    SizeType size,
+    SizeType storedFlag,
+    SizeType referenceFlag)
+{
+    // Hashing small values costs more than recording them again
+    if (size < DEDUPLICATION_MIN_SIZE)
+    {
+        recordValue(size);
+        if (size)
+        {
+            m_stream->write(data, size);
+        }
+        return;
+    }
+
+    static_assert(sizeof(Slang::SHA1::Digest) == DEDUPLICATION_DIGEST_SIZE, "unexpected size");
+    const Slang::SHA1::Digest digest = Slang::SHA1::compute(data, SlangInt(size));
+    if (m_storedDigests.add(digest))
+    {
+        recordValue(SizeType(size | storedFlag));
+        m_stream->write(digest.data, sizeof(digest.data));
+        m_stream->write(data, size);
+    }
+    else
+    {
+        recordValue(SizeType(size | referenceFlag));
+        m_stream->write(digest.data, sizeof(digest.data));
     }
 }
 } // namespace SlangRecord
@@ -1,6 +1,8 @@
 #ifndef PARAMETER_ENCODER_H
 #define PARAMETER_ENCODER_H
 
+#include "../../core/slang-crypto.h"
+#include "../../core/slang-dictionary.h"
 #include "../util/record-format.h"
 #include "output-stream.h"
 
@@ -94,7 +96,18 @@ private:
     {
         m_stream->write(&value, sizeof(T));
     }
+
+    // Record `size` and then `data`, or only a reference to it if it was recorded before
+    template<typename SizeType>
+    void recordData(
+        const void* data,
+        SizeType size,
+        SizeType storedFlag,
+        SizeType referenceFlag);
+
     OutputStream* m_stream;
+    // The digests of the data stored in the record so far
+    Slang::HashSet<Slang::SHA1::Digest> m_storedDigests;
 };
 } // namespace SlangRecord
 
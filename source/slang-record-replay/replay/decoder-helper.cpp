@@ -35,6 +35,13 @@ DecoderAllocatorSingleton::~DecoderAllocatorSingleton()
     }
 }
 
+DeduplicatedDataTable* DeduplicatedDataTable::getInstance()
+{
+    // The data is owned by the allocator of the same thread, so lives as long as this
+    thread_local DeduplicatedDataTable instance;
+    return &instance;
+}
+
 template<typename T, typename U>
 size_t StructDecoder<T, U>::decode(const uint8_t* buffer, int64_t bufferSize)
 {
@@ -46,7 +53,8 @@ size_t BlobDecoder::decode(const uint8_t* buffer, int64_t bufferSize)
     size_t readByte = 0;
     readByte = ParameterDecoder::decodeAddress(buffer, bufferSize, m_address);
 
-    if (!m_address)
+    // The blob is followed by its contents, unless it is null
+    if (m_address)
     {
         readByte +=
             ParameterDecoder::decodePointer(buffer + readByte, bufferSize - readByte, m_blobData);
@@ -1,6 +1,8 @@
 #ifndef SLANG_DECODER_HELPER_H
 #define SLANG_DECODER_HELPER_H
 
+#include "../../core/slang-crypto.h"
+#include "../../core/slang-dictionary.h"
 #include "../../core/slang-list.h"
 #include "../util/record-format.h"
 #include "slang-com-helper.h"
@@ -24,6 +26,32 @@ private:
     Slang::List<void*> m_allocations;
 };
 
+// The data stored once in a record file, by digest, so later references to it can use the copy
+// that was decoded first rather than decoding another (see DEDUPLICATION_MIN_SIZE)
+class DeduplicatedDataTable
+{
+public:
+    struct Entry
+    {
+        const void* data = nullptr;
+        size_t size = 0;
+    };
+
+    static DeduplicatedDataTable* getInstance();
+    void add(const Slang::SHA1::Digest& digest, const void* data, size_t size)
+    {
+        m_entries[digest] = Entry{data, size};
+    }
+    const Entry* find(const Slang::SHA1::Digest& digest) const
+    {
+        return m_entries.tryGetValue(digest);
+    }
+
+private:
+    DeduplicatedDataTable() = default;
+    Slang::Dictionary<Slang::SHA1::Digest, Entry> m_entries;
+};
+
 class DecoderBase
 {
 public:
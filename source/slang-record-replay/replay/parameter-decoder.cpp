@@ -4,6 +4,14 @@
 
 namespace SlangRecord
 {
+// Decode the digest that follows the size of deduplicated data.
+static size_t decodeDigest(const uint8_t* buffer, int64_t bufferSize, Slang::SHA1::Digest& digest)
+{
+    SLANG_RECORD_ASSERT(bufferSize >= (int64_t)DEDUPLICATION_DIGEST_SIZE);
+    memcpy(digest.data, buffer, DEDUPLICATION_DIGEST_SIZE);
+    return DEDUPLICATION_DIGEST_SIZE;
+}
+
 size_t ParameterDecoder::decodeString(
     const uint8_t* buffer,
     int64_t bufferSize,
@@ -20,6 +28,24 @@ size_t ParameterDecoder::decodeString(
     size_t readByte = 0;
     readByte += decodeUint32(buffer, bufferSize - readByte, stringLength);
 
+    const uint32_t flags = stringLength & (STRING_STORED_FLAG | STRING_REFERENCE_FLAG);
+    stringLength &= ~flags;
+
+    Slang::SHA1::Digest digest;
+    if (flags)
+    {
+        readByte += decodeDigest(buffer + readByte, bufferSize - readByte, digest);
+    }
+
+    if (flags == STRING_REFERENCE_FLAG)
+    {
+        const auto entry = DeduplicatedDataTable::getInstance()->find(digest);
+        SLANG_RECORD_ASSERT(entry && entry->size == stringLength + 1);
+        typeDecoder.setPointer(const_cast<void*>(entry->data));
+        typeDecoder.setDataSize(entry->size);
+        return readByte;
+    }
+
     SLANG_RECORD_ASSERT(bufferSize >= (int64_t)(readByte + stringLength));
 
     if (stringLength == 0)
@@ -31,6 +57,11 @@ size_t ParameterDecoder::decodeString(
     memcpy(data, buffer + readByte, stringLength);
     typeDecoder.setPointer(data);
     typeDecoder.setDataSize(stringLength + 1);
+
+    if (flags == STRING_STORED_FLAG)
+    {
+        DeduplicatedDataTable::getInstance()->add(digest, data, stringLength + 1);
+    }
     return readByte + stringLength;
 }
 
@@ -53,6 +84,24 @@ size_t ParameterDecoder::decodePointer(
     uint64_t dataSize = 0;
     readByte += decodeUint64(buffer + readByte, bufferSize - readByte, dataSize);
 
+    const uint64_t flags = dataSize & (POINTER_DATA_STORED_FLAG | POINTER_DATA_REFERENCE_FLAG);
+    dataSize &= ~flags;
+
+    Slang::SHA1::Digest digest;
+    if (flags)
+    {
+        readByte += decodeDigest(buffer + readByte, bufferSize - readByte, digest);
+    }
+
+    if (flags == POINTER_DATA_REFERENCE_FLAG)
+    {
+        const auto entry = DeduplicatedDataTable::getInstance()->find(digest);
+        SLANG_RECORD_ASSERT(entry && entry->size == dataSize);
+        pointerDecoder.setPointer(const_cast<void*>(entry->data));
+        pointerDecoder.setDataSize(entry->size);
+        return readByte;
+    }
+
     // return if the data size is 0
     if (dataSize == 0)
     {
@@ -65,6 +114,11 @@ size_t ParameterDecoder::decodePointer(
     memcpy(data, buffer + readByte, dataSize);
     pointerDecoder.setPointer(data);
     pointerDecoder.setDataSize(dataSize);
+
+    if (flags == POINTER_DATA_STORED_FLAG)
+    {
+        DeduplicatedDataTable::getInstance()->add(digest, data, dataSize);
+    }
     return readByte + dataSize;
 }
 
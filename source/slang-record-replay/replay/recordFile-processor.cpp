@@ -1,5 +1,6 @@
 #include "recordFile-processor.h"
 
+#include "../../core/slang-lz4-compression-system.h"
 #include "../util/record-format.h"
 #include "parameter-decoder.h"
 
@@ -25,6 +26,72 @@ RecordFileProcessor::RecordFileProcessor(const Slang::String& filePath)
 
     // Enable log system
     setLogLevel();
+
+    // A file recorded with SLANG_RECORD_COMPRESS starts with a compressed block
+    uint32_t magic = 0;
+    size_t readBytes = 0;
+    res = m_inputStream.read(&magic, sizeof(magic), readBytes);
+    m_inputStream.seek(Slang::SeekOrigin::Start, 0);
+    if (res == SLANG_OK && readBytes == sizeof(magic) && magic == MAGIC_COMPRESSED_BLOCK)
+    {
+        if (!decompressFile())
+        {
+            SlangRecord::slangRecordLog(
+                SlangRecord::LogLevel::Error,
+                "Failed to decompress file %s\n",
+                filePath.begin());
+            std::abort();
+        }
+        m_stream = &m_decompressedStream;
+    }
+}
+
+bool RecordFileProcessor::decompressFile()
+{
+    Slang::ICompressionSystem* compressionSystem = Slang::LZ4CompressionSystem::getSingleton();
+
+    Slang::List<uint8_t> contents;
+    Slang::List<uint8_t> compressed;
+    while (true)
+    {
+        CompressedBlockHeader header{};
+        size_t readBytes = 0;
+        SlangResult res = m_inputStream.read(&header, sizeof(header), readBytes);
+        if (res != SLANG_OK || readBytes == 0)
+        {
+            break;
+        }
+
+        if (readBytes != sizeof(header) || header.magic != MAGIC_COMPRESSED_BLOCK)
+        {
+            return false;
+        }
+
+        compressed.setCount(Slang::Index(header.compressedSizeInBytes));
+        res = m_inputStream.read(compressed.getBuffer(), header.compressedSizeInBytes, readBytes);
+        if (res != SLANG_OK || readBytes != header.compressedSizeInBytes)
+        {
+            // The process that recorded the file stopped while writing this block, so replay
+            // what was recorded before it.
+            slangRecordLog(LogLevel::Error, "The last block of the record file is truncated\n");
+            break;
+        }
+
+        const Slang::Index offset = contents.getCount();
+        contents.setCount(offset + Slang::Index(header.uncompressedSizeInBytes));
+        res = compressionSystem->decompress(
+            compressed.getBuffer(),
+            compressed.getCount(),
+            size_t(header.uncompressedSizeInBytes),
+            contents.getBuffer() + offset);
+        if (res != SLANG_OK)
+        {
+            return false;
+        }
+    }
+
+    m_decompressedStream.swapContents(contents);
+    return true;
 }
 
 bool RecordFileProcessor::processNextBlock()
@@ -35,6 +102,7 @@ bool RecordFileProcessor::processNextBlock()
         return false;
     }
 
+    m_lastCallId = header.callId;
     ApiClassId classId = static_cast<ApiClassId>(getClassId(header.callId));
 
     // capacity comparison will be performed in the reserve call, so we can safely call reserve
@@ -45,7 +113,7 @@ bool RecordFileProcessor::processNextBlock()
 
     if (header.dataSizeInBytes)
     {
-        res = m_inputStream.read(m_parameterBuffer.getBuffer(), header.dataSizeInBytes, readBytes);
+        res = m_stream->read(m_parameterBuffer.getBuffer(), header.dataSizeInBytes, readBytes);
     }
 
     if (res != SLANG_OK || readBytes != header.dataSizeInBytes)
@@ -62,7 +130,7 @@ bool RecordFileProcessor::processNextBlock()
     if (tailer.dataSizeInBytes)
     {
         m_outputBuffer.reserve(tailer.dataSizeInBytes);
-        res = m_inputStream.read(m_outputBuffer.getBuffer(), tailer.dataSizeInBytes, readBytes);
+        res = m_stream->read(m_outputBuffer.getBuffer(), tailer.dataSizeInBytes, readBytes);
 
         if (res != SLANG_OK || readBytes != tailer.dataSizeInBytes)
         {
@@ -94,7 +162,7 @@ bool RecordFileProcessor::processNextBlock()
 bool RecordFileProcessor::processHeader(FunctionHeader& header)
 {
     size_t readBytes = 0;
-    SlangResult res = m_inputStream.read(&header, sizeof(FunctionHeader), readBytes);
+    SlangResult res = m_stream->read(&header, sizeof(FunctionHeader), readBytes);
 
     if (res != SLANG_OK || readBytes != sizeof(FunctionHeader))
     {
@@ -112,7 +180,7 @@ bool RecordFileProcessor::processHeader(FunctionHeader& header)
 RecordFileResultCode RecordFileProcessor::processTailer(FunctionTailer& tailer)
 {
     size_t readBytes = 0;
-    SlangResult res = m_inputStream.read(&tailer, sizeof(FunctionTailer), readBytes);
+    SlangResult res = m_stream->read(&tailer, sizeof(FunctionTailer), readBytes);
 
     if (res != SLANG_OK || readBytes != sizeof(FunctionTailer))
     {
@@ -125,7 +193,7 @@ RecordFileResultCode RecordFileProcessor::processTailer(FunctionTailer& tailer)
     {
         // revert back to last read position, and clear tailer
         int64_t offset = -(int64_t)sizeof(FunctionTailer);
-        m_inputStream.seek(Slang::SeekOrigin::Current, offset);
+        m_stream->seek(Slang::SeekOrigin::Current, offset);
         memset(&tailer, 0, sizeof(FunctionTailer));
         return NOT_EXSIT;
     }
@@ -39,12 +39,22 @@ public:
     bool processMethod(FunctionHeader const& header, const uint8_t* buffer, int64_t bufferSize);
     bool processFunction(FunctionHeader const& header, const uint8_t* buffer, int64_t bufferSize);
 
+    // The call of the block processed last
+    ApiCallId getLastCallId() const { return m_lastCallId; }
+
 private:
+    bool decompressFile();
+
     Slang::FileStream m_inputStream;
+    // The contents of the file if it is compressed
+    Slang::OwnedMemoryStream m_decompressedStream{Slang::FileAccess::Read};
+    // The stream the blocks are read from, either of the above
+    Slang::Stream* m_stream = &m_inputStream;
     Slang::List<uint8_t> m_parameterBuffer;
     Slang::List<uint8_t> m_outputBuffer;
 
     SlangDecoder* m_decoder = nullptr;
+    ApiCallId m_lastCallId = ApiCallId::InvalidCallId;
 };
 
 } // namespace SlangRecord
@@ -42,6 +42,18 @@ typedef AddressFormat ObjectID;
 constexpr uint64_t g_globalFunctionHandle = 0;
 constexpr uint32_t MAGIC_HEADER = 0x44414548;
 constexpr uint32_t MAGIC_TAILER = 0x4C494154;
+constexpr uint32_t MAGIC_COMPRESSED_BLOCK = 0x4B4C425A;
+
+// Strings and pointer data of at least DEDUPLICATION_MIN_SIZE bytes are stored once per record
+// file. The first copy has the STORED flag set in its size, and its size is followed by the SHA1
+// digest of the data and then the data. Later copies have the REFERENCE flag set instead, and
+// only the digest follows their size.
+constexpr uint32_t DEDUPLICATION_MIN_SIZE = 64;
+constexpr uint32_t DEDUPLICATION_DIGEST_SIZE = 20;
+constexpr uint64_t POINTER_DATA_STORED_FLAG = 1ull << 63;
+constexpr uint64_t POINTER_DATA_REFERENCE_FLAG = 1ull << 62;
+constexpr uint32_t STRING_STORED_FLAG = 1u << 31;
+constexpr uint32_t STRING_REFERENCE_FLAG = 1u << 30;
 
 enum IComponentTypeMethodId : uint16_t
 {
@@ -228,5 +240,15 @@ struct FunctionTailer
     uint32_t dataSizeInBytes{0};
 };
 
+// A compressed record file is a sequence of LZ4 compressed blocks, each of them following one of
+// these. The blocks, once decompressed and joined, are the contents of an uncompressed file.
+struct CompressedBlockHeader
+{
+    uint32_t magic{MAGIC_COMPRESSED_BLOCK};
+    uint32_t reserved{0};
+    uint64_t uncompressedSizeInBytes{0};
+    uint64_t compressedSizeInBytes{0};
+};
+
 } // namespace SlangRecord
 #endif
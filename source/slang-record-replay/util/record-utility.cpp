@@ -11,6 +11,8 @@
 
 constexpr const char* kRecordLayerEnvVar = "SLANG_RECORD_LAYER";
 constexpr const char* kRecordLayerLogLevel = "SLANG_RECORD_LOG_LEVEL";
+constexpr const char* kRecordAsyncEnvVar = "SLANG_RECORD_ASYNC";
+constexpr const char* kRecordCompressEnvVar = "SLANG_RECORD_COMPRESS";
 
 namespace SlangRecord
 {
@@ -35,10 +37,10 @@ static bool getEnvironmentVariable(const char* name, Slang::String& out)
     return out.getLength() > 0;
 }
 
-bool isRecordLayerEnabled()
+static bool isEnvironmentVariableSet(const char* name)
 {
     Slang::String envVarStr;
-    if (getEnvironmentVariable(kRecordLayerEnvVar, envVarStr))
+    if (getEnvironmentVariable(name, envVarStr))
     {
         if (envVarStr == "1")
         {
@@ -48,6 +50,22 @@ bool isRecordLayerEnabled()
     return false;
 }
 
+bool isRecordLayerEnabled()
+{
+    return isEnvironmentVariableSet(kRecordLayerEnvVar);
+}
+
+bool isRecordAsyncEnabled()
+{
+    // Compression is done on the writer thread, so it implies the asynchronous mode
+    return isEnvironmentVariableSet(kRecordAsyncEnvVar) || isRecordCompressionEnabled();
+}
+
+bool isRecordCompressionEnabled()
+{
+    return isEnvironmentVariableSet(kRecordCompressEnvVar);
+}
+
 void setLogLevel()
 {
     // We only want to set the log level once
@@ -65,6 +83,122 @@ void setLogLevel()
     }
 }
 
+const char* getApiCallName(ApiCallId callId)
+{
+#define CASE(x) \
+    case x:     \
+        return #x
+
+    switch (callId)
+    {
+        CASE(CreateGlobalSession);
+        CASE(IGlobalSession_createSession);
+        CASE(IGlobalSession_findProfile);
+        CASE(IGlobalSession_setDownstreamCompilerPath);
+        CASE(IGlobalSession_setDownstreamCompilerPrelude);
+        CASE(IGlobalSession_getDownstreamCompilerPrelude);
+        CASE(IGlobalSession_getBuildTagString);
+        CASE(IGlobalSession_setDefaultDownstreamCompiler);
+        CASE(IGlobalSession_getDefaultDownstreamCompiler);
+        CASE(IGlobalSession_setLanguagePrelude);
+        CASE(IGlobalSession_getLanguagePrelude);
+        CASE(IGlobalSession_createCompileRequest);
+        CASE(IGlobalSession_addBuiltins);
+        CASE(IGlobalSession_setSharedLibraryLoader);
+        CASE(IGlobalSession_getSharedLibraryLoader);
+        CASE(IGlobalSession_checkCompileTargetSupport);
+        CASE(IGlobalSession_checkPassThroughSupport);
+        CASE(IGlobalSession_compileCoreModule);
+        CASE(IGlobalSession_loadCoreModule);
+        CASE(IGlobalSession_saveCoreModule);
+        CASE(IGlobalSession_findCapability);
+        CASE(IGlobalSession_setDownstreamCompilerForTransition);
+        CASE(IGlobalSession_getDownstreamCompilerForTransition);
+        CASE(IGlobalSession_getCompilerElapsedTime);
+        CASE(IGlobalSession_setSPIRVCoreGrammar);
+        CASE(IGlobalSession_parseCommandLineArguments);
+        CASE(IGlobalSession_getSessionDescDigest);
+        CASE(ISession_getGlobalSession);
+        CASE(ISession_loadModule);
+        CASE(ISession_loadModuleFromIRBlob);
+        CASE(ISession_loadModuleFromSource);
+        CASE(ISession_loadModuleFromSourceString);
+        CASE(ISession_createCompositeComponentType);
+        CASE(ISession_specializeType);
+        CASE(ISession_getTypeLayout);
+        CASE(ISession_getContainerType);
+        CASE(ISession_getDynamicType);
+        CASE(ISession_getTypeRTTIMangledName);
+        CASE(ISession_getTypeConformanceWitnessMangledName);
+        CASE(ISession_getTypeConformanceWitnessSequentialID);
+        CASE(ISession_createTypeConformanceComponentType);
+        CASE(ISession_createCompileRequest);
+        CASE(ISession_getLoadedModuleCount);
+        CASE(ISession_getLoadedModule);
+        CASE(ISession_isBinaryModuleUpToDate);
+        CASE(IModule_findEntryPointByName);
+        CASE(IModule_getDefinedEntryPointCount);
+        CASE(IModule_getDefinedEntryPoint);
+        CASE(IModule_serialize);
+        CASE(IModule_writeToFile);
+        CASE(IModule_getName);
+        CASE(IModule_getFilePath);
+        CASE(IModule_getUniqueIdentity);
+        CASE(IModule_findAndCheckEntryPoint);
+        CASE(IModule_getSession);
+        CASE(IModule_getLayout);
+        CASE(IModule_getSpecializationParamCount);
+        CASE(IModule_getEntryPointCode);
+        CASE(IModule_getTargetCode);
+        CASE(IModule_getResultAsFileSystem);
+        CASE(IModule_getEntryPointHash);
+        CASE(IModule_specialize);
+        CASE(IModule_link);
+        CASE(IModule_getEntryPointHostCallable);
+        CASE(IModule_renameEntryPoint);
+        CASE(IModule_linkWithOptions);
+        CASE(IEntryPoint_getSession);
+        CASE(IEntryPoint_getLayout);
+        CASE(IEntryPoint_getSpecializationParamCount);
+        CASE(IEntryPoint_getEntryPointCode);
+        CASE(IEntryPoint_getTargetCode);
+        CASE(IEntryPoint_getResultAsFileSystem);
+        CASE(IEntryPoint_getEntryPointHash);
+        CASE(IEntryPoint_specialize);
+        CASE(IEntryPoint_link);
+        CASE(IEntryPoint_getEntryPointHostCallable);
+        CASE(IEntryPoint_renameEntryPoint);
+        CASE(IEntryPoint_linkWithOptions);
+        CASE(ICompositeComponentType_getSession);
+        CASE(ICompositeComponentType_getLayout);
+        CASE(ICompositeComponentType_getSpecializationParamCount);
+        CASE(ICompositeComponentType_getEntryPointCode);
+        CASE(ICompositeComponentType_getTargetCode);
+        CASE(ICompositeComponentType_getResultAsFileSystem);
+        CASE(ICompositeComponentType_getEntryPointHash);
+        CASE(ICompositeComponentType_specialize);
+        CASE(ICompositeComponentType_link);
+        CASE(ICompositeComponentType_getEntryPointHostCallable);
+        CASE(ICompositeComponentType_renameEntryPoint);
+        CASE(ICompositeComponentType_linkWithOptions);
+        CASE(ITypeConformance_getSession);
+        CASE(ITypeConformance_getLayout);
+        CASE(ITypeConformance_getSpecializationParamCount);
+        CASE(ITypeConformance_getEntryPointCode);
+        CASE(ITypeConformance_getTargetCode);
+        CASE(ITypeConformance_getResultAsFileSystem);
+        CASE(ITypeConformance_getEntryPointHash);
+        CASE(ITypeConformance_specialize);
+        CASE(ITypeConformance_link);
+        CASE(ITypeConformance_getEntryPointHostCallable);
+        CASE(ITypeConformance_renameEntryPoint);
+        CASE(ITypeConformance_linkWithOptions);
+    default:
+        return "Unknown";
+    }
+#undef CASE
+}
+
 void slangRecordLog(LogLevel logLevel, const char* fmt, ...)
 {
     if (logLevel > g_logLevel)
@@ -7,6 +7,8 @@
 #define __PRETTY_FUNCTION__ __FUNCSIG__
 #endif
 
+#include "record-format.h"
+
 namespace SlangRecord
 {
 enum LogLevel : unsigned int
@@ -18,8 +20,13 @@ enum LogLevel : unsigned int
 };
 
 bool isRecordLayerEnabled();
+bool isRecordAsyncEnabled();
+bool isRecordCompressionEnabled();
 void slangRecordLog(LogLevel logLevel, const char* fmt, ...);
 void setLogLevel();
+
+// The name of the API call `callId`, such as "ISession_loadModule"
+const char* getApiCallName(ApiCallId callId);
 } // namespace SlangRecord
 
 #define SLANG_RECORD_ASSERT(VALUE)                \
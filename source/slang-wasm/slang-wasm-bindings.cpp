@@ -14,6 +14,7 @@ EMSCRIPTEN_BINDINGS(slang)
     function("getCompileTargets", &slang::wgsl::getCompileTargets);
 
     class_<slang::wgsl::GlobalSession>("GlobalSession")
+        .function("loadCoreModule", &slang::wgsl::GlobalSession::loadCoreModule)
         .function(
             "createSession",
             &slang::wgsl::GlobalSession::createSession,
@@ -52,9 +52,12 @@ emscripten::val getCompileTargets()
 
 GlobalSession* createGlobalSession()
 {
+    // Loading the core module takes most of the time of creating a global session, so it waits
+    // until something needs it, or until `GlobalSession::loadCoreModule` is called. Creating the
+    // global session while a page starts up then doesn't hold it up.
     IGlobalSession* globalSession = nullptr;
     {
-        SlangResult result = slang::createGlobalSession(&globalSession);
+        SlangResult result = slang_createGlobalSessionWithoutCoreModule(0, &globalSession);
         if (result != SLANG_OK)
         {
             g_error.type = std::string("USER");
@@ -66,8 +69,42 @@ GlobalSession* createGlobalSession()
     return new GlobalSession(globalSession);
 }
 
+bool GlobalSession::loadCoreModule()
+{
+    if (m_isCoreModuleLoaded)
+    {
+        return true;
+    }
+
+    SlangResult result = SLANG_OK;
+    if (ISlangBlob* coreModule = slang_getEmbeddedCoreModule())
+    {
+        result = m_interface->loadCoreModule(
+            coreModule->getBufferPointer(),
+            coreModule->getBufferSize());
+    }
+    else
+    {
+        result = m_interface->compileCoreModule(0);
+    }
+
+    if (SLANG_FAILED(result))
+    {
+        g_error.type = std::string("INTERNAL");
+        g_error.result = result;
+        return false;
+    }
+    m_isCoreModuleLoaded = true;
+    return true;
+}
+
 Session* GlobalSession::createSession(int compileTarget)
 {
+    if (!loadCoreModule())
+    {
+        return nullptr;
+    }
+
     Slang::ComPtr<ISession> session;
     {
         SessionDesc sessionDesc = {};
@@ -215,12 +215,18 @@ public:
     {
     }
 
+    // Load the core module if it isn't loaded yet, which `createSession` otherwise does.
+    // Calling it ahead of time, such as while a page is idle, makes the first compile faster.
+    // Returns false on failure.
+    bool loadCoreModule();
+
     Session* createSession(int compileTarget);
 
     slang::IGlobalSession* interface() const { return m_interface; }
 
 private:
     Slang::ComPtr<slang::IGlobalSession> m_interface;
+    bool m_isCoreModuleLoaded = false;
 };
 
 GlobalSession* createGlobalSession();
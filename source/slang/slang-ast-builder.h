@@ -132,14 +132,13 @@ struct ValKey
     Val* val;
     HashCode hashCode;
     ValKey() = default;
-    ValKey(Val* v)
+    /// Make a key for `v`, which was created from a `ValNodeDesc` with `descHashCode`.
+    ///
+    /// The hash of the description already covers the node type and every operand, so it
+    /// is reused rather than walking the operands of the new node again.
+    ValKey(Val* v, HashCode descHashCode)
+        : val(v), hashCode(descHashCode)
     {
-        val = v;
-        Hasher hasher;
-        hasher.hashValue(v->astNodeType);
-        for (auto& operand : v->m_operands)
-            hasher.hashValue(operand.values.intOperand);
-        hashCode = hasher.getResult();
     }
     bool operator==(ValKey other) const
     {
@@ -201,11 +200,11 @@ public:
 
         auto node = as<Val>(createByNodeType(desc.type));
         SLANG_ASSERT(node);
+        node->m_operands.reserve(desc.operands.getCount());
         for (auto& operand : desc.operands)
             node->m_operands.add(operand);
-        auto result = node;
-        m_cachedNodes.add(ValKey(node), _Move(node));
-        return result;
+        m_cachedNodes.add(ValKey(node, desc.getHashCode()), node);
+        return node;
     }
 
     /// A cache for AST nodes that are entirely defined by their node type, with
@@ -1369,6 +1369,13 @@ class SpecializeAttribute : public Attribute
     SLANG_AST_CLASS(SpecializeAttribute)
 };
 
+class DispatchWeightAttribute : public Attribute
+{
+    SLANG_AST_CLASS(DispatchWeightAttribute)
+
+    IntegerLiteralValue weight = 0;
+};
+
 /// An attribute that marks a type, function or variable as differentiable.
 class DifferentiableAttribute : public Attribute
 {
@@ -1459,6 +1466,14 @@ class PreferCheckpointAttribute : public Attribute
     SLANG_AST_CLASS(PreferCheckpointAttribute)
 };
 
+class CheckpointPolicyAttribute : public Attribute
+{
+    SLANG_AST_CLASS(CheckpointPolicyAttribute)
+
+    /// One of the `CheckpointPolicyKind` values
+    IntegerLiteralValue policy = 0;
+};
+
 class DerivativeMemberAttribute : public Attribute
 {
     SLANG_AST_CLASS(DerivativeMemberAttribute)
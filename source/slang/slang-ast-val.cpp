@@ -89,11 +89,15 @@ Val* Val::defaultResolveImpl()
 {
     // Default resolve implementation is to recursively resolve all operands, and lookup in
     // deduplication cache.
+    //
+    // Most values are already resolved, so the description of the new value is only built
+    // once an operand is found to have changed.
     ValNodeDesc newDesc;
-    newDesc.type = astNodeType;
     bool diff = false;
-    for (auto operand : m_operands)
+    const Index operandCount = m_operands.getCount();
+    for (Index i = 0; i < operandCount; ++i)
     {
+        auto operand = m_operands[i];
         if (operand.kind == ValNodeOperandKind::ValNode)
         {
             auto valOperand = as<Val>(operand.values.nodeOperand);
@@ -102,12 +106,19 @@ Val* Val::defaultResolveImpl()
                 auto newOperand = valOperand->resolve();
                 if (newOperand != valOperand)
                 {
-                    diff = true;
+                    if (!diff)
+                    {
+                        diff = true;
+                        newDesc.type = astNodeType;
+                        for (Index j = 0; j < i; ++j)
+                            newDesc.operands.add(m_operands[j]);
+                    }
                     operand.values.nodeOperand = newOperand;
                 }
             }
         }
-        newDesc.operands.add(operand);
+        if (diff)
+            newDesc.operands.add(operand);
     }
 
     if (!diff)
@@ -359,8 +359,28 @@ CapabilitySet::CapabilitySet(Int atomCount, CapabilityName const* atoms)
 
 CapabilitySet::CapabilitySet(CapabilityName atom)
 {
-    this->m_targetSets.reserve(kCapabilityTargetCount);
-    addUnexpandedCapabilites(atom);
+    *this = getAtomCapabilitySet(atom);
+}
+
+const CapabilitySet& CapabilitySet::getAtomCapabilitySet(CapabilityName atom)
+{
+    // Expanding an atom into a conjunction for every target and stage it applies to
+    // is most of the cost of building a set, and capability checking builds sets for
+    // the same few atoms over and over, so each expansion is only done once per thread.
+    //
+    thread_local List<std::optional<CapabilitySet>> expandedSets;
+    if (expandedSets.getCount() == 0)
+        expandedSets.setCount(Index(CapabilityName::Count));
+
+    auto& expandedSet = expandedSets[Index(atom)];
+    if (!expandedSet)
+    {
+        CapabilitySet result;
+        result.m_targetSets.reserve(kCapabilityTargetCount);
+        result.addUnexpandedCapabilites(atom);
+        expandedSet = std::move(result);
+    }
+    return *expandedSet;
 }
 
 CapabilitySet::CapabilitySet(List<CapabilityName> const& atoms)
@@ -384,7 +404,7 @@ CapabilitySet CapabilitySet::makeInvalid()
 
 void CapabilitySet::addCapability(CapabilityName name)
 {
-    join(CapabilitySet(name));
+    join(getAtomCapabilitySet(name));
 }
 
 bool CapabilitySet::isEmpty() const
@@ -404,16 +424,14 @@ bool CapabilitySet::isIncompatibleWith(CapabilityAtom other) const
     if (isEmpty())
         return false;
 
-    CapabilitySet otherSet((CapabilityName)other);
-    return isIncompatibleWith(otherSet);
+    return isIncompatibleWith(getAtomCapabilitySet((CapabilityName)other));
 }
 
 bool CapabilitySet::isIncompatibleWith(CapabilityName other) const
 {
     if (isEmpty())
         return false;
-    auto otherSet = CapabilitySet(other);
-    return isIncompatibleWith(otherSet);
+    return isIncompatibleWith(getAtomCapabilitySet(other));
 }
 
 bool CapabilitySet::isIncompatibleWith(CapabilitySet const& other) const
@@ -469,9 +487,7 @@ bool CapabilitySet::implies(CapabilityAtom atom) const
     if (isEmpty() || atom == CapabilityAtom::Invalid)
         return false;
 
-    CapabilitySet tmpSet = CapabilitySet(CapabilityName(atom));
-
-    return this->implies(tmpSet);
+    return this->implies(getAtomCapabilitySet(CapabilityName(atom)));
 }
 
 CapabilitySet::ImpliesReturnFlags CapabilitySet::_implies(
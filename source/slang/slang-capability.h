@@ -120,6 +120,9 @@ public:
     /// Construct a singleton set from a single atomic capability
     explicit CapabilitySet(CapabilityName atom);
 
+    /// Get the singleton set of a single atomic capability, which is only built once
+    static const CapabilitySet& getAtomCapabilitySet(CapabilityName atom);
+
     /// Make an empty capability set
     static CapabilitySet makeEmpty();
 
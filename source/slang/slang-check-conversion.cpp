@@ -1440,10 +1440,14 @@ bool SemanticsVisitor::canCoerce(
     // As an optimization, we will maintain a cache of conversion results
     // for basic types such as scalars and vectors.
     //
+    // These conversions are defined by the core module, so the cache is
+    // shared by all the linkages of the session.
+    //
 
     bool shouldAddToCache = false;
     ConversionCost cost;
-    TypeCheckingCache* typeCheckingCache = getLinkage()->getTypeCheckingCache();
+    SharedTypeCheckingCache* typeCheckingCache =
+        getLinkage()->getSessionImpl()->getSharedTypeCheckingCache();
 
     BasicTypeKeyPair cacheKey;
     cacheKey.type1 = makeBasicTypeKey(toType);
@@ -1270,6 +1270,14 @@ void SemanticsVisitor::ensureDecl(Decl* decl, DeclCheckState state, SemanticsCon
 ///
 void SemanticsVisitor::ensureAllDeclsRec(Decl* decl, DeclCheckState state)
 {
+    // The body of a function nothing has referenced yet can be checked later, if at all.
+    if (state >= DeclCheckState::DefinitionChecked && getShared()->shouldDeferFunctionBody(decl))
+    {
+        if (state == DeclCheckState::DefinitionChecked)
+            getShared()->m_deferredFunctionDecls.add(decl);
+        return;
+    }
+
     // Ensure `decl` itself first.
     ensureDecl(decl, state);
 
@@ -3154,6 +3162,16 @@ void SemanticsDeclVisitorBase::checkModule(ModuleDecl* moduleDecl)
         _registerBuiltinDeclsRec(getSession(), moduleDecl);
     }
 
+    // The bodies of functions in an imported module are only checked when needed if the
+    // user asked for it. Nothing outside of the module can reference its private and internal
+    // functions, so once the module is checked the ones left unreferenced never will be.
+    //
+    auto module = getShared()->getModule();
+    getShared()->m_deferUnreferencedFunctionBodies =
+        getOptionSet().getBoolOption(CompilerOptionName::LazyImportChecking) && module &&
+        getLinkage()->isBeingImported(module) && !isFromCoreModule(moduleDecl) &&
+        !getShared()->isInLanguageServer();
+
     if (moduleDecl->members.getCount() > 0)
     {
         auto firstMember = moduleDecl->members[0];
@@ -3309,9 +3327,45 @@ void SemanticsDeclVisitorBase::checkModule(ModuleDecl* moduleDecl)
         // to the subset of declarations coming from a given source
         // file.
         //
+        // Checking function bodies on multiple threads within a single
+        // front end isn't possible yet. Body checking mutates state
+        // shared by the whole linkage: the `ASTBuilder` that creates
+        // (and deduplicates) nodes, the `TypeCheckingCache` and the
+        // caches on `SharedSemanticsContext`, the `NamePool`, and the
+        // diagnostic sink. Checking a body can also advance other
+        // declarations (via `ensureDecl`) and synthesize members of
+        // the types it uses. All of these would need to be made
+        // thread-safe, or per-thread and merged, and the diagnostics
+        // ordered deterministically.
+        //
         ensureAllDeclsRec(moduleDecl, s);
+
+        // Checking the bodies above may have referenced functions whose bodies were deferred,
+        // and checking those may reference more of them.
+        //
+        if (s == DeclCheckState::DefinitionChecked)
+        {
+            auto& deferredDecls = getShared()->m_deferredFunctionDecls;
+            for (bool changed = true; changed;)
+            {
+                changed = false;
+                for (Index i = 0; i < deferredDecls.getCount(); ++i)
+                {
+                    auto decl = deferredDecls[i];
+                    if (getShared()->shouldDeferFunctionBody(decl))
+                        continue;
+                    deferredDecls.fastRemoveAt(i--);
+                    ensureAllDeclsRec(decl, s);
+                    changed = true;
+                }
+            }
+        }
     }
 
+    // The functions still deferred are left out of the module's IR.
+    for (auto decl : getShared()->m_deferredFunctionDecls)
+        module->getDeclsWithUncheckedBodies().add(decl);
+
     // Once we have completed the above loop, all declarations not
     // nested in function bodies should be in `DeclState::Checked`.
     // Furthermore, because a fully checked function will have checked
@@ -7062,10 +7116,14 @@ void SemanticsVisitor::checkAggTypeConformance(AggTypeDecl* decl)
         // Increment epoch to invalidate the cache, so subsequent canonical types are
         // re-calculated.
         //
+        // A type without any inheritance clauses didn't check any conformances, so it can't
+        // have made any cached resolution stale, and the cache is kept.
+        //
         // TODO: Is it really necessary to invalidate globally? Maybe there's a way to invalidate
         // only the types that are affected by these interface decls.
         //
-        astBuilder->incrementEpoch();
+        if (inheritanceDecls.getCount())
+            astBuilder->incrementEpoch();
     }
 }
 
@@ -10407,6 +10465,9 @@ void SharedSemanticsContext::registerCandidateExtension(
     //
     _getCandidateExtensionList(typeDecl, m_mapTypeDeclToCandidateExtensions).add(extDecl);
 
+    // The new extension may add members to any type that the cached lookups were made in.
+    m_mapMemberLookupToResult.clear();
+
     // Remove the cached inheritanceInfo about typeDecl, if `extDecl` inherits new types.
     bool invalidateSubtypes = false;
     if (as<InterfaceDecl>(typeDecl))
@@ -11948,14 +12009,16 @@ static void _propagateRequirement(
     if (resultCaps.implies(nodeCaps))
         return;
 
-    auto oldCaps = resultCaps;
+    // Joining two valid sets only gives an invalid set when they have no target and
+    // stage in common, so that is checked up front rather than copying `resultCaps`
+    // before every join to report the conflict with.
     bool isAnyInvalid = resultCaps.isInvalid() || nodeCaps.isInvalid();
-    resultCaps.join(nodeCaps);
-
     auto decl = as<Decl>(userNode);
 
-    if (!isAnyInvalid && resultCaps.isInvalid())
+    if (!isAnyInvalid && resultCaps.isIncompatibleWith(nodeCaps))
     {
+        const auto& oldCaps = resultCaps;
+
         // If joining the referenced decl's requirements results an invalid capability set,
         // then the decl is using things that require conflicting set of capabilities, and we should
         // diagnose an error.
@@ -11997,6 +12060,8 @@ static void _propagateRequirement(
         }
     }
 
+    resultCaps.join(nodeCaps);
+
     // if stmt inside parent, set the provenance tracker to the calling function
     if (!decl)
         decl = visitor->getParentFuncOfVisitor();
@@ -12402,6 +12467,48 @@ void SemanticsDeclCapabilityVisitor::visitInheritanceDecl(InheritanceDecl* inher
     }
 }
 
+bool SharedSemanticsContext::shouldDeferFunctionBody(Decl* decl)
+{
+    if (!m_deferUnreferencedFunctionBodies)
+        return false;
+
+    // Only functions at global or namespace scope are deferred, because the bodies of
+    // members may be used to satisfy interface requirements.
+    //
+    auto funcDecl = as<FuncDecl>(decl);
+    if (auto genericDecl = as<GenericDecl>(decl))
+        funcDecl = as<FuncDecl>(genericDecl->inner);
+    if (!funcDecl || !(as<NamespaceDeclBase>(decl->parentDecl) || as<FileDecl>(decl->parentDecl)))
+        return false;
+
+    if (m_referencedDecls.contains(decl) || m_referencedDecls.contains(funcDecl))
+        return false;
+
+    // Public functions can be referenced by other modules.
+    if (getDeclVisibility(funcDecl) == DeclVisibility::Public)
+        return false;
+
+    // A function declared more than once is referenced through its first declaration.
+    if (funcDecl->primaryDecl || funcDecl->nextDecl)
+        return false;
+
+    // Attributes and most other modifiers can make a function used without being referenced,
+    // e.g. as an entry point or an export.
+    //
+    for (auto modifier : funcDecl->modifiers)
+    {
+        if (!as<VisibilityModifier>(modifier) && !as<HLSLStaticModifier>(modifier) &&
+            !as<InlineModifier>(modifier))
+            return false;
+    }
+    for (auto modifier : decl->modifiers)
+    {
+        if (decl != funcDecl && !as<VisibilityModifier>(modifier))
+            return false;
+    }
+    return true;
+}
+
 DeclVisibility getDeclVisibility(Decl* decl)
 {
     if (as<GenericTypeParamDeclBase>(decl) || as<GenericValueParamDecl>(decl) ||
@@ -346,6 +346,7 @@ DeclRefExpr* SemanticsVisitor::ConstructDeclRefExpr(
     // This is the bottleneck for using declarations which might be
     // deprecated, diagnose here.
     diagnoseDeprecatedDeclRefUsage(declRef, loc, originalExpr);
+    getShared()->noteDeclReferenced(declRef.getDecl());
 
     // Construct an appropriate expression based on the structured of
     // the declaration reference.
@@ -299,10 +299,35 @@ struct OverloadCandidate
     SubstitutionSet subst;
 };
 
-struct TypeCheckingCache
+/// The range of argument counts that a callable declaration can be applied to.
+struct OverloadArgCountRange
 {
-    Dictionary<OperatorOverloadCacheKey, OverloadCandidate> resolvedOperatorOverloadCache;
+    Count required = 0;
+
+    /// The largest number of arguments allowed, or -1 if there is no limit.
+    Count allowed = 0;
+};
+
+/// Type checking results that are shared by all the linkages created from a global session.
+///
+/// A `TypeCheckingCache` starts out empty for each linkage, and its overload candidates refer
+/// to AST nodes owned by that linkage. This cache only holds results that are determined by
+/// the core module, and only refers to core module declarations, which live as long as the
+/// global session does.
+///
+struct SharedTypeCheckingCache
+{
+    /// The core module declaration that overload resolution picked for an operator
+    /// applied to operands of basic types.
+    Dictionary<OperatorOverloadCacheKey, Decl*> resolvedOperatorDecls;
+
+    /// The cost of converting between basic types.
     Dictionary<BasicTypeKeyPair, ConversionCost> conversionCostCache;
+
+    /// The number of arguments that each core module callable accepts, so that overload
+    /// resolution can skip the overloads of intrinsics like `lerp` or `max` that don't
+    /// take as many arguments as a call provides without checking them.
+    Dictionary<Decl*, OverloadArgCountRange> overloadArgCounts;
 };
 
 enum class CoercionSite
@@ -568,6 +593,16 @@ struct InheritanceInfo
     FacetList facets;
 };
 
+struct TypeCheckingCache
+{
+    Dictionary<OperatorOverloadCacheKey, OverloadCandidate> resolvedOperatorOverloadCache;
+
+    /// Inheritance info of core module types, shared by every module checked in the linkage.
+    /// Only types that are spelled entirely with core module declarations, and whose facets
+    /// all come from the core module, are kept here.
+    Dictionary<DeclRef<Decl>, InheritanceInfo> coreModuleInheritanceInfos;
+};
+
 /// Cached information about how to convert between two types.
 struct ImplicitCastMethod
 {
@@ -760,6 +795,55 @@ public:
         m_mapTypePairToImplicitCastMethod[key] = candidate;
     }
 
+    /// The parameters of a `lookUpMember` request that its result depends on.
+    struct MemberLookupKey
+    {
+        Type* type;
+        Name* name;
+        LookupMask mask;
+        LookupOptions options;
+        HashCode getHashCode() const
+        {
+            return combineHash(
+                Slang::getHashCode(type),
+                Slang::getHashCode(name),
+                (HashCode32)mask,
+                (HashCode32)options);
+        }
+        bool operator==(const MemberLookupKey& other) const
+        {
+            return type == other.type && name == other.name && mask == other.mask &&
+                   options == other.options;
+        }
+    };
+    LookupResult* tryGetMemberLookupResult(const MemberLookupKey& key)
+    {
+        return m_mapMemberLookupToResult.tryGetValue(key);
+    }
+    void cacheMemberLookupResult(const MemberLookupKey& key, const LookupResult& result)
+    {
+        m_mapMemberLookupToResult[key] = result;
+    }
+
+    /// Is checking the bodies of functions that nothing references deferred?
+    ///
+    /// This is only done for modules being imported with `-lazy-import-checking`, and only
+    /// for functions that can't be referenced from outside of the module.
+    bool m_deferUnreferencedFunctionBodies = false;
+
+    /// Functions whose bodies have been deferred, and that nothing has referenced yet.
+    List<Decl*> m_deferredFunctionDecls;
+
+    /// Note that `decl` is referenced by checked code.
+    void noteDeclReferenced(Decl* decl)
+    {
+        if (m_deferUnreferencedFunctionBodies)
+            m_referencedDecls.add(decl);
+    }
+
+    /// Should checking the body of `decl` wait until something references it?
+    bool shouldDeferFunctionBody(Decl* decl);
+
     // Get the inner most generic decl that a decl-ref is dependent on.
     // For example, `Foo<T>` depends on the generic decl that defines `T`.
     //
@@ -791,6 +875,13 @@ private:
         DeclRef<Decl> declRef,
         DeclRefType* correspondingType,
         InheritanceCircularityInfo* circularityInfo);
+
+    /// Can `info`, computed for `declRef` while checking this module, be reused by
+    /// other modules in the linkage?
+    bool _canShareInheritanceInfo(DeclRef<Decl> declRef, InheritanceInfo const& info);
+
+    /// Can `info`, shared by another module, be used by this one?
+    bool _canUseSharedInheritanceInfo(InheritanceInfo const& info);
     InheritanceInfo _calcInheritanceInfo(Type* type, InheritanceCircularityInfo* circularityInfo);
     InheritanceInfo _calcInheritanceInfo(
         DeclRef<Decl> declRef,
@@ -889,6 +980,13 @@ private:
     Dictionary<DeclRef<Decl>, InheritanceInfo> m_mapDeclRefToInheritanceInfo;
     Dictionary<TypePair, SubtypeWitness*> m_mapTypePairToSubtypeWitness;
     Dictionary<ImplicitCastMethodKey, ImplicitCastMethod> m_mapTypePairToImplicitCastMethod;
+
+    /// Results of member lookups in types that are only declared in other modules, which
+    /// can only change when a new extension becomes visible.
+    Dictionary<MemberLookupKey, LookupResult> m_mapMemberLookupToResult;
+
+    /// Declarations referenced by checked code, when function bodies are being deferred.
+    HashSet<Decl*> m_referencedDecls;
 };
 
 /// Local/scoped state of the semantic-checking system
@@ -2637,6 +2735,16 @@ public:
 
     void AddOverloadCandidates(LookupResult const& result, OverloadResolveContext& context);
 
+    /// Add the candidates from `result`, skipping the core module callables that can't be
+    /// applied to the number of arguments in `context`.
+    ///
+    /// Returns false if some candidates were skipped and none of the others turned out to be
+    /// applicable, in which case the caller should consider the whole overload set so that
+    /// any diagnostics mention all of the candidates.
+    bool tryAddOverloadCandidatesForArgCount(
+        LookupResult const& result,
+        OverloadResolveContext& context);
+
     void AddOverloadCandidates(Expr* funcExpr, OverloadResolveContext& context);
 
     String getCallSignatureString(OverloadResolveContext& context);
@@ -86,6 +86,21 @@ InheritanceInfo SharedSemanticsContext::_getInheritanceInfo(
     if (auto found = m_mapDeclRefToInheritanceInfo.tryGetValue(declRef))
         return *found;
 
+    // The inheritance of core module types is the same for every module checked
+    // in the linkage, unless an extension from outside the core module applies,
+    // so it is only computed once for all of them.
+    //
+    auto typeCheckingCache = m_linkage->getTypeCheckingCache();
+    if (auto found = typeCheckingCache->coreModuleInheritanceInfos.tryGetValue(declRef))
+    {
+        if (_canUseSharedInheritanceInfo(*found))
+        {
+            auto info = *found;
+            m_mapDeclRefToInheritanceInfo[declRef] = info;
+            return info;
+        }
+    }
+
     // Note: we install a null pointer into the dictionary to act
     // as a sentinel during the processing of calculating the inheritnace
     // info. If we encounter this sentinel value during the calcuation,
@@ -98,6 +113,9 @@ InheritanceInfo SharedSemanticsContext::_getInheritanceInfo(
     auto info = _calcInheritanceInfo(declRef, declRefType, circularityInfo);
     m_mapDeclRefToInheritanceInfo[declRef] = info;
 
+    if (_canShareInheritanceInfo(declRef, info))
+        typeCheckingCache->coreModuleInheritanceInfos[declRef] = info;
+
     getSession()->m_typeDictionarySize = Math::Max(
         getSession()->m_typeDictionarySize,
         (int)m_mapDeclRefToInheritanceInfo.getCount());
@@ -105,6 +123,79 @@ InheritanceInfo SharedSemanticsContext::_getInheritanceInfo(
     return info;
 }
 
+/// Is `val` made up only of core module declarations and constants?
+static bool _isCoreModuleVal(Val* val)
+{
+    for (auto& operand : val->m_operands)
+    {
+        switch (operand.kind)
+        {
+        case ValNodeOperandKind::ValNode:
+            if (operand.values.nodeOperand &&
+                !_isCoreModuleVal((Val*)operand.values.nodeOperand))
+                return false;
+            break;
+        case ValNodeOperandKind::ASTNode:
+            {
+                auto decl = as<Decl>((NodeBase*)operand.values.nodeOperand);
+                if (!decl || !isFromCoreModule(decl))
+                    return false;
+                break;
+            }
+        default:
+            break;
+        }
+    }
+    return true;
+}
+
+bool SharedSemanticsContext::_canShareInheritanceInfo(
+    DeclRef<Decl> declRef,
+    InheritanceInfo const& info)
+{
+    // While a core module is being checked its extensions are still being
+    // registered, so the result may be missing facets.
+    if (!m_module)
+        return false;
+    for (auto coreModule : getSession()->coreModules)
+    {
+        if (coreModule == m_module)
+            return false;
+    }
+
+    // An empty list is the sentinel left while the info is being computed.
+    if (info.facets.isEmpty())
+        return false;
+
+    if (!_isCoreModuleVal(declRef.declRefBase))
+        return false;
+    for (auto facet : info.facets)
+    {
+        auto decl = facet.getImpl()->getDeclRef().getDecl();
+        if (!decl || !isFromCoreModule(decl))
+            return false;
+    }
+    return true;
+}
+
+bool SharedSemanticsContext::_canUseSharedInheritanceInfo(InheritanceInfo const& info)
+{
+    // The shared info is only valid if this module doesn't see any extension
+    // from outside the core module on the types and interfaces it is made of.
+    for (auto facet : info.facets)
+    {
+        auto aggTypeDecl = as<AggTypeDecl>(facet.getImpl()->getDeclRef().getDecl());
+        if (!aggTypeDecl)
+            continue;
+        for (auto extDecl : getCandidateExtensionsForTypeDecl(aggTypeDecl))
+        {
+            if (!isFromCoreModule(extDecl))
+                return false;
+        }
+    }
+    return true;
+}
+
 void SharedSemanticsContext::getDependentGenericParentImpl(
     DeclRef<GenericDecl>& genericParent,
     DeclRef<Decl> declRef)
@@ -469,6 +469,27 @@ Modifier* SemanticsVisitor::validateAttribute(
 
         anyValueSizeAttr->size = int32_t(value->getValue());
     }
+    else if (auto dispatchWeightAttr = as<DispatchWeightAttribute>(attr))
+    {
+        if (attr->args.getCount() != 1)
+        {
+            return nullptr;
+        }
+
+        auto value = checkConstantIntVal(attr->args[0]);
+        if (value == nullptr)
+        {
+            return nullptr;
+        }
+
+        if (value->getValue() < 0)
+        {
+            getSink()->diagnose(dispatchWeightAttr->loc, Diagnostics::dispatchWeightIsNegative);
+            return nullptr;
+        }
+
+        dispatchWeightAttr->weight = value->getValue();
+    }
     else if (
         auto glslRequireShaderInputParameter = as<GLSLRequireShaderInputParameterAttribute>(attr))
     {
@@ -956,6 +977,16 @@ Modifier* SemanticsVisitor::validateAttribute(
         preferRecomputeAttr->sideEffectBehavior =
             (PreferRecomputeAttribute::SideEffectBehavior)val->getValue();
     }
+    else if (auto checkpointPolicyAttr = as<CheckpointPolicyAttribute>(attr))
+    {
+        SLANG_ASSERT(attr->args.getCount() == 1);
+
+        auto val = checkConstantIntVal(attr->args[0]);
+        if (!val)
+            return nullptr;
+
+        checkpointPolicyAttr->policy = val->getValue();
+    }
     else if (auto comInterfaceAttr = as<ComInterfaceAttribute>(attr))
     {
         SLANG_ASSERT(attr->args.getCount() == 1);
@@ -2275,6 +2275,94 @@ void SemanticsVisitor::AddOverloadCandidates(
     }
 }
 
+// Look up the range of argument counts that a call to the core module callable
+// `decl` can accept, computing it from the declared parameters the first time.
+//
+// Returns false if `decl` isn't a core module callable, or if its parameters haven't
+// been checked yet, since we can't skip it safely in either case.
+//
+static bool _tryGetCoreModuleArgCountRange(
+    SharedTypeCheckingCache* cache,
+    Decl* decl,
+    OverloadArgCountRange& outRange)
+{
+    if (auto genericDecl = as<GenericDecl>(decl))
+        decl = genericDecl->inner;
+    auto callableDecl = as<CallableDecl>(decl);
+    if (!callableDecl || !isFromCoreModule(callableDecl))
+        return false;
+
+    if (cache->overloadArgCounts.tryGetValue(callableDecl, outRange))
+        return true;
+
+    OverloadArgCountRange range;
+    for (auto param : callableDecl->getParameters())
+    {
+        auto paramType = param->getType();
+        if (!paramType)
+            return false;
+
+        // A parameter pack could be matched by any number of arguments, including none.
+        if (isTypePack(paramType))
+        {
+            range.allowed = -1;
+            continue;
+        }
+
+        if (!param->initExpr)
+            range.required++;
+        if (range.allowed >= 0)
+            range.allowed++;
+    }
+
+    cache->overloadArgCounts[callableDecl] = range;
+    outRange = range;
+    return true;
+}
+
+static bool _hasApplicableCandidate(SemanticsVisitor::OverloadResolveContext& context)
+{
+    if (context.bestCandidates.getCount() > 0)
+        return context.bestCandidates[0].status == OverloadCandidate::Status::Applicable;
+    return context.bestCandidate &&
+           context.bestCandidate->status == OverloadCandidate::Status::Applicable;
+}
+
+bool SemanticsVisitor::tryAddOverloadCandidatesForArgCount(
+    LookupResult const& result,
+    OverloadResolveContext& context)
+{
+    if (!result.isOverloaded())
+    {
+        AddOverloadCandidates(result, context);
+        return true;
+    }
+
+    // The overload sets of core module intrinsics are large, and most of their
+    // entries are generics that would otherwise go through generic argument inference
+    // only to fail the arity check afterwards. A candidate that can't take this many
+    // arguments can never be applicable, so skipping it doesn't change which candidate
+    // is picked when one of the others is applicable.
+    //
+    auto cache = getLinkage()->getSessionImpl()->getSharedTypeCheckingCache();
+    auto argCount = context.getArgCount();
+    bool skippedAnyCandidate = false;
+    for (auto item : result.items)
+    {
+        OverloadArgCountRange range;
+        if (_tryGetCoreModuleArgCountRange(cache, item.declRef.getDecl(), range))
+        {
+            if (argCount < range.required || (range.allowed >= 0 && argCount > range.allowed))
+            {
+                skippedAnyCandidate = true;
+                continue;
+            }
+        }
+        AddDeclRefOverloadCandidates(item, context, kConversionCost_None);
+    }
+    return !skippedAnyCandidate || _hasApplicableCandidate(context);
+}
+
 void SemanticsVisitor::AddOverloadCandidates(Expr* funcExpr, OverloadResolveContext& context)
 {
     // A call of the form `(<something>)(<args>)` should be
@@ -2466,6 +2554,14 @@ String SemanticsVisitor::getCallSignatureString(OverloadResolveContext& context)
     return argsListBuilder.produceString();
 }
 
+/// Get the declaration that identifies an operator overload in a `SharedTypeCheckingCache`.
+static Decl* _getOperatorCacheDecl(Decl* decl)
+{
+    if (auto genericDecl = as<GenericDecl>(decl))
+        return genericDecl->inner;
+    return decl;
+}
+
 Expr* SemanticsVisitor::ResolveInvoke(InvokeExpr* expr)
 {
     OverloadResolveContext context;
@@ -2474,6 +2570,9 @@ Expr* SemanticsVisitor::ResolveInvoke(InvokeExpr* expr)
     bool shouldAddToCache = false;
     OperatorOverloadCacheKey key;
     TypeCheckingCache* typeCheckingCache = getLinkage()->getTypeCheckingCache();
+    SharedTypeCheckingCache* sharedTypeCheckingCache =
+        getLinkage()->getSessionImpl()->getSharedTypeCheckingCache();
+    Decl* sharedOperatorDecl = nullptr;
     if (auto opExpr = as<OperatorExpr>(expr))
     {
         if (key.fromOperatorExpr(opExpr))
@@ -2487,6 +2586,7 @@ Expr* SemanticsVisitor::ResolveInvoke(InvokeExpr* expr)
             else
             {
                 shouldAddToCache = true;
+                sharedTypeCheckingCache->resolvedOperatorDecls.tryGetValue(key, sharedOperatorDecl);
             }
         }
     }
@@ -2573,7 +2673,39 @@ Expr* SemanticsVisitor::ResolveInvoke(InvokeExpr* expr)
     }
     if (!context.bestCandidate && !typeOverloadChecked)
     {
-        AddOverloadCandidates(funcExpr, context);
+        // If another linkage has already resolved the same operator application to
+        // a core module declaration, we only consider the candidates for that
+        // declaration rather than the whole overload set, falling back to the whole
+        // set if none of them turn out to be applicable.
+        //
+        // Otherwise, we skip the core module overloads that can't take as many
+        // arguments as the call provides.
+        //
+        auto overloadedExpr = as<OverloadedExpr>(funcExpr);
+        bool addedCandidates = false;
+        if (sharedOperatorDecl && overloadedExpr)
+        {
+            for (auto item : overloadedExpr->lookupResult2)
+            {
+                if (_getOperatorCacheDecl(item.declRef.getDecl()) == sharedOperatorDecl)
+                    AddDeclRefOverloadCandidates(item, context, kConversionCost_None);
+            }
+            addedCandidates =
+                context.bestCandidate &&
+                context.bestCandidate->status == OverloadCandidate::Status::Applicable;
+        }
+        else if (overloadedExpr)
+        {
+            addedCandidates =
+                tryAddOverloadCandidatesForArgCount(overloadedExpr->lookupResult2, context);
+        }
+
+        if (!addedCandidates)
+        {
+            context.bestCandidate = nullptr;
+            context.bestCandidates.clear();
+            AddOverloadCandidates(funcExpr, context);
+        }
     }
 
     if (context.bestCandidates.getCount() > 0)
@@ -2692,8 +2824,23 @@ Expr* SemanticsVisitor::ResolveInvoke(InvokeExpr* expr)
         // We will report errors for this one candidate, then, to give
         // the user the most help we can.
         if (shouldAddToCache)
+        {
             typeCheckingCache->resolvedOperatorOverloadCache[key] = *context.bestCandidate;
 
+            // The candidate itself refers to AST nodes owned by this linkage, so
+            // only its declaration can be shared with other linkages, and only
+            // if it belongs to the core module.
+            //
+            auto builtinLinkage = getLinkage()->getSessionImpl()->getBuiltinLinkage();
+            auto decl = _getOperatorCacheDecl(context.bestCandidate->item.declRef.getDecl());
+            auto module = decl ? getModule(decl) : nullptr;
+            if (context.bestCandidate->status == OverloadCandidate::Status::Applicable &&
+                module && module->getLinkage() == builtinLinkage)
+            {
+                sharedTypeCheckingCache->resolvedOperatorDecls[key] = decl;
+            }
+        }
+
         // Now that we have resolved the overload candidate, we need to undo an `openExistential`
         // operation that was applied to `out` arguments.
         //
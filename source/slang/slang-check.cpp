@@ -5,6 +5,7 @@
 // checking that don't cleanly land in one of the more
 // specialized `slang-check-*` files.
 
+#include "../core/slang-performance-profiler.h"
 #include "../core/slang-type-text-util.h"
 #include "slang-check-impl.h"
 
@@ -66,6 +67,7 @@ void Session::_setSharedLibraryLoader(ISlangSharedLibraryLoader* loader)
         // Need to clear all of the libraries
         m_downstreamCompilerSet->clear();
         m_downstreamCompilerInitialized = 0;
+        m_downstreamCompilerDigestsValid = 0;
 
         for (Index i = 0; i < Index(SLANG_PASS_THROUGH_COUNT_OF); ++i)
         {
@@ -82,6 +84,44 @@ void Session::resetDownstreamCompiler(PassThroughMode type)
     // Mark as initialized
     m_downstreamCompilerInitialized &= ~(1 << int(type));
     m_downstreamCompilers[int(type)].setNull();
+    m_downstreamCompilerDigestsValid &= ~(1 << int(type));
+
+    // A compiler loaded in its place may not produce the same output.
+    m_downstreamCompileResults.clear();
+}
+
+SHA1::Digest Session::getDownstreamCompilerDigest(PassThroughMode type)
+{
+    if (m_downstreamCompilerDigestsValid & (1 << int(type)))
+        return m_downstreamCompilerDigests[int(type)];
+
+    DigestBuilder<SHA1> builder;
+
+    // Add prelude for the given downstream compiler.
+    const SourceLanguage sourceLanguage = getDefaultSourceLanguageForDownstreamCompiler(type);
+    if (sourceLanguage != SourceLanguage::Unknown)
+        builder.append(getPreludeForLanguage(sourceLanguage));
+
+    // TODO: Downstream compilers (specifically dxc) can currently #include additional
+    // dependencies. This is currently the case for NVAPI headers included in the prelude. These
+    // dependencies are currently not picked up by the shader cache which is a significant
+    // issue. This can only be fixed by running the preprocessor in the slang compiler so dxc
+    // (or any other downstream compiler for that matter) isn't resolving any includes
+    // implicitly.
+
+    // Add the downstream compiler version (if it exists) to the hash
+    if (auto downstreamCompiler = getOrLoadDownstreamCompiler(type, nullptr))
+    {
+        ComPtr<ISlangBlob> versionString;
+        if (SLANG_SUCCEEDED(downstreamCompiler->getVersionString(versionString.writeRef())))
+        {
+            builder.append(versionString);
+        }
+    }
+
+    m_downstreamCompilerDigests[int(type)] = builder.finalize();
+    m_downstreamCompilerDigestsValid |= 1 << int(type);
+    return m_downstreamCompilerDigests[int(type)];
 }
 
 IDownstreamCompiler* Session::getOrLoadDownstreamCompiler(
@@ -173,6 +213,9 @@ void checkTranslationUnit(
     TranslationUnitRequest* translationUnit,
     LoadedModuleDictionary& loadedModules)
 {
+    SLANG_PROFILE_SECTION_TAGGED(
+        checkTranslationUnit,
+        getText(translationUnit->moduleName).getUnownedSlice());
     SLANG_AST_BUILDER_RAII(translationUnit->compileRequest->getLinkage()->getASTBuilder());
 
     SharedSemanticsContext sharedSemanticsContext(
@@ -0,0 +1,137 @@
+// slang-compile-task.cpp
+#include "slang-compile-task.h"
+
+namespace Slang
+{
+
+CompileTask::CompileTask(ComponentType* componentType, Index entryPointIndex, Index targetIndex)
+    : m_componentType(componentType)
+    , m_entryPointIndex(entryPointIndex)
+    , m_targetIndex(targetIndex)
+{
+}
+
+CompileTask::~CompileTask()
+{
+    // An abandoned compile is of no further use, so stop it as early as possible.
+    cancel();
+
+    if (m_isStarted)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_completedCondition.wait(lock, [this] { return m_isComplete; });
+    }
+
+    if (m_thread.joinable())
+        m_thread.join();
+}
+
+ISlangUnknown* CompileTask::getInterface(const Guid& guid)
+{
+    if (guid == ISlangUnknown::getTypeGuid() ||
+        guid == slang::ICompileTask_Experimental::getTypeGuid())
+    {
+        return static_cast<slang::ICompileTask_Experimental*>(this);
+    }
+    return nullptr;
+}
+
+void CompileTask::start(slang::ITaskScheduler_Experimental* scheduler)
+{
+    m_isStarted = true;
+    if (!scheduler)
+        scheduler = m_componentType->getLinkage()->m_taskScheduler;
+
+    if (scheduler)
+    {
+        scheduler->scheduleTask(&_runTask, this);
+    }
+    else
+    {
+        m_thread = std::thread(&_runTask, this);
+    }
+}
+
+/* static */ void CompileTask::_runTask(void* context)
+{
+    static_cast<CompileTask*>(context)->_run();
+}
+
+void CompileTask::_run()
+{
+    ComPtr<slang::IBlob> code;
+    ComPtr<slang::IBlob> diagnostics;
+    SlangResult result = SLANG_E_ABORT;
+
+    // The task may have been cancelled before it got to run.
+    if (!m_cancellation.isCancelled())
+    {
+        auto linkage = m_componentType->getLinkage();
+
+        SLANG_LINKAGE_API_LOCK(linkage);
+        CompileCancellationScope cancellationScope(linkage, &m_cancellation);
+
+        try
+        {
+            result = (m_entryPointIndex < 0)
+                         ? m_componentType->getTargetCode(
+                               m_targetIndex,
+                               code.writeRef(),
+                               diagnostics.writeRef())
+                         : m_componentType->getEntryPointCode(
+                               m_entryPointIndex,
+                               m_targetIndex,
+                               code.writeRef(),
+                               diagnostics.writeRef());
+        }
+        catch (const AbortCompilationException&)
+        {
+            result = SLANG_FAIL;
+        }
+        catch (...)
+        {
+            result = SLANG_E_INTERNAL_FAIL;
+        }
+
+        if (m_cancellation.isCancelled())
+        {
+            code.setNull();
+            result = SLANG_E_ABORT;
+        }
+    }
+
+    // Once the task is marked complete its destructor can run, so it must
+    // not be touched after the lock is released.
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_result = result;
+    m_code = code;
+    m_diagnostics = diagnostics;
+    m_isComplete = true;
+    m_completedCondition.notify_all();
+}
+
+SLANG_NO_THROW void SLANG_MCALL CompileTask::cancel()
+{
+    m_cancellation.cancel();
+}
+
+SLANG_NO_THROW bool SLANG_MCALL CompileTask::isComplete()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_isComplete;
+}
+
+SLANG_NO_THROW SlangResult SLANG_MCALL
+CompileTask::waitForResult(slang::IBlob** outCode, slang::IBlob** outDiagnostics)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_completedCondition.wait(lock, [this] { return m_isComplete; });
+
+    if (outCode)
+        *outCode = ComPtr<slang::IBlob>(m_code).detach();
+    if (outDiagnostics)
+        *outDiagnostics = ComPtr<slang::IBlob>(m_diagnostics).detach();
+    return m_result;
+}
+
+} // namespace Slang
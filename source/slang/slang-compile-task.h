@@ -0,0 +1,75 @@
+// slang-compile-task.h
+#pragma once
+
+#include "../core/slang-basic.h"
+#include "../core/slang-com-object.h"
+#include "slang-com-ptr.h"
+#include "slang-compiler.h"
+#include "slang.h"
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace Slang
+{
+
+/// Generates the code of a component type in the background.
+///
+/// Implements `ICompileTask_Experimental`, as returned by the
+/// `IComponentTypeAsync_Experimental` methods of `ComponentType`.
+///
+/// The compile runs on a scheduler supplied by the application (for the call, or for
+/// the session), or on a thread owned by the task. It holds the linkage's API lock
+/// while running, and makes the task's cancellation active on the linkage so code
+/// generation can stop early.
+///
+/// The thread that runs the compile never holds a reference to the task: the task's
+/// destructor cancels the compile and waits for it instead. That way the component
+/// type (whose reference count is not atomic) is only released by the application.
+class CompileTask : public ComBaseObject, public slang::ICompileTask_Experimental
+{
+public:
+    SLANG_COM_BASE_IUNKNOWN_ALL
+
+    ISlangUnknown* getInterface(const Guid& guid);
+
+    // ICompileTask_Experimental
+    SLANG_NO_THROW void SLANG_MCALL cancel() SLANG_OVERRIDE;
+    SLANG_NO_THROW bool SLANG_MCALL isComplete() SLANG_OVERRIDE;
+    SLANG_NO_THROW SlangResult SLANG_MCALL
+    waitForResult(slang::IBlob** outCode, slang::IBlob** outDiagnostics) SLANG_OVERRIDE;
+
+    /// Start generating code for `targetIndex` of `componentType`.
+    ///
+    /// If `entryPointIndex` is negative the code for the whole target is generated,
+    /// otherwise just the code for that entry point.
+    void start(slang::ITaskScheduler_Experimental* scheduler);
+
+    CompileTask(ComponentType* componentType, Index entryPointIndex, Index targetIndex);
+    ~CompileTask();
+
+protected:
+    static void _runTask(void* context);
+    void _run();
+
+    RefPtr<ComponentType> m_componentType;
+    Index m_entryPointIndex;
+    Index m_targetIndex;
+
+    CompileCancellation m_cancellation;
+
+    std::mutex m_mutex;
+    std::condition_variable m_completedCondition;
+    bool m_isStarted = false;
+    bool m_isComplete = false;
+
+    SlangResult m_result = SLANG_OK;
+    ComPtr<slang::IBlob> m_code;
+    ComPtr<slang::IBlob> m_diagnostics;
+
+    /// Only used when there is no scheduler.
+    std::thread m_thread;
+};
+
+} // namespace Slang
@@ -152,10 +152,39 @@ void CompilerOptionSet::writeCommandLineArgs(Session* globalSession, StringBuild
     }
 }
 
-void CompilerOptionSet::buildHash(DigestBuilder<SHA1>& builder)
+static void _buildHash(
+    OrderedDictionary<CompilerOptionName, List<CompilerOptionValue>>& options,
+    DigestBuilder<SHA1>& builder,
+    const HashSet<String>* macroNames)
 {
     for (auto& kv : options)
     {
+        if (macroNames && kv.key == CompilerOptionName::MacroDefine)
+        {
+            // Only hash the macros we were asked for, and leave the option out entirely
+            // if there are none, so that it hashes the same as having no macros defined.
+            Index count = 0;
+            for (auto& v : kv.value)
+            {
+                if (macroNames->contains(v.stringValue))
+                    count++;
+            }
+            if (count == 0)
+                continue;
+
+            builder.append(kv.key);
+            builder.append(count);
+            for (auto& v : kv.value)
+            {
+                if (macroNames->contains(v.stringValue))
+                {
+                    builder.append(v.stringValue);
+                    builder.append(v.stringValue2);
+                }
+            }
+            continue;
+        }
+
         builder.append(kv.key);
         builder.append(kv.value.getCount());
         for (auto& v : kv.value)
@@ -173,6 +202,16 @@ void CompilerOptionSet::buildHash(DigestBuilder<SHA1>& builder)
     }
 }
 
+void CompilerOptionSet::buildHash(DigestBuilder<SHA1>& builder)
+{
+    _buildHash(options, builder, nullptr);
+}
+
+void CompilerOptionSet::buildHash(DigestBuilder<SHA1>& builder, const HashSet<String>& macroNames)
+{
+    _buildHash(options, builder, &macroNames);
+}
+
 bool CompilerOptionSet::allowDuplicate(CompilerOptionName name)
 {
     switch (name)
@@ -92,6 +92,10 @@ struct CompilerOptionSet
 
     void buildHash(DigestBuilder<SHA1>& builder);
 
+    /// Build a hash of the options like `buildHash`, except that `MacroDefine` options are
+    /// only included for the macros named in `macroNames`.
+    void buildHash(DigestBuilder<SHA1>& builder, const HashSet<String>& macroNames);
+
     static bool allowDuplicate(CompilerOptionName name);
 
     void writeCommandLineArgs(Session* globalSession, StringBuilder& sb);
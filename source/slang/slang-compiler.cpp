@@ -5,12 +5,14 @@
 #include "../compiler-core/slang-lexer.h"
 #include "../core/slang-basic.h"
 #include "../core/slang-castable.h"
+#include "../core/slang-crypto.h"
 #include "../core/slang-hex-dump-util.h"
 #include "../core/slang-io.h"
 #include "../core/slang-performance-profiler.h"
 #include "../core/slang-platform.h"
 #include "../core/slang-riff.h"
 #include "../core/slang-string-util.h"
+#include "../core/slang-task-util.h"
 #include "../core/slang-type-convert-util.h"
 #include "../core/slang-type-text-util.h"
 #include "slang-check-impl.h"
@@ -24,6 +26,7 @@
 #include "../compiler-core/slang-artifact-impl.h"
 #include "../compiler-core/slang-artifact-representation-impl.h"
 #include "../compiler-core/slang-artifact-util.h"
+#include "../compiler-core/slang-json-parser.h"
 
 // Artifact output
 #include "slang-artifact-output-util.h"
@@ -38,6 +41,8 @@
 #include "slang-serialize-container.h"
 #include "slang-type-layout.h"
 
+#include <atomic>
+
 namespace Slang
 {
 
@@ -711,6 +716,15 @@ SlangResult CodeGenContext::requireTranslationUnitSourceFiles()
     return SLANG_OK;
 }
 
+void CodeGenContext::checkForCancellation()
+{
+    auto cancellation = getLinkage()->m_activeCompileCancellation;
+    if (cancellation && cancellation->isCancelled())
+    {
+        SLANG_ABORT_COMPILATION("compilation was cancelled");
+    }
+}
+
 #if SLANG_VC
 // TODO(JS): This is a workaround
 // In debug VS builds there is a warning on line about it being unreachable.
@@ -1166,10 +1180,125 @@ SlangResult passthroughDownstreamDiagnostics(
     return SLANG_OK;
 }
 
+/// Compute a key that identifies the output of compiling with `options` using `compiler`.
+///
+/// Returns false if the output depends on inputs that the key can't capture, such as
+/// libraries or source files read by the downstream compiler, or if the output is a
+/// CPU binary that only exists as a file, so it shouldn't be reused.
+static bool _calcDownstreamCompileKey(
+    IDownstreamCompiler* compiler,
+    const DownstreamCompileOptions& options,
+    SHA1::Digest& outKey)
+{
+    if (options.libraries.count || options.sourceArtifacts.count != 1)
+        return false;
+    if (ArtifactDescUtil::isCpuLikeTarget(
+            ArtifactDescUtil::makeDescForCompileTarget(options.targetType)))
+        return false;
+
+    ComPtr<ISlangBlob> sourceBlob;
+    if (SLANG_FAILED(
+            options.sourceArtifacts[0]->loadBlob(ArtifactKeep::Yes, sourceBlob.writeRef())))
+        return false;
+
+    DigestBuilder<SHA1> builder;
+    auto appendSlice = [&](const CharSlice& slice)
+    {
+        builder.append(slice.count);
+        builder.append(slice.data, slice.count);
+    };
+    auto appendSlices = [&](const Slice<TerminatedCharSlice>& slices)
+    {
+        builder.append(slices.count);
+        for (const auto& slice : slices)
+            appendSlice(slice);
+    };
+
+    // Results can be kept on disk and so outlive the compiler, so the build of the
+    // compiler is identified as closely as it can be.
+    const auto desc = compiler->getDesc();
+    builder.append(desc.type);
+    builder.append(desc.version.toInteger());
+    ComPtr<ISlangBlob> versionString;
+    if (SLANG_SUCCEEDED(compiler->getVersionString(versionString.writeRef())) && versionString)
+        builder.append(versionString);
+
+    builder.append(options.optimizationLevel);
+    builder.append(options.debugInfoType);
+    builder.append(options.targetType);
+    builder.append(options.sourceLanguage);
+    builder.append(options.floatingPointMode);
+    builder.append(options.pipelineType);
+    builder.append(options.matrixLayout);
+    builder.append(options.flags);
+    builder.append(options.platform);
+    builder.append(options.stage);
+    builder.append(options.m_debugInfoFormat);
+
+    appendSlice(options.modulePath);
+    appendSlice(options.entryPointName);
+    appendSlice(options.profileName);
+    appendSlices(options.includePaths);
+    appendSlices(options.libraryPaths);
+    appendSlices(options.compilerSpecificArguments);
+
+    builder.append(options.defines.count);
+    for (const auto& define : options.defines)
+    {
+        appendSlice(define.nameWithSig);
+        appendSlice(define.value);
+    }
+
+    builder.append(options.requiredCapabilityVersions.count);
+    for (const auto& capabilityVersion : options.requiredCapabilityVersions)
+    {
+        builder.append(capabilityVersion.kind);
+        builder.append(capabilityVersion.version.toInteger());
+    }
+
+    builder.append(sourceBlob);
+
+    outKey = builder.finalize();
+    return true;
+}
+
+/// Returns true if `artifact` holds nothing but the output of a compile that succeeded
+/// without any diagnostics, so that it can stand in for a later identical compile.
+static bool _canReuseDownstreamCompileResult(IArtifact* artifact)
+{
+    auto diagnostics = findAssociatedRepresentation<IArtifactDiagnostics>(artifact);
+    if (diagnostics && (diagnostics->getCount() || SLANG_FAILED(diagnostics->getResult())))
+        return false;
+    return artifact->getAssociated().count == (diagnostics ? 1 : 0);
+}
+
+void DownstreamCompileJob::compile()
+{
+    if (artifact)
+        return;
+
+    auto startTime = std::chrono::high_resolution_clock::now();
+    result = compiler->compile(options, artifact.writeRef());
+    compileTime =
+        (std::chrono::high_resolution_clock::now() - startTime).count() * 0.000000001;
+}
+
 SlangResult CodeGenContext::emitWithDownstreamForEntryPoints(ComPtr<IArtifact>& outArtifact)
 {
     outArtifact.setNull();
 
+    RefPtr<DownstreamCompileJob> job;
+    SLANG_RETURN_ON_FAIL(prepareDownstreamCompile(job));
+    job->compile();
+    return finishDownstreamCompile(job, outArtifact);
+}
+
+SlangResult CodeGenContext::prepareDownstreamCompile(RefPtr<DownstreamCompileJob>& outJob)
+{
+    // Everything the options refer to is held by the job, so that the compile
+    // can be run once this function has returned.
+    RefPtr<DownstreamCompileJob> job = new DownstreamCompileJob;
+
     auto sink = getSink();
     auto session = getSession();
 
@@ -1180,7 +1309,7 @@ SlangResult CodeGenContext::emitWithDownstreamForEntryPoints(ComPtr<IArtifact>&
     RefPtr<ExtensionTracker> extensionTracker = _newExtensionTracker(target);
     PassThroughMode compilerType;
 
-    SliceAllocator allocator;
+    SliceAllocator& allocator = job->allocator;
 
     if (auto endToEndReq = isPassThroughEnabled())
     {
@@ -1220,16 +1349,17 @@ SlangResult CodeGenContext::emitWithDownstreamForEntryPoints(ComPtr<IArtifact>&
         sink->diagnose(SourceLoc(), Diagnostics::passThroughCompilerNotFound, compilerName);
         return SLANG_FAIL;
     }
+    job->compiler = compiler;
 
     Dictionary<String, String> preprocessorDefinitions;
     List<String> includePaths;
 
     typedef DownstreamCompileOptions CompileOptions;
-    CompileOptions options;
+    CompileOptions& options = job->options;
 
-    List<DownstreamCompileOptions::CapabilityVersion> requiredCapabilityVersions;
+    auto& requiredCapabilityVersions = job->requiredCapabilityVersions;
     List<String> compilerSpecificArguments;
-    List<ComPtr<IArtifact>> libraries;
+    auto& libraries = job->libraries;
     List<String> libraryPaths;
 
     // Set compiler specific args
@@ -1251,7 +1381,7 @@ SlangResult CodeGenContext::emitWithDownstreamForEntryPoints(ComPtr<IArtifact>&
         }
     }
 
-    ComPtr<IArtifact> sourceArtifact;
+    ComPtr<IArtifact>& sourceArtifact = job->sourceArtifact;
 
     /* This is more convoluted than the other scenarios, because when we invoke C/C++ compiler we
     would ideally like to use the original file. We want to do this because we want includes
@@ -1424,6 +1554,10 @@ SlangResult CodeGenContext::emitWithDownstreamForEntryPoints(ComPtr<IArtifact>&
         options.flags &=
             ~(CompileOptions::Flag::EnableExceptionHandling |
               CompileOptions::Flag::EnableSecurityChecks);
+        if (getTargetProgram()->getOptionSet().getBoolOption(CompilerOptionName::TieredJit))
+        {
+            options.flags |= CompileOptions::Flag::TieredOptimization;
+        }
         break;
     }
 
@@ -1726,18 +1860,54 @@ SlangResult CodeGenContext::emitWithDownstreamForEntryPoints(ComPtr<IArtifact>&
     options.libraries = SliceUtil::asSlice(libraries);
     options.libraryPaths = allocator.allocate(libraryPaths);
 
-    // Compile
-    ComPtr<IArtifact> artifact;
-    auto downstreamStartTime = std::chrono::high_resolution_clock::now();
-    SLANG_RETURN_ON_FAIL(compiler->compile(options, artifact.writeRef()));
-    auto downstreamElapsedTime =
-        (std::chrono::high_resolution_clock::now() - downstreamStartTime).count() * 0.000000001;
-    getSession()->addDownstreamCompileTime(downstreamElapsedTime);
+    // Generated code is often identical across compiles (say, for permutations that
+    // end up the same after dead code elimination), in which case the downstream
+    // compiler's earlier output can be used as is.
+    job->isCacheable =
+        !isPassThroughEnabled() && _calcDownstreamCompileKey(compiler, options, job->cacheKey);
+
+    if (job->isCacheable)
+    {
+        if (auto cachedResult = getSession()->findDownstreamCompileResult(job->cacheKey))
+        {
+            job->artifact = ArtifactUtil::createArtifactForCompileTarget(options.targetType);
+            job->artifact->addRepresentationUnknown(cachedResult);
+            job->isCachedResult = true;
+        }
+    }
+
+    // Running the downstream compiler is often the most expensive part of code
+    // generation, so don't start it for a compile that is no longer wanted.
+    if (!job->isCachedResult)
+        checkForCancellation();
+
+    outJob = job;
+    return SLANG_OK;
+}
+
+SlangResult CodeGenContext::finishDownstreamCompile(
+    DownstreamCompileJob* job,
+    ComPtr<IArtifact>& outArtifact)
+{
+    SLANG_RETURN_ON_FAIL(job->result);
+
+    ComPtr<IArtifact> artifact = job->artifact;
+    if (!job->isCachedResult)
+    {
+        getSession()->addDownstreamCompileTime(job->compileTime);
+
+        ComPtr<ISlangBlob> resultBlob;
+        if (job->isCacheable && _canReuseDownstreamCompileResult(artifact) &&
+            SLANG_SUCCEEDED(artifact->loadBlob(ArtifactKeep::Yes, resultBlob.writeRef())))
+        {
+            getSession()->addDownstreamCompileResult(job->cacheKey, resultBlob);
+        }
+    }
 
-    SLANG_RETURN_ON_FAIL(passthroughDownstreamDiagnostics(getSink(), compiler, artifact));
+    SLANG_RETURN_ON_FAIL(passthroughDownstreamDiagnostics(getSink(), job->compiler, artifact));
 
     // Copy over all of the information associated with the source into the output
-    if (sourceArtifact)
+    if (auto sourceArtifact = job->sourceArtifact)
     {
         for (auto associatedArtifact : sourceArtifact->getAssociated())
         {
@@ -2043,6 +2213,9 @@ IArtifact* TargetProgram::_createEntryPointResult(
     if (entryPointIndex >= m_entryPointResults.getCount())
         m_entryPointResults.setCount(entryPointIndex + 1);
 
+    SLANG_PROFILE_SECTION_TAGGED(
+        createEntryPointResult,
+        getText(m_program->getEntryPoint(entryPointIndex)->getName()).getUnownedSlice());
 
     CodeGenContext::EntryPointIndices entryPointIndices;
     entryPointIndices.add(entryPointIndex);
@@ -2055,6 +2228,127 @@ IArtifact* TargetProgram::_createEntryPointResult(
     return m_entryPointResults[entryPointIndex];
 }
 
+/// Returns true if the downstream compile of `job` may read other files, such as through
+/// `#include`s in its source.
+///
+/// Neither the file system nor the source manager can be used from several threads at once.
+static bool _mayReadFilesInDownstreamCompile(DownstreamCompileJob* job)
+{
+    ComPtr<ISlangBlob> sourceBlob;
+    if (!job->sourceArtifact ||
+        SLANG_FAILED(job->sourceArtifact->loadBlob(ArtifactKeep::Yes, sourceBlob.writeRef())))
+        return true;
+    const UnownedStringSlice source(
+        (const char*)sourceBlob->getBufferPointer(),
+        sourceBlob->getBufferSize());
+    return source.indexOf(toSlice("#include")) >= 0;
+}
+
+void TargetProgram::_createEntryPointResults(
+    DiagnosticSink* sink,
+    EndToEndCompileRequest* endToEndReq)
+{
+    const Index entryPointCount = m_program->getEntryPointCount();
+
+    // The instances that DXC and FXC create for each compile are independent,
+    // so the downstream compiles of separate entry points can be run at the same time.
+    // Other compilers either keep state of their own (NVRTC), or are run directly
+    // from code generation (glslang), so they stay serial.
+    bool canCompileInParallel = false;
+    switch (m_targetReq->getTarget())
+    {
+    case CodeGenTarget::DXIL:
+    case CodeGenTarget::DXBytecode:
+        canCompileInParallel =
+            entryPointCount > 1 &&
+            !(endToEndReq && endToEndReq->m_passThrough != PassThroughMode::None);
+        break;
+    default:
+        break;
+    }
+
+    if (!canCompileInParallel)
+    {
+        for (Index ii = 0; ii < entryPointCount; ++ii)
+        {
+            _createEntryPointResult(ii, sink, endToEndReq);
+        }
+        return;
+    }
+
+    CompileTimerRAII recordCompileTime(m_targetReq->getSession());
+
+    if (entryPointCount > m_entryPointResults.getCount())
+        m_entryPointResults.setCount(entryPointCount);
+
+    // Generating code touches state shared across the whole program, so the source
+    // for each entry point is still generated one at a time.
+    List<RefPtr<DownstreamCompileJob>> jobs;
+    jobs.setCount(entryPointCount);
+    for (Index ii = 0; ii < entryPointCount; ++ii)
+    {
+        SLANG_PROFILE_SECTION_TAGGED(
+            createEntryPointResult,
+            getText(m_program->getEntryPoint(ii)->getName()).getUnownedSlice());
+
+        CodeGenContext::EntryPointIndices entryPointIndices;
+        entryPointIndices.add(ii);
+
+        CodeGenContext::Shared sharedCodeGenContext(this, entryPointIndices, sink, endToEndReq);
+        CodeGenContext codeGenContext(&sharedCodeGenContext);
+
+        if (SLANG_FAILED(codeGenContext.prepareDownstreamCompile(jobs[ii])))
+            jobs[ii] = nullptr;
+    }
+
+    List<DownstreamCompileJob*> parallelJobs;
+    for (auto& job : jobs)
+    {
+        if (!job)
+            continue;
+        if (_mayReadFilesInDownstreamCompile(job))
+            job->compile();
+        else
+            parallelJobs.add(job);
+    }
+
+    const Index parallelJobCount = parallelJobs.getCount();
+    std::atomic<Index> nextJobIndex(0);
+    auto worker = [&]()
+    {
+        for (Index i = nextJobIndex++; i < parallelJobCount; i = nextJobIndex++)
+        {
+            parallelJobs[i]->compile();
+        }
+    };
+
+    TaskUtil::runWorkers(
+        getLinkage()->m_taskScheduler,
+        TaskUtil::calcExtraWorkerCount(parallelJobCount),
+        worker);
+
+    // Diagnostics are reported in entry point order, as they would be if each
+    // entry point had been compiled in turn.
+    for (Index ii = 0; ii < entryPointCount; ++ii)
+    {
+        if (!jobs[ii])
+            continue;
+
+        CodeGenContext::EntryPointIndices entryPointIndices;
+        entryPointIndices.add(ii);
+
+        CodeGenContext::Shared sharedCodeGenContext(this, entryPointIndices, sink, endToEndReq);
+        CodeGenContext codeGenContext(&sharedCodeGenContext);
+
+        ComPtr<IArtifact> artifact;
+        if (SLANG_SUCCEEDED(codeGenContext.finishDownstreamCompile(jobs[ii], artifact)))
+        {
+            codeGenContext.maybeDumpIntermediate(artifact);
+            m_entryPointResults[ii] = artifact;
+        }
+    }
+}
+
 IArtifact* TargetProgram::getOrCreateWholeProgramResult(DiagnosticSink* sink)
 {
     if (m_wholeProgramResult)
@@ -2094,21 +2388,15 @@ IArtifact* TargetProgram::getOrCreateEntryPointResult(Int entryPointIndex, Diagn
 
 void EndToEndCompileRequest::generateOutput(TargetProgram* targetProgram)
 {
-    auto program = targetProgram->getProgram();
-
     // Generate target code any entry points that
     // have been requested for compilation.
-    auto entryPointCount = program->getEntryPointCount();
     if (targetProgram->getOptionSet().getBoolOption(CompilerOptionName::GenerateWholeProgram))
     {
         targetProgram->_createWholeProgramResult(getSink(), this);
     }
     else
     {
-        for (Index ii = 0; ii < entryPointCount; ++ii)
-        {
-            targetProgram->_createEntryPointResult(ii, getSink(), this);
-        }
+        targetProgram->_createEntryPointResults(getSink(), this);
     }
 }
 
@@ -2136,6 +2424,7 @@ SlangResult EndToEndCompileRequest::writeContainerToStream(Stream* stream)
 
     options.compressionType = linkage->m_optionSet.getEnumOption<SerialCompressionType>(
         CompilerOptionName::IrCompression);
+    options.taskScheduler = linkage->m_taskScheduler;
 
     // If debug information is enabled, enable writing out source locs
     if (_shouldWriteSourceLocs(linkage))
@@ -2424,6 +2713,117 @@ static SlangResult _writeDependencyFile(EndToEndCompileRequest* compileRequest)
     return SLANG_OK;
 }
 
+// Writes a JSON manifest of every input of the compile: the files read with a hash of their
+// contents, the paths searched that didn't hold a file, and the versions of the compilers. If
+// none of them have changed, compiling again produces the same output (for the same options).
+static SlangResult _writeInputManifest(EndToEndCompileRequest* compileRequest)
+{
+    const String manifestPath =
+        compileRequest->getOptionSet().getStringOption(CompilerOptionName::InputManifest);
+    if (manifestPath.getLength() == 0)
+        return SLANG_OK;
+
+    auto linkage = compileRequest->getLinkage();
+    auto session = linkage->getSessionImpl();
+    auto program = compileRequest->getFrontEndReq()->getGlobalAndEntryPointsComponentType();
+
+    JSONWriter writer(JSONWriter::IndentationStyle::KNR);
+    writer.startObject(SourceLoc());
+
+    writer.addUnquotedKey(toSlice("compiler"), SourceLoc());
+    writer.addStringValue(UnownedStringSlice(getBuildTagString()), SourceLoc());
+
+    // The files read, which includes any precompiled modules that were loaded. A file is
+    // identified by the same path as in a `-depfile`.
+    HashSet<String> writtenPaths;
+    writer.addUnquotedKey(toSlice("files"), SourceLoc());
+    writer.startArray(SourceLoc());
+    auto writeFile = [&](const String& path, const void* data, size_t size)
+    {
+        if (!writtenPaths.add(path))
+            return;
+        writer.startObject(SourceLoc());
+        writer.addUnquotedKey(toSlice("path"), SourceLoc());
+        writer.addStringValue(path.getUnownedSlice(), SourceLoc());
+        writer.addUnquotedKey(toSlice("sha1"), SourceLoc());
+        writer.addStringValue(
+            SHA1::compute(data, SlangInt(size)).toString().getUnownedSlice(),
+            SourceLoc());
+        writer.endObject(SourceLoc());
+    };
+    for (auto sourceFile : program->getFileDependencies())
+    {
+        const auto& pathInfo = sourceFile->getPathInfo();
+        if (!pathInfo.hasFoundPath())
+            continue;
+        const auto content = sourceFile->getContent();
+        writeFile(pathInfo.getMostUniqueIdentity(), content.begin(), size_t(content.getLength()));
+        // The path of a module compiled from source is the found path of its file
+        writtenPaths.add(pathInfo.foundPath);
+    }
+    for (auto module : program->getModuleDependencies())
+    {
+        const char* modulePath = module->getFilePath();
+        if (!modulePath || writtenPaths.contains(modulePath))
+            continue;
+        ComPtr<ISlangBlob> blob;
+        if (SLANG_SUCCEEDED(linkage->getFileSystemExt()->loadFile(modulePath, blob.writeRef())))
+        {
+            writeFile(modulePath, blob->getBufferPointer(), blob->getBufferSize());
+        }
+    }
+    writer.endArray(SourceLoc());
+
+    // The paths that were searched without finding a file, as a file appearing at one of them
+    // could change what is found.
+    List<String> missingPaths;
+    for (const auto& path : linkage->m_missingFilePaths)
+    {
+        missingPaths.add(path);
+    }
+    missingPaths.sort();
+    writer.addUnquotedKey(toSlice("missing"), SourceLoc());
+    writer.startArray(SourceLoc());
+    for (const auto& path : missingPaths)
+    {
+        writer.addStringValue(path.getUnownedSlice(), SourceLoc());
+    }
+    writer.endArray(SourceLoc());
+
+    // The downstream compilers that were loaded, with the versions that identify them
+    writer.addUnquotedKey(toSlice("downstreamCompilers"), SourceLoc());
+    writer.startArray(SourceLoc());
+    for (const auto& compiler : session->m_downstreamCompilers)
+    {
+        if (!compiler)
+            continue;
+        writer.startObject(SourceLoc());
+        writer.addUnquotedKey(toSlice("name"), SourceLoc());
+        writer.addStringValue(
+            TypeTextUtil::getPassThroughName(compiler->getDesc().type),
+            SourceLoc());
+        ComPtr<ISlangBlob> versionString;
+        if (SLANG_SUCCEEDED(compiler->getVersionString(versionString.writeRef())) && versionString)
+        {
+            writer.addUnquotedKey(toSlice("version"), SourceLoc());
+            writer.addStringValue(StringUtil::getSlice(versionString), SourceLoc());
+        }
+        else if (compiler->getDesc().hasVersion())
+        {
+            StringBuilder version;
+            compiler->getDesc().version.append(version);
+            writer.addUnquotedKey(toSlice("version"), SourceLoc());
+            writer.addStringValue(version.getUnownedSlice(), SourceLoc());
+        }
+        writer.endObject(SourceLoc());
+    }
+    writer.endArray(SourceLoc());
+
+    writer.endObject(SourceLoc());
+    writer.getBuilder() << "\n";
+
+    return File::writeAllText(manifestPath, writer.getBuilder());
+}
 
 void EndToEndCompileRequest::generateOutput(ComponentType* program)
 {
@@ -2537,6 +2937,14 @@ void EndToEndCompileRequest::generateOutput()
 
         _writeDependencyFile(this);
     }
+
+    if (SLANG_FAILED(_writeInputManifest(this)))
+    {
+        getSink()->diagnose(
+            SourceLoc(),
+            Diagnostics::unableToWriteFile,
+            getOptionSet().getStringOption(CompilerOptionName::InputManifest));
+    }
 }
 
 // Debug logic for dumping intermediate outputs
@@ -2622,7 +3030,9 @@ IRDumpOptions CodeGenContext::getIRDumpOptions()
 
 bool CodeGenContext::shouldValidateIR()
 {
-    return getTargetProgram()->getOptionSet().getBoolOption(CompilerOptionName::ValidateIr);
+    auto& optionSet = getTargetProgram()->getOptionSet();
+    return optionSet.getBoolOption(CompilerOptionName::ValidateIr) ||
+           optionSet.getBoolOption(CompilerOptionName::ValidateIrIncremental);
 }
 
 bool CodeGenContext::shouldSkipSPIRVValidation()
@@ -2642,6 +3052,11 @@ bool CodeGenContext::shouldReportCheckpointIntermediates()
         CompilerOptionName::ReportCheckpointIntermediates);
 }
 
+bool CodeGenContext::shouldReportPassStats()
+{
+    return getTargetProgram()->getOptionSet().getBoolOption(CompilerOptionName::ReportPassStats);
+}
+
 bool CodeGenContext::shouldDumpIntermediates()
 {
     return getTargetProgram()->getOptionSet().getBoolOption(CompilerOptionName::DumpIntermediates);
@@ -2670,10 +3085,28 @@ bool CodeGenContext::isSpecializationDisabled()
         CompilerOptionName::DisableSpecialization);
 }
 
+static void _initModuleWriteOptions(
+    Linkage* linkage,
+    SerialContainerUtil::WriteOptions& outOptions)
+{
+    outOptions.sourceManager = linkage->getSourceManager();
+    outOptions.taskScheduler = linkage->m_taskScheduler;
+
+    // Modules are compressed unless asked otherwise. An uncompressed module is
+    // larger, but loading it copies each array out of the file as a block instead
+    // of decoding it entry by entry.
+    if (linkage->m_optionSet.hasOption(CompilerOptionName::IrCompression))
+    {
+        outOptions.compressionType = linkage->m_optionSet.getEnumOption<SerialCompressionType>(
+            CompilerOptionName::IrCompression);
+    }
+}
+
 SLANG_NO_THROW SlangResult SLANG_MCALL Module::serialize(ISlangBlob** outSerializedBlob)
 {
+    SLANG_LINKAGE_API_LOCK(getLinkage());
     SerialContainerUtil::WriteOptions writeOptions;
-    writeOptions.sourceManager = getLinkage()->getSourceManager();
+    _initModuleWriteOptions(getLinkage(), writeOptions);
     OwnedMemoryStream memoryStream(FileAccess::Write);
     SLANG_RETURN_ON_FAIL(SerialContainerUtil::write(this, writeOptions, &memoryStream));
     *outSerializedBlob = RawBlob::create(
@@ -2685,8 +3118,20 @@ SLANG_NO_THROW SlangResult SLANG_MCALL Module::serialize(ISlangBlob** outSeriali
 
 SLANG_NO_THROW SlangResult SLANG_MCALL Module::writeToFile(char const* fileName)
 {
+    SLANG_LINKAGE_API_LOCK(getLinkage());
+    SerialContainerUtil::WriteOptions writeOptions;
+    _initModuleWriteOptions(getLinkage(), writeOptions);
+    FileStream fileStream;
+    SLANG_RETURN_ON_FAIL(fileStream.init(fileName, FileMode::Create));
+    return SerialContainerUtil::write(this, writeOptions, &fileStream);
+}
+
+SlangResult Module::writeToCacheFile(const String& fileName)
+{
+    SLANG_LINKAGE_API_LOCK(getLinkage());
     SerialContainerUtil::WriteOptions writeOptions;
-    writeOptions.sourceManager = getLinkage()->getSourceManager();
+    _initModuleWriteOptions(getLinkage(), writeOptions);
+    writeOptions.optionFlags |= SerialOptionFlag::SourceLocation;
     FileStream fileStream;
     SLANG_RETURN_ON_FAIL(fileStream.init(fileName, FileMode::Create));
     return SerialContainerUtil::write(this, writeOptions, &fileStream);
@@ -7,12 +7,14 @@
 #include "../compiler-core/slang-downstream-compiler.h"
 #include "../compiler-core/slang-include-system.h"
 #include "../compiler-core/slang-name.h"
+#include "../compiler-core/slang-slice-allocator.h"
 #include "../compiler-core/slang-source-embed-util.h"
 #include "../compiler-core/slang-spirv-core-grammar.h"
 #include "../core/slang-basic.h"
 #include "../core/slang-command-options.h"
 #include "../core/slang-crypto.h"
 #include "../core/slang-file-system.h"
+#include "../core/slang-persistent-cache.h"
 #include "../core/slang-shared-library.h"
 #include "../core/slang-std-writers.h"
 #include "slang-capability.h"
@@ -27,6 +29,9 @@
 #include "slang-syntax.h"
 #include "slang.h"
 
+#include <atomic>
+#include <mutex>
+
 namespace Slang
 {
 struct PathInfo;
@@ -281,7 +286,9 @@ class ComponentTypeVisitor;
 ///
 class ComponentType : public RefObject,
                       public slang::IComponentType,
-                      public slang::IModulePrecompileService_Experimental
+                      public slang::IModulePrecompileService_Experimental,
+                      public slang::IComponentTypeAsync_Experimental,
+                      public slang::IComponentTypeOutput_Experimental
 {
 public:
     //
@@ -374,6 +381,49 @@ public:
         slang::IModule** outModule,
         slang::IBlob** outDiagnostics = nullptr) SLANG_OVERRIDE;
 
+    //
+    // slang::IComponentTypeAsync_Experimental interface
+    //
+    SLANG_NO_THROW SlangResult SLANG_MCALL getEntryPointCodeAsync(
+        SlangInt entryPointIndex,
+        SlangInt targetIndex,
+        slang::ITaskScheduler_Experimental* scheduler,
+        slang::ICompileTask_Experimental** outTask) SLANG_OVERRIDE;
+
+    SLANG_NO_THROW SlangResult SLANG_MCALL getTargetCodeAsync(
+        SlangInt targetIndex,
+        slang::ITaskScheduler_Experimental* scheduler,
+        slang::ICompileTask_Experimental** outTask) SLANG_OVERRIDE;
+
+    //
+    // slang::IComponentTypeOutput_Experimental interface
+    //
+    SLANG_NO_THROW SlangResult SLANG_MCALL writeEntryPointCode(
+        SlangInt entryPointIndex,
+        SlangInt targetIndex,
+        ISlangWriter* writer,
+        slang::IBlob** outDiagnostics) SLANG_OVERRIDE;
+
+    SLANG_NO_THROW SlangResult SLANG_MCALL writeTargetCode(
+        SlangInt targetIndex,
+        ISlangWriter* writer,
+        slang::IBlob** outDiagnostics) SLANG_OVERRIDE;
+
+    SLANG_NO_THROW SlangResult SLANG_MCALL copyEntryPointCode(
+        SlangInt entryPointIndex,
+        SlangInt targetIndex,
+        void* buffer,
+        size_t bufferSize,
+        size_t* outCodeSize,
+        slang::IBlob** outDiagnostics) SLANG_OVERRIDE;
+
+    SLANG_NO_THROW SlangResult SLANG_MCALL copyTargetCode(
+        SlangInt targetIndex,
+        void* buffer,
+        size_t bufferSize,
+        size_t* outCodeSize,
+        slang::IBlob** outDiagnostics) SLANG_OVERRIDE;
+
     CompilerOptionSet& getOptionSet() { return m_optionSet; }
 
     /// Get the linkage (aka "session" in the public API) for this component type.
@@ -384,9 +434,24 @@ public:
     /// The `target` must be a target on the `Linkage` that was used to create this program.
     TargetProgram* getTargetProgram(TargetRequest* target);
 
+    /// Get/set the symbol table of the IR modules of this program, other than the core modules.
+    ///
+    /// The table is owned by the IR linker (see `slang-ir-link.cpp`). The modules are the
+    /// same for every target, so the link symbol tables of all the target programs are
+    /// layered on this one, rather than each indexing the modules again.
+    ///
+    RefObject* getLinkSymbolTable() { return m_linkSymbolTable; }
+    void setLinkSymbolTable(RefObject* symbolTable) { m_linkSymbolTable = symbolTable; }
+
     /// Update the hash builder with the dependencies for this component type.
     virtual void buildHash(DigestBuilder<SHA1>& builder) = 0;
 
+    /// Get the digest of what `buildHash` adds for this component type.
+    ///
+    /// A component type doesn't change once it has been created, so the digest is only
+    /// computed the first time, and component types made of others hash in their digests.
+    SHA1::Digest getHashDigest();
+
     /// Get the number of entry points linked into this component type.
     virtual Index getEntryPointCount() = 0;
 
@@ -572,6 +637,15 @@ public:
     ///
     Scope* _getOrCreateScopeForLegacyLookup(ASTBuilder* astBuilder);
 
+    /// Get the whole-program code cached by `getTargetCode` for the target at
+    /// `targetIndex`, if any.
+    IArtifact* findCachedTargetArtifact(Int targetIndex);
+
+    /// Drop the whole-program code cached by `getTargetCode` for `targetIndex`.
+    void evictCachedTargetArtifact(Int targetIndex) { m_targetArtifacts.remove(targetIndex); }
+
+    ~ComponentType();
+
 protected:
     ComponentType(Linkage* linkage);
 
@@ -583,6 +657,9 @@ protected:
     // Cache of target-specific programs for each target.
     Dictionary<TargetRequest*, RefPtr<TargetProgram>> m_targetPrograms;
 
+    // The link symbol table shared by the target programs.
+    RefPtr<RefObject> m_linkSymbolTable;
+
     // Any types looked up dynamically using `getTypeFromString`
     //
     // TODO: Remove this. Type lookup should only be supported on `Module`s.
@@ -596,6 +673,9 @@ protected:
     std::unique_ptr<Dictionary<String, IntVal*>> m_mapMangledNameToIntVal;
 
     Dictionary<Int, ComPtr<IArtifact>> m_targetArtifacts;
+
+    SHA1::Digest m_hashDigest;
+    bool m_hasHashDigest = false;
 };
 
 /// A component type built up from other component types.
@@ -1584,6 +1664,12 @@ public:
     /// Write the serialized representation of this module to a file.
     virtual SLANG_NO_THROW SlangResult SLANG_MCALL writeToFile(char const* fileName) override;
 
+    /// Write this module to a module cache entry at `fileName`.
+    ///
+    /// Unlike `writeToFile`, source locations are always included, so that the language server
+    /// can navigate into modules it loads from the cache.
+    SlangResult writeToCacheFile(const String& fileName);
+
     /// Get the name of the module.
     virtual SLANG_NO_THROW const char* SLANG_MCALL getName() override;
 
@@ -1627,6 +1713,10 @@ public:
     void setDigest(SHA1::Digest const& digest) { m_digest = digest; }
     SHA1::Digest computeDigest();
 
+    /// Compute a digest of the compiler version and the source files this module depends on,
+    /// which unlike `computeDigest` ignores the compile options.
+    SHA1::Digest computeSourceDigest();
+
     /// Create a module (initially empty).
     Module(Linkage* linkage, ASTBuilder* astBuilder = nullptr);
 
@@ -1634,7 +1724,21 @@ public:
     ModuleDecl* getModuleDecl() { return m_moduleDecl; }
 
     /// The the IR for the module (if it has been generated)
-    IRModule* getIRModule() { return m_irModule; }
+    ///
+    /// If the module was deserialized with its IR deferred, this is where the IR is read.
+    IRModule* getIRModule();
+
+    /// Get the IR for the module if it has already been generated or read, without reading
+    /// deferred IR.
+    IRModule* getExistingIRModule() { return m_irModule; }
+
+    /// Lower the module to IR now if that was deferred, reporting diagnostics to `sink`.
+    ///
+    /// `getIRModule` also lowers a deferred module, but its diagnostics are discarded.
+    void ensureIRModule(DiagnosticSink* sink);
+
+    /// Get the pool holding the mangled names exported by the module.
+    const StringSlicePool& getMangledExportPool() const { return m_mangledExportPool; }
 
     /// Get the list of other modules this module depends on
     List<Module*> const& getModuleDependencyList()
@@ -1652,6 +1756,17 @@ public:
     void addFileDependency(SourceFile* sourceFile);
 
     void clearFileDependency() { m_fileDependencyList.clear(); }
+
+    /// Get the names of the macros whose definitions in the compile options the module
+    /// (or a module it depends on) could have been affected by when it was preprocessed.
+    ///
+    /// The module digest only includes the `MacroDefine` options for these macros, so that a
+    /// serialized module stays up to date when compiling with macros it never reads.
+    HashSet<String> const& getDefineDependencies() { return m_defineDependencies; }
+
+    /// Register a macro name whose definition in the compile options this module depends on
+    void addDefineDependency(String const& macroName) { m_defineDependencies.add(macroName); }
+
     /// Set the AST for this module.
     ///
     /// This should only be called once, during creation of the module.
@@ -1670,6 +1785,20 @@ public:
     ///
     void setIRModule(IRModule* irModule) { m_irModule = irModule; }
 
+    /// Set the serialized IR for this module, to be read the first time the IR is needed.
+    ///
+    /// The `deferredIRModule` must be an `IRSerialDeferredModule`.
+    void setDeferredIRModule(RefObject* deferredIRModule) { m_deferredIRModule = deferredIRModule; }
+
+    /// Set the translation unit to lower to IR the first time the IR is needed.
+    void setDeferredIRTranslationUnit(TranslationUnitRequest* translationUnit)
+    {
+        m_deferredIRTranslationUnit = translationUnit;
+    }
+
+    /// Drop the translation unit waiting to be lowered, if any.
+    void discardDeferredIRTranslationUnit() { m_deferredIRTranslationUnit = nullptr; }
+
     Index getEntryPointCount() SLANG_OVERRIDE { return 0; }
     RefPtr<EntryPoint> getEntryPoint(Index index) SLANG_OVERRIDE
     {
@@ -1765,6 +1894,9 @@ public:
         return m_mapSourceFileToFileDecl;
     }
 
+    /// Gets the functions whose bodies were never checked, because nothing could reference them.
+    HashSet<Decl*>& getDeclsWithUncheckedBodies() { return m_declsWithUncheckedBodies; }
+
 protected:
     void acceptVisitor(ComponentTypeVisitor* visitor, SpecializationInfo* specializationInfo)
         SLANG_OVERRIDE;
@@ -1784,6 +1916,13 @@ private:
     // The IR for the module
     RefPtr<IRModule> m_irModule = nullptr;
 
+    // The serialized IR for the module, if it hasn't been read into `m_irModule` yet
+    RefPtr<RefObject> m_deferredIRModule;
+
+    // The translation unit to lower into `m_irModule`, if that hasn't happened yet. It refers
+    // back to this module, so the linkage discards it when it is destroyed.
+    RefPtr<TranslationUnitRequest> m_deferredIRTranslationUnit;
+
     List<ShaderParamInfo> m_shaderParams;
     SpecializationParams m_specializationParams;
 
@@ -1798,6 +1937,9 @@ private:
     // List of source files this module depends on
     FileDependencyList m_fileDependencyList;
 
+    // Names of the macros whose definitions in the compile options this module depends on
+    HashSet<String> m_defineDependencies;
+
     // Entry points that were defined in this module
     //
     // Note: the entry point defined in the module are *not*
@@ -1829,6 +1971,9 @@ private:
 
     // Source files that have been pulled into the module with `__include`.
     Dictionary<SourceFile*, FileDecl*> m_mapSourceFileToFileDecl;
+
+    // Functions left unchecked with `-lazy-import-checking`, which are not lowered to IR.
+    HashSet<Decl*> m_declsWithUncheckedBodies;
 };
 typedef Module LoadedModule;
 
@@ -2003,6 +2148,14 @@ public:
 
     TypeLayout* getTypeLayout(Type* type, slang::LayoutRules rules);
 
+    /// Get/set the cache of type layouts shared by every program laid out for this target.
+    ///
+    /// The cache is owned by type layout (see `slang-type-layout.cpp`), and lets the
+    /// component types of a session reuse the layouts of the `struct` types they have in common.
+    ///
+    RefObject* getTypeLayoutCache() { return typeLayoutCache; }
+    void setTypeLayoutCache(RefObject* cache) { typeLayoutCache = cache; }
+
     CompilerOptionSet& getOptionSet() { return optionSet; }
 
     CapabilitySet getTargetCaps();
@@ -2016,6 +2169,7 @@ private:
     CompilerOptionSet optionSet;
     CapabilitySet cookedCapabilities;
     RefPtr<HLSLToVulkanLayoutOptions> hlslToVulkanOptions;
+    RefPtr<RefObject> typeLayoutCache;
 };
 
 /// Given a target request returns which (if any) intermediate source language is required
@@ -2052,6 +2206,7 @@ SourceLanguage getDefaultSourceLanguageForDownstreamCompiler(PassThroughMode com
 const char* getBuildTagString();
 
 struct TypeCheckingCache;
+struct SharedTypeCheckingCache;
 
 struct ContainerTypeKey
 {
@@ -2082,7 +2237,79 @@ enum ModuleBlobType
 struct SerialContainerDataModule;
 
 /// A context for loading and re-using code modules.
-class Linkage : public RefObject, public slang::ISession
+/// Lets a compile running on one thread be asked to stop from another thread.
+///
+/// Cancellation is cooperative: code generation checks for it (see
+/// `CodeGenContext::checkForCancellation`) at points where stopping is cheap, such as
+/// between IR passes and before running a downstream compiler.
+class CompileCancellation
+{
+public:
+    void cancel() { m_isCancelled = true; }
+    bool isCancelled() const { return m_isCancelled; }
+
+protected:
+    std::atomic<bool> m_isCancelled{false};
+};
+
+/// Tracks the target programs of a linkage that hold compiled code or other caches, so that
+/// they can be kept within the memory budget of the session (see
+/// `ISessionMemory_Experimental`).
+///
+/// Target programs are owned by their component types, which an application can release
+/// at any time. The tracker is therefore shared by the linkage and the programs it tracks,
+/// and a program removes itself from the tracker when it is destroyed.
+///
+class SessionMemoryTracker : public RefObject
+{
+public:
+    /// Record that the caches of `targetProgram` were just used, and evict the caches of
+    /// the least recently used other programs while the session is over its budget.
+    void noteUse(TargetProgram* targetProgram);
+
+    /// Stop tracking `targetProgram`, which is being destroyed.
+    void remove(TargetProgram* targetProgram);
+
+    /// Evict the caches of every tracked program.
+    void evictAll();
+
+    /// Evict the caches of every tracked program that uses any of `modules`.
+    void evictUsingModules(const HashSet<Module*>& modules);
+
+    bool isTracked(TargetProgram* targetProgram);
+
+    void setBudget(size_t budget);
+    void getStats(slang::SessionMemoryStats& outStats);
+
+    /// Update the high water marks with the sizes in `ioStats`, plus `codeGenIRBytes` of IR
+    /// currently allocated for code generation, and write the marks back into `ioStats`.
+    void updatePeaks(slang::SessionMemoryStats& ioStats, size_t codeGenIRBytes);
+
+private:
+    struct Entry
+    {
+        uint64_t lastUse = 0;
+        size_t codeSize = 0;
+        Index codeCount = 0;
+    };
+
+    void _evict(TargetProgram* targetProgram, Entry& entry);
+    void _evictOverBudget(TargetProgram* inUse);
+
+    std::mutex m_mutex;
+    Dictionary<TargetProgram*, Entry> m_entries;
+    uint64_t m_useCounter = 0;
+    size_t m_budget = 0;
+    size_t m_totalCodeSize = 0;
+    SlangInt m_evictionCount = 0;
+    size_t m_peakCodeGenIRBytes = 0;
+    size_t m_peakTotalBytes = 0;
+};
+
+class Linkage : public RefObject,
+                public slang::ISession,
+                public slang::ISessionMemory_Experimental,
+                public slang::ISessionReload_Experimental
 {
 public:
     SLANG_REF_OBJECT_IUNKNOWN_ALL
@@ -2158,6 +2385,28 @@ public:
     virtual SLANG_NO_THROW bool SLANG_MCALL
     isBinaryModuleUpToDate(const char* modulePath, slang::IBlob* binaryModuleBlob) override;
 
+    // ISessionMemory_Experimental
+    virtual SLANG_NO_THROW void SLANG_MCALL setMemoryBudget(size_t budgetInBytes) override;
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL
+    getMemoryStats(slang::SessionMemoryStats* outStats) override;
+    virtual SLANG_NO_THROW void SLANG_MCALL trimMemory() override;
+
+    // ISessionReload_Experimental
+    virtual SLANG_NO_THROW slang::IModule* SLANG_MCALL reloadModule(
+        const char* moduleName,
+        slang::IBlob* source,
+        slang::IBlob** outDiagnostics) override;
+
+    /// Get the tracker that keeps the caches of this linkage's target programs in budget.
+    SessionMemoryTracker* getMemoryTracker() { return m_memoryTracker; }
+
+    /// Measure the memory used by this linkage. `codeGenIRBytes` is the size of the IR that
+    /// is currently allocated for generating code, which counts towards the peaks.
+    void calcMemoryStats(slang::SessionMemoryStats& outStats, size_t codeGenIRBytes = 0);
+
+    /// Format the stats from `calcMemoryStats` as a human readable report.
+    static void appendMemoryReport(const slang::SessionMemoryStats& stats, StringBuilder& out);
+
     // Updates the supplied builder with linkage-related information, which includes preprocessor
     // defines, the compiler version, and other compiler options. This is then merged with the hash
     // produced for the program to produce a key that can be used with the shader cache.
@@ -2198,6 +2447,12 @@ public:
 
     NamePool* getNamePool() { return &namePool; }
 
+    // Tokens lexed from source files, shared by every translation unit preprocessed
+    // by this linkage
+    PreprocessorTokenCache m_preprocessorTokenCache;
+
+    PreprocessorTokenCache* getPreprocessorTokenCache() { return &m_preprocessorTokenCache; }
+
     ASTBuilder* getASTBuilder() { return m_astBuilder; }
 
     RefPtr<ASTBuilder> m_astBuilder;
@@ -2292,6 +2547,12 @@ public:
         SerialContainerDataModule& m,
         DiagnosticSink* sink);
 
+    /// Remove `modules` from the modules loaded into this linkage, so that a later
+    /// import (or load) of one of them produces a fresh module.
+    ///
+    /// Any module that depends on one of `modules` must be unloaded along with it.
+    void unloadModules(const HashSet<Module*>& modules);
+
     SourceFile* loadSourceFile(String pathFrom, String path);
 
     void loadParsedModule(
@@ -2305,6 +2566,22 @@ public:
 
     bool isBinaryModuleUpToDate(String fromPath, RiffContainer* container);
 
+    /// Get the path of the module cache entry for the module source at `filePathInfo`.
+    ///
+    /// Returns an empty string if module caching is not enabled, or not applicable to the source.
+    String getModuleCacheFilePath(const PathInfo& filePathInfo);
+
+    /// Try to load the module at `filePathInfo` from its module cache entry.
+    ///
+    /// Returns nullptr if there is no cache entry, or if the entry is not up-to-date.
+    RefPtr<Module> loadModuleFromCache(
+        Name* name,
+        const PathInfo& filePathInfo,
+        const String& cacheFilePath,
+        SourceLoc const& loc,
+        DiagnosticSink* sink,
+        const LoadedModuleDictionary* additionalLoadedModules);
+
     RefPtr<Module> findOrImportModule(
         Name* name,
         SourceLoc const& loc,
@@ -2362,6 +2639,43 @@ public:
 
     bool m_requireCacheFileSystem = false;
 
+    /// The set to add the paths probed when searching for files that didn't exist to, or nullptr
+    /// if they aren't tracked.
+    HashSet<String>* getMissingFilePathTracker();
+
+    /// Paths probed when searching for files that didn't exist, when an input manifest is written.
+    HashSet<String> m_missingFilePaths;
+
+    /// Reads the files of the modules that checking translation units will import, ahead of
+    /// the checking, and forgets the ones that weren't used once it's done.
+    ///
+    /// Only the outermost scope reads files: imports checked within it are already covered.
+    struct ImportedModuleFilesPrefetchRAII
+    {
+    public:
+        ImportedModuleFilesPrefetchRAII(
+            Linkage* linkage,
+            List<RefPtr<TranslationUnitRequest>> const& translationUnits)
+            : linkage(linkage), isOutermost(!linkage->m_isPrefetchingModuleFiles)
+        {
+            if (!isOutermost)
+                return;
+            linkage->m_isPrefetchingModuleFiles = true;
+            linkage->_prefetchImportedModuleFiles(translationUnits);
+        }
+
+        ~ImportedModuleFilesPrefetchRAII()
+        {
+            if (!isOutermost)
+                return;
+            linkage->m_prefetchedModuleFiles.clear();
+            linkage->m_isPrefetchingModuleFiles = false;
+        }
+
+        Linkage* linkage;
+        bool isOutermost;
+    };
+
     // Modules that have been read in with the -r option
     List<ComPtr<IArtifact>> m_libModules;
 
@@ -2414,9 +2728,68 @@ private:
     /// Diagnose that an error occured in the process of importing a module
     void _diagnoseErrorInImportedModule(DiagnosticSink* sink);
 
+    /// Read the files of the modules that `translationUnits` import, directly or indirectly,
+    /// on several threads, into `m_prefetchedModuleFiles`.
+    ///
+    /// The imports of the translation units are taken from their parsed declarations, and the
+    /// imports of the files read from a quick scan of their text, so a whole level of the
+    /// import graph is read at once. Finding the files is done as `findOrImportModule` does,
+    /// on this thread. Only done when the linkage uses the OS file system, which is safe to
+    /// read from several threads.
+    void _prefetchImportedModuleFiles(List<RefPtr<TranslationUnitRequest>> const& translationUnits);
+
+    /// The contents of files read by `_prefetchImportedModuleFiles`, by unique identity.
+    Dictionary<String, ComPtr<ISlangBlob>> m_prefetchedModuleFiles;
+    /// Set while in the outermost `ImportedModuleFilesPrefetchRAII`.
+    bool m_isPrefetchingModuleFiles = false;
+
     List<Type*> m_specializedTypes;
 
     RefPtr<SharedSemanticsContext> m_semanticsForReflection;
+
+    /// Get the mutex that serializes API calls on this linkage.
+    ///
+    /// The loaded modules, AST builder and semantic caches of a linkage are shared
+    /// by every component type created from it. Holding this mutex (see
+    /// `SLANG_LINKAGE_API_LOCK`) lets the same session be used from multiple
+    /// threads without each thread re-importing and re-checking the same modules.
+    ///
+    /// The mutex is recursive because API entry points call into each other.
+    std::recursive_mutex& getAPIMutex() { return m_apiMutex; }
+
+    /// The cancellation of the compile that is currently running on this linkage, if any.
+    ///
+    /// Set (see `CompileCancellationScope`) while a compile started through
+    /// `IComponentTypeAsync_Experimental` holds the API mutex.
+    CompileCancellation* m_activeCompileCancellation = nullptr;
+
+    /// The scheduler that parallel work for this linkage is submitted to (see
+    /// `TaskUtil::runWorkers`). If null, threads are created for the work.
+    ComPtr<slang::ITaskScheduler_Experimental> m_taskScheduler;
+
+private:
+    std::recursive_mutex m_apiMutex;
+
+    RefPtr<SessionMemoryTracker> m_memoryTracker = new SessionMemoryTracker();
+};
+
+/// Holds the API mutex of `linkage` until the end of the enclosing scope.
+#define SLANG_LINKAGE_API_LOCK(linkage) \
+    std::lock_guard<std::recursive_mutex> _linkageAPILock((linkage)->getAPIMutex())
+
+/// Makes `cancellation` the active compile cancellation of `linkage` for the lifetime
+/// of the scope. The linkage's API mutex must be held.
+struct CompileCancellationScope
+{
+    CompileCancellationScope(Linkage* linkage, CompileCancellation* cancellation)
+        : m_linkage(linkage), m_previous(linkage->m_activeCompileCancellation)
+    {
+        linkage->m_activeCompileCancellation = cancellation;
+    }
+    ~CompileCancellationScope() { m_linkage->m_activeCompileCancellation = m_previous; }
+
+    Linkage* m_linkage;
+    CompileCancellation* m_previous;
 };
 
 /// Shared functionality between front- and back-end compile requests.
@@ -2495,6 +2868,14 @@ public:
 
     void parseTranslationUnit(TranslationUnitRequest* translationUnit);
 
+    /// Read the source files of the translation units from disk on several threads.
+    ///
+    /// Only done when the linkage uses the OS file system, which (unlike a file system
+    /// supplied by the application, or the cache in front of it) is safe to use from
+    /// several threads. Files that can't be read are left for `requireSourceFiles`
+    /// to report.
+    void loadTranslationUnitSourcesInParallel();
+
     // Perform primary semantic checking on all
     // of the translation units in the program
     void checkAllTranslationUnits();
@@ -2658,6 +3039,24 @@ public:
         return m_layout;
     }
 
+    /// Get the layout for the program on the target, or null if it hasn't been created.
+    ProgramLayout* tryGetExistingLayout() { return m_layout; }
+
+    ~TargetProgram();
+
+    /// Record that the code of this program was just used, so that it is kept in
+    /// preference to the code of other programs when the session is over its memory
+    /// budget (see `SessionMemoryTracker`).
+    void noteCacheUse();
+
+    /// Get the total size in bytes of the compiled code held for this program, and the
+    /// number of results it is made of.
+    size_t getCachedCodeSize(Index* outCount = nullptr);
+
+    /// Drop the compiled code of this program, and the IR and specialization caches used
+    /// to produce it. They are created again if code is requested later.
+    void evictCaches();
+
     /// Get the compiled code for an entry point on the target.
     ///
     /// If this is the first time that code generation has
@@ -2694,10 +3093,31 @@ public:
         DiagnosticSink* sink,
         EndToEndCompileRequest* endToEndReq = nullptr);
 
+    /// Create the results for all of the entry points, as `_createEntryPointResult` would,
+    /// running the downstream compiles for them concurrently where that is safe.
+    void _createEntryPointResults(DiagnosticSink* sink, EndToEndCompileRequest* endToEndReq);
+
     RefPtr<IRModule> getOrCreateIRModuleForLayout(DiagnosticSink* sink);
 
     RefPtr<IRModule> getExistingIRModuleForLayout() { return m_irModuleForLayout; }
 
+    /// Get/set the symbol table used when linking IR for this target program.
+    ///
+    /// The table is owned by the IR linker (see `slang-ir-link.cpp`); it is
+    /// cached here so that it can be shared by all the entry points of the program.
+    ///
+    RefObject* getLinkSymbolTable() { return m_linkSymbolTable; }
+    void setLinkSymbolTable(RefObject* symbolTable) { m_linkSymbolTable = symbolTable; }
+
+    /// Get/set the cache of generic specializations made while compiling this target program.
+    ///
+    /// The cache is owned by the IR linker (see `slang-ir-link.cpp`), and lets entry points
+    /// that are compiled separately reuse each other's specialized functions. With
+    /// `-cache-derivatives` it also holds the derivatives that autodiff made.
+    ///
+    RefObject* getSpecializationCache() { return m_specializationCache; }
+    void setSpecializationCache(RefObject* cache) { m_specializationCache = cache; }
+
     CompilerOptionSet& getOptionSet() { return m_optionSet; }
 
     HLSLToVulkanLayoutOptions* getHLSLToVulkanLayoutOptions()
@@ -2731,6 +3151,12 @@ private:
     List<ComPtr<IArtifact>> m_entryPointResults;
 
     RefPtr<IRModule> m_irModuleForLayout;
+
+    RefPtr<RefObject> m_linkSymbolTable;
+    RefPtr<RefObject> m_specializationCache;
+
+    // The tracker this program has been added to by `noteCacheUse`, if any
+    RefPtr<SessionMemoryTracker> m_memoryTracker;
 };
 
 /// A back-end-specific object to track optional feaures/capabilities/extensions
@@ -2763,6 +3189,38 @@ class ExtensionTracker : public RefObject
 public:
 };
 
+/// A compile to be done by a downstream compiler, along with the storage its options refer to.
+///
+/// Holding everything the compile needs lets it run after, and on a different thread from,
+/// the code generation that produced its source.
+class DownstreamCompileJob : public RefObject
+{
+public:
+    /// Run the compile, unless an earlier identical compile already provided `artifact`.
+    ///
+    /// Only touches the job itself, so separate jobs can be compiled concurrently.
+    void compile();
+
+    ComPtr<IDownstreamCompiler> compiler;
+    DownstreamCompileOptions options;
+
+    SliceAllocator allocator;
+    ComPtr<IArtifact> sourceArtifact;
+    List<ComPtr<IArtifact>> libraries;
+    List<DownstreamCompileOptions::CapabilityVersion> requiredCapabilityVersions;
+
+    /// Identifies the output of the compile, if it can be reused by identical compiles.
+    SHA1::Digest cacheKey;
+    bool isCacheable = false;
+    /// Set if `artifact` came from an earlier identical compile.
+    bool isCachedResult = false;
+
+    SlangResult result = SLANG_OK;
+    ComPtr<IArtifact> artifact;
+    /// The time taken by `compile`, in seconds.
+    double compileTime = 0.0;
+};
+
 /// A context for code generation in the compiler back-end
 struct CodeGenContext
 {
@@ -2858,6 +3316,7 @@ public:
     bool shouldValidateIR();
     bool shouldDumpIR();
     bool shouldReportCheckpointIntermediates();
+    bool shouldReportPassStats();
 
     bool shouldTrackLiveness();
 
@@ -2872,6 +3331,10 @@ public:
 
     SlangResult requireTranslationUnitSourceFiles();
 
+    /// Aborts code generation (by throwing `AbortCompilationException`) if the
+    /// compile has been cancelled. See `CompileCancellation`.
+    void checkForCancellation();
+
     //
 
     SlangResult emitEntryPoints(ComPtr<IArtifact>& outArtifact);
@@ -2880,6 +3343,14 @@ public:
 
     void maybeDumpIntermediate(IArtifact* artifact);
 
+    /// Generate the source for the entry points and set up the downstream compile of it,
+    /// without running the compile.
+    SlangResult prepareDownstreamCompile(RefPtr<DownstreamCompileJob>& outJob);
+
+    /// Produce the output of a downstream compile set up by `prepareDownstreamCompile`,
+    /// once `job` has been compiled.
+    SlangResult finishDownstreamCompile(DownstreamCompileJob* job, ComPtr<IArtifact>& outArtifact);
+
     // Used to cause instructions available in precompiled blobs to be
     // removed between IR linking and target source generation.
     bool removeAvailableInDownstreamIR = false;
@@ -3475,6 +3946,13 @@ public:
     ModuleDecl* baseModuleDecl = nullptr;
     List<RefPtr<Module>> coreModules;
 
+    /// Symbol tables for linking against the IR of `coreModules`, which `linkIR` builds once and
+    /// layers the table of every target program on. The last table is the current one; earlier
+    /// ones are kept alive for the tables that were layered on them before more core modules
+    /// were loaded.
+    List<RefPtr<RefObject>> coreModuleLinkSymbolTables;
+    std::mutex coreModuleLinkSymbolTablesMutex;
+
     SourceManager builtinSourceManager;
 
     SourceManager* getBuiltinSourceManager() { return &builtinSourceManager; }
@@ -3513,6 +3991,12 @@ public:
     ComPtr<ISlangBlob> getAutodiffLibraryCode();
     ComPtr<ISlangBlob> getGLSLLibraryCode();
 
+    /// Get the serialized `glsl` module saved alongside the core module, if there is one.
+    ///
+    /// It is only available when the core module was loaded from the embedded archive, and
+    /// is extracted from the archive the first time it is asked for.
+    SlangResult getPrecompiledGLSLModule(ComPtr<ISlangBlob>& outBlob);
+
     RefPtr<SharedASTBuilder> m_sharedASTBuilder;
 
     SPIRVCoreGrammarInfo& getSPIRVCoreGrammarInfo()
@@ -3534,6 +4018,11 @@ public:
     /// Will unload the specified shared library if it's currently loaded
     void resetDownstreamCompiler(PassThroughMode type);
 
+    /// Get the digest of the prelude and version of the downstream compiler for `type`, as
+    /// hashed into the keys of compiled code. It is only computed again after the prelude or
+    /// the compiler changed.
+    SHA1::Digest getDownstreamCompilerDigest(PassThroughMode type);
+
     /// Get the prelude associated with the language
     const String& getPreludeForLanguage(SourceLanguage language)
     {
@@ -3543,6 +4032,14 @@ public:
     /// Get the built in linkage -> handy to get the core module from
     Linkage* getBuiltinLinkage() const { return m_builtinLinkage; }
 
+    /// Get the type checking results shared by all the linkages of this session
+    SharedTypeCheckingCache* getSharedTypeCheckingCache();
+
+    /// Find the output of an earlier downstream compile identified by `key`, or nullptr.
+    ISlangBlob* findDownstreamCompileResult(const SHA1::Digest& key);
+    /// Record the output of a downstream compile, so a later identical compile can reuse it.
+    void addDownstreamCompileResult(const SHA1::Digest& key, ISlangBlob* result);
+
     Name* getCompletionRequestTokenName() const { return m_completionTokenName; }
 
     void init();
@@ -3558,8 +4055,19 @@ public:
 
     int m_downstreamCompilerInitialized = 0;
 
+    /// The digests returned by `getDownstreamCompilerDigest`, valid for each bit set in
+    /// `m_downstreamCompilerDigestsValid`.
+    SHA1::Digest m_downstreamCompilerDigests[int(PassThroughMode::CountOf)];
+    int m_downstreamCompilerDigestsValid = 0;
+
     RefPtr<DownstreamCompilerSet>
         m_downstreamCompilerSet; ///< Information about all available downstream compilers.
+    /// The cache of the OS file system shared by the sessions that don't set a file system of
+    /// their own, so that paths probed and files read by one compile are reused by the next.
+    /// Like the rest of the global session, it must only be used from one thread at a time.
+    CacheFileSystem* getSharedOSFileSystemCache();
+    ComPtr<CacheFileSystem> m_sharedOSFileSystemCache;
+
     ComPtr<IDownstreamCompiler> m_downstreamCompilers[int(
         PassThroughMode::CountOf)]; ///< A downstream compiler for a pass through
     DownstreamCompilerLocatorFunc m_downstreamCompilerLocators[int(PassThroughMode::CountOf)];
@@ -3573,13 +4081,30 @@ public:
 private:
     void _initCodeGenTransitionMap();
 
-    SlangResult _readBuiltinModule(ISlangFileSystem* fileSystem, Scope* scope, String moduleName);
+    SlangResult _readBuiltinModule(ISlangBlob* moduleBlob, Scope* scope, String moduleName);
+
+    /// The embedded archive the core module was loaded from, which lives as long as the process.
+    const void* m_embeddedCoreModuleArchive = nullptr;
+    size_t m_embeddedCoreModuleArchiveSize = 0;
+
+    /// The serialized `glsl` module, once extracted from `m_embeddedCoreModuleArchive`.
+    ComPtr<ISlangBlob> m_precompiledGLSLModule;
+    bool m_hasTriedPrecompiledGLSLModule = false;
 
     SlangResult _loadRequest(EndToEndCompileRequest* request, const void* data, size_t size);
 
     /// Linkage used for all built-in (core module) code.
     RefPtr<Linkage> m_builtinLinkage;
 
+    SharedTypeCheckingCache* m_sharedTypeCheckingCache = nullptr;
+
+    /// Outputs of downstream compiles, keyed by a digest of the compiler and all of its inputs.
+    Dictionary<SHA1::Digest, ComPtr<ISlangBlob>> m_downstreamCompileResults;
+    /// Keeps outputs of downstream compiles on disk, so they are shared between processes.
+    /// Only set if SLANG_DOWNSTREAM_CACHE_PATH names a directory for it. The results are
+    /// stored in pack files if SLANG_DOWNSTREAM_CACHE_PACK_FILES is set to a value other than 0.
+    RefPtr<PersistentCache> m_persistentDownstreamCompileResults;
+
     String
         m_downstreamCompilerPaths[int(PassThroughMode::CountOf)]; ///< Paths for each pass through
     String m_languagePreludes[int(SourceLanguage::CountOf)]; ///< Prelude for each source language
@@ -3,53 +3,70 @@
 
 #include "../core/slang-dictionary.h"
 #include "../core/slang-list.h"
-#include "../core/slang-virtual-object-pool.h"
 
 // A pool to allow reuse of common types of containers to avoid
 // frequent resizing and rehashing.
 
 namespace Slang
 {
-static const int kContainerPoolSize = 1024;
+/// The most containers of each kind that a pool holds on to once they are freed.
+static const Index kContainerPoolSize = 64;
+
+/// Containers that have grown beyond this many elements release their storage when
+/// they are freed, so that one large function doesn't pin memory for the rest of the thread.
+static const Index kContainerPoolMaxRetainedCount = 16 * 1024;
 
 template<typename T>
 struct ObjectPool
 {
-    ObjectPool(int maxElementCount)
+    ObjectPool() = default;
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+
+    ~ObjectPool()
     {
-        m_pool.initPool(maxElementCount);
-        m_objects.setCount(maxElementCount);
+        for (auto object : m_freeObjects)
+            delete object;
     }
 
     T* getObject()
     {
-        auto id = m_pool.alloc(1);
-        if (id == -1)
-            SLANG_UNEXPECTED("container pool allocation failure.");
-        return &m_objects[id];
+        if (m_freeObjects.getCount() == 0)
+            return new T();
+        auto object = m_freeObjects.getLast();
+        m_freeObjects.removeLast();
+        return object;
     }
 
+    /// Return `object`, which must already be empty, to the pool.
     void freeObject(T* object)
     {
-        auto id = (int)(object - m_objects.getBuffer());
-        m_pool.free(id, 1);
+        if (m_freeObjects.getCount() >= kContainerPoolSize)
+            delete object;
+        else
+            m_freeObjects.add(object);
     }
 
-    VirtualObjectPool m_pool;
-    List<T> m_objects;
+    List<T*> m_freeObjects;
 };
 
+/// Holds containers of pointers that have been used and emptied, so that their storage can be
+/// reused by the next pass or function that needs a temporary container.
+///
+/// Every thread has its own pool (see `getThreadLocal`), which is shared by all IR modules,
+/// passes and emitters running on that thread. Containers must be freed on the thread that
+/// got them.
 struct ContainerPool
 {
     ObjectPool<List<void*>> m_listPool;
     ObjectPool<Dictionary<void*, void*>> m_dictionaryPool;
     ObjectPool<HashSet<void*>> m_hashSetPool;
 
-    ContainerPool()
-        : m_listPool(kContainerPoolSize)
-        , m_dictionaryPool(kContainerPoolSize)
-        , m_hashSetPool(kContainerPoolSize)
+    /// Get the pool of the calling thread.
+    static ContainerPool& getThreadLocal()
     {
+        thread_local ContainerPool pool;
+        return pool;
     }
 
     template<typename T>
@@ -73,24 +90,95 @@ struct ContainerPool
     template<typename T>
     void free(List<T*>* list)
     {
-        list->clear();
+        if (list->getCapacity() > kContainerPoolMaxRetainedCount)
+            list->clearAndDeallocate();
+        else
+            list->clear();
         m_listPool.freeObject((List<void*>*)list);
     }
 
     template<typename T, typename U>
     void free(Dictionary<T*, U*>* dict)
     {
-        dict->clear();
+        if (dict->getCount() > kContainerPoolMaxRetainedCount)
+            *dict = Dictionary<T*, U*>();
+        else
+            dict->clear();
         m_dictionaryPool.freeObject((Dictionary<void*, void*>*)dict);
     }
 
     template<typename T>
     void free(HashSet<T*>* set)
     {
-        set->clear();
+        if (set->getCount() > kContainerPoolMaxRetainedCount)
+            *set = HashSet<T*>();
+        else
+            set->clear();
         m_hashSetPool.freeObject((HashSet<void*>*)set);
     }
+
+    /// Estimate of the memory held by the free containers of the pool in bytes, including the
+    /// capacity every list in the pool keeps for reuse.
+    size_t calcMemoryUsed() const
+    {
+        size_t size = m_listPool.m_freeObjects.getCount() * sizeof(List<void*>);
+        size += m_dictionaryPool.m_freeObjects.getCount() * sizeof(Dictionary<void*, void*>);
+        size += m_hashSetPool.m_freeObjects.getCount() * sizeof(HashSet<void*>);
+        for (auto list : m_listPool.m_freeObjects)
+            size += list->getCapacity() * sizeof(void*);
+        return size;
+    }
 };
+
+/// A container borrowed from the pool of the current thread for the lifetime of the object.
+/// The container is returned to the pool, keeping its storage, when the object is destroyed.
+///
+/// This is meant for the temporary lists, sets and maps of pointers that passes and emitters
+/// create again for every function or block they process.
+template<typename TContainer>
+struct PooledContainer
+{
+    PooledContainer()
+        : m_pool(&ContainerPool::getThreadLocal())
+    {
+        _get(m_container);
+    }
+    ~PooledContainer() { m_pool->free(m_container); }
+
+    PooledContainer(const PooledContainer&) = delete;
+    PooledContainer& operator=(const PooledContainer&) = delete;
+
+    TContainer& operator*() { return *m_container; }
+    TContainer* operator->() { return m_container; }
+
+private:
+    template<typename T>
+    void _get(List<T*>*& outList)
+    {
+        outList = m_pool->getList<T>();
+    }
+    template<typename T>
+    void _get(HashSet<T*>*& outSet)
+    {
+        outSet = m_pool->getHashSet<T>();
+    }
+    template<typename T, typename U>
+    void _get(Dictionary<T*, U*>*& outDict)
+    {
+        outDict = m_pool->getDictionary<T, U>();
+    }
+
+    ContainerPool* m_pool;
+    TContainer* m_container;
+};
+
+template<typename T>
+using PooledList = PooledContainer<List<T*>>;
+template<typename T>
+using PooledHashSet = PooledContainer<HashSet<T*>>;
+template<typename T, typename U>
+using PooledDictionary = PooledContainer<Dictionary<T*, U*>>;
+
 } // namespace Slang
 
 #endif
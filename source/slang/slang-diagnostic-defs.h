@@ -291,6 +291,8 @@ DIAGNOSTIC(
     "downstream compiler '$0' doesn't support whole program compilation")
 DIAGNOSTIC(102, Note, downstreamCompileTime, "downstream compile time: $0s")
 DIAGNOSTIC(103, Note, performanceBenchmarkResult, "compiler performance benchmark:\n$0")
+DIAGNOSTIC(104, Note, irPassStatsReport, "IR pass statistics:\n$0")
+DIAGNOSTIC(105, Note, memoryReport, "compiler memory usage:\n$0")
 DIAGNOSTIC(99999, Note, noteFailedToLoadDynamicLibrary, "failed to load dynamic library '$0'")
 
 //
@@ -1026,6 +1028,7 @@ DIAGNOSTIC(
 DIAGNOSTIC(31120, Error, invalidAttributeTarget, "invalid syntax target for user defined attribute")
 
 DIAGNOSTIC(31121, Error, anyValueSizeExceedsLimit, "'anyValueSize' cannot exceed $0")
+DIAGNOSTIC(31125, Error, dispatchWeightIsNegative, "'DispatchWeight' cannot be negative")
 
 DIAGNOSTIC(
     31122,
@@ -2122,6 +2125,31 @@ DIAGNOSTIC(
     "left shift amount exceeds the number of bits and the result will be always zero, (`$0` << "
     "`$1`).")
 
+DIAGNOSTIC(
+    41040,
+    Warning,
+    timingBufferNotFound,
+    "-instrument-timing: there is no global 'RWStructuredBuffer<uint>' named '$0' to record the "
+    "timings in, so the code is not instrumented.")
+
+DIAGNOSTIC(
+    41050,
+    Warning,
+    irInstBudgetExceeded,
+    "the IR has $0 instructions after pass '$1', over the budget of $2 set by -ir-inst-budget")
+DIAGNOSTIC(
+    41051,
+    Warning,
+    irFuncInstBudgetExceeded,
+    "function '$0' has $1 IR instructions after pass '$2', over the budget of $3 set by "
+    "-ir-func-inst-budget")
+DIAGNOSTIC(
+    41052,
+    Error,
+    specializationDepthBudgetExceeded,
+    "specializing '$0' would nest $1 specializations deep, over the budget of $2 set by "
+    "-specialization-depth-budget")
+
 DIAGNOSTIC(
     41901,
     Error,
@@ -2361,6 +2389,11 @@ DIAGNOSTIC(
     Error,
     dynamicDispatchOnSpecializeOnlyInterface,
     "type '$0' is marked for specialization only, but dynamic dispatch is needed for the call.")
+DIAGNOSTIC(
+    52009,
+    Error,
+    codeGenUnavailableInReflectionOnlyMode,
+    "target code cannot be generated when compiling in reflection-only mode.")
 DIAGNOSTIC(
     53001,
     Error,
@@ -2473,6 +2506,13 @@ DIAGNOSTIC(
 DIAGNOSTIC(-1, Note, reportCheckpointCounter, "$0 bytes ($1) used for a loop counter here:")
 DIAGNOSTIC(-1, Note, reportCheckpointNone, "no checkpoint contexts to report")
 
+// Reporting local variables that are kept in memory
+DIAGNOSTIC(
+    -1,
+    Note,
+    reportUnpromotedVar,
+    "local variable '$0' of type '$1' is kept in memory because $2")
+
 // 9xxxx - Documentation generation
 DIAGNOSTIC(
     90001,
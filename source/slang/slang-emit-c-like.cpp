@@ -1085,6 +1085,24 @@ String CLikeSourceEmitter::_generateUniqueName(const UnownedStringSlice& name)
 
     StringBuilder sb;
 
+    // Compact names are `_` followed by the counter in base 36, which can't
+    // collide with the `_S<id>` names used for instructions without a hint.
+    if (m_useCompactNames)
+    {
+        static const char kDigits[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+        char buffer[16];
+        char* cursor = buffer + sizeof(buffer);
+        UInt value = m_compactNameCounter++;
+        do
+        {
+            *--cursor = kDigits[value % 36];
+            value /= 36;
+        } while (value);
+        sb << "_";
+        sb.append(cursor, buffer + sizeof(buffer));
+        return sb.produceString();
+    }
+
     appendScrubbedName(name, sb);
 
     // Avoid introducing a double underscore
@@ -1176,6 +1194,8 @@ String CLikeSourceEmitter::generateName(IRInst* inst)
     if (auto linkageDecoration = inst->findDecoration<IRLinkageDecoration>())
     {
         // Just use the linkages mangled name directly.
+        if (m_useCompactNames)
+            return _generateUniqueName(linkageDecoration->getMangledName());
         return linkageDecoration->getMangledName();
     }
 
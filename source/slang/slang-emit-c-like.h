@@ -714,6 +714,11 @@ protected:
     // name used so far during code emission.
     Dictionary<String, UInt> m_uniqueNameCounters;
 
+    // When set, generated names are replaced with short ones that
+    // only depend on the order in which they were generated.
+    bool m_useCompactNames = false;
+    UInt m_compactNameCounter = 0;
+
     // Map an IR instruction to the name that we've decided
     // to use for it when emitting code.
     Dictionary<IRInst*, String> m_mapInstToName;
@@ -1903,6 +1903,19 @@ void CPPSourceEmitter::emitVarDecorationsImpl(IRInst* inst)
     Super::emitVarDecorationsImpl(inst);
 }
 
+void CPPSourceEmitter::emitRateQualifiersAndAddressSpaceImpl(
+    IRRate* rate,
+    [[maybe_unused]] AddressSpace addressSpace)
+{
+    // `groupshared` variables remain globals on this target. A dispatch may run its groups on
+    // several threads at once, each thread running whole groups one after another, so giving
+    // every thread its own copy keeps the variables shared by exactly one group at a time.
+    if (as<IRGroupSharedRate>(rate))
+    {
+        m_writer->emit("thread_local ");
+    }
+}
+
 void CPPSourceEmitter::_getExportStyle(IRInst* inst, bool& outIsExport, bool& outIsExternC)
 {
     outIsExport = false;
@@ -2083,22 +2096,41 @@ void CPPSourceEmitter::_emitEntryPointGroup(
     for (Index i = 0; i < axes.getCount(); ++i)
     {
         const auto& axis = axes[i];
+        const bool isInnermost = (i == axes.getCount() - 1);
         builder.clear();
         const char elem[2] = {s_xyzwNames[axis.axis], 0};
+
+        // The threads along the inner loop are independent of one another, and are what a
+        // vectorizing compiler can spread across lanes. Each has its own copy of the input, so
+        // that the iterations don't all write to the same memory.
+        if (isInnermost)
+        {
+            builder << "SLANG_VECTORIZE\n";
+        }
         builder << "for (uint32_t " << elem << " = 0; " << elem << " < " << axis.size << "; ++"
                 << elem << ")\n{\n";
         m_writer->emit(builder);
         m_writer->indent();
 
         builder.clear();
-        builder << "threadInput.groupThreadID." << elem << " = " << elem << ";\n";
+        if (isInnermost)
+        {
+            builder << "ComputeThreadVaryingInput laneInput = threadInput;\n";
+            builder << "laneInput.groupThreadID." << elem << " = " << elem << ";\n";
+        }
+        else
+        {
+            builder << "threadInput.groupThreadID." << elem << " = " << elem << ";\n";
+        }
         m_writer->emit(builder);
     }
 
     // just call at inner loop point
     m_writer->emit("_");
     m_writer->emit(funcName);
-    m_writer->emit("(&threadInput, entryPointParams, globalParams);\n");
+    m_writer->emit(
+        axes.getCount() ? "(&laneInput, entryPointParams, globalParams);\n"
+                        : "(&threadInput, entryPointParams, globalParams);\n");
 
     // Close all the loops
     for (Index i = Index(axes.getCount() - 1); i >= 0; --i)
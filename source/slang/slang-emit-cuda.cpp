@@ -518,6 +518,17 @@ void CUDASourceEmitter::emitIntrinsicCallExprImpl(
         m_extensionTracker->requireBaseType(BaseType::Half);
     }
 
+    // The wave/warp helpers make up a large part of the prelude, so they are only
+    // enabled when an intrinsic actually refers to one of them.
+    if (intrinsicDefinition.indexOf(toSlice("_wave")) >= 0 ||
+        intrinsicDefinition.indexOf(toSlice("WarpMask")) >= 0 ||
+        intrinsicDefinition.indexOf(toSlice("_getLane")) >= 0 ||
+        intrinsicDefinition.indexOf(toSlice("_getActiveMask")) >= 0 ||
+        intrinsicDefinition.indexOf(toSlice("_getMultiPrefixMask")) >= 0)
+    {
+        m_extensionTracker->requireWaveIntrinsics();
+    }
+
     Super::emitIntrinsicCallExprImpl(inst, intrinsicDefinition, intrinsicInst, inOuterPrec);
 }
 
@@ -941,6 +952,17 @@ void CUDASourceEmitter::handleRequiredCapabilitiesImpl(IRInst* inst)
     }
 }
 
+void CUDASourceEmitter::emitFrontMatterImpl(TargetRequest*)
+{
+    // The front matter is emitted after the module, so at this point we know if any
+    // of the wave helpers are used. If not, skip them in the prelude, to reduce the
+    // amount of code the downstream compiler has to parse.
+    if (!m_extensionTracker->isWaveIntrinsicsRequired())
+    {
+        m_writer->emit("#define SLANG_CUDA_ENABLE_WAVE 0\n");
+    }
+}
+
 void CUDASourceEmitter::emitVectorTypeNameImpl(IRType* elementType, IRIntegerValue elementCount)
 {
     m_writer->emit(getVectorPrefix(elementType->getOp()));
@@ -21,6 +21,10 @@ public:
     }
     void requireBaseTypes(BaseTypeFlags flags) { m_baseTypeFlags |= flags; }
 
+    /// Record that the generated code uses the wave/warp helpers defined in the prelude
+    void requireWaveIntrinsics() { m_requiresWaveIntrinsics = true; }
+    bool isWaveIntrinsicsRequired() const { return m_requiresWaveIntrinsics; }
+
     /// Ensure that the generated code is compiled for at least CUDA SM `version`
     void requireSMVersion(const SemanticVersion& smVersion)
     {
@@ -34,6 +38,7 @@ protected:
     static BaseTypeFlags _getFlag(BaseType baseType) { return BaseTypeFlags(1) << int(baseType); }
 
     BaseTypeFlags m_baseTypeFlags = 0;
+    bool m_requiresWaveIntrinsics = false;
 };
 
 class CUDASourceEmitter : public CPPSourceEmitter
@@ -103,6 +108,7 @@ protected:
     virtual void emitLoopControlDecorationImpl(IRLoopControlDecoration* decl) SLANG_OVERRIDE;
 
     virtual void handleRequiredCapabilitiesImpl(IRInst* inst) SLANG_OVERRIDE;
+    virtual void emitFrontMatterImpl(TargetRequest* targetReq) SLANG_OVERRIDE;
 
     virtual bool tryEmitGlobalParamImpl(IRGlobalParam* varDecl, IRType* varType) SLANG_OVERRIDE;
     virtual bool tryEmitInstExprImpl(IRInst* inst, const EmitOpInfo& inOuterPrec) SLANG_OVERRIDE;
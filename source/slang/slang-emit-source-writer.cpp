@@ -54,6 +54,10 @@ void SourceWriter::_emitTextSpan(char const* textBegin, char const* textEnd)
     // do it now!
     _flushSourceLocationChange();
 
+    // In compact mode a line that is empty isn't emitted at all.
+    if (m_isCompact && m_isAtStartOfLine && *textBegin == '\n')
+        return;
+
     // Note: we don't want to emit indentation on a line that is empty.
     // The logic in `Emit(textBegin, textEnd)` below will have broken
     // the text into lines, so we can simply check if a line consists
@@ -63,12 +67,20 @@ void SourceWriter::_emitTextSpan(char const* textBegin, char const* textEnd)
         // We are about to emit text (other than a newline)
         // at the start of a line, so we will emit the proper
         // amount of indentation to keep things looking nice.
+        //
+        // The indentation is appended several levels at a time.
         m_isAtStartOfLine = false;
-        for (Int ii = 0; ii < m_indentLevel; ++ii)
+        if (m_indentLevel > 0 && !m_isCompact)
         {
-            char const* indentString = "    ";
-            size_t indentStringSize = strlen(indentString);
-            emitRawTextSpan(indentString, indentString + indentStringSize);
+            static const char kSpaces[] = "                                ";
+            const Index kIndentSize = 4;
+            const Index maxChunkSize = Index(sizeof(kSpaces) - 1);
+
+            const Index indentSize = m_indentLevel * kIndentSize;
+            for (Index remaining = indentSize; remaining > 0; remaining -= maxChunkSize)
+            {
+                emitRawTextSpan(kSpaces, kSpaces + Math::Min(remaining, maxChunkSize));
+            }
 
             // We will also update our tracking location, just in
             // case other logic needs it.
@@ -76,7 +88,7 @@ void SourceWriter::_emitTextSpan(char const* textBegin, char const* textEnd)
             // TODO: We may need to have a switch that controls whether
             // we are in "pretty-printing" mode or "follow the locations
             // in the original code" mode.
-            m_loc.column += indentStringSize;
+            m_loc.column += indentSize;
         }
     }
 
@@ -100,36 +112,34 @@ void SourceWriter::dedent()
 
 void SourceWriter::emitChar(char c)
 {
-    emit(&c, &c + 1);
+    if (c == '\n')
+        emit(&c, &c + 1);
+    else
+        _emitTextSpan(&c, &c + 1);
 }
 
 void SourceWriter::emit(char const* textBegin, char const* textEnd)
 {
-    char const* spanBegin = textBegin;
-    char const* spanEnd = spanBegin;
-    for (;;)
+    while (textBegin != textEnd)
     {
-        if (spanEnd == textEnd)
+        auto lineEnd = (char const*)::memchr(textBegin, '\n', size_t(textEnd - textBegin));
+        if (!lineEnd)
         {
             // We have a whole range of text waiting to be flushed
-            _emitTextSpan(spanBegin, spanEnd);
+            _emitTextSpan(textBegin, textEnd);
             return;
         }
 
-        auto c = *spanEnd++;
+        // At the end of a line, we need to update our tracking
+        // information on code positions
+        ++lineEnd;
+        _emitTextSpan(textBegin, lineEnd);
+        m_loc.line++;
+        m_loc.column = 1;
+        m_isAtStartOfLine = true;
 
-        if (c == '\n')
-        {
-            // At the end of a line, we need to update our tracking
-            // information on code positions
-            _emitTextSpan(spanBegin, spanEnd);
-            m_loc.line++;
-            m_loc.column = 1;
-            m_isAtStartOfLine = true;
-
-            // Start a new span for emit purposes
-            spanBegin = spanEnd;
-        }
+        // Start a new span for emit purposes
+        textBegin = lineEnd;
     }
 }
 
@@ -196,32 +206,47 @@ void SourceWriter::emitInt64(int64_t value)
     emit(value);
 }
 
+// Write the decimal digits of `value` to the end of the buffer ending at `end`,
+// and return where they start. The buffer must have room for 20 digits.
+static char* _formatDecimalDigits(uint64_t value, char* end)
+{
+    char* begin = end;
+    do
+    {
+        *--begin = char('0' + value % 10);
+        value /= 10;
+    } while (value);
+    return begin;
+}
+
 void SourceWriter::emit(Int32 value)
 {
-    char buffer[16];
-    snprintf(buffer, sizeof(buffer), "%" PRId32, value);
-    emit(buffer);
+    emit(Int64(value));
 }
 
 void SourceWriter::emit(Int64 value)
 {
+    // The digits are formatted straight into a local buffer, which is cheaper than going
+    // through `snprintf`, and contain no line breaks so don't need to be scanned for any.
     char buffer[32];
-    snprintf(buffer, sizeof(buffer), "%" PRId64, value);
-    emit(buffer);
+    char* const end = buffer + sizeof(buffer);
+    const uint64_t magnitude = (value < 0) ? 0 - uint64_t(value) : uint64_t(value);
+    char* begin = _formatDecimalDigits(magnitude, end);
+    if (value < 0)
+        *--begin = '-';
+    _emitTextSpan(begin, end);
 }
 
 void SourceWriter::emit(UInt32 value)
 {
-    char buffer[32];
-    snprintf(buffer, sizeof(buffer), "%" PRIu32, value);
-    emit(buffer);
+    emit(UInt64(value));
 }
 
 void SourceWriter::emit(UInt64 value)
 {
     char buffer[32];
-    snprintf(buffer, sizeof(buffer), "%" PRIu64, value);
-    emit(buffer);
+    char* const end = buffer + sizeof(buffer);
+    _emitTextSpan(_formatDecimalDigits(value, end), end);
 }
 
 void SourceWriter::emit(double value)
@@ -248,8 +273,16 @@ void SourceWriter::emit(double value)
     // number formatting ourselves, but that would require extensive testing to
     // make sure we get it right.
 
-    std::ostringstream stream;
-    stream.imbue(std::locale::classic());
+    // Setting up a stream and its locale costs more than formatting a number, so every
+    // thread keeps one stream for all the values it formats.
+    thread_local std::ostringstream stream = []()
+    {
+        std::ostringstream classicStream;
+        classicStream.imbue(std::locale::classic());
+        return classicStream;
+    }();
+    stream.str(std::string());
+    stream.clear();
 
     int expBase2;
     std::frexp(value, &expBase2);
@@ -58,6 +58,9 @@ public:
     /// Dedent (the opposite of indenting) the text
     void dedent();
 
+    /// When compact, lines are not indented and blank lines are dropped
+    void setIsCompact(bool isCompact) { m_isCompact = isCompact; }
+
     /// Move the current source location to that specified
     void advanceToSourceLocation(const SourceLoc& sourceLocation);
     /// Only advances if the sourceLocation is valid
@@ -135,6 +138,9 @@ protected:
     // How far are we indented?
     Int m_indentLevel = 0;
 
+    // Should indentation and blank lines be left out of the output?
+    bool m_isCompact = false;
+
     SourceManager* m_sourceManager = nullptr;
 
     // For GLSL output, we can't emit traditional `#line` directives
@@ -1,6 +1,8 @@
 // slang-emit-spirv.cpp
 
 #include "../core/slang-memory-arena.h"
+#include "../core/slang-performance-profiler.h"
+#include "../core/slang-task-util.h"
 #include "slang-compiler.h"
 #include "slang-emit-base.h"
 #include "slang-ir-call-graph.h"
@@ -15,6 +17,7 @@
 #include "slang-spirv-val.h"
 #include "spirv/unified1/spirv.h"
 
+#include <atomic>
 #include <type_traits>
 
 namespace Slang
@@ -134,8 +137,13 @@ public:
     /// Add an instruction to the end of the list of children
     void addInst(SpvInst* inst);
 
-    /// Dump all children, recursively, to a flattened list of SPIR-V words
-    void dumpTo(List<SpvWord>& ioWords);
+    /// Count the SPIR-V words taken by all children, recursively
+    Index calcWordCount();
+
+    /// Write all children, recursively, as a flat sequence of SPIR-V words starting at `dst`.
+    ///
+    /// `dst` must have room for `calcWordCount()` words. Returns the end of the written words.
+    SpvWord* writeTo(SpvWord* dst);
 
     /// The first child, if any.
     SpvInst* m_firstChild = nullptr;
@@ -191,10 +199,13 @@ struct SpvInst : SpvInstParent
     // cases where we needed to do post-processing, then we would
     // need to store a more refined representation here.
 
-    /// The additional words of the instruction after the opcode
-    SpvWord* operandWords = nullptr;
+    // The operand count is declared ahead of the operand pointer so that it
+    // packs alongside `opcode`, keeping a `SpvInst` to a single cache line.
+
     /// The amount of operand words
     uint32_t operandWordsCount = 0;
+    /// The additional words of the instruction after the opcode
+    SpvWord* operandWords = nullptr;
 
     // We will store the instructions in a given `SpvInstParent`
     // using an intrusive linked list.
@@ -209,8 +220,11 @@ struct SpvInst : SpvInstParent
     /// The result <id> produced by this instruction, or zero if it has no result.
     SpvWord id = 0;
 
-    /// Dump the instruction (and any children, recursively) into the flat array of SPIR-V words.
-    void dumpTo(List<SpvWord>& ioWords)
+    /// Count the words taken by the instruction and any children, recursively.
+    Index calcWordCount() { return 1 + Index(operandWordsCount) + SpvInstParent::calcWordCount(); }
+
+    /// Write the instruction (and any children, recursively) as a flat sequence of SPIR-V words.
+    SpvWord* writeTo(SpvWord* dst)
     {
         // [2.2: Terms]
         //
@@ -225,11 +239,12 @@ struct SpvInst : SpvInstParent
         // > Opcode: The 16 high-order bits are the WordCount of the instruction.
         // >         The 16 low-order bits are the opcode enumerant.
         //
-        ioWords.add(wordCount << 16 | opcode);
+        *dst++ = wordCount << 16 | opcode;
 
         // The operand words simply follow the opcode word.
         //
-        ioWords.addRange(operandWords, operandWordsCount);
+        ::memcpy(dst, operandWords, operandWordsCount * sizeof(SpvWord));
+        dst += operandWordsCount;
 
         // In our representation choice, the children of a
         // parent instruction will always follow the encoded
@@ -238,7 +253,7 @@ struct SpvInst : SpvInstParent
         // * The instructions inside a function always follow the `OpFunction`
         // * The instructions inside a block always follow the `OpLabel`
         //
-        SpvInstParent::dumpTo(ioWords);
+        return SpvInstParent::writeTo(dst);
     }
 
     void removeFromParent()
@@ -308,12 +323,23 @@ void SpvInstParent::addInst(SpvInst* inst)
     m_lastChild = inst;
 }
 
-void SpvInstParent::dumpTo(List<SpvWord>& ioWords)
+Index SpvInstParent::calcWordCount()
 {
+    Index count = 0;
     for (auto child = m_firstChild; child; child = child->nextSibling)
     {
-        child->dumpTo(ioWords);
+        count += child->calcWordCount();
     }
+    return count;
+}
+
+SpvWord* SpvInstParent::writeTo(SpvWord* dst)
+{
+    for (auto child = m_firstChild; child; child = child->nextSibling)
+    {
+        dst = child->writeTo(dst);
+    }
+    return dst;
 }
 
 /// The context for inlining a SPV assembly snippet.
@@ -514,29 +540,59 @@ struct SPIRVEmitContext : public SourceEmitterBase, public SPIRVEmitSharedContex
     // At the end of emission we need a single linear stream of words,
     // so we will eventually flatten `m_sections` into a single array.
 
-    /// The final array of SPIR-V words that defines the encoded module
-    List<SpvWord> m_words;
-
     /// Emit the concrete words that make up the binary SPIR-V module.
     ///
-    /// This function fills in `m_words` based on the data in `m_sections`.
+    /// This function fills in `spirvOut` based on the data in `m_sections`.
+    /// The words are written straight into the bytes of `spirvOut`, which
+    /// becomes the blob of the output, so the module is never copied.
     /// This function should only be called once.
     ///
-    void emitPhysicalLayout()
+    void emitPhysicalLayout(List<uint8_t>& spirvOut)
     {
+        // We size the output up front, so that every section can be written
+        // straight into its final place.
+        //
+        // Function definitions make up most of a large module, and each one's
+        // words depend only on its own instructions, so we work out where each
+        // function will land as well, which lets them be written in parallel.
+        //
+        const Index headerWordCount = 5;
+        auto& functionSection = m_sections[int(SpvLogicalSectionID::FunctionDefinitions)];
+
+        Index wordCount = headerWordCount;
+        for (int ii = 0; ii < int(SpvLogicalSectionID::FunctionDefinitions); ++ii)
+        {
+            wordCount += m_sections[ii].calcWordCount();
+        }
+
+        List<SpvInst*> functions;
+        List<Index> functionOffsets;
+        for (auto func = functionSection.m_firstChild; func; func = func->nextSibling)
+        {
+            functions.add(func);
+            functionOffsets.add(wordCount);
+            wordCount += func->calcWordCount();
+        }
+
+        // The buffer of a `List` is allocated with `new[]`, so it is aligned
+        // well enough for words.
+        spirvOut.setCount(wordCount * Index(sizeof(SpvWord)));
+        SpvWord* const words = (SpvWord*)spirvOut.getBuffer();
+        SpvWord* dst = words;
+
         // [2.3: Physical Layout of a SPIR-V Module and Instruction]
         //
         // > Magic Number
         //
-        m_words.add(SpvMagicNumber);
+        *dst++ = SpvMagicNumber;
 
         // > Version nuumber
         //
-        m_words.add(m_spvVersion);
+        *dst++ = m_spvVersion;
 
         // > Generator's magic number.
         //
-        m_words.add(kSPIRVSlangCompilerId);
+        *dst++ = kSPIRVSlangCompilerId;
 
         // > Bound
         //
@@ -544,11 +600,11 @@ struct SPIRVEmitContext : public SourceEmitterBase, public SPIRVEmitSharedContex
         // <id>s, so its value when we are done emitting code
         // can serve as the bound.
         //
-        m_words.add(m_nextID);
+        *dst++ = m_nextID;
 
         // > 0 (Reserved for instruction schema, if needed.)
         //
-        m_words.add(0);
+        *dst++ = 0;
 
         // > First word of instruction stream
         // > All remaining words are a linear sequence of instructions.
@@ -556,10 +612,52 @@ struct SPIRVEmitContext : public SourceEmitterBase, public SPIRVEmitSharedContex
         // Once we are done emitting the header, we emit all
         // the instructions in our logical sections.
         //
-        for (int ii = 0; ii < int(SpvLogicalSectionID::Count); ++ii)
+        for (int ii = 0; ii < int(SpvLogicalSectionID::FunctionDefinitions); ++ii)
+        {
+            dst = m_sections[ii].writeTo(dst);
+        }
+        SLANG_ASSERT(functions.getCount() == 0 || dst == words + functionOffsets[0]);
+
+        _writeFunctionDefinitions(words, wordCount, functions, functionOffsets);
+    }
+
+    /// Write each of `functions` to the `wordCount` words at `words`, at the matching
+    /// offset in `functionOffsets`.
+    ///
+    /// Nothing is shared between functions at this point, so large modules
+    /// are written from several threads.
+    ///
+    void _writeFunctionDefinitions(
+        SpvWord* words,
+        Index wordCount,
+        const List<SpvInst*>& functions,
+        const List<Index>& functionOffsets)
+    {
+        const Index functionCount = functions.getCount();
+        if (functionCount == 0)
+            return;
+
+        std::atomic<Index> nextFunctionIndex(0);
+        auto worker = [&]()
         {
-            m_sections[ii].dumpTo(m_words);
+            for (Index i = nextFunctionIndex++; i < functionCount; i = nextFunctionIndex++)
+            {
+                functions[i]->writeTo(words + functionOffsets[i]);
+            }
+        };
+
+        // Starting threads costs more than writing a small module serially.
+        const Index kMinWordCountForParallelWrite = 1 << 18;
+        Index extraWorkerCount = 0;
+        if (wordCount - functionOffsets[0] >= kMinWordCountForParallelWrite)
+        {
+            extraWorkerCount = TaskUtil::calcExtraWorkerCount(functionCount);
         }
+
+        TaskUtil::runWorkers(
+            m_targetProgram->getProgram()->getLinkage()->m_taskScheduler,
+            extraWorkerCount,
+            worker);
     }
 
     // We will often need to refer to an instrcition by its
@@ -718,6 +816,10 @@ struct SPIRVEmitContext : public SourceEmitterBase, public SPIRVEmitSharedContex
     /// Holds memory for instructions and operands.
     MemoryArena m_memoryArena;
 
+    /// Large modules emit millions of instructions, so the arena uses blocks big
+    /// enough that allocating them doesn't show up next to emitting the instructions.
+    static const size_t kMemoryArenaBlockSize = 64 * 1024;
+
     /// Begin emitting an instruction with the given SPIR-V `opcode`.
     ///
     /// If `irInst` is non-null, then the resulting SPIR-V instruction
@@ -1425,6 +1527,22 @@ struct SPIRVEmitContext : public SourceEmitterBase, public SPIRVEmitSharedContex
             CompilerOptionName::VulkanEmitReflection);
     }
 
+    /// Should the contents of source files be left out of `DebugSource`, so that debug
+    /// information only refers to the files by path?
+    bool shouldReferenceDebugSourceByPath()
+    {
+        auto& optionSet = m_targetProgram->getOptionSet();
+        return optionSet.getDebugInfoLevel() == DebugInfoLevel::Minimal ||
+               optionSet.getBoolOption(CompilerOptionName::DebugInfoExternalSource);
+    }
+
+    /// Should a `DebugLine` be left out when it only moves to another column of the line
+    /// that is already current?
+    bool shouldCompactDebugLines()
+    {
+        return m_targetProgram->getOptionSet().getDebugInfoLevel() == DebugInfoLevel::Minimal;
+    }
+
     void requirePhysicalStorageAddressing()
     {
         if (m_addressingMode == SpvAddressingModelPhysicalStorageBuffer64)
@@ -1785,8 +1903,8 @@ struct SPIRVEmitContext : public SourceEmitterBase, public SPIRVEmitSharedContex
                 ensureExtensionDeclaration(UnownedStringSlice("SPV_KHR_non_semantic_info"));
                 auto debugSource = as<IRDebugSource>(inst);
                 auto sourceStr = as<IRStringLit>(debugSource->getSource())->getStringSlice();
-                // If source content is empty, skip the content operand.
-                if (sourceStr.getLength() == 0)
+                // If source content is empty, or is not wanted, skip the content operand.
+                if (sourceStr.getLength() == 0 || shouldReferenceDebugSourceByPath())
                 {
                     return emitOpDebugSource(
                         getSection(SpvLogicalSectionID::ConstantsAndTypes),
@@ -6980,11 +7098,44 @@ struct SPIRVEmitContext : public SourceEmitterBase, public SPIRVEmitSharedContex
             operands.getView());
     }
 
+    /// The `DebugLine` that applies to the instructions emitted next into `parent`
+    struct CurrentDebugLine
+    {
+        SpvInstParent* parent = nullptr;
+        SpvInst* scope = nullptr;
+        IRInst* source = nullptr;
+        IRIntegerValue lineStart = 0;
+        IRIntegerValue lineEnd = 0;
+    };
+    CurrentDebugLine m_currentDebugLine;
+
     SpvInst* emitDebugLine(SpvInstParent* parent, IRDebugLine* debugLine)
     {
         auto scope = findDebugScope(debugLine);
         if (!scope)
             return nullptr;
+
+        // A `DebugLine` applies until the next one or the end of its block, so when only
+        // lines are wanted, the statements that follow on the same line don't need one.
+        if (shouldCompactDebugLines())
+        {
+            CurrentDebugLine line;
+            line.parent = parent;
+            line.scope = scope;
+            line.source = debugLine->getSource();
+            line.lineStart = getIntVal(debugLine->getLineStart());
+            line.lineEnd = getIntVal(debugLine->getLineEnd());
+            if (m_currentDebugLine.parent == line.parent &&
+                m_currentDebugLine.scope == line.scope &&
+                m_currentDebugLine.source == line.source &&
+                m_currentDebugLine.lineStart == line.lineStart &&
+                m_currentDebugLine.lineEnd == line.lineEnd)
+            {
+                return nullptr;
+            }
+            m_currentDebugLine = line;
+        }
+
         return emitOpDebugLine(
             parent,
             debugLine,
@@ -7072,7 +7223,8 @@ struct SPIRVEmitContext : public SourceEmitterBase, public SPIRVEmitSharedContex
         // First we need to check if the debug variable has a backing ordinary
         // variable. If it doesn't, we can't emit a store.
         //
-        List<IRInst*> irAccessChain;
+        PooledList<IRInst> pooledIRAccessChain;
+        auto& irAccessChain = *pooledIRAccessChain;
         auto rootVar = getRootAddr(debugValue->getDebugVar(), irAccessChain);
         SpvInst* spvDebugVar = nullptr;
         if (!m_mapIRInstToSpvInst.tryGetValue(rootVar, spvDebugVar))
@@ -7090,7 +7242,8 @@ struct SPIRVEmitContext : public SourceEmitterBase, public SPIRVEmitSharedContex
             // isn't static.
             //
             auto type = unwrapAttributedType(debugValue->getDebugVar()->getDataType());
-            List<SpvInst*> accessChain;
+            PooledList<SpvInst> pooledAccessChain;
+            auto& accessChain = *pooledAccessChain;
             bool isConstAccessChain =
                 translateIRAccessChain(builder, type, irAccessChain, accessChain);
 
@@ -7136,6 +7289,21 @@ struct SPIRVEmitContext : public SourceEmitterBase, public SPIRVEmitSharedContex
     }
 
     Dictionary<IRType*, SpvInst*> m_mapTypeToDebugType;
+
+    struct DebugPointerTypeKey
+    {
+        SpvInst* baseType = nullptr;
+        SpvStorageClass storageClass = SpvStorageClassFunction;
+        bool operator==(const DebugPointerTypeKey& other) const
+        {
+            return baseType == other.baseType && storageClass == other.storageClass;
+        }
+        HashCode getHashCode() const
+        {
+            return combineHash(Slang::getHashCode(baseType), Slang::getHashCode(storageClass));
+        }
+    };
+    Dictionary<DebugPointerTypeKey, SpvInst*> m_debugPointerTypes;
     HashSet<IRType*> m_emittingTypes; // Types that are being emitted.
     Dictionary<IRType*, SpvInst*> m_mapForwardRefsToDebugType;
     static constexpr const int kUnknownPhysicalLayout = 1 << 17;
@@ -7382,7 +7550,15 @@ struct SPIRVEmitContext : public SourceEmitterBase, public SPIRVEmitSharedContex
             if (ptrType->hasAddressSpace())
                 storageClass = addressSpaceToStorageClass(ptrType->getAddressSpace());
 
-            return emitOpDebugTypePointer(
+            // Pointer, reference, `out` and `inout` types of the same value type are all
+            // described by the same `DebugTypePointer`.
+            DebugPointerTypeKey key;
+            key.baseType = debugBaseType;
+            key.storageClass = storageClass;
+            if (auto found = m_debugPointerTypes.tryGetValue(key))
+                return *found;
+
+            auto result = emitOpDebugTypePointer(
                 getSection(SpvLogicalSectionID::ConstantsAndTypes),
                 nullptr,
                 m_voidType,
@@ -7390,6 +7566,8 @@ struct SPIRVEmitContext : public SourceEmitterBase, public SPIRVEmitSharedContex
                 debugBaseType,
                 builder.getIntValue(builder.getUIntType(), storageClass),
                 builder.getIntValue(builder.getUIntType(), kUnknownPhysicalLayout));
+            m_debugPointerTypes[key] = result;
+            return result;
         }
         return ensureInst(m_voidType);
     }
@@ -7944,7 +8122,9 @@ struct SPIRVEmitContext : public SourceEmitterBase, public SPIRVEmitSharedContex
     }
 
     SPIRVEmitContext(IRModule* module, TargetProgram* program, DiagnosticSink* sink)
-        : SPIRVEmitSharedContext(module, program, sink), m_irModule(module), m_memoryArena(2048)
+        : SPIRVEmitSharedContext(module, program, sink)
+        , m_irModule(module)
+        , m_memoryArena(kMemoryArenaBlockSize)
     {
     }
 };
@@ -7955,6 +8135,7 @@ SlangResult emitSPIRVFromIR(
     const List<IRFunc*>& irEntryPoints,
     List<uint8_t>& spirvOut)
 {
+    SLANG_PROFILE;
     spirvOut.clear();
 
     auto sink = codeGenContext->getSink();
@@ -8063,11 +8244,7 @@ SlangResult emitSPIRVFromIR(
 
     context.emitFrontMatter();
 
-    context.emitPhysicalLayout();
-
-    spirvOut.addRange(
-        (uint8_t const*)context.m_words.getBuffer(),
-        context.m_words.getCount() * Index(sizeof(context.m_words[0])));
+    context.emitPhysicalLayout(spirvOut);
 
     return SLANG_OK;
 }
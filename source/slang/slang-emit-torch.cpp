@@ -229,6 +229,22 @@ void TorchCppSourceEmitter::emitModuleImpl(IRModule* module, DiagnosticSink* sin
         m_writer->emit(", ");
         emitStringLiteral(decor->getFunctionName());
         m_writer->emit(");\n");
+
+        // Functions that take arguments also get a `_batched` version, which takes a list of
+        // argument tuples and makes all of the calls from C++.
+        if (func->getParamCount() == 0)
+            continue;
+        StringBuilder batchedName;
+        batchedName << decor->getFunctionName() << "_batched";
+        m_writer->emit("m.def(");
+        emitStringLiteral(batchedName);
+        m_writer->emit(", &SlangTorchBatched<decltype(&");
+        m_writer->emit(decor->getFunctionName());
+        m_writer->emit(")>::call<&");
+        m_writer->emit(decor->getFunctionName());
+        m_writer->emit(">, ");
+        emitStringLiteral(batchedName);
+        m_writer->emit(");\n");
     }
     m_writer->dedent();
     m_writer->emit("}\n");
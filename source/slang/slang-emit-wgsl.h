@@ -11,6 +11,11 @@ public:
     WGSLSourceEmitter(const Desc& desc)
         : CLikeSourceEmitter(desc)
     {
+        if (getTargetProgram()->getOptionSet().getBoolOption(CompilerOptionName::CompactWGSL))
+        {
+            m_useCompactNames = true;
+            m_writer->setIsCompact(true);
+        }
     }
 
     virtual void emitParameterGroupImpl(IRGlobalParam* varDecl, IRUniformParameterGroupType* type)
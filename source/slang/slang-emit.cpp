@@ -47,6 +47,7 @@
 #include "slang-ir-glsl-liveness.h"
 #include "slang-ir-hlsl-legalize.h"
 #include "slang-ir-inline.h"
+#include "slang-ir-instrument-timing.h"
 #include "slang-ir-insts.h"
 #include "slang-ir-layout.h"
 #include "slang-ir-legalize-array-return-type.h"
@@ -70,9 +71,11 @@
 #include "slang-ir-lower-reinterpret.h"
 #include "slang-ir-lower-result-type.h"
 #include "slang-ir-lower-tuple-types.h"
+#include "slang-ir-merge-identical-functions.h"
 #include "slang-ir-metadata.h"
 #include "slang-ir-metal-legalize.h"
 #include "slang-ir-optix-entry-point-uniforms.h"
+#include "slang-ir-pass-stats.h"
 #include "slang-ir-pytorch-cpp-binding.h"
 #include "slang-ir-redundancy-removal.h"
 #include "slang-ir-resolve-texture-format.h"
@@ -80,11 +83,13 @@
 #include "slang-ir-restructure.h"
 #include "slang-ir-sccp.h"
 #include "slang-ir-simplify-for-emit.h"
+#include "slang-ir-sink-insts.h"
 #include "slang-ir-specialize-arrays.h"
 #include "slang-ir-specialize-buffer-load-arg.h"
 #include "slang-ir-specialize-matrix-layout.h"
 #include "slang-ir-specialize-resources.h"
 #include "slang-ir-specialize.h"
+#include "slang-ir-sroa.h"
 #include "slang-ir-ssa-simplification.h"
 #include "slang-ir-ssa.h"
 #include "slang-ir-string-hash.h"
@@ -98,6 +103,7 @@
 #include "slang-ir-user-type-hint.h"
 #include "slang-ir-validate.h"
 #include "slang-ir-variable-scope-correction.h"
+#include "slang-ir-vectorize.h"
 #include "slang-ir-vk-invert-y.h"
 #include "slang-ir-wgsl-legalize.h"
 #include "slang-ir-wrap-structured-buffers.h"
@@ -315,6 +321,8 @@ struct RequiredLoweringPassSet
     bool glslSSBO;
     bool byteAddressBuffer;
     bool dynamicResource;
+    bool staticAssert;
+    bool rttiObjects;
 };
 
 // Scan the IR module and determine which lowering/legalization passes are needed based
@@ -424,6 +432,19 @@ void calcRequiredLoweringPassSet(
     case kIROp_DynamicResourceType:
         result.dynamicResource = true;
         break;
+    case kIROp_StaticAssert:
+        result.staticAssert = true;
+        break;
+    case kIROp_RTTIType:
+    case kIROp_RTTIHandleType:
+    case kIROp_RTTIObject:
+    case kIROp_WitnessTableIDType:
+    case kIROp_IsType:
+    case kIROp_AnyValueType:
+    case kIROp_PackAnyValue:
+    case kIROp_UnpackAnyValue:
+        result.rttiObjects = true;
+        break;
     }
     if (!result.generics || !result.existentialTypeLayout)
     {
@@ -544,12 +565,48 @@ static void unexportNonEmbeddableIR(CodeGenTarget target, IRModule* irModule)
     }
 }
 
-Result linkAndOptimizeIR(
+// Rebuild the module of `linkedIR` into a fresh memory arena to release the memory
+// of removed instructions (see `IRModule::compactMemory`), keeping the instructions
+// referenced from `linkedIR` and `irEntryPoints` valid.
+static void compactLinkedIRModule(LinkedIR& linkedIR, List<IRFunc*>& irEntryPoints)
+{
+    List<IRInst*> externalInsts;
+    externalInsts.add(linkedIR.globalScopeVarLayout);
+    for (auto entryPoint : linkedIR.entryPoints)
+        externalInsts.add(entryPoint);
+    for (auto entryPoint : irEntryPoints)
+        externalInsts.add(entryPoint);
+
+    if (!linkedIR.module->compactMemory(externalInsts))
+        return;
+
+    Index index = 0;
+    linkedIR.globalScopeVarLayout = static_cast<IRVarLayout*>(externalInsts[index++]);
+    for (auto& entryPoint : linkedIR.entryPoints)
+        entryPoint = static_cast<IRFunc*>(externalInsts[index++]);
+    for (auto& entryPoint : irEntryPoints)
+        entryPoint = static_cast<IRFunc*>(externalInsts[index++]);
+}
+
+// Run the IR pass `passFunc(...)` over `irModule`, recording statistics about it into
+// `passStats` (if not null) and adding it to the compile trace (if tracing is enabled).
+//
+// The call evaluates to the result of the pass, so it can be used wherever the direct
+// call could be. Before the pass runs the compile is aborted if it has been cancelled,
+// and the IR left by the previous pass is checked against `instBudget` (if not null).
+#define SLANG_PASS(passFunc, ...)                                                   \
+    (codeGenContext->checkForCancellation(),                                        \
+     instBudget ? instBudget->checkBeforePass(irModule, #passFunc) : (void)0,       \
+     (void)IRPassStatsScope(passStats, irModule, #passFunc),                        \
+     passFunc(__VA_ARGS__))
+
+static Result _linkAndOptimizeIR(
     CodeGenContext* codeGenContext,
     LinkingAndOptimizationOptions const& options,
+    IRPassStatsRecorder* passStats,
+    IRInstBudget* instBudget,
     LinkedIR& outLinkedIR)
 {
-    SLANG_PROFILE;
     auto session = codeGenContext->getSession();
     auto sink = codeGenContext->getSink();
     auto target = codeGenContext->getTargetFormat();
@@ -577,6 +634,12 @@ Result linkAndOptimizeIR(
 
     validateIRModuleIfEnabled(codeGenContext, irModule);
 
+    // When the generated code should contain neither names nor debug information, they
+    // are removed right after linking, so that the rest of code generation doesn't spend
+    // time carrying them along.
+    if (targetProgram->getOptionSet().getBoolOption(CompilerOptionName::StripNamesAndDebugInfo))
+        SLANG_PASS(stripNamesAndDebugInfo, irModule);
+
     // If the user specified the flag that they want us to dump
     // IR, then do it here, for the target-specific, but
     // un-specialized IR.
@@ -586,15 +649,25 @@ Result linkAndOptimizeIR(
     RequiredLoweringPassSet requiredLoweringPassSet = {};
     calcRequiredLoweringPassSet(requiredLoweringPassSet, codeGenContext, irModule->getModuleInst());
 
+    // The bodies of functions that an embedded precompiled library already defines are
+    // only going to be removed, so remove them before the rest of the passes spend time
+    // on them. Autodiff and higher order functions may need the bodies until after
+    // specialization, in which case they are removed then.
+    const bool removeAvailableInDownstreamIREarly = codeGenContext->removeAvailableInDownstreamIR &&
+                                                    !requiredLoweringPassSet.autodiff &&
+                                                    !requiredLoweringPassSet.higherOrderFunc;
+    if (removeAvailableInDownstreamIREarly)
+        SLANG_PASS(removeAvailableInDownstreamModuleDecorations, target, irModule);
+
     if (!isKhronosTarget(targetRequest) && requiredLoweringPassSet.glslSSBO)
-        lowerGLSLShaderStorageBufferObjectsToStructuredBuffers(irModule, sink);
+        SLANG_PASS(lowerGLSLShaderStorageBufferObjectsToStructuredBuffers, irModule, sink);
 
     if (requiredLoweringPassSet.glslGlobalVar)
-        translateGLSLGlobalVar(codeGenContext, irModule);
+        SLANG_PASS(translateGLSLGlobalVar, codeGenContext, irModule);
 
     // Replace any global constants with their values.
     //
-    replaceGlobalConstants(irModule);
+    SLANG_PASS(replaceGlobalConstants, irModule);
 #if 0
     dumpIRIfEnabled(codeGenContext, irModule, "GLOBAL CONSTANTS REPLACED");
 #endif
@@ -609,7 +682,7 @@ Result linkAndOptimizeIR(
     // use sites.
     //
     if (requiredLoweringPassSet.bindExistential)
-        bindExistentialSlots(irModule, sink);
+        SLANG_PASS(bindExistentialSlots, irModule, sink);
 #if 0
     dumpIRIfEnabled(codeGenContext, irModule, "EXISTENTIALS BOUND");
 #endif
@@ -633,7 +706,7 @@ Result linkAndOptimizeIR(
     // can assume that all ordinary/uniform data is strictly
     // passed using constant buffers.
     //
-    collectGlobalUniformParameters(irModule, outLinkedIR.globalScopeVarLayout);
+    SLANG_PASS(collectGlobalUniformParameters, irModule, outLinkedIR.globalScopeVarLayout);
 #if 0
     dumpIRIfEnabled(codeGenContext, irModule, "GLOBAL UNIFORMS COLLECTED");
 #endif
@@ -655,7 +728,7 @@ Result linkAndOptimizeIR(
         case CodeGenTarget::HostCPPSource:
             break;
         case CodeGenTarget::CUDASource:
-            collectOptiXEntryPointUniformParams(irModule);
+            SLANG_PASS(collectOptiXEntryPointUniformParams, irModule);
 #if 0
             dumpIRIfEnabled(codeGenContext, irModule, "OPTIX ENTRY POINT UNIFORMS COLLECTED");
 #endif
@@ -666,7 +739,7 @@ Result linkAndOptimizeIR(
             passOptions.alwaysCreateCollectedParam = true;
             [[fallthrough]];
         default:
-            collectEntryPointUniformParams(irModule, passOptions);
+            SLANG_PASS(collectEntryPointUniformParams, irModule, passOptions);
 #if 0
             dumpIRIfEnabled(codeGenContext, irModule, "ENTRY POINT UNIFORMS COLLECTED");
 #endif
@@ -678,7 +751,7 @@ Result linkAndOptimizeIR(
     switch (target)
     {
     default:
-        moveEntryPointUniformParamsToGlobalScope(irModule);
+        SLANG_PASS(moveEntryPointUniformParamsToGlobalScope, irModule);
 #if 0
         dumpIRIfEnabled(codeGenContext, irModule, "ENTRY POINT UNIFORMS MOVED");
 #endif
@@ -691,7 +764,7 @@ Result linkAndOptimizeIR(
     }
 
     if (requiredLoweringPassSet.optionalType)
-        lowerOptionalType(irModule, sink);
+        SLANG_PASS(lowerOptionalType, irModule, sink);
 
     switch (target)
     {
@@ -700,7 +773,7 @@ Result linkAndOptimizeIR(
         break;
 
     default:
-        removeTorchAndCUDAEntryPoints(irModule);
+        SLANG_PASS(removeTorchAndCUDAEntryPoints, irModule);
         break;
     }
 
@@ -709,9 +782,9 @@ Result linkAndOptimizeIR(
     case CodeGenTarget::CPPSource:
     case CodeGenTarget::HostCPPSource:
         {
-            lowerComInterfaces(irModule, artifactDesc.style, sink);
-            generateDllImportFuncs(codeGenContext->getTargetProgram(), irModule, sink);
-            generateDllExportFuncs(irModule, sink);
+            SLANG_PASS(lowerComInterfaces, irModule, artifactDesc.style, sink);
+            SLANG_PASS(generateDllImportFuncs, codeGenContext->getTargetProgram(), irModule, sink);
+            SLANG_PASS(generateDllExportFuncs, irModule, sink);
             break;
         }
     default:
@@ -720,7 +793,7 @@ Result linkAndOptimizeIR(
 
     // Lower `Result<T,E>` types into ordinary struct types.
     if (requiredLoweringPassSet.resultType)
-        lowerResultType(irModule, sink);
+        SLANG_PASS(lowerResultType, irModule, sink);
 
 #if 0
     dumpIRIfEnabled(codeGenContext, irModule, "UNIONS DESUGARED");
@@ -728,7 +801,7 @@ Result linkAndOptimizeIR(
     validateIRModuleIfEnabled(codeGenContext, irModule);
 
     // Lower all the LValue implict casts (used for out/inout/ref scenarios)
-    lowerLValueCast(targetProgram, irModule);
+    SLANG_PASS(lowerLValueCast, targetProgram, irModule);
 
     IRSimplificationOptions defaultIRSimplificationOptions =
         IRSimplificationOptions::getDefault(targetProgram);
@@ -741,23 +814,23 @@ Result linkAndOptimizeIR(
     deadCodeEliminationOptions.keepGlobalParamsAlive =
         targetProgram->getOptionSet().getBoolOption(CompilerOptionName::PreserveParameters);
 
-    simplifyIR(targetProgram, irModule, defaultIRSimplificationOptions, sink);
+    SLANG_PASS(simplifyIR, targetProgram, irModule, defaultIRSimplificationOptions, sink);
 
     if (targetProgram->getOptionSet().getBoolOption(CompilerOptionName::ValidateUniformity))
     {
-        validateUniformity(irModule, sink);
+        SLANG_PASS(validateUniformity, irModule, sink);
         if (sink->getErrorCount() != 0)
             return SLANG_FAIL;
     }
 
     // Fill in default matrix layout into matrix types that left layout unspecified.
-    specializeMatrixLayout(targetProgram, irModule);
+    SLANG_PASS(specializeMatrixLayout, targetProgram, irModule);
 
     // It's important that this takes place before defunctionalization as we
     // want to be able to easily discover the cooperate and fallback funcitons
     // being passed to saturated_cooperation
     if (!targetProgram->getOptionSet().shouldPerformMinimumOptimizations())
-        fuseCallsToSaturatedCooperation(irModule);
+        SLANG_PASS(fuseCallsToSaturatedCooperation, irModule);
 
     switch (target)
     {
@@ -766,7 +839,7 @@ Result linkAndOptimizeIR(
         {
             // Generate any requested derivative wrappers
             if (requiredLoweringPassSet.derivativePyBindWrapper)
-                generateDerivativeWrappers(irModule, sink);
+                SLANG_PASS(generateDerivativeWrappers, irModule, sink);
             break;
         }
     default:
@@ -776,7 +849,7 @@ Result linkAndOptimizeIR(
     if (requiredLoweringPassSet.autodiff)
     {
         // Generate warnings for potentially incorrect or badly-performing autodiff patterns.
-        checkAutodiffPatterns(targetProgram, irModule, sink);
+        SLANG_PASS(checkAutodiffPatterns, targetProgram, irModule, sink);
     }
 
     // Next, we need to ensure that the code we emit for
@@ -805,28 +878,39 @@ Result linkAndOptimizeIR(
         bool changed = false;
         dumpIRIfEnabled(codeGenContext, irModule, "BEFORE-SPECIALIZE");
         if (!codeGenContext->isSpecializationDisabled())
-            changed |= specializeModule(targetProgram, irModule, codeGenContext->getSink());
+            changed |= SLANG_PASS(
+                specializeModule,
+                targetProgram,
+                irModule,
+                codeGenContext->getSink());
         if (codeGenContext->getSink()->getErrorCount() != 0)
             return SLANG_FAIL;
         dumpIRIfEnabled(codeGenContext, irModule, "AFTER-SPECIALIZE");
 
         if (changed)
         {
-            applySparseConditionalConstantPropagation(irModule, codeGenContext->getSink());
+            SLANG_PASS(
+                applySparseConditionalConstantPropagation,
+                irModule,
+                codeGenContext->getSink());
         }
         validateIRModuleIfEnabled(codeGenContext, irModule);
 
         // Inline calls to any functions marked with [__unsafeInlineEarly] again,
         // since we may be missing out cases prevented by the functions that we just specialzied.
-        performMandatoryEarlyInlining(irModule);
-        eliminateDeadCode(irModule, deadCodeEliminationOptions);
+        SLANG_PASS(performMandatoryEarlyInlining, irModule);
+        SLANG_PASS(eliminateDeadCode, irModule, deadCodeEliminationOptions);
 
         // Unroll loops.
         if (!fastIRSimplificationOptions.minimalOptimization)
         {
             if (codeGenContext->getSink()->getErrorCount() == 0)
             {
-                if (!unrollLoopsInModule(targetProgram, irModule, codeGenContext->getSink()))
+                if (!SLANG_PASS(
+                        unrollLoopsInModule,
+                        targetProgram,
+                        irModule,
+                        codeGenContext->getSink()))
                     return SLANG_FAIL;
             }
         }
@@ -837,13 +921,13 @@ Result linkAndOptimizeIR(
         // Specialize away these parameters
         // TODO: We should implement a proper defunctionalization pass
         if (requiredLoweringPassSet.higherOrderFunc)
-            changed |= specializeHigherOrderParameters(codeGenContext, irModule);
+            changed |= SLANG_PASS(specializeHigherOrderParameters, codeGenContext, irModule);
 
         if (requiredLoweringPassSet.autodiff)
         {
             dumpIRIfEnabled(codeGenContext, irModule, "BEFORE-AUTODIFF");
             enableIRValidationAtInsert();
-            changed |= processAutodiffCalls(targetProgram, irModule, sink);
+            changed |= SLANG_PASS(processAutodiffCalls, targetProgram, irModule, sink);
             disableIRValidationAtInsert();
             dumpIRIfEnabled(codeGenContext, irModule, "AFTER-AUTODIFF");
         }
@@ -859,9 +943,9 @@ Result linkAndOptimizeIR(
     // Finalization is always run so AD-related instructions can be removed,
     // even the AD pass itself is not run.
     //
-    finalizeAutoDiffPass(targetProgram, irModule);
+    SLANG_PASS(finalizeAutoDiffPass, targetProgram, irModule);
 
-    finalizeSpecialization(irModule);
+    SLANG_PASS(finalizeSpecialization, irModule);
 
     requiredLoweringPassSet = {};
     calcRequiredLoweringPassSet(requiredLoweringPassSet, codeGenContext, irModule->getModuleInst());
@@ -869,34 +953,34 @@ Result linkAndOptimizeIR(
     switch (target)
     {
     case CodeGenTarget::PyTorchCppBinding:
-        generateHostFunctionsForAutoBindCuda(irModule, sink);
-        lowerBuiltinTypesForKernelEntryPoints(irModule, sink);
-        generatePyTorchCppBinding(irModule, sink);
-        handleAutoBindNames(irModule);
+        SLANG_PASS(generateHostFunctionsForAutoBindCuda, irModule, sink);
+        SLANG_PASS(lowerBuiltinTypesForKernelEntryPoints, irModule, sink);
+        SLANG_PASS(generatePyTorchCppBinding, irModule, sink);
+        SLANG_PASS(handleAutoBindNames, irModule);
         break;
     case CodeGenTarget::CUDASource:
-        lowerBuiltinTypesForKernelEntryPoints(irModule, sink);
-        removeTorchKernels(irModule);
-        handleAutoBindNames(irModule);
+        SLANG_PASS(lowerBuiltinTypesForKernelEntryPoints, irModule, sink);
+        SLANG_PASS(removeTorchKernels, irModule);
+        SLANG_PASS(handleAutoBindNames, irModule);
         break;
     default:
         break;
     }
 
-    if (codeGenContext->removeAvailableInDownstreamIR)
+    if (codeGenContext->removeAvailableInDownstreamIR && !removeAvailableInDownstreamIREarly)
     {
-        removeAvailableInDownstreamModuleDecorations(target, irModule);
+        SLANG_PASS(removeAvailableInDownstreamModuleDecorations, target, irModule);
     }
 
     if (targetProgram->getOptionSet().shouldRunNonEssentialValidation())
     {
-        checkForRecursiveTypes(irModule, sink);
-        checkForRecursiveFunctions(codeGenContext->getTargetReq(), irModule, sink);
+        SLANG_PASS(checkForRecursiveTypes, irModule, sink);
+        SLANG_PASS(checkForRecursiveFunctions, codeGenContext->getTargetReq(), irModule, sink);
 
         // For some targets, we are more restrictive about what types are allowed
         // to be used as shader parameters in ConstantBuffer/ParameterBlock.
         // We will check for these restrictions here.
-        checkForInvalidShaderParameterType(targetRequest, irModule, sink);
+        SLANG_PASS(checkForInvalidShaderParameterType, targetRequest, irModule, sink);
     }
 
     if (sink->getErrorCount() != 0)
@@ -909,11 +993,11 @@ Result linkAndOptimizeIR(
     {
         // We could fail because
         // 1) It's not inlinable for some reason (for example if it's recursive)
-        SLANG_RETURN_ON_FAIL(performTypeInlining(irModule, sink));
+        SLANG_RETURN_ON_FAIL(SLANG_PASS(performTypeInlining, irModule, sink));
     }
 
     if (requiredLoweringPassSet.reinterpret)
-        lowerReinterpret(targetProgram, irModule, sink);
+        SLANG_PASS(lowerReinterpret, targetProgram, irModule, sink);
 
     if (sink->getErrorCount() != 0)
         return SLANG_FAIL;
@@ -923,15 +1007,15 @@ Result linkAndOptimizeIR(
     // If we have any witness tables that are marked as `KeepAlive`,
     // but are not used for dynamic dispatch, unpin them so we don't
     // do unnecessary work to lower them.
-    unpinWitnessTables(irModule);
+    SLANG_PASS(unpinWitnessTables, irModule);
 
     if (!fastIRSimplificationOptions.minimalOptimization)
     {
-        simplifyIR(targetProgram, irModule, fastIRSimplificationOptions, sink);
+        SLANG_PASS(simplifyIR, targetProgram, irModule, fastIRSimplificationOptions, sink);
     }
     else if (requiredLoweringPassSet.generics)
     {
-        eliminateDeadCode(irModule, fastIRSimplificationOptions.deadCodeElimOptions);
+        SLANG_PASS(eliminateDeadCode, irModule, fastIRSimplificationOptions.deadCodeElimOptions);
     }
 
     if (!ArtifactDescUtil::isCpuLikeTarget(artifactDesc) &&
@@ -939,7 +1023,7 @@ Result linkAndOptimizeIR(
     {
         // We could fail because (perhaps, somehow) end up with getStringHash that the operand is
         // not a string literal
-        SLANG_RETURN_ON_FAIL(checkGetStringHashInsts(irModule, sink));
+        SLANG_RETURN_ON_FAIL(SLANG_PASS(checkGetStringHashInsts, irModule, sink));
     }
 
     // For targets that supports dynamic dispatch, we need to lower the
@@ -947,9 +1031,15 @@ Result linkAndOptimizeIR(
     // function pointers.
     dumpIRIfEnabled(codeGenContext, irModule, "BEFORE-LOWER-GENERICS");
     if (requiredLoweringPassSet.generics)
-        lowerGenerics(targetProgram, irModule, sink);
+        SLANG_PASS(lowerGenerics, targetProgram, irModule, sink);
+    else if (requiredLoweringPassSet.rttiObjects)
+        SLANG_PASS(cleanupGenerics, targetProgram, irModule, sink);
     else
-        cleanupGenerics(targetProgram, irModule, sink);
+    {
+        // Without interfaces, existentials or RTTI objects left after specialization,
+        // the only part of generic cleanup that can have any work to do is tuple lowering.
+        SLANG_PASS(lowerTuples, irModule, sink);
+    }
     dumpIRIfEnabled(codeGenContext, irModule, "AFTER-LOWER-GENERICS");
 
     if (sink->getErrorCount() != 0)
@@ -960,12 +1050,33 @@ Result linkAndOptimizeIR(
     validateIRModuleIfEnabled(codeGenContext, irModule);
 
     // Inline calls to any functions marked with [__unsafeInlineEarly] or [ForceInline].
-    performForceInlining(irModule);
+    SLANG_PASS(performForceInlining, irModule);
+
+    // The atomics in the core module's functions are only in their callers, where their
+    // address may be uniform, once they are inlined.
+    if (targetProgram->getOptionSet().getBoolOption(CompilerOptionName::AggregateUniformAtomics))
+        SLANG_PASS(aggregateUniformAtomics, irModule, sink);
+
+    // Functions are instrumented once those marked `[ForceInline]` are gone, so that their
+    // time is counted in their callers.
+    List<InstrumentedFunction> instrumentedFunctions;
+    if (targetProgram->getOptionSet().hasOption(CompilerOptionName::InstrumentTiming))
+    {
+        auto bufferName =
+            targetProgram->getOptionSet().getStringOption(CompilerOptionName::InstrumentTiming);
+        SLANG_PASS(
+            instrumentFunctionTiming,
+            irModule,
+            bufferName.getUnownedSlice(),
+            codeGenContext->getSourceManager(),
+            instrumentedFunctions,
+            sink);
+    }
 
     // Push `structuredBufferLoad` to the end of access chain to avoid loading unnecessary data.
     if (isKhronosTarget(targetRequest) || isMetalTarget(targetRequest) ||
         isWGPUTarget(targetRequest))
-        deferBufferLoad(irModule);
+        SLANG_PASS(deferBufferLoad, irModule);
 
     // Specialization can introduce dead code that could trip
     // up downstream passes like type legalization, so we
@@ -973,13 +1084,30 @@ Result linkAndOptimizeIR(
     //
     if (fastIRSimplificationOptions.minimalOptimization)
     {
-        eliminateDeadCode(irModule, deadCodeEliminationOptions);
+        SLANG_PASS(eliminateDeadCode, irModule, deadCodeEliminationOptions);
     }
     else
     {
-        simplifyIR(targetProgram, irModule, defaultIRSimplificationOptions, sink);
+        SLANG_PASS(simplifyIR, targetProgram, irModule, defaultIRSimplificationOptions, sink);
+
+        // The downstream compilers for these targets are given the calls between the functions
+        // we emit, and don't always inline the small helpers that specialization leaves behind.
+        // At higher optimization levels, inline those that are likely to pay off here, where
+        // the simplifications that follow can specialize them to their call sites.
+        const auto optimizationLevel = targetProgram->getOptionSet().getOptimizationLevel();
+        if ((optimizationLevel == OptimizationLevel::High ||
+             optimizationLevel == OptimizationLevel::Maximal) &&
+            (isCPUTarget(targetRequest) || isCUDATarget(targetRequest) ||
+             isMetalTarget(targetRequest)))
+        {
+            SLANG_PASS(performCostModelInlining, irModule);
+        }
     }
 
+    // Specialization, inlining and DCE leave most of the module's memory arena holding
+    // instructions that have been removed, so this is a good point to release it.
+    SLANG_PASS(compactLinkedIRModule, outLinkedIR, irEntryPoints);
+
     validateIRModuleIfEnabled(codeGenContext, irModule);
 
     // On non-HLSL targets, there isn't an implementation of `AppendStructuredBuffer`
@@ -987,7 +1115,7 @@ Result linkAndOptimizeIR(
     // of `RWStructuredBuffer` typed fields now.
     if (target != CodeGenTarget::HLSL)
     {
-        lowerAppendConsumeStructuredBuffers(targetProgram, irModule, sink);
+        SLANG_PASS(lowerAppendConsumeStructuredBuffers, targetProgram, irModule, sink);
     }
 
     switch (target)
@@ -1002,14 +1130,14 @@ Result linkAndOptimizeIR(
     case CodeGenTarget::MetalLibAssembly:
     case CodeGenTarget::WGSL:
         if (requiredLoweringPassSet.combinedTextureSamplers)
-            lowerCombinedTextureSamplers(codeGenContext, irModule, sink);
+            SLANG_PASS(lowerCombinedTextureSamplers, codeGenContext, irModule, sink);
         break;
     }
 
     if (codeGenContext->getTargetProgram()->getOptionSet().getBoolOption(
             CompilerOptionName::VulkanEmitReflection))
     {
-        addUserTypeHintDecorations(irModule);
+        SLANG_PASS(addUserTypeHintDecorations, irModule);
     }
 
     // We don't need the legalize pass for C/C++ based types
@@ -1042,7 +1170,7 @@ Result linkAndOptimizeIR(
         //
         if (requiredLoweringPassSet.existentialTypeLayout)
         {
-            legalizeExistentialTypeLayout(targetProgram, irModule, sink);
+            SLANG_PASS(legalizeExistentialTypeLayout, targetProgram, irModule, sink);
         }
 
 #if 0
@@ -1061,7 +1189,7 @@ Result linkAndOptimizeIR(
         // What used to be individual variables/parameters/arguments/etc.
         // then become multiple variables/parameters/arguments/etc.
         //
-        legalizeResourceTypes(targetProgram, irModule, sink);
+        SLANG_PASS(legalizeResourceTypes, targetProgram, irModule, sink);
 
         //  Debugging output of legalization
 #if 0
@@ -1073,10 +1201,10 @@ Result linkAndOptimizeIR(
     {
         // On CPU/CUDA targets, we simply elminate any empty types if
         // they are not part of public interface.
-        legalizeEmptyTypes(targetProgram, irModule, sink);
+        SLANG_PASS(legalizeEmptyTypes, targetProgram, irModule, sink);
     }
 
-    legalizeVectorTypes(irModule, sink);
+    SLANG_PASS(legalizeVectorTypes, irModule, sink);
 
     // Once specialization and type legalization have been performed,
     // we should perform some of our basic optimization steps again,
@@ -1084,9 +1212,9 @@ Result linkAndOptimizeIR(
     // (e.g., things that used to be aggregated might now be split up,
     // so that we can work with the individual fields).
     if (fastIRSimplificationOptions.minimalOptimization)
-        eliminateDeadCode(irModule, deadCodeEliminationOptions);
+        SLANG_PASS(eliminateDeadCode, irModule, deadCodeEliminationOptions);
     else
-        simplifyIR(targetProgram, irModule, fastIRSimplificationOptions, sink);
+        SLANG_PASS(simplifyIR, targetProgram, irModule, fastIRSimplificationOptions, sink);
 
 #if 0
     dumpIRIfEnabled(codeGenContext, irModule, "AFTER SSA");
@@ -1102,8 +1230,8 @@ Result linkAndOptimizeIR(
     // resource types can be used, so that having them as
     // function parameters, reults, etc. is invalid.
     // We clean up the usages of resource values here.
-    specializeResourceUsage(codeGenContext, irModule);
-    specializeFuncsForBufferLoadArgs(codeGenContext, irModule);
+    SLANG_PASS(specializeResourceUsage, codeGenContext, irModule);
+    SLANG_PASS(specializeFuncsForBufferLoadArgs, codeGenContext, irModule);
 
     // We also want to specialize calls to functions that
     // takes unsized array parameters if possible.
@@ -1111,7 +1239,7 @@ Result linkAndOptimizeIR(
     // that takes arrays/structs containing arrays as parameters with the actual
     // global array object to avoid loading big arrays into SSA registers, which seems
     // to cause performance issues.
-    specializeArrayParameters(codeGenContext, irModule);
+    SLANG_PASS(specializeArrayParameters, codeGenContext, irModule);
 
 #if 0
     dumpIRIfEnabled(codeGenContext, irModule, "AFTER RESOURCE SPECIALIZATION");
@@ -1121,7 +1249,8 @@ Result linkAndOptimizeIR(
 
     // Process `static_assert` after the specialization is done.
     // Some information for `static_assert` is available only after the specialization.
-    checkStaticAssert(irModule->getModuleInst(), sink);
+    if (requiredLoweringPassSet.staticAssert)
+        SLANG_PASS(checkStaticAssert, irModule->getModuleInst(), sink);
 
     // For HLSL (and fxc/dxc) only, we need to "wrap" any
     // structured buffers defined over matrix types so
@@ -1134,7 +1263,7 @@ Result linkAndOptimizeIR(
     {
     case CodeGenTarget::HLSL:
         {
-            wrapStructuredBuffersOfMatrices(irModule);
+            SLANG_PASS(wrapStructuredBuffersOfMatrices, irModule);
 #if 0
             dumpIRIfEnabled(codeGenContext, irModule, "STRUCTURED BUFFERS WRAPPED");
 #endif
@@ -1250,7 +1379,19 @@ Result linkAndOptimizeIR(
             break;
         }
 
-        legalizeByteAddressBufferOps(
+        // At higher optimization levels, adjacent scalar fields of a structure
+        // are loaded and stored together as vectors when their alignment allows it,
+        // which cuts down the number of memory operations for large structures.
+        //
+        {
+            const auto optimizationLevel = targetProgram->getOptionSet().getOptimizationLevel();
+            if (optimizationLevel == OptimizationLevel::High ||
+                optimizationLevel == OptimizationLevel::Maximal)
+                byteAddressBufferOptions.coalesceFieldLoadStore = true;
+        }
+
+        SLANG_PASS(
+            legalizeByteAddressBufferOps,
             session,
             targetProgram,
             irModule,
@@ -1267,7 +1408,7 @@ Result linkAndOptimizeIR(
     case CodeGenTarget::CUDASource:
     case CodeGenTarget::PTX:
         {
-            synthesizeActiveMask(irModule, codeGenContext->getSink());
+            SLANG_PASS(synthesizeActiveMask, irModule, codeGenContext->getSink());
 
 #if 0
             dumpIRIfEnabled(codeGenContext, irModule, "AFTER synthesizeActiveMask");
@@ -1285,7 +1426,7 @@ Result linkAndOptimizeIR(
     case CodeGenTarget::GLSL:
     case CodeGenTarget::SPIRV:
     case CodeGenTarget::WGSL:
-        resolveTextureFormat(irModule);
+        SLANG_PASS(resolveTextureFormat, irModule);
         break;
     }
 
@@ -1312,7 +1453,8 @@ Result linkAndOptimizeIR(
             dumpIRIfEnabled(codeGenContext, irModule, "PRE GLSL LEGALIZED");
 #endif
 
-            legalizeEntryPointsForGLSL(
+            SLANG_PASS(
+                legalizeEntryPointsForGLSL,
                 session,
                 irModule,
                 irEntryPoints,
@@ -1329,19 +1471,19 @@ Result linkAndOptimizeIR(
     case CodeGenTarget::MetalLib:
     case CodeGenTarget::MetalLibAssembly:
         {
-            legalizeIRForMetal(irModule, sink);
+            SLANG_PASS(legalizeIRForMetal, irModule, sink);
         }
         break;
     case CodeGenTarget::CSource:
     case CodeGenTarget::CPPSource:
         {
-            legalizeEntryPointVaryingParamsForCPU(irModule, codeGenContext->getSink());
+            SLANG_PASS(legalizeEntryPointVaryingParamsForCPU, irModule, codeGenContext->getSink());
         }
         break;
 
     case CodeGenTarget::CUDASource:
         {
-            legalizeEntryPointVaryingParamsForCUDA(irModule, codeGenContext->getSink());
+            SLANG_PASS(legalizeEntryPointVaryingParamsForCUDA, irModule, codeGenContext->getSink());
         }
         break;
 
@@ -1349,7 +1491,7 @@ Result linkAndOptimizeIR(
     case CodeGenTarget::WGSLSPIRV:
     case CodeGenTarget::WGSLSPIRVAssembly:
         {
-            legalizeIRForWGSL(irModule, sink);
+            SLANG_PASS(legalizeIRForWGSL, irModule, sink);
         }
         break;
 
@@ -1359,11 +1501,11 @@ Result linkAndOptimizeIR(
 
     // Legalize non struct parameters that are expected to be structs for HLSL.
     if (isD3DTarget(targetRequest))
-        legalizeNonStructParameterToStructForHLSL(irModule);
+        SLANG_PASS(legalizeNonStructParameterToStructForHLSL, irModule);
 
     // Create aliases for all dynamic resource parameters.
     if (requiredLoweringPassSet.dynamicResource && isKhronosTarget(targetRequest))
-        legalizeDynamicResourcesForGLSL(codeGenContext, irModule);
+        SLANG_PASS(legalizeDynamicResourcesForGLSL, codeGenContext, irModule);
 
     // Legalize `ImageSubscript` loads.
     switch (target)
@@ -1375,7 +1517,7 @@ Result linkAndOptimizeIR(
     case CodeGenTarget::SPIRV:
     case CodeGenTarget::SPIRVAssembly:
         {
-            legalizeImageSubscript(targetRequest, irModule, sink);
+            SLANG_PASS(legalizeImageSubscript, targetRequest, irModule, sink);
         }
         break;
     default:
@@ -1389,8 +1531,8 @@ Result linkAndOptimizeIR(
     case CodeGenTarget::SPIRV:
     case CodeGenTarget::SPIRVAssembly:
         {
-            legalizeConstantBufferLoadForGLSL(irModule);
-            legalizeDispatchMeshPayloadForGLSL(irModule);
+            SLANG_PASS(legalizeConstantBufferLoadForGLSL, irModule);
+            SLANG_PASS(legalizeDispatchMeshPayloadForGLSL, irModule);
         }
         break;
     default:
@@ -1402,15 +1544,15 @@ Result linkAndOptimizeIR(
     default:
         break;
     case CodeGenTarget::GLSL:
-        moveGlobalVarInitializationToEntryPoints(irModule);
+        SLANG_PASS(moveGlobalVarInitializationToEntryPoints, irModule);
         break;
     // For SPIR-V to SROA across 2 entry-points a value must not be a global
     case CodeGenTarget::SPIRV:
     case CodeGenTarget::SPIRVAssembly:
-        moveGlobalVarInitializationToEntryPoints(irModule);
+        SLANG_PASS(moveGlobalVarInitializationToEntryPoints, irModule);
         if (targetProgram->getOptionSet().getBoolOption(
                 CompilerOptionName::EnableExperimentalPasses))
-            introduceExplicitGlobalContext(irModule, target);
+            SLANG_PASS(introduceExplicitGlobalContext, irModule, target);
 #if 0
         dumpIRIfEnabled(codeGenContext, irModule, "EXPLICIT GLOBAL CONTEXT INTRODUCED");
 #endif
@@ -1418,11 +1560,11 @@ Result linkAndOptimizeIR(
     case CodeGenTarget::Metal:
     case CodeGenTarget::CPPSource:
     case CodeGenTarget::CUDASource:
-        moveGlobalVarInitializationToEntryPoints(irModule);
-        introduceExplicitGlobalContext(irModule, target);
+        SLANG_PASS(moveGlobalVarInitializationToEntryPoints, irModule);
+        SLANG_PASS(introduceExplicitGlobalContext, irModule, target);
         if (target == CodeGenTarget::CPPSource)
         {
-            convertEntryPointPtrParamsToRawPtrs(irModule);
+            SLANG_PASS(convertEntryPointPtrParamsToRawPtrs, irModule);
         }
 #if 0
         dumpIRIfEnabled(codeGenContext, irModule, "EXPLICIT GLOBAL CONTEXT INTRODUCED");
@@ -1431,12 +1573,12 @@ Result linkAndOptimizeIR(
         break;
     }
 
-    stripCachedDictionaries(irModule);
+    SLANG_PASS(stripCachedDictionaries, irModule);
 
     // TODO: our current dynamic dispatch pass will remove all uses of witness tables.
     // If we are going to support function-pointer based, "real" modular dynamic dispatch,
     // we will need to disable this pass.
-    stripWitnessTables(irModule);
+    SLANG_PASS(stripWitnessTables, irModule);
 
     switch (target)
     {
@@ -1445,7 +1587,7 @@ Result linkAndOptimizeIR(
     //
     case CodeGenTarget::SPIRV:
         if (targetProgram->shouldEmitSPIRVDirectly())
-            removeRawDefaultConstructors(irModule);
+            SLANG_PASS(removeRawDefaultConstructors, irModule);
         break;
     default:
         break;
@@ -1464,26 +1606,27 @@ Result linkAndOptimizeIR(
     //
     // We run DCE pass again to clean things up.
     //
-    eliminateDeadCode(irModule, deadCodeEliminationOptions);
+    SLANG_PASS(eliminateDeadCode, irModule, deadCodeEliminationOptions);
+    SLANG_PASS(compactLinkedIRModule, outLinkedIR, irEntryPoints);
 
     if (isKhronosTarget(targetRequest))
     {
         // As a fallback, if the above specialization steps failed to remove resource type
         // parameters, we will inline the functions in question to make sure we can produce valid
         // GLSL.
-        performGLSLResourceReturnFunctionInlining(targetProgram, irModule);
+        SLANG_PASS(performGLSLResourceReturnFunctionInlining, targetProgram, irModule);
     }
 #if 0
     dumpIRIfEnabled(codeGenContext, irModule, "AFTER DCE");
 #endif
     validateIRModuleIfEnabled(codeGenContext, irModule);
 
-    cleanUpVoidType(irModule);
+    SLANG_PASS(cleanUpVoidType, irModule);
 
     // Lower the `getRegisterIndex` and `getRegisterSpace` intrinsics.
     //
     if (requiredLoweringPassSet.bindingQuery)
-        lowerBindingQueries(irModule, sink);
+        SLANG_PASS(lowerBindingQueries, irModule, sink);
 
     // For some small improvement in type safety we represent these as opaque
     // structs instead of regular arrays.
@@ -1491,48 +1634,79 @@ Result linkAndOptimizeIR(
     // If any have survived this far, change them back to regular (decorated)
     // arrays that the emitters can deal with.
     if (requiredLoweringPassSet.meshOutput)
-        legalizeMeshOutputTypes(irModule);
+        SLANG_PASS(legalizeMeshOutputTypes, irModule);
 
     BufferElementTypeLoweringOptions bufferElementTypeLoweringOptions;
     bufferElementTypeLoweringOptions.use16ByteArrayElementForConstantBuffer =
         isWGPUTarget(targetRequest);
-    lowerBufferElementTypeToStorageType(targetProgram, irModule, bufferElementTypeLoweringOptions);
+    SLANG_PASS(
+        lowerBufferElementTypeToStorageType,
+        targetProgram,
+        irModule,
+        bufferElementTypeLoweringOptions);
 
     // Rewrite functions that return arrays to return them via `out` parameter,
     // since our target languages doesn't allow returning arrays.
     if (!isMetalTarget(targetRequest))
-        legalizeArrayReturnType(irModule);
+        SLANG_PASS(legalizeArrayReturnType, irModule);
 
     if (isKhronosTarget(targetRequest) || target == CodeGenTarget::HLSL)
     {
-        legalizeUniformBufferLoad(irModule);
+        SLANG_PASS(legalizeUniformBufferLoad, irModule);
         if (targetProgram->getOptionSet().getBoolOption(CompilerOptionName::VulkanInvertY))
-            invertYOfPositionOutput(irModule);
+            SLANG_PASS(invertYOfPositionOutput, irModule);
         if (targetProgram->getOptionSet().getBoolOption(CompilerOptionName::VulkanUseDxPositionW))
-            rcpWOfPositionInput(irModule);
+            SLANG_PASS(rcpWOfPositionInput, irModule);
     }
 
     // Lower all bit_cast operations on complex types into leaf-level
     // bit_cast on basic types.
     if (requiredLoweringPassSet.bitcast)
-        lowerBitCast(targetProgram, irModule, sink);
+        SLANG_PASS(lowerBitCast, targetProgram, irModule, sink);
 
     bool emitSpirvDirectly = targetProgram->shouldEmitSPIRVDirectly();
 
     if (emitSpirvDirectly)
     {
-        performIntrinsicFunctionInlining(irModule);
-        eliminateDeadCode(irModule, deadCodeEliminationOptions);
+        SLANG_PASS(performIntrinsicFunctionInlining, irModule);
+        SLANG_PASS(eliminateDeadCode, irModule, deadCodeEliminationOptions);
     }
-    eliminateMultiLevelBreak(irModule);
+    SLANG_PASS(eliminateMultiLevelBreak, irModule);
 
     if (!fastIRSimplificationOptions.minimalOptimization)
     {
         IRSimplificationOptions simplificationOptions = fastIRSimplificationOptions;
         simplificationOptions.cfgOptions.removeTrivialSingleIterationLoops = true;
-        simplifyIR(targetProgram, irModule, simplificationOptions, sink);
+        SLANG_PASS(simplifyIR, targetProgram, irModule, simplificationOptions, sink);
+
+        // Specialization and legalization can leave several copies of the same function,
+        // which only need to be emitted once.
+        SLANG_PASS(mergeIdenticalFunctions, irModule);
+
+        const auto optimizationLevel = targetProgram->getOptionSet().getOptimizationLevel();
+        if (optimizationLevel == OptimizationLevel::High ||
+            optimizationLevel == OptimizationLevel::Maximal)
+        {
+            // Legalization and struct splitting leave operations on vectors done one element at
+            // a time, which the downstream compilers for these targets don't reliably recombine.
+            if (isMetalTarget(targetRequest) || isWGPUTarget(targetRequest) ||
+                isCPUTarget(targetRequest))
+            {
+                SLANG_PASS(vectorizeScalarOps, irModule);
+            }
+
+            // Passes such as buffer load deferral and autodiff unzipping can leave values
+            // computed far from where they are used, and the code is emitted in IR order. Move
+            // them next to their uses to shorten their live ranges.
+            SLANG_PASS(sinkInstsToUses, irModule);
+        }
     }
 
+    // Report the local aggregates that are still kept in memory, before phi elimination
+    // introduces variables of its own.
+    if (targetProgram->getOptionSet().getBoolOption(CompilerOptionName::ReportUnpromotedVars))
+        reportUnpromotedVars(irModule, sink);
+
     // As a late step, we need to take the SSA-form IR and move things *out*
     // of SSA form, by eliminating all "phi nodes" (block parameters) and
     // introducing explicit temporaries instead. Doing this at the IR level
@@ -1555,7 +1729,7 @@ Result linkAndOptimizeIR(
         //
         if (isEnabled(livenessMode))
         {
-            LivenessUtil::addVariableRangeStarts(irModule, livenessMode);
+            SLANG_PASS(LivenessUtil::addVariableRangeStarts, irModule, livenessMode);
         }
 
         // We only want to accumulate locations if liveness tracking is enabled.
@@ -1565,7 +1739,7 @@ Result linkAndOptimizeIR(
             phiEliminationOptions.eliminateCompositeTypedPhiOnly = false;
             phiEliminationOptions.useRegisterAllocation = true;
         }
-        eliminatePhis(livenessMode, irModule, phiEliminationOptions);
+        SLANG_PASS(eliminatePhis, livenessMode, irModule, phiEliminationOptions);
 #if 0
         dumpIRIfEnabled(codeGenContext, irModule, "PHIS ELIMINATED");
 #endif
@@ -1574,7 +1748,7 @@ Result linkAndOptimizeIR(
 
         if (isEnabled(livenessMode))
         {
-            LivenessUtil::addRangeEnds(irModule, livenessMode);
+            SLANG_PASS(LivenessUtil::addRangeEnds, irModule, livenessMode);
 
 #if 0
             dumpIRIfEnabled(codeGenContext, irModule, "LIVENESS");
@@ -1604,19 +1778,19 @@ Result linkAndOptimizeIR(
     {
         if (isKhronosTarget(targetRequest))
         {
-            applyGLSLLiveness(irModule);
+            SLANG_PASS(applyGLSLLiveness, irModule);
         }
     }
 
     if (isKhronosTarget(targetRequest) && emitSpirvDirectly)
     {
-        replaceLocationIntrinsicsWithRaytracingObject(targetProgram, irModule, sink);
+        SLANG_PASS(replaceLocationIntrinsicsWithRaytracingObject, targetProgram, irModule, sink);
     }
 
     validateIRModuleIfEnabled(codeGenContext, irModule);
 
     // Run a final round of simplifications to clean up unused things after phi-elimination.
-    simplifyNonSSAIR(targetProgram, irModule, fastIRSimplificationOptions);
+    SLANG_PASS(simplifyNonSSAIR, targetProgram, irModule, fastIRSimplificationOptions);
 
     // We include one final step to (optionally) dump the IR and validate
     // it after all of the optimization passes are complete. This should
@@ -1635,7 +1809,7 @@ Result linkAndOptimizeIR(
         // This is a separate pass because it needs to run after
         // all the other optimization passes have been performed.
 
-        applyVariableScopeCorrection(irModule, targetRequest);
+        SLANG_PASS(applyVariableScopeCorrection, irModule, targetRequest);
         validateIRModuleIfEnabled(codeGenContext, irModule);
     }
 
@@ -1644,19 +1818,73 @@ Result linkAndOptimizeIR(
 
     if (targetProgram->getOptionSet().getBoolOption(CompilerOptionName::EmbedDownstreamIR))
     {
-        unexportNonEmbeddableIR(target, irModule);
+        SLANG_PASS(unexportNonEmbeddableIR, target, irModule);
     }
 
-    collectMetadata(irModule, *metadata);
+    SLANG_PASS(collectMetadata, irModule, *metadata);
+    metadata->m_instrumentedFunctions = _Move(instrumentedFunctions);
 
     outLinkedIR.metadata = metadata;
 
     if (!targetProgram->getOptionSet().shouldPerformMinimumOptimizations())
-        checkUnsupportedInst(codeGenContext->getTargetReq(), irModule, sink);
+        SLANG_PASS(checkUnsupportedInst, codeGenContext->getTargetReq(), irModule, sink);
 
     return sink->getErrorCount() == 0 ? SLANG_OK : SLANG_FAIL;
 }
 
+#undef SLANG_PASS
+
+Result linkAndOptimizeIR(
+    CodeGenContext* codeGenContext,
+    LinkingAndOptimizationOptions const& options,
+    LinkedIR& outLinkedIR)
+{
+    SLANG_PROFILE;
+
+    const bool reportPassStats = codeGenContext->shouldReportPassStats();
+    IRPassStatsRecorder passStats;
+
+    auto& optionSet = codeGenContext->getTargetProgram()->getOptionSet();
+    IRInstBudget instBudget(
+        codeGenContext->getSink(),
+        optionSet.getIntOption(CompilerOptionName::IRInstBudget),
+        optionSet.getIntOption(CompilerOptionName::IRFuncInstBudget));
+
+    const Result result = _linkAndOptimizeIR(
+        codeGenContext,
+        options,
+        reportPassStats ? &passStats : nullptr,
+        instBudget.isEnabled() ? &instBudget : nullptr,
+        outLinkedIR);
+
+    // The passes are checked before they run, so the IR the last pass left still needs
+    // checking.
+    if (SLANG_SUCCEEDED(result) && instBudget.isEnabled() && outLinkedIR.module)
+        instBudget.check(outLinkedIR.module);
+
+    if (reportPassStats)
+    {
+        StringBuilder report;
+        passStats.writeJSON(report);
+        codeGenContext->getSink()->diagnose(
+            SourceLoc(),
+            Diagnostics::irPassStatsReport,
+            report.produceString());
+    }
+
+    // The linked IR only grows while it is optimized, so this is when code generation uses
+    // the most memory. Sample it for the high water marks of the session.
+    if (outLinkedIR.module)
+    {
+        slang::SessionMemoryStats memoryStats;
+        codeGenContext->getLinkage()->calcMemoryStats(
+            memoryStats,
+            outLinkedIR.module->getMemoryArena().calcTotalMemoryAllocated());
+    }
+
+    return result;
+}
+
 SlangResult CodeGenContext::emitEntryPointsSourceFromIR(ComPtr<IArtifact>& outArtifact)
 {
     SLANG_PROFILE;
@@ -1918,6 +2146,44 @@ SlangResult emitSPIRVForEntryPointsDirectly(
     CodeGenContext* codeGenContext,
     ComPtr<IArtifact>& outArtifact)
 {
+    IDownstreamCompiler* compiler = codeGenContext->getSession()->getOrLoadDownstreamCompiler(
+        PassThroughMode::SpirvOpt,
+        codeGenContext->getSink());
+
+    // Modules precompiled to SPIR-V can be linked in, rather than emitting SPIR-V for
+    // the functions they provide again. When precompiling, the output has to stay a
+    // library, so nothing is linked in.
+    List<ComPtr<IArtifact>> libraries;
+    if (compiler && !codeGenContext->getTargetProgram()->getOptionSet().getBoolOption(
+                        CompilerOptionName::EmbedDownstreamIR))
+    {
+        codeGenContext->getProgram()->enumerateIRModules(
+            [&](IRModule* irModule)
+            {
+                for (auto globalInst : irModule->getModuleInst()->getChildren())
+                {
+                    auto inst = as<IREmbeddedDownstreamIR>(globalInst);
+                    if (!inst || inst->getTarget() != CodeGenTarget::SPIRV)
+                        continue;
+
+                    ArtifactDesc desc = ArtifactDescUtil::makeDescForCompileTarget(SLANG_SPIRV);
+                    desc.kind = ArtifactKind::Library;
+
+                    // The libraries are only used by the link below, whilst the IR
+                    // modules are alive, so they can refer to the IR's copy of the SPIR-V.
+                    auto library = ArtifactUtil::createArtifact(desc);
+                    const auto slice = inst->getBlob()->getStringSlice();
+                    library->addRepresentationUnknown(
+                        UnownedRawBlob::create(slice.begin(), slice.getLength()));
+                    libraries.add(library);
+                }
+            });
+    }
+    if (libraries.getCount())
+    {
+        codeGenContext->removeAvailableInDownstreamIR = true;
+    }
+
     // Outside because we want to keep IR in scope whilst we are processing emits
     LinkedIR linkedIR;
     LinkingAndOptimizationOptions linkingAndOptimizationOptions;
@@ -1938,9 +2204,12 @@ SlangResult emitSPIRVForEntryPointsDirectly(
         spirv = _Move(outSpirv);
     }
 #endif
+    // The blob takes over the buffer of `spirv`, so the module is read from the blob
+    // from here on.
     auto artifact =
         ArtifactUtil::createArtifactForCompileTarget(asExternal(codeGenContext->getTargetFormat()));
-    artifact->addRepresentationUnknown(ListBlob::moveCreate(spirv));
+    ComPtr<ISlangBlob> spirvBlob = ListBlob::moveCreate(spirv);
+    artifact->addRepresentationUnknown(spirvBlob);
 
 #if 0
     // Dump the unoptimized SPIRV after lowering from slang IR -> SPIRV
@@ -1949,12 +2218,11 @@ SlangResult emitSPIRVForEntryPointsDirectly(
     printf("%s", dis.begin());
 #endif
 
-    IDownstreamCompiler* compiler = codeGenContext->getSession()->getOrLoadDownstreamCompiler(
-        PassThroughMode::SpirvOpt,
-        codeGenContext->getSink());
     if (compiler)
     {
-        if (!codeGenContext->shouldSkipSPIRVValidation())
+        // Until the libraries are linked in the module has unresolved imports, which
+        // Vulkan doesn't allow, so it can't be validated.
+        if (!codeGenContext->shouldSkipSPIRVValidation() && !libraries.getCount())
         {
             StringBuilder runSpirvValEnvVar;
             PlatformUtil::getEnvironmentVariable(
@@ -1963,12 +2231,16 @@ SlangResult emitSPIRVForEntryPointsDirectly(
             if (runSpirvValEnvVar.getUnownedSlice() == "1")
             {
                 if (SLANG_FAILED(compiler->validate(
-                        (uint32_t*)spirv.getBuffer(),
-                        int(spirv.getCount() / 4))))
+                        (uint32_t*)spirvBlob->getBufferPointer(),
+                        int(spirvBlob->getBufferSize() / 4))))
                 {
+                    List<uint8_t> spirvCopy;
+                    spirvCopy.addRange(
+                        (const uint8_t*)spirvBlob->getBufferPointer(),
+                        Index(spirvBlob->getBufferSize()));
                     String err;
                     String dis;
-                    disassembleSPIRV(spirv, err, dis);
+                    disassembleSPIRV(spirvCopy, err, dis);
                     codeGenContext->getSink()->diagnoseWithoutSourceView(
                         SourceLoc{},
                         Diagnostics::spirvValidationFailed,
@@ -1982,6 +2254,7 @@ SlangResult emitSPIRVForEntryPointsDirectly(
         downstreamOptions.sourceArtifacts = makeSlice(artifact.readRef(), 1);
         downstreamOptions.targetType = SLANG_SPIRV;
         downstreamOptions.sourceLanguage = SLANG_SOURCE_LANGUAGE_SPIRV;
+        downstreamOptions.libraries = SliceUtil::asSlice(libraries);
         switch (codeGenContext->getTargetProgram()->getOptionSet().getEnumOption<OptimizationLevel>(
             CompilerOptionName::Optimization))
         {
@@ -2003,17 +2276,27 @@ SlangResult emitSPIRVForEntryPointsDirectly(
             SLANG_ASSERT(!"Unhandled optimization level");
             break;
         }
-        auto downstreamStartTime = std::chrono::high_resolution_clock::now();
-        if (SLANG_SUCCEEDED(compiler->compile(downstreamOptions, optimizedArtifact.writeRef())))
+
+        // Without optimization spirv-opt has nothing to do, so there is no need to
+        // copy the module over to it and back, unless there are libraries to link.
+        if (downstreamOptions.optimizationLevel !=
+                DownstreamCompileOptions::OptimizationLevel::None ||
+            libraries.getCount())
         {
-            artifact = _Move(optimizedArtifact);
-        }
-        auto downstreamElapsedTime =
-            (std::chrono::high_resolution_clock::now() - downstreamStartTime).count() * 0.000000001;
-        codeGenContext->getSession()->addDownstreamCompileTime(downstreamElapsedTime);
+            auto downstreamStartTime = std::chrono::high_resolution_clock::now();
+            if (SLANG_SUCCEEDED(
+                    compiler->compile(downstreamOptions, optimizedArtifact.writeRef())))
+            {
+                artifact = _Move(optimizedArtifact);
+            }
+            auto downstreamElapsedTime =
+                (std::chrono::high_resolution_clock::now() - downstreamStartTime).count() *
+                0.000000001;
+            codeGenContext->getSession()->addDownstreamCompileTime(downstreamElapsedTime);
 
-        SLANG_RETURN_ON_FAIL(
-            passthroughDownstreamDiagnostics(codeGenContext->getSink(), compiler, artifact));
+            SLANG_RETURN_ON_FAIL(
+                passthroughDownstreamDiagnostics(codeGenContext->getSink(), compiler, artifact));
+        }
     }
 
     ArtifactUtil::addAssociated(artifact, linkedIR.metadata);
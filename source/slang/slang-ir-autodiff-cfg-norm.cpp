@@ -709,7 +709,7 @@ struct CFGNormalizationPass
 
 static void legalizeDefUse(IRGlobalValueWithCode* func)
 {
-    auto dom = computeDominatorTree(func);
+    RefPtr<IRDominatorTree> dom = func->getModule()->findOrCreateDominatorTree(func);
     for (auto block : func->getBlocks())
     {
         for (auto inst : block->getModifiableChildren())
@@ -866,7 +866,6 @@ void normalizeCFG(
     constructSSA(module, func);
     enableIRValidationAtInsert();
 
-    module->invalidateAnalysisForInst(func);
 #if _DEBUG
     validateIRInst(maybeFindOuterGeneric(func));
 #endif
@@ -2009,7 +2009,9 @@ void buildIndexedBlocks(
 // For each primal inst that is used in reverse blocks, decide if we should recompute or store
 // its value, then make them accessible in reverse blocks based the decision.
 //
-RefPtr<HoistedPrimalsInfo> applyCheckpointPolicy(IRGlobalValueWithCode* func)
+RefPtr<HoistedPrimalsInfo> applyCheckpointPolicy(
+    IRGlobalValueWithCode* func,
+    CheckpointPolicyKind kind)
 {
     sortBlocksInFunc(func);
 
@@ -2031,7 +2033,11 @@ RefPtr<HoistedPrimalsInfo> applyCheckpointPolicy(IRGlobalValueWithCode* func)
     // If we decide to recompute the inst, emit the recompute inst in the corresponding recompute
     // block.
     //
-    RefPtr<AutodiffCheckpointPolicyBase> chkPolicy = new DefaultCheckpointPolicy(func->getModule());
+    RefPtr<AutodiffCheckpointPolicyBase> chkPolicy;
+    if (kind == CheckpointPolicyKind::Default)
+        chkPolicy = new DefaultCheckpointPolicy(func->getModule());
+    else
+        chkPolicy = new StorageAwareCheckpointPolicy(func->getModule(), kind, indexedBlockInfo);
     chkPolicy->preparePolicy(func);
     auto primalsInfo = chkPolicy->processFunc(func, recomputeBlockMap, cloneCtx, indexedBlockInfo);
 
@@ -2330,4 +2336,54 @@ HoistResult DefaultCheckpointPolicy::classify(UseOrPseudoUse use)
     }
 }
 
+bool StorageAwareCheckpointPolicy::canRecomputeInsteadOfStore(UseOrPseudoUse use)
+{
+    IRInst* inst = use.usedVal;
+
+    // A var is recomputed by running the call that writes it again.
+    if (auto var = as<IRVar>(inst))
+    {
+        auto storeUse = findLatestUniqueWriteUse(var);
+        if (!storeUse)
+            return false;
+        inst = as<IRCall>(storeUse->getUser());
+        if (!inst)
+            return false;
+    }
+    else if (!canRecompute(use))
+    {
+        return false;
+    }
+
+    if (auto call = as<IRCall>(inst))
+    {
+        // An explicit preference of the callee wins over the policy.
+        auto callee = call->getCallee();
+        if (getCheckpointPreference(callee) == CheckpointPreference::PreferCheckpoint)
+            return false;
+        return !doesCalleeHaveSideEffect(callee);
+    }
+    return !inst->mightHaveSideEffects();
+}
+
+HoistResult StorageAwareCheckpointPolicy::classify(UseOrPseudoUse use)
+{
+    auto result = DefaultCheckpointPolicy::classify(use);
+    if (result.mode != HoistResult::Mode::Store)
+        return result;
+
+    if (kind == CheckpointPolicyKind::RecomputeInLoops)
+    {
+        // Only values computed in a loop need storage per iteration.
+        auto block = as<IRBlock>(use.usedVal->getParent());
+        auto loopInfo = block ? blockIndexInfo.tryGetValue(block) : nullptr;
+        if (!loopInfo || loopInfo->getCount() == 0)
+            return result;
+    }
+
+    if (canRecomputeInsteadOfStore(use))
+        return HoistResult::recompute(use.usedVal);
+    return result;
+}
+
 }; // namespace Slang
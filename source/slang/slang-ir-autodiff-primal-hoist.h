@@ -331,9 +331,45 @@ public:
     virtual void preparePolicy(IRGlobalValueWithCode* func);
     virtual HoistResult classify(UseOrPseudoUse use);
 
-private:
+protected:
     bool canRecompute(UseOrPseudoUse use);
 };
 
-RefPtr<HoistedPrimalsInfo> applyCheckpointPolicy(IRGlobalValueWithCode* func);
+// Mirrors `CheckpointPolicyKind` in the core module, which is what a
+// `[CheckpointPolicy]` attribute on a function selects.
+enum class CheckpointPolicyKind
+{
+    Default = 0,
+    MinimizeStorage = 1,
+    RecomputeInLoops = 2,
+};
+
+// A policy that trades recomputation for storage: values that the default
+// policy would store are recomputed instead wherever that is safe, either
+// everywhere (`MinimizeStorage`) or only inside of loops (`RecomputeInLoops`),
+// where every stored value takes an array with an element per iteration.
+//
+class StorageAwareCheckpointPolicy : public DefaultCheckpointPolicy
+{
+public:
+    StorageAwareCheckpointPolicy(
+        IRModule* module,
+        CheckpointPolicyKind kind,
+        Dictionary<IRBlock*, List<IndexTrackingInfo>>& blockIndexInfo)
+        : DefaultCheckpointPolicy(module), kind(kind), blockIndexInfo(blockIndexInfo)
+    {
+    }
+
+    virtual HoistResult classify(UseOrPseudoUse use);
+
+private:
+    bool canRecomputeInsteadOfStore(UseOrPseudoUse use);
+
+    CheckpointPolicyKind kind;
+    Dictionary<IRBlock*, List<IndexTrackingInfo>>& blockIndexInfo;
+};
+
+RefPtr<HoistedPrimalsInfo> applyCheckpointPolicy(
+    IRGlobalValueWithCode* func,
+    CheckpointPolicyKind kind = CheckpointPolicyKind::Default);
 }; // namespace Slang
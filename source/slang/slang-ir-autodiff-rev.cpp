@@ -836,7 +836,10 @@ void BackwardDiffTranscriberBase::transcribeFuncImpl(
 
     // Apply checkpointing policy to legalize cross-scope uses of primal values
     // using either recompute or store strategies.
-    auto primalsInfo = applyCheckpointPolicy(diffPropagateFunc);
+    auto policyKind = CheckpointPolicyKind::Default;
+    if (auto policyDecor = primalFunc->findDecoration<IRCheckpointPolicyDecoration>())
+        policyKind = (CheckpointPolicyKind)policyDecor->getPolicy();
+    auto primalsInfo = applyCheckpointPolicy(diffPropagateFunc, policyKind);
 
     eliminateDeadCode(diffPropagateFunc);
 
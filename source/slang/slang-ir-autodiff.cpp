@@ -6,6 +6,7 @@
 #include "slang-ir-autodiff-pairs.h"
 #include "slang-ir-autodiff-rev.h"
 #include "slang-ir-inline.h"
+#include "slang-ir-link.h"
 #include "slang-ir-single-return.h"
 #include "slang-ir-ssa-simplification.h"
 #include "slang-ir-validate.h"
@@ -1811,9 +1812,64 @@ struct AutoDiffPass : public InstPassBase
         //
         bool modified = processReferencedFunctions(builder);
 
+        // Share the derivatives made for this module with any later compilation for the
+        // same target program.
+        if (isDerivativeCacheEnabled() && sink->getErrorCount() == 0)
+            addCachedDerivatives(autodiffContext->targetProgram, module, derivatives);
+
         return modified;
     }
 
+    bool isDerivativeCacheEnabled()
+    {
+        auto targetProgram = autodiffContext->targetProgram;
+        return targetProgram &&
+               targetProgram->getOptionSet().getBoolOption(CompilerOptionName::CacheDerivatives);
+    }
+
+    // The key that identifies the derivative of `func` made by `mode` independently of the
+    // module, which is empty if `func` can't be identified outside of it.
+    //
+    String getDerivativeCacheKey(IRInst* func, const char* mode)
+    {
+        auto linkage = func ? func->findDecoration<IRLinkageDecoration>() : nullptr;
+        if (!as<IRFunc>(func) || !linkage || !isDerivativeCacheEnabled())
+            return String();
+
+        StringBuilder key;
+        key << "autodiff:" << mode << ":" << linkage->getMangledName();
+        return key.produceString();
+    }
+
+    // Find the derivative for `key` made earlier for this module, or clone it from the
+    // derivative cache of the target program.
+    //
+    IRInst* findCachedDerivative(const String& key)
+    {
+        if (!key.getLength())
+            return nullptr;
+
+        IRInst* derivative = nullptr;
+        if (derivatives.tryGetValue(key, derivative) && derivative->getParent())
+            return derivative;
+
+        derivative = cloneCachedSpecialization(
+            autodiffContext->targetProgram,
+            module,
+            key,
+            moduleSymbols,
+            derivatives);
+        if (derivative)
+            derivatives[key] = derivative;
+        return derivative;
+    }
+
+    void addDerivative(const String& key, IRInst* derivative)
+    {
+        if (key.getLength() && as<IRFunc>(derivative))
+            derivatives[key] = derivative;
+    }
+
     IRInst* processIntermediateContextTypeBase(IRBuilder* builder, IRInst* base)
     {
         if (auto spec = as<IRSpecialize>(base))
@@ -2470,35 +2526,51 @@ struct AutoDiffPass : public InstPassBase
                 IRInst* diffFunc = nullptr;
                 IRBuilder subBuilder(*builder);
                 subBuilder.setInsertBefore(differentiateInst);
+
+                // A derivative that an earlier compilation of the target program made for
+                // the same function is cloned rather than transcribed again.
+                auto baseFunc = differentiateInst->getOperand(0);
+                String cacheKey;
                 switch (differentiateInst->getOp())
                 {
                 case kIROp_ForwardDifferentiate:
-                    {
-                        auto baseFunc = as<IRForwardDifferentiate>(differentiateInst)->getBaseFn();
-                        diffFunc = forwardTranscriber.transcribe(&subBuilder, baseFunc);
-                    }
+                    cacheKey = getDerivativeCacheKey(baseFunc, "fwd");
                     break;
                 case kIROp_BackwardDifferentiatePrimal:
-                    {
-                        auto baseFunc = differentiateInst->getOperand(0);
-                        diffFunc = backwardPrimalTranscriber.transcribe(&subBuilder, baseFunc);
-                    }
+                    cacheKey = getDerivativeCacheKey(baseFunc, "bwd_primal");
                     break;
                 case kIROp_BackwardDifferentiatePropagate:
-                    {
-                        auto baseFunc = differentiateInst->getOperand(0);
-                        diffFunc = backwardPropagateTranscriber.transcribe(&subBuilder, baseFunc);
-                    }
+                    cacheKey = getDerivativeCacheKey(baseFunc, "bwd_propagate");
                     break;
                 case kIROp_BackwardDifferentiate:
-                    {
-                        auto baseFunc = differentiateInst->getOperand(0);
-                        diffFunc = backwardTranscriber.transcribe(&subBuilder, baseFunc);
-                    }
+                    cacheKey = getDerivativeCacheKey(baseFunc, "bwd");
                     break;
                 default:
                     break;
                 }
+                diffFunc = findCachedDerivative(cacheKey);
+
+                if (!diffFunc)
+                {
+                    switch (differentiateInst->getOp())
+                    {
+                    case kIROp_ForwardDifferentiate:
+                        diffFunc = forwardTranscriber.transcribe(&subBuilder, baseFunc);
+                        break;
+                    case kIROp_BackwardDifferentiatePrimal:
+                        diffFunc = backwardPrimalTranscriber.transcribe(&subBuilder, baseFunc);
+                        break;
+                    case kIROp_BackwardDifferentiatePropagate:
+                        diffFunc = backwardPropagateTranscriber.transcribe(&subBuilder, baseFunc);
+                        break;
+                    case kIROp_BackwardDifferentiate:
+                        diffFunc = backwardTranscriber.transcribe(&subBuilder, baseFunc);
+                        break;
+                    default:
+                        break;
+                    }
+                    addDerivative(cacheKey, diffFunc);
+                }
 
                 if (diffFunc)
                 {
@@ -2535,12 +2607,17 @@ struct AutoDiffPass : public InstPassBase
                     {
                     case FuncBodyTranscriptionTaskType::Forward:
                         forwardTranscriber.transcribeFunc(builder, primalFunc, diffFunc);
+                        addDerivative(getDerivativeCacheKey(primalFunc, "fwd"), diffFunc);
                         break;
                     case FuncBodyTranscriptionTaskType::BackwardPrimal:
                         backwardPrimalTranscriber.transcribeFunc(builder, primalFunc, diffFunc);
+                        addDerivative(getDerivativeCacheKey(primalFunc, "bwd_primal"), diffFunc);
                         break;
                     case FuncBodyTranscriptionTaskType::BackwardPropagate:
                         backwardPropagateTranscriber.transcribeFunc(builder, primalFunc, diffFunc);
+                        addDerivative(
+                            getDerivativeCacheKey(primalFunc, "bwd_propagate"),
+                            diffFunc);
                         break;
                     default:
                         break;
@@ -2662,6 +2739,12 @@ protected:
 
     // Builder for dealing with differential pair types.
     DifferentialPairTypeBuilder pairBuilderStorage;
+
+    // With `-cache-derivatives`, the derivative functions of this module by derivative cache
+    // key (see `getDerivativeCacheKey`), and the global values with linkage by mangled name,
+    // to bind the values that a derivative cloned out of the cache refers to.
+    Dictionary<String, IRInst*> derivatives;
+    Dictionary<String, IRInst*> moduleSymbols;
 };
 
 void checkAutodiffPatterns(TargetProgram* target, IRModule* module, DiagnosticSink* sink)
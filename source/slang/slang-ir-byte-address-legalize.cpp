@@ -267,6 +267,114 @@ struct ByteAddressBufferLegalizationContext
         return getNaturalSizeAndAlignment(target->getOptionSet(), type, outSizeAlignment);
     }
 
+    SlangResult getFieldsAndOffsets(
+        IRStructType* structType,
+        List<IRStructField*>& outFields,
+        List<IRIntegerValue>& outOffsets)
+    {
+        for (auto field : structType->getFields())
+        {
+            IRIntegerValue fieldOffset = 0;
+            SLANG_RETURN_ON_FAIL(getOffset(m_targetProgram, field, &fieldOffset));
+            outFields.add(field);
+            outOffsets.add(fieldOffset);
+        }
+        return SLANG_OK;
+    }
+
+    // Check whether `baseOffset` plus `immediateOffset` is known to be a multiple of
+    // `alignmentVal`. Unlike `isAligned`, this never diagnoses, because it is only used
+    // to decide whether an optional wider access is possible.
+    bool isKnownAligned(
+        IRInst* baseOffset,
+        IRIntegerValue immediateOffset,
+        IRInst* unknownOffsetAlignment,
+        IRIntegerValue alignmentVal)
+    {
+        if (auto baseOffsetVal = as<IRIntLit>(baseOffset))
+            return ((baseOffsetVal->getValue() + immediateOffset) % alignmentVal) == 0;
+
+        if ((immediateOffset % alignmentVal) != 0)
+            return false;
+
+        auto alignInst = as<IRIntLit>(unknownOffsetAlignment);
+        return alignInst && alignInst->getValue() && (alignInst->getValue() % alignmentVal) == 0;
+    }
+
+    // When `coalesceFieldLoadStore` is enabled, a run of adjacent fields that
+    // share a 32-bit scalar type can be accessed with one `vector<T,2>` or
+    // `vector<T,4>` operation (like `Load2()`/`Load4()`), provided the layout
+    // guarantees the wider access is aligned. Returns the number of fields,
+    // starting at `startIndex`, that should be accessed together (1 if the
+    // field should be accessed on its own).
+    //
+    Index getCoalescedFieldCount(
+        List<IRStructField*> const& fields,
+        List<IRIntegerValue> const& fieldOffsets,
+        Index startIndex,
+        IRInst* baseOffset,
+        IRIntegerValue immediateOffset,
+        IRInst* alignment)
+    {
+        if (!m_options.coalesceFieldLoadStore || m_options.scalarizeVectorLoadStore)
+            return 1;
+
+        auto elementType = as<IRBasicType>(fields[startIndex]->getFieldType());
+        if (!elementType || elementType->getOp() == kIROp_BoolType)
+            return 1;
+
+        IRSizeAndAlignment elementLayout;
+        if (SLANG_FAILED(getNaturalSizeAndAlignment(
+                m_targetProgram->getOptionSet(),
+                elementType,
+                &elementLayout)))
+            return 1;
+        const IRIntegerValue elementSize = elementLayout.size;
+        if (elementSize != 4)
+            return 1;
+
+        const IRIntegerValue startOffset = fieldOffsets[startIndex];
+        Index runCount = 1;
+        while (runCount < 4 && startIndex + runCount < fields.getCount() &&
+               fields[startIndex + runCount]->getFieldType() == elementType &&
+               fieldOffsets[startIndex + runCount] == startOffset + runCount * elementSize)
+        {
+            runCount++;
+        }
+
+        // Only the two- and four-wide forms are used, since a three-wide vector
+        // has a padded stride on some targets.
+        //
+        for (Index width = runCount >= 4 ? 4 : 2; width >= 2; width /= 2)
+        {
+            if (runCount >= width &&
+                isKnownAligned(baseOffset, immediateOffset + startOffset, alignment, width * 4))
+                return width;
+        }
+        return 1;
+    }
+
+    IRInst* emitCoalescedFieldLoad(
+        IRType* elementType,
+        IRIntegerValue elementCount,
+        IRInst* buffer,
+        IRInst* baseOffset,
+        IRIntegerValue immediateOffset)
+    {
+        auto vecType = m_builder.getVectorType(elementType, elementCount);
+        if (m_options.useBitCastFromUInt && elementType->getOp() != kIROp_UIntType)
+        {
+            if (auto unsignedElementType = getSameSizeUIntType(elementType))
+            {
+                auto unsignedVecType = m_builder.getVectorType(unsignedElementType, elementCount);
+                auto unsignedVecVal =
+                    emitSimpleLoad(unsignedVecType, buffer, baseOffset, immediateOffset);
+                return m_builder.emitBitCast(vecType, unsignedVecVal);
+            }
+        }
+        return emitSimpleLoad(vecType, buffer, baseOffset, immediateOffset);
+    }
+
     // The core workhorse routine for the load case is `emitLegalLoad`,
     // which tries to emit load operations that read a value of the
     // given `type` from the given `buffer` at the required `baseOffset`
@@ -310,22 +418,49 @@ struct ByteAddressBufferLegalizationContext
             // array, which we will then use to construct the
             // full value of the `struct` type.
             //
+            // The relative offset of each field is calculated using
+            // the IR-based layout subsystem, which works with the
+            // "natural" in-memory layout of types.
+            //
+            // It is possible for layout computation to fail (e.g.,
+            // if the field type somehow wasn't one that can be
+            // laid out "naturally"). If the layout process fails,
+            // then we fail to legalize this load.
+            //
+            List<IRStructField*> fields;
+            List<IRIntegerValue> fieldOffsets;
+            SLANG_RETURN_NULL_ON_FAIL(getFieldsAndOffsets(structType, fields, fieldOffsets));
+
             List<IRInst*> fieldVals;
-            for (auto field : structType->getFields())
+            for (Index fieldIndex = 0; fieldIndex < fields.getCount(); fieldIndex++)
             {
+                auto field = fields[fieldIndex];
                 auto fieldType = field->getFieldType();
+                auto fieldOffset = fieldOffsets[fieldIndex];
 
-                // The relative offset of each field is calculated using
-                // the IR-based layout subsystem, which works with the
-                // "natural" in-memory layout of types.
+                // A run of adjacent scalar fields may be loaded as a single
+                // vector, and then split back into the individual fields.
                 //
-                // It is possible for layout computation to fail (e.g.,
-                // if the field type somehow wasn't one that can be
-                // laid out "naturally"). If the layout process fails,
-                // then we fail to legalize this load.
-                //
-                IRIntegerValue fieldOffset = 0;
-                SLANG_RETURN_NULL_ON_FAIL(getOffset(m_targetProgram, field, &fieldOffset));
+                auto runCount = getCoalescedFieldCount(
+                    fields,
+                    fieldOffsets,
+                    fieldIndex,
+                    baseOffset,
+                    immediateOffset,
+                    alignment);
+                if (runCount > 1)
+                {
+                    auto runVal = emitCoalescedFieldLoad(
+                        fieldType,
+                        runCount,
+                        buffer,
+                        baseOffset,
+                        immediateOffset + fieldOffset);
+                    for (Index ii = 0; ii < runCount; ii++)
+                        fieldVals.add(m_builder.emitElementExtract(runVal, ii));
+                    fieldIndex += runCount - 1;
+                    continue;
+                }
 
                 // Otherwise, we load the field by recursively calling this function
                 // on the field type, with an adjusted immediate offset.
@@ -1154,12 +1289,45 @@ struct ByteAddressBufferLegalizationContext
             // To store a structure, we store each of its fields at
             // the appropriate relative offset.
             //
-            for (auto field : structType->getFields())
+            List<IRStructField*> fields;
+            List<IRIntegerValue> fieldOffsets;
+            SLANG_RETURN_ON_FAIL(getFieldsAndOffsets(structType, fields, fieldOffsets));
+
+            for (Index fieldIndex = 0; fieldIndex < fields.getCount(); fieldIndex++)
             {
+                auto field = fields[fieldIndex];
                 auto fieldType = field->getFieldType();
+                auto fieldOffset = fieldOffsets[fieldIndex];
 
-                IRIntegerValue fieldOffset;
-                SLANG_RETURN_ON_FAIL(getOffset(m_targetProgram, field, &fieldOffset));
+                // As for loads, a run of adjacent scalar fields may be
+                // gathered into a vector and stored with one operation.
+                //
+                auto runCount = getCoalescedFieldCount(
+                    fields,
+                    fieldOffsets,
+                    fieldIndex,
+                    baseOffset,
+                    immediateOffset,
+                    alignment);
+                if (runCount > 1)
+                {
+                    List<IRInst*> runVals;
+                    for (Index ii = 0; ii < runCount; ii++)
+                    {
+                        runVals.add(m_builder.emitFieldExtract(
+                            fieldType,
+                            value,
+                            fields[fieldIndex + ii]->getKey()));
+                    }
+                    SLANG_RETURN_ON_FAIL(emitCoalescedFieldStore(
+                        fieldType,
+                        runVals,
+                        buffer,
+                        baseOffset,
+                        immediateOffset + fieldOffset));
+                    fieldIndex += runCount - 1;
+                    continue;
+                }
 
                 auto fieldVal = m_builder.emitFieldExtract(fieldType, value, field->getKey());
                 SLANG_RETURN_ON_FAIL(emitLegalStore(
@@ -1348,6 +1516,33 @@ struct ByteAddressBufferLegalizationContext
         return emitSimpleStore(type, buffer, baseOffset, immediateOffset, value);
     }
 
+    Result emitCoalescedFieldStore(
+        IRType* elementType,
+        List<IRInst*> const& elementVals,
+        IRInst* buffer,
+        IRInst* baseOffset,
+        IRIntegerValue immediateOffset)
+    {
+        auto vecType = m_builder.getVectorType(elementType, elementVals.getCount());
+        auto vecVal = m_builder.emitMakeVector(vecType, elementVals);
+        if (m_options.useBitCastFromUInt && elementType->getOp() != kIROp_UIntType)
+        {
+            if (auto unsignedElementType = getSameSizeUIntType(elementType))
+            {
+                auto unsignedVecType =
+                    m_builder.getVectorType(unsignedElementType, elementVals.getCount());
+                auto unsignedVecVal = m_builder.emitBitCast(unsignedVecType, vecVal);
+                return emitSimpleStore(
+                    unsignedVecType,
+                    buffer,
+                    baseOffset,
+                    immediateOffset,
+                    unsignedVecVal);
+            }
+        }
+        return emitSimpleStore(vecType, buffer, baseOffset, immediateOffset, vecVal);
+    }
+
     Result emitSimpleStore(
         IRType* type,
         IRInst* buffer,
@@ -15,6 +15,11 @@ struct ByteAddressBufferLegalizationOptions
     bool translateToStructuredBufferOps = false;
     bool lowerBasicTypeOps = false;
 
+    /// Load and store runs of adjacent 32-bit scalar fields of a `struct` with a
+    /// single two- or four-element vector operation, when the layout shows the wider
+    /// access is aligned. Has no effect when `scalarizeVectorLoadStore` is set.
+    bool coalesceFieldLoadStore = false;
+
     /// Causes all calls to `getEquivlentStructuredBuffer` to return a `ByteAddressBuffer` (this)
     /// instead of a `StructuredBuffer`. This option is used for targets that do not distinctly
     /// define `ByteAddressBuffer`/`StructuredBuffer` and introduce operations which prevent DCE
@@ -0,0 +1,182 @@
+// slang-ir-dataflow.cpp
+#include "slang-ir-dataflow.h"
+
+#include "slang-ir-dominators.h"
+#include "slang-ir.h"
+
+namespace Slang
+{
+
+IRBlockNumbering::IRBlockNumbering(IRGlobalValueWithCode* code)
+{
+    // The postorder has the unreachable blocks first, so reversing it puts them last.
+    HashSet<IRBlock*> reachableSet;
+    computePostorder(code, m_blocks, reachableSet);
+    m_blocks.reverse();
+    m_reachableBlockCount = reachableSet.getCount();
+
+    const Index blockCount = m_blocks.getCount();
+    for (Index i = 0; i < blockCount; ++i)
+        m_mapBlockToIndex.add(m_blocks[i], i);
+
+    m_successorStarts.setCount(blockCount + 1);
+    m_predecessorStarts.setCount(blockCount + 1);
+    for (Index i = 0; i <= blockCount; ++i)
+        m_predecessorStarts[i] = 0;
+
+    for (Index i = 0; i < blockCount; ++i)
+    {
+        m_successorStarts[i] = m_successors.getCount();
+        for (auto successor : m_blocks[i]->getSuccessors())
+        {
+            const Index successorIndex = m_mapBlockToIndex.getValue(successor);
+            m_successors.add(successorIndex);
+            m_predecessorStarts[successorIndex + 1]++;
+        }
+    }
+    m_successorStarts[blockCount] = m_successors.getCount();
+
+    // Turn the counts of predecessors into where the predecessors of each block start, and
+    // then fill them in by going over the successors again.
+    for (Index i = 0; i < blockCount; ++i)
+        m_predecessorStarts[i + 1] += m_predecessorStarts[i];
+
+    List<Index> predecessorCounts;
+    predecessorCounts.setCount(blockCount);
+    for (Index i = 0; i < blockCount; ++i)
+        predecessorCounts[i] = 0;
+
+    m_predecessors.setCount(m_successors.getCount());
+    for (Index i = 0; i < blockCount; ++i)
+    {
+        for (auto successorIndex : getSuccessors(i))
+        {
+            const Index slot = m_predecessorStarts[successorIndex];
+            m_predecessors[slot + predecessorCounts[successorIndex]++] = i;
+        }
+    }
+}
+
+Index IRBlockNumbering::getBlockIndex(IRBlock* block) const
+{
+    if (auto index = m_mapBlockToIndex.tryGetValue(block))
+        return *index;
+    return -1;
+}
+
+IRBitSetDataFlow::IRBitSetDataFlow(
+    const IRBlockNumbering& blocks,
+    DataFlowDirection direction,
+    DataFlowMeet meet,
+    Index factCount)
+    : m_blocks(blocks), m_direction(direction), m_meet(meet)
+{
+    const Index blockCount = blocks.getBlockCount();
+    m_boundary.resizeAndClear(UInt(factCount));
+    List<UIntSet>* sets[] = {&m_gen, &m_kill, &m_in, &m_out};
+    for (auto blockSets : sets)
+    {
+        blockSets->setCount(blockCount);
+        for (auto& set : *blockSets)
+            set.resizeAndClear(UInt(factCount));
+    }
+}
+
+bool IRBitSetDataFlow::_visit(Index blockIndex)
+{
+    const bool isForward = m_direction == DataFlowDirection::Forward;
+
+    // `from` is the set the edges flow into, and `to` the set this block passes on.
+    UIntSet& from = isForward ? m_in[blockIndex] : m_out[blockIndex];
+    UIntSet& to = isForward ? m_out[blockIndex] : m_in[blockIndex];
+    const List<UIntSet>& toOfOthers = isForward ? m_out : m_in;
+
+    // The entry block, or an exit block for a backward problem, also has the edge that
+    // enters or leaves the function.
+    const auto edges = isForward ? m_blocks.getPredecessors(blockIndex)
+                                 : m_blocks.getSuccessors(blockIndex);
+    const bool isBoundary = isForward ? blockIndex == 0 : edges.getCount() == 0;
+
+    bool isFirst = true;
+    auto meetWith = [&](const UIntSet& set)
+    {
+        if (isFirst)
+            from = set;
+        else if (m_meet == DataFlowMeet::Union)
+            from.unionWith(set);
+        else
+            from.intersectWith(set);
+        isFirst = false;
+    };
+    if (isBoundary)
+        meetWith(m_boundary);
+    for (auto otherIndex : edges)
+    {
+        // Unreachable blocks aren't solved, and don't contribute.
+        if (otherIndex < m_blocks.getReachableBlockCount())
+            meetWith(toOfOthers[otherIndex]);
+    }
+    if (isFirst)
+        from.clear();
+
+    UIntSet result = from;
+    result.subtractWith(m_kill[blockIndex]);
+    result.unionWith(m_gen[blockIndex]);
+    if (result == to)
+        return false;
+    to.swapWith(result);
+    return true;
+}
+
+void IRBitSetDataFlow::solve()
+{
+    const Index reachableCount = m_blocks.getReachableBlockCount();
+    if (reachableCount == 0)
+        return;
+
+    const bool isForward = m_direction == DataFlowDirection::Forward;
+
+    // With intersection, a set that hasn't been computed yet must not remove facts from the
+    // sets it meets with, so all of them start out full.
+    if (m_meet == DataFlowMeet::Intersection)
+    {
+        for (Index i = 0; i < reachableCount; ++i)
+            (isForward ? m_out : m_in)[i].setAll();
+    }
+
+    // Visit in reverse postorder for forward problems, so the predecessors of a block are
+    // visited before it, apart from back edges, and in postorder for backward ones.
+    UIntSet pending(UInt(reachableCount));
+    pending.setAll();
+    for (bool needsPass = true; needsPass;)
+    {
+        needsPass = false;
+        for (Index n = 0; n < reachableCount; ++n)
+        {
+            const Index blockIndex = isForward ? n : reachableCount - 1 - n;
+            if (!pending.contains(UInt(blockIndex)))
+                continue;
+            pending.remove(UInt(blockIndex));
+            if (!_visit(blockIndex))
+                continue;
+
+            const auto dependents = isForward ? m_blocks.getSuccessors(blockIndex)
+                                              : m_blocks.getPredecessors(blockIndex);
+            for (auto dependentIndex : dependents)
+            {
+                if (dependentIndex >= reachableCount)
+                    continue;
+                pending.add(UInt(dependentIndex));
+
+                // A dependent that comes later in this pass is visited in it, one that came
+                // before needs another pass.
+                const Index dependentN =
+                    isForward ? dependentIndex : reachableCount - 1 - dependentIndex;
+                if (dependentN <= n)
+                    needsPass = true;
+            }
+        }
+    }
+}
+
+} // namespace Slang
@@ -0,0 +1,135 @@
+// slang-ir-dataflow.h
+#pragma once
+
+#include "../core/slang-basic.h"
+#include "../core/slang-uint-set.h"
+
+namespace Slang
+{
+struct IRBlock;
+struct IRGlobalValueWithCode;
+
+/// The blocks of a function numbered densely, for analyses that keep their state per block
+/// in lists, and sets of blocks as `UIntSet`s, rather than in hash maps keyed by block.
+///
+/// The blocks that are reachable from the entry block come first, in reverse postorder, so
+/// a block comes after all of its predecessors other than those reached through a back edge.
+/// The unreachable blocks come after them.
+struct IRBlockNumbering
+{
+    IRBlockNumbering() = default;
+    IRBlockNumbering(IRGlobalValueWithCode* code);
+
+    Index getBlockCount() const { return m_blocks.getCount(); }
+
+    /// Get the number of blocks reachable from the entry block, which are numbered
+    /// `[0, getReachableBlockCount())`.
+    Index getReachableBlockCount() const { return m_reachableBlockCount; }
+
+    IRBlock* getBlock(Index index) const { return m_blocks[index]; }
+
+    /// Get the index of `block`, or -1 if it isn't a block of the function.
+    Index getBlockIndex(IRBlock* block) const;
+
+    /// Get the indices of the successors of a block. As with `IRBlock::getSuccessors`, a block
+    /// appears once for each edge to it.
+    ConstArrayView<Index> getSuccessors(Index index) const
+    {
+        return _getEdges(m_successors, m_successorStarts, index);
+    }
+
+    /// Get the indices of the predecessors of a block, once for each edge from them.
+    ConstArrayView<Index> getPredecessors(Index index) const
+    {
+        return _getEdges(m_predecessors, m_predecessorStarts, index);
+    }
+
+private:
+    static ConstArrayView<Index> _getEdges(
+        const List<Index>& edges,
+        const List<Index>& starts,
+        Index index)
+    {
+        return ConstArrayView<Index>(
+            edges.getBuffer() + starts[index],
+            starts[index + 1] - starts[index]);
+    }
+
+    List<IRBlock*> m_blocks;
+    Dictionary<IRBlock*, Index> m_mapBlockToIndex;
+    Index m_reachableBlockCount = 0;
+
+    // The edges of block `i` are `m_successors[m_successorStarts[i]]` up to
+    // `m_successors[m_successorStarts[i + 1]]`, and the same for predecessors.
+    List<Index> m_successorStarts;
+    List<Index> m_successors;
+    List<Index> m_predecessorStarts;
+    List<Index> m_predecessors;
+};
+
+enum class DataFlowDirection
+{
+    Forward,  ///< Facts flow from a block to its successors
+    Backward, ///< Facts flow from a block to its predecessors
+};
+
+enum class DataFlowMeet
+{
+    Union,        ///< A fact holds if it holds on any of the incoming edges
+    Intersection, ///< A fact holds only if it holds on all of the incoming edges
+};
+
+/// Solves a gen/kill dataflow problem over the blocks of a function, where the facts that
+/// hold at a point are a set of indices in `[0, factCount)`.
+///
+/// For a forward problem, the facts at the start of a block are the meet of the facts at
+/// the end of its predecessors, and the facts at the end of the block are
+/// `gen | (start & ~kill)`. A backward problem is the same on the reversed CFG: liveness, for
+/// example, is backward with union, with uses as gen and definitions as kill.
+///
+/// Only the blocks reachable from the entry block are solved, and the sets of the other
+/// blocks are left empty. The blocks are visited in reverse postorder for a forward problem,
+/// and postorder for a backward one, with a bit per block saying if it needs visiting again.
+/// So a pass over the function visits each block that changed once, and the number of
+/// passes is bounded by the loop nesting depth rather than by the number of blocks.
+struct IRBitSetDataFlow
+{
+    IRBitSetDataFlow(
+        const IRBlockNumbering& blocks,
+        DataFlowDirection direction,
+        DataFlowMeet meet,
+        Index factCount);
+
+    /// The facts that a block adds. Set these before calling `solve`.
+    UIntSet& getGen(Index blockIndex) { return m_gen[blockIndex]; }
+    /// The facts that a block removes. Set these before calling `solve`.
+    UIntSet& getKill(Index blockIndex) { return m_kill[blockIndex]; }
+
+    /// Set the facts that hold on entry to the function for a forward problem, or at the exits
+    /// of the function for a backward one. They are empty by default.
+    void setBoundary(const UIntSet& facts) { m_boundary = facts; }
+
+    /// Solve the problem.
+    void solve();
+
+    /// Get the facts that hold at the start of a block.
+    const UIntSet& getIn(Index blockIndex) const { return m_in[blockIndex]; }
+    /// Get the facts that hold at the end of a block.
+    const UIntSet& getOut(Index blockIndex) const { return m_out[blockIndex]; }
+
+private:
+    /// Recompute the sets of a block, returning true if the set it passes on changed.
+    bool _visit(Index blockIndex);
+
+    const IRBlockNumbering& m_blocks;
+    DataFlowDirection m_direction;
+    DataFlowMeet m_meet;
+
+    UIntSet m_boundary;
+    List<UIntSet> m_gen;
+    List<UIntSet> m_kill;
+    List<UIntSet> m_in;
+    List<UIntSet> m_out;
+};
+
+} // namespace Slang
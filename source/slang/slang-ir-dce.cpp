@@ -55,6 +55,12 @@ struct DeadCodeEliminationContext
     //
     List<IRInst*> workList;
 
+    // The children of the instructions that `eliminateDeadInstsRec`
+    // is walking, shared by every level of the walk, so that it
+    // doesn't allocate a list for each live instruction.
+    //
+    List<IRInst*> childrenStack;
+
     // When we discover that an instruction seems
     // to be live, we will add it to our set,
     // and also the work list, but only if we
@@ -93,13 +99,13 @@ struct DeadCodeEliminationContext
     {
         bool result = false;
 
-        module->invalidateAllAnalysis();
+        // Clear the `alive` bits by initializing all scratchData to 0.
+        // The walk that eliminates dead instructions clears the bits
+        // of the ones it keeps, so this is only needed once.
+        initializeScratchData(root);
 
         for (;;)
         {
-            // Clear the `alive` bits by initializing all scratchData to 0.
-            initializeScratchData(root);
-
             workList.clear();
 
             // First of all, we know that the root instruction
@@ -114,7 +120,13 @@ struct DeadCodeEliminationContext
             // whose used value is marked as dead and eliminated.
             // We always make sure this undef inst is available to prevent
             // infiniate oscilating loops.
-            markInstAsLive(getUndefInst());
+            //
+            // The undef inst is in the global scope, so only the DCE of a
+            // whole module could eliminate it. Finding it means walking the
+            // global scope, so for anything smaller, such as a single
+            // function, it is only found once a use needs replacing.
+            if (root == module->getModuleInst())
+                markInstAsLive(getUndefInst());
 
             // Marking the module as live should have
             // seeded our work list, so we can now start
@@ -247,6 +259,11 @@ struct DeadCodeEliminationContext
         }
         else
         {
+            // The instruction is kept, so clear its `alive` bit, leaving
+            // the bits clear for the next iteration of `processInst`.
+            //
+            inst->scratchData = 0;
+
             // If `inst` is live, then we need to deal with the possibility
             // that its children/decorations (or descendents in general)
             // might still be dead.
@@ -257,19 +274,15 @@ struct DeadCodeEliminationContext
             // We need to cache all children in a work list to ensure they are
             // properly traversed.
             //
-            List<IRInst*> children;
+            const Index childrenStart = childrenStack.getCount();
             for (auto child : inst->getDecorationsAndChildren())
-                children.add(child);
-            for (IRInst* child : children)
-            {
-                changed |= eliminateDeadInstsRec(child);
-            }
-            if (changed)
+                childrenStack.add(child);
+            const Index childrenEnd = childrenStack.getCount();
+            for (Index i = childrenStart; i < childrenEnd; ++i)
             {
-                // If the function body is changed, invalidate its dominator tree.
-                if (auto func = as<IRGlobalValueWithCode>(inst))
-                    module->invalidateAnalysisForInst(func);
+                changed |= eliminateDeadInstsRec(childrenStack[i]);
             }
+            childrenStack.setCount(childrenStart);
         }
         return changed;
     }
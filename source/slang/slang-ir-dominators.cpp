@@ -271,7 +271,8 @@ struct DepthFirstSearchContext
     template<typename SuccessorFunc>
     void walk(IRBlock* block, const SuccessorFunc& getSuccessors)
     {
-        List<IRBlock*> nodeStack;
+        PooledList<IRBlock> pooledNodeStack;
+        auto& nodeStack = *pooledNodeStack;
         nodeStack.add(block);
         visited.add(block);
         preVisit(block);
@@ -334,8 +335,8 @@ void computeReachableSet(IRGlobalValueWithCode* code, HashSet<IRBlock*>& outSet)
 /// `outOrder`.
 void computePostorder(IRGlobalValueWithCode* code, List<IRBlock*>& outOrder)
 {
-    HashSet<IRBlock*> reachableSet;
-    computePostorder(code, outOrder, reachableSet);
+    PooledHashSet<IRBlock> reachableSet;
+    computePostorder(code, outOrder, *reachableSet);
 }
 
 /// Compute a postorder traversal of the blocks in `code`, writing the resulting order to
@@ -323,7 +323,7 @@ struct PhiEliminationContext
     {
         if (!m_dominatorTree)
         {
-            m_dominatorTree = computeDominatorTree(m_func);
+            m_dominatorTree = m_func->getModule()->findOrCreateDominatorTree(m_func);
         }
         return m_dominatorTree;
     }
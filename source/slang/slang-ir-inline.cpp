@@ -1045,6 +1045,184 @@ void performIntrinsicFunctionInlining(IRModule* module)
     }
 }
 
+/// An inlining pass that decides which call sites to inline from an estimate of the cost and
+/// benefit of doing so, rather than from attributes on the callee.
+///
+/// The cost of inlining a call site is the size of the callee, since that many instructions are
+/// copied into the caller. The benefit is that the optimizations that follow can specialize the
+/// body of the callee to the call site, which is most likely to pay off when arguments are
+/// constants, and that the call itself goes away. A callee with a single call site costs nothing
+/// overall, because the original function becomes dead once it is inlined.
+struct CostModelInliningPass : InliningPassBase
+{
+    typedef InliningPassBase Super;
+
+    /// Callees at most this size are always inlined, as the call costs about as much as the body.
+    static const Index kTrivialCalleeSize = 8;
+    /// Callees at most this size are inlined at every call site...
+    static const Index kSmallCalleeSize = 24;
+    /// ...and this much bigger for every argument that is a constant.
+    static const Index kConstantArgBonus = 8;
+    /// Callees with only one call site are inlined when they are at most this size.
+    static const Index kSingleCallSiteCalleeSize = 200;
+    /// A caller isn't grown beyond this size, except by trivial callees.
+    static const Index kMaxCallerSize = 2000;
+
+    CostModelInliningPass(IRModule* module)
+        : Super(module)
+    {
+    }
+
+    /// The number of call sites of each callee in the module, found before any inlining
+    Dictionary<IRFunc*, Index> m_callSiteCounts;
+    /// The size of each function that has been measured. A caller's size is updated as calls are
+    /// inlined into it.
+    Dictionary<IRFunc*, Index> m_funcSizes;
+
+    static Index calcFuncSize(IRFunc* func)
+    {
+        Index size = 0;
+        for (auto block : func->getBlocks())
+        {
+            for (auto inst : block->getChildren())
+            {
+                SLANG_UNUSED(inst);
+                size++;
+            }
+        }
+        return size;
+    }
+
+    Index getFuncSize(IRFunc* func)
+    {
+        if (auto size = m_funcSizes.tryGetValue(func))
+            return *size;
+        const Index size = calcFuncSize(func);
+        m_funcSizes.add(func, size);
+        return size;
+    }
+
+    void countCallSitesRec(IRInst* inst)
+    {
+        if (auto call = as<IRCall>(inst))
+        {
+            CallSiteInfo callSite;
+            if (canInline(call, callSite))
+            {
+                auto count = m_callSiteCounts.tryGetValue(callSite.callee);
+                if (count)
+                    (*count)++;
+                else
+                    m_callSiteCounts.add(callSite.callee, 1);
+            }
+            return;
+        }
+        for (auto child : inst->getChildren())
+        {
+            countCallSitesRec(child);
+        }
+    }
+
+    bool shouldInline(CallSiteInfo const& info)
+    {
+        auto callee = info.callee;
+        auto caller = getParentFunc(info.call);
+        if (!caller || caller == callee)
+            return false;
+
+        for (auto decor : callee->getDecorations())
+        {
+            switch (decor->getOp())
+            {
+            // Respect an explicit request not to inline
+            case kIROp_NoInlineDecoration:
+            // A callee with a target intrinsic is emitted as that intrinsic, not as its body
+            case kIROp_TargetIntrinsicDecoration:
+                return false;
+            default:
+                break;
+            }
+        }
+
+        const Index calleeSize = getFuncSize(callee);
+        if (calleeSize <= kTrivialCalleeSize)
+            return true;
+
+        if (getFuncSize(caller) + calleeSize > kMaxCallerSize)
+            return false;
+
+        Index callSiteCount = 0;
+        m_callSiteCounts.tryGetValue(callee, callSiteCount);
+        if (callSiteCount == 1 && calleeSize <= kSingleCallSiteCalleeSize)
+            return true;
+
+        Index constantArgCount = 0;
+        for (auto arg : info.call->getArgsList())
+        {
+            if (as<IRConstant>(arg))
+                constantArgCount++;
+        }
+        return calleeSize <= kSmallCalleeSize + kConstantArgBonus * constantArgCount;
+    }
+
+    bool considerCallSite(IRCall* call)
+    {
+        auto caller = getParentFunc(call);
+        CallSiteInfo callSite;
+        if (!caller || !canInline(call, callSite) || !shouldInline(callSite))
+            return false;
+
+        // The call is replaced by the body of the callee
+        const Index calleeSize = getFuncSize(callSite.callee);
+        inlineCallSite(callSite);
+        m_funcSizes[caller] = getFuncSize(caller) + calleeSize - 1;
+        return true;
+    }
+
+    bool run()
+    {
+        countCallSitesRec(m_module->getModuleInst());
+
+        // Inlining a generic callee can add global instructions, so the functions are found first
+        List<IRFunc*> funcs;
+        for (auto inst : m_module->getGlobalInsts())
+        {
+            if (auto func = as<IRFunc>(inst))
+                funcs.add(func);
+        }
+
+        bool changed = false;
+        for (auto func : funcs)
+        {
+            // Unlike considerCallSiteInFunc, each call site is only considered once, and calls
+            // that come from an inlined body are not considered again. That bounds how much the
+            // pass can grow the code.
+            List<IRCall*> callSites;
+            for (auto block : func->getBlocks())
+            {
+                for (auto child : block->getChildren())
+                {
+                    if (auto call = as<IRCall>(child))
+                        callSites.add(call);
+                }
+            }
+            for (auto call : callSites)
+            {
+                changed |= considerCallSite(call);
+            }
+        }
+        return changed;
+    }
+};
+
+bool performCostModelInlining(IRModule* module)
+{
+    SLANG_PROFILE;
+
+    CostModelInliningPass pass(module);
+    return pass.run();
+}
+
 struct CustomInliningPass : InliningPassBase
 {
     typedef InliningPassBase Super;
@@ -38,6 +38,10 @@ void performGLSLResourceReturnFunctionInlining(TargetProgram* targetProgram, IRM
 /// Inline simple intrinsic functions whose definition is a single asm block.
 void performIntrinsicFunctionInlining(IRModule* module);
 
+/// Inline call sites where an estimate of the benefit outweighs the growth in code size: small
+/// callees, callees with a single call site, and callees given constant arguments.
+bool performCostModelInlining(IRModule* module);
+
 /// Inline a specific call.
 bool inlineCall(IRCall* call);
 } // namespace Slang
@@ -955,6 +955,9 @@ INST_RANGE(BindingQuery, GetRegisterIndex, GetRegisterSpace)
         // Marks a type to be non copyable, causing SSA pass to skip turning variables of the the type into SSA values.
     INST(NonCopyableTypeDecoration, nonCopyable, 0, 0)
 
+        // The relative frequency of a type in dynamic dispatch, given by `[DispatchWeight]`.
+    INST(DispatchWeightDecoration, DispatchWeight, 1, 0)
+
         // Marks a value to be dynamically uniform.
     INST(DynamicUniformDecoration, DynamicUniform, 0, 0)
 
@@ -1096,6 +1099,9 @@ INST_RANGE(BindingQuery, GetRegisterIndex, GetRegisterSpace)
         /// Hint that a struct is used for reverse mode checkpointing
     INST(CheckpointIntermediateDecoration, CheckpointIntermediateDecoration, 1, 0)
 
+        /// The policy used to checkpoint the backward derivative of the decorated function.
+    INST(CheckpointPolicyDecoration, CheckpointPolicyDecoration, 1, 0)
+
     INST_RANGE(CheckpointHintDecoration, PreferCheckpointDecoration, PreferRecomputeDecoration)
 
         /// Marks a function whose return value is never dynamic uniform.
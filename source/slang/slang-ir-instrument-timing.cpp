@@ -0,0 +1,137 @@
+// slang-ir-instrument-timing.cpp
+#include "slang-ir-instrument-timing.h"
+
+#include "../compiler-core/slang-artifact-associated-impl.h"
+#include "slang-ir-inline.h"
+#include "slang-ir-insts.h"
+#include "slang-ir.h"
+
+namespace Slang
+{
+
+static IRFunc* _findKnownBuiltinFunc(IRModule* module, UnownedStringSlice name)
+{
+    for (auto globalInst : module->getGlobalInsts())
+    {
+        if (auto knownBuiltin = globalInst->findDecoration<IRKnownBuiltinDecoration>())
+        {
+            if (knownBuiltin->getName() == name)
+                return as<IRFunc>(globalInst);
+        }
+    }
+    return nullptr;
+}
+
+static IRGlobalParam* _findTimingBuffer(IRModule* module, UnownedStringSlice name)
+{
+    for (auto globalInst : module->getGlobalInsts())
+    {
+        auto param = as<IRGlobalParam>(globalInst);
+        if (!param)
+            continue;
+        auto nameHint = param->findDecoration<IRNameHintDecoration>();
+        if (!nameHint || nameHint->getName() != name)
+            continue;
+        auto bufferType = as<IRHLSLRWStructuredBufferType>(param->getDataType());
+        if (bufferType && bufferType->getElementType()->getOp() == kIROp_UIntType)
+            return param;
+    }
+    return nullptr;
+}
+
+void instrumentFunctionTiming(
+    IRModule* module,
+    UnownedStringSlice bufferName,
+    SourceManager* sourceManager,
+    List<InstrumentedFunction>& outFunctions,
+    DiagnosticSink* sink)
+{
+    // The helpers are linked in by `linkIR` when the option is set (and the target has a
+    // clock to read), and are kept alive until now.
+    IRFunc* readClock = _findKnownBuiltinFunc(module, UnownedStringSlice("InstrumentationClock"));
+    IRFunc* recordTime =
+        _findKnownBuiltinFunc(module, UnownedStringSlice("InstrumentationRecord"));
+    if (!readClock || !recordTime)
+        return;
+
+    List<IRFunc*> funcs;
+    auto buffer = _findTimingBuffer(module, bufferName);
+    if (!buffer)
+    {
+        sink->diagnose(SourceLoc(), Diagnostics::timingBufferNotFound, bufferName);
+    }
+    else
+    {
+        // Only the functions written by the user are instrumented. The functions of the
+        // core modules are mostly small, and their time is counted in their callers.
+        //
+        for (auto globalInst : module->getGlobalInsts())
+        {
+            auto func = as<IRFunc>(globalInst);
+            if (!func || func == readClock || func == recordTime || !func->getFirstBlock())
+                continue;
+            if (!func->sourceLoc.isValid())
+                continue;
+
+            auto humaneLoc = sourceManager->getHumaneLoc(func->sourceLoc);
+            String filePath = humaneLoc.pathInfo.getName();
+            if (filePath.endsWith(".meta.slang"))
+                continue;
+
+            InstrumentedFunction instrumented;
+            if (auto nameHint = func->findDecoration<IRNameHintDecoration>())
+                instrumented.name = nameHint->getName();
+            instrumented.filePath = filePath;
+            instrumented.line = humaneLoc.line;
+            outFunctions.add(instrumented);
+            funcs.add(func);
+        }
+    }
+
+    IRBuilder builder(module);
+    auto uintType = builder.getUIntType();
+    List<IRCall*> calls;
+    for (Index slot = 0; slot < funcs.getCount(); ++slot)
+    {
+        auto func = funcs[slot];
+
+        List<IRInst*> returns;
+        for (auto block : func->getBlocks())
+        {
+            if (auto terminator = as<IRReturn>(block->getTerminator()))
+                returns.add(terminator);
+        }
+
+        builder.setInsertBefore(func->getFirstBlock()->getFirstOrdinaryInst());
+        auto startTime = builder.emitCallInst(uintType, readClock, 0, nullptr);
+        calls.add(startTime);
+
+        for (auto ret : returns)
+        {
+            builder.setInsertBefore(ret);
+            auto endTime = builder.emitCallInst(uintType, readClock, 0, nullptr);
+            IRInst* args[] = {
+                builder.emitRWStructuredBufferGetElementPtr(
+                    buffer,
+                    builder.getIntValue(uintType, 2 * slot)),
+                builder.emitRWStructuredBufferGetElementPtr(
+                    buffer,
+                    builder.getIntValue(uintType, 2 * slot + 1)),
+                startTime,
+                endTime};
+            calls.add(endTime);
+            calls.add(builder.emitCallInst(builder.getVoidType(), recordTime, 4, args));
+        }
+    }
+
+    // Force inlining has already run, so the helpers are inlined here.
+    for (auto call : calls)
+        inlineCall(call);
+
+    for (auto func : {readClock, recordTime})
+    {
+        if (auto keepAlive = func->findDecoration<IRKeepAliveDecoration>())
+            keepAlive->removeAndDeallocate();
+    }
+}
+} // namespace Slang
@@ -0,0 +1,25 @@
+// slang-ir-instrument-timing.h
+#pragma once
+
+#include "../core/slang-basic.h"
+
+namespace Slang
+{
+struct IRModule;
+class DiagnosticSink;
+class SourceManager;
+struct InstrumentedFunction;
+
+/// Add code to each function of user code that records the time spent in it, and the
+/// number of times it was called, in the global `RWStructuredBuffer<uint>` named `bufferName`.
+///
+/// The function at index `i` of `outFunctions` accumulates its time at index `2 * i` of the
+/// buffer and its call count at index `2 * i + 1`. The clock is read with the helpers of the
+/// core module that `linkIR` links in for `-instrument-timing`.
+void instrumentFunctionTiming(
+    IRModule* module,
+    UnownedStringSlice bufferName,
+    SourceManager* sourceManager,
+    List<InstrumentedFunction>& outFunctions,
+    DiagnosticSink* sink);
+} // namespace Slang
@@ -1036,6 +1036,29 @@ struct IRCheckpointIntermediateDecoration : IRCheckpointHintDecoration
     IRInst* getSourceFunction() { return getOperand(0); }
 };
 
+struct IRDispatchWeightDecoration : IRDecoration
+{
+    enum
+    {
+        kOp = kIROp_DispatchWeightDecoration
+    };
+    IR_LEAF_ISA(DispatchWeightDecoration)
+
+    IRIntegerValue getWeight() { return cast<IRIntLit>(getOperand(0))->getValue(); }
+};
+
+struct IRCheckpointPolicyDecoration : IRDecoration
+{
+    enum
+    {
+        kOp = kIROp_CheckpointPolicyDecoration
+    };
+    IR_LEAF_ISA(CheckpointPolicyDecoration)
+
+    /// One of the `CheckpointPolicyKind` values
+    IRIntegerValue getPolicy() { return cast<IRIntLit>(getOperand(0))->getValue(); }
+};
+
 struct IRLoopCounterDecoration : IRDecoration
 {
     enum
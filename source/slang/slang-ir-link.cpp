@@ -5,6 +5,7 @@
 #include "../core/slang-performance-profiler.h"
 #include "slang-capability.h"
 #include "slang-ir-autodiff.h"
+#include "slang-ir-clone.h"
 #include "slang-ir-insts.h"
 #include "slang-ir-layout.h"
 #include "slang-ir-specialize-target-switch.h"
@@ -23,6 +24,8 @@ namespace Slang
 /// for an explanation of the problems.
 EntryPointLayout* findEntryPointLayout(ProgramLayout* programLayout, EntryPoint* entryPoint);
 
+bool isCPUTarget(TargetRequest* targetReq);
+
 struct IRSpecSymbol : RefObject
 {
     IRInst* irGlobalValue;
@@ -38,6 +41,86 @@ struct IRSpecEnv
     ClonedValueDictionary clonedValues;
 };
 
+/// The symbol table used to look up the definitions available for linking.
+///
+/// A symbol table only references instructions in the *original* modules
+/// and is never modified once it has been built, so it can be shared by
+/// every `linkIR` call made for the same `TargetProgram` (e.g., when each
+/// entry point of a program is compiled separately).
+///
+/// A table can be layered on a `parent` table, which is consulted for the
+/// names the table itself doesn't have. This is used to index the core
+/// modules only once per session, instead of once per target program.
+/// Looking a name up in a layered table gives the same chain of symbols
+/// as in a single table built from the parent's modules followed by the
+/// table's own modules.
+///
+struct IRLinkSymbolTable : RefObject
+{
+    // A map from mangled symbol names to zero or
+    // more global IR values that have that name,
+    // in the *original* module.
+    //
+    // The names are owned by the string literals of the original modules,
+    // which outlive the table just like the values it refers to, so
+    // building the table doesn't copy any strings.
+    typedef Dictionary<UnownedStringSlice, RefPtr<IRSpecSymbol>> SymbolDictionary;
+    SymbolDictionary symbols;
+
+    // String literals are deduplicated within a module, so the literal that
+    // holds a mangled name in an original module identifies that name. This
+    // lets the symbol for a linkage decoration be found by hashing a pointer
+    // rather than the whole name.
+    Dictionary<IRInst*, IRSpecSymbol*> symbolsByNameLit;
+
+    // The global values marked `[KnownBuiltin]`, by their known name. Passes that need
+    // to call a function of the core module find it here to link it in explicitly.
+    Dictionary<UnownedStringSlice, IRInst*> knownBuiltins;
+
+    // The table that is consulted for names that aren't in `symbols`.
+    // It is owned by the session or the program, and outlives this table.
+    IRLinkSymbolTable* parent = nullptr;
+
+    // The modules that were inserted, in order.
+    List<IRModule*> modules;
+
+    // The layout module that was included when the table was built.
+    IRModule* irModuleForLayout = nullptr;
+
+    IRSpecSymbol* findSymbol(UnownedStringSlice mangledName)
+    {
+        if (auto found = symbols.tryGetValue(mangledName))
+            return *found;
+        return parent ? parent->findSymbol(mangledName) : nullptr;
+    }
+
+    IRSpecSymbol* findSymbol(IRLinkageDecoration* linkage)
+    {
+        // When a name of the parent gets more symbols in this table, the
+        // literals of the parent's symbols for it are mapped to the chain
+        // of this table (see `insertGlobalValueSymbol`), so a literal that
+        // isn't found here can be looked up in the parent directly.
+        //
+        auto nameLit = linkage->getMangledNameOperand();
+        for (auto table = this; table; table = table->parent)
+        {
+            if (auto found = table->symbolsByNameLit.tryGetValue(nameLit))
+                return *found;
+        }
+        return findSymbol(linkage->getMangledName());
+    }
+
+    IRInst* findKnownBuiltin(UnownedStringSlice name)
+    {
+        for (auto table = this; table; table = table->parent)
+        {
+            if (auto found = table->knownBuiltins.tryGetValue(name))
+                return *found;
+        }
+        return nullptr;
+    }
+};
+
 struct IRSharedSpecContext
 {
     // The code-generation target in use
@@ -49,11 +132,8 @@ struct IRSharedSpecContext
     // The specialized module we are building
     RefPtr<IRModule> module;
 
-    // A map from mangled symbol names to zero or
-    // more global IR values that have that name,
-    // in the *original* module.
-    typedef Dictionary<String, RefPtr<IRSpecSymbol>> SymbolDictionary;
-    SymbolDictionary symbols;
+    typedef IRLinkSymbolTable::SymbolDictionary SymbolDictionary;
+    RefPtr<IRLinkSymbolTable> symbolTable;
 
     IRBuilder builderStorage;
 
@@ -69,7 +149,7 @@ struct IRSpecContextBase
 
     IRModule* getModule() { return getShared()->module; }
 
-    IRSharedSpecContext::SymbolDictionary& getSymbols() { return getShared()->symbols; }
+    IRLinkSymbolTable* getSymbolTable() { return getShared()->symbolTable; }
 
     // The current specialization environment to use.
     IRSpecEnv* env = nullptr;
@@ -758,9 +838,10 @@ void cloneGlobalValueWithCodeCommon(
     }
 }
 
-void checkIRDuplicate(IRInst* inst, IRInst* moduleInst, UnownedStringSlice const& mangledName)
+void checkIRDuplicate(IRInst* inst, IRInst* moduleInst, IRStringLit* mangledName)
 {
 #ifdef _DEBUG
+    // String literals are deduplicated within the module, so names can be compared by identity.
     for (auto child : moduleInst->getDecorationsAndChildren())
     {
         if (child == inst)
@@ -768,7 +849,7 @@ void checkIRDuplicate(IRInst* inst, IRInst* moduleInst, UnownedStringSlice const
 
         if (auto childLinkage = child->findDecoration<IRLinkageDecoration>())
         {
-            if (mangledName == childLinkage->getMangledName())
+            if (mangledName == childLinkage->getMangledNameOperand())
             {
                 SLANG_UNEXPECTED("duplicate global instruction");
             }
@@ -806,7 +887,7 @@ void cloneFunctionCommon(
             checkIRDuplicate(
                 clonedFunc,
                 context->getModule()->getModuleInst(),
-                linkage->getMangledName());
+                linkage->getMangledNameOperand());
         }
     }
 }
@@ -886,12 +967,13 @@ IRFunc* specializeIRForEntryPoint(
     // so that the mangled name of the decl-ref is
     // not the same as the mangled name of the decl.
     //
-    RefPtr<IRSpecSymbol> sym;
-    if (!context->getSymbols().tryGetValue(mangledName, sym))
+    IRSpecSymbol* sym = context->getSymbolTable()->findSymbol(mangledName.getUnownedSlice());
+    if (!sym)
     {
         String hashedName = getHashedName(mangledName.getUnownedSlice());
 
-        if (!context->getSymbols().tryGetValue(hashedName, sym))
+        sym = context->getSymbolTable()->findSymbol(hashedName.getUnownedSlice());
+        if (!sym)
         {
             SLANG_UNEXPECTED("no matching IR symbol");
             return nullptr;
@@ -1326,9 +1408,8 @@ IRInst* cloneGlobalValueWithLinkage(
     // with the same mangled name as `originalVal` and try
     // to pick the "best" one for our target.
 
-    auto mangledName = String(originalLinkage->getMangledName());
-    RefPtr<IRSpecSymbol> sym;
-    if (!context->getSymbols().tryGetValue(mangledName, sym))
+    IRSpecSymbol* sym = context->getSymbolTable()->findSymbol(originalLinkage);
+    if (!sym)
     {
         if (!originalVal)
             return nullptr;
@@ -1385,7 +1466,7 @@ IRInst* cloneGlobalValue(IRSpecContext* context, IRInst* originalVal)
         originalVal->findDecoration<IRLinkageDecoration>());
 }
 
-void insertGlobalValueSymbol(IRSharedSpecContext* sharedContext, IRInst* gv)
+void insertGlobalValueSymbol(IRLinkSymbolTable* symbolTable, IRInst* gv)
 {
     auto linkage = gv->findDecoration<IRLinkageDecoration>();
 
@@ -1395,32 +1476,96 @@ void insertGlobalValueSymbol(IRSharedSpecContext* sharedContext, IRInst* gv)
     if (!linkage)
         return;
 
-    auto mangledName = String(linkage->getMangledName());
+    auto mangledName = linkage->getMangledName();
+
+    if (auto knownBuiltin = gv->findDecoration<IRKnownBuiltinDecoration>())
+        symbolTable->knownBuiltins[knownBuiltin->getName()] = gv;
 
     RefPtr<IRSpecSymbol> sym = new IRSpecSymbol();
     sym->irGlobalValue = gv;
 
-    RefPtr<IRSpecSymbol> prev;
-    if (sharedContext->symbols.tryGetValue(mangledName, prev))
+    RefPtr<IRSpecSymbol>* found = symbolTable->symbols.tryGetValue(mangledName);
+    IRSpecSymbol* prev = found ? found->Ptr() : nullptr;
+
+    // The parent table is shared and so can't be changed. If it has the
+    // name, this table gets its own copy of the parent's chain, which the
+    // new symbol is then added to exactly as if the parent's modules had
+    // been inserted into this table.
+    //
+    IRSpecSymbol* parentSym =
+        (!prev && symbolTable->parent) ? symbolTable->parent->findSymbol(mangledName) : nullptr;
+    if (parentSym)
+    {
+        RefPtr<IRSpecSymbol> head;
+        IRSpecSymbol* tail = nullptr;
+        for (auto ps = parentSym; ps; ps = ps->nextWithSameName)
+        {
+            RefPtr<IRSpecSymbol> copy = new IRSpecSymbol();
+            copy->irGlobalValue = ps->irGlobalValue;
+            if (tail)
+                tail->nextWithSameName = copy;
+            else
+                head = copy;
+            tail = copy;
+        }
+        symbolTable->symbols.add(mangledName, head);
+        prev = head;
+
+        for (auto ps = parentSym; ps; ps = ps->nextWithSameName)
+        {
+            auto psLinkage = ps->irGlobalValue->findDecoration<IRLinkageDecoration>();
+            symbolTable->symbolsByNameLit[psLinkage->getMangledNameOperand()] = prev;
+        }
+    }
+
+    if (prev)
     {
         sym->nextWithSameName = prev->nextWithSameName;
         prev->nextWithSameName = sym;
+        symbolTable->symbolsByNameLit[linkage->getMangledNameOperand()] = prev;
     }
     else
     {
-        sharedContext->symbols.add(mangledName, sym);
+        symbolTable->symbols.add(mangledName, sym);
+        symbolTable->symbolsByNameLit[linkage->getMangledNameOperand()] = sym;
     }
 }
 
-void insertGlobalValueSymbols(IRSharedSpecContext* sharedContext, IRModule* originalModule)
+void insertGlobalValueSymbols(IRLinkSymbolTable* symbolTable, IRModule* originalModule)
 {
+    symbolTable->modules.add(originalModule);
     if (!originalModule)
         return;
 
     for (auto ii : originalModule->getGlobalInsts())
     {
-        insertGlobalValueSymbol(sharedContext, ii);
+        insertGlobalValueSymbol(symbolTable, ii);
+    }
+}
+
+// Get the symbol table of the session for the IR of its core modules,
+// building it if there isn't one yet or more core modules have been
+// loaded since it was built.
+//
+static IRLinkSymbolTable* getCoreModuleLinkSymbolTable(
+    Session* session,
+    ArrayView<IRModule*> coreIRModules)
+{
+    std::lock_guard<std::mutex> lock(session->coreModuleLinkSymbolTablesMutex);
+
+    auto& tables = session->coreModuleLinkSymbolTables;
+    if (tables.getCount())
+    {
+        auto table = static_cast<IRLinkSymbolTable*>(tables.getLast().Ptr());
+        if (table->modules.getArrayView() == coreIRModules)
+            return table;
     }
+
+    RefPtr<IRLinkSymbolTable> table = new IRLinkSymbolTable();
+    for (auto irModule : coreIRModules)
+        insertGlobalValueSymbols(table, irModule);
+    tables.add(table);
+    return table;
 }
 
 void initializeSharedSpecContext(
@@ -1433,7 +1578,8 @@ void initializeSharedSpecContext(
     RefPtr<IRModule> module = inModule;
     if (!module)
     {
-        module = IRModule::create(session);
+        // The linked module only lives for the code generation of one program.
+        module = IRModule::createScratch(session);
     }
 
     sharedContext->builderStorage = IRBuilder(module);
@@ -1541,6 +1687,79 @@ static bool doesTargetAllowUnresolvedFuncSymbol(TargetRequest* req)
     }
 }
 
+/// Replace the link-time constants of `module` that no linked module provided a value for
+/// with specialization constants, so that their values can be chosen when the target code is
+/// used rather than by linking and generating code again.
+///
+/// Only constants of scalar type are replaced. They are assigned constant ids after the
+/// largest id used by the other specialization constants in the program, and are named
+/// after the constant.
+///
+static void replaceUnresolvedConstantsWithSpecializationConstants(IRModule* module)
+{
+    List<IRGlobalConstant*> unresolvedConstants;
+    UInt nextConstantId = 0;
+    for (auto globalInst : module->getGlobalInsts())
+    {
+        if (auto constant = as<IRGlobalConstant>(globalInst))
+        {
+            if (constant->getOperandCount() == 0 &&
+                constant->findDecoration<IRImportDecoration>() &&
+                as<IRBasicType>(constant->getDataType()))
+            {
+                unresolvedConstants.add(constant);
+            }
+        }
+        else if (auto globalParam = as<IRGlobalParam>(globalInst))
+        {
+            auto layoutDecoration = globalParam->findDecoration<IRLayoutDecoration>();
+            auto varLayout = layoutDecoration ? as<IRVarLayout>(layoutDecoration->getLayout())
+                                              : nullptr;
+            if (!varLayout)
+                continue;
+            if (auto offsetAttr =
+                    varLayout->findOffsetAttr(LayoutResourceKind::SpecializationConstant))
+            {
+                nextConstantId = Math::Max(nextConstantId, UInt(offsetAttr->getOffset()) + 1);
+            }
+        }
+    }
+
+    IRBuilder builder(module);
+    for (auto constant : unresolvedConstants)
+    {
+        builder.setInsertBefore(constant);
+
+        auto type = constant->getDataType();
+        auto param = builder.createGlobalParam(type);
+
+        IRTypeLayout::Builder typeLayoutBuilder(&builder);
+        typeLayoutBuilder.addResourceUsage(
+            LayoutResourceKind::SpecializationConstant,
+            LayoutSize::fromRaw(1));
+        IRVarLayout::Builder varLayoutBuilder(&builder, typeLayoutBuilder.build());
+        varLayoutBuilder.findOrAddResourceInfo(LayoutResourceKind::SpecializationConstant)->offset =
+            nextConstantId++;
+        builder.addLayoutDecoration(param, varLayoutBuilder.build());
+
+        // The default value of the constant is zero (or false).
+        IRInst* defaultValue = nullptr;
+        if (as<IRBoolType>(type))
+            defaultValue = builder.getBoolValue(false);
+        else if (isFloatingType(type))
+            defaultValue = builder.getFloatValue(type, 0.0);
+        else
+            defaultValue = builder.getIntValue(type, 0);
+        builder.addDefaultValueDecoration(param, defaultValue);
+
+        if (auto nameHint = constant->findDecoration<IRNameHintDecoration>())
+            builder.addNameHintDecoration(param, nameHint->getName());
+
+        constant->replaceUsesWith(param);
+        constant->removeAndDeallocate();
+    }
+}
+
 static void diagnoseUnresolvedSymbols(TargetRequest* req, DiagnosticSink* sink, IRModule* module)
 {
     for (auto globalSym : module->getGlobalInsts())
@@ -1734,6 +1953,42 @@ void GLSLReplaceAtomicUint(IRSpecContext* context, TargetProgram* targetProgram,
     convertAtomicToStorageBuffer(context, bindingToInstMapUnsorted);
 }
 
+/// Clone the layout of the global-scope parameters, `originalVarLayout`.
+///
+/// The fields of the layout refer to every global parameter of the program, and so
+/// cloning all of them would also clone every parameter, along with its type and
+/// layout, whether or not any entry point uses it. When `shouldPrune` is set, the
+/// fields for global parameters that haven't been cloned yet are left out instead.
+///
+static IRVarLayout* _cloneGlobalScopeVarLayout(
+    IRSpecContext* context,
+    IRVarLayout* originalVarLayout,
+    bool shouldPrune)
+{
+    auto originalTypeLayout = as<IRStructTypeLayout>(originalVarLayout->getTypeLayout());
+    if (shouldPrune && originalTypeLayout)
+    {
+        List<IRInst*> operands;
+        for (UInt i = 0; i < originalTypeLayout->getOperandCount(); ++i)
+        {
+            auto operand = originalTypeLayout->getOperand(i);
+            if (auto fieldAttr = as<IRStructFieldLayoutAttr>(operand))
+            {
+                auto key = fieldAttr->getFieldKey();
+                if (as<IRGlobalParam>(key) && !findClonedValue(context, key))
+                    continue;
+            }
+            operands.add(cloneValue(context, operand));
+        }
+
+        // The var layout refers to the pruned type layout in place of the original.
+        auto prunedTypeLayout =
+            context->builder->getTypeLayout(originalTypeLayout->getOp(), operands);
+        registerClonedValue(context, prunedTypeLayout, originalTypeLayout);
+    }
+    return cast<IRVarLayout>(cloneValue(context, originalVarLayout));
+}
+
 LinkedIR linkIR(CodeGenContext* codeGenContext)
 {
     SLANG_PROFILE;
@@ -1771,26 +2026,75 @@ LinkedIR linkIR(CodeGenContext* codeGenContext)
     List<IRModule*> irModules;
 
     // Link the core modules.
-    auto& coreModules = static_cast<Session*>(linkage->getGlobalSession())->coreModules;
-    for (auto& m : coreModules)
+    auto session = static_cast<Session*>(linkage->getGlobalSession());
+    for (auto& m : session->coreModules)
         irModules.add(m->getIRModule());
+    const Index coreModuleCount = irModules.getCount();
+
+    // Modules whose lowering was deferred are lowered now, so that their diagnostics are
+    // reported with the rest of the compile.
+    for (auto module : program->getModuleDependencies())
+        module->ensureIRModule(codeGenContext->getSink());
 
     // Link modules in the program.
     program->enumerateIRModules([&](IRModule* irModule) { irModules.add(irModule); });
 
-    // Add any modules that were loaded as libraries
-    for (IRModule* irModule : irModules)
-    {
-        insertGlobalValueSymbols(sharedContext, irModule);
-    }
-
     // We will also insert the IR global symbols from the IR module
     // attached to the `TargetProgram`, since this module is
     // responsible for associating layout information to those
     // global symbols via decorations.
     //
-    auto irModuleForLayout = targetProgram->getExistingIRModuleForLayout();
-    insertGlobalValueSymbols(sharedContext, irModuleForLayout);
+    auto irModuleForLayout = targetProgram->getOrCreateIRModuleForLayout(codeGenContext->getSink());
+
+    // Building the symbol table requires a walk over every global
+    // instruction of every module involved, which is the same for all
+    // the entry points of a target program. We therefore build it once
+    // per `TargetProgram` and reuse it for each subsequent link.
+    //
+    // The core modules make up most of those instructions and are the
+    // same for every program, so their symbols are put in a table of
+    // their own that is built once per session. The other modules of
+    // the program are the same for every target, so their symbols are
+    // put in a table that is built once per program, and layered on the
+    // table of the core modules. Only the layout module is specific to
+    // the target, and the table of each target program holds just its
+    // symbols, layered on the table of the program.
+    //
+    auto coreSymbolTable =
+        getCoreModuleLinkSymbolTable(session, irModules.getArrayView(0, coreModuleCount));
+    const auto programIRModules =
+        irModules.getArrayView(coreModuleCount, irModules.getCount() - coreModuleCount);
+
+    RefPtr<IRLinkSymbolTable> programSymbolTable =
+        static_cast<IRLinkSymbolTable*>(program->getLinkSymbolTable());
+    if (!programSymbolTable || programSymbolTable->parent != coreSymbolTable ||
+        programSymbolTable->modules.getArrayView() != programIRModules)
+    {
+        programSymbolTable = new IRLinkSymbolTable();
+        programSymbolTable->parent = coreSymbolTable;
+
+        // Add any modules that were loaded as libraries
+        for (auto irModule : programIRModules)
+        {
+            insertGlobalValueSymbols(programSymbolTable, irModule);
+        }
+
+        program->setLinkSymbolTable(programSymbolTable);
+    }
+
+    RefPtr<IRLinkSymbolTable> symbolTable =
+        static_cast<IRLinkSymbolTable*>(targetProgram->getLinkSymbolTable());
+    if (!symbolTable || symbolTable->irModuleForLayout != irModuleForLayout ||
+        symbolTable->parent != programSymbolTable)
+    {
+        symbolTable = new IRLinkSymbolTable();
+        symbolTable->irModuleForLayout = irModuleForLayout;
+        symbolTable->parent = programSymbolTable;
+        insertGlobalValueSymbols(symbolTable, irModuleForLayout);
+
+        targetProgram->setLinkSymbolTable(symbolTable);
+    }
+    sharedContext->symbolTable = symbolTable;
 
     auto context = state->getContext();
 
@@ -1836,23 +2140,6 @@ LinkedIR linkIR(CodeGenContext* codeGenContext)
             nameOverride.getUnownedSlice()));
     }
 
-    // Layout information for global shader parameters is also required,
-    // and in particular every global parameter that is part of the layout
-    // should be present in the initial IR module so that steps that
-    // need to operate on all the global parameters can do so.
-    //
-    IRVarLayout* irGlobalScopeVarLayout = nullptr;
-    if (irModuleForLayout)
-    {
-        if (auto irGlobalScopeLayoutDecoration =
-                irModuleForLayout->getModuleInst()->findDecoration<IRLayoutDecoration>())
-        {
-            auto irOriginalGlobalScopeVarLayout = irGlobalScopeLayoutDecoration->getLayout();
-            irGlobalScopeVarLayout =
-                cast<IRVarLayout>(cloneValue(context, irOriginalGlobalScopeVarLayout));
-        }
-    }
-
     // Bindings for global generic parameters are currently represented
     // as stand-alone global-scope instructions in the IR module for
     // `SpecializedComponentType`s. These instructions are required for
@@ -1897,6 +2184,72 @@ LinkedIR linkIR(CodeGenContext* codeGenContext)
         }
     }
 
+    // The atomics that `aggregateUniformAtomics` rewrites are only known once the
+    // program has been specialized, so the functions it replaces them with are linked
+    // in now, and kept alive until the pass has run.
+    //
+    if (!isCPUTarget(targetReq) &&
+        targetProgram->getOptionSet().getBoolOption(CompilerOptionName::AggregateUniformAtomics))
+    {
+        for (auto name : {"WaveAggregatedAtomicAddUInt", "WaveAggregatedAtomicAddInt"})
+        {
+            auto helper = symbolTable->findKnownBuiltin(UnownedStringSlice(name));
+            if (!helper)
+                continue;
+            auto cloned = cloneValue(context, helper);
+            if (!cloned->findDecorationImpl(kIROp_KeepAliveDecoration))
+                context->builder->addKeepAliveDecoration(cloned);
+        }
+    }
+
+    // The same goes for the helpers that `instrumentFunctionTiming` adds calls to, on the
+    // targets that have a clock they can read.
+    //
+    if ((isD3DTarget(targetReq) || isKhronosTarget(targetReq) || isCUDATarget(targetReq) ||
+         isCPUTarget(targetReq)) &&
+        targetProgram->getOptionSet().hasOption(CompilerOptionName::InstrumentTiming))
+    {
+        for (auto name : {"InstrumentationClock", "InstrumentationRecord"})
+        {
+            auto helper = symbolTable->findKnownBuiltin(UnownedStringSlice(name));
+            if (!helper)
+                continue;
+            auto cloned = cloneValue(context, helper);
+            if (!cloned->findDecorationImpl(kIROp_KeepAliveDecoration))
+                context->builder->addKeepAliveDecoration(cloned);
+        }
+    }
+
+    // Layout information for global shader parameters is also required.
+    //
+    // When the global-scope parameters are packaged up into a single
+    // structure (see `collectGlobalUniformParameters`), or when the user asked
+    // for all parameters to be preserved, every global parameter that is part
+    // of the layout must be present in the linked module. Otherwise the only
+    // parameters needed are the ones that were cloned above because something
+    // references them, and the layout is pruned down to those, so that programs
+    // with many unused parameters don't pay for cloning them.
+    //
+    IRVarLayout* irGlobalScopeVarLayout = nullptr;
+    if (irModuleForLayout)
+    {
+        if (auto irGlobalScopeLayoutDecoration =
+                irModuleForLayout->getModuleInst()->findDecoration<IRLayoutDecoration>())
+        {
+            auto irOriginalGlobalScopeVarLayout =
+                cast<IRVarLayout>(irGlobalScopeLayoutDecoration->getLayout());
+            auto irOriginalGlobalScopeTypeLayout = irOriginalGlobalScopeVarLayout->getTypeLayout();
+            bool shouldPruneLayout =
+                !shouldCopyGlobalParams &&
+                as<IRStructTypeLayout>(irOriginalGlobalScopeTypeLayout) &&
+                !irOriginalGlobalScopeTypeLayout->findSizeAttr(LayoutResourceKind::Uniform);
+            irGlobalScopeVarLayout = _cloneGlobalScopeVarLayout(
+                context,
+                irOriginalGlobalScopeVarLayout,
+                shouldPruneLayout);
+        }
+    }
+
     // It is possible that metadata has been attached to the input modules
     // themselves, which should be copied over to the output module.
     //
@@ -1938,6 +2291,15 @@ LinkedIR linkIR(CodeGenContext* codeGenContext)
     // Specialize target_switch branches to use the best branch for the target.
     specializeTargetSwitch(targetReq, state->irModule, codeGenContext->getSink());
 
+    // Link-time constants that weren't provided can become specialization constants
+    // on targets that support them, if requested.
+    if (isKhronosTarget(targetReq) &&
+        targetProgram->getOptionSet().getBoolOption(
+            CompilerOptionName::LinkTimeSpecializationConstants))
+    {
+        replaceUnresolvedConstantsWithSpecializationConstants(state->irModule);
+    }
+
     // Diagnose on unresolved symbols if we are compiling into a target that does
     // not allow incomplete symbols.
     // At this point, we should not see any [import] symbols that does not have a
@@ -2025,5 +2387,445 @@ void replaceGlobalConstants(IRModule* module)
     pass.process(module);
 }
 
+/// A cache of the generic functions specialized while compiling a `TargetProgram`.
+///
+/// Each entry point of a program that is compiled separately gets its own linked
+/// module, and so would otherwise specialize the same generics again. The cache
+/// keeps a copy of each specialized function in a module of its own, from which
+/// later specialization passes can clone it.
+///
+/// Global values with linkage that the cached functions refer to are represented
+/// in the cache module by placeholders that only carry the linkage, and are bound
+/// by mangled name to the matching values of the module a function is cloned into.
+///
+struct IRSpecializationCache : RefObject
+{
+    RefPtr<IRModule> module;
+
+    // The cached specializations, by specialization cache key. This includes
+    // specialized types and witness tables that the cached functions refer to.
+    Dictionary<String, IRInst*> specializations;
+    Dictionary<IRInst*, String> specializationKeys;
+
+    // The placeholders for global values with linkage, by mangled name.
+    Dictionary<String, IRInst*> placeholders;
+};
+
+static bool _appendSpecializationCacheKey(StringBuilder& sb, IRInst* inst)
+{
+    if (!inst)
+    {
+        sb << "N";
+        return true;
+    }
+
+    if (auto linkage = inst->findDecoration<IRLinkageDecoration>())
+    {
+        auto mangledName = linkage->getMangledName();
+        sb << "L" << mangledName.getLength() << ":" << mangledName;
+        return true;
+    }
+
+    switch (inst->getOp())
+    {
+    case kIROp_IntLit:
+    case kIROp_BoolLit:
+        sb << "C";
+        if (!_appendSpecializationCacheKey(sb, inst->getDataType()))
+            return false;
+        sb << static_cast<IRConstant*>(inst)->value.intVal << ";";
+        return true;
+
+    default:
+        break;
+    }
+
+    // Any other constants, and values that aren't hoistable (such as a struct
+    // type without linkage), are only identified by their instruction.
+    //
+    if (as<IRConstant>(inst) || !getIROpInfo(inst->getOp()).isHoistable())
+        return false;
+
+    sb << "(" << Int(inst->getOp());
+    if (!_appendSpecializationCacheKey(sb, inst->getFullType()))
+        return false;
+    for (UInt i = 0; i < inst->getOperandCount(); i++)
+    {
+        sb << ",";
+        if (!_appendSpecializationCacheKey(sb, inst->getOperand(i)))
+            return false;
+    }
+    sb << ")";
+    return true;
+}
+
+bool getSpecializationCacheKey(IRSimpleSpecializationKey const& key, StringBuilder& outKey)
+{
+    for (auto val : key.vals)
+    {
+        if (!_appendSpecializationCacheKey(outKey, val))
+            return false;
+        outKey << ";";
+    }
+    return true;
+}
+
+/// How a global value referenced by a specialization is handled when it is cloned
+/// into or out of a specialization cache.
+enum class SpecializationCacheRef
+{
+    Bound,       ///< Bound to an existing value of the destination module
+    Cloned,      ///< Cloned along with the specialization
+    Unsupported, ///< Can't be cloned, so the specialization can't be either
+};
+
+/// Check whether every global value (transitively) referenced by `root` can be cloned
+/// into another module, according to `classify`.
+template<typename F>
+static bool _canCloneSpecialization(IRInst* root, F const& classify)
+{
+    auto moduleInst = root->getModule()->getModuleInst();
+
+    HashSet<IRInst*> visitedGlobals;
+    visitedGlobals.add(root);
+    List<IRInst*> globalsToScan;
+    globalsToScan.add(root);
+
+    List<IRInst*> instsToScan;
+    while (globalsToScan.getCount())
+    {
+        instsToScan.clear();
+        instsToScan.add(globalsToScan.getLast());
+        globalsToScan.removeLast();
+        while (instsToScan.getCount())
+        {
+            auto inst = instsToScan.getLast();
+            instsToScan.removeLast();
+
+            for (UInt i = 0; i <= inst->getOperandCount(); i++)
+            {
+                auto referenced = i == 0 ? inst->getFullType() : inst->getOperand(i - 1);
+                if (!referenced || referenced->getParent() != moduleInst)
+                    continue;
+                if (!visitedGlobals.add(referenced))
+                    continue;
+
+                switch (classify(referenced))
+                {
+                case SpecializationCacheRef::Bound:
+                    break;
+                case SpecializationCacheRef::Cloned:
+                    globalsToScan.add(referenced);
+                    break;
+                case SpecializationCacheRef::Unsupported:
+                    return false;
+                }
+            }
+
+            for (auto child : inst->getDecorationsAndChildren())
+                instsToScan.add(child);
+        }
+    }
+    return true;
+}
+
+/// The context for cloning specializations into or out of an `IRSpecializationCache`.
+///
+/// This reuses the cloning logic of the linker, except that global values with
+/// linkage are never cloned: they are replaced with a placeholder when cloning into
+/// the cache, and bound to the value with the same mangled name when cloning out.
+///
+struct IRSpecializationCacheContext : IRSpecContext
+{
+    IRSpecializationCache* cache = nullptr;
+
+    // The module that values are being cloned from.
+    IRModule* sourceModule = nullptr;
+
+    // The cache keys of the specializations in `sourceModule`.
+    Dictionary<IRInst*, String>* sourceKeys = nullptr;
+
+    // When cloning out of the cache, the global values with linkage and the
+    // specializations in the destination module. Null when cloning into the cache.
+    Dictionary<String, IRInst*>* moduleSymbols = nullptr;
+    Dictionary<String, IRInst*>* moduleSpecializations = nullptr;
+
+    virtual IRInst* maybeCloneValue(IRInst* originalValue) override
+    {
+        if (originalValue->getParent() != sourceModule->getModuleInst())
+            return IRSpecContext::maybeCloneValue(originalValue);
+
+        if (auto linkage = originalValue->findDecoration<IRLinkageDecoration>())
+        {
+            auto boundValue = moduleSymbols ? findModuleSymbol(originalValue, linkage)
+                                            : getPlaceholder(originalValue, linkage);
+            registerClonedValue(this, boundValue, originalValue);
+            return boundValue;
+        }
+
+        String key;
+        if (!sourceKeys->tryGetValue(originalValue, key))
+            return IRSpecContext::maybeCloneValue(originalValue);
+
+        // Specializations are made once per module, so those that are cloned
+        // along with a specialized function are shared with any existing one.
+        //
+        auto& specializations = moduleSpecializations ? *moduleSpecializations
+                                                      : cache->specializations;
+        IRInst* existing = nullptr;
+        if (specializations.tryGetValue(key, existing) && existing->getParent())
+        {
+            registerClonedValue(this, existing, originalValue);
+            return existing;
+        }
+
+        auto clonedValue = IRSpecContext::maybeCloneValue(originalValue);
+        specializations[key] = clonedValue;
+        if (!moduleSpecializations)
+            cache->specializationKeys[clonedValue] = key;
+        return clonedValue;
+    }
+
+    IRInst* findModuleSymbol(IRInst* originalValue, IRLinkageDecoration* linkage)
+    {
+        IRInst* symbol = nullptr;
+        moduleSymbols->tryGetValue(String(linkage->getMangledName()), symbol);
+        SLANG_ASSERT(symbol);
+        return symbol ? symbol : originalValue;
+    }
+
+    IRInst* getPlaceholder(IRInst* originalValue, IRLinkageDecoration* linkage)
+    {
+        String mangledName = linkage->getMangledName();
+        IRInst* placeholder = nullptr;
+        if (cache->placeholders.tryGetValue(mangledName, placeholder))
+            return placeholder;
+
+        IRBuilder builder(cache->module);
+        builder.setInsertInto(cache->module->getModuleInst());
+        placeholder = builder.createIntrinsicInst(nullptr, originalValue->getOp(), 0, nullptr);
+        builder.addInst(placeholder);
+
+        builder.setInsertInto(placeholder);
+        cloneInst(this, &builder, linkage);
+
+        cache->placeholders.add(mangledName, placeholder);
+        return placeholder;
+    }
+};
+
+static void _initializeSpecializationCacheContext(
+    IRSpecializationCacheContext& context,
+    IRSharedSpecContext& sharedContext,
+    IRModule* destinationModule)
+{
+    sharedContext.module = destinationModule;
+    sharedContext.builderStorage = IRBuilder(destinationModule);
+    sharedContext.builderStorage.setInsertInto(destinationModule->getModuleInst());
+
+    context.shared = &sharedContext;
+    context.builder = &sharedContext.builderStorage;
+    context.env = &sharedContext.globalEnv;
+}
+
+IRFunc* cloneCachedSpecialization(
+    TargetProgram* targetProgram,
+    IRModule* module,
+    String const& key,
+    Dictionary<String, IRInst*>& moduleSymbols,
+    Dictionary<String, IRInst*>& ioSpecializations)
+{
+    auto cache = static_cast<IRSpecializationCache*>(targetProgram->getSpecializationCache());
+    if (!cache)
+        return nullptr;
+
+    IRInst* cachedValue = nullptr;
+    if (!cache->specializations.tryGetValue(key, cachedValue))
+        return nullptr;
+    auto cachedFunc = as<IRFunc>(cachedValue);
+    if (!cachedFunc)
+        return nullptr;
+
+    if (moduleSymbols.getCount() == 0)
+    {
+        for (auto inst : module->getGlobalInsts())
+        {
+            if (auto linkage = inst->findDecoration<IRLinkageDecoration>())
+                moduleSymbols[String(linkage->getMangledName())] = inst;
+        }
+    }
+
+    // Everything the cached function refers to must either be cloned along with it,
+    // or already be in `module`; we don't try to link in other global values.
+    //
+    if (!_canCloneSpecialization(
+            cachedFunc,
+            [&](IRInst* inst)
+            {
+                if (auto linkage = inst->findDecoration<IRLinkageDecoration>())
+                {
+                    IRInst* symbol = nullptr;
+                    moduleSymbols.tryGetValue(String(linkage->getMangledName()), symbol);
+                    return symbol && symbol->getParent() ? SpecializationCacheRef::Bound
+                                                         : SpecializationCacheRef::Unsupported;
+                }
+                String instKey;
+                IRInst* existing = nullptr;
+                if (cache->specializationKeys.tryGetValue(inst, instKey) &&
+                    ioSpecializations.tryGetValue(instKey, existing) && existing->getParent())
+                {
+                    return SpecializationCacheRef::Bound;
+                }
+                return SpecializationCacheRef::Cloned;
+            }))
+    {
+        return nullptr;
+    }
+
+    IRSharedSpecContext sharedContext;
+    IRSpecializationCacheContext context;
+    _initializeSpecializationCacheContext(context, sharedContext, module);
+    context.cache = cache;
+    context.sourceModule = cache->module;
+    context.sourceKeys = &cache->specializationKeys;
+    context.moduleSymbols = &moduleSymbols;
+    context.moduleSpecializations = &ioSpecializations;
+
+    return cast<IRFunc>(cloneValue(&context, cachedFunc));
+}
+
+/// Check that the instructions of `func` only refer to global values and to other
+/// instructions of `func`, so that it can be cloned on its own.
+static bool _refersOnlyToGlobalsAndOwnInsts(IRFunc* func)
+{
+    auto moduleInst = func->getModule()->getModuleInst();
+
+    List<IRInst*> instsToScan;
+    instsToScan.add(func);
+    while (instsToScan.getCount())
+    {
+        auto inst = instsToScan.getLast();
+        instsToScan.removeLast();
+
+        for (UInt i = 0; i <= inst->getOperandCount(); i++)
+        {
+            auto referenced = i == 0 ? inst->getFullType() : inst->getOperand(i - 1);
+            if (!referenced || referenced->getParent() == moduleInst)
+                continue;
+
+            // Find the global value that the referenced instruction is nested in
+            auto ancestor = referenced;
+            while (ancestor && ancestor->getParent() != moduleInst)
+                ancestor = ancestor->getParent();
+            if (ancestor != func)
+                return false;
+        }
+
+        for (auto child : inst->getDecorationsAndChildren())
+            instsToScan.add(child);
+    }
+    return true;
+}
+
+/// Add the functions in `specializations` to the specialization cache of `targetProgram`.
+///
+/// When `canCloneLocalTypes` is set, struct types and keys without linkage can be cloned
+/// along with the functions that refer to them.
+static void _addCachedFunctions(
+    TargetProgram* targetProgram,
+    IRModule* module,
+    Dictionary<String, IRInst*> const& specializations,
+    bool canCloneLocalTypes)
+{
+    if (specializations.getCount() == 0)
+        return;
+
+    Dictionary<IRInst*, String> keys;
+    for (const auto& [key, value] : specializations)
+    {
+        if (value->getParent())
+            keys[value] = key;
+    }
+
+    // A cached function can refer to global values with linkage, and to other
+    // specializations, since both are shared with the module it is cloned into.
+    // Other functions it calls are cloned along with it. Anything else (e.g., a
+    // struct type made by existential specialization) has an identity that we can't
+    // preserve across modules, so we don't cache functions that refer to one. The
+    // struct types that autodiff makes for the intermediate values of a derivative are
+    // only used by the derivative functions, so those can be cloned along with them.
+    //
+    auto classify = [&](IRInst* inst)
+    {
+        if (inst->findDecoration<IRLinkageDecoration>())
+            return SpecializationCacheRef::Bound;
+        if (auto func = as<IRFunc>(inst))
+        {
+            return !canCloneLocalTypes || _refersOnlyToGlobalsAndOwnInsts(func)
+                       ? SpecializationCacheRef::Cloned
+                       : SpecializationCacheRef::Unsupported;
+        }
+        if (keys.containsKey(inst) || as<IRConstant>(inst) ||
+            getIROpInfo(inst->getOp()).isHoistable() ||
+            (canCloneLocalTypes && (as<IRStructType>(inst) || as<IRStructKey>(inst))))
+        {
+            return SpecializationCacheRef::Cloned;
+        }
+        return SpecializationCacheRef::Unsupported;
+    };
+
+    RefPtr<IRSpecializationCache> cache =
+        static_cast<IRSpecializationCache*>(targetProgram->getSpecializationCache());
+
+    IRSharedSpecContext sharedContext;
+    IRSpecializationCacheContext context;
+    for (const auto& [specializedValue, key] : keys)
+    {
+        // Only functions are worth caching, since the other specializations are
+        // cheap to make again. Functions with linkage are left out, as they would
+        // be bound to themselves when cloned out of the cache.
+        //
+        auto func = as<IRFunc>(specializedValue);
+        if (!func || !func->isDefinition() || func->findDecoration<IRLinkageDecoration>())
+            continue;
+        if (cache && cache->specializations.containsKey(key))
+            continue;
+        if (!_canCloneSpecialization(func, classify) ||
+            (canCloneLocalTypes && !_refersOnlyToGlobalsAndOwnInsts(func)))
+            continue;
+
+        if (!cache)
+        {
+            cache = new IRSpecializationCache();
+            cache->module = IRModule::create(module->getSession());
+            targetProgram->setSpecializationCache(cache);
+        }
+        if (!context.cache)
+        {
+            _initializeSpecializationCacheContext(context, sharedContext, cache->module);
+            context.cache = cache;
+            context.sourceModule = module;
+            context.sourceKeys = &keys;
+        }
+
+        cloneValue(&context, func);
+    }
+}
+
+void addCachedSpecializations(
+    TargetProgram* targetProgram,
+    IRModule* module,
+    Dictionary<String, IRInst*> const& specializations)
+{
+    _addCachedFunctions(targetProgram, module, specializations, false);
+}
+
+void addCachedDerivatives(
+    TargetProgram* targetProgram,
+    IRModule* module,
+    Dictionary<String, IRInst*> const& derivatives)
+{
+    _addCachedFunctions(targetProgram, module, derivatives, true);
+}
 
 } // namespace Slang
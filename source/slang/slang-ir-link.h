@@ -6,6 +6,7 @@
 
 namespace Slang
 {
+struct IRSimpleSpecializationKey;
 struct IRVarLayout;
 
 struct LinkedIR
@@ -33,4 +34,53 @@ LinkedIR linkIR(CodeGenContext* codeGenContext);
 // treated as identical for the purposes of specialization.
 //
 void replaceGlobalConstants(IRModule* module);
+
+// Compute a key that identifies the specialization of a generic to the
+// arguments in `key`, independently of the IR module it appears in, so
+// that it can be looked up in the specialization cache of a `TargetProgram`.
+//
+// Returns false if the generic or one of the arguments can't be
+// identified outside of its module.
+//
+bool getSpecializationCacheKey(IRSimpleSpecializationKey const& key, StringBuilder& outKey);
+
+// Clone the specialized function cached under `key` for `targetProgram`
+// into `module`, instead of specializing its generic again.
+//
+// Global values with linkage that the cached function refers to are bound
+// to the values in `moduleSymbols` with the same mangled name; it is filled
+// in from `module` when empty. Other cached specializations that the
+// function refers to are bound to the ones in `ioSpecializations`, and any
+// that have to be cloned are added to it.
+//
+// Returns null if no function is cached for `key`, or if it refers to a
+// global value that `module` doesn't contain.
+//
+IRFunc* cloneCachedSpecialization(
+    TargetProgram* targetProgram,
+    IRModule* module,
+    String const& key,
+    Dictionary<String, IRInst*>& moduleSymbols,
+    Dictionary<String, IRInst*>& ioSpecializations);
+
+// Add the specialized functions of `module` in `specializations` (which
+// maps specialization cache keys to the specialized values) to the
+// specialization cache for `targetProgram`.
+//
+void addCachedSpecializations(
+    TargetProgram* targetProgram,
+    IRModule* module,
+    Dictionary<String, IRInst*> const& specializations);
+
+// Add the derivative functions of `module` in `derivatives` (which maps
+// derivative cache keys to the functions) to the specialization cache for
+// `targetProgram`, from which `cloneCachedSpecialization` can clone them.
+//
+// Unlike specializations, the struct types that the functions refer to are
+// cloned along with them, as autodiff makes them for the functions alone.
+//
+void addCachedDerivatives(
+    TargetProgram* targetProgram,
+    IRModule* module,
+    Dictionary<String, IRInst*> const& derivatives);
 } // namespace Slang
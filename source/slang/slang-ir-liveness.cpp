@@ -1341,7 +1341,7 @@ void LivenessContext::_processFunction(IRFunc* func)
     SLANG_ASSERT(m_rangeStarts.getCount() > 0);
 
     // Create the dominator tree, for the function
-    m_dominatorTree = computeDominatorTree(func);
+    m_dominatorTree = func->getModule()->findOrCreateDominatorTree(func);
 
     // We are going to precalculate a variety of things for blocks.
     // Most processing is performed via BlockIndex, so we need to set up a map from the block
@@ -1,6 +1,7 @@
 #include "slang-ir-loop-unroll.h"
 
 #include "../core/slang-performance-profiler.h"
+#include "slang-compiler.h"
 #include "slang-ir-clone.h"
 #include "slang-ir-dce.h"
 #include "slang-ir-dominators.h"
@@ -66,6 +67,88 @@ static int _getLoopMaxIterationsToUnroll(IRLoop* loopInst)
     return maxIterations;
 }
 
+// The number of times the body of a loop can run, if it is known to be a constant.
+static IRIntegerValue _getLoopTripCount(IRLoop* loopInst)
+{
+    auto maxItersDecor = loopInst->findDecoration<IRLoopMaxItersDecoration>();
+    if (!maxItersDecor)
+        return -1;
+    auto maxIters = as<IRIntLit>(maxItersDecor->getOperand(0));
+    return maxIters ? maxIters->getValue() : -1;
+}
+
+// Does the loop index an array with a value computed in the loop? Such an array has to be kept
+// in memory that can be indexed, which is usually scratch memory, unless the loop is unrolled
+// and the indices become constants.
+static bool _hasDynamicArrayIndexing(List<IRBlock*> const& blocks)
+{
+    HashSet<IRBlock*> blockSet;
+    for (auto block : blocks)
+        blockSet.add(block);
+
+    for (auto block : blocks)
+    {
+        for (auto inst : block->getChildren())
+        {
+            IRType* baseType = nullptr;
+            switch (inst->getOp())
+            {
+            case kIROp_GetElement:
+                baseType = inst->getOperand(0)->getDataType();
+                break;
+            case kIROp_GetElementPtr:
+                if (!as<IRVar>(getRootAddr(inst->getOperand(0))))
+                    continue;
+                if (auto ptrType = as<IRPtrTypeBase>(inst->getOperand(0)->getDataType()))
+                    baseType = ptrType->getValueType();
+                break;
+            default:
+                continue;
+            }
+            if (!as<IRArrayType>(baseType))
+                continue;
+
+            auto index = inst->getOperand(1);
+            if (blockSet.contains(as<IRBlock>(index->getParent())))
+                return true;
+        }
+    }
+    return false;
+}
+
+// Decide whether a loop without `[ForceUnroll]` should be unrolled anyway, because it runs a
+// small constant number of times and unrolling it makes the indices of the arrays it accesses
+// constants.
+static bool _shouldUnrollHeuristically(IRLoop* loopInst, List<IRBlock*> const& blocks)
+{
+    static constexpr IRIntegerValue kMaxTripCount = 16;
+    static constexpr Index kMaxUnrolledInstCount = 512;
+
+    if (auto loopControl = loopInst->findDecoration<IRLoopControlDecoration>())
+    {
+        if (loopControl->getMode() == kIRLoopControl_Loop)
+            return false;
+    }
+
+    auto tripCount = _getLoopTripCount(loopInst);
+    if (tripCount <= 0 || tripCount > kMaxTripCount)
+        return false;
+
+    Index instCount = 0;
+    for (auto block : blocks)
+    {
+        for (auto inst : block->getChildren())
+        {
+            SLANG_UNUSED(inst);
+            instCount++;
+        }
+    }
+    if (instCount * tripCount > kMaxUnrolledInstCount)
+        return false;
+
+    return _hasDynamicArrayIndexing(blocks);
+}
+
 static void _foldAndSimplifyLoopIteration(
     TargetProgram* targetProgram,
     IRBuilder& builder,
@@ -154,7 +237,8 @@ static bool _unrollLoop(
     TargetProgram* targetProgram,
     IRModule* module,
     IRLoop* loopInst,
-    List<IRBlock*>& blocks)
+    List<IRBlock*>& blocks,
+    int maxIterations)
 {
     if (blocks.getCount() == 0)
     {
@@ -165,7 +249,6 @@ static bool _unrollLoop(
         return true;
     }
 
-    auto maxIterations = _getLoopMaxIterationsToUnroll(loopInst);
     if (maxIterations < 0)
         return true;
 
@@ -454,21 +537,47 @@ bool unrollLoopsInFunc(
     IRGlobalValueWithCode* func,
     DiagnosticSink* sink)
 {
+    // At higher optimization levels, loops that aren't marked `[ForceUnroll]` may be unrolled
+    // too, when that is likely to pay off.
+    bool useHeuristics = false;
+    if (targetProgram)
+    {
+        const auto optimizationLevel = targetProgram->getOptionSet().getOptimizationLevel();
+        useHeuristics = optimizationLevel == OptimizationLevel::High ||
+                        optimizationLevel == OptimizationLevel::Maximal;
+    }
+
     List<IRLoop*> loops = collectLoopsInFunc(
         func,
-        [](IRLoop* l) { return l->findDecoration<IRForceUnrollDecoration>() != nullptr; });
+        [&](IRLoop* l)
+        {
+            return l->findDecoration<IRForceUnrollDecoration>() != nullptr ||
+                   (useHeuristics && _getLoopTripCount(l) > 0);
+        });
 
     if (loops.getCount() == 0)
         return true;
 
     for (auto loop : loops)
     {
+        const bool isForced = loop->findDecoration<IRForceUnrollDecoration>() != nullptr;
+        if (!isForced && !_shouldUnrollHeuristically(loop, collectBlocksInRegion(func, loop)))
+            continue;
+
         // Remove any continue jumps from the loop.
         eliminateContinueBlocks(module, loop);
 
         auto blocks = collectBlocksInRegion(func, loop);
         auto loopLoc = loop->sourceLoc;
-        if (!_unrollLoop(targetProgram, module, loop, blocks))
+
+        // A loop that is unrolled by choice runs at most its trip count times, which
+        // `eliminateContinueBlocks` has adjusted for the region it introduced. One more
+        // iteration is needed to see that the loop exits.
+        const int maxIterations = isForced ? _getLoopMaxIterationsToUnroll(loop)
+                                           : (int)_getLoopTripCount(loop) + 1;
+        // The trip count of a loop that wasn't forced is only an upper bound, so if unrolling
+        // it didn't finish, the rest of the loop is left in place.
+        if (!_unrollLoop(targetProgram, module, loop, blocks, maxIterations) && isForced)
         {
             if (sink)
                 sink->diagnose(loopLoc, Diagnostics::cannotUnrollLoop);
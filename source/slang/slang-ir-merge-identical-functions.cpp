@@ -0,0 +1,185 @@
+#include "slang-ir-merge-identical-functions.h"
+
+#include "slang-ir-insts.h"
+#include "slang-ir.h"
+
+namespace Slang
+{
+
+// Decorations that don't affect what a function does, and which may differ between functions
+// that are otherwise identical.
+static bool _isIgnoredDecoration(IRInst* inst)
+{
+    switch (inst->getOp())
+    {
+    case kIROp_NameHintDecoration:
+    case kIROp_ExportDecoration:
+    case kIROp_ImportDecoration:
+        return true;
+    default:
+        return false;
+    }
+}
+
+// Can `func` be merged with another function, so that its uses refer to that function?
+static bool _canMergeFunc(IRFunc* func)
+{
+    if (!func->getFirstBlock())
+        return false;
+
+    for (auto decoration : func->getDecorations())
+    {
+        switch (decoration->getOp())
+        {
+        case kIROp_EntryPointDecoration:
+        case kIROp_PublicDecoration:
+        case kIROp_HLSLExportDecoration:
+        case kIROp_DllExportDecoration:
+        case kIROp_DllImportDecoration:
+        case kIROp_ExternCppDecoration:
+        case kIROp_KeepAliveDecoration:
+        case kIROp_CudaKernelDecoration:
+        case kIROp_TargetIntrinsicDecoration:
+            return false;
+        default:
+            break;
+        }
+    }
+    return true;
+}
+
+struct FunctionMergeContext
+{
+    IRModule* module;
+
+    // The index of each instruction in the function being encoded, in the order they are
+    // visited.
+    Dictionary<IRInst*, UInt64> mapLocalInstToIndex;
+
+    void indexLocalInsts(IRInst* inst)
+    {
+        mapLocalInstToIndex.add(inst, UInt64(mapLocalInstToIndex.getCount()));
+        for (auto child : inst->getDecorationsAndChildren())
+        {
+            if (!_isIgnoredDecoration(child))
+                indexLocalInsts(child);
+        }
+    }
+
+    // An instruction of the function is encoded by its index, and any other by its address.
+    // Instructions are at least 2-byte aligned, so the low bit distinguishes the two.
+    UInt64 encodeRef(IRInst* inst)
+    {
+        if (auto index = mapLocalInstToIndex.tryGetValue(inst))
+            return (*index << 1) | 1;
+        return UInt64(reinterpret_cast<uintptr_t>(inst));
+    }
+
+    // Append the encoding of `inst` and its children to `ioCode`. Returns false if the
+    // function contains something that the encoding can't represent.
+    bool encodeInst(IRInst* inst, List<UInt64>& ioCode)
+    {
+        // The value of a constant isn't one of its operands. Constants are normally
+        // hoisted to the module, so a function that has its own is simply not merged.
+        if (as<IRConstant>(inst))
+            return false;
+
+        ioCode.add(UInt64(inst->getOp()));
+        ioCode.add(encodeRef(inst->getFullType()));
+
+        const UInt operandCount = inst->getOperandCount();
+        ioCode.add(UInt64(operandCount));
+        for (UInt i = 0; i < operandCount; ++i)
+            ioCode.add(encodeRef(inst->getOperand(i)));
+
+        UInt64 childCount = 0;
+        for (auto child : inst->getDecorationsAndChildren())
+        {
+            if (_isIgnoredDecoration(child))
+                continue;
+            if (!encodeInst(child, ioCode))
+                return false;
+            childCount++;
+        }
+        ioCode.add(childCount);
+        return true;
+    }
+
+    // Encode `func` so that two functions have the same code exactly when they are
+    // structurally identical.
+    bool encodeFunc(IRFunc* func, List<UInt64>& outCode)
+    {
+        mapLocalInstToIndex.clear();
+        indexLocalInsts(func);
+        outCode.clear();
+        return encodeInst(func, outCode);
+    }
+
+    bool mergeRound()
+    {
+        struct Candidate
+        {
+            IRFunc* func;
+            List<UInt64> code;
+        };
+        List<Candidate> candidates;
+        Dictionary<HashCode64, List<Index>> mapHashToCandidates;
+
+        for (auto inst : module->getGlobalInsts())
+        {
+            auto func = as<IRFunc>(inst);
+            if (!func || !_canMergeFunc(func))
+                continue;
+
+            Candidate candidate;
+            candidate.func = func;
+            if (!encodeFunc(func, candidate.code))
+                continue;
+
+            const HashCode64 hash = getHashCode(
+                (const char*)candidate.code.getBuffer(),
+                candidate.code.getCount() * sizeof(UInt64));
+            mapHashToCandidates[hash].add(candidates.getCount());
+            candidates.add(_Move(candidate));
+        }
+
+        // Functions whose code is the same as that of an earlier function are replaced by it.
+        List<IRFunc*> mergedFuncs;
+        for (const auto& [hash, indices] : mapHashToCandidates)
+        {
+            for (Index i = 1; i < indices.getCount(); ++i)
+            {
+                auto& candidate = candidates[indices[i]];
+                for (Index j = 0; j < i; ++j)
+                {
+                    auto& earlier = candidates[indices[j]];
+                    if (!earlier.func || earlier.code != candidate.code)
+                        continue;
+                    candidate.func->replaceUsesWith(earlier.func);
+                    mergedFuncs.add(candidate.func);
+                    candidate.func = nullptr;
+                    break;
+                }
+            }
+        }
+
+        for (auto func : mergedFuncs)
+            func->removeAndDeallocate();
+        return mergedFuncs.getCount() != 0;
+    }
+};
+
+bool mergeIdenticalFunctions(IRModule* module)
+{
+    FunctionMergeContext context;
+    context.module = module;
+
+    // Merging functions changes the callees of their callers, which can make callers
+    // identical in turn, so keep going until nothing is merged.
+    bool changed = false;
+    while (context.mergeRound())
+        changed = true;
+    return changed;
+}
+
+} // namespace Slang
@@ -0,0 +1,18 @@
+// slang-ir-merge-identical-functions.h
+#pragma once
+
+namespace Slang
+{
+struct IRModule;
+
+/// Merge functions that are structurally identical, and redirect their uses to one of them.
+///
+/// Two functions are identical if they have the same type, decorations and body, up to the
+/// names of the functions and of their values. Specialization often produces such functions,
+/// for example when a helper is specialized to types that turn out the same after
+/// legalization. Entry points and functions visible outside of the module are never merged.
+///
+/// Returns true if any function was merged.
+bool mergeIdenticalFunctions(IRModule* module);
+
+} // namespace Slang
@@ -0,0 +1,219 @@
+// slang-ir-pass-stats.cpp
+#include "slang-ir-pass-stats.h"
+
+#include "../compiler-core/slang-diagnostic-sink.h"
+#include "../compiler-core/slang-json-parser.h"
+#include "../compiler-core/slang-json-value.h"
+#include "slang-diagnostics.h"
+#include "slang-ir-insts.h"
+#include "slang-ir.h"
+
+namespace Slang
+{
+
+/* static */ void IRPassStatsRecorder::countInsts(
+    IRModule* module,
+    Count& outInstCount,
+    Count& outFuncCount)
+{
+    Count instCount = 0;
+    Count funcCount = 0;
+
+    List<IRInst*> workList;
+    workList.add(module->getModuleInst());
+    while (workList.getCount())
+    {
+        IRInst* inst = workList.getLast();
+        workList.removeLast();
+
+        instCount++;
+        if (as<IRFunc>(inst))
+            funcCount++;
+
+        for (auto child : inst->getDecorationsAndChildren())
+            workList.add(child);
+    }
+
+    outInstCount = instCount;
+    outFuncCount = funcCount;
+}
+
+void IRInstBudget::check(IRModule* module)
+{
+    if (!isEnabled())
+        return;
+
+    const int errorCountBefore = m_sink->getErrorCount();
+
+    Count moduleInstCount = 1;
+    List<IRInst*> workList;
+    for (auto globalInst : module->getModuleInst()->getDecorationsAndChildren())
+    {
+        Count instCount = 0;
+        workList.add(globalInst);
+        while (workList.getCount())
+        {
+            IRInst* inst = workList.getLast();
+            workList.removeLast();
+
+            instCount++;
+            for (auto child : inst->getDecorationsAndChildren())
+                workList.add(child);
+        }
+        moduleInstCount += instCount;
+
+        if (m_funcInstBudget > 0 && instCount > m_funcInstBudget && as<IRFunc>(globalInst) &&
+            m_reportedFuncs.add(globalInst))
+        {
+            m_sink->diagnose(
+                globalInst,
+                Diagnostics::irFuncInstBudgetExceeded,
+                globalInst,
+                instCount,
+                m_lastPassName,
+                m_funcInstBudget);
+        }
+    }
+
+    if (m_moduleInstBudget > 0 && moduleInstCount > m_moduleInstBudget && !m_reportedModule)
+    {
+        m_reportedModule = true;
+        m_sink->diagnose(
+            SourceLoc(),
+            Diagnostics::irInstBudgetExceeded,
+            moduleInstCount,
+            m_lastPassName,
+            m_moduleInstBudget);
+    }
+
+    if (m_sink->getErrorCount() != errorCountBefore)
+        SLANG_ABORT_COMPILATION("IR instruction budget exceeded");
+}
+
+void IRPassStatsRecorder::writeJSON(StringBuilder& out) const
+{
+    JSONContainer container(nullptr);
+
+    List<JSONValue> passValues;
+    for (const auto& pass : m_passes)
+    {
+        const double timeMS = std::chrono::duration<double, std::milli>(pass.duration).count();
+        const JSONKeyValue commonKeyValues[] = {
+            JSONKeyValue::make(
+                container.getKey(toSlice("name")),
+                container.createString(UnownedStringSlice(pass.passName))),
+            JSONKeyValue::make(container.getKey(toSlice("timeMS")), JSONValue::makeFloat(timeMS)),
+            JSONKeyValue::make(
+                container.getKey(toSlice("instCountBefore")),
+                JSONValue::makeInt(pass.instCountBefore)),
+            JSONKeyValue::make(
+                container.getKey(toSlice("instCountAfter")),
+                JSONValue::makeInt(pass.instCountAfter)),
+            JSONKeyValue::make(
+                container.getKey(toSlice("funcCount")),
+                JSONValue::makeInt(pass.funcCount)),
+            JSONKeyValue::make(
+                container.getKey(toSlice("arenaBytesAllocated")),
+                JSONValue::makeInt(int64_t(pass.arenaBytesAllocated))),
+            JSONKeyValue::make(
+                container.getKey(toSlice("hoistableInstHits")),
+                JSONValue::makeInt(pass.hoistableInstHits)),
+            JSONKeyValue::make(
+                container.getKey(toSlice("hoistableInstMisses")),
+                JSONValue::makeInt(pass.hoistableInstMisses)),
+        };
+        List<JSONKeyValue> keyValues;
+        keyValues.addRange(commonKeyValues, SLANG_COUNT_OF(commonKeyValues));
+
+        // Only the type legalization passes do any legalization, so the counts are left out
+        // for the other passes rather than reporting zeros for all of them.
+        if (pass.legalizedTypes || pass.legalizedTypeCacheHits)
+        {
+            keyValues.add(JSONKeyValue::make(
+                container.getKey(toSlice("legalizedTypes")),
+                JSONValue::makeInt(pass.legalizedTypes)));
+            keyValues.add(JSONKeyValue::make(
+                container.getKey(toSlice("legalizedTypeCacheHits")),
+                JSONValue::makeInt(pass.legalizedTypeCacheHits)));
+            keyValues.add(JSONKeyValue::make(
+                container.getKey(toSlice("expandedTypes")),
+                JSONValue::makeInt(pass.expandedTypes)));
+        }
+        passValues.add(container.createObject(keyValues.getBuffer(), keyValues.getCount()));
+    }
+
+    const JSONKeyValue rootKeyValue = JSONKeyValue::make(
+        container.getKey(toSlice("passes")),
+        container.createArray(passValues.getBuffer(), passValues.getCount()));
+    const JSONValue root = container.createObject(&rootKeyValue, 1);
+
+    JSONWriter writer(JSONWriter::IndentationStyle::KNR);
+    container.traverseRecursively(root, &writer);
+    out << writer.getBuilder();
+}
+
+IRPassStatsScope::IRPassStatsScope(
+    IRPassStatsRecorder* recorder,
+    IRModule* module,
+    const char* passName)
+    : m_recorder(recorder), m_module(module)
+{
+    if (m_recorder)
+    {
+        m_stats.passName = passName;
+        Count funcCount = 0;
+        IRPassStatsRecorder::countInsts(m_module, m_stats.instCountBefore, funcCount);
+        m_arenaBytesBefore = m_module->getMemoryArena().calcTotalMemoryUsed();
+
+        auto dedupContext = m_module->getDeduplicationContext();
+        m_hoistableInstHitsBefore = dedupContext->getHoistableInstHitCount();
+        m_hoistableInstMissesBefore = dedupContext->getHoistableInstMissCount();
+
+        const auto& legalizationCounts = m_module->getTypeLegalizationCounts();
+        m_legalizedTypesBefore = legalizationCounts.legalizedTypes;
+        m_legalizedTypeCacheHitsBefore = legalizationCounts.cacheHits;
+        m_expandedTypesBefore = legalizationCounts.expandedTypes;
+    }
+
+    // Start timing after counting the instructions, so that it isn't included.
+    auto profiler = PerformanceProfiler::getProfiler();
+    m_isTracing = profiler->isTraceEnabled();
+    if (m_isTracing)
+        m_profileContext = profiler->enterFunction(passName);
+
+    m_startTime = std::chrono::high_resolution_clock::now();
+}
+
+IRPassStatsScope::~IRPassStatsScope()
+{
+    const auto duration = std::chrono::high_resolution_clock::now() - m_startTime;
+
+    if (m_isTracing)
+        PerformanceProfiler::getProfiler()->exitFunction(m_profileContext);
+
+    if (m_recorder)
+    {
+        m_stats.duration = duration;
+
+        const size_t arenaBytesAfter = m_module->getMemoryArena().calcTotalMemoryUsed();
+        m_stats.arenaBytesAllocated =
+            arenaBytesAfter > m_arenaBytesBefore ? arenaBytesAfter - m_arenaBytesBefore : 0;
+        IRPassStatsRecorder::countInsts(m_module, m_stats.instCountAfter, m_stats.funcCount);
+
+        auto dedupContext = m_module->getDeduplicationContext();
+        m_stats.hoistableInstHits =
+            dedupContext->getHoistableInstHitCount() - m_hoistableInstHitsBefore;
+        m_stats.hoistableInstMisses =
+            dedupContext->getHoistableInstMissCount() - m_hoistableInstMissesBefore;
+
+        const auto& legalizationCounts = m_module->getTypeLegalizationCounts();
+        m_stats.legalizedTypes = legalizationCounts.legalizedTypes - m_legalizedTypesBefore;
+        m_stats.legalizedTypeCacheHits =
+            legalizationCounts.cacheHits - m_legalizedTypeCacheHitsBefore;
+        m_stats.expandedTypes = legalizationCounts.expandedTypes - m_expandedTypesBefore;
+
+        m_recorder->add(m_stats);
+    }
+}
+
+} // namespace Slang
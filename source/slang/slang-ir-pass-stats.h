@@ -0,0 +1,123 @@
+// slang-ir-pass-stats.h
+#pragma once
+
+#include "../core/slang-basic.h"
+#include "../core/slang-performance-profiler.h"
+
+#include <chrono>
+
+namespace Slang
+{
+class DiagnosticSink;
+struct IRInst;
+struct IRModule;
+
+/// Statistics recorded for a single invocation of an IR pass.
+struct IRPassStats
+{
+    const char* passName = nullptr;
+    std::chrono::nanoseconds duration = std::chrono::nanoseconds::zero();
+    /// Number of instructions in the module before and after the pass ran.
+    Count instCountBefore = 0;
+    Count instCountAfter = 0;
+    /// Number of functions in the module after the pass ran.
+    Count funcCount = 0;
+    /// Bytes allocated from the module's memory arena while the pass ran.
+    size_t arenaBytesAllocated = 0;
+    /// Number of requests for a hoistable inst (types, constants, etc.) while the pass ran
+    /// that found an existing equivalent inst, and that had to create a new one.
+    Count hoistableInstHits = 0;
+    Count hoistableInstMisses = 0;
+    /// The work done by type legalization while the pass ran (see
+    /// `IRModule::TypeLegalizationCounts`). Zero for passes that don't legalize types.
+    Count legalizedTypes = 0;
+    Count legalizedTypeCacheHits = 0;
+    Count expandedTypes = 0;
+};
+
+/// Collects `IRPassStats` for the passes run over an IR module, in the order they ran.
+class IRPassStatsRecorder
+{
+public:
+    void add(const IRPassStats& stats) { m_passes.add(stats); }
+
+    const List<IRPassStats>& getPasses() const { return m_passes; }
+
+    /// Write the recorded statistics as a JSON object with a `passes` array.
+    void writeJSON(StringBuilder& out) const;
+
+    /// Count the instructions (including decorations) and functions in `module`.
+    static void countInsts(IRModule* module, Count& outInstCount, Count& outFuncCount);
+
+protected:
+    List<IRPassStats> m_passes;
+};
+
+/// Records statistics for an IR pass run over `module` during the lifetime of the scope.
+///
+/// Statistics are added to `recorder` if it is not null, and a span named after the pass
+/// is added to the compile trace if tracing is enabled. Otherwise the scope does nothing.
+struct IRPassStatsScope
+{
+    IRPassStatsScope(IRPassStatsRecorder* recorder, IRModule* module, const char* passName);
+    ~IRPassStatsScope();
+
+protected:
+    IRPassStatsRecorder* m_recorder;
+    IRModule* m_module;
+    IRPassStats m_stats;
+    std::chrono::time_point<std::chrono::high_resolution_clock> m_startTime;
+    size_t m_arenaBytesBefore = 0;
+    Count m_hoistableInstHitsBefore = 0;
+    Count m_hoistableInstMissesBefore = 0;
+    Count m_legalizedTypesBefore = 0;
+    Count m_legalizedTypeCacheHitsBefore = 0;
+    Count m_expandedTypesBefore = 0;
+
+    bool m_isTracing = false;
+    FuncProfileContext m_profileContext;
+};
+
+/// Checks the number of instructions in a module, and in each of its functions, against
+/// budgets at the boundaries between the IR passes run over it, so a pass that makes the IR
+/// explode can be found. Set by `-ir-inst-budget` and `-ir-func-inst-budget`.
+///
+/// Going over a budget is a warning, reported once for the module and once for each function,
+/// that names the pass that ran last. If the warning is treated as an error, the compilation
+/// is aborted at that point, rather than spending more time on the IR that is too large.
+class IRInstBudget
+{
+public:
+    /// A budget of 0 isn't checked.
+    IRInstBudget(DiagnosticSink* sink, Count moduleInstBudget, Count funcInstBudget)
+        : m_sink(sink), m_moduleInstBudget(moduleInstBudget), m_funcInstBudget(funcInstBudget)
+    {
+    }
+
+    /// True if there are any budgets to check.
+    bool isEnabled() const { return m_moduleInstBudget > 0 || m_funcInstBudget > 0; }
+
+    /// Check `module` after the pass that ran last, and remember `passName` as the pass that
+    /// runs next.
+    void checkBeforePass(IRModule* module, const char* passName)
+    {
+        check(module);
+        m_lastPassName = passName;
+    }
+
+    /// Check `module` after the pass that ran last.
+    void check(IRModule* module);
+
+protected:
+    DiagnosticSink* m_sink;
+    Count m_moduleInstBudget;
+    Count m_funcInstBudget;
+
+    /// The IR is first checked after linking, before any pass has run.
+    const char* m_lastPassName = "linkIR";
+
+    bool m_reportedModule = false;
+    HashSet<IRInst*> m_reportedFuncs;
+};
+
+} // namespace Slang
@@ -2,6 +2,7 @@
 
 #include "slang-diagnostics.h"
 #include "slang-ir-autodiff.h"
+#include "slang-ir-clone.h"
 #include "slang-ir-insts.h"
 #include "slang-ir-lower-cuda-builtin-types.h"
 #include "slang-ir.h"
@@ -1523,6 +1524,89 @@ void generateDerivativeWrappers(IRModule* module, DiagnosticSink* sink)
 
                 builder.addCudaKernelBackwardDerivativeDecoration(func, wrapperFunc);
             }
+
+            if (globalInst->findDecoration<IRBackwardDifferentiableDecoration>())
+            {
+                // Generate a fused kernel that runs the primal computation, writing its outputs,
+                // and then the reverse-mode derivative in the same thread. This saves the second
+                // launch and the second read of the inputs from memory when the gradient of the
+                // outputs is already known, such as for a loss computed in the kernel itself.
+                //
+                // A kernel can't call another kernel, so the primal computation is called through
+                // a copy of the original function that is an ordinary device function.
+                //
+                IRBuilder builder(module);
+                auto func = cast<IRFunc>(globalInst);
+
+                IRCloneEnv cloneEnv;
+                builder.setInsertBefore(func);
+                auto primalFunc = cast<IRFunc>(cloneInst(&cloneEnv, &builder, func));
+                List<IRDecoration*> decorations;
+                for (auto decoration : primalFunc->getDecorations())
+                {
+                    if (!as<IRNameHintDecoration>(decoration))
+                        decorations.add(decoration);
+                }
+                for (auto decoration : decorations)
+                    decoration->removeAndDeallocate();
+
+                // Create a new wrapper function.
+                auto wrapperFunc = builder.createFunc();
+                builder.setInsertInto(wrapperFunc);
+                builder.emitBlock();
+
+                // Clone the parameter list.
+                List<IRInst*> params;
+                for (auto param : func->getFirstBlock()->getParams())
+                {
+                    auto newParam = builder.emitParam(param->getFullType());
+
+                    // Copy over the name hint.
+                    if (auto nameHint = param->findDecoration<IRNameHintDecoration>())
+                        builder.addNameHintDecoration(newParam, nameHint->getName());
+
+                    params.add(newParam);
+                }
+
+                wrapperFunc->setFullType(func->getFullType());
+
+                builder.emitCallInst(
+                    func->getResultType(),
+                    primalFunc,
+                    params.getCount(),
+                    params.getBuffer());
+                auto bwdDiffFunc = builder.emitBackwardDifferentiateInst(func->getFullType(), func);
+                auto bwdDiffCall = builder.emitCallInst(
+                    func->getResultType(),
+                    bwdDiffFunc,
+                    params.getCount(),
+                    params.getBuffer());
+
+                builder.emitReturn(bwdDiffCall);
+
+                if (func->findDecoration<IRCudaKernelDecoration>())
+                {
+                    builder.addCudaKernelDecoration(wrapperFunc);
+                    builder.addExternCDecoration(wrapperFunc);
+                }
+
+                {
+                    auto autoPyBindCudaHint = func->findDecoration<IRAutoPyBindCudaDecoration>();
+                    StringBuilder nameBuilder;
+                    nameBuilder << autoPyBindCudaHint->getFunctionName() << "_fwd_bwd";
+                    builder.addAutoPyBindCudaDecoration(wrapperFunc, nameBuilder.getUnownedSlice());
+                }
+
+                // Build a name for the wrapper function: <original_name>_fwd_bwd
+                if (auto externCppHint = func->findDecoration<IRExternCppDecoration>())
+                {
+                    StringBuilder nameBuilder;
+                    nameBuilder << externCppHint->getName() << "_fwd_bwd";
+                    builder.addExternCppDecoration(wrapperFunc, nameBuilder.getUnownedSlice());
+                }
+
+                builder.addKeepAliveDecoration(wrapperFunc);
+            }
         }
     }
 }
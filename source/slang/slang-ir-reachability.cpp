@@ -8,53 +8,19 @@ namespace Slang
 // Computes whether block1 can reach block2.
 // A block is considered not reachable from itself unless there is a backedge in the CFG.
 ReachabilityContext::ReachabilityContext(IRGlobalValueWithCode* code)
+    : blocks(code)
 {
-    int id = 0;
-    for (auto block : code->getBlocks())
-    {
-        mapBlockToId[block] = id++;
-        allBlocks.add(block);
-    }
-
-    sourceBlocks.setCount(allBlocks.getCount());
-    for (auto& srcBlock : sourceBlocks)
-        srcBlock.resizeAndClear(allBlocks.getCount());
-
-    if (allBlocks.getCount() == 0)
-        return;
-
-    List<IRBlock*> workList;
-    List<IRBlock*> pendingWorkList;
-
-    workList.add(allBlocks[0]);
-    while (workList.getCount())
-    {
-        pendingWorkList.clear();
-        for (Index i = 0; i < workList.getCount(); i++)
-        {
-            auto src = workList[i];
-            auto srcId = mapBlockToId.getValue(src);
-            for (auto successor : src->getSuccessors())
-            {
-                auto successorId = mapBlockToId.getValue(successor);
-                auto& blockSet = sourceBlocks[successorId];
-                bool changed = false;
-                if (!blockSet.contains(srcId))
-                {
-                    blockSet.add(srcId);
-                    changed = true;
-                }
-                if (!blockSet.contains(sourceBlocks[srcId]))
-                {
-                    blockSet.unionWith(sourceBlocks[srcId]);
-                    changed = true;
-                }
-                if (changed)
-                    pendingWorkList.add(successor);
-            }
-        }
-        workList.swapWith(pendingWorkList);
-    }
+    // The blocks that reach a block flow forward: a block passes on the blocks that reach it,
+    // and itself. Blocks not reachable from the entry block are reached from no block.
+    const Index blockCount = blocks.getBlockCount();
+    IRBitSetDataFlow dataFlow(blocks, DataFlowDirection::Forward, DataFlowMeet::Union, blockCount);
+    for (Index i = 0; i < blockCount; i++)
+        dataFlow.getGen(i).add(UInt(i));
+    dataFlow.solve();
+
+    sourceBlocks.setCount(blockCount);
+    for (Index i = 0; i < blockCount; i++)
+        sourceBlocks[i] = dataFlow.getIn(i);
 }
 
 bool ReachabilityContext::isInstReachable(IRInst* from, IRInst* to)
@@ -81,11 +47,11 @@ bool ReachabilityContext::isBlockReachable(IRBlock* from, IRBlock* to)
     if (!to)
         return false;
 
-    int* fromId = mapBlockToId.tryGetValue(from);
-    int* toId = mapBlockToId.tryGetValue(to);
-    if (!fromId || !toId)
+    const Index fromIndex = blocks.getBlockIndex(from);
+    const Index toIndex = blocks.getBlockIndex(to);
+    if (fromIndex < 0 || toIndex < 0)
         return true;
 
-    return sourceBlocks[*toId].contains(*fromId);
+    return sourceBlocks[toIndex].contains(UInt(fromIndex));
 }
 } // namespace Slang
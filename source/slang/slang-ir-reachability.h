@@ -1,6 +1,7 @@
 // slang-ir-reachability.h
 #pragma once
 
+#include "slang-ir-dataflow.h"
 #include "slang-ir.h"
 
 namespace Slang
@@ -9,10 +10,9 @@ namespace Slang
 // A context for computing and caching reachability between blocks on the CFG.
 struct ReachabilityContext
 {
-    Dictionary<IRBlock*, int> mapBlockToId;
-    List<IRBlock*> allBlocks;
+    IRBlockNumbering blocks;
     List<UIntSet> sourceBlocks; // sourcesBlocks[i] stores the set of blocks from which block i can
-                                // be reached.
+                                // be reached, by their index in `blocks`.
 
     ReachabilityContext() = default;
     ReachabilityContext(IRGlobalValueWithCode* code);
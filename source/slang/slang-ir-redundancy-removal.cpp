@@ -6,10 +6,109 @@
 namespace Slang
 {
 
+// A load from a buffer that is read only gives the same value wherever it is done, so it can be
+// deduplicated like any other value.
+static bool _isReadOnlyBufferLoad(IRInst* inst)
+{
+    switch (inst->getOp())
+    {
+    case kIROp_ByteAddressBufferLoad:
+    case kIROp_StructuredBufferLoad:
+        break;
+    default:
+        return false;
+    }
+    auto bufferType = inst->getOperand(0)->getDataType();
+    if (!bufferType)
+        return false;
+    switch (bufferType->getOp())
+    {
+    case kIROp_HLSLByteAddressBufferType:
+    case kIROp_HLSLStructuredBufferType:
+        return true;
+    default:
+        return false;
+    }
+}
+
 struct RedundancyRemovalContext
 {
     RefPtr<IRDominatorTree> dom;
 
+    /// True if `inst` is available everywhere `block` is, because it is defined outside of `func`
+    /// or in a block that dominates `block`.
+    bool isAvailableIn(IRGlobalValueWithCode* func, IRInst* inst, IRBlock* block)
+    {
+        if (!hasDescendent(func, inst))
+            return true;
+        auto parentBlock = as<IRBlock>(inst->getParent());
+        return parentBlock && dom->dominates(parentBlock, block);
+    }
+
+    // An instruction that is computed on both sides of an `if` is partially redundant with any
+    // computation of it after the `if`, which the dominator based deduplication below can't
+    // see. Hoisting one of the pair into the block with the `if`, and replacing the other with
+    // it, makes the later computations fully redundant. Nothing is computed on a path that
+    // didn't compute it before.
+    //
+    // Hoisting an instruction can make one that uses it hoistable too, so this repeats until
+    // nothing more is hoisted.
+    bool hoistInstsCommonToBranches(IRGlobalValueWithCode* func, IRBlock* block)
+    {
+        auto ifElse = as<IRIfElse>(block->getTerminator());
+        if (!ifElse)
+            return false;
+        auto trueBlock = ifElse->getTrueBlock();
+        auto falseBlock = ifElse->getFalseBlock();
+        if (trueBlock == falseBlock || trueBlock == ifElse->getAfterBlock() ||
+            falseBlock == ifElse->getAfterBlock())
+            return false;
+        if (trueBlock->getPredecessors().getCount() != 1 ||
+            falseBlock->getPredecessors().getCount() != 1)
+            return false;
+
+        bool result = false;
+        for (;;)
+        {
+            Dictionary<IRInstKey, IRInst*> falseInsts;
+            for (auto inst : falseBlock->getOrdinaryInsts())
+            {
+                if (isMovableInst(inst))
+                    falseInsts.addIfNotExists(IRInstKey{inst}, inst);
+            }
+
+            bool changed = false;
+            for (auto inst = trueBlock->getFirstOrdinaryInst(); inst;)
+            {
+                auto nextInst = inst->getNextInst();
+                if (isMovableInst(inst))
+                {
+                    bool canHoist = true;
+                    for (UInt i = 0; i < inst->getOperandCount(); i++)
+                    {
+                        canHoist = isAvailableIn(func, inst->getOperand(i), block);
+                        if (!canHoist)
+                            break;
+                    }
+                    IRInst* falseInst = nullptr;
+                    if (canHoist && falseInsts.tryGetValue(IRInstKey{inst}, falseInst))
+                    {
+                        inst->insertBefore(ifElse);
+                        falseInsts.remove(IRInstKey{inst});
+                        falseInst->replaceUsesWith(inst);
+                        falseInst->removeAndDeallocate();
+                        changed = true;
+                    }
+                }
+                inst = nextInst;
+            }
+            result |= changed;
+            if (!changed)
+                break;
+        }
+        return result;
+    }
+
     bool tryHoistInstToOuterMostLoop(IRGlobalValueWithCode* func, IRInst* inst)
     {
         bool changed = false;
@@ -77,7 +176,7 @@ struct RedundancyRemovalContext
                         return false;
                     if (dom->isUnreachable(parentBlock))
                         return false;
-                    return isMovableInst(inst);
+                    return isMovableInst(inst) || _isReadOnlyBufferLoad(inst);
                 });
             if (resultInst != instP)
             {
@@ -126,15 +225,17 @@ bool removeRedundancyInFunc(IRGlobalValueWithCode* func)
         return false;
 
     RedundancyRemovalContext context;
-    context.dom = computeDominatorTree(func);
+    context.dom = func->getModule()->findOrCreateDominatorTree(func);
     Dictionary<IRBlock*, DeduplicateContext> mapBlockToDeduplicateContext;
+    bool result = false;
     for (auto block : func->getBlocks())
     {
         mapBlockToDeduplicateContext[block] = DeduplicateContext();
+        if (!context.dom->isUnreachable(block))
+            result |= context.hoistInstsCommonToBranches(func, block);
     }
     List<IRBlock*> workList, pendingWorkList;
     workList.add(root);
-    bool result = false;
     while (workList.getCount())
     {
         for (auto block : workList)
@@ -265,7 +366,8 @@ bool tryRemoveRedundantStore(IRGlobalValueWithCode* func, IRStore* store)
     // A store can be removed if there are subsequent stores to the same variable,
     // and there are no insts in between the stores that can read the variable.
 
-    HashSet<IRBlock*> visitedBlocks;
+    PooledHashSet<IRBlock> pooledVisitedBlocks;
+    auto& visitedBlocks = *pooledVisitedBlocks;
     for (auto next = store->getNextInst(); next;)
     {
         if (auto nextStore = as<IRStore>(next))
@@ -350,6 +452,46 @@ bool tryRemoveRedundantStore(IRGlobalValueWithCode* func, IRStore* store)
     return false;
 }
 
+static bool _isBufferLoad(IRInst* inst)
+{
+    switch (inst->getOp())
+    {
+    case kIROp_ByteAddressBufferLoad:
+    case kIROp_StructuredBufferLoad:
+    case kIROp_RWStructuredBufferLoad:
+        return true;
+    default:
+        return false;
+    }
+}
+
+// A load from a buffer that may be written is redundant if an identical load comes before it in
+// the same block, with nothing in between that might write to memory.
+static bool _tryRemoveRedundantBufferLoad(IRInst* load)
+{
+    // Loads from coherent or volatile buffers may see writes from other threads
+    if (load->getOperand(0)->findDecoration<IRMemoryQualifierSetDecoration>())
+        return false;
+
+    const IRInstKey key{load};
+    for (auto prev = load->getPrevInst(); prev; prev = prev->getPrevInst())
+    {
+        if (_isBufferLoad(prev))
+        {
+            if (IRInstKey{prev} == key)
+            {
+                load->replaceUsesWith(prev);
+                load->removeAndDeallocate();
+                return true;
+            }
+            continue;
+        }
+        if (prev->mightHaveSideEffects())
+            break;
+    }
+    return false;
+}
+
 bool eliminateRedundantLoadStore(IRGlobalValueWithCode* func)
 {
     bool changed = false;
@@ -386,6 +528,10 @@ bool eliminateRedundantLoadStore(IRGlobalValueWithCode* func)
             {
                 changed |= tryRemoveRedundantStore(func, store);
             }
+            else if (_isBufferLoad(inst))
+            {
+                changed |= _tryRemoveRedundantBufferLoad(inst);
+            }
             inst = nextInst;
         }
     }
@@ -2,6 +2,7 @@
 #include "slang-ir-sccp.h"
 
 #include "slang-ir-insts.h"
+#include "slang-ir-util.h"
 #include "slang-ir.h"
 
 namespace Slang
@@ -845,6 +846,179 @@ struct SCCPContext
         return c0->value.intVal != 0 ? v1 : v2;
     }
 
+    // Pure math functions in the core module are marked with `[KnownBuiltin]`,
+    // and a call to one of them with constant arguments can be evaluated at compile
+    // time. Each entry gives the implementation over floating-point arguments,
+    // integer arguments, or both. A null function means the builtin isn't folded
+    // for arguments of that kind.
+    //
+    struct FoldableBuiltin
+    {
+        const char* name;
+        Index argCount;
+        double (*floatFunc)(const double* args);
+        IRIntegerValue (*intFunc)(const IRIntegerValue* args, bool isSigned);
+    };
+
+    static IRIntegerValue _reverseBits(IRIntegerValue value)
+    {
+        uint32_t bits = uint32_t(value);
+        uint32_t result = 0;
+        for (int i = 0; i < 32; i++, bits >>= 1)
+            result = (result << 1) | (bits & 1);
+        return result;
+    }
+
+    static IRIntegerValue _intMin(IRIntegerValue a, IRIntegerValue b, bool isSigned)
+    {
+        if (isSigned)
+            return a < b ? a : b;
+        return IRUnsignedIntegerValue(a) < IRUnsignedIntegerValue(b) ? a : b;
+    }
+
+    static IRIntegerValue _intMax(IRIntegerValue a, IRIntegerValue b, bool isSigned)
+    {
+        if (isSigned)
+            return a > b ? a : b;
+        return IRUnsignedIntegerValue(a) > IRUnsignedIntegerValue(b) ? a : b;
+    }
+
+    static const FoldableBuiltin* findFoldableBuiltin(UnownedStringSlice name)
+    {
+        typedef const double* F;
+        typedef const IRIntegerValue* I;
+        static const FoldableBuiltin kFoldableBuiltins[] = {
+            {"abs",
+             1,
+             [](F a) { return std::fabs(a[0]); },
+             [](I a, bool isSigned) { return (isSigned && a[0] < 0) ? -a[0] : a[0]; }},
+            {"min",
+             2,
+             [](F a) { return a[0] < a[1] ? a[0] : a[1]; },
+             [](I a, bool isSigned) { return _intMin(a[0], a[1], isSigned); }},
+            {"max",
+             2,
+             [](F a) { return a[0] > a[1] ? a[0] : a[1]; },
+             [](I a, bool isSigned) { return _intMax(a[0], a[1], isSigned); }},
+            {"clamp",
+             3,
+             [](F a) { return a[0] < a[1] ? a[1] : (a[0] > a[2] ? a[2] : a[0]); },
+             [](I a, bool isSigned)
+             { return _intMin(_intMax(a[0], a[1], isSigned), a[2], isSigned); }},
+            {"sign",
+             1,
+             [](F a) { return a[0] > 0 ? 1.0 : (a[0] < 0 ? -1.0 : 0.0); },
+             [](I a, bool isSigned)
+             { return a[0] > 0 ? 1 : ((isSigned && a[0] < 0) ? IRIntegerValue(-1) : 0); }},
+            {"countbits",
+             1,
+             nullptr,
+             [](I a, bool) { return IRIntegerValue(Math::Ones32(uint32_t(a[0]))); }},
+            {"reversebits", 1, nullptr, [](I a, bool) { return _reverseBits(a[0]); }},
+            {"sqrt", 1, [](F a) { return std::sqrt(a[0]); }, nullptr},
+            {"rsqrt", 1, [](F a) { return 1.0 / std::sqrt(a[0]); }, nullptr},
+            {"pow", 2, [](F a) { return std::pow(a[0], a[1]); }, nullptr},
+            {"exp", 1, [](F a) { return std::exp(a[0]); }, nullptr},
+            {"exp2", 1, [](F a) { return std::exp2(a[0]); }, nullptr},
+            {"log", 1, [](F a) { return std::log(a[0]); }, nullptr},
+            {"log2", 1, [](F a) { return std::log2(a[0]); }, nullptr},
+            {"log10", 1, [](F a) { return std::log10(a[0]); }, nullptr},
+            {"sin", 1, [](F a) { return std::sin(a[0]); }, nullptr},
+            {"cos", 1, [](F a) { return std::cos(a[0]); }, nullptr},
+            {"tan", 1, [](F a) { return std::tan(a[0]); }, nullptr},
+            {"asin", 1, [](F a) { return std::asin(a[0]); }, nullptr},
+            {"acos", 1, [](F a) { return std::acos(a[0]); }, nullptr},
+            {"atan", 1, [](F a) { return std::atan(a[0]); }, nullptr},
+            {"atan2", 2, [](F a) { return std::atan2(a[0], a[1]); }, nullptr},
+            {"sinh", 1, [](F a) { return std::sinh(a[0]); }, nullptr},
+            {"cosh", 1, [](F a) { return std::cosh(a[0]); }, nullptr},
+            {"tanh", 1, [](F a) { return std::tanh(a[0]); }, nullptr},
+            {"floor", 1, [](F a) { return std::floor(a[0]); }, nullptr},
+            {"ceil", 1, [](F a) { return std::ceil(a[0]); }, nullptr},
+            {"trunc", 1, [](F a) { return std::trunc(a[0]); }, nullptr},
+            {"round", 1, [](F a) { return std::nearbyint(a[0]); }, nullptr},
+            {"frac", 1, [](F a) { return a[0] - std::floor(a[0]); }, nullptr},
+            {"saturate", 1, [](F a) { return a[0] < 0 ? 0.0 : (a[0] > 1 ? 1.0 : a[0]); }, nullptr},
+            {"lerp", 3, [](F a) { return a[0] + a[2] * (a[1] - a[0]); }, nullptr},
+            {"step", 2, [](F a) { return a[1] >= a[0] ? 1.0 : 0.0; }, nullptr},
+            {"fmod", 2, [](F a) { return std::fmod(a[0], a[1]); }, nullptr},
+        };
+        for (auto& builtin : kFoldableBuiltins)
+        {
+            if (name == UnownedStringSlice(builtin.name))
+                return &builtin;
+        }
+        return nullptr;
+    }
+
+    LatticeVal evalBuiltinCall(IRCall* call)
+    {
+        auto name = getBuiltinFuncName(call->getCallee());
+        if (!name.getLength())
+            return LatticeVal::getAny();
+
+        auto builtin = findFoldableBuiltin(name);
+        if (!builtin || Index(call->getArgCount()) != builtin->argCount)
+            return LatticeVal::getAny();
+
+        auto resultType = call->getDataType();
+        if (!as<IRBasicType>(resultType))
+            return LatticeVal::getAny();
+
+        // All of the foldable builtins take arguments of a single scalar type.
+        //
+        auto argType = call->getArg(0)->getDataType();
+        const bool isFloatArg = isFloatingType(argType);
+        if (!as<IRBasicType>(argType) || argType->getOp() == kIROp_BoolType)
+            return LatticeVal::getAny();
+        if (isFloatArg ? !builtin->floatFunc : !builtin->intFunc)
+            return LatticeVal::getAny();
+
+        double floatArgs[3];
+        IRIntegerValue intArgs[3];
+        for (Index i = 0; i < builtin->argCount; i++)
+        {
+            auto argVal = getLatticeVal(call->getArg(i));
+            SLANG_SCCP_RETURN_IF_NONE_OR_ANY(argVal)
+            auto c = as<IRConstant>(argVal.value);
+            if (!c || c->getDataType() != argType)
+                return LatticeVal::getAny();
+            if (isFloatArg)
+                floatArgs[i] = c->value.floatVal;
+            else
+                intArgs[i] = c->value.intVal;
+        }
+
+        if (!isFloatArg)
+        {
+            auto result = builtin->intFunc(intArgs, getIntTypeInfo(argType).isSigned);
+            if (!isIntegralType(resultType))
+                return LatticeVal::getAny();
+            return LatticeVal::getConstant(getBuilder()->getIntValue(resultType, result));
+        }
+
+        auto result = builtin->floatFunc(floatArgs);
+
+        // Results that aren't finite are left to the target, which is the only place
+        // that knows how it treats them.
+        //
+        if (!std::isfinite(result))
+            return LatticeVal::getAny();
+
+        if (isIntegralType(resultType))
+            return LatticeVal::getConstant(
+                getBuilder()->getIntValue(resultType, IRIntegerValue(result)));
+        if (!isFloatingType(resultType))
+            return LatticeVal::getAny();
+
+        // The math is done in double precision, so the result for narrower types is
+        // rounded to the precision of `float`, as the target would compute it.
+        //
+        if (resultType->getOp() != kIROp_DoubleType)
+            result = double(float(result));
+        return LatticeVal::getConstant(getBuilder()->getFloatValue(resultType, result));
+    }
+
     // In order to perform constant folding, we need to be able to
     // interpret an instruction over the lattice values.
     //
@@ -862,11 +1036,15 @@ struct SCCPContext
         case kIROp_BoolLit:
             return LatticeVal::getConstant(inst);
 
+        // Calls are only folded when they are to one of the known
+        // pure builtins.
+        case kIROp_Call:
+            return evalBuiltinCall(as<IRCall>(inst));
+
         // We might also want to special-case certain
         // instructions where we shouldn't bother trying to
         // constant-fold them and should just default to the
         // `Any` value right away.
-        case kIROp_Call:
         case kIROp_ByteAddressBufferLoad:
         case kIROp_ByteAddressBufferStore:
         case kIROp_Alloca:
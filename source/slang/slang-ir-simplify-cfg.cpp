@@ -92,7 +92,7 @@ static bool isTrivialSingleIterationLoop(
     // We need to verify this is a trivial loop by checking if there is any multi-level breaks
     // that skips out of this loop.
     if (!context.domTree)
-        context.domTree = computeDominatorTree(func);
+        context.domTree = func->getModule()->findOrCreateDominatorTree(func);
     bool hasMultiLevelBreaks = false;
     auto loopBlocks = collectBlocksInRegion(context.domTree, loop, &hasMultiLevelBreaks);
     if (hasMultiLevelBreaks)
@@ -163,7 +163,7 @@ static bool doesLoopHasSideEffect(
 {
     bool hasMultiLevelBreaks = false;
     if (!context.domTree)
-        context.domTree = computeDominatorTree(func);
+        context.domTree = func->getModule()->findOrCreateDominatorTree(func);
     auto blocks = collectBlocksInRegion(context.domTree.get(), loopInst, &hasMultiLevelBreaks);
 
     // We'll currently not deal with loops that contain multi-level breaks.
@@ -299,18 +299,22 @@ static bool doesLoopHasSideEffect(
 static bool removeDeadBlocks(IRGlobalValueWithCode* func)
 {
     bool changed = false;
-    List<IRBlock*> workList;
     auto firstBlock = func->getFirstBlock();
     if (!firstBlock)
         return false;
 
+    PooledList<IRBlock> pooledWorkList;
+    PooledHashSet<IRBlock> pooledWorkListSet;
+    PooledList<IRBlock> pooledNextWorkList;
+    auto& workList = *pooledWorkList;
+    auto& workListSet = *pooledWorkListSet;
+    auto& nextWorkList = *pooledNextWorkList;
+
     for (auto block = firstBlock->getNextBlock(); block; block = block->getNextBlock())
     {
         workList.add(block);
     }
 
-    HashSet<IRBlock*> workListSet;
-    List<IRBlock*> nextWorkList;
     for (;;)
     {
         for (Index i = 0; i < workList.getCount(); i++)
@@ -331,7 +335,8 @@ static bool removeDeadBlocks(IRGlobalValueWithCode* func)
         }
         if (nextWorkList.getCount())
         {
-            workList = _Move(nextWorkList);
+            workList.swapWith(nextWorkList);
+            nextWorkList.clear();
             workListSet.clear();
         }
         else
@@ -812,8 +817,10 @@ static bool processFunc(IRGlobalValueWithCode* func, CFGSimplificationOptions op
     bool changed = false;
     for (;;)
     {
-        List<IRBlock*> workList;
-        HashSet<IRBlock*> processedBlock;
+        PooledList<IRBlock> pooledWorkList;
+        PooledHashSet<IRBlock> pooledProcessedBlock;
+        auto& workList = *pooledWorkList;
+        auto& processedBlock = *pooledProcessedBlock;
         workList.add(func->getFirstBlock());
         while (workList.getCount())
         {
@@ -950,12 +957,6 @@ static bool processFunc(IRGlobalValueWithCode* func, CFGSimplificationOptions op
         if (!blocksRemoved)
             break;
     }
-    if (changed)
-    {
-        auto module = func->getModule();
-        if (module)
-            module->invalidateAnalysisForInst(func);
-    }
     return changed;
 }
 
@@ -0,0 +1,166 @@
+#include "slang-ir-sink-insts.h"
+
+#include "slang-ir-dominators.h"
+#include "slang-ir-insts.h"
+#include "slang-ir-util.h"
+#include "slang-ir.h"
+
+namespace Slang
+{
+
+// A load from a buffer that is read only gives the same value wherever it is done, so it
+// can be moved past any other instruction.
+static bool _isReadOnlyBufferLoad(IRInst* inst)
+{
+    switch (inst->getOp())
+    {
+    case kIROp_ByteAddressBufferLoad:
+    case kIROp_StructuredBufferLoad:
+        break;
+    default:
+        return false;
+    }
+    auto bufferType = inst->getOperand(0)->getDataType();
+    if (!bufferType)
+        return false;
+    switch (bufferType->getOp())
+    {
+    case kIROp_HLSLByteAddressBufferType:
+    case kIROp_HLSLStructuredBufferType:
+        return true;
+    default:
+        return false;
+    }
+}
+
+static bool _canSink(IRInst* inst)
+{
+    return isMovableInst(inst) || _isReadOnlyBufferLoad(inst);
+}
+
+struct SinkInstsContext
+{
+    IRGlobalValueWithCode* func;
+
+    // The innermost loop that each block is in, if it is in one.
+    Dictionary<IRBlock*, IRLoop*> mapBlockToInnermostLoop;
+
+    IRLoop* getInnermostLoop(IRBlock* block)
+    {
+        IRLoop* loop = nullptr;
+        mapBlockToInnermostLoop.tryGetValue(block, loop);
+        return loop;
+    }
+
+    void collectLoops()
+    {
+        RefPtr<IRDominatorTree> dom = computeDominatorTree(func);
+
+        // The innermost of the loops containing a block is the one with the smallest region.
+        Dictionary<IRBlock*, Index> mapBlockToRegionSize;
+        for (auto block : func->getBlocks())
+        {
+            auto loop = as<IRLoop>(block->getTerminator());
+            if (!loop)
+                continue;
+            auto region = collectBlocksInRegion(dom, loop);
+            for (auto regionBlock : region)
+            {
+                Index size = 0;
+                if (mapBlockToRegionSize.tryGetValue(regionBlock, size) &&
+                    size <= region.getCount())
+                    continue;
+                mapBlockToRegionSize[regionBlock] = region.getCount();
+                mapBlockToInnermostLoop[regionBlock] = loop;
+            }
+        }
+    }
+
+    // Find the block that all the uses of `inst` are in, and the first of them in it.
+    IRInst* findFirstUser(IRInst* inst)
+    {
+        IRBlock* userBlock = nullptr;
+        for (auto use = inst->firstUse; use; use = use->nextUse)
+        {
+            auto block = as<IRBlock>(use->getUser()->getParent());
+            if (!block)
+                return nullptr;
+            if (userBlock && block != userBlock)
+                return nullptr;
+            userBlock = block;
+        }
+        if (!userBlock)
+            return nullptr;
+
+        auto start = userBlock == inst->getParent() ? inst->getNextInst()
+                                                    : userBlock->getFirstOrdinaryInst();
+        for (auto candidate = start; candidate; candidate = candidate->getNextInst())
+        {
+            for (UInt i = 0; i < candidate->getOperandCount(); i++)
+            {
+                if (candidate->getOperand(i) == inst)
+                    return candidate;
+            }
+        }
+        return nullptr;
+    }
+
+    bool trySink(IRInst* inst)
+    {
+        if (!_canSink(inst))
+            return false;
+
+        auto firstUser = findFirstUser(inst);
+        if (!firstUser || firstUser == inst->getNextInst())
+            return false;
+
+        auto block = as<IRBlock>(inst->getParent());
+        auto userBlock = as<IRBlock>(firstUser->getParent());
+        if (userBlock != block && getInnermostLoop(userBlock) != getInnermostLoop(block))
+            return false;
+
+        inst->insertBefore(firstUser);
+        return true;
+    }
+
+    bool processFunc()
+    {
+        collectLoops();
+
+        // The instructions of a block are visited last to first, so that by the time an
+        // instruction is visited the users it has in the block have been moved already, and a
+        // chain of instructions is moved together.
+        //
+        bool changed = false;
+        List<IRInst*> insts;
+        for (auto block : func->getBlocks())
+        {
+            insts.clear();
+            for (auto inst : block->getOrdinaryInsts())
+                insts.add(inst);
+            for (Index i = insts.getCount() - 1; i >= 0; i--)
+                changed |= trySink(insts[i]);
+        }
+        return changed;
+    }
+};
+
+bool sinkInstsToUsesInFunc(IRGlobalValueWithCode* func)
+{
+    SinkInstsContext context;
+    context.func = func;
+    return context.processFunc();
+}
+
+bool sinkInstsToUses(IRModule* module)
+{
+    bool changed = false;
+    for (auto globalInst : module->getGlobalInsts())
+    {
+        if (auto func = as<IRFunc>(globalInst))
+            changed |= sinkInstsToUsesInFunc(func);
+    }
+    return changed;
+}
+
+} // namespace Slang
@@ -0,0 +1,21 @@
+// slang-ir-sink-insts.h
+#pragma once
+
+namespace Slang
+{
+struct IRModule;
+struct IRGlobalValueWithCode;
+
+/// Move side effect free instructions as close as possible to their uses, to shorten the
+/// live ranges of their values in the generated code.
+///
+/// An instruction whose uses are all in a single block is moved to just before the first of
+/// them. That is within its own block, or into a block it dominates, as long as that doesn't
+/// move it into a loop, where it would be executed more often. Instructions are never moved
+/// onto a path where they weren't executed before.
+///
+/// Returns true if any instruction was moved.
+bool sinkInstsToUses(IRModule* module);
+bool sinkInstsToUsesInFunc(IRGlobalValueWithCode* func);
+
+} // namespace Slang
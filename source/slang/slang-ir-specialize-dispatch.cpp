@@ -7,72 +7,65 @@
 
 namespace Slang
 {
-IRFunc* specializeDispatchFunction(
-    SharedGenericsLoweringContext* sharedContext,
-    IRFunc* dispatchFunc)
+// Returns the weight given to the concrete type of `witnessTable` with `[DispatchWeight]`,
+// or -1 if the type has no weight.
+static IRIntegerValue _getDispatchWeight(IRWitnessTable* witnessTable)
 {
-    auto witnessTableType = cast<IRFuncType>(dispatchFunc->getDataType())->getParamType(0);
-    auto conformanceType = cast<IRWitnessTableTypeBase>(witnessTableType)->getConformanceType();
-    // Collect all witness tables of `witnessTableType` in current module.
-    List<IRWitnessTable*> witnessTables =
-        sharedContext->getWitnessTablesFromInterfaceType(conformanceType);
-
-    SLANG_ASSERT(dispatchFunc->getFirstBlock() == dispatchFunc->getLastBlock());
-    auto block = dispatchFunc->getFirstBlock();
-
-    // The dispatch function before modification must be in the form of
-    // call(lookup_interface_method(witnessTableParam, interfaceReqKey), args)
-    // We now find the relavent instructions.
-    IRCall* callInst = nullptr;
-    IRLookupWitnessMethod* lookupInst = nullptr;
-    // Only used in debug builds as a sanity check
-    [[maybe_unused]] IRReturn* returnInst = nullptr;
-    for (auto inst : block->getOrdinaryInsts())
-    {
-        switch (inst->getOp())
-        {
-        case kIROp_Call:
-            callInst = cast<IRCall>(inst);
-            break;
-        case kIROp_LookupWitness:
-            lookupInst = cast<IRLookupWitnessMethod>(inst);
-            break;
-        case kIROp_Return:
-            returnInst = cast<IRReturn>(inst);
-            break;
-        default:
-            break;
-        }
-    }
-    SLANG_ASSERT(callInst && lookupInst && returnInst);
-
-    IRBuilder builderStorage(sharedContext->module);
-    auto builder = &builderStorage;
-    builder->setInsertBefore(dispatchFunc);
-
-    // Create a new dispatch func to replace the existing one.
-    auto newDispatchFunc = builder->createFunc();
+    auto concreteType = getResolvedInstForDecorations(witnessTable->getConcreteType());
+    if (auto weightDecor = concreteType->findDecoration<IRDispatchWeightDecoration>())
+        return weightDecor->getWeight();
+    return -1;
+}
 
-    List<IRType*> paramTypes;
-    for (auto paramInst : dispatchFunc->getParams())
+// Orders `witnessTables` so that a dispatch tests the most frequent types first: types with a
+// nonzero `[DispatchWeight]` come first by decreasing weight, followed by the types without a
+// weight in their original order. Types with a weight of zero are cold, and are moved to
+// `outColdTables` so that their cases can be kept out of the main dispatch function.
+static void _orderWitnessTablesByWeight(
+    List<IRWitnessTable*>& witnessTables,
+    List<IRWitnessTable*>& outColdTables)
+{
+    List<IRWitnessTable*> weightedTables;
+    List<IRWitnessTable*> unweightedTables;
+    for (auto witnessTable : witnessTables)
     {
-        paramTypes.add(paramInst->getFullType());
+        auto weight = _getDispatchWeight(witnessTable);
+        if (weight == 0)
+            outColdTables.add(witnessTable);
+        else if (weight < 0)
+            unweightedTables.add(witnessTable);
+        else
+            weightedTables.add(witnessTable);
     }
+    weightedTables.stableSort(
+        [](IRWitnessTable* a, IRWitnessTable* b)
+        { return _getDispatchWeight(a) > _getDispatchWeight(b); });
 
-    // Modify the first paramter from IRWitnessTable to IRWitnessTableID representing the sequential
-    // ID.
-    paramTypes[0] = builder->getWitnessTableIDType((IRType*)conformanceType);
-
-    auto newDipsatchFuncType = builder->getFuncType(paramTypes, dispatchFunc->getResultType());
-    newDispatchFunc->setFullType(newDipsatchFuncType);
-    dispatchFunc->transferDecorationsTo(newDispatchFunc);
+    witnessTables = _Move(weightedTables);
+    witnessTables.addRange(unweightedTables);
+}
 
-    builder->setInsertInto(newDispatchFunc);
+// Emits the body of `func`, whose parameters have `paramTypes` and whose first parameter is
+// a witness table ID, as a `switch` that calls the implementation of `requirementKey` in the
+// matching entry of `witnessTables`. The cases are tested in the order of `witnessTables`.
+//
+// If `fallbackFunc` is given, IDs that match none of the cases are forwarded to it.
+// Otherwise the last witness table is used as the `default` case.
+static void _emitDispatchSwitch(
+    SharedGenericsLoweringContext* sharedContext,
+    IRBuilder* builder,
+    IRFunc* func,
+    List<IRType*> const& paramTypes,
+    List<IRWitnessTable*> const& witnessTables,
+    IRInst* requirementKey,
+    IRType* callType,
+    IRFunc* fallbackFunc)
+{
+    builder->setInsertInto(func);
     auto newBlock = builder->emitBlock();
 
     IRBlock* defaultBlock = nullptr;
 
-    auto requirementKey = lookupInst->getRequirementKey();
     List<IRInst*> params;
     for (Index i = 0; i < paramTypes.getCount(); i++)
     {
@@ -91,6 +84,15 @@ IRFunc* specializeDispatchFunction(
     auto witnessTableSequentialID =
         builder->emitSwizzle(builder->getUIntType(), witnessTableParam, 1, &elemIdx);
 
+    auto emitCallAndReturn = [&](IRInst* callee, List<IRInst*> const& args)
+    {
+        auto specializedCallInst = builder->emitCallInst(callType, callee, args);
+        if (callType->getOp() == kIROp_VoidType)
+            builder->emitReturn();
+        else
+            builder->emitReturn(specializedCallInst);
+    };
+
     // Generate case blocks for each possible witness table.
     List<IRInst*> caseBlocks;
     for (Index i = 0; i < witnessTables.getCount(); i++)
@@ -105,43 +107,52 @@ IRFunc* specializeDispatchFunction(
                 witnessTable->getConcreteType());
         }
 
-        if (i != witnessTables.getCount() - 1)
+        if (fallbackFunc || i != witnessTables.getCount() - 1)
         {
             // Create a case block if we are not the last case.
             caseBlocks.add(seqIdDecoration->getSequentialIDOperand());
-            builder->setInsertInto(newDispatchFunc);
+            builder->setInsertInto(func);
             auto caseBlock = builder->emitBlock();
             caseBlocks.add(caseBlock);
         }
         else
         {
             // Generate code for the last possible value in the `default` block.
-            builder->setInsertInto(newDispatchFunc);
+            builder->setInsertInto(func);
             defaultBlock = builder->emitBlock();
             builder->setInsertInto(defaultBlock);
         }
 
         auto callee = findWitnessTableEntry(witnessTable, requirementKey);
         SLANG_ASSERT(callee);
-        auto specializedCallInst = builder->emitCallInst(callInst->getFullType(), callee, params);
-        if (callInst->getDataType()->getOp() == kIROp_VoidType)
-            builder->emitReturn();
-        else
-            builder->emitReturn(specializedCallInst);
+        emitCallAndReturn(callee, params);
+    }
+
+    if (fallbackFunc)
+    {
+        // All remaining IDs are handled by the fallback function, which takes the
+        // same parameters as this one.
+        builder->setInsertInto(func);
+        defaultBlock = builder->emitBlock();
+        builder->setInsertInto(defaultBlock);
+
+        List<IRInst*> fallbackArgs;
+        fallbackArgs.add(witnessTableParam);
+        fallbackArgs.addRange(params);
+        emitCallAndReturn(fallbackFunc, fallbackArgs);
     }
 
     // Emit a switch statement to call the correct concrete function based on
     // the witness table sequential ID passed in.
-    builder->setInsertInto(newDispatchFunc);
+    builder->setInsertInto(func);
 
-
-    if (witnessTables.getCount() == 1)
+    if (caseBlocks.getCount() == 0 && defaultBlock)
     {
         // If there is only 1 case, no switch statement is necessary.
         builder->setInsertInto(newBlock);
         builder->emitBranch(defaultBlock);
     }
-    else if (witnessTables.getCount() > 1)
+    else if (defaultBlock)
     {
         auto breakBlock = builder->emitBlock();
         builder->setInsertInto(breakBlock);
@@ -160,16 +171,123 @@ IRFunc* specializeDispatchFunction(
         // We have no witness tables that implements this interface.
         // Just return a default value.
         builder->setInsertInto(newBlock);
-        if (callInst->getDataType()->getOp() == kIROp_VoidType)
+        if (callType->getOp() == kIROp_VoidType)
         {
             builder->emitReturn();
         }
         else
         {
-            auto defaultValue = builder->emitDefaultConstruct(callInst->getDataType());
+            auto defaultValue = builder->emitDefaultConstruct(callType);
             builder->emitReturn(defaultValue);
         }
     }
+}
+
+IRFunc* specializeDispatchFunction(
+    SharedGenericsLoweringContext* sharedContext,
+    IRFunc* dispatchFunc)
+{
+    auto witnessTableType = cast<IRFuncType>(dispatchFunc->getDataType())->getParamType(0);
+    auto conformanceType = cast<IRWitnessTableTypeBase>(witnessTableType)->getConformanceType();
+    // Collect all witness tables of `witnessTableType` in current module.
+    List<IRWitnessTable*> witnessTables =
+        sharedContext->getWitnessTablesFromInterfaceType(conformanceType);
+
+    // Types marked with `[DispatchWeight]` are tested in order of decreasing
+    // weight, and the cases for cold types are outlined into a separate function.
+    List<IRWitnessTable*> coldWitnessTables;
+    _orderWitnessTablesByWeight(witnessTables, coldWitnessTables);
+    if (witnessTables.getCount() == 0)
+        witnessTables.swapWith(coldWitnessTables);
+
+    SLANG_ASSERT(dispatchFunc->getFirstBlock() == dispatchFunc->getLastBlock());
+    auto block = dispatchFunc->getFirstBlock();
+
+    // The dispatch function before modification must be in the form of
+    // call(lookup_interface_method(witnessTableParam, interfaceReqKey), args)
+    // We now find the relavent instructions.
+    IRCall* callInst = nullptr;
+    IRLookupWitnessMethod* lookupInst = nullptr;
+    // Only used in debug builds as a sanity check
+    [[maybe_unused]] IRReturn* returnInst = nullptr;
+    for (auto inst : block->getOrdinaryInsts())
+    {
+        switch (inst->getOp())
+        {
+        case kIROp_Call:
+            callInst = cast<IRCall>(inst);
+            break;
+        case kIROp_LookupWitness:
+            lookupInst = cast<IRLookupWitnessMethod>(inst);
+            break;
+        case kIROp_Return:
+            returnInst = cast<IRReturn>(inst);
+            break;
+        default:
+            break;
+        }
+    }
+    SLANG_ASSERT(callInst && lookupInst && returnInst);
+
+    IRBuilder builderStorage(sharedContext->module);
+    auto builder = &builderStorage;
+    builder->setInsertBefore(dispatchFunc);
+
+    // Create a new dispatch func to replace the existing one.
+    auto newDispatchFunc = builder->createFunc();
+
+    List<IRType*> paramTypes;
+    for (auto paramInst : dispatchFunc->getParams())
+    {
+        paramTypes.add(paramInst->getFullType());
+    }
+
+    // Modify the first paramter from IRWitnessTable to IRWitnessTableID representing the sequential
+    // ID.
+    paramTypes[0] = builder->getWitnessTableIDType((IRType*)conformanceType);
+
+    auto newDipsatchFuncType = builder->getFuncType(paramTypes, dispatchFunc->getResultType());
+    newDispatchFunc->setFullType(newDipsatchFuncType);
+    dispatchFunc->transferDecorationsTo(newDispatchFunc);
+
+    auto requirementKey = lookupInst->getRequirementKey();
+
+    // The cold cases are dispatched by a function of their own that is never inlined,
+    // which keeps the code for the hot path compact.
+    IRFunc* coldDispatchFunc = nullptr;
+    if (coldWitnessTables.getCount())
+    {
+        builder->setInsertBefore(newDispatchFunc);
+        coldDispatchFunc = builder->createFunc();
+        coldDispatchFunc->setFullType(newDipsatchFuncType);
+        builder->addDecoration(coldDispatchFunc, kIROp_NoInlineDecoration);
+        if (auto nameHint = newDispatchFunc->findDecoration<IRNameHintDecoration>())
+        {
+            StringBuilder coldName;
+            coldName << nameHint->getName() << "_cold";
+            builder->addNameHintDecoration(coldDispatchFunc, coldName.getUnownedSlice());
+        }
+        _emitDispatchSwitch(
+            sharedContext,
+            builder,
+            coldDispatchFunc,
+            paramTypes,
+            coldWitnessTables,
+            requirementKey,
+            callInst->getFullType(),
+            nullptr);
+    }
+
+    _emitDispatchSwitch(
+        sharedContext,
+        builder,
+        newDispatchFunc,
+        paramTypes,
+        witnessTables,
+        requirementKey,
+        callInst->getFullType(),
+        coldDispatchFunc);
+
     // Remove old implementation.
     dispatchFunc->replaceUsesWith(newDispatchFunc);
     dispatchFunc->removeAndDeallocate();
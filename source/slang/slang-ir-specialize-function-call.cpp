@@ -301,6 +301,10 @@ struct FunctionParameterSpecializationContext
     {
         Key key;
         List<IRInst*> newArgs;
+
+        // The call site, before which any instructions needed
+        // to compute the new arguments are inserted.
+        IRCall* oldCall = nullptr;
     };
 
     // Once we've collected the information about a call site
@@ -459,6 +463,8 @@ struct FunctionParameterSpecializationContext
     //
     void gatherCallInfo(IRCall* oldCall, IRFunc* oldFunc, CallSpecializationInfo& callInfo)
     {
+        callInfo.oldCall = oldCall;
+
         // The specialized callee key always needs to include
         // the original function, since different functions
         // will always yield different specializations.
@@ -566,16 +572,30 @@ struct FunctionParameterSpecializationContext
             // By doing so, we form an IRAttributedType to include both information
             // and add it to the key of call info.
 
+            //
+            // The index is passed as the type given by `getSpecializedIndexType`,
+            // so that call sites that only differ in the signedness of an index
+            // share a specialization.
+
+            auto newIndex = oldIndex;
+            auto indexType = getSpecializedIndexType(oldIndex);
+            if (indexType != oldIndex->getFullType())
+            {
+                IRBuilder castBuilder(module);
+                castBuilder.setInsertBefore(ioInfo.oldCall);
+                newIndex = castBuilder.emitCast(indexType, oldIndex);
+            }
+
             List<IRAttr*> irAttrs;
-            if (findNonuniformIndexInst(oldIndex))
+            if (findNonuniformIndexInst(newIndex))
             {
                 IRAttr* attr = getBuilder()->getAttr(kIROp_NonUniformAttr);
                 irAttrs.add(attr);
             }
-            auto irType = getBuilder()->getAttributedType(oldIndex->getDataType(), irAttrs);
+            auto irType = getBuilder()->getAttributedType(newIndex->getDataType(), irAttrs);
             ioInfo.key.vals.add(irType);
 
-            ioInfo.newArgs.add(oldIndex);
+            ioInfo.newArgs.add(newIndex);
         }
         else if (oldArg->getOp() == kIROp_Load)
         {
@@ -593,6 +613,29 @@ struct FunctionParameterSpecializationContext
         }
     }
 
+    // Get the type that `index` is passed as to a specialized callee.
+    //
+    // Signed and unsigned indices of the same width address an array
+    // the same way, so an unsigned index is passed as the signed type.
+    // Otherwise a callee would be specialized once for each signedness
+    // of the indices used at its call sites.
+    //
+    IRType* getSpecializedIndexType(IRInst* index)
+    {
+        auto type = index->getFullType();
+        if (type != index->getDataType())
+            return type;
+        switch (type->getOp())
+        {
+        case kIROp_UIntType:
+            return getBuilder()->getIntType();
+        case kIROp_UInt64Type:
+            return getBuilder()->getInt64Type();
+        default:
+            return type;
+        }
+    }
+
     IRInst* findNonuniformIndexInst(IRInst* inst)
     {
         for (;;)
@@ -758,7 +801,7 @@ struct FunctionParameterSpecializationContext
             // the body of the specialized callee.
             //
             auto builder = getBuilder();
-            auto newIndex = builder->createParam(oldIndex->getFullType());
+            auto newIndex = builder->createParam(getSpecializedIndexType(oldIndex));
             ioInfo.newParams.add(newIndex);
 
             // Finally, we need to compute a value that
@@ -5,6 +5,7 @@
 #include "slang-ir-clone.h"
 #include "slang-ir-dce.h"
 #include "slang-ir-insts.h"
+#include "slang-ir-link.h"
 #include "slang-ir-lower-witness-lookup.h"
 #include "slang-ir-peephole.h"
 #include "slang-ir-sccp.h"
@@ -213,6 +214,46 @@ struct SpecializationContext
     typedef IRSimpleSpecializationKey Key;
     Dictionary<Key, IRInst*> genericSpecializations;
 
+    // Entry points of a program that are compiled separately each get their
+    // own module to specialize, but tend to need the same specializations.
+    // Specialized functions are therefore also cached on the target program,
+    // using a key that doesn't depend on the module (see `getSpecializationCacheKey`).
+    //
+    // We track the specializations of this module by that key, and the
+    // global values with linkage by mangled name, in order to bind the values
+    // that a function cloned out of the cache refers to.
+    //
+    Dictionary<String, IRInst*> cacheableSpecializations;
+    Dictionary<String, IRInst*> moduleSymbols;
+
+    // A generic that specializes itself with ever larger arguments, such as
+    // `f<T>` calling `f<Wrapper<T>>`, makes new specializations without end.
+    // With `-specialization-depth-budget`, we track how deeply each
+    // specialization we make is nested in the arguments of the others (a
+    // specialization with arguments that aren't specializations has a depth
+    // of 1), and report an error instead of going over the budget.
+    //
+    Index specializationDepthBudget = 0;
+    Dictionary<IRInst*, Index> specializationDepths;
+    bool reportedSpecializationDepth = false;
+
+    Index getSpecializationDepth(IRInst* inst)
+    {
+        if (auto depth = specializationDepths.tryGetValue(inst))
+            return *depth;
+
+        // A type made from specializations, like a pointer to one, is as deep
+        // as they are.
+        //
+        Index depth = 0;
+        if (as<IRType>(inst))
+        {
+            for (UInt ii = 0; ii < inst->getOperandCount(); ++ii)
+                depth = Math::Max(depth, getSpecializationDepth(inst->getOperand(ii)));
+        }
+        return depth;
+    }
+
 
     // Now let's look at the task of finding or generation a
     // specialization of some generic `g`, given a specialization
@@ -220,7 +261,8 @@ struct SpecializationContext
     //
     // The `specializeGeneric` function will return a value
     // suitable for use as a replacement for the `specialize(...)`
-    // instruction.
+    // instruction, or null if making it would go over the
+    // specialization depth budget.
     //
     IRInst* specializeGeneric(IRGeneric* genericVal, IRSpecialize* specializeInst)
     {
@@ -273,6 +315,61 @@ struct SpecializationContext
                 return specializedVal;
         }
 
+        // Next we will look for the same specialization under its cache key,
+        // which can find one made in this module for equivalent arguments, or
+        // one cached by an earlier compilation for the same target program.
+        //
+        StringBuilder cacheKey;
+        bool isCacheable = targetProgram && getSpecializationCacheKey(key, cacheKey);
+        if (isCacheable)
+        {
+            IRInst* specializedVal = nullptr;
+            if (!cacheableSpecializations.tryGetValue(cacheKey, specializedVal) ||
+                !specializedVal->getParent())
+            {
+                specializedVal = cloneCachedSpecialization(
+                    targetProgram,
+                    module,
+                    cacheKey,
+                    moduleSymbols,
+                    cacheableSpecializations);
+                if (specializedVal)
+                {
+                    for (auto child : specializedVal->getDecorationsAndChildren())
+                        addToWorkList(child);
+                }
+            }
+            if (specializedVal)
+            {
+                cacheableSpecializations[cacheKey] = specializedVal;
+                genericSpecializations.add(key, specializedVal);
+                return specializedVal;
+            }
+        }
+
+        Index depth = 0;
+        if (specializationDepthBudget > 0)
+        {
+            for (UInt ii = 0; ii < argCount; ++ii)
+                depth = Math::Max(depth, getSpecializationDepth(specializeInst->getArg(ii)));
+            depth++;
+
+            if (depth > specializationDepthBudget)
+            {
+                if (!reportedSpecializationDepth)
+                {
+                    reportedSpecializationDepth = true;
+                    sink->diagnose(
+                        specializeInst,
+                        Diagnostics::specializationDepthBudgetExceeded,
+                        genericVal,
+                        depth,
+                        specializationDepthBudget);
+                }
+                return nullptr;
+            }
+        }
+
         // If no existing specialization is found, we need
         // to create the specialization instead.
         // This mostly amounts to evaluating the generic as
@@ -297,6 +394,10 @@ struct SpecializationContext
         // this generic again for the same arguments.
         //
         genericSpecializations.add(key, specializedVal);
+        if (isCacheable)
+            cacheableSpecializations[cacheKey] = specializedVal;
+        if (depth)
+            specializationDepths[specializedVal] = depth;
 
         return specializedVal;
     }
@@ -502,6 +603,8 @@ struct SpecializationContext
         // type, function, or whatever).
         //
         auto specializedVal = specializeGeneric(genericVal, specInst);
+        if (!specializedVal)
+            return false;
 
         // Any uses of this `specialize(...)` instruction will
         // become uses of `specializeVal`, so we want to re-consider
@@ -982,6 +1085,19 @@ struct SpecializationContext
         // when this pass is invoked iteratively.
         readSpecializationDictionaries();
 
+        if (targetProgram)
+        {
+            specializationDepthBudget = targetProgram->getOptionSet().getIntOption(
+                CompilerOptionName::SpecializationDepthBudget);
+
+            for (const auto& [key, value] : genericSpecializations)
+            {
+                StringBuilder cacheKey;
+                if (getSpecializationCacheKey(key, cacheKey))
+                    cacheableSpecializations[cacheKey] = value;
+            }
+        }
+
         // The unspecialized IR we receive as input will have
         // `IRBindGlobalGenericParam` instructions that associate
         // each global-scope generic parameter (a type, witness
@@ -1084,6 +1200,7 @@ struct SpecializationContext
             {
                 this->changed = true;
                 eliminateDeadCode(module->getModuleInst());
+                moduleSymbols.clear();
             }
 
             // Once the work list has gone dry, we should have the invariant
@@ -1102,6 +1219,11 @@ struct SpecializationContext
         }
 
 
+        // Share the functions specialized for this module with any later
+        // compilation for the same target program.
+        if (targetProgram && sink->getErrorCount() == 0)
+            addCachedSpecializations(targetProgram, module, cacheableSpecializations);
+
         // For functions that still have `specialize` uses left, we need to preserve the
         // its specializations in resulting IR so they can be reconstructed when this
         // specialization pass gets invoked again.
@@ -0,0 +1,267 @@
+#include "slang-ir-sroa.h"
+
+#include "slang-diagnostics.h"
+#include "slang-ir-insts.h"
+#include "slang-ir-util.h"
+#include "slang-ir.h"
+
+namespace Slang
+{
+
+// Arrays with more elements than this are left alone, as splitting them makes the code larger
+// for little gain.
+static const IRIntegerValue kMaxSplitElementCount = 16;
+
+// A field or element of a variable being split.
+struct AggregateElement
+{
+    IRInst* key;   // The field key, or the constant index of the element.
+    IRType* type;
+};
+
+static bool _getAggregateElements(IRType* type, List<AggregateElement>& outElements)
+{
+    if (auto structType = as<IRStructType>(type))
+    {
+        for (auto field : structType->getFields())
+            outElements.add(AggregateElement{field->getKey(), field->getFieldType()});
+    }
+    else if (auto arrayType = as<IRArrayType>(type))
+    {
+        auto count = as<IRIntLit>(arrayType->getElementCount());
+        if (!count || count->getValue() > kMaxSplitElementCount)
+            return false;
+
+        IRBuilder builder(type);
+        for (IRIntegerValue i = 0; i < count->getValue(); i++)
+        {
+            outElements.add(
+                AggregateElement{builder.getIntValue(builder.getIntType(), i),
+                                 arrayType->getElementType()});
+        }
+    }
+    return outElements.getCount() != 0 && outElements.getCount() <= kMaxSplitElementCount;
+}
+
+// Find the element of `elements` accessed by `accessInst`, the address of a field or element of
+// the variable.
+static Index _findAccessedElement(List<AggregateElement> const& elements, IRInst* accessInst)
+{
+    auto key = accessInst->getOperand(1);
+    if (accessInst->getOp() == kIROp_GetElementPtr)
+    {
+        auto index = as<IRIntLit>(key);
+        if (!index || index->getValue() < 0 || index->getValue() >= elements.getCount())
+            return -1;
+        return Index(index->getValue());
+    }
+    for (Index i = 0; i < elements.getCount(); i++)
+    {
+        if (elements[i].key == key)
+            return i;
+    }
+    return -1;
+}
+
+static bool _canSplitVar(IRVar* var, List<AggregateElement> const& elements)
+{
+    // Other decorations, such as those for debug information, can't be carried over to the
+    // element variables.
+    for (auto decoration : var->getDecorations())
+    {
+        if (!as<IRNameHintDecoration>(decoration))
+            return false;
+    }
+
+    bool hasPartialUpdate = false;
+    for (auto use = var->firstUse; use; use = use->nextUse)
+    {
+        auto user = use->getUser();
+        switch (user->getOp())
+        {
+        case kIROp_Load:
+            break;
+        case kIROp_Store:
+            if (use != user->getOperands())
+                return false;
+            break;
+        case kIROp_FieldAddress:
+        case kIROp_GetElementPtr:
+            if (use != user->getOperands() || _findAccessedElement(elements, user) < 0)
+                return false;
+            for (auto elementUse = user->firstUse; elementUse; elementUse = elementUse->nextUse)
+            {
+                if (elementUse->getUser()->getOp() != kIROp_Load)
+                    hasPartialUpdate = true;
+            }
+            break;
+        default:
+            return false;
+        }
+    }
+
+    // A variable whose fields and elements are only loaded can be promoted as it is.
+    return hasPartialUpdate;
+}
+
+static void _splitVar(
+    IRBuilder& builder,
+    IRVar* var,
+    List<AggregateElement> const& elements,
+    List<IRVar*>& outElementVars)
+{
+    auto valueType = var->getDataType()->getValueType();
+    auto nameHint = var->findDecoration<IRNameHintDecoration>();
+
+    builder.setInsertBefore(var);
+    for (Index i = 0; i < elements.getCount(); i++)
+    {
+        auto elementVar = builder.emitVar(elements[i].type);
+        if (nameHint)
+        {
+            StringBuilder name;
+            name << nameHint->getName() << "_" << i;
+            builder.addNameHintDecoration(elementVar, name.getUnownedSlice());
+        }
+        outElementVars.add(elementVar);
+    }
+
+    List<IRInst*> users;
+    for (auto use = var->firstUse; use; use = use->nextUse)
+        users.add(use->getUser());
+
+    for (auto user : users)
+    {
+        builder.setInsertBefore(user);
+        switch (user->getOp())
+        {
+        case kIROp_Load:
+            {
+                List<IRInst*> elementValues;
+                for (auto elementVar : outElementVars)
+                    elementValues.add(builder.emitLoad(elementVar));
+                IRInst* value =
+                    as<IRStructType>(valueType)
+                        ? builder.emitMakeStruct(valueType, elementValues)
+                        : builder.emitMakeArray(
+                              valueType,
+                              elementValues.getCount(),
+                              elementValues.getBuffer());
+                user->replaceUsesWith(value);
+                break;
+            }
+        case kIROp_Store:
+            {
+                auto value = as<IRStore>(user)->getVal();
+                for (Index i = 0; i < elements.getCount(); i++)
+                {
+                    auto elementValue =
+                        as<IRStructType>(valueType)
+                            ? builder.emitFieldExtract(elements[i].type, value, elements[i].key)
+                            : builder.emitElementExtract(elements[i].type, value, elements[i].key);
+                    builder.emitStore(outElementVars[i], elementValue);
+                }
+                break;
+            }
+        default:
+            user->replaceUsesWith(outElementVars[_findAccessedElement(elements, user)]);
+            break;
+        }
+        user->removeAndDeallocate();
+    }
+    var->removeAndDeallocate();
+}
+
+bool splitAggregateVars(IRGlobalValueWithCode* func)
+{
+    List<IRVar*> workList;
+    for (auto block : func->getBlocks())
+    {
+        for (auto inst : block->getChildren())
+        {
+            if (auto var = as<IRVar>(inst))
+                workList.add(var);
+        }
+    }
+
+    bool changed = false;
+    IRBuilder builder(func);
+    for (Index i = 0; i < workList.getCount(); i++)
+    {
+        auto var = workList[i];
+        List<AggregateElement> elements;
+        if (!_getAggregateElements(var->getDataType()->getValueType(), elements))
+            continue;
+        if (!_canSplitVar(var, elements))
+            continue;
+
+        // The variables of fields that are aggregates themselves may be split in turn.
+        List<IRVar*> elementVars;
+        _splitVar(builder, var, elements, elementVars);
+        workList.addRange(elementVars);
+        changed = true;
+    }
+    return changed;
+}
+
+// Find out why a variable, or the field or element of it at `addr`, can't be promoted to SSA
+// form, for reporting.
+static const char* _getUnpromotedVarReason(IRInst* addr, bool isElement)
+{
+    for (auto use = addr->firstUse; use; use = use->nextUse)
+    {
+        auto user = use->getUser();
+        switch (user->getOp())
+        {
+        case kIROp_Load:
+            break;
+        case kIROp_Store:
+            if (use != user->getOperands())
+                return "its address is stored";
+            if (isElement)
+                return "its fields or elements are written one at a time";
+            break;
+        case kIROp_GetElementPtr:
+            if (!as<IRIntLit>(user->getOperand(1)))
+                return "it is indexed with a value that is not a constant";
+            [[fallthrough]];
+        case kIROp_FieldAddress:
+            if (auto reason = _getUnpromotedVarReason(user, true))
+                return reason;
+            break;
+        case kIROp_Call:
+            return "its address is passed to a function";
+        default:
+            return "its address is used by an operation other than a load or store";
+        }
+    }
+    return nullptr;
+}
+
+void reportUnpromotedVars(IRModule* module, DiagnosticSink* sink)
+{
+    for (auto globalInst : module->getGlobalInsts())
+    {
+        auto func = as<IRFunc>(globalInst);
+        if (!func)
+            continue;
+        for (auto block : func->getBlocks())
+        {
+            for (auto inst : block->getChildren())
+            {
+                auto var = as<IRVar>(inst);
+                if (!var)
+                    continue;
+                auto valueType = var->getDataType()->getValueType();
+                if (!as<IRStructType>(valueType) && !as<IRArrayTypeBase>(valueType))
+                    continue;
+                auto reason = _getUnpromotedVarReason(var, false);
+                if (!reason)
+                    continue;
+                sink->diagnose(var, Diagnostics::reportUnpromotedVar, var, valueType, reason);
+            }
+        }
+    }
+}
+
+} // namespace Slang
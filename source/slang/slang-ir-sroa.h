@@ -0,0 +1,26 @@
+// slang-ir-sroa.h
+#pragma once
+
+namespace Slang
+{
+struct IRGlobalValueWithCode;
+struct IRModule;
+class DiagnosticSink;
+
+/// Split local variables of struct and small array types into a variable per field or
+/// element (scalar replacement of aggregates).
+///
+/// A variable is split when every use of it is a load or store of the whole variable, or the
+/// address of a field or of an element at a constant index, and at least one of the field or
+/// element addresses is used for something other than a load. Such a variable can't be
+/// promoted by `constructSSA`, but the variables it is split into usually can. Whole loads
+/// and stores become loads and stores of every field or element.
+///
+/// Returns true if any variable was split.
+bool splitAggregateVars(IRGlobalValueWithCode* func);
+
+/// Report the local variables of struct and array types in `module` that are still kept in
+/// memory, and why.
+void reportUnpromotedVars(IRModule* module, DiagnosticSink* sink);
+
+} // namespace Slang
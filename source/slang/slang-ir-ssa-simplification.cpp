@@ -10,6 +10,7 @@
 #include "slang-ir-remove-unused-generic-param.h"
 #include "slang-ir-sccp.h"
 #include "slang-ir-simplify-cfg.h"
+#include "slang-ir-sroa.h"
 #include "slang-ir-ssa.h"
 #include "slang-ir-util.h"
 #include "slang-ir.h"
@@ -27,8 +28,15 @@ IRSimplificationOptions IRSimplificationOptions::getDefault(TargetProgram* targe
         result.cfgOptions = CFGSimplificationOptions::getDefault();
     result.peepholeOptions = PeepholeOptimizationOptions();
     if (targetProgram)
+    {
         result.deadCodeElimOptions.keepGlobalParamsAlive =
             targetProgram->getOptionSet().getBoolOption(CompilerOptionName::PreserveParameters);
+
+        const auto optimizationLevel = targetProgram->getOptionSet().getOptimizationLevel();
+        result.splitAggregateVars = !result.minimalOptimization &&
+                                    (optimizationLevel == OptimizationLevel::High ||
+                                     optimizationLevel == OptimizationLevel::Maximal);
+    }
     result.deadCodeElimOptions.useFastAnalysis = result.minimalOptimization;
     return result;
 }
@@ -47,8 +55,48 @@ IRSimplificationOptions IRSimplificationOptions::getFast(TargetProgram* targetPr
     return result;
 }
 
+// Find the global-scope instruction that `inst` is (or is nested in).
+static IRInst* _findOuterGlobalInst(IRInst* inst)
+{
+    while (inst->getParent() && !as<IRModuleInst>(inst->getParent()))
+        inst = inst->getParent();
+    return inst;
+}
+
+// Add the functions that use `func` (directly, or through global-scope instructions
+// such as specializations or witness tables) to `ioFuncs`.
+//
+// Simplifying a function can open up opportunities in the functions that call it,
+// so those need to be simplified again too.
+static void _addDependentFuncs(IRInst* func, HashSet<IRInst*>& ioFuncs)
+{
+    HashSet<IRInst*> visited;
+    List<IRInst*> workList;
+    visited.add(func);
+    workList.add(func);
+    while (workList.getCount())
+    {
+        IRInst* value = workList.getLast();
+        workList.removeLast();
+
+        for (auto use = value->firstUse; use; use = use->nextUse)
+        {
+            IRInst* outer = _findOuterGlobalInst(use->getUser());
+            if (outer != use->getUser() && as<IRGlobalValueWithCode>(outer))
+                ioFuncs.add(outer);
+            else if (visited.add(outer))
+                workList.add(outer);
+        }
+    }
+}
+
 // Run a combination of SSA, SCCP, SimplifyCFG, and DeadCodeElimination pass
 // until no more changes are possible.
+//
+// After the first iteration only the functions that may have new opportunities are
+// simplified again: those that changed in the previous iteration and the functions
+// that use them. If any of the global-scope passes change the module, every function
+// is simplified again.
 void simplifyIR(
     TargetProgram* target,
     IRModule* module,
@@ -61,6 +109,10 @@ void simplifyIR(
     const int kMaxFuncIterations = 16;
     int iterationCounter = 0;
 
+    // The functions to simplify in the current iteration, if not all of them.
+    HashSet<IRInst*> dirtyFuncs;
+    bool allFuncsDirty = true;
+
     while (changed && iterationCounter < kMaxIterations)
     {
         if (sink && sink->getErrorCount())
@@ -68,18 +120,26 @@ void simplifyIR(
 
         changed = false;
 
-        changed |= deduplicateGenericChildren(module);
-        changed |= propagateFuncProperties(module);
-        changed |= removeUnusedGenericParam(module);
-        changed |= applySparseConditionalConstantPropagationForGlobalScope(module, sink);
-        changed |= peepholeOptimizeGlobalScope(target, module);
-        changed |= trimOptimizableTypes(module);
+        bool globalScopeChanged = false;
+        globalScopeChanged |= deduplicateGenericChildren(module);
+        globalScopeChanged |= propagateFuncProperties(module);
+        globalScopeChanged |= removeUnusedGenericParam(module);
+        globalScopeChanged |= applySparseConditionalConstantPropagationForGlobalScope(module, sink);
+        globalScopeChanged |= peepholeOptimizeGlobalScope(target, module);
+        globalScopeChanged |= trimOptimizableTypes(module);
+        changed |= globalScopeChanged;
+
+        if (globalScopeChanged)
+            allFuncsDirty = true;
 
+        HashSet<IRInst*> changedFuncs;
         for (auto inst : module->getGlobalInsts())
         {
             auto func = as<IRGlobalValueWithCode>(inst);
             if (!func)
                 continue;
+            if (!allFuncsDirty && !dirtyFuncs.contains(func))
+                continue;
             bool funcChanged = true;
             int funcIterationCount = 0;
             while (funcChanged && funcIterationCount < kMaxFuncIterations)
@@ -100,11 +160,26 @@ void simplifyIR(
                 //
                 eliminateDeadCode(func, options.deadCodeElimOptions);
                 if (funcIterationCount == 0)
+                {
+                    if (options.splitAggregateVars)
+                        funcChanged |= splitAggregateVars(func);
                     funcChanged |= constructSSA(func);
+                }
+                if (funcChanged)
+                    changedFuncs.add(func);
                 changed |= funcChanged;
                 funcIterationCount++;
             }
         }
+
+        dirtyFuncs.clear();
+        for (auto func : changedFuncs)
+        {
+            dirtyFuncs.add(func);
+            _addDependentFuncs(func, dirtyFuncs);
+        }
+        allFuncsDirty = false;
+
         iterationCounter++;
     }
     eliminateDeadCode(module, options.deadCodeElimOptions);
@@ -21,6 +21,10 @@ struct IRSimplificationOptions
     bool minimalOptimization = false;
     bool removeRedundancy = false;
 
+    // Split local struct and array variables into a variable per field or element, before
+    // promoting variables to SSA form.
+    bool splitAggregateVars = false;
+
     static IRSimplificationOptions getDefault(TargetProgram* targetProgram);
 
     static IRSimplificationOptions getFast(TargetProgram* targetProgram);
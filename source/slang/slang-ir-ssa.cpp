@@ -82,6 +82,10 @@ struct ConstructSSAContext
     // to SSA values.
     List<IRVar*> promotableVars;
 
+    // The same variables as `promotableVars`, for checking
+    // if a variable is promotable at each load and store.
+    HashSet<IRVar*> promotableVarSet;
+
     // Information about each basic block
     Dictionary<IRBlock*, RefPtr<SSABlockInfo>> blockInfos;
 
@@ -144,7 +148,7 @@ bool allUsesLeadToLoads(IRInst* inst)
 }
 
 // Is the given variable one that we can promote to SSA form?
-bool isPromotableVar(ConstructSSAContext* /*context*/, IRVar* var, HashSet<IRBlock*>& knownBlocks)
+bool isPromotableVar(ConstructSSAContext* context, IRVar* var)
 {
     // We want to identify variables such that we can always
     // determine what they will contain at a point in the
@@ -225,8 +229,9 @@ bool isPromotableVar(ConstructSSAContext* /*context*/, IRVar* var, HashSet<IRBlo
             break;
         }
 
-        // If the use is outside of known blocks, then we can't promote it.
-        if (!knownBlocks.contains(getBlock(user)))
+        // If the use is outside of the blocks of the function, then we can't promote it.
+        auto userBlock = getBlock(user);
+        if (!userBlock || userBlock->getParent() != context->globalVal)
             return false;
     }
 
@@ -239,12 +244,6 @@ bool isPromotableVar(ConstructSSAContext* /*context*/, IRVar* var, HashSet<IRBlo
 // Identify local variables that can be promoted to SSA form
 void identifyPromotableVars(ConstructSSAContext* context)
 {
-    HashSet<IRBlock*> knownBlocks;
-    for (auto bb = context->globalVal->getFirstBlock(); bb; bb = bb->getNextBlock())
-    {
-        knownBlocks.add(bb);
-    }
-
     for (auto bb = context->globalVal->getFirstBlock(); bb; bb = bb->getNextBlock())
     {
         for (auto ii = bb->getFirstInst(); ii; ii = ii->getNextInst())
@@ -254,9 +253,10 @@ void identifyPromotableVars(ConstructSSAContext* context)
 
             IRVar* var = (IRVar*)ii;
 
-            if (isPromotableVar(context, var, knownBlocks))
+            if (isPromotableVar(context, var))
             {
                 context->promotableVars.add(var);
+                context->promotableVarSet.add(var);
             }
         }
     }
@@ -269,7 +269,7 @@ IRVar* asPromotableVar(ConstructSSAContext* context, IRInst* value)
         return nullptr;
 
     IRVar* var = (IRVar*)value;
-    if (!context->promotableVars.contains(var))
+    if (!context->promotableVarSet.contains(var))
         return nullptr;
 
     return var;
@@ -822,7 +822,8 @@ void processBlock(ConstructSSAContext* context, IRBlock* block, SSABlockInfo* bl
     // leave them as-is, or replace them with a value
     // that we look up with local/global value numbering
 
-    List<IRInst*> workList;
+    PooledList<IRInst> pooledWorkList;
+    auto& workList = *pooledWorkList;
     for (auto ii = block->getFirstInst(); ii; ii = ii->getNextInst())
         workList.add(ii);
 
@@ -1043,12 +1044,13 @@ static void breakCriticalEdges(ConstructSSAContext* context)
 // Construct SSA form for a global value with code
 bool constructSSA(ConstructSSAContext* context)
 {
-    // First, detect and and break any critical edges in the CFG,
-    // because our representation of SSA form doesn't allow for them.
-    breakCriticalEdges(context);
-
     // Figure out what variables we can promote to
     // SSA temporaries.
+    //
+    // This pass is run many times over every function, and
+    // after the first time most functions have nothing left
+    // to promote, so this is done first, with a single walk
+    // over the instructions.
     identifyPromotableVars(context);
 
     // If none of the variables are promote-able,
@@ -1056,6 +1058,13 @@ bool constructSSA(ConstructSSAContext* context)
     if (context->promotableVars.getCount() == 0)
         return false;
 
+    // Detect and and break any critical edges in the CFG,
+    // because our representation of SSA form doesn't allow for
+    // them on the edges that we add phi arguments to. Breaking
+    // critical edges doesn't change which blocks the uses of
+    // the variables are in.
+    breakCriticalEdges(context);
+
     // We are going to walk the blocks in order,
     // and try to process each, by replacing loads
     // and stores of promotable variables with simple values.
@@ -51,4 +51,52 @@ void stripFrontEndOnlyInstructions(IRModule* module, IRStripOptions const& optio
     _stripFrontEndOnlyInstructionsRec(module->getModuleInst(), options);
 }
 
+static void _collectNamesAndDebugInfoRec(IRInst* inst, List<IRInst*> (&ioInstsByStage)[3])
+{
+    for (auto child : inst->getDecorationsAndChildren())
+    {
+        switch (child->getOp())
+        {
+        case kIROp_NameHintDecoration:
+            // The names of shader parameters are part of the interface of the program,
+            // which the application may bind by, so they are kept.
+            if (!as<IRGlobalParam>(inst))
+                ioInstsByStage[0].add(child);
+            continue;
+        case kIROp_DebugLocationDecoration:
+        case kIROp_DebugLine:
+        case kIROp_DebugValue:
+            ioInstsByStage[0].add(child);
+            continue;
+        case kIROp_DebugVar:
+            ioInstsByStage[1].add(child);
+            continue;
+        case kIROp_DebugSource:
+            ioInstsByStage[2].add(child);
+            continue;
+        default:
+            break;
+        }
+        _collectNamesAndDebugInfoRec(child, ioInstsByStage);
+    }
+}
+
+void stripNamesAndDebugInfo(IRModule* module)
+{
+    // Debug values refer to debug variables, and everything else refers to debug
+    // sources, so the instructions are removed in stages, users before what they use.
+    List<IRInst*> instsByStage[3];
+    _collectNamesAndDebugInfoRec(module->getModuleInst(), instsByStage);
+
+    for (auto& insts : instsByStage)
+    {
+        for (auto inst : insts)
+        {
+            // Anything that still refers to the instruction makes it worth keeping.
+            if (!inst->hasUses())
+                inst->removeAndDeallocate();
+        }
+    }
+}
+
 } // namespace Slang
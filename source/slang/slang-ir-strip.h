@@ -13,5 +13,14 @@ struct IRStripOptions
 
 /// Strip out instructions that should only be used by the front-end.
 void stripFrontEndOnlyInstructions(IRModule* module, IRStripOptions const& options);
+
+/// Strip the name hints and debug information (debug lines, variables, values, sources and
+/// locations) from `module`.
+///
+/// This is meant for a linked module, when the generated code should contain neither, so
+/// that the rest of code generation doesn't have to carry them along. The names of shader
+/// parameters are kept, since applications may bind parameters by name. Source locations
+/// are kept too, as later passes still use them to report diagnostics.
+void stripNamesAndDebugInfo(IRModule* module);
 } // namespace Slang
 #pragma once
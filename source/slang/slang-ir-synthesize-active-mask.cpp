@@ -968,7 +968,7 @@ struct SynthesizeActiveMaskForFunctionContext
         // the function, since that will help us
         // identify the regions.
         //
-        m_dominatorTree = computeDominatorTree(m_func);
+        m_dominatorTree = m_func->getModule()->findOrCreateDominatorTree(m_func);
 
         // Next we look up th active mask for the function's
         // entry region, which had better be set before
@@ -1,6 +1,7 @@
 #include "slang-ir-uniformity.h"
 
 #include "slang-ir-dominators.h"
+#include "slang-ir-inline.h"
 #include "slang-ir-insts.h"
 #include "slang-ir-util.h"
 #include "slang-ir.h"
@@ -17,6 +18,14 @@ struct ValidateUniformityContext
     IRCall* call = nullptr;
     IRFunc* currentCallee = nullptr;
 
+    // Whether values that should be dynamically uniform but aren't are diagnosed.
+    bool shouldDiagnose = true;
+
+    // When set, these collect the insts found to be non-uniform in any of the calls
+    // analyzed, and the functions that were analyzed, for passes that use the results.
+    HashSet<IRInst*>* nonUniformInstsInAnyCall = nullptr;
+    HashSet<IRInst*>* analyzedFuncs = nullptr;
+
     bool isInstNonUniform(IRInst* inst)
     {
         auto context = this;
@@ -111,6 +120,9 @@ struct ValidateUniformityContext
         subContext.module = module;
         subContext.sink = sink;
         subContext.parentContext = this;
+        subContext.shouldDiagnose = shouldDiagnose;
+        subContext.nonUniformInstsInAnyCall = nonUniformInstsInAnyCall;
+        subContext.analyzedFuncs = analyzedFuncs;
 
         List<IRInst*> workList;
         Index paramIndex = 0;
@@ -126,6 +138,7 @@ struct ValidateUniformityContext
         subContext.call = callInst;
         subContext.currentCallee = key.func;
         subContext.propagateNonUniform(key.func, workList);
+        subContext.collectResults(key.func);
 
         FunctionNonUniformInfo info;
         info.nonUniformParams = key.nonUniformParams;
@@ -303,10 +316,11 @@ struct ValidateUniformityContext
                                 addToWorkList(ptr);
                                 if (isDynamicUniformLocation(ptr))
                                 {
-                                    sink->diagnose(
-                                        user->sourceLoc,
-                                        Diagnostics::expectDynamicUniformValue,
-                                        ptr);
+                                    if (shouldDiagnose)
+                                        sink->diagnose(
+                                            user->sourceLoc,
+                                            Diagnostics::expectDynamicUniformValue,
+                                            ptr);
                                 }
                                 else
                                 {
@@ -358,10 +372,11 @@ struct ValidateUniformityContext
                                             auto param = getParamAt(func->getFirstBlock(), argi);
                                             if (param->findDecoration<IRDynamicUniformDecoration>())
                                             {
-                                                sink->diagnose(
-                                                    callInst->sourceLoc,
-                                                    Diagnostics::expectDynamicUniformArgument,
-                                                    param);
+                                                if (shouldDiagnose)
+                                                    sink->diagnose(
+                                                        callInst->sourceLoc,
+                                                        Diagnostics::expectDynamicUniformArgument,
+                                                        param);
                                             }
                                             else
                                             {
@@ -462,6 +477,7 @@ struct ValidateUniformityContext
                 currentCallee = func;
                 call = nullptr;
                 propagateNonUniform(func, workList.getList());
+                collectResults(func);
             }
         }
         workList.clear();
@@ -469,6 +485,15 @@ struct ValidateUniformityContext
         eliminateAsDynamicUniformInst();
     }
 
+    void collectResults(IRFunc* func)
+    {
+        if (!nonUniformInstsInAnyCall)
+            return;
+        for (auto inst : nonUniformInsts)
+            nonUniformInstsInAnyCall->add(inst);
+        analyzedFuncs->add(func);
+    }
+
     void eliminateAsDynamicUniformInst()
     {
         InstWorkList workList(module);
@@ -500,4 +525,96 @@ void validateUniformity(IRModule* module, DiagnosticSink* sink)
     context.sink = sink;
     context.analyzeModule();
 }
+
+static IRFunc* findAggregatedAtomicAdd(IRModule* module, UnownedStringSlice name)
+{
+    for (auto globalInst : module->getGlobalInsts())
+    {
+        if (auto knownBuiltin = globalInst->findDecoration<IRKnownBuiltinDecoration>())
+        {
+            if (knownBuiltin->getName() == name)
+                return as<IRFunc>(globalInst);
+        }
+    }
+    return nullptr;
+}
+
+void aggregateUniformAtomics(IRModule* module, DiagnosticSink* sink)
+{
+    // The replacements are linked in by `linkIR` when the option is set, and
+    // are kept alive until now.
+    IRFunc* uintAtomicAdd =
+        findAggregatedAtomicAdd(module, UnownedStringSlice("WaveAggregatedAtomicAddUInt"));
+    IRFunc* intAtomicAdd =
+        findAggregatedAtomicAdd(module, UnownedStringSlice("WaveAggregatedAtomicAddInt"));
+    if (!uintAtomicAdd && !intAtomicAdd)
+        return;
+
+    HashSet<IRInst*> nonUniformInsts;
+    HashSet<IRInst*> analyzedFuncs;
+    {
+        ValidateUniformityContext context;
+        context.module = module;
+        context.sink = sink;
+        context.shouldDiagnose = false;
+        context.nonUniformInstsInAnyCall = &nonUniformInsts;
+        context.analyzedFuncs = &analyzedFuncs;
+        context.analyzeModule();
+    }
+
+    // An atomic can only be replaced if its address is uniform in every call to
+    // the function it is in, since all the calls share it.
+    List<IRInst*> atomics;
+    for (auto func : analyzedFuncs)
+    {
+        for (auto block : as<IRFunc>(func)->getBlocks())
+        {
+            for (auto inst : block->getChildren())
+            {
+                if (inst->getOp() != kIROp_AtomicAdd && inst->getOp() != kIROp_AtomicSub)
+                    continue;
+                if (nonUniformInsts.contains(inst->getOperand(0)))
+                    continue;
+                if (inst->getOperandCount() > 2)
+                {
+                    auto order = as<IRIntLit>(inst->getOperand(2));
+                    if (!order || order->getValue() != kIRMemoryOrder_Relaxed)
+                        continue;
+                }
+                atomics.add(inst);
+            }
+        }
+    }
+
+    IRBuilder builder(module);
+    for (auto atomic : atomics)
+    {
+        auto type = atomic->getDataType();
+        IRFunc* atomicAdd = nullptr;
+        if (type->getOp() == kIROp_UIntType)
+            atomicAdd = uintAtomicAdd;
+        else if (type->getOp() == kIROp_IntType)
+            atomicAdd = intAtomicAdd;
+        if (!atomicAdd)
+            continue;
+
+        builder.setInsertBefore(atomic);
+        IRInst* value = atomic->getOperand(1);
+        if (atomic->getOp() == kIROp_AtomicSub)
+            value = builder.emitNeg(type, value);
+        IRInst* args[] = {atomic->getOperand(0), value};
+        auto call = builder.emitCallInst(type, atomicAdd, 2, args);
+        atomic->replaceUsesWith(call);
+        atomic->removeAndDeallocate();
+        inlineCall(call);
+    }
+
+    for (auto func : {uintAtomicAdd, intAtomicAdd})
+    {
+        if (!func)
+            continue;
+        if (auto keepAlive = func->findDecoration<IRKeepAliveDecoration>())
+            keepAlive->removeAndDeallocate();
+    }
+}
 } // namespace Slang
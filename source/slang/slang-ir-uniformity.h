@@ -7,4 +7,8 @@ struct IRModule;
 class DiagnosticSink;
 
 void validateUniformity(IRModule* module, DiagnosticSink* sink);
+
+/// Replace the atomic adds and subtracts of 32-bit integers whose address is dynamically
+/// uniform with a wave reduction and a single atomic add from the first active lane.
+void aggregateUniformAtomics(IRModule* module, DiagnosticSink* sink);
 } // namespace Slang
@@ -1444,7 +1444,7 @@ void resetScratchDataBit(IRInst* inst, int bitIndex)
     {
         auto item = workList.getLast();
         workList.removeLast();
-        item->scratchData &= ~(1ULL << bitIndex);
+        item->scratchData &= ~(1U << bitIndex);
         for (auto child = item->getLastDecorationOrChild(); child; child = child->getPrevInst())
             workList.add(child);
     }
@@ -1603,13 +1603,13 @@ List<IRBlock*> collectBlocksInRegion(
     IRLoop* loopInst,
     bool* outHasMultiLevelBreaks)
 {
-    auto dom = computeDominatorTree(func);
+    RefPtr<IRDominatorTree> dom = func->getModule()->findOrCreateDominatorTree(func);
     return collectBlocksInRegion(dom, loopInst, outHasMultiLevelBreaks);
 }
 
 List<IRBlock*> collectBlocksInRegion(IRGlobalValueWithCode* func, IRLoop* loopInst)
 {
-    auto dom = computeDominatorTree(func);
+    RefPtr<IRDominatorTree> dom = func->getModule()->findOrCreateDominatorTree(func);
     bool hasMultiLevelBreaks = false;
     return collectBlocksInRegion(dom, loopInst, &hasMultiLevelBreaks);
 }
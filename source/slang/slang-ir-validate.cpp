@@ -23,6 +23,10 @@ struct IRValidateContext
     // A set of instructions we've seen, to help confirm that
     // values are defined before they are used in a given block.
     HashSet<IRInst*> seenInsts;
+
+    // If set, the fingerprints of the bodies that passed validation before, which are
+    // skipped if their fingerprint is unchanged, and updated for the bodies that pass now.
+    Dictionary<IRInst*, HashCode64>* validatedCodeFingerprints = nullptr;
 };
 
 void validateIRInst(IRValidateContext* context, IRInst* inst);
@@ -343,12 +347,63 @@ void validateCodeBody(IRValidateContext* context, IRGlobalValueWithCode* code)
     }
 }
 
+static void _hashInstTree(Hasher& hasher, IRInst* inst)
+{
+    hasher.hashValue(UInt32(inst->getOp()));
+    hasher.hashValue(inst->getFullType());
+
+    const UInt operandCount = inst->getOperandCount();
+    hasher.hashValue(operandCount);
+    for (UInt i = 0; i < operandCount; ++i)
+    {
+        // An operand that has been removed from the module (or moved) changes the
+        // fingerprint even if the instructions of the body stay the same.
+        auto operand = inst->getOperand(i);
+        hasher.hashValue(operand);
+        hasher.hashValue(operand ? operand->getParent() : (IRInst*)nullptr);
+    }
+
+    Count childCount = 0;
+    for (auto child : inst->getDecorationsAndChildren())
+    {
+        _hashInstTree(hasher, child);
+        childCount++;
+    }
+    hasher.hashValue(childCount);
+}
+
+// Compute a fingerprint of the body of `code`, which changes whenever the body does.
+static HashCode64 _computeCodeFingerprint(IRGlobalValueWithCode* code)
+{
+    Hasher hasher;
+    _hashInstTree(hasher, code);
+    return hasher.getResult();
+}
+
 void validateIRInst(IRValidateContext* context, IRInst* inst)
 {
     // Validate that any operands of the instruction are used appropriately
     validateIRInstOperands(context, inst);
     context->seenInsts.add(inst);
 
+    // When validating incrementally, a body that hasn't changed since it was last
+    // validated is skipped, and a body that passes is remembered.
+    HashCode64 fingerprint = 0;
+    Index errorCountBefore = 0;
+    auto code = as<IRGlobalValueWithCode>(inst);
+    const bool isIncremental = code && context->validatedCodeFingerprints &&
+                               as<IRModuleInst>(code->getParent());
+    if (isIncremental)
+    {
+        fingerprint = _computeCodeFingerprint(code);
+        if (auto validatedFingerprint = context->validatedCodeFingerprints->tryGetValue(code))
+        {
+            if (*validatedFingerprint == fingerprint)
+                return;
+        }
+        errorCountBefore = context->getSink()->getErrorCount();
+    }
+
     if (auto code = as<IRGlobalValueWithCode>(inst))
     {
         context->domTree = computeDominatorTree(code);
@@ -361,6 +416,14 @@ void validateIRInst(IRValidateContext* context, IRInst* inst)
 
     if (as<IRGlobalValueWithCode>(inst))
         context->domTree = nullptr;
+
+    if (isIncremental)
+    {
+        if (context->getSink()->getErrorCount() == errorCountBefore)
+            context->validatedCodeFingerprints->set(code, fingerprint);
+        else
+            context->validatedCodeFingerprints->remove(code);
+    }
 }
 
 void validateIRInst(IRInst* inst)
@@ -375,14 +438,9 @@ void validateIRInst(IRInst* inst)
     validateIRInst(context, inst);
 }
 
-void validateIRModule(IRModule* module, DiagnosticSink* sink)
+static void _validateIRModule(IRValidateContext* context)
 {
-    IRValidateContext contextStorage;
-    IRValidateContext* context = &contextStorage;
-    context->module = module;
-    context->sink = sink;
-
-    auto moduleInst = module->getModuleInst();
+    auto moduleInst = context->module->getModuleInst();
 
     validate(context, moduleInst != nullptr, moduleInst, "module instruction");
     validate(context, moduleInst->parent == nullptr, moduleInst, "module instruction parent");
@@ -392,13 +450,46 @@ void validateIRModule(IRModule* module, DiagnosticSink* sink)
     validateIRInst(context, moduleInst);
 }
 
+void validateIRModule(IRModule* module, DiagnosticSink* sink)
+{
+    IRValidateContext contextStorage;
+    IRValidateContext* context = &contextStorage;
+    context->module = module;
+    context->sink = sink;
+    _validateIRModule(context);
+}
+
+void validateIRModuleIncremental(IRModule* module, DiagnosticSink* sink)
+{
+    // Only the bodies of functions are skipped: the global instructions are few and cheap
+    // to check, so they are always validated.
+    IRValidateContext contextStorage;
+    IRValidateContext* context = &contextStorage;
+    context->module = module;
+    context->sink = sink;
+    context->validatedCodeFingerprints = &module->getValidatedCodeFingerprints();
+    _validateIRModule(context);
+}
+
+static void _validateIRModuleWithOptions(
+    CompilerOptionSet& optionSet,
+    IRModule* module,
+    DiagnosticSink* sink)
+{
+    if (optionSet.getBoolOption(CompilerOptionName::ValidateIrIncremental))
+        validateIRModuleIncremental(module, sink);
+    else
+        validateIRModule(module, sink);
+}
+
 void validateIRModuleIfEnabled(CompileRequestBase* compileRequest, IRModule* module)
 {
-    if (!compileRequest->getLinkage()->m_optionSet.getBoolOption(CompilerOptionName::ValidateIr))
+    auto& optionSet = compileRequest->getLinkage()->m_optionSet;
+    if (!optionSet.getBoolOption(CompilerOptionName::ValidateIr) &&
+        !optionSet.getBoolOption(CompilerOptionName::ValidateIrIncremental))
         return;
 
-    auto sink = compileRequest->getSink();
-    validateIRModule(module, sink);
+    _validateIRModuleWithOptions(optionSet, module, compileRequest->getSink());
 }
 
 void validateIRModuleIfEnabled(CodeGenContext* codeGenContext, IRModule* module)
@@ -406,8 +497,10 @@ void validateIRModuleIfEnabled(CodeGenContext* codeGenContext, IRModule* module)
     if (!codeGenContext->shouldValidateIR())
         return;
 
-    auto sink = codeGenContext->getSink();
-    validateIRModule(module, sink);
+    _validateIRModuleWithOptions(
+        codeGenContext->getTargetProgram()->getOptionSet(),
+        module,
+        codeGenContext->getSink());
 }
 
 } // namespace Slang
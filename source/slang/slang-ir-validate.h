@@ -29,8 +29,17 @@ struct IRInst;
 void validateIRModule(IRModule* module, DiagnosticSink* sink);
 void validateIRInst(IRInst* inst);
 
+// Validate `module` like `validateIRModule`, except that the body of a function (or other
+// value with code) is skipped if it hasn't changed since it last passed validation.
+//
+// Whether a body has changed is decided by a fingerprint of its instructions: their
+// opcodes, types, operands and nesting, and whether each operand is still in the module.
+// Computing it is much cheaper than validating the body, which needs a dominator tree.
+void validateIRModuleIncremental(IRModule* module, DiagnosticSink* sink);
+
 // A wrapper that calls `validateIRModule` only when IR validation is enabled
-// for the given compile request.
+// for the given compile request, or `validateIRModuleIncremental` when incremental
+// IR validation is.
 void validateIRModuleIfEnabled(CompileRequestBase* compileRequest, IRModule* module);
 
 void validateIRModuleIfEnabled(CodeGenContext* codeGenContext, IRModule* module);
@@ -0,0 +1,286 @@
+#include "slang-ir-vectorize.h"
+
+#include "slang-ir-insts.h"
+#include "slang-ir-util.h"
+#include "slang-ir.h"
+
+namespace Slang
+{
+
+static bool _isVectorizableOp(IROp op)
+{
+    switch (op)
+    {
+    case kIROp_Add:
+    case kIROp_Sub:
+    case kIROp_Mul:
+    case kIROp_Div:
+    case kIROp_Neg:
+    case kIROp_BitAnd:
+    case kIROp_BitOr:
+    case kIROp_BitXor:
+        return true;
+    default:
+        return false;
+    }
+}
+
+// If `inst` is a single element of a vector, get the vector and the index of the element.
+static bool _getVectorElement(IRInst* inst, IRInst*& outVector, IRIntegerValue& outIndex)
+{
+    IRInst* vector = nullptr;
+    IRInst* index = nullptr;
+    if (inst->getOp() == kIROp_GetElement)
+    {
+        vector = inst->getOperand(0);
+        index = inst->getOperand(1);
+    }
+    else if (auto swizzle = as<IRSwizzle>(inst))
+    {
+        if (swizzle->getElementCount() != 1)
+            return false;
+        vector = swizzle->getBase();
+        index = swizzle->getElementIndex(0);
+    }
+    if (!vector || !as<IRVectorType>(vector->getDataType()) || !as<IRIntLit>(index))
+        return false;
+    outVector = vector;
+    outIndex = getIntVal(index);
+    return true;
+}
+
+struct VectorizeContext
+{
+    IRModule* module;
+
+    // The ways a list of scalar lanes can become a single vector value.
+    enum class LaneKind
+    {
+        Elements,  // Elements of one vector
+        Constants, // All constants
+        Splat,     // The same value in every lane
+        Operation, // The same vectorizable operation in every lane
+    };
+
+    bool classifyLanes(List<IRInst*> const& lanes, LaneKind& outKind)
+    {
+        auto first = lanes[0];
+
+        IRInst* vector = nullptr;
+        IRIntegerValue index = 0;
+        if (_getVectorElement(first, vector, index))
+        {
+            bool sameVector = true;
+            for (auto lane : lanes)
+            {
+                IRInst* laneVector = nullptr;
+                if (!_getVectorElement(lane, laneVector, index) || laneVector != vector)
+                {
+                    sameVector = false;
+                    break;
+                }
+            }
+            if (sameVector)
+            {
+                outKind = LaneKind::Elements;
+                return true;
+            }
+        }
+
+        bool allConstants = true;
+        bool allSame = true;
+        for (auto lane : lanes)
+        {
+            allConstants = allConstants && as<IRConstant>(lane);
+            allSame = allSame && lane == first;
+        }
+        if (allConstants)
+        {
+            outKind = LaneKind::Constants;
+            return true;
+        }
+        if (allSame)
+        {
+            outKind = LaneKind::Splat;
+            return true;
+        }
+
+        if (!_isVectorizableOp(first->getOp()))
+            return false;
+        for (auto lane : lanes)
+        {
+            if (lane->getOp() != first->getOp() || lane->getDataType() != first->getDataType() ||
+                lane->getOperandCount() != first->getOperandCount())
+                return false;
+
+            // A lane that is used elsewhere would still have to be computed as a scalar.
+            if (!lane->firstUse || lane->firstUse->nextUse)
+                return false;
+        }
+        outKind = LaneKind::Operation;
+        return true;
+    }
+
+    List<IRInst*> getOperandLanes(List<IRInst*> const& lanes, UInt operandIndex)
+    {
+        List<IRInst*> operandLanes;
+        for (auto lane : lanes)
+            operandLanes.add(lane->getOperand(operandIndex));
+        return operandLanes;
+    }
+
+    bool canVectorize(List<IRInst*> const& lanes)
+    {
+        LaneKind kind;
+        if (!classifyLanes(lanes, kind))
+            return false;
+        if (kind != LaneKind::Operation)
+            return true;
+        for (UInt i = 0; i < lanes[0]->getOperandCount(); i++)
+        {
+            if (!canVectorize(getOperandLanes(lanes, i)))
+                return false;
+        }
+        return true;
+    }
+
+    IRInst* emitVectorized(IRBuilder& builder, List<IRInst*> const& lanes)
+    {
+        auto vectorType = builder.getVectorType(lanes[0]->getDataType(), lanes.getCount());
+
+        LaneKind kind;
+        classifyLanes(lanes, kind);
+        switch (kind)
+        {
+        case LaneKind::Elements:
+            {
+                IRInst* vector = nullptr;
+                IRIntegerValue index = 0;
+                List<IRIntegerValue> indices;
+                for (auto lane : lanes)
+                {
+                    _getVectorElement(lane, vector, index);
+                    indices.add(index);
+                }
+
+                bool isIdentity = vector->getDataType() == vectorType;
+                for (Index i = 0; i < indices.getCount(); i++)
+                    isIdentity = isIdentity && indices[i] == i;
+                if (isIdentity)
+                    return vector;
+
+                List<IRInst*> indexInsts;
+                for (auto i : indices)
+                    indexInsts.add(builder.getIntValue(builder.getIntType(), i));
+                return builder.emitSwizzle(
+                    vectorType,
+                    vector,
+                    indexInsts.getCount(),
+                    indexInsts.getBuffer());
+            }
+        case LaneKind::Constants:
+            return builder.emitMakeVector(vectorType, lanes);
+        case LaneKind::Splat:
+            return builder.emitMakeVectorFromScalar(vectorType, lanes[0]);
+        case LaneKind::Operation:
+        default:
+            {
+                List<IRInst*> operands;
+                for (UInt i = 0; i < lanes[0]->getOperandCount(); i++)
+                    operands.add(emitVectorized(builder, getOperandLanes(lanes, i)));
+                return builder.emitIntrinsicInst(
+                    vectorType,
+                    lanes[0]->getOp(),
+                    operands.getCount(),
+                    operands.getBuffer());
+            }
+        }
+    }
+
+    // Remove the scalar operations of a tree that was replaced, which are now unused.
+    void removeDeadLanes(List<IRInst*> const& lanes)
+    {
+        for (auto lane : lanes)
+        {
+            if (lane->hasUses() || !_isVectorizableOp(lane->getOp()))
+                continue;
+            List<IRInst*> operands;
+            for (UInt i = 0; i < lane->getOperandCount(); i++)
+            {
+                if (!operands.contains(lane->getOperand(i)))
+                    operands.add(lane->getOperand(i));
+            }
+            lane->removeAndDeallocate();
+            removeDeadLanes(operands);
+        }
+    }
+
+    bool tryVectorize(IRInst* makeVector)
+    {
+        auto vectorType = as<IRVectorType>(makeVector->getDataType());
+        if (!vectorType)
+            return false;
+        auto elementCount = as<IRIntLit>(vectorType->getElementCount());
+        if (!elementCount ||
+            getIntVal(elementCount) != (IRIntegerValue)makeVector->getOperandCount())
+            return false;
+
+        List<IRInst*> lanes;
+        for (UInt i = 0; i < makeVector->getOperandCount(); i++)
+        {
+            auto lane = makeVector->getOperand(i);
+            if (lane->getDataType() != vectorType->getElementType())
+                return false;
+            lanes.add(lane);
+        }
+
+        // Only a tree with operations in it is worth rewriting.
+        LaneKind kind;
+        if (!classifyLanes(lanes, kind) || kind != LaneKind::Operation)
+            return false;
+        if (!canVectorize(lanes))
+            return false;
+
+        IRBuilder builder(module);
+        builder.setInsertBefore(makeVector);
+        auto vectorized = emitVectorized(builder, lanes);
+        makeVector->replaceUsesWith(vectorized);
+        makeVector->removeAndDeallocate();
+        removeDeadLanes(lanes);
+        return true;
+    }
+
+    bool processFunc(IRGlobalValueWithCode* func)
+    {
+        List<IRInst*> makeVectors;
+        for (auto block : func->getBlocks())
+        {
+            for (auto inst : block->getChildren())
+            {
+                if (inst->getOp() == kIROp_MakeVector)
+                    makeVectors.add(inst);
+            }
+        }
+
+        bool changed = false;
+        for (auto makeVector : makeVectors)
+            changed |= tryVectorize(makeVector);
+        return changed;
+    }
+};
+
+bool vectorizeScalarOps(IRModule* module)
+{
+    VectorizeContext context;
+    context.module = module;
+
+    bool changed = false;
+    for (auto globalInst : module->getGlobalInsts())
+    {
+        if (auto func = as<IRFunc>(globalInst))
+            changed |= context.processFunc(func);
+    }
+    return changed;
+}
+
+} // namespace Slang
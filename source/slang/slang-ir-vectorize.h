@@ -0,0 +1,25 @@
+// slang-ir-vectorize.h
+#pragma once
+
+namespace Slang
+{
+struct IRModule;
+
+/// Recombine isomorphic scalar operations on the elements of vectors into vector operations.
+///
+/// The pass starts from each `MakeVector` whose elements are all results of the same scalar
+/// operation, such as:
+///
+///     x = Add(GetElement(a, 0), GetElement(b, 0))
+///     y = Add(GetElement(a, 1), GetElement(b, 1))
+///     v = MakeVector(x, y)
+///
+/// and rewrites it into `v = Add(a, b)`, following the operands down through further levels
+/// of the same kind of operation. The operands of the lanes at the bottom must be elements of
+/// a single vector, the same scalar value, or constants, so no vector has to be assembled
+/// element by element. Lane operations with other uses are left alone.
+///
+/// Returns true if anything was rewritten.
+bool vectorizeScalarOps(IRModule* module);
+
+} // namespace Slang
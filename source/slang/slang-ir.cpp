@@ -176,6 +176,36 @@ void IRUse::debugValidate()
 #endif
 }
 
+// Discard the cached analyses of `code` (if it is a function or other
+// code-bearing value), because its control-flow graph has changed.
+static void _invalidateCFGAnalysis(IRInst* code)
+{
+    auto func = as<IRGlobalValueWithCode>(code);
+    if (!func)
+        return;
+    if (auto module = func->getModule())
+        module->invalidateAnalysisForInst(func);
+}
+
+// Discard the cached analyses of the function containing `inst`, if `inst`
+// is a block or terminator whose placement determines the control-flow graph.
+static void _invalidateCFGAnalysisForChild(IRInst* inst, IRInst* parent)
+{
+    if (as<IRBlock>(inst))
+        _invalidateCFGAnalysis(parent);
+    else if (as<IRTerminatorInst>(inst))
+        _invalidateCFGAnalysis(parent->getParent());
+}
+
+// The control-flow graph of a function is determined by the uses of its blocks
+// (as the targets of terminators), so changing such a use discards the cached
+// analyses of the function containing the user.
+static void _invalidateCFGAnalysisForUse(IRInst* user, IRInst* usedValue)
+{
+    if (user && as<IRBlock>(usedValue) && user->getParent())
+        _invalidateCFGAnalysis(usedValue->getParent());
+}
+
 void IRUse::init(IRInst* u, IRInst* v)
 {
     clear();
@@ -183,6 +213,8 @@ void IRUse::init(IRInst* u, IRInst* v)
     usedValue = v;
     if (v)
     {
+        _invalidateCFGAnalysisForUse(u, v);
+
         nextUse = v->firstUse;
         prevLink = &v->firstUse;
 
@@ -219,6 +251,8 @@ void IRUse::clear()
 #ifdef SLANG_ENABLE_FULL_IR_VALIDATION
         auto uv = usedValue;
 #endif
+        _invalidateCFGAnalysisForUse(user, usedValue);
+
         *prevLink = nextUse;
         if (nextUse)
         {
@@ -1518,6 +1552,236 @@ IRInst* IRModule::_allocateInst(IROp op, Int operandCount, size_t minSizeInBytes
     return inst;
 }
 
+/// Get the number of bytes needed to hold a copy of `inst`.
+///
+/// This must match the sizes used when instructions are allocated with `_allocateInst`.
+static size_t _calcInstAllocationSize(IRInst* inst)
+{
+    const size_t defaultSize = sizeof(IRInst) + inst->operandCount * sizeof(IRUse);
+
+    // The minimum size of a constant, not including the payload of its value
+    const size_t prefixSize = SLANG_OFFSET_OF(IRConstant, value);
+
+    size_t minSizeInBytes = 0;
+    switch (inst->getOp())
+    {
+    case kIROp_Module:
+        minSizeInBytes = sizeof(IRModuleInst);
+        break;
+    case kIROp_BoolLit:
+    case kIROp_IntLit:
+        minSizeInBytes = prefixSize + sizeof(IRIntegerValue);
+        break;
+    case kIROp_FloatLit:
+        minSizeInBytes = prefixSize + sizeof(IRFloatingPointValue);
+        break;
+    case kIROp_PtrLit:
+        minSizeInBytes = prefixSize + sizeof(void*);
+        break;
+    case kIROp_VoidLit:
+        minSizeInBytes = prefixSize;
+        break;
+    case kIROp_BlobLit:
+    case kIROp_StringLit:
+        minSizeInBytes = prefixSize + SLANG_OFFSET_OF(IRConstant::StringValue, chars) +
+                         static_cast<IRConstant*>(inst)->value.stringVal.numChars;
+        break;
+    default:
+        break;
+    }
+    return minSizeInBytes > defaultSize ? minSizeInBytes : defaultSize;
+}
+
+bool IRModule::compactMemory(List<IRInst*>& ioExternalInsts)
+{
+    // We start by collecting all of the live instructions, in the order
+    // we want them laid out in the new arena.
+    //
+    // The live instructions are those in the tree under the module instruction,
+    // along with any trees that have been detached from the module but are
+    // still referenced by a live instruction (or from outside the module).
+    //
+    Dictionary<IRInst*, IRInst*> mapOldToNew;
+    List<IRInst*> liveInsts;
+    size_t liveSizeInBytes = 0;
+
+    List<IRInst*> stack;
+    auto addTree = [&](IRInst* root)
+    {
+        if (!root)
+            return;
+
+        // Always copy a whole tree, so that the parent of every copied
+        // instruction is also copied.
+        while (root->getParent() && !mapOldToNew.containsKey(root->getParent()))
+            root = root->getParent();
+
+        // Don't take ownership of instructions that belong to another module.
+        if (root->getOp() == kIROp_Module && root != m_moduleInst)
+            return;
+
+        if (mapOldToNew.containsKey(root))
+            return;
+
+        stack.add(root);
+        while (stack.getCount())
+        {
+            IRInst* inst = stack.getLast();
+            stack.removeLast();
+
+            mapOldToNew.add(inst, nullptr);
+            liveInsts.add(inst);
+            liveSizeInBytes += _calcInstAllocationSize(inst);
+
+            // Push the children in reverse, so that they are visited in order.
+            for (auto child = inst->getLastDecorationOrChild(); child; child = child->getPrevInst())
+                stack.add(child);
+        }
+    };
+
+    addTree(m_moduleInst);
+    for (auto inst : ioExternalInsts)
+        addTree(inst);
+    for (Index i = 0; i < liveInsts.getCount(); ++i)
+    {
+        IRInst* inst = liveInsts[i];
+        addTree(inst->getFullType());
+        for (UInt j = 0; j < inst->getOperandCount(); ++j)
+            addTree(inst->getOperand(j));
+    }
+
+    // If most of the arena is still in use there isn't enough to gain from copying.
+    if (liveSizeInBytes * 2 > m_memoryArena.calcTotalMemoryUsed())
+        return false;
+
+    MemoryArena newArena(kMemoryArenaBlockSize);
+    for (auto oldInst : liveInsts)
+    {
+        const size_t sizeInBytes = _calcInstAllocationSize(oldInst);
+        void* newInst = newArena.allocate(sizeInBytes);
+        memcpy(newInst, oldInst, sizeInBytes);
+        mapOldToNew[oldInst] = (IRInst*)newInst;
+    }
+
+    auto remap = [&](IRInst* inst) -> IRInst*
+    {
+        if (!inst)
+            return nullptr;
+        if (auto newInst = mapOldToNew.tryGetValue(inst))
+            return *newInst;
+        return inst;
+    };
+
+    // Uses of values that aren't owned by this module, which need to be
+    // moved over to the use lists of those values.
+    List<KeyValuePair<IRUse*, IRUse*>> externalUses;
+
+    for (auto oldInst : liveInsts)
+    {
+        IRInst* newInst = mapOldToNew[oldInst];
+        newInst->parent = remap(oldInst->parent);
+        newInst->next = remap(oldInst->next);
+        newInst->prev = remap(oldInst->prev);
+        newInst->m_decorationsAndChildren.first = remap(oldInst->m_decorationsAndChildren.first);
+        newInst->m_decorationsAndChildren.last = remap(oldInst->m_decorationsAndChildren.last);
+
+        // The use lists are rebuilt below.
+        newInst->firstUse = nullptr;
+
+        auto fixUse = [&](IRUse* oldUse, IRUse* newUse)
+        {
+            newUse->user = newInst;
+            newUse->usedValue = remap(oldUse->usedValue);
+            newUse->nextUse = nullptr;
+            newUse->prevLink = nullptr;
+            if (newUse->usedValue && newUse->usedValue == oldUse->usedValue)
+            {
+                newUse->usedValue = nullptr;
+                externalUses.add(KVPair(oldUse, newUse));
+            }
+        };
+        fixUse(&oldInst->typeUse, &newInst->typeUse);
+        for (UInt i = 0; i < oldInst->getOperandCount(); ++i)
+            fixUse(oldInst->getOperands() + i, newInst->getOperands() + i);
+    }
+
+    // Rebuild the use list of each copied value, keeping the uses in the same
+    // order. Uses by instructions that weren't copied are dropped.
+    for (auto oldInst : liveInsts)
+    {
+        IRInst* newInst = mapOldToNew[oldInst];
+        IRUse** link = &newInst->firstUse;
+        for (IRUse* oldUse = oldInst->firstUse; oldUse; oldUse = oldUse->nextUse)
+        {
+            IRInst* oldUser = oldUse->getUser();
+            IRInst* const* newUser = mapOldToNew.tryGetValue(oldUser);
+            if (!newUser)
+                continue;
+
+            IRUse* newUse = (IRUse*)((char*)*newUser + ((char*)oldUse - (char*)oldUser));
+            *link = newUse;
+            newUse->prevLink = link;
+            link = &newUse->nextUse;
+        }
+    }
+    for (const auto& pair : externalUses)
+    {
+        IRInst* usedValue = pair.key->get();
+        pair.key->clear();
+        pair.value->init(pair.value->getUser(), usedValue);
+    }
+
+    m_moduleInst = static_cast<IRModuleInst*>(remap(m_moduleInst));
+    for (auto& inst : ioExternalInsts)
+        inst = remap(inst);
+
+    // The deduplication maps are keyed on the (old) instructions and their operands,
+    // so they need to be rebuilt over the new ones.
+    {
+        IRDeduplicationContext::GlobalValueNumberingMap globalValueNumberingMap;
+        m_deduplicationContext.getGlobalValueNumberingMap().swapWith(globalValueNumberingMap);
+        for (const auto& [_, value] : globalValueNumberingMap)
+        {
+            if (auto newValue = mapOldToNew.tryGetValue(value))
+                m_deduplicationContext.getGlobalValueNumberingMap().add(
+                    IRInstKey{*newValue},
+                    *newValue);
+        }
+
+        IRDeduplicationContext::ConstantMap constantMap;
+        m_deduplicationContext.getConstantMap().swapWith(constantMap);
+        for (const auto& [_, value] : constantMap)
+        {
+            if (auto newValue = mapOldToNew.tryGetValue(value))
+            {
+                auto newConstant = static_cast<IRConstant*>(*newValue);
+                m_deduplicationContext.getConstantMap().add(
+                    IRConstantKey{newConstant},
+                    newConstant);
+            }
+        }
+
+        Dictionary<IRInst*, IRInst*> instReplacementMap;
+        m_deduplicationContext.getInstReplacementMap().swapWith(instReplacementMap);
+        for (const auto& [inst, replacement] : instReplacementMap)
+        {
+            auto newInst = mapOldToNew.tryGetValue(inst);
+            auto newReplacement = mapOldToNew.tryGetValue(replacement);
+            if (newInst && newReplacement)
+                m_deduplicationContext.getInstReplacementMap().add(*newInst, *newReplacement);
+        }
+    }
+
+    invalidateAllAnalysis();
+    m_validatedCodeFingerprints.clear();
+
+    // Swap in the new arena. The old one (and all of the garbage in it)
+    // is freed when `newArena` goes out of scope.
+    m_memoryArena.swapWith(newArena);
+
+    return true;
+}
+
 /// Return whichever of `left` or `right` represents the later point in a common parent
 static IRInst* pickLaterInstInSameParent(IRInst* left, IRInst* right)
 {
@@ -2539,9 +2803,7 @@ IRInst* IRBuilder::_findOrEmitHoistableInst(
         IRUse* operand = inst->getOperands();
         for (Int ii = 0; ii < fixedArgCount; ++ii)
         {
-            auto arg = canonicalizedOperands[ii];
-            m_dedupContext->getInstReplacementMap().tryGetValue(arg, arg);
-            operand->usedValue = arg;
+            operand->usedValue = m_dedupContext->getReplacementInst(canonicalizedOperands[ii]);
             operand++;
         }
         for (Int ii = 0; ii < varArgListCount; ++ii)
@@ -2549,9 +2811,7 @@ IRInst* IRBuilder::_findOrEmitHoistableInst(
             UInt listOperandCount = listArgCounts[ii];
             for (UInt jj = 0; jj < listOperandCount; ++jj)
             {
-                auto arg = listArgs[ii][jj];
-                m_dedupContext->getInstReplacementMap().tryGetValue(arg, arg);
-                operand->usedValue = arg;
+                operand->usedValue = m_dedupContext->getReplacementInst(listArgs[ii][jj]);
                 operand++;
             }
         }
@@ -2562,6 +2822,7 @@ IRInst* IRBuilder::_findOrEmitHoistableInst(
         IRInstKey key = {inst};
 
         IRInst** found = m_dedupContext->getGlobalValueNumberingMap().tryGetValueOrAdd(key, inst);
+        m_dedupContext->recordHoistableInstLookup(found != nullptr);
         SLANG_ASSERT(endCursor == memoryArena.getCursor());
         // If it's found, just return, and throw away the instruction
         if (found)
@@ -4451,9 +4712,32 @@ IRInst* IRBuilder::addIntermediateContextFieldDifferentialTypeDecoration(
     return addDecoration(target, kIROp_IntermediateContextFieldDifferentialTypeDecoration, witness);
 }
 
+/// The blocks of the last scratch module released on this thread, which are reused by the
+/// next scratch module created on it.
+static MemoryArena& _getThreadScratchArena()
+{
+    thread_local MemoryArena arena(IRModule::kMemoryArenaBlockSize);
+    return arena;
+}
+
 RefPtr<IRModule> IRModule::create(Session* session)
+{
+    return _create(session, false);
+}
+
+RefPtr<IRModule> IRModule::createScratch(Session* session)
+{
+    return _create(session, true);
+}
+
+RefPtr<IRModule> IRModule::_create(Session* session, bool isScratch)
 {
     RefPtr<IRModule> module = new IRModule(session);
+    if (isScratch)
+    {
+        module->m_isScratch = true;
+        module->m_memoryArena.swapWith(_getThreadScratchArena());
+    }
 
     auto moduleInst = module->_allocateInst<IRModuleInst>(kIROp_Module, 0);
 
@@ -4463,6 +4747,22 @@ RefPtr<IRModule> IRModule::create(Session* session)
     return module;
 }
 
+IRModule::~IRModule()
+{
+    if (!m_isScratch)
+        return;
+
+    // The instructions are never destructed, so the memory can be handed back as soon as the
+    // module goes away. Keep whichever arena has more blocks, unless it is too large to pin.
+    auto& threadArena = _getThreadScratchArena();
+    const size_t size = m_memoryArena.calcTotalMemoryAllocated();
+    if (size > threadArena.calcTotalMemoryAllocated() && size <= kMaxRetainedScratchMemory)
+    {
+        m_memoryArena.deallocateAll();
+        m_memoryArena.swapWith(threadArena);
+    }
+}
+
 IRDominatorTree* IRModule::findOrCreateDominatorTree(IRGlobalValueWithCode* func)
 {
     IRAnalysis* analysis = m_mapInstToAnalysis.tryGetValue(func);
@@ -7713,6 +8013,10 @@ static void _replaceInstUsesWith(IRInst* thisInst, IRInst* other)
 
     addToWorkList(thisInst, other);
 
+    // Replacing a block changes the targets of the terminators that branch to it.
+    if (as<IRBlock>(thisInst))
+        _invalidateCFGAnalysis(thisInst->getParent());
+
     for (Index i = 0; i < workList.getCount(); i++)
     {
         auto workItem = workList[i];
@@ -7745,6 +8049,14 @@ static void _replaceInstUsesWith(IRInst* thisInst, IRInst* other)
 
         // ff->debugValidate();
 
+        // Whether `other` may need to be hoisted ahead of a user depends only
+        // on `other` itself, so decide it once rather than for every use of a
+        // value that may have many users.
+        //
+        auto otherParent = other->getParent();
+        bool otherMayNeedHoisting = getIROpInfo(other->getOp()).isHoistable() &&
+                                    !(otherParent && otherParent->getOp() == kIROp_Module);
+
         IRUse* uu = ff;
         for (;;)
         {
@@ -7769,7 +8081,8 @@ static void _replaceInstUsesWith(IRInst* thisInst, IRInst* other)
 
             // If `other` is hoistable, then we need to make sure `other` is hoisted
             // to a point before `user`, if it is not already so.
-            _maybeHoistOperand(uu);
+            if (otherMayNeedHoisting)
+                _maybeHoistOperand(uu);
 
             if (userIsHoistable)
             {
@@ -7893,6 +8206,8 @@ void IRInst::_insertAt(IRInst* inPrev, IRInst* inNext, IRInst* inParent)
     this->next = inNext;
     this->parent = inParent;
 
+    _invalidateCFGAnalysisForChild(this, inParent);
+
 #if _DEBUG
     validateIRInstOperands(this);
 #endif
@@ -7953,6 +8268,8 @@ void IRInst::removeFromParent()
     if (!oldParent)
         return;
 
+    _invalidateCFGAnalysisForChild(this, oldParent);
+
     auto pp = getPrevInst();
     auto nn = getNextInst();
 
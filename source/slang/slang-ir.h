@@ -584,6 +584,17 @@ struct IRInst
     // Source location information for this value, if any
     SourceLoc sourceLoc;
 
+    // Reserved memory space for use by individual IR passes.
+    // This field is not supposed to be valid outside an IR pass,
+    // and each IR pass should always treat it as uninitialized
+    // upon entry.
+    //
+    // Note: This field is 32 bits and declared here so that it fills
+    // the space left before the pointer-aligned fields below, rather
+    // than adding another 8 bytes to every instruction.
+    //
+    uint32_t scratchData = 0;
+
     // Each instruction can have zero or more "decorations"
     // attached to it. A decoration is a specialized kind
     // of instruction that either attaches metadata to,
@@ -697,12 +708,6 @@ struct IRInst
     uint32_t _debugUID;
 #endif
 
-    // Reserved memory space for use by individual IR passes.
-    // This field is not supposed to be valid outside an IR pass,
-    // and each IR pass should always treat it as uninitialized
-    // upon entry.
-    UInt64 scratchData = 0;
-
     // The type of the result value of this instruction,
     // or `null` to indicate that the instruction has
     // no value.
@@ -2300,16 +2305,42 @@ public:
     }
     void _removeGlobalNumberingEntry(IRInst* inst)
     {
+        // Hashing a key means hashing all of the inst's operands, so only do it once.
+        const IRInstKey key{inst};
         IRInst* value = nullptr;
-        if (m_globalValueNumberingMap.tryGetValue(IRInstKey{inst}, value))
+        if (m_globalValueNumberingMap.tryGetValue(key, value))
         {
             if (value == inst)
             {
-                m_globalValueNumberingMap.remove(IRInstKey{inst});
+                m_globalValueNumberingMap.remove(key);
             }
         }
     }
 
+    /// Look up the inst that should be used in place of `inst` as an operand of a new
+    /// hoistable inst, which is `inst` itself unless it has been replaced.
+    IRInst* getReplacementInst(IRInst* inst)
+    {
+        if (m_instReplacementMap.getCount())
+            m_instReplacementMap.tryGetValue(inst, inst);
+        return inst;
+    }
+
+    /// Record whether looking up a hoistable inst found an existing equivalent one.
+    void recordHoistableInstLookup(bool found)
+    {
+        if (found)
+            m_hoistableInstHitCount++;
+        else
+            m_hoistableInstMissCount++;
+    }
+
+    /// Get the number of requests for a hoistable inst that were satisfied by an existing inst.
+    Count getHoistableInstHitCount() const { return m_hoistableInstHitCount; }
+
+    /// Get the number of requests for a hoistable inst that had to create a new inst.
+    Count getHoistableInstMissCount() const { return m_hoistableInstMissCount; }
+
     ConstantMap& getConstantMap() { return m_constantMap; }
 
 private:
@@ -2326,6 +2357,9 @@ private:
     Dictionary<IRInst*, IRInst*> m_instReplacementMap;
 
     ConstantMap m_constantMap;
+
+    Count m_hoistableInstHitCount = 0;
+    Count m_hoistableInstMissCount = 0;
 };
 
 struct IRDominatorTree;
@@ -2344,8 +2378,21 @@ public:
         kMemoryArenaBlockSize = 16 * 1024, ///< Use 16k block size for memory arena
     };
 
+    /// The most memory a thread keeps for reuse by scratch modules (see `createScratch`).
+    static const size_t kMaxRetainedScratchMemory = 64 * 1024 * 1024;
+
     static RefPtr<IRModule> create(Session* session);
 
+    /// Create a module for temporary IR, such as the IR linked to generate code for a program.
+    ///
+    /// The module starts with the memory blocks left by the last scratch module released on
+    /// the current thread, and leaves its own blocks for the next one when it is destroyed.
+    /// Compiles that run one after another on a thread thus reuse the same memory rather
+    /// than allocating and freeing it for every request.
+    static RefPtr<IRModule> createScratch(Session* session);
+
+    ~IRModule();
+
     SLANG_FORCE_INLINE Session* getSession() const { return m_session; }
     SLANG_FORCE_INLINE IRModuleInst* getModuleInst() const { return m_moduleInst; }
     SLANG_FORCE_INLINE MemoryArena& getMemoryArena() { return m_memoryArena; }
@@ -2368,6 +2415,14 @@ public:
             return analysis->getDominatorTree();
         return nullptr;
     }
+
+    /// Get the dominator tree for `func`, computing it if it isn't cached.
+    ///
+    /// The cached analyses of a function are discarded automatically whenever its
+    /// control-flow graph changes: when a block or terminator is inserted or removed,
+    /// or a use of a block is changed. A caller that changes the CFG while still using
+    /// the tree should hold it with a `RefPtr`.
+    ///
     IRDominatorTree* findOrCreateDominatorTree(IRGlobalValueWithCode* func);
     void invalidateAnalysisForInst(IRGlobalValueWithCode* func)
     {
@@ -2406,7 +2461,48 @@ public:
         return (T*)_allocateInst(op, operandCount, sizeof(T));
     }
 
-    ContainerPool& getContainerPool() { return m_containerPool; }
+    /// Rebuild the instructions of this module into a fresh memory arena.
+    ///
+    /// Removing an instruction never returns its memory to the arena, so after
+    /// passes like specialization, inlining and DCE most of the arena may be garbage.
+    /// This copies every live instruction into a new arena, in tree order, and
+    /// frees the old one. Nothing is done unless at least half of the arena would
+    /// be reclaimed.
+    ///
+    /// If the module is rebuilt, every `IRInst` pointer into it held elsewhere is
+    /// invalidated, and all cached analyses are discarded. Instructions referenced
+    /// from outside the module should be passed in `ioExternalInsts`: they are
+    /// kept alive and the list is updated to refer to their new locations.
+    ///
+    /// Returns true if the module was rebuilt.
+    ///
+    bool compactMemory(List<IRInst*>& ioExternalInsts);
+
+    /// Get the pool of reusable containers for passes over this module. The pool belongs to
+    /// the current thread, so containers keep their capacity across functions and modules.
+    ContainerPool& getContainerPool() { return ContainerPool::getThreadLocal(); }
+
+    /// Counts of the work done by type legalization over this module, summed over every
+    /// legalization pass, so that the statistics of a single pass can be found by difference.
+    struct TypeLegalizationCounts
+    {
+        /// Number of types that were legalized, and of requests answered from the cache.
+        Count legalizedTypes = 0;
+        Count cacheHits = 0;
+        /// Number of legalized types that were split into several values (tuples, pairs,
+        /// wrapped buffers and so on) rather than mapped to a single type.
+        Count expandedTypes = 0;
+    };
+
+    TypeLegalizationCounts& getTypeLegalizationCounts() { return m_typeLegalizationCounts; }
+
+    /// Get the fingerprints of the functions (and other values with code) that passed IR
+    /// validation, as of when they were validated. Used to skip validating the functions
+    /// that haven't changed since (see `validateIRModuleIncremental`).
+    Dictionary<IRInst*, HashCode64>& getValidatedCodeFingerprints()
+    {
+        return m_validatedCodeFingerprints;
+    }
 
 private:
     IRModule() = delete;
@@ -2417,9 +2513,14 @@ private:
     {
     }
 
+    static RefPtr<IRModule> _create(Session* session, bool isScratch);
+
     // The compilation session in use.
     Session* m_session = nullptr;
 
+    /// True if the memory of the module is returned to the thread for reuse.
+    bool m_isScratch = false;
+
     /// The root IR instruction for the module.
     ///
     /// All other IR instructions that make up the state/contents of the module are
@@ -2433,10 +2534,6 @@ private:
     /// are allocated.
     MemoryArena m_memoryArena;
 
-    /// A pool to allow reuse of common types of containers to reduce memory allocations
-    /// and rehashing.
-    ContainerPool m_containerPool;
-
     /// Shared contexts for constructing and deduplicating the IR.
     mutable IRDeduplicationContext m_deduplicationContext;
 
@@ -2444,6 +2541,10 @@ private:
     ComPtr<IBoxValue<SourceMap>> m_obfuscatedSourceMap;
 
     Dictionary<IRInst*, IRAnalysis> m_mapInstToAnalysis;
+
+    TypeLegalizationCounts m_typeLegalizationCounts;
+
+    Dictionary<IRInst*, HashCode64> m_validatedCodeFingerprints;
 };
 
 
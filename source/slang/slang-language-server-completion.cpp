@@ -138,6 +138,59 @@ bool isDeclKeyword(const UnownedStringSlice& slice)
     return false;
 }
 
+// The most member and symbol completion items sent for one request. Global scope completions
+// see every declaration of the core module, so without a limit the response can be megabytes.
+static const Index kMaxCompletionItemCount = 500;
+
+// Check if the characters of `prefix` appear in `label` in order, ignoring case. This is no
+// stricter than the fuzzy matching editors apply to the items, so no item they would show is
+// filtered out.
+static bool _matchesTypedPrefix(UnownedStringSlice label, UnownedStringSlice prefix)
+{
+    Index matched = 0;
+    for (Index i = 0; i < label.getLength() && matched < prefix.getLength(); i++)
+    {
+        if (CharUtil::toLower(label[i]) == CharUtil::toLower(prefix[matched]))
+            matched++;
+    }
+    return matched == prefix.getLength();
+}
+
+// Rank how well `label` matches `prefix`, lower is better.
+static int _getTypedPrefixRank(UnownedStringSlice label, UnownedStringSlice prefix)
+{
+    if (label.startsWith(prefix))
+        return 0;
+    if (label.startsWithCaseInsensitive(prefix))
+        return 1;
+    return 2;
+}
+
+// Keep only the best `kMaxCompletionItemCount` items. Returns true if any were dropped.
+static bool _limitCompletionItems(
+    List<LanguageServerProtocol::CompletionItem>& items,
+    UnownedStringSlice prefix)
+{
+    if (items.getCount() <= kMaxCompletionItemCount)
+        return false;
+    items.sort(
+        [&](const LanguageServerProtocol::CompletionItem& a,
+            const LanguageServerProtocol::CompletionItem& b)
+        {
+            auto labelA = a.label.getUnownedSlice();
+            auto labelB = b.label.getUnownedSlice();
+            auto rankA = _getTypedPrefixRank(labelA, prefix);
+            auto rankB = _getTypedPrefixRank(labelB, prefix);
+            if (rankA != rankB)
+                return rankA < rankB;
+            if (labelA.getLength() != labelB.getLength())
+                return labelA.getLength() < labelB.getLength();
+            return a.label < b.label;
+        });
+    items.setCount(kMaxCompletionItemCount);
+    return true;
+}
+
 LanguageServerResult<CompletionResult> CompletionContext::tryCompleteHLSLSemantic()
 {
     if (version->linkage->contentAssistInfo.completionSuggestions.scopeKind !=
@@ -577,6 +630,8 @@ CompletionResult CompletionContext::collectMembersAndSymbols()
             continue;
         if (item.label.startsWith("$"))
             continue;
+        if (!_matchesTypedPrefix(item.label.getUnownedSlice(), typedPrefix.getUnownedSlice()))
+            continue;
         if (!deduplicateSet.add(item.label))
             continue;
 
@@ -630,6 +685,10 @@ CompletionResult CompletionContext::collectMembersAndSymbols()
         {
             for (auto keyword : kDeclKeywords)
             {
+                if (!_matchesTypedPrefix(
+                        UnownedStringSlice(keyword),
+                        typedPrefix.getUnownedSlice()))
+                    continue;
                 if (!deduplicateSet.add(keyword))
                     continue;
                 LanguageServerProtocol::CompletionItem item;
@@ -643,6 +702,10 @@ CompletionResult CompletionContext::collectMembersAndSymbols()
         {
             for (auto keyword : kStmtKeywords)
             {
+                if (!_matchesTypedPrefix(
+                        UnownedStringSlice(keyword),
+                        typedPrefix.getUnownedSlice()))
+                    continue;
                 if (!deduplicateSet.add(keyword))
                     continue;
                 LanguageServerProtocol::CompletionItem item;
@@ -658,6 +721,8 @@ CompletionResult CompletionContext::collectMembersAndSymbols()
             if (!def.name)
                 continue;
             auto& text = def.name->text;
+            if (!_matchesTypedPrefix(text.getUnownedSlice(), typedPrefix.getUnownedSlice()))
+                continue;
             if (!deduplicateSet.add(text))
                 continue;
             LanguageServerProtocol::CompletionItem item;
@@ -667,6 +732,7 @@ CompletionResult CompletionContext::collectMembersAndSymbols()
             result.add(item);
         }
     }
+    bool isIncomplete = _limitCompletionItems(result, typedPrefix.getUnownedSlice());
     if (useCommitChars)
     {
         for (auto& item : result)
@@ -675,7 +741,9 @@ CompletionResult CompletionContext::collectMembersAndSymbols()
                 item.commitCharacters.add(ch);
         }
     }
-    return result;
+    CompletionResult completionResult(_Move(result));
+    completionResult.isIncomplete = isIncomplete;
+    return completionResult;
 }
 
 CompletionResult CompletionContext::createCapabilityCandidates()
@@ -20,6 +20,9 @@ struct CompletionResult
 {
     List<LanguageServerProtocol::CompletionItem> items;
     List<LanguageServerProtocol::TextEditCompletionItem> textEditItems;
+    // Set if `items` was cut down to a limited number of the best matches, so the client must
+    // ask again as the user types more of the name.
+    bool isIncomplete = false;
     CompletionResult() = default;
     CompletionResult(List<LanguageServerProtocol::CompletionItem>&& other)
         : items(_Move(other))
@@ -42,6 +45,8 @@ struct CompletionContext
     CommitCharacterBehavior commitCharacterBehavior;
     Int line;
     Int col;
+    // The part of the identifier at the cursor that has been typed so far.
+    String typedPrefix;
 
     LanguageServerResult<CompletionResult> tryCompleteMemberAndSymbol();
     LanguageServerResult<CompletionResult> tryCompleteHLSLSemantic();
@@ -0,0 +1,566 @@
+#include "slang-language-server-workspace-symbols.h"
+
+#include "../compiler-core/slang-lexer.h"
+#include "../compiler-core/slang-name.h"
+#include "../core/slang-char-encode.h"
+#include "../core/slang-char-util.h"
+#include "../core/slang-file-system.h"
+#include "../core/slang-io.h"
+#include "../core/slang-string-util.h"
+#include "slang-workspace-version.h"
+
+#include <stdlib.h>
+
+namespace Slang
+{
+using namespace LanguageServerProtocol;
+
+static const UnownedStringSlice kIndexFileHeader =
+    UnownedStringSlice::fromLiteral("slangd-symbol-index 1");
+
+// A `{}` scope that can contain declarations (struct, namespace, ...), as opposed to a
+// function body or an initializer list.
+struct SymbolIndexScope
+{
+    SymbolKind kind = 0;
+    String name;
+};
+
+// Get the kind of symbol declared by a keyword that begins a named `{}` scope.
+static bool _getContainerKeywordKind(UnownedStringSlice keyword, SymbolKind& outKind)
+{
+    if (keyword == "struct" || keyword == "cbuffer" || keyword == "tbuffer")
+        outKind = kSymbolKindStruct;
+    else if (keyword == "class" || keyword == "extension")
+        outKind = kSymbolKindClass;
+    else if (keyword == "interface")
+        outKind = kSymbolKindInterface;
+    else if (keyword == "enum")
+        outKind = kSymbolKindEnum;
+    else if (keyword == "namespace")
+        outKind = kSymbolKindNamespace;
+    else
+        return false;
+    return true;
+}
+
+// Statements at declaration scope that don't declare anything we want to index.
+static bool _isIgnoredStatementKeyword(UnownedStringSlice keyword)
+{
+    return keyword == "import" || keyword == "__include" || keyword == "__exported" ||
+           keyword == "module" || keyword == "implementing" || keyword == "using";
+}
+
+// Find the declarations in the tokens of a single file.
+//
+// This is a lexical approximation of the parser: it tracks `{}` scopes to tell type and
+// namespace bodies apart from function bodies, and treats an identifier that follows a type
+// name and is followed by `(`, `=`, `;`, `:`, `[` or `,` as a declaration.
+static void _indexTokens(
+    const List<Token>& tokens,
+    SourceManager* sourceManager,
+    DocumentVersion* doc,
+    List<WorkspaceSymbolIndex::Symbol>& outSymbols)
+{
+    List<SymbolIndexScope> scopes;
+    bool hasPendingContainer = false;
+    SymbolIndexScope pendingContainer;
+    Index parenDepth = 0;
+    bool isStatementStart = true;
+    bool isIgnoredStatement = false;
+    bool isConstStatement = false;
+    bool isTypedefStatement = false;
+    Index lastIdentifierIndex = -1;
+
+    auto resetStatement = [&]()
+    {
+        isStatementStart = true;
+        isIgnoredStatement = false;
+        isConstStatement = false;
+        isTypedefStatement = false;
+        lastIdentifierIndex = -1;
+    };
+    auto getContainer = [&]() -> SymbolIndexScope*
+    {
+        return scopes.getCount() ? &scopes.getLast() : nullptr;
+    };
+    auto isMemberScope = [&]()
+    {
+        auto container = getContainer();
+        return container && container->kind != kSymbolKindNamespace;
+    };
+    auto addSymbol = [&](const Token& nameToken, SymbolKind kind)
+    {
+        auto humaneLoc = sourceManager->getHumaneLoc(nameToken.loc, SourceLocType::Actual);
+        WorkspaceSymbolIndex::Symbol symbol;
+        symbol.name = nameToken.getContent();
+        symbol.kind = kind;
+        doc->oneBasedUTF8LocToZeroBasedUTF16Loc(
+            humaneLoc.line,
+            humaneLoc.column,
+            symbol.line,
+            symbol.character);
+        StringBuilder containerName;
+        for (auto& scope : scopes)
+        {
+            if (containerName.getLength())
+                containerName << "::";
+            containerName << scope.name;
+        }
+        symbol.containerName = containerName.produceString();
+        outSymbols.add(symbol);
+    };
+
+    const Index tokenCount = tokens.getCount();
+    for (Index i = 0; i < tokenCount; i++)
+    {
+        const Token& token = tokens[i];
+        if (token.type == TokenType::EndOfFile)
+            break;
+
+        // Skip over preprocessor directives.
+        if (token.type == TokenType::Pound && (token.flags & TokenFlag::AtStartOfLine))
+        {
+            while (i + 1 < tokenCount && !(tokens[i + 1].flags & TokenFlag::AtStartOfLine))
+                i++;
+            continue;
+        }
+
+        if (token.type == TokenType::LBrace)
+        {
+            if (hasPendingContainer && parenDepth == 0)
+            {
+                scopes.add(pendingContainer);
+                hasPendingContainer = false;
+                resetStatement();
+                continue;
+            }
+
+            // Anything else is a function body or an initializer, which we skip as a whole.
+            Index depth = 1;
+            while (depth > 0 && i + 1 < tokenCount)
+            {
+                i++;
+                if (tokens[i].type == TokenType::LBrace)
+                    depth++;
+                else if (tokens[i].type == TokenType::RBrace)
+                    depth--;
+                else if (tokens[i].type == TokenType::EndOfFile)
+                    break;
+            }
+            parenDepth = 0;
+            resetStatement();
+            continue;
+        }
+        if (token.type == TokenType::RBrace)
+        {
+            if (scopes.getCount())
+                scopes.removeLast();
+            hasPendingContainer = false;
+            parenDepth = 0;
+            resetStatement();
+            continue;
+        }
+        if (token.type == TokenType::Semicolon)
+        {
+            if (isTypedefStatement && !isIgnoredStatement && lastIdentifierIndex >= 0)
+                addSymbol(tokens[lastIdentifierIndex], kSymbolKindClass);
+            hasPendingContainer = false;
+            parenDepth = 0;
+            resetStatement();
+            continue;
+        }
+        if (token.type == TokenType::OpAssign)
+        {
+            // `struct S s = { ... };` is followed by an initializer, not the body of `S`.
+            hasPendingContainer = false;
+        }
+        if (token.type == TokenType::LParent)
+        {
+            parenDepth++;
+            isStatementStart = false;
+            continue;
+        }
+        if (token.type == TokenType::RParent)
+        {
+            if (parenDepth > 0)
+                parenDepth--;
+            continue;
+        }
+
+        const bool wasStatementStart = isStatementStart;
+        isStatementStart = false;
+        if (token.type != TokenType::Identifier || parenDepth > 0 || isIgnoredStatement)
+            continue;
+
+        auto content = token.getContent();
+        lastIdentifierIndex = i;
+
+        // The cases of an enum are the identifiers at the start of each comma-separated item.
+        auto container = getContainer();
+        if (container && container->kind == kSymbolKindEnum)
+        {
+            auto prevType = tokens[i - 1].type;
+            if (prevType == TokenType::LBrace || prevType == TokenType::Comma)
+                addSymbol(token, kSymbolKindEnumMember);
+            continue;
+        }
+
+        if (wasStatementStart && _isIgnoredStatementKeyword(content))
+        {
+            isIgnoredStatement = true;
+            continue;
+        }
+        if (content == "const")
+        {
+            isConstStatement = true;
+            continue;
+        }
+        if (content == "typedef")
+        {
+            isTypedefStatement = true;
+            continue;
+        }
+
+        SymbolKind containerKind = 0;
+        if (_getContainerKeywordKind(content, containerKind))
+        {
+            Index nameIndex = i + 1;
+            // `enum class Name`
+            if (content == "enum" && nameIndex < tokenCount &&
+                tokens[nameIndex].type == TokenType::Identifier &&
+                tokens[nameIndex].getContent() == "class")
+            {
+                nameIndex++;
+            }
+            if (nameIndex < tokenCount && tokens[nameIndex].type == TokenType::Identifier)
+            {
+                // An extension doesn't declare a new name, but its members are still indexed.
+                if (content != "extension")
+                    addSymbol(tokens[nameIndex], containerKind);
+                pendingContainer = SymbolIndexScope();
+                pendingContainer.kind = containerKind;
+                pendingContainer.name = tokens[nameIndex].getContent();
+                hasPendingContainer = true;
+                i = nameIndex;
+                lastIdentifierIndex = nameIndex;
+            }
+            continue;
+        }
+
+        // Keywords that are directly followed by the name they declare.
+        SymbolKind keywordDeclKind = 0;
+        if (content == "typealias")
+            keywordDeclKind = kSymbolKindClass;
+        else if (content == "associatedtype")
+            keywordDeclKind = kSymbolKindTypeParameter;
+        else if (content == "property")
+            keywordDeclKind = kSymbolKindProperty;
+        else if (content == "func")
+            keywordDeclKind = isMemberScope() ? kSymbolKindMethod : kSymbolKindFunction;
+        if (keywordDeclKind)
+        {
+            if (i + 1 < tokenCount && tokens[i + 1].type == TokenType::Identifier)
+            {
+                addSymbol(tokens[i + 1], keywordDeclKind);
+                i++;
+                lastIdentifierIndex = i;
+            }
+            continue;
+        }
+
+        if (i == 0 || i + 1 >= tokenCount || isTypedefStatement)
+            continue;
+        const Token& prevToken = tokens[i - 1];
+        const bool isAfterType =
+            (prevToken.type == TokenType::Identifier && prevToken.getContent() != "return") ||
+            prevToken.type == TokenType::OpGreater;
+        if (!isAfterType)
+            continue;
+        switch (tokens[i + 1].type)
+        {
+        case TokenType::LParent:
+            addSymbol(token, isMemberScope() ? kSymbolKindMethod : kSymbolKindFunction);
+            break;
+        case TokenType::OpAssign:
+        case TokenType::Semicolon:
+        case TokenType::Colon:
+        case TokenType::LBracket:
+        case TokenType::Comma:
+            if (isConstStatement)
+                addSymbol(token, kSymbolKindConstant);
+            else
+                addSymbol(token, isMemberScope() ? kSymbolKindField : kSymbolKindVariable);
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+void WorkspaceSymbolIndex::init(const List<String>& rootDirectories)
+{
+    m_rootDirectories = rootDirectories;
+    m_files.clear();
+    m_isWorkspaceIndexed = false;
+    m_isDirty = false;
+    m_indexFilePath = String();
+    if (m_rootDirectories.getCount())
+    {
+        m_indexFilePath = Path::combine(
+            Path::combine(m_rootDirectories[0], ".cache", "slangd"),
+            "symbol-index.txt");
+        _load();
+    }
+}
+
+void WorkspaceSymbolIndex::updateFile(const String& path, const String& text)
+{
+    auto contentHash = getStableHashCode64(text.getBuffer(), text.getLength());
+    if (auto entry = m_files.tryGetValue(path))
+    {
+        if (entry->contentHash == contentHash)
+            return;
+    }
+
+    SourceManager sourceManager;
+    sourceManager.initialize(nullptr, nullptr);
+    auto sourceFile =
+        sourceManager.createSourceFileWithString(PathInfo::makePath(path), text);
+    auto sourceView = sourceManager.createSourceView(sourceFile, nullptr, SourceLoc());
+    DiagnosticSink sink;
+    RootNamePool rootPool;
+    NamePool namePool;
+    namePool.setRootNamePool(&rootPool);
+    MemoryArena memory;
+    memory.init(1 << 16);
+    Lexer lexer;
+    lexer.initialize(sourceView, &sink, &namePool, &memory);
+    lexer.m_lexerFlags |= kLexerFlag_SuppressDiagnostics;
+    auto tokens = lexer.lexAllSemanticTokens();
+
+    RefPtr<DocumentVersion> doc = new DocumentVersion();
+    doc->setText(text);
+
+    FileEntry entry;
+    entry.contentHash = contentHash;
+    _indexTokens(tokens.m_tokens, &sourceManager, doc.Ptr(), entry.symbols);
+    m_files[path] = _Move(entry);
+    m_isDirty = true;
+}
+
+struct WorkspaceFileEnumerationContext
+{
+    List<String> workList;
+    List<String> files;
+    String currentPath;
+};
+
+void WorkspaceSymbolIndex::indexWorkspace(Workspace* workspace)
+{
+    // Opened documents are kept up to date as they are edited, so only the files on disk
+    // need to be looked at, and only once.
+    if (m_isWorkspaceIndexed)
+        return;
+    m_isWorkspaceIndexed = true;
+
+    WorkspaceFileEnumerationContext context;
+    for (auto& root : m_rootDirectories)
+        context.workList.add(root);
+    auto fileSystem = OSFileSystem::getExtSingleton();
+    for (Index i = 0; i < context.workList.getCount(); i++)
+    {
+        context.currentPath = context.workList[i];
+        fileSystem->enumeratePathContents(
+            context.currentPath.getBuffer(),
+            [](SlangPathType pathType, const char* name, void* userData)
+            {
+                auto enumContext = (WorkspaceFileEnumerationContext*)userData;
+                auto nameSlice = UnownedStringSlice(name);
+                if (pathType == SLANG_PATH_TYPE_DIRECTORY)
+                {
+                    // Ignore directories starting with '.', including the index itself.
+                    if (nameSlice.getLength() && nameSlice[0] == '.')
+                        return;
+                    enumContext->workList.add(Path::combine(enumContext->currentPath, name));
+                }
+                else if (
+                    nameSlice.endsWithCaseInsensitive(".slang") ||
+                    nameSlice.endsWithCaseInsensitive(".hlsl"))
+                {
+                    enumContext->files.add(Path::combine(enumContext->currentPath, name));
+                }
+            },
+            &context);
+    }
+
+    HashSet<String> foundFiles;
+    for (auto& file : context.files)
+    {
+        String canonicalPath;
+        if (SLANG_FAILED(Path::getCanonical(file, canonicalPath)))
+            continue;
+        foundFiles.add(canonicalPath);
+        if (workspace->openedDocuments.containsKey(canonicalPath))
+            continue;
+        String text;
+        if (SLANG_FAILED(File::readAllText(canonicalPath, text)))
+            continue;
+        updateFile(canonicalPath, text);
+    }
+
+    // Forget about files that were deleted since the index was saved.
+    List<String> removedFiles;
+    for (const auto& [path, _] : m_files)
+    {
+        if (!foundFiles.contains(path) && !workspace->openedDocuments.containsKey(path))
+            removedFiles.add(path);
+    }
+    for (auto& path : removedFiles)
+    {
+        m_files.remove(path);
+        m_isDirty = true;
+    }
+
+    save();
+}
+
+// Check if all characters of `query` appear in `name` in order, ignoring case.
+static bool _matchesQuery(UnownedStringSlice name, UnownedStringSlice query)
+{
+    Index queryIndex = 0;
+    for (Index i = 0; i < name.getLength() && queryIndex < query.getLength(); i++)
+    {
+        if (CharUtil::toLower(name[i]) == CharUtil::toLower(query[queryIndex]))
+            queryIndex++;
+    }
+    return queryIndex == query.getLength();
+}
+
+static Location _getSymbolLocation(const String& path, const WorkspaceSymbolIndex::Symbol& symbol)
+{
+    Location location;
+    location.uri = URI::fromLocalFilePath(path.getUnownedSlice()).uri;
+    location.range.start.line = symbol.line;
+    location.range.start.character = symbol.character;
+    location.range.end.line = symbol.line;
+    location.range.end.character =
+        symbol.character + (int)UTF8Util::calcUTF16CharCount(symbol.name.getUnownedSlice());
+    return location;
+}
+
+List<SymbolInformation> WorkspaceSymbolIndex::search(UnownedStringSlice query, Index maxCount)
+{
+    List<SymbolInformation> result;
+    for (const auto& [path, entry] : m_files)
+    {
+        for (auto& symbol : entry.symbols)
+        {
+            if (!_matchesQuery(symbol.name.getUnownedSlice(), query))
+                continue;
+            SymbolInformation info;
+            info.name = symbol.name;
+            info.kind = symbol.kind;
+            info.containerName = symbol.containerName;
+            info.location = _getSymbolLocation(path, symbol);
+            result.add(info);
+            if (result.getCount() >= maxCount)
+                return result;
+        }
+    }
+    return result;
+}
+
+List<Location> WorkspaceSymbolIndex::findDefinitions(UnownedStringSlice name)
+{
+    List<Location> result;
+    for (const auto& [path, entry] : m_files)
+    {
+        for (auto& symbol : entry.symbols)
+        {
+            if (symbol.name.getUnownedSlice() == name)
+                result.add(_getSymbolLocation(path, symbol));
+        }
+    }
+    return result;
+}
+
+// The index file has one line per file, `F <content hash> <path>`, followed by one line per
+// symbol in that file, `S <kind> <line> <character> <name> <container name>`, all separated
+// by tabs.
+SlangResult WorkspaceSymbolIndex::save()
+{
+    if (!m_isDirty || m_indexFilePath.getLength() == 0)
+        return SLANG_OK;
+
+    StringBuilder sb;
+    sb << kIndexFileHeader << "\n";
+    for (const auto& [path, entry] : m_files)
+    {
+        sb << "F\t" << String(entry.contentHash.hash, 16) << "\t" << path << "\n";
+        for (auto& symbol : entry.symbols)
+        {
+            sb << "S\t" << symbol.kind << "\t" << symbol.line << "\t" << symbol.character
+               << "\t" << symbol.name << "\t" << symbol.containerName << "\n";
+        }
+    }
+    Path::createDirectoryRecursive(Path::getParentDirectory(m_indexFilePath));
+    SLANG_RETURN_ON_FAIL(File::writeAllText(m_indexFilePath, sb.produceString()));
+    m_isDirty = false;
+    return SLANG_OK;
+}
+
+SlangResult WorkspaceSymbolIndex::_load()
+{
+    if (!File::exists(m_indexFilePath))
+        return SLANG_E_NOT_FOUND;
+    String text;
+    SLANG_RETURN_ON_FAIL(File::readAllText(m_indexFilePath, text));
+
+    List<UnownedStringSlice> lines;
+    StringUtil::calcLines(text.getUnownedSlice(), lines);
+    if (lines.getCount() == 0 || lines[0].trim() != kIndexFileHeader)
+        return SLANG_FAIL;
+
+    String currentPath;
+    FileEntry currentEntry;
+    auto addCurrentEntry = [&]()
+    {
+        if (currentPath.getLength())
+            m_files[currentPath] = _Move(currentEntry);
+        currentEntry = FileEntry();
+    };
+    List<UnownedStringSlice> fields;
+    for (Index i = 1; i < lines.getCount(); i++)
+    {
+        fields.clear();
+        StringUtil::split(lines[i], '\t', fields);
+        if (fields.getCount() == 3 && fields[0] == "F")
+        {
+            addCurrentEntry();
+            currentPath = fields[2];
+            currentEntry.contentHash.hash = strtoull(String(fields[1]).getBuffer(), nullptr, 16);
+        }
+        else if (fields.getCount() == 6 && fields[0] == "S" && currentPath.getLength())
+        {
+            Int kind = 0, line = 0, character = 0;
+            if (SLANG_FAILED(StringUtil::parseInt(fields[1], kind)) ||
+                SLANG_FAILED(StringUtil::parseInt(fields[2], line)) ||
+                SLANG_FAILED(StringUtil::parseInt(fields[3], character)))
+            {
+                continue;
+            }
+            Symbol symbol;
+            symbol.kind = (SymbolKind)kind;
+            symbol.line = (int)line;
+            symbol.character = (int)character;
+            symbol.name = fields[4];
+            symbol.containerName = fields[5];
+            currentEntry.symbols.add(symbol);
+        }
+    }
+    addCurrentEntry();
+    return SLANG_OK;
+}
+
+} // namespace Slang
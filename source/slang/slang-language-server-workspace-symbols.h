@@ -0,0 +1,66 @@
+#pragma once
+
+#include "../compiler-core/slang-language-server-protocol.h"
+#include "../core/slang-basic.h"
+#include "../core/slang-stable-hash.h"
+
+namespace Slang
+{
+class Workspace;
+
+/// An index of the declarations in every source file of a workspace.
+///
+/// Declarations are found by lexing each file, without parsing or checking it, so the index
+/// also covers files that are not imported by any opened document. The index is saved under
+/// the first workspace root, and a file is only lexed again when its contents have changed.
+class WorkspaceSymbolIndex
+{
+public:
+    struct Symbol
+    {
+        String name;
+        String containerName;
+        LanguageServerProtocol::SymbolKind kind = 0;
+        // Zero-based line and UTF-16 column of the name.
+        int line = 0;
+        int character = 0;
+    };
+
+    /// Set up the index for a workspace, loading the saved index if there is one.
+    void init(const List<String>& rootDirectories);
+
+    /// Make sure every source file under the workspace roots is indexed, and save the index
+    /// if anything changed.
+    void indexWorkspace(Workspace* workspace);
+
+    /// Index the file at (canonical) `path` with contents `text`, if they have changed.
+    void updateFile(const String& path, const String& text);
+
+    /// Find the symbols whose name contains all characters of `query` in order,
+    /// ignoring case.
+    List<LanguageServerProtocol::SymbolInformation> search(
+        UnownedStringSlice query,
+        Index maxCount);
+
+    /// Find the locations of the symbols named exactly `name`.
+    List<LanguageServerProtocol::Location> findDefinitions(UnownedStringSlice name);
+
+    SlangResult save();
+
+private:
+    struct FileEntry
+    {
+        StableHashCode64 contentHash = {0};
+        List<Symbol> symbols;
+    };
+
+    SlangResult _load();
+
+    Dictionary<String, FileEntry> m_files;
+    List<String> m_rootDirectories;
+    String m_indexFilePath;
+    bool m_isWorkspaceIndexed = false;
+    bool m_isDirty = false;
+};
+
+} // namespace Slang
@@ -65,6 +65,7 @@ SlangResult LanguageServerCore::init(const InitializeParams& args)
         rootUris.add(URI::fromString(wd.uri.getUnownedSlice()));
     }
     m_workspace->init(rootUris, getOrCreateGlobalSession());
+    m_symbolIndex.init(m_workspace->rootDirectories);
     return SLANG_OK;
 }
 
@@ -138,6 +139,7 @@ SlangResult LanguageServer::parseNextMessage()
                     caps.hoverProvider = true;
                     caps.definitionProvider = true;
                     caps.documentSymbolProvider = true;
+                    caps.workspaceSymbolProvider = true;
                     caps.inlayHintProvider.resolveProvider = false;
                     caps.documentFormattingProvider = true;
                     caps.documentOnTypeFormattingProvider.firstTriggerCharacter = "}";
@@ -155,7 +157,7 @@ SlangResult LanguageServer::parseNextMessage()
                     caps.completionProvider.triggerCharacters.add("/");
                     caps.completionProvider.resolveProvider = true;
                     caps.completionProvider.workDoneToken = "";
-                    caps.semanticTokensProvider.full = true;
+                    caps.semanticTokensProvider.full.delta = true;
                     caps.semanticTokensProvider.range = false;
                     caps.signatureHelpProvider.triggerCharacters.add("(");
                     caps.signatureHelpProvider.triggerCharacters.add(",");
@@ -208,7 +210,7 @@ SlangResult LanguageServer::parseNextMessage()
                 if (response.result.getKind() == JSONValue::Kind::Array)
                 {
                     auto arr = m_connection->getContainer()->getArray(response.result);
-                    if (arr.getCount() == 12)
+                    if (arr.getCount() == 13)
                     {
                         updatePredefinedMacros(arr[0]);
                         updateSearchPaths(arr[1]);
@@ -217,6 +219,7 @@ SlangResult LanguageServer::parseNextMessage()
                         updateFormattingOptions(arr[4], arr[5], arr[6], arr[7], arr[8]);
                         updateInlayHintOptions(arr[9], arr[10]);
                         updateTraceOptions(arr[11]);
+                        updateModuleCachePath(arr[12]);
                     }
                 }
                 break;
@@ -245,6 +248,7 @@ SlangResult LanguageServerCore::didOpenTextDocument(const DidOpenTextDocumentPar
 {
     String canonicalPath = uriToCanonicalPath(args.textDocument.uri);
     m_workspace->openDoc(canonicalPath, args.textDocument.text);
+    m_symbolIndex.updateFile(canonicalPath, args.textDocument.text);
     return SLANG_OK;
 }
 
@@ -966,6 +970,7 @@ LanguageServerResult<List<LanguageServerProtocol::Location>> LanguageServerCore:
     {
         SLANG_LS_RETURN_ON_SUCCESS(tryGotoMacroDefinition(version, doc, line, col));
         SLANG_LS_RETURN_ON_SUCCESS(tryGotoFileInclude(version, doc, line));
+        SLANG_LS_RETURN_ON_SUCCESS(tryGotoIndexedSymbol(doc, line, col));
         return std::nullopt;
     }
     struct LocationResult
@@ -1088,6 +1093,13 @@ SlangResult LanguageServer::completion(
     auto result = m_core.completion(args);
     if (SLANG_FAILED(result.returnCode) || result.isNull)
         m_connection->sendResult(NullResponse::get(), responseId);
+    else if (result.result.isIncomplete)
+    {
+        CompletionList list;
+        list.isIncomplete = true;
+        list.items = _Move(result.result.items);
+        m_connection->sendResult(&list, responseId);
+    }
     else if (result.result.items.getCount())
         m_connection->sendResult(&result.result.items, responseId);
     else
@@ -1139,6 +1151,15 @@ LanguageServerResult<CompletionResult> LanguageServerCore::completion(
         return std::nullopt;
     }
 
+    Index prefixStart = cursorOffset;
+    while (prefixStart > 0 && _isIdentifierChar(doc->getText()[prefixStart - 1]))
+    {
+        prefixStart--;
+    }
+    String typedPrefix = doc->getText().getUnownedSlice().subString(
+        prefixStart,
+        cursorOffset - prefixStart);
+
     // Ajust cursor position to the beginning of the current/last identifier.
     cursorOffset--;
     while (cursorOffset > 0 && _isIdentifierChar(doc->getText()[cursorOffset]))
@@ -1169,6 +1190,7 @@ LanguageServerResult<CompletionResult> LanguageServerCore::completion(
     context.canonicalPath = canonicalPath.getUnownedSlice();
     context.line = utf8Line;
     context.col = utf8Col;
+    context.typedPrefix = typedPrefix;
     context.commitCharacterBehavior = m_commitCharacterBehavior;
     if (args.context.triggerKind == kCompletionTriggerKindTriggerCharacter &&
         (args.context.triggerCharacter == " " || args.context.triggerCharacter == "[" ||
@@ -1284,10 +1306,105 @@ SlangResult LanguageServer::semanticTokens(
     return SLANG_OK;
 }
 
+SlangResult LanguageServer::semanticTokensDelta(
+    const LanguageServerProtocol::SemanticTokensDeltaParams& args,
+    const JSONValue& responseId)
+{
+    SemanticTokens fullTokens;
+    bool isDelta = false;
+    auto result = m_core.semanticTokensDelta(args, fullTokens, isDelta);
+    if (SLANG_FAILED(result.returnCode) || result.isNull)
+    {
+        m_connection->sendResult(NullResponse::get(), responseId);
+        return SLANG_OK;
+    }
+    if (isDelta)
+        m_connection->sendResult(&result.result, responseId);
+    else
+        m_connection->sendResult(&fullTokens, responseId);
+    return SLANG_OK;
+}
+
 LanguageServerResult<LanguageServerProtocol::SemanticTokens> LanguageServerCore::semanticTokens(
     const LanguageServerProtocol::SemanticTokensParams& args)
+{
+    return computeSemanticTokens(args.textDocument.uri);
+}
+
+// Find the edit that turns the encoded tokens `oldData` into `newData`.
+static List<SemanticTokensEdit> _diffSemanticTokens(
+    const List<uint32_t>& oldData,
+    const List<uint32_t>& newData)
+{
+    // Tokens are encoded relative to the previous token, so an edit in the middle of a
+    // document usually leaves a common prefix and suffix. Keep the edit aligned to whole
+    // tokens of five integers each.
+    const Index kTokenSize = 5;
+    const Index minCount = Math::Min(oldData.getCount(), newData.getCount());
+    Index prefixCount = 0;
+    while (prefixCount < minCount && oldData[prefixCount] == newData[prefixCount])
+        prefixCount++;
+    prefixCount -= prefixCount % kTokenSize;
+    Index suffixCount = 0;
+    while (suffixCount < minCount - prefixCount &&
+           oldData[oldData.getCount() - 1 - suffixCount] ==
+               newData[newData.getCount() - 1 - suffixCount])
+    {
+        suffixCount++;
+    }
+    suffixCount -= suffixCount % kTokenSize;
+
+    List<SemanticTokensEdit> edits;
+    if (prefixCount == oldData.getCount() && prefixCount == newData.getCount())
+        return edits;
+    SemanticTokensEdit edit;
+    edit.start = (uint32_t)prefixCount;
+    edit.deleteCount = (uint32_t)(oldData.getCount() - prefixCount - suffixCount);
+    edit.data.addRange(
+        newData.getBuffer() + prefixCount,
+        newData.getCount() - prefixCount - suffixCount);
+    edits.add(_Move(edit));
+    return edits;
+}
+
+LanguageServerResult<LanguageServerProtocol::SemanticTokensDelta> LanguageServerCore::
+    semanticTokensDelta(
+        const LanguageServerProtocol::SemanticTokensDeltaParams& args,
+        LanguageServerProtocol::SemanticTokens& outFullTokens,
+        bool& outIsDelta)
 {
     String canonicalPath = uriToCanonicalPath(args.textDocument.uri);
+    List<uint32_t> previousData;
+    bool hasPrevious = false;
+    if (auto cached = m_semanticTokenCache.tryGetValue(canonicalPath))
+    {
+        if (cached->resultId == args.previousResultId)
+        {
+            previousData = cached->data;
+            hasPrevious = true;
+        }
+    }
+
+    auto result = computeSemanticTokens(args.textDocument.uri);
+    if (SLANG_FAILED(result.returnCode) || result.isNull)
+        return std::nullopt;
+
+    outIsDelta = hasPrevious;
+    if (!hasPrevious)
+    {
+        outFullTokens = _Move(result.result);
+        return SemanticTokensDelta();
+    }
+    SemanticTokensDelta delta;
+    delta.resultId = result.result.resultId;
+    delta.edits = _diffSemanticTokens(previousData, result.result.data);
+    return delta;
+}
+
+LanguageServerResult<LanguageServerProtocol::SemanticTokens> LanguageServerCore::
+    computeSemanticTokens(const String& uri)
+{
+    String canonicalPath = uriToCanonicalPath(uri);
 
     RefPtr<DocumentVersion> doc;
     if (!m_workspace->openedDocuments.tryGetValue(canonicalPath, doc))
@@ -1324,8 +1441,12 @@ LanguageServerResult<LanguageServerProtocol::SemanticTokens> LanguageServerCore:
         token.length = (int)(colEnd - col);
     }
     SemanticTokens response;
-    response.resultId = "";
+    response.resultId = String(++m_semanticTokenResultCount);
     response.data = getEncodedTokens(tokens);
+
+    auto& cached = m_semanticTokenCache[canonicalPath];
+    cached.resultId = response.resultId;
+    cached.data = response.data;
     return response;
 }
 
@@ -1722,6 +1843,33 @@ LanguageServerResult<List<LanguageServerProtocol::DocumentSymbol>> LanguageServe
     return symbols;
 }
 
+SlangResult LanguageServer::workspaceSymbol(
+    const LanguageServerProtocol::WorkspaceSymbolParams& args,
+    const JSONValue& responseId)
+{
+    auto result = m_core.workspaceSymbol(args);
+    if (SLANG_FAILED(result.returnCode) || result.isNull)
+    {
+        m_connection->sendResult(NullResponse::get(), responseId);
+        return SLANG_OK;
+    }
+    m_connection->sendResult(&result.result, responseId);
+    return SLANG_OK;
+}
+
+LanguageServerResult<List<LanguageServerProtocol::SymbolInformation>> LanguageServerCore::
+    workspaceSymbol(const LanguageServerProtocol::WorkspaceSymbolParams& args)
+{
+    // The first request indexes the files on disk, which is cheap for the files whose
+    // contents match the saved index.
+    const Index kMaxWorkspaceSymbolCount = 1000;
+    m_symbolIndex.indexWorkspace(m_workspace);
+    auto symbols =
+        m_symbolIndex.search(args.query.getUnownedSlice(), kMaxWorkspaceSymbolCount);
+    m_symbolIndex.save();
+    return symbols;
+}
+
 SlangResult LanguageServer::inlayHint(
     const LanguageServerProtocol::InlayHintParams& args,
     const JSONValue& responseId)
@@ -1928,6 +2076,21 @@ void LanguageServer::publishDiagnostics()
     auto version = m_core.m_workspace->getCurrentVersion();
     SLANG_AST_BUILDER_RAII(version->linkage->getASTBuilder());
 
+    // Editors only send requests for the documents that are visible, so check the other opened
+    // documents here. To stay responsive, stop after a while or when a message arrives, and
+    // check the remaining documents in later updates.
+    auto checkStartTime = std::chrono::system_clock::now();
+    auto underlyingConnection = m_connection->getUnderlyingConnection();
+    version->checkOpenedDocuments(
+        [&]()
+        {
+            if (std::chrono::system_clock::now() - checkStartTime >
+                std::chrono::milliseconds(200))
+                return true;
+            underlyingConnection->update();
+            return underlyingConnection->hasContent();
+        });
+
     // Send updates to clear diagnostics for files that no longer have any messages.
     List<String> filesToRemove;
     for (const auto& [filepath, _] : m_lastPublishedDiagnostics)
@@ -2019,6 +2182,23 @@ void LanguageServer::updateSearchInWorkspace(const JSONValue& value)
     }
 }
 
+void LanguageServer::updateModuleCachePath(const JSONValue& value)
+{
+    if (value.isValid())
+    {
+        auto container = m_connection->getContainer();
+        JSONToNativeConverter converter(container, &m_typeMap, m_connection->getSink());
+        String path;
+        if (SLANG_SUCCEEDED(converter.convert(value, &path)))
+        {
+            if (m_core.m_workspace->updateModuleCachePath(path))
+            {
+                sendRefreshRequests(m_connection);
+            }
+        }
+    }
+}
+
 void LanguageServer::updateCommitCharacters(const JSONValue& jsonValue)
 {
     if (jsonValue.isValid())
@@ -2139,6 +2319,8 @@ void LanguageServer::sendConfigRequest()
     args.items.add(item);
     item.section = "slangLanguageServer.trace.server";
     args.items.add(item);
+    item.section = "slang.moduleCachePath";
+    args.items.add(item);
     m_connection->sendCall(
         ConfigurationParams::methodName,
         &args,
@@ -2288,6 +2470,24 @@ LanguageServerResult<List<Location>> LanguageServerCore::tryGotoFileInclude(
     return SLANG_FAIL;
 }
 
+LanguageServerResult<List<Location>> LanguageServerCore::tryGotoIndexedSymbol(
+    DocumentVersion* doc,
+    Index line,
+    Index col)
+{
+    // The identifier could not be resolved in the checked module, for example because the
+    // module that declares it is not imported yet. Fall back to the workspace index.
+    Index offset = 0;
+    auto identifier = doc->peekIdentifier(line, col, offset);
+    if (identifier.getLength() == 0)
+        return SLANG_FAIL;
+    m_symbolIndex.indexWorkspace(m_workspace);
+    auto results = m_symbolIndex.findDefinitions(identifier);
+    if (results.getCount() == 0)
+        return SLANG_FAIL;
+    return results;
+}
+
 SlangResult LanguageServer::queueJSONCall(JSONRPCCall call)
 {
     Command cmd;
@@ -2339,6 +2539,16 @@ SlangResult LanguageServer::queueJSONCall(JSONRPCCall call)
             call.id));
         cmd.semanticTokenArgs = args;
     }
+    else if (call.method == SemanticTokensDeltaParams::methodName)
+    {
+        SemanticTokensDeltaParams args;
+        SLANG_RETURN_ON_FAIL(m_connection->checkArrayObjectWrap(
+            call.params,
+            GetRttiInfo<SemanticTokensDeltaParams>::get(),
+            &args,
+            call.id));
+        cmd.semanticTokenDeltaArgs = args;
+    }
     else if (call.method == SignatureHelpParams::methodName)
     {
         SignatureHelpParams args;
@@ -2365,6 +2575,12 @@ SlangResult LanguageServer::queueJSONCall(JSONRPCCall call)
             call.id));
         cmd.documentSymbolArgs = args;
     }
+    else if (call.method == WorkspaceSymbolParams::methodName)
+    {
+        WorkspaceSymbolParams args;
+        SLANG_RETURN_ON_FAIL(m_connection->toNativeArgsOrSendError(call.params, &args, call.id));
+        cmd.workspaceSymbolArgs = args;
+    }
     else if (call.method == DocumentFormattingParams::methodName)
     {
         DocumentFormattingParams args;
@@ -2453,6 +2669,10 @@ SlangResult LanguageServer::runCommand(Command& call)
         {
             return semanticTokens(call.semanticTokenArgs.get(), call.id);
         }
+        else if (call.method == SemanticTokensDeltaParams::methodName)
+        {
+            return semanticTokensDelta(call.semanticTokenDeltaArgs.get(), call.id);
+        }
         else if (call.method == SignatureHelpParams::methodName)
         {
             return signatureHelp(call.signatureHelpArgs.get(), call.id);
@@ -2468,6 +2688,10 @@ SlangResult LanguageServer::runCommand(Command& call)
         {
             return documentSymbol(call.documentSymbolArgs.get(), call.id);
         }
+        else if (call.method == WorkspaceSymbolParams::methodName)
+        {
+            return workspaceSymbol(call.workspaceSymbolArgs.get(), call.id);
+        }
         else if (call.method == DidChangeConfigurationParams::methodName)
         {
             return didChangeConfiguration(call.changeConfigArgs.get());
@@ -2503,11 +2727,29 @@ SlangResult LanguageServer::runCommand(Command& call)
     return m_connection->sendError(JSONRPC::ErrorCode::MethodNotFound, call.id);
 }
 
+// Get the document of a request that has to check the whole document, or an empty string if
+// the request is cheap enough to answer right away.
+static String _getWholeDocumentRequestURI(Command& cmd)
+{
+    if (cmd.method == SemanticTokensParams::methodName)
+        return cmd.semanticTokenArgs.get().textDocument.uri;
+    if (cmd.method == SemanticTokensDeltaParams::methodName)
+        return cmd.semanticTokenDeltaArgs.get().textDocument.uri;
+    if (cmd.method == InlayHintParams::methodName)
+        return cmd.inlayHintArgs.get().textDocument.uri;
+    if (cmd.method == DocumentSymbolParams::methodName)
+        return cmd.documentSymbolArgs.get().textDocument.uri;
+    return String();
+}
+
 void LanguageServer::processCommands()
 {
     HashSet<int64_t> canceledIDs;
-    for (auto& cmd : commands)
+    // The index of the last command that modifies each document.
+    Dictionary<String, Index> lastDocumentChanges;
+    for (Index i = 0; i < commands.getCount(); i++)
     {
+        auto& cmd = commands[i];
         if (cmd.method == "$/cancelRequest")
         {
             auto id = cmd.cancelArgs.get().id;
@@ -2516,19 +2758,48 @@ void LanguageServer::processCommands()
                 canceledIDs.add(id);
             }
         }
+        else if (cmd.method == DidChangeTextDocumentParams::methodName)
+        {
+            lastDocumentChanges[cmd.changeDocArgs.get().textDocument.uri] = i;
+        }
+        else if (cmd.method == DidCloseTextDocumentParams::methodName)
+        {
+            lastDocumentChanges[cmd.closeDocArgs.get().textDocument.uri] = i;
+        }
     }
     const int kErrorRequestCanceled = -32800;
-    for (auto& cmd : commands)
+    const int kErrorContentModified = -32801;
+
+    // Requests that check a whole document (semantic tokens, inlay hints, document symbols)
+    // run after all other commands of this batch, so that they don't delay hover, completion
+    // and other requests that the user is waiting on.
+    List<Index> deferredCommands;
+    for (Index i = 0; i < commands.getCount(); i++)
     {
+        auto& cmd = commands[i];
         if (cmd.id.getKind() == JSONValue::Kind::Integer &&
             canceledIDs.contains(cmd.id.asInteger()))
         {
             m_connection->sendError((JSONRPC::ErrorCode)kErrorRequestCanceled, cmd.id);
+            continue;
         }
-        else
+        auto uri = _getWholeDocumentRequestURI(cmd);
+        if (uri.getLength() == 0)
         {
             runCommand(cmd);
+            continue;
         }
+        // A later edit of the same document makes the result stale, and the client will
+        // request it again for the new text.
+        Index changeIndex = -1;
+        if (lastDocumentChanges.tryGetValue(uri, changeIndex) && changeIndex > i)
+            m_connection->sendError((JSONRPC::ErrorCode)kErrorContentModified, cmd.id);
+        else
+            deferredCommands.add(i);
+    }
+    for (auto i : deferredCommands)
+    {
+        runCommand(commands[i]);
     }
 }
 
@@ -2542,6 +2813,7 @@ SlangResult LanguageServerCore::didCloseTextDocument(const DidCloseTextDocumentP
 {
     String canonicalPath = uriToCanonicalPath(args.textDocument.uri);
     m_workspace->closeDoc(canonicalPath);
+    m_semanticTokenCache.remove(canonicalPath);
     return SLANG_OK;
 }
 
@@ -2556,6 +2828,9 @@ SlangResult LanguageServerCore::didChangeTextDocument(const DidChangeTextDocumen
     String canonicalPath = uriToCanonicalPath(args.textDocument.uri);
     for (auto change : args.contentChanges)
         m_workspace->changeDoc(canonicalPath, change.range, change.text);
+    RefPtr<DocumentVersion> doc;
+    if (m_workspace->openedDocuments.tryGetValue(canonicalPath, doc))
+        m_symbolIndex.updateFile(canonicalPath, doc->getText());
     return SLANG_OK;
 }
 
@@ -2603,6 +2878,10 @@ void LanguageServer::updateConfigFromJSON(const JSONValue& jsonVal)
         {
             updateSearchPaths(kv.value);
         }
+        else if (key == "slang.moduleCachePath")
+        {
+            updateModuleCachePath(kv.value);
+        }
         else if (key == "slang.enableCommitCharactersInAutoCompletion")
         {
             updateCommitCharacters(kv.value);
@@ -2659,8 +2938,12 @@ SlangResult LanguageServer::execute()
 
         processCommands();
 
-        // Report diagnostics if it hasn't been updated for a while.
-        update();
+        // Report diagnostics if it hasn't been updated for a while. This checks the whole
+        // workspace, so if more messages arrived in the meantime, handle them first.
+        auto underlyingConnection = m_connection->getUnderlyingConnection();
+        underlyingConnection->update();
+        if (!underlyingConnection->hasContent())
+            update();
 
         auto workTime = platform::PerformanceCounter::getElapsedTimeInSeconds(workStart);
 
@@ -5,6 +5,7 @@
 #include "slang-language-server-auto-format.h"
 #include "slang-language-server-completion.h"
 #include "slang-language-server-inlay-hints.h"
+#include "slang-language-server-workspace-symbols.h"
 #include "slang-workspace-version.h"
 #include "slang.h"
 
@@ -63,6 +64,7 @@ struct Command
     Optional<LanguageServerProtocol::CompletionItem> completionResolveArgs;
     Optional<LanguageServerProtocol::TextEditCompletionItem> textEditCompletionResolveArgs;
     Optional<LanguageServerProtocol::DocumentSymbolParams> documentSymbolArgs;
+    Optional<LanguageServerProtocol::WorkspaceSymbolParams> workspaceSymbolArgs;
     Optional<LanguageServerProtocol::InlayHintParams> inlayHintArgs;
     Optional<LanguageServerProtocol::DocumentFormattingParams> formattingArgs;
     Optional<LanguageServerProtocol::DocumentRangeFormattingParams> rangeFormattingArgs;
@@ -71,6 +73,7 @@ struct Command
     Optional<LanguageServerProtocol::SignatureHelpParams> signatureHelpArgs;
     Optional<LanguageServerProtocol::DefinitionParams> definitionArgs;
     Optional<LanguageServerProtocol::SemanticTokensParams> semanticTokenArgs;
+    Optional<LanguageServerProtocol::SemanticTokensDeltaParams> semanticTokenDeltaArgs;
     Optional<LanguageServerProtocol::HoverParams> hoverArgs;
     Optional<LanguageServerProtocol::DidOpenTextDocumentParams> openDocArgs;
     Optional<LanguageServerProtocol::DidChangeTextDocumentParams> changeDocArgs;
@@ -98,6 +101,16 @@ public:
     CommitCharacterBehavior m_commitCharacterBehavior = CommitCharacterBehavior::MembersOnly;
     ComPtr<slang::IGlobalSession> m_session;
     RefPtr<Workspace> m_workspace;
+    WorkspaceSymbolIndex m_symbolIndex;
+
+    // The last semantic tokens sent for each document, used to answer delta requests.
+    struct CachedSemanticTokens
+    {
+        String resultId;
+        List<uint32_t> data;
+    };
+    Dictionary<String, CachedSemanticTokens> m_semanticTokenCache;
+    uint64_t m_semanticTokenResultCount = 0;
     FormatOptions m_formatOptions;
     Slang::InlayHintOptions m_inlayHintOptions;
     List<LanguageServerProtocol::WorkspaceFolder> m_workspaceFolders;
@@ -126,10 +139,19 @@ public:
         const LanguageServerProtocol::TextEditCompletionItem& editItem);
     LanguageServerResult<LanguageServerProtocol::SemanticTokens> semanticTokens(
         const LanguageServerProtocol::SemanticTokensParams& args);
+    /// Get the semantic tokens as edits to the result with `args.previousResultId`.
+    /// If that result is no longer cached, `outIsDelta` is set to false and the full
+    /// tokens are returned in `outFullTokens` instead.
+    LanguageServerResult<LanguageServerProtocol::SemanticTokensDelta> semanticTokensDelta(
+        const LanguageServerProtocol::SemanticTokensDeltaParams& args,
+        LanguageServerProtocol::SemanticTokens& outFullTokens,
+        bool& outIsDelta);
     LanguageServerResult<LanguageServerProtocol::SignatureHelp> signatureHelp(
         const LanguageServerProtocol::SignatureHelpParams& args);
     LanguageServerResult<List<LanguageServerProtocol::DocumentSymbol>> documentSymbol(
         const LanguageServerProtocol::DocumentSymbolParams& args);
+    LanguageServerResult<List<LanguageServerProtocol::SymbolInformation>> workspaceSymbol(
+        const LanguageServerProtocol::WorkspaceSymbolParams& args);
     LanguageServerResult<List<LanguageServerProtocol::InlayHint>> inlayHint(
         const LanguageServerProtocol::InlayHintParams& args);
     LanguageServerResult<List<LanguageServerProtocol::TextEdit>> formatting(
@@ -149,6 +171,8 @@ public:
 
 private:
     slang::IGlobalSession* getOrCreateGlobalSession();
+    LanguageServerResult<LanguageServerProtocol::SemanticTokens> computeSemanticTokens(
+        const String& uri);
 
     FormatOptions getFormatOptions(Workspace* workspace, FormatOptions inOptions);
     LanguageServerResult<LanguageServerProtocol::Hover> tryGetMacroHoverInfo(
@@ -165,6 +189,10 @@ private:
         WorkspaceVersion* version,
         DocumentVersion* doc,
         Index line);
+    LanguageServerResult<List<LanguageServerProtocol::Location>> tryGotoIndexedSymbol(
+        DocumentVersion* doc,
+        Index line,
+        Index col);
 };
 
 class LanguageServer
@@ -219,12 +247,18 @@ public:
     SlangResult semanticTokens(
         const LanguageServerProtocol::SemanticTokensParams& args,
         const JSONValue& responseId);
+    SlangResult semanticTokensDelta(
+        const LanguageServerProtocol::SemanticTokensDeltaParams& args,
+        const JSONValue& responseId);
     SlangResult signatureHelp(
         const LanguageServerProtocol::SignatureHelpParams& args,
         const JSONValue& responseId);
     SlangResult documentSymbol(
         const LanguageServerProtocol::DocumentSymbolParams& args,
         const JSONValue& responseId);
+    SlangResult workspaceSymbol(
+        const LanguageServerProtocol::WorkspaceSymbolParams& args,
+        const JSONValue& responseId);
     SlangResult inlayHint(
         const LanguageServerProtocol::InlayHintParams& args,
         const JSONValue& responseId);
@@ -245,6 +279,7 @@ private:
     void updatePredefinedMacros(const JSONValue& macros);
     void updateSearchPaths(const JSONValue& value);
     void updateSearchInWorkspace(const JSONValue& value);
+    void updateModuleCachePath(const JSONValue& value);
     void updateCommitCharacters(const JSONValue& value);
     void updateFormattingOptions(
         const JSONValue& clangFormatLoc,
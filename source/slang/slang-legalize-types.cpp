@@ -1390,12 +1390,22 @@ LegalType legalizeTypeImpl(TypeLegalizationContext* context, IRType* type)
 
 LegalType legalizeType(TypeLegalizationContext* context, IRType* type)
 {
+    auto& counts = context->module->getTypeLegalizationCounts();
+
     LegalType legalType;
     if (context->mapTypeToLegalType.tryGetValue(type, legalType))
+    {
+        counts.cacheHits++;
         return legalType;
+    }
 
     legalType = legalizeTypeImpl(context, type);
     context->mapTypeToLegalType[type] = legalType;
+
+    counts.legalizedTypes++;
+    if (legalType.flavor != LegalType::Flavor::simple &&
+        legalType.flavor != LegalType::Flavor::none)
+        counts.expandedTypes++;
     return legalType;
 }
 
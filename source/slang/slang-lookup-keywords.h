@@ -0,0 +1,60 @@
+#pragma once
+
+#include "../core/slang-string.h"
+
+namespace Slang
+{
+
+// Keywords that are recognized by their text alone, rather than by looking up a `SyntaxDecl`.
+// The lookups are perfect hashes generated at build time by `slang-lookup-generator`, from the
+// word lists in `slang-stmt-keywords.txt` and `slang-preprocessor-directives.txt`.
+
+/// Keywords that start a statement
+enum class StmtKeyword
+{
+    If,
+    For,
+    While,
+    Do,
+    Break,
+    Continue,
+    Return,
+    Discard,
+    Switch,
+    TargetSwitch,
+    IntrinsicAsm,
+    Case,
+    Default,
+    GPUForeach,
+    Try,
+};
+
+bool lookupStmtKeyword(const UnownedStringSlice& str, StmtKeyword& value);
+
+/// Names of preprocessor directives
+enum class PreprocessorDirectiveKind
+{
+    If,
+    IfDef,
+    IfNDef,
+    Else,
+    Elif,
+    EndIf,
+    Include,
+    Define,
+    Undef,
+    Warning,
+    Error,
+    Line,
+    Pragma,
+    Version,
+    Extension,
+
+    CountOf,
+};
+
+bool lookupPreprocessorDirectiveKind(
+    const UnownedStringSlice& str,
+    PreprocessorDirectiveKind& value);
+
+} // namespace Slang
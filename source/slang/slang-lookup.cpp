@@ -1068,6 +1068,37 @@ LookupResult lookUp(
     return result;
 }
 
+/// Can the result of looking up a member in `type` be reused for later lookups?
+///
+/// Declarations in the module being checked can still gain members (for example
+/// synthesized constructors and conformances), so a lookup is only cached if every
+/// facet of `type` comes from another module.
+///
+static bool _canCacheMemberLookup(SemanticsVisitor* semantics, Type* type)
+{
+    // An implicit dereference looks up members in another type.
+    if (getPointedToTypeIfCanImplicitDeref(type))
+        return false;
+
+    auto shared = semantics->getShared();
+    auto module = shared->getModule();
+    if (!module)
+        return false;
+
+    // The inheritance info is empty while it is being computed.
+    auto inheritanceInfo = shared->getInheritanceInfo(type->getCanonicalType());
+    if (inheritanceInfo.facets.isEmpty())
+        return false;
+
+    for (auto facet : inheritanceInfo.facets)
+    {
+        auto decl = facet.getImpl()->getDeclRef().getDecl();
+        if (!decl || getModuleDecl(decl) == module->getModuleDecl())
+            return false;
+    }
+    return true;
+}
+
 LookupResult lookUpMember(
     ASTBuilder* astBuilder,
     SemanticsVisitor* semantics,
@@ -1079,7 +1110,24 @@ LookupResult lookUpMember(
 {
     LookupResult result;
     LookupRequest request = initLookupRequest(semantics, name, mask, options, sourceScope, nullptr);
+
+    // The same members are looked up in the same types many times over (swizzles,
+    // methods of resources, operators), so results are cached on the shared context.
+    // Member lookup doesn't depend on `sourceScope`, so it isn't part of the key.
+    //
+    const bool canUseCache =
+        semantics && !request.isCompletionRequest() && as<DeclRefType>(type) != nullptr;
+    SharedSemanticsContext::MemberLookupKey key = {type, name, mask, request.options};
+    if (canUseCache)
+    {
+        if (auto cachedResult = semantics->getShared()->tryGetMemberLookupResult(key))
+            return *cachedResult;
+    }
+
     _lookUpMembersInType(astBuilder, name, type, request, result, nullptr);
+
+    if (canUseCache && _canCacheMemberLookup(semantics, type))
+        semantics->getShared()->cacheMemberLookupResult(key, result);
     return result;
 }
 
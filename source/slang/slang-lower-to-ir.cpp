@@ -490,6 +490,10 @@ struct SharedIRGenContext
     Dictionary<SourceFile*, IRInst*> mapSourceFileToDebugSourceInst;
     Dictionary<String, IRInst*> mapSourcePathToDebugSourceInst;
 
+    // The mangled forms of declarations and types, shared by the linkage names
+    // of everything lowered.
+    ManglingCache manglingCache;
+
     void setGlobalValue(Decl* decl, LoweredValInfo value)
     {
         globalEnv.mapDeclToValue[decl] = value;
@@ -515,6 +519,9 @@ struct SharedIRGenContext
     ModuleDecl* m_mainModuleDecl = nullptr;
     Linkage* m_linkage = nullptr;
 
+    // Functions of the module whose bodies were never checked, which are not lowered.
+    HashSet<Decl*> const* m_declsWithUncheckedBodies = nullptr;
+
     // List of all string literals used in user code, regardless
     // of how they were used (i.e., whether or not they were hashed).
     //
@@ -1391,7 +1398,8 @@ static void addLinkageDecoration(
 
 static void addLinkageDecoration(IRGenContext* context, IRInst* inst, Decl* decl)
 {
-    const String mangledName = getMangledName(context->astBuilder, decl);
+    const String mangledName =
+        getMangledName(context->astBuilder, decl, &context->shared->manglingCache);
 
     // Obfuscate the mangled names if necessary.
     //
@@ -7784,7 +7792,8 @@ struct DeclLoweringVisitor : DeclVisitor<DeclLoweringVisitor, LoweredValInfo>
                         auto mangledName = getMangledNameForConformanceWitness(
                             subContext->astBuilder,
                             astReqWitnessTable->witnessedType,
-                            astReqWitnessTable->baseType);
+                            astReqWitnessTable->baseType,
+                            &subContext->shared->manglingCache);
                         subBuilder->addExportDecoration(
                             irSatisfyingWitnessTable,
                             mangledName.getUnownedSlice());
@@ -7888,8 +7897,11 @@ struct DeclLoweringVisitor : DeclVisitor<DeclLoweringVisitor, LoweredValInfo>
         // on the type that is conforming, and the type that it conforms to.
         //
         // TODO: This approach doesn't really make sense for generic `extension` conformances.
-        auto mangledName =
-            getMangledNameForConformanceWitness(context->astBuilder, subType, superType);
+        auto mangledName = getMangledNameForConformanceWitness(
+            context->astBuilder,
+            subType,
+            superType,
+            &context->shared->manglingCache);
 
 
         // A witness table may need to be generic, if the outer
@@ -8997,6 +9009,11 @@ struct DeclLoweringVisitor : DeclVisitor<DeclLoweringVisitor, LoweredValInfo>
                 subBuilder->addNonCopyableTypeDecoration(irAggType);
             else if (as<AutoDiffBuiltinAttribute>(modifier))
                 subBuilder->addAutoDiffBuiltinDecoration(irAggType);
+            else if (auto weightAttr = as<DispatchWeightAttribute>(modifier))
+                subBuilder->addDecoration(
+                    irAggType,
+                    kIROp_DispatchWeightDecoration,
+                    subBuilder->getIntValue(subBuilder->getIntType(), weightAttr->weight));
         }
 
 
@@ -10377,6 +10394,13 @@ struct DeclLoweringVisitor : DeclVisitor<DeclLoweringVisitor, LoweredValInfo>
                         getBuilder()->getIntType(),
                         attr->sideEffectBehavior));
             }
+            else if (auto policyAttr = as<CheckpointPolicyAttribute>(modifier))
+            {
+                getBuilder()->addDecoration(
+                    irFunc,
+                    kIROp_CheckpointPolicyDecoration,
+                    getBuilder()->getIntValue(getBuilder()->getIntType(), policyAttr->policy));
+            }
             else if (auto extensionMod = as<RequiredGLSLExtensionModifier>(modifier))
                 getBuilder()->addRequireGLSLExtensionDecoration(
                     irFunc,
@@ -11115,6 +11139,10 @@ static void lowerProgramEntryPointToIR(
 /// Ensure that `decl` and all relevant declarations under it get emitted.
 static void ensureAllDeclsRec(IRGenContext* context, Decl* decl)
 {
+    if (context->shared->m_declsWithUncheckedBodies &&
+        context->shared->m_declsWithUncheckedBodies->contains(decl))
+        return;
+
     ensureDecl(context, decl);
 
     // Note: We are checking here for aggregate type declarations, and
@@ -11171,6 +11199,8 @@ RefPtr<IRModule> generateIRForTranslationUnit(
         translationUnit->getModuleDecl(),
         translationUnit->compileRequest->getLinkage());
     SharedIRGenContext* sharedContext = &sharedContextStorage;
+    sharedContext->m_declsWithUncheckedBodies =
+        &translationUnit->getModule()->getDeclsWithUncheckedBodies();
 
     IRGenContext contextStorage(sharedContext, astBuilder);
     IRGenContext* context = &contextStorage;
@@ -11698,8 +11728,20 @@ RefPtr<IRModule> generateIRForTypeConformance(
 
 RefPtr<IRModule> TargetProgram::getOrCreateIRModuleForLayout(DiagnosticSink* sink)
 {
-    getOrCreateLayout(sink);
-    return m_irModuleForLayout;
+    if (m_irModuleForLayout)
+        return m_irModuleForLayout;
+
+    // In reflection-only mode no IR was generated for the modules of the
+    // program, so there is nothing that the layout could be attached to.
+    if (getOptionSet().getBoolOption(CompilerOptionName::ReflectionOnly))
+    {
+        sink->diagnose(SourceLoc(), Diagnostics::codeGenUnavailableInReflectionOnlyMode);
+        return nullptr;
+    }
+
+    if (!getOrCreateLayout(sink))
+        return nullptr;
+    return createIRModuleForLayout(sink);
 }
 
 /// Specialized IR generation context for when generating IR for layouts.
@@ -8,14 +8,39 @@ namespace Slang
 {
 struct ManglingContext
 {
-    ManglingContext(ASTBuilder* inAstBuilder)
-        : astBuilder(inAstBuilder)
+    ManglingContext(ASTBuilder* inAstBuilder, ManglingCache* inCache = nullptr)
+        : astBuilder(inAstBuilder), cache(inCache)
     {
     }
     ASTBuilder* astBuilder;
+    ManglingCache* cache;
     StringBuilder sb;
 };
 
+// Append the mangled form of `key` from `cachedForms` if it is there. Otherwise
+// produce it with `emitFunc`, and remember it.
+template<typename K, typename F>
+static void _emitCached(
+    ManglingContext* context,
+    Dictionary<K, String>& cachedForms,
+    K key,
+    const F& emitFunc)
+{
+    if (auto cachedForm = cachedForms.tryGetValue(key))
+    {
+        context->sb.append(*cachedForm);
+        return;
+    }
+
+    const Index start = context->sb.getLength();
+    emitFunc();
+    cachedForms.set(
+        key,
+        String(UnownedStringSlice(
+            context->sb.getBuffer() + start,
+            context->sb.getLength() - start)));
+}
+
 void emitRaw(ManglingContext* context, char const* text)
 {
     context->sb.append(text);
@@ -194,7 +219,19 @@ void emitBaseType(ManglingContext* context, BaseType baseType)
     }
 }
 
+static void _emitTypeImpl(ManglingContext* context, Type* type);
+
 void emitType(ManglingContext* context, Type* type)
+{
+    if (context->cache && type)
+    {
+        _emitCached(context, context->cache->types, type, [&]() { _emitTypeImpl(context, type); });
+        return;
+    }
+    _emitTypeImpl(context, type);
+}
+
+static void _emitTypeImpl(ManglingContext* context, Type* type)
 {
     // TODO: actually implement this bit...
 
@@ -386,7 +423,31 @@ void emitVal(ManglingContext* context, Val* val)
     }
 }
 
+static void _emitQualifiedNameImpl(
+    ManglingContext* context,
+    DeclRef<Decl> declRef,
+    bool includeModuleName);
+
 void emitQualifiedName(ManglingContext* context, DeclRef<Decl> declRef, bool includeModuleName)
+{
+    if (context->cache && declRef.declRefBase)
+    {
+        auto& cachedForms = includeModuleName ? context->cache->qualifiedNames
+                                              : context->cache->qualifiedNamesWithoutModule;
+        _emitCached(
+            context,
+            cachedForms,
+            declRef.declRefBase,
+            [&]() { _emitQualifiedNameImpl(context, declRef, includeModuleName); });
+        return;
+    }
+    _emitQualifiedNameImpl(context, declRef, includeModuleName);
+}
+
+static void _emitQualifiedNameImpl(
+    ManglingContext* context,
+    DeclRef<Decl> declRef,
+    bool includeModuleName)
 {
     if (!includeModuleName)
     {
@@ -748,42 +809,50 @@ void mangleName(ManglingContext* context, DeclRef<Decl> declRef)
     emitQualifiedName(context, declRef, true);
 }
 
-static String getMangledName(ASTBuilder* astBuilder, DeclRef<Decl> const& declRef)
+static String getMangledName(
+    ASTBuilder* astBuilder,
+    DeclRef<Decl> const& declRef,
+    ManglingCache* cache)
 {
     SLANG_AST_BUILDER_RAII(astBuilder);
-    ManglingContext context(astBuilder);
+    ManglingContext context(astBuilder, cache);
     mangleName(&context, declRef);
     return context.sb.produceString();
 }
 
-String getMangledName(ASTBuilder* astBuilder, DeclRefBase* declRef)
+String getMangledName(ASTBuilder* astBuilder, DeclRefBase* declRef, ManglingCache* cache)
 {
     SLANG_AST_BUILDER_RAII(astBuilder);
 
-    return getMangledName(astBuilder, DeclRef<Decl>(declRef));
+    return getMangledName(astBuilder, DeclRef<Decl>(declRef), cache);
 }
 
-String getMangledName(ASTBuilder* astBuilder, Decl* decl)
+String getMangledName(ASTBuilder* astBuilder, Decl* decl, ManglingCache* cache)
 {
     SLANG_AST_BUILDER_RAII(astBuilder);
 
-    return getMangledName(astBuilder, makeDeclRef(decl));
+    return getMangledName(astBuilder, makeDeclRef(decl), cache);
 }
 
 String getMangledNameForConformanceWitness(
     ASTBuilder* astBuilder,
     DeclRef<Decl> sub,
-    DeclRef<Decl> sup)
+    DeclRef<Decl> sup,
+    ManglingCache* cache)
 {
     SLANG_AST_BUILDER_RAII(astBuilder);
-    ManglingContext context(astBuilder);
+    ManglingContext context(astBuilder, cache);
     emitRaw(&context, "_SW");
     emitQualifiedName(&context, sub, true);
     emitQualifiedName(&context, sup, true);
     return context.sb.produceString();
 }
 
-String getMangledNameForConformanceWitness(ASTBuilder* astBuilder, DeclRef<Decl> sub, Type* sup)
+String getMangledNameForConformanceWitness(
+    ASTBuilder* astBuilder,
+    DeclRef<Decl> sub,
+    Type* sup,
+    ManglingCache* cache)
 {
     SLANG_AST_BUILDER_RAII(astBuilder);
     // The mangled form for a witness that `sub`
@@ -791,14 +860,18 @@ String getMangledNameForConformanceWitness(ASTBuilder* astBuilder, DeclRef<Decl>
     //
     //     {Conforms(sub,sup)} => _SW{sub}{sup}
     //
-    ManglingContext context(astBuilder);
+    ManglingContext context(astBuilder, cache);
     emitRaw(&context, "_SW");
     emitQualifiedName(&context, sub, true);
     emitType(&context, sup);
     return context.sb.produceString();
 }
 
-String getMangledNameForConformanceWitness(ASTBuilder* astBuilder, Type* sub, Type* sup)
+String getMangledNameForConformanceWitness(
+    ASTBuilder* astBuilder,
+    Type* sub,
+    Type* sup,
+    ManglingCache* cache)
 {
     SLANG_AST_BUILDER_RAII(astBuilder);
     // The mangled form for a witness that `sub`
@@ -806,17 +879,17 @@ String getMangledNameForConformanceWitness(ASTBuilder* astBuilder, Type* sub, Ty
     //
     //     {Conforms(sub,sup)} => _SW{sub}{sup}
     //
-    ManglingContext context(astBuilder);
+    ManglingContext context(astBuilder, cache);
     emitRaw(&context, "_SW");
     emitType(&context, sub);
     emitType(&context, sup);
     return context.sb.produceString();
 }
 
-String getMangledTypeName(ASTBuilder* astBuilder, Type* type)
+String getMangledTypeName(ASTBuilder* astBuilder, Type* type, ManglingCache* cache)
 {
     SLANG_AST_BUILDER_RAII(astBuilder);
-    ManglingContext context(astBuilder);
+    ManglingContext context(astBuilder, cache);
     emitRaw(&context, "_ST");
     emitType(&context, type);
     return context.sb.produceString();
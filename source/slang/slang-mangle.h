@@ -10,19 +10,44 @@ namespace Slang
 {
 struct IRSpecialize;
 
-String getMangledName(ASTBuilder* astBuilder, Decl* decl);
-String getMangledName(ASTBuilder* astBuilder, DeclRefBase* declRef);
+/// Remembers the mangled forms of the declarations and types that mangled names are made of,
+/// so that the parts shared by many names (such as the names of enclosing declarations and of
+/// common types) are only produced once.
+///
+/// The mangled form of a declaration can only be remembered once it has been checked, so a
+/// cache should only be used after semantic checking, such as while lowering to IR.
+struct ManglingCache
+{
+    Dictionary<DeclRefBase*, String> qualifiedNames;
+    Dictionary<DeclRefBase*, String> qualifiedNamesWithoutModule;
+    Dictionary<Type*, String> types;
+};
+
+String getMangledName(ASTBuilder* astBuilder, Decl* decl, ManglingCache* cache = nullptr);
+String getMangledName(
+    ASTBuilder* astBuilder,
+    DeclRefBase* declRef,
+    ManglingCache* cache = nullptr);
 String getMangledNameFromNameString(const UnownedStringSlice& name);
 
 String getHashedName(const UnownedStringSlice& mangledName);
 
-String getMangledNameForConformanceWitness(ASTBuilder* astBuilder, Type* sub, Type* sup);
+String getMangledNameForConformanceWitness(
+    ASTBuilder* astBuilder,
+    Type* sub,
+    Type* sup,
+    ManglingCache* cache = nullptr);
+String getMangledNameForConformanceWitness(
+    ASTBuilder* astBuilder,
+    DeclRef<Decl> sub,
+    DeclRef<Decl> sup,
+    ManglingCache* cache = nullptr);
 String getMangledNameForConformanceWitness(
     ASTBuilder* astBuilder,
     DeclRef<Decl> sub,
-    DeclRef<Decl> sup);
-String getMangledNameForConformanceWitness(ASTBuilder* astBuilder, DeclRef<Decl> sub, Type* sup);
-String getMangledTypeName(ASTBuilder* astBuilder, Type* type);
+    Type* sup,
+    ManglingCache* cache = nullptr);
+String getMangledTypeName(ASTBuilder* astBuilder, Type* type, ManglingCache* cache = nullptr);
 } // namespace Slang
 
 #endif
@@ -339,6 +339,13 @@ void initCommandOptions(CommandOptions& options)
          "-depfile",
          "-depfile <path>",
          "Save the source file dependency list in a file."},
+        {OptionKind::InputManifest,
+         "-input-manifest",
+         "-input-manifest <path>",
+         "Save a JSON manifest of every input of the compile to a file: the files read with the "
+         "SHA-1 of their contents, the paths searched that didn't exist, and the versions of the "
+         "compiler and the downstream compilers loaded. A build system can skip compiling again "
+         "while all of them are unchanged."},
         {OptionKind::EntryPointName,
          "-entry",
          "-entry <name>",
@@ -395,6 +402,17 @@ void initCommandOptions(CommandOptions& options)
          "-ignore-capabilities",
          nullptr,
          "Do not warn or error if capabilities are violated"},
+        {OptionKind::LazyImportChecking,
+         "-lazy-import-checking",
+         nullptr,
+         "Skip checking the bodies of private and internal functions in imported modules that "
+         "nothing in the module references. Entry points in those modules must have a "
+         "[shader] attribute."},
+        {OptionKind::LazyImportLowering,
+         "-lazy-import-lowering",
+         nullptr,
+         "Lower an imported module to IR the first time its IR is needed, such as when a "
+         "program using it is linked, instead of when it is loaded."},
         {OptionKind::MinimumSlangOptimization,
          "-minimum-slang-optimization",
          nullptr,
@@ -480,11 +498,49 @@ void initCommandOptions(CommandOptions& options)
          "-report-perf-benchmark",
          nullptr,
          "Reports compiler performance benchmark results."},
+        {OptionKind::ReportPassStats,
+         "-report-pass-stats",
+         nullptr,
+         "Reports the time, instruction counts, function count and IR memory allocated for "
+         "every IR pass run during code generation, as JSON."},
+        {OptionKind::ReportMemory,
+         "-report-memory",
+         nullptr,
+         "Reports the memory used by the ASTs, IR, string pools and generated code of the "
+         "compilation, and the high water marks of its memory use."},
+        {OptionKind::IRInstBudget,
+         "-ir-inst-budget",
+         "-ir-inst-budget <count>",
+         "Warn when the IR of the program being generated has more than <count> instructions "
+         "after an IR pass, naming the pass. Treating warning 41050 as an error stops the "
+         "compilation there."},
+        {OptionKind::IRFuncInstBudget,
+         "-ir-func-inst-budget",
+         "-ir-func-inst-budget <count>",
+         "Warn when a function of the IR being generated has more than <count> instructions "
+         "after an IR pass, naming the function and the pass. Treating warning 41051 as an "
+         "error stops the compilation there."},
+        {OptionKind::SpecializationDepthBudget,
+         "-specialization-depth-budget",
+         "-specialization-depth-budget <depth>",
+         "Report an error instead of specializing a generic when the specialization would "
+         "nest more than <depth> specializations deep, as a generic that specializes "
+         "itself with ever larger arguments does."},
+        {OptionKind::TraceJSONPath,
+         "-trace-json",
+         "-trace-json <file>",
+         "Write a hierarchical trace of the compilation to <file> in the Chrome trace event "
+         "format, for viewing in chrome://tracing or Perfetto."},
         {OptionKind::ReportCheckpointIntermediates,
          "-report-checkpoint-intermediates",
          nullptr,
          "Reports information about checkpoint contexts used for reverse-mode automatic "
          "differentiation."},
+        {OptionKind::ReportUnpromotedVars,
+         "-report-unpromoted-vars",
+         nullptr,
+         "Reports the local variables of struct and array types that are kept in memory in the "
+         "generated code instead of being promoted to registers, and why."},
         {OptionKind::SkipSPIRVValidation,
          "-skip-spirv-validation",
          nullptr,
@@ -528,6 +584,17 @@ void initCommandOptions(CommandOptions& options)
          "-reflection-json",
          "reflection-json <path>",
          "Emit reflection data in JSON format to a file."},
+        {OptionKind::EmitReflectionBlob,
+         "-reflection-blob",
+         "-reflection-blob <path>",
+         "Emit reflection data to a file in the flat binary format of slang-reflection-blob.h, "
+         "which can be read at runtime without the compiler."},
+        {OptionKind::ModuleCachePath,
+         "-module-cache-path",
+         "-module-cache-path <dir>",
+         "Cache the serialized IR of imported modules in <dir>, and reuse a cached module instead "
+         "of recompiling it from source when it is up-to-date with its source files and the "
+         "current compiler options."},
     };
 
 
@@ -579,7 +646,14 @@ void initCommandOptions(CommandOptions& options)
          "<debug-level> is the amount of information, 0..3, unspecified means 2\n"
          "<debug-info-format> specifies a debugging info format\n"
          "It is valid to have multiple -g options, such as a <debug-level> and a "
-         "<debug-info-format>"},
+         "<debug-info-format>\n"
+         "With -g1, SPIR-V debug information only records a line when it changes, and refers "
+         "to source files by path instead of embedding them."},
+        {OptionKind::DebugInfoExternalSource,
+         "-debug-info-external-source",
+         nullptr,
+         "Refer to source files by path in SPIR-V debug information, instead of embedding their "
+         "contents."},
         {OptionKind::LineDirectiveMode,
          "-line-directive-mode",
          "-line-directive-mode <line-directive-mode>",
@@ -591,10 +665,29 @@ void initCommandOptions(CommandOptions& options)
          "-O...",
          "-O<optimization-level>",
          "Set the optimization level."},
+        {OptionKind::TieredJit,
+         "-tiered-jit",
+         nullptr,
+         "For host callable targets compiled through LLVM, first compile the code without "
+         "optimizing it so it can be called sooner, then optimize it on another thread at the "
+         "optimization level. Looking up a function once the optimized code is ready returns "
+         "the optimized function."},
         {OptionKind::Obfuscate,
          "-obfuscate",
          nullptr,
          "Remove all source file information from outputs."},
+        {OptionKind::StripNamesAndDebugInfo,
+         "-strip-names-and-debug-info",
+         nullptr,
+         "Remove the names and debug information from the linked IR, so that neither is carried "
+         "through code generation or appears in the output. The names of shader parameters are "
+         "kept."},
+        {OptionKind::CacheDerivatives,
+         "-cache-derivatives",
+         nullptr,
+         "Keep the derivatives that autodiff makes of functions with linkage, so that the other "
+         "entry points of a program compiled for the same target clone them instead of "
+         "differentiating the functions again."},
         {OptionKind::GLSLForceScalarLayout,
          "-force-glsl-scalar-layout,-fvk-use-scalar-layout",
          nullptr,
@@ -605,6 +698,17 @@ void initCommandOptions(CommandOptions& options)
          "-fvk-use-dx-layout",
          nullptr,
          "Pack members using FXCs member packing rules when targeting GLSL or SPIRV."},
+        {OptionKind::MetalArgumentBufferTier2,
+         "-metal-argument-buffer-tier-2",
+         nullptr,
+         "Lay out the contents of parameter blocks as Metal tier-2 argument buffers when "
+         "targeting Metal, so that reflection reports the byte offset of each field, and a "
+         "block can be bound by writing its fields into one buffer."},
+        {OptionKind::CompactWGSL,
+         "-compact-wgsl",
+         nullptr,
+         "Emit WGSL with short identifiers and without indentation or blank lines, to "
+         "reduce the size of shaders that are delivered to a browser."},
         {OptionKind::VulkanBindShift,
          vkShiftNames.getBuffer(),
          "-fvk-<vulkan-shift>-shift <N> <space>",
@@ -672,6 +776,16 @@ void initCommandOptions(CommandOptions& options)
          "-incomplete-library",
          nullptr,
          "Allow generating code from incomplete libraries with unresolved external functions"},
+        {OptionKind::LinkTimeSpecializationConstants,
+         "-link-time-specialization-constants",
+         nullptr,
+         "Emit link-time constants (`extern static const`) of scalar type that are not provided "
+         "when linking as specialization constants, when generating SPIR-V or GLSL"},
+        {OptionKind::ReflectionOnly,
+         "-reflection-only",
+         nullptr,
+         "Stop compilation after parameter binding, without generating IR, so that only "
+         "reflection information is available. Requests for target code are an error."},
     };
 
     _addOptions(makeConstArrayView(targetOpts), options);
@@ -800,6 +914,11 @@ void initCommandOptions(CommandOptions& options)
          "Serialize the IR between front-end and back-end."},
         {OptionKind::SkipCodeGen, "-skip-codegen", nullptr, "Skip the code generation phase."},
         {OptionKind::ValidateIr, "-validate-ir", nullptr, "Validate the IR between the phases."},
+        {OptionKind::ValidateIrIncremental,
+         "-validate-ir-incremental",
+         nullptr,
+         "Validate the IR between the phases, but only re-validate the functions that changed "
+         "since they were last validated."},
         {OptionKind::VerbosePaths,
          "-verbose-paths",
          nullptr,
@@ -841,6 +960,19 @@ void initCommandOptions(CommandOptions& options)
          "-validate-uniformity",
          nullptr,
          "Perform uniformity validation analysis."},
+        {OptionKind::AggregateUniformAtomics,
+         "-aggregate-uniform-atomics",
+         nullptr,
+         "Replace atomic adds and subtracts of 32-bit integers at an address that uniformity "
+         "analysis finds to be dynamically uniform with a wave reduction and a single atomic from "
+         "one lane. The target must support wave operations."},
+        {OptionKind::InstrumentTiming,
+         "-instrument-timing",
+         "-instrument-timing <buffer-name>",
+         "Add the time spent in each function of user code, and the number of calls to it, to the "
+         "global RWStructuredBuffer<uint> named <buffer-name>. The metadata of the code lists the "
+         "function of each counter. Supported for HLSL (through NVAPI), GLSL, SPIR-V, CUDA and "
+         "CPU targets."},
         {OptionKind::AllowGLSL, "-allow-glsl", nullptr, "Enable GLSL as an input language."},
         {OptionKind::EnableExperimentalPasses,
          "-enable-experimental-passes",
@@ -2111,6 +2243,7 @@ SlangResult OptionsParser::_parse(int argc, char const* const* argv)
         {
         case OptionKind::NoMangle:
         case OptionKind::ValidateUniformity:
+        case OptionKind::AggregateUniformAtomics:
         case OptionKind::AllowGLSL:
         case OptionKind::EnableExperimentalPasses:
         case OptionKind::EmitIr:
@@ -2118,7 +2251,11 @@ SlangResult OptionsParser::_parse(int argc, char const* const* argv)
         case OptionKind::DumpReproOnError:
         case OptionKind::ReportDownstreamTime:
         case OptionKind::ReportPerfBenchmark:
+        case OptionKind::ReportPassStats:
+        case OptionKind::ReportMemory:
         case OptionKind::ReportCheckpointIntermediates:
+        case OptionKind::ReportUnpromotedVars:
+        case OptionKind::TieredJit:
         case OptionKind::SkipSPIRVValidation:
         case OptionKind::DisableSpecialization:
         case OptionKind::DisableDynamicDispatch:
@@ -2134,6 +2271,12 @@ SlangResult OptionsParser::_parse(int argc, char const* const* argv)
         case OptionKind::VulkanEmitReflection:
         case OptionKind::ZeroInitialize:
         case OptionKind::IgnoreCapabilities:
+        case OptionKind::LazyImportChecking:
+        case OptionKind::LazyImportLowering:
+        case OptionKind::DebugInfoExternalSource:
+        case OptionKind::ValidateIrIncremental:
+        case OptionKind::StripNamesAndDebugInfo:
+        case OptionKind::CacheDerivatives:
         case OptionKind::RestrictiveCapabilityCheck:
         case OptionKind::MinimumSlangOptimization:
         case OptionKind::DisableNonEssentialValidations:
@@ -2144,6 +2287,8 @@ SlangResult OptionsParser::_parse(int argc, char const* const* argv)
         case OptionKind::PreprocessorOutput:
         case OptionKind::DumpAst:
         case OptionKind::IncompleteLibrary:
+        case OptionKind::LinkTimeSpecializationConstants:
+        case OptionKind::ReflectionOnly:
         case OptionKind::NoHLSLBinding:
         case OptionKind::NoHLSLPackConstantBufferElements:
         case OptionKind::LoopInversion:
@@ -2522,6 +2667,18 @@ SlangResult OptionsParser::_parse(int argc, char const* const* argv)
                 getCurrentTarget()->optionSet.add(CompilerOptionName::ForceDXLayout, true);
                 break;
             }
+        case OptionKind::MetalArgumentBufferTier2:
+            {
+                getCurrentTarget()->optionSet.add(
+                    CompilerOptionName::MetalArgumentBufferTier2,
+                    true);
+                break;
+            }
+        case OptionKind::CompactWGSL:
+            {
+                getCurrentTarget()->optionSet.add(CompilerOptionName::CompactWGSL, true);
+                break;
+            }
         case OptionKind::EnableEffectAnnotations:
             {
                 m_compileRequest->setEnableEffectAnnotations(true);
@@ -2676,6 +2833,56 @@ SlangResult OptionsParser::_parse(int argc, char const* const* argv)
                 linkage->m_optionSet.set(CompilerOptionName::EmitReflectionJSON, outputPath.value);
                 break;
             }
+        case OptionKind::InstrumentTiming:
+            {
+                CommandLineArg bufferName;
+                SLANG_RETURN_ON_FAIL(m_reader.expectArg(bufferName));
+
+                linkage->m_optionSet.set(CompilerOptionName::InstrumentTiming, bufferName.value);
+                break;
+            }
+        case OptionKind::InputManifest:
+            {
+                CommandLineArg manifestPath;
+                SLANG_RETURN_ON_FAIL(m_reader.expectArg(manifestPath));
+
+                linkage->m_optionSet.set(CompilerOptionName::InputManifest, manifestPath.value);
+                break;
+            }
+        case OptionKind::EmitReflectionBlob:
+            {
+                CommandLineArg outputPath;
+                SLANG_RETURN_ON_FAIL(m_reader.expectArg(outputPath));
+
+                linkage->m_optionSet.set(CompilerOptionName::EmitReflectionBlob, outputPath.value);
+                break;
+            }
+        case OptionKind::ModuleCachePath:
+            {
+                CommandLineArg cachePath;
+                SLANG_RETURN_ON_FAIL(m_reader.expectArg(cachePath));
+
+                linkage->m_optionSet.set(CompilerOptionName::ModuleCachePath, cachePath.value);
+                break;
+            }
+        case OptionKind::TraceJSONPath:
+            {
+                CommandLineArg tracePath;
+                SLANG_RETURN_ON_FAIL(m_reader.expectArg(tracePath));
+
+                linkage->m_optionSet.set(CompilerOptionName::TraceJSONPath, tracePath.value);
+                break;
+            }
+        case OptionKind::IRInstBudget:
+        case OptionKind::IRFuncInstBudget:
+        case OptionKind::SpecializationDepthBudget:
+            {
+                Int budget;
+                SLANG_RETURN_ON_FAIL(_expectInt(arg, budget));
+
+                linkage->m_optionSet.set(optionKind, (int)budget);
+                break;
+            }
         case OptionKind::DepFile:
             {
                 CommandLineArg dependencyPath;
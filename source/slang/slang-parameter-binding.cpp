@@ -407,6 +407,10 @@ struct SharedParameterBindingContext
     // The program layout we are trying to construct
     RefPtr<ProgramLayout> programLayout;
 
+    // The existing layout of the unspecialized program, when laying out a
+    // specialization of it, which parameter type layouts can be reused from.
+    ProgramLayout* baseProgramLayout = nullptr;
+
     // What ranges of resources bindings are already claimed at the global scope?
     // We store one of these for each declared binding space/set.
     //
@@ -773,10 +777,35 @@ static void collectGlobalScopeParameter(
     auto type =
         as<Type>(getType(astBuilder, varDeclRef)->substitute(astBuilder, globalGenericSubst));
 
-    // We use a single operation to both check whether the
-    // variable represents a shader parameter, and to compute
-    // the layout for that parameter's type.
-    auto typeLayout = getTypeLayoutForGlobalShaderParameter(context, varDeclRef.getDecl(), type);
+    // When specialization didn't plug any types into this parameter, the
+    // layout of its type can usually be taken from the unspecialized program.
+    //
+    auto varDecl = varDeclRef.getDecl();
+    const bool isSpecializationIndependent = shaderParamInfo.specializationParamCount == 0;
+    RefPtr<TypeLayout> typeLayout;
+    if (isSpecializationIndependent)
+    {
+        if (auto baseProgramLayout = context->shared->baseProgramLayout)
+            baseProgramLayout->contextFreeParameterTypeLayouts.tryGetValue(varDecl, typeLayout);
+    }
+
+    if (!typeLayout)
+    {
+        // We use a single operation to both check whether the
+        // variable represents a shader parameter, and to compute
+        // the layout for that parameter's type.
+        //
+        bool dependsOnContext = false;
+        auto savedDependsOnContext = context->layoutContext.dependsOnContext;
+        context->layoutContext.dependsOnContext = &dependsOnContext;
+        typeLayout = getTypeLayoutForGlobalShaderParameter(context, varDecl, type);
+        context->layoutContext.dependsOnContext = savedDependsOnContext;
+
+        if (typeLayout && isSpecializationIndependent && !dependsOnContext)
+        {
+            context->shared->programLayout->contextFreeParameterTypeLayouts[varDecl] = typeLayout;
+        }
+    }
 
     // If we did not find appropriate layout rules, then it
     // must mean that this global variable is *not* a shader
@@ -4035,8 +4064,14 @@ RefPtr<ProgramLayout> generateParameterBindings(TargetProgram* targetProgram, Di
 
     {
         auto& pool = programLayout->hashedStringLiteralPool;
-        program->enumerateIRModules([&](IRModule* module)
-                                    { findGlobalHashedStringLiterals(module, pool); });
+        // A module has no IR when it was only checked (in the language server, or
+        // in reflection-only mode), in which case there are no hashed strings to find.
+        program->enumerateIRModules(
+            [&](IRModule* module)
+            {
+                if (module)
+                    findGlobalHashedStringLiterals(module, pool);
+            });
     }
 
     // Try to find rules based on the selected code-generation target
@@ -4056,6 +4091,17 @@ RefPtr<ProgramLayout> generateParameterBindings(TargetProgram* targetProgram, Di
         targetProgram,
         sink);
 
+    // If this is a specialization of a program that has already been laid
+    // out for the same target, we can reuse the parts of that layout that
+    // specialization doesn't change.
+    //
+    if (auto specializedProgram = as<SpecializedComponentType>(program))
+    {
+        auto baseProgram = specializedProgram->getBaseComponentType();
+        sharedContext.baseProgramLayout =
+            baseProgram->getTargetProgram(targetReq)->tryGetExistingLayout();
+    }
+
     // Create a sub-context to collect parameters that get
     // declared into the global scope
     ParameterBindingContext context;
@@ -4379,14 +4425,11 @@ ProgramLayout* TargetProgram::getOrCreateLayout(DiagnosticSink* sink)
 {
     if (!m_layout)
     {
+        // The IR module for the layout is only needed for code generation,
+        // so it is created on demand by `getOrCreateIRModuleForLayout`.
         m_layout = generateParameterBindings(this, sink);
         if (sink->getErrorCount() != 0)
             return nullptr;
-
-        if (m_layout)
-        {
-            m_irModuleForLayout = createIRModuleForLayout(sink);
-        }
     }
     return m_layout;
 }
@@ -2,6 +2,7 @@
 
 #include "../core/slang-semantic-version.h"
 #include "slang-compiler.h"
+#include "slang-lookup-keywords.h"
 #include "slang-lookup-spirv.h"
 #include "slang-lookup.h"
 #include "slang-visitor.h"
@@ -75,11 +76,42 @@ enum Precedence : int
     Postfix,
 };
 
+/// Decisions made by speculatively parsing a `<` as the start of generic arguments.
+///
+/// A decision only depends on the tokens that follow, so it is recorded by position.
+/// Without this, each level of nested generic arguments would be speculated on again
+/// every time an enclosing level is parsed, which takes time exponential in the depth.
+///
+struct GenericAppSpeculations : RefObject
+{
+    struct Key
+    {
+        const Token* cursor;
+        int genericDepth;
+        HashCode getHashCode() const
+        {
+            return combineHash(Slang::getHashCode(cursor), Slang::getHashCode(genericDepth));
+        }
+        bool operator==(const Key& other) const
+        {
+            return cursor == other.cursor && genericDepth == other.genericDepth;
+        }
+    };
+
+    /// Whether the `<` at each position starts generic arguments.
+    Dictionary<Key, bool> isGenericApp;
+};
+
 struct ParserOptions
 {
     bool enableEffectAnnotations = false;
     bool allowGLSLInput = false;
     bool isInLanguageServer = false;
+    // When set, function bodies are only parsed if they contain `cursorLine` of the file at
+    // `cursorFilePath`. Used for completion requests, where no other body gets checked.
+    bool skipBodiesAwayFromCursor = false;
+    String cursorFilePath;
+    Index cursorLine = 0;
     CompilerOptionSet optionSet;
 };
 
@@ -119,6 +151,9 @@ public:
     Modifiers* pendingModifiers = nullptr;
     int genericDepth = 0;
 
+    // Shared with the copies of this parser that are made to speculate.
+    RefPtr<GenericAppSpeculations> genericAppSpeculations = new GenericAppSpeculations();
+
     // Is the parser in a "recovering" state?
     // During recovery we don't emit additional errors, until we find
     // a token that we expected, when we exit recovery.
@@ -1799,6 +1834,57 @@ public:
     void visitExpr(Expr* /*expr*/) {}
 };
 
+/// Skip over a `{}` body that doesn't contain the cursor of a completion request, and
+/// return an empty block statement in its place.
+///
+/// Returns nullptr, without consuming any tokens, if the body should be parsed.
+static Stmt* _trySkipBodyAwayFromCursor(Parser* parser)
+{
+    if (!parser->options.skipBodiesAwayFromCursor)
+        return nullptr;
+    auto& tokenReader = parser->tokenReader;
+    if (tokenReader.peekTokenType() != TokenType::LBrace)
+        return nullptr;
+
+    const auto startCursor = tokenReader.getCursor();
+    const Token openingBrace = tokenReader.advanceToken();
+    while (!tokenReader.isAtEnd() && tokenReader.peekTokenType() != TokenType::RBrace)
+        SkipBalancedToken(&tokenReader);
+    if (tokenReader.isAtEnd())
+    {
+        // Let the regular parser diagnose the unterminated body.
+        tokenReader.setCursor(startCursor);
+        return nullptr;
+    }
+    const Token closingBrace = tokenReader.advanceToken();
+
+    auto sourceManager = parser->sink->getSourceManager();
+    auto openingLoc = sourceManager->getHumaneLoc(openingBrace.loc, SourceLocType::Actual);
+    if (openingLoc.pathInfo.foundPath == parser->options.cursorFilePath)
+    {
+        auto closingLoc = sourceManager->getHumaneLoc(closingBrace.loc, SourceLocType::Actual);
+        if (parser->options.cursorLine >= openingLoc.line &&
+            parser->options.cursorLine <= closingLoc.line)
+        {
+            tokenReader.setCursor(startCursor);
+            return nullptr;
+        }
+    }
+
+    ScopeDecl* scopeDecl = parser->astBuilder->create<ScopeDecl>();
+    BlockStmt* blockStmt = parser->astBuilder->create<BlockStmt>();
+    blockStmt->scopeDecl = scopeDecl;
+    blockStmt->loc = openingBrace.loc;
+    blockStmt->closingSourceLoc = closingBrace.loc;
+    parser->pushScopeAndSetParent(scopeDecl);
+    parser->PopScope();
+
+    auto emptyStmt = parser->astBuilder->create<EmptyStmt>();
+    emptyStmt->loc = openingBrace.loc;
+    blockStmt->body = emptyStmt;
+    return blockStmt;
+}
+
 /// Parse an optional body statement for a declaration that can have a body.
 static Stmt* parseOptBody(Parser* parser)
 {
@@ -1807,6 +1893,10 @@ static Stmt* parseOptBody(Parser* parser)
         // empty body
         return nullptr;
     }
+    else if (auto skippedBody = _trySkipBodyAwayFromCursor(parser))
+    {
+        return skippedBody;
+    }
     else
     {
         return parser->parseBlockStatement();
@@ -2312,10 +2402,12 @@ static Expr* tryParseGenericApp(Parser* parser, Expr* base)
     if (baseName && isGenericName(parser, baseName))
         return parseGenericApp(parser, base);
 
+    // If the same `<` was speculated on before, reuse the decision.
+    GenericAppSpeculations::Key key = {parser->tokenReader.m_cursor, parser->genericDepth};
+    if (auto isGenericApp = parser->genericAppSpeculations->isGenericApp.tryGetValue(key))
+        return *isGenericApp ? parseGenericApp(parser, base) : base;
+
     // otherwise, we speculate as generics, and fallback to comparison when parsing failed
-    TokenSpan tokenSpan;
-    tokenSpan.m_begin = parser->tokenReader.m_cursor;
-    tokenSpan.m_end = parser->tokenReader.m_end;
 
     // Setup without diagnostic lexer, or SourceLocationLine output
     // as this sink is just to *try* generic application
@@ -2326,6 +2418,7 @@ static Expr* tryParseGenericApp(Parser* parser, Expr* base)
 
     /* auto speculateParseRs = */ parseGenericApp(&newParser, base);
 
+    bool isGenericApp = false;
     if (newSink.getErrorCount() == 0)
     {
         // disambiguate based on FOLLOW set
@@ -2344,12 +2437,14 @@ static Expr* tryParseGenericApp(Parser* parser, Expr* base)
         case TokenType::OpNeq:
         case TokenType::OpGreater:
         case TokenType::EndOfFile:
-            {
-                return parseGenericApp(parser, base);
-            }
+            isGenericApp = true;
+            break;
+        default:
+            break;
         }
     }
-    return base;
+    parser->genericAppSpeculations->isGenericApp[key] = isGenericApp;
+    return isGenericApp ? parseGenericApp(parser, base) : base;
 }
 static Expr* parseMemberType(Parser* parser, Expr* base, SourceLoc opLoc)
 {
@@ -5495,59 +5590,80 @@ Stmt* Parser::ParseStatement(Stmt* parentStmt)
 {
     auto modifiers = ParseModifiers(this);
 
+    // Statement keywords are found with a single perfect hash lookup, rather than by comparing
+    // the token with each of them in turn.
+    StmtKeyword keyword = StmtKeyword::If;
+    const bool isKeyword = LookAheadToken(TokenType::Identifier) &&
+                           lookupStmtKeyword(tokenReader.peekToken().getContent(), keyword);
+
     Stmt* statement = nullptr;
     if (LookAheadToken(TokenType::LBrace))
         statement = parseBlockStatement();
-    else if (LookAheadToken("if"))
+    else if (isKeyword)
     {
-        if (LookAheadToken("let", 2))
+        switch (keyword)
         {
-            statement = parseIfLetStatement();
-        }
-        else
-        {
-            statement = parseIfStatement();
+        case StmtKeyword::If:
+            if (LookAheadToken("let", 2))
+            {
+                statement = parseIfLetStatement();
+            }
+            else
+            {
+                statement = parseIfStatement();
+            }
+            break;
+        case StmtKeyword::For:
+            statement = ParseForStatement();
+            break;
+        case StmtKeyword::While:
+            statement = ParseWhileStatement();
+            break;
+        case StmtKeyword::Do:
+            statement = ParseDoWhileStatement();
+            break;
+        case StmtKeyword::Break:
+            statement = ParseBreakStatement();
+            break;
+        case StmtKeyword::Continue:
+            statement = ParseContinueStatement();
+            break;
+        case StmtKeyword::Return:
+            statement = ParseReturnStatement();
+            break;
+        case StmtKeyword::Discard:
+            statement = astBuilder->create<DiscardStmt>();
+            FillPosition(statement);
+            ReadToken("discard");
+            ReadToken(TokenType::Semicolon);
+            break;
+        case StmtKeyword::Switch:
+            statement = ParseSwitchStmt(this);
+            break;
+        case StmtKeyword::TargetSwitch:
+            statement = parseTargetSwitchStmt(this);
+            break;
+        case StmtKeyword::IntrinsicAsm:
+            statement = parseIntrinsicAsmStmt(this);
+            break;
+        case StmtKeyword::Case:
+            statement = ParseCaseStmt(this);
+            break;
+        case StmtKeyword::Default:
+            statement = ParseDefaultStmt(this);
+            break;
+        case StmtKeyword::GPUForeach:
+            statement = ParseGpuForeachStmt(this);
+            break;
+        case StmtKeyword::Try:
+            statement = ParseExpressionStatement();
+            break;
         }
     }
-    else if (LookAheadToken("for"))
-        statement = ParseForStatement();
-    else if (LookAheadToken("while"))
-        statement = ParseWhileStatement();
-    else if (LookAheadToken("do"))
-        statement = ParseDoWhileStatement();
-    else if (LookAheadToken("break"))
-        statement = ParseBreakStatement();
-    else if (LookAheadToken("continue"))
-        statement = ParseContinueStatement();
-    else if (LookAheadToken("return"))
-        statement = ParseReturnStatement();
-    else if (LookAheadToken("discard"))
-    {
-        statement = astBuilder->create<DiscardStmt>();
-        FillPosition(statement);
-        ReadToken("discard");
-        ReadToken(TokenType::Semicolon);
-    }
-    else if (LookAheadToken("switch"))
-        statement = ParseSwitchStmt(this);
-    else if (LookAheadToken("__target_switch"))
-        statement = parseTargetSwitchStmt(this);
-    else if (LookAheadToken("__intrinsic_asm"))
-        statement = parseIntrinsicAsmStmt(this);
-    else if (LookAheadToken("case"))
-        statement = ParseCaseStmt(this);
-    else if (LookAheadToken("default"))
-        statement = ParseDefaultStmt(this);
-    else if (LookAheadToken("__GPU_FOREACH"))
-        statement = ParseGpuForeachStmt(this);
     else if (LookAheadToken(TokenType::Dollar))
     {
         statement = parseCompileTimeStmt(this);
     }
-    else if (LookAheadToken("try"))
-    {
-        statement = ParseExpressionStatement();
-    }
     else if (LookAheadToken(TokenType::Identifier) || LookAheadToken(TokenType::Scope))
     {
         if (LookAheadToken(TokenType::Identifier) && LookAheadToken(TokenType::Colon, 1))
@@ -8080,6 +8196,15 @@ void parseSourceFile(
         sourceLanguage == SourceLanguage::GLSL;
     options.isInLanguageServer =
         translationUnit->compileRequest->getLinkage()->isInLanguageServer();
+    auto& assistInfo = translationUnit->compileRequest->getLinkage()->contentAssistInfo;
+    if (assistInfo.checkingMode == ContentAssistCheckingMode::Completion)
+    {
+        // The checker skips every function body except the one being edited, so there is
+        // no need to build the AST for the others either.
+        options.skipBodiesAwayFromCursor = true;
+        options.cursorFilePath = assistInfo.primaryModulePath;
+        options.cursorLine = assistInfo.cursorLine;
+    }
     options.optionSet = translationUnit->compileRequest->optionSet;
 
     Parser parser(astBuilder, tokens, sink, outerScope, options);
@@ -14,6 +14,7 @@
 #include "../compiler-core/slang-lexer.h"
 #include "slang-compiler.h"
 #include "slang-diagnostics.h"
+#include "slang-lookup-keywords.h"
 
 #include <assert.h>
 
@@ -492,7 +493,12 @@ struct LexerInputStream : InputStream
 {
     typedef InputStream Super;
 
-    LexerInputStream(Preprocessor* preprocessor, SourceView* sourceView);
+    /// Create a stream that lexes `sourceView`, or replays `cachedTokens` (lexed
+    /// from the same file) instead if they are provided.
+    LexerInputStream(
+        Preprocessor* preprocessor,
+        SourceView* sourceView,
+        PreprocessorTokenCache::Entry* cachedTokens);
 
     Lexer* getLexer() { return &m_lexer; }
 
@@ -513,6 +519,17 @@ private:
     /// Read a token from the lexer, bypassing lookahead
     Token _readTokenImpl()
     {
+        if (m_cachedTokens)
+        {
+            // The cached tokens end with an end of file token, which we keep returning once
+            // it is reached, just like the lexer would.
+            Token token = m_cachedTokens->tokens[m_cachedTokenIndex];
+            if (token.type != TokenType::EndOfFile)
+                m_cachedTokenIndex++;
+            token.loc = m_lexer.m_startLoc + Int(token.loc.getRaw());
+            return token;
+        }
+
         for (;;)
         {
             Token token = m_lexer.lexToken();
@@ -532,6 +549,10 @@ private:
     /// The lexer state that will provide input
     Lexer m_lexer;
 
+    /// If set, the cached tokens of the file to replay instead of using the lexer
+    RefPtr<PreprocessorTokenCache::Entry> m_cachedTokens;
+    Index m_cachedTokenIndex = 0;
+
     /// One token of lookahead
     Token m_lookaheadToken;
 };
@@ -638,6 +659,9 @@ struct MacroDefinition
     /// Parameters of the macro, in case of a function-like macro
     List<Param> params;
 
+    /// Was the macro defined by the `defines` given to the preprocessor (e.g., via `-D`)?
+    bool isFromDefines = false;
+
     Name* getName() { return nameAndLoc.name; }
 
     SourceLoc getLoc() { return nameAndLoc.loc; }
@@ -728,6 +752,13 @@ private:
     /// Arguments to the macro, in the case of a function-like macro expansion
     List<Arg> m_args;
 
+    /// The fully macro-expanded tokens of each argument, filled in on first use
+    ///
+    /// Each list is terminated with an end-of-file token, so that a `TokenReader`
+    /// can play it back. An empty list means the argument hasn't been expanded yet.
+    ///
+    List<List<Token>> m_expandedArgTokens;
+
     /// Additional macros that should be considered "busy" during this expansion
     MacroInvocation* m_nextBusyMacroInvocation = nullptr;
 
@@ -760,6 +791,9 @@ private:
     /// Get a reader for the tokens that make up the macro argument at the given `paramIndex`
     TokenReader _getArgTokens(Index paramIndex);
 
+    /// Get a reader for the macro-expanded tokens of the argument at the given `paramIndex`
+    TokenReader _getExpandedArgTokens(Index paramIndex);
+
     /// Push a stream onto `m_currentOpStreams` that consists of a single token
     void _pushSingleTokenStream(
         TokenType tokenType,
@@ -927,9 +961,44 @@ struct InputFile
 
     bool isIncludedFile() { return m_parent != nullptr; }
 
+    /// Note that the inner-most conditional was just opened by `#ifndef macroName`.
+    void noteIfNDef(Name* macroName);
+
+    /// Note that a `#else` or `#elif` (or a `#endif`, if `isEnd`) was read
+    /// for the inner-most conditional.
+    void noteConditionalBranch(bool isEnd);
+
+    /// Note that a token or directive was read outside of any conditional.
+    void noteTokenOutsideConditionals();
+
+    /// Get the macro of the include guard that wraps the whole file, or null if the
+    /// file (as read so far) isn't wrapped in one.
+    Name* getIncludeGuardName()
+    {
+        return m_includeGuardState == IncludeGuardState::AfterGuard ? m_includeGuardName : nullptr;
+    }
+
 private:
     friend struct Preprocessor;
 
+    /// State for detecting whether the file is wrapped in an include guard:
+    /// `#ifndef NAME` ... `#endif`, with only whitespace and comments outside it.
+    enum class IncludeGuardState
+    {
+        Start,      ///< Nothing has been read yet
+        InGuard,    ///< Inside the conditional opened by the guard's `#ifndef`
+        AfterGuard, ///< The guard's `#endif` has been read
+        NotGuarded, ///< The file doesn't fit the idiom
+    };
+
+    IncludeGuardState m_includeGuardState = IncludeGuardState::Start;
+
+    /// The macro named by the guard's `#ifndef`
+    Name* m_includeGuardName = nullptr;
+
+    /// The conditional opened by the guard's `#ifndef`
+    Conditional* m_includeGuardConditional = nullptr;
+
     /// The parent preprocessor
     Preprocessor* m_preprocessor = nullptr;
 
@@ -981,6 +1050,15 @@ struct Preprocessor
     /// stop them from being included again.
     HashSet<String> pragmaOnceUniqueIdentities;
 
+    /// The unique identities of any paths that are wrapped in an include guard, and the macro
+    /// of the guard. They don't need to be included again while the macro is defined.
+    Dictionary<String, Name*> includeGuardedUniqueIdentities;
+
+    /// The names of macros that were looked up while they were either undefined or
+    /// defined by the `defines` given to the preprocessor. The output of the preprocessor
+    /// only depends on the `defines` for these names.
+    HashSet<Name*> defineDependencies;
+
     /// Name pool to use when creating `Name`s from strings
     NamePool* namePool = nullptr;
 
@@ -999,6 +1077,9 @@ struct Preprocessor
     /// Stores macro definition and invocation info for language server.
     PreprocessorContentAssistInfo* contentAssistInfo = nullptr;
 
+    /// Cache of lexed tokens shared with other preprocessor invocations, if any.
+    PreprocessorTokenCache* tokenCache = nullptr;
+
     NamePool* getNamePool() { return namePool; }
     SourceManager* getSourceManager() { return sourceManager; }
 
@@ -1073,9 +1154,14 @@ DiagnosticSink* InputStream::getSink()
 // Basic Input Handling
 //
 
-LexerInputStream::LexerInputStream(Preprocessor* preprocessor, SourceView* sourceView)
-    : Super(preprocessor)
+LexerInputStream::LexerInputStream(
+    Preprocessor* preprocessor,
+    SourceView* sourceView,
+    PreprocessorTokenCache::Entry* cachedTokens)
+    : Super(preprocessor), m_cachedTokens(cachedTokens)
 {
+    // The lexer is initialized even when replaying cached tokens, since it is still
+    // used to find the source view of the file.
     MemoryArena* memoryArena = sourceView->getSourceManager()->getMemoryArena();
     m_lexer.initialize(sourceView, GetSink(preprocessor), preprocessor->getNamePool(), memoryArena);
     m_lookaheadToken = _readTokenImpl();
@@ -1085,7 +1171,11 @@ InputFile::InputFile(Preprocessor* preprocessor, SourceView* sourceView)
 {
     m_preprocessor = preprocessor;
 
-    m_lexerStream = new LexerInputStream(preprocessor, sourceView);
+    PreprocessorTokenCache::Entry* cachedTokens = nullptr;
+    if (auto tokenCache = preprocessor->tokenCache)
+        cachedTokens = tokenCache->findOrLexTokens(sourceView, preprocessor->getNamePool());
+
+    m_lexerStream = new LexerInputStream(preprocessor, sourceView, cachedTokens);
     m_expansionStream = new ExpansionInputStream(preprocessor, m_lexerStream);
 }
 
@@ -1128,6 +1218,16 @@ static MacroDefinition* LookupMacro(Environment* environment, Name* name)
     return NULL;
 }
 
+// Find the currently-defined macro of the given name in the global environment,
+// noting if the result depends on the `defines` given to the preprocessor.
+static MacroDefinition* LookupMacro(Preprocessor* preprocessor, Name* name)
+{
+    MacroDefinition* macro = LookupMacro(&preprocessor->globalEnv, name);
+    if (!macro || macro->isFromDefines)
+        preprocessor->defineDependencies.add(name);
+    return macro;
+}
+
 bool MacroInvocation::isBusy(MacroDefinition* macro, MacroInvocation* duringMacroInvocation)
 {
     for (auto busyMacroInvocation = duringMacroInvocation; busyMacroInvocation;
@@ -1360,7 +1460,7 @@ void ExpansionInputStream::_maybeBeginMacroInvocation()
         // invocation.
         //
         Name* name = token.getName();
-        MacroDefinition* macro = LookupMacro(&preprocessor->globalEnv, name);
+        MacroDefinition* macro = LookupMacro(preprocessor, name);
         if (!macro)
         {
             return;
@@ -2052,6 +2152,45 @@ TokenReader MacroInvocation::_getArgTokens(Index paramIndex)
     }
 }
 
+TokenReader MacroInvocation::_getExpandedArgTokens(Index paramIndex)
+{
+    // A parameter may be referenced any number of times in the body of a macro,
+    // but the expansion of its argument doesn't depend on where it is referenced:
+    // the argument tokens are played back in isolation, with no macros busy.
+    // We therefore expand each argument at most once per invocation, and play
+    // back the result for every reference after the first.
+    //
+    // The outer list is sized up front so that the buffers of the inner lists
+    // never move while a reader for one of them is in flight.
+    //
+    if (m_expandedArgTokens.getCount() == 0)
+        m_expandedArgTokens.setCount(m_macro->params.getCount());
+
+    auto& expandedTokens = m_expandedArgTokens[paramIndex];
+    if (expandedTokens.getCount() == 0)
+    {
+        PretokenizedInputStream* stream =
+            new PretokenizedInputStream(m_preprocessor, _getArgTokens(paramIndex));
+        ExpansionInputStream* expansion = new ExpansionInputStream(m_preprocessor, stream);
+        expansion->setInitiatingMacroSourceLoc(m_initiatingMacroInvocationLoc);
+
+        // The end-of-file token is kept as well, both to terminate the list
+        // and so that its location is the one the argument tokens would give.
+        //
+        for (;;)
+        {
+            Token token = expansion->readToken();
+            expandedTokens.add(token);
+            if (token.type == TokenType::EndOfFile)
+                break;
+        }
+        delete expansion;
+    }
+
+    auto tokens = expandedTokens.getBuffer();
+    return TokenReader(tokens, tokens + expandedTokens.getCount() - 1);
+}
+
 void MacroInvocation::_initCurrentOpStream()
 {
     // The job of this function is to make sure that `m_currentOpStreams` is set up
@@ -2119,20 +2258,15 @@ void MacroInvocation::_initCurrentOpStream()
         {
             // Most uses of a macro parameter will be subject to macro expansion.
             //
-            // The initial logic here is similar to the unexpanded case above.
+            // The logic here is similar to the unexpanded case above, except that
+            // the tokens played back are those of the argument after macro expansion
+            // has been applied to it (which is only done once per argument).
             //
             Index paramIndex = op.index1;
-            auto tokenReader = _getArgTokens(paramIndex);
+            auto tokenReader = _getExpandedArgTokens(paramIndex);
             PretokenizedInputStream* stream =
                 new PretokenizedInputStream(m_preprocessor, tokenReader);
-
-            // The only interesting addition to the unexpanded case is that we wrap
-            // the stream that "plays back" the argument tokens with a stream that
-            // applies macro expansion to them.
-            //
-            ExpansionInputStream* expansion = new ExpansionInputStream(m_preprocessor, stream);
-            expansion->setInitiatingMacroSourceLoc(m_initiatingMacroInvocationLoc);
-            m_currentOpStreams.push(expansion);
+            m_currentOpStreams.push(stream);
         }
         break;
 
@@ -2323,8 +2457,7 @@ static SourceLoc PeekLoc(PreprocessorDirectiveContext* context)
 // Wrapper to look up a macro in the context of a directive.
 static MacroDefinition* LookupMacro(PreprocessorDirectiveContext* context, Name* name)
 {
-    auto preprocessor = context->m_preprocessor;
-    return LookupMacro(&preprocessor->globalEnv, name);
+    return LookupMacro(context->m_preprocessor, name);
 }
 
 // Determine if we have read everything on the directive's line.
@@ -2446,6 +2579,36 @@ static bool Expect(
 // Preprocessor Conditionals
 //
 
+void InputFile::noteIfNDef(Name* macroName)
+{
+    // Only a `#ifndef` that is the first thing in the file can start an include guard.
+    if (m_includeGuardState != IncludeGuardState::Start || m_conditional->parent)
+        return;
+
+    m_includeGuardState = IncludeGuardState::InGuard;
+    m_includeGuardName = macroName;
+    m_includeGuardConditional = m_conditional;
+}
+
+void InputFile::noteConditionalBranch(bool isEnd)
+{
+    if (m_includeGuardState != IncludeGuardState::InGuard ||
+        m_conditional != m_includeGuardConditional)
+        return;
+
+    // An include guard can't have a `#else` or `#elif` branch.
+    m_includeGuardState = isEnd ? IncludeGuardState::AfterGuard : IncludeGuardState::NotGuarded;
+    m_includeGuardConditional = nullptr;
+}
+
+void InputFile::noteTokenOutsideConditionals()
+{
+    // The only thing allowed outside of a conditional is the `#ifndef` of the guard,
+    // which will have moved us into the `InGuard` state.
+    if (m_includeGuardState != IncludeGuardState::InGuard)
+        m_includeGuardState = IncludeGuardState::NotGuarded;
+}
+
 bool InputFile::isSkipping()
 {
     // If we are not inside a preprocessor conditional, then don't skip
@@ -2950,6 +3113,8 @@ static void HandleIfNDefDirective(PreprocessorDirectiveContext* context)
 
     // Check if the name is defined.
     beginConditional(context, LookupMacro(context, name) == NULL);
+
+    getInputFile(context)->noteIfNDef(name);
 }
 
 // Handle a `#else` directive
@@ -2980,6 +3145,7 @@ static void HandleElseDirective(PreprocessorDirectiveContext* context)
         return;
     }
     conditional->elseToken = context->m_directiveToken;
+    inputFile->noteConditionalBranch(false);
 
     switch (conditional->state)
     {
@@ -3044,6 +3210,8 @@ static void HandleElifDirective(PreprocessorDirectiveContext* context)
         return;
     }
 
+    inputFile->noteConditionalBranch(false);
+
     switch (conditional->state)
     {
     case Conditional::State::Before:
@@ -3091,6 +3259,7 @@ static void HandleEndIfDirective(PreprocessorDirectiveContext* context)
         return;
     }
 
+    inputFile->noteConditionalBranch(true);
     inputFile->popConditional();
 
     updateLexerFlagsForConditionals(inputFile);
@@ -3229,6 +3398,17 @@ static void HandleIncludeDirective(PreprocessorDirectiveContext* context)
         return;
     }
 
+    // Likewise if the file is wrapped in an include guard whose macro is still defined,
+    // since including it again would produce nothing.
+    Name* includeGuardName = nullptr;
+    if (context->m_preprocessor->includeGuardedUniqueIdentities.tryGetValue(
+            filePathInfo.uniqueIdentity,
+            includeGuardName) &&
+        LookupMacro(context, includeGuardName))
+    {
+        return;
+    }
+
     // Simplify the path
     filePathInfo.foundPath = includeSystem->simplifyPath(filePathInfo.foundPath);
 
@@ -3401,7 +3581,7 @@ static void HandleDefineDirective(PreprocessorDirectiveContext* context)
         return;
     Name* name = nameToken.getName();
 
-    MacroDefinition* oldMacro = LookupMacro(&context->m_preprocessor->globalEnv, name);
+    MacroDefinition* oldMacro = LookupMacro(context->m_preprocessor, name);
     if (oldMacro)
     {
         auto sink = GetSink(context);
@@ -3927,10 +4107,8 @@ struct PreprocessorDirective
     unsigned int flags;
 };
 
-// A simple array of all the directives we know how to handle.
-// TODO(tfoley): considering making this into a real hash map,
-// and then make it easy-ish for users of the codebase to add
-// their own directives as desired.
+// All the directives we know how to handle, in the order of `PreprocessorDirectiveKind`,
+// which `lookupPreprocessorDirectiveKind` finds from the name of a directive.
 static const PreprocessorDirective kDirectives[] = {
     {"if", &HandleIfDirective, ProcessWhenSkipping},
     {"ifdef", &HandleIfDefDirective, ProcessWhenSkipping},
@@ -3950,10 +4128,10 @@ static const PreprocessorDirective kDirectives[] = {
     // GLSL
     {"version", &HandleVersionDirective, 0},
     {"extension", &HandleExtensionDirective, 0},
-
-
-    {nullptr, nullptr, 0},
 };
+static_assert(
+    SLANG_COUNT_OF(kDirectives) == Index(PreprocessorDirectiveKind::CountOf),
+    "A directive is missing from kDirectives");
 
 static const PreprocessorDirective kInvalidDirective = {
     nullptr,
@@ -3962,18 +4140,14 @@ static const PreprocessorDirective kInvalidDirective = {
 };
 
 // Look up the directive with the given name.
-static PreprocessorDirective const* FindDirective(String const& name)
+static PreprocessorDirective const* FindDirective(const UnownedStringSlice& name)
 {
-    char const* nameStr = name.getBuffer();
-    for (int ii = 0; kDirectives[ii].name; ++ii)
-    {
-        if (strcmp(kDirectives[ii].name, nameStr) != 0)
-            continue;
+    PreprocessorDirectiveKind kind;
+    if (!lookupPreprocessorDirectiveKind(name, kind))
+        return &kInvalidDirective;
 
-        return &kDirectives[ii];
-    }
-
-    return &kInvalidDirective;
+    SLANG_ASSERT(name == kDirectives[Index(kind)].name);
+    return &kDirectives[Index(kind)];
 }
 
 // Process a directive, where the preprocessor has already consumed the
@@ -4057,6 +4231,17 @@ void Preprocessor::popInputFile()
             conditional->ifToken.getContent());
     }
 
+    // If the whole file is wrapped in an include guard, remember it so that
+    // we can skip including it again.
+    //
+    if (auto includeGuardName = inputFile->getIncludeGuardName())
+    {
+        const PathInfo& pathInfo =
+            inputFile->getLexer()->m_sourceView->getSourceFile()->getPathInfo();
+        if (pathInfo.hasUniqueIdentity())
+            includeGuardedUniqueIdentities[pathInfo.uniqueIdentity] = includeGuardName;
+    }
+
     // We will update the current file to the parent of whatever
     // the `inputFile` was (usually the file that `#include`d it).
     //
@@ -4095,6 +4280,8 @@ static Token ReadToken(Preprocessor* preprocessor)
             continue;
         }
 
+        const bool isOutsideConditionals = !inputFile->getInnerMostConditional();
+
         // If we have a directive (`#` at start of line) then handle it
         if ((token.type == TokenType::Pound) && (token.flags & TokenFlag::AtStartOfLine))
         {
@@ -4110,9 +4297,15 @@ static Token ReadToken(Preprocessor* preprocessor)
 
             // Parse and handle the directive
             HandleDirective(&directiveContext);
+
+            if (isOutsideConditionals)
+                inputFile->noteTokenOutsideConditionals();
             continue;
         }
 
+        if (isOutsideConditionals)
+            inputFile->noteTokenOutsideConditionals();
+
         // otherwise, if we are currently in a skipping mode, then skip tokens
         if (inputFile->isSkipping())
         {
@@ -4147,6 +4340,7 @@ static void DefineMacro(Preprocessor* preprocessor, String const& key, String co
 
     MacroDefinition* macro = new MacroDefinition();
     macro->flavor = MacroDefinition::Flavor::ObjectLike;
+    macro->isFromDefines = true;
 
     auto sourceManager = preprocessor->getSourceManager();
 
@@ -4218,6 +4412,67 @@ static TokenList ReadAllTokens(Preprocessor* preprocessor)
 
 } // namespace preprocessor
 
+PreprocessorTokenCache::Entry* PreprocessorTokenCache::findOrLexTokens(
+    SourceView* sourceView,
+    NamePool* namePool)
+{
+    SourceFile* sourceFile = sourceView->getSourceFile();
+    const PathInfo& pathInfo = sourceFile->getPathInfo();
+    if (!pathInfo.hasUniqueIdentity() || !sourceFile->getContentBlob())
+        return nullptr;
+
+    const SHA1::Digest contentDigest = sourceFile->getDigest();
+
+    RefPtr<Entry> entry;
+    if (m_entries.tryGetValue(pathInfo.uniqueIdentity, entry) &&
+        entry->contentDigest == contentDigest)
+    {
+        return entry->hasDiagnostics ? nullptr : entry.get();
+    }
+
+    entry = new Entry();
+    entry->contentDigest = contentDigest;
+    entry->contentBlob = sourceFile->getContentBlob();
+
+    // Lex the whole file with a sink of our own, so that we can tell if there were any
+    // diagnostics. If there were, the preprocessor lexes the file itself instead, since it
+    // may need to report them or suppress them in disabled conditional blocks.
+    DiagnosticSink sink(sourceView->getSourceManager(), nullptr);
+
+    Lexer lexer;
+    lexer.initialize(sourceView, &sink, namePool, &m_memoryArena);
+
+    const SourceLoc startLoc = sourceView->getRange().begin;
+    for (;;)
+    {
+        Token token = lexer.lexToken();
+        switch (token.type)
+        {
+        case TokenType::WhiteSpace:
+        case TokenType::BlockComment:
+        case TokenType::LineComment:
+            continue;
+        default:
+            break;
+        }
+
+        token.loc = SourceLoc::fromRaw(token.loc.getRaw() - startLoc.getRaw());
+        entry->tokens.add(token);
+
+        if (token.type == TokenType::EndOfFile)
+            break;
+    }
+
+    if (sink.outputBuffer.getLength() || sink.getErrorCount())
+    {
+        entry->hasDiagnostics = true;
+        entry->tokens = List<Token>();
+    }
+
+    m_entries[pathInfo.uniqueIdentity] = entry;
+    return entry->hasDiagnostics ? nullptr : entry.get();
+}
+
 /// Try to look up a macro with the given `macroName` and produce its value as a string
 Result findMacroValue(
     Preprocessor* preprocessor,
@@ -4228,7 +4483,7 @@ Result findMacroValue(
     using namespace preprocessor;
 
     auto namePool = preprocessor->namePool;
-    auto macro = LookupMacro(&preprocessor->globalEnv, namePool->getName(macroName));
+    auto macro = LookupMacro(preprocessor, namePool->getName(macroName));
     if (!macro)
         return SLANG_FAIL;
     if (macro->flavor != MacroDefinition::Flavor::ObjectLike)
@@ -4261,6 +4516,12 @@ Result findMacroValue(
     return SLANG_OK;
 }
 
+void getDefineDependencies(Preprocessor* preprocessor, List<Name*>& outNames)
+{
+    for (auto name : preprocessor->defineDependencies)
+        outNames.add(name);
+}
+
 TokenList preprocessSource(
     SourceFile* file,
     DiagnosticSink* sink,
@@ -4286,6 +4547,9 @@ TokenList preprocessSource(
     {
         desc.contentAssistInfo = &linkage->contentAssistInfo.preprocessorInfo;
     }
+
+    desc.tokenCache = linkage->getPreprocessorTokenCache();
+
     return preprocessSource(file, desc, outDetectedLanguage);
 }
 
@@ -4306,6 +4570,7 @@ TokenList preprocessSource(
     preprocessor.endOfFileToken.type = TokenType::EndOfFile;
     preprocessor.endOfFileToken.flags = TokenFlag::AtStartOfLine;
     preprocessor.contentAssistInfo = desc.contentAssistInfo;
+    preprocessor.tokenCache = desc.tokenCache;
 
     // Add builtin macros
     {
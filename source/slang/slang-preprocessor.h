@@ -33,6 +33,48 @@ struct PreprocessorHandler
     virtual void handleFileDependency(SourceFile* sourceFile);
 };
 
+/// A cache of the tokens lexed from source files, which can be shared between preprocessor
+/// invocations so that a file included by many translation units is only lexed once.
+///
+/// Entries are keyed by the unique identity of a file, and are only replayed while the
+/// digest of the file contents is unchanged. Files whose lexing produced any diagnostics
+/// are never replayed, so that those diagnostics are still reported (or suppressed) in
+/// context by the preprocessor.
+class PreprocessorTokenCache
+{
+public:
+    struct Entry : public RefObject
+    {
+        /// Digest of the file contents the tokens were lexed from
+        SHA1::Digest contentDigest;
+
+        /// Keeps the file contents that `tokens` point into alive
+        ComPtr<ISlangBlob> contentBlob;
+
+        /// The tokens of the file (excluding whitespace and comments) up to and including
+        /// the end of file token. Locations are stored as offsets from the start of the file.
+        List<Token> tokens;
+
+        /// True if lexing the file produced diagnostics, so `tokens` is empty.
+        bool hasDiagnostics = false;
+    };
+
+    /// Find the tokens for the file viewed by `sourceView`, lexing the file and adding them to
+    /// the cache if necessary. Returns nullptr if the file can't be replayed from the cache.
+    Entry* findOrLexTokens(SourceView* sourceView, NamePool* namePool);
+
+    PreprocessorTokenCache()
+        : m_memoryArena(2048)
+    {
+    }
+
+protected:
+    Dictionary<String, RefPtr<Entry>> m_entries;
+
+    /// Storage for the text of tokens that had escaped newlines removed by the lexer
+    MemoryArena m_memoryArena;
+};
+
 /// Description of a preprocessor options/dependencies
 struct PreprocessorDesc
 {
@@ -59,6 +101,9 @@ struct PreprocessorDesc
 
     /// Optional: additional information for code assist.
     PreprocessorContentAssistInfo* contentAssistInfo = nullptr;
+
+    /// Optional: cache of lexed tokens to replay instead of lexing files again.
+    PreprocessorTokenCache* tokenCache = nullptr;
 };
 
 /// Take a source `file` and preprocess it into a list of tokens.
@@ -88,6 +133,10 @@ Result findMacroValue(
     String& outValue,
     SourceLoc& outLoc);
 
+/// Get the names of the macros whose definition (or lack of one) in the `defines` given to
+/// the preprocessor could have affected its output.
+void getDefineDependencies(Preprocessor* preprocessor, List<Name*>& outNames);
+
 } // namespace Slang
 
 #endif
@@ -896,11 +896,65 @@ SlangReflectionFunction* tryConvertExprToFunctionReflection(ASTBuilder* astBuild
     return nullptr;
 }
 
-SLANG_API SlangReflectionFunction* spReflection_FindFunctionByName(
-    SlangReflection* reflection,
-    char const* name)
+/// The results of looking up types and functions by name through a `ProgramLayout`,
+/// including the names that weren't found.
+///
+/// Entries are keyed by the `spComputeStringHash` of the name, so a lookup only compares
+/// the name against the entries with the same hash, and doesn't need to copy it.
+///
+struct ReflectionNameLookupCache : RefObject
+{
+    template<typename T>
+    struct NameMap
+    {
+        struct Entry
+        {
+            String name;
+            T* value;
+        };
+
+        bool tryGetValue(SlangUInt32 hash, UnownedStringSlice name, T*& outValue) const
+        {
+            if (auto entries = m_entries.tryGetValue(hash))
+            {
+                for (auto& entry : *entries)
+                {
+                    if (entry.name.getUnownedSlice() == name)
+                    {
+                        outValue = entry.value;
+                        return true;
+                    }
+                }
+            }
+            return false;
+        }
+
+        void add(SlangUInt32 hash, UnownedStringSlice name, T* value)
+        {
+            m_entries[hash].add(Entry{String(name), value});
+        }
+
+    private:
+        Dictionary<SlangUInt32, List<Entry>> m_entries;
+    };
+
+    NameMap<SlangReflectionType> types;
+    NameMap<SlangReflectionFunction> functions;
+};
+
+static ReflectionNameLookupCache* _getNameLookupCache(ProgramLayout* programLayout)
+{
+    auto cache = static_cast<ReflectionNameLookupCache*>(programLayout->nameLookupCache.Ptr());
+    if (!cache)
+    {
+        cache = new ReflectionNameLookupCache();
+        programLayout->nameLookupCache = cache;
+    }
+    return cache;
+}
+
+static SlangReflectionFunction* _findFunctionByName(ProgramLayout* programLayout, char const* name)
 {
-    auto programLayout = convert(reflection);
     auto program = programLayout->getProgram();
 
     // TODO: We should extend this API to support getting error messages
@@ -923,6 +977,37 @@ SLANG_API SlangReflectionFunction* spReflection_FindFunctionByName(
     return nullptr;
 }
 
+SLANG_API SlangReflectionFunction* spReflection_FindFunctionByNameHashed(
+    SlangReflection* reflection,
+    char const* name,
+    SlangUInt32 nameHash)
+{
+    auto programLayout = convert(reflection);
+    if (!programLayout || !name)
+        return nullptr;
+
+    auto cache = _getNameLookupCache(programLayout);
+    SlangReflectionFunction* result = nullptr;
+    if (!cache->functions.tryGetValue(nameHash, UnownedStringSlice(name), result))
+    {
+        result = _findFunctionByName(programLayout, name);
+        cache->functions.add(nameHash, UnownedStringSlice(name), result);
+    }
+    return result;
+}
+
+SLANG_API SlangReflectionFunction* spReflection_FindFunctionByName(
+    SlangReflection* reflection,
+    char const* name)
+{
+    if (!name)
+        return nullptr;
+    return spReflection_FindFunctionByNameHashed(
+        reflection,
+        name,
+        spComputeStringHash(name, strlen(name)));
+}
+
 SLANG_API SlangReflectionFunction* spReflection_FindFunctionByNameInType(
     SlangReflection* reflection,
     SlangReflectionType* reflType,
@@ -979,11 +1064,8 @@ SLANG_API SlangReflectionVariable* spReflection_FindVarByNameInType(
     return nullptr;
 }
 
-SLANG_API SlangReflectionType* spReflection_FindTypeByName(
-    SlangReflection* reflection,
-    char const* name)
+static SlangReflectionType* _findTypeByName(ProgramLayout* programLayout, char const* name)
 {
-    auto programLayout = convert(reflection);
     auto program = programLayout->getProgram();
 
     // TODO: We should extend this API to support getting error messages
@@ -1021,6 +1103,37 @@ SLANG_API SlangReflectionType* spReflection_FindTypeByName(
     }
 }
 
+SLANG_API SlangReflectionType* spReflection_FindTypeByNameHashed(
+    SlangReflection* reflection,
+    char const* name,
+    SlangUInt32 nameHash)
+{
+    auto programLayout = convert(reflection);
+    if (!programLayout || !name)
+        return nullptr;
+
+    auto cache = _getNameLookupCache(programLayout);
+    SlangReflectionType* result = nullptr;
+    if (!cache->types.tryGetValue(nameHash, UnownedStringSlice(name), result))
+    {
+        result = _findTypeByName(programLayout, name);
+        cache->types.add(nameHash, UnownedStringSlice(name), result);
+    }
+    return result;
+}
+
+SLANG_API SlangReflectionType* spReflection_FindTypeByName(
+    SlangReflection* reflection,
+    char const* name)
+{
+    if (!name)
+        return nullptr;
+    return spReflection_FindTypeByNameHashed(
+        reflection,
+        name,
+        spComputeStringHash(name, strlen(name)));
+}
+
 
 SLANG_API bool spReflection_isSubType(
     SlangReflection* reflection,
@@ -1264,6 +1377,90 @@ SLANG_API SlangReflectionVariableLayout* spReflectionTypeLayout_GetFieldByIndex(
     return nullptr;
 }
 
+namespace
+{
+struct FlattenedTypeLayoutContext
+{
+    SlangReflectionFlattenedTypeLayout* out;
+    SlangUInt count = 0;
+
+    void addNode(TypeLayout* typeLayout, VarLayout* field, int32_t parentIndex)
+    {
+        const SlangUInt nodeIndex = count++;
+        if (nodeIndex < out->capacity)
+        {
+            auto reflectionTypeLayout = convert(typeLayout);
+            auto kind = spReflectionTypeLayout_getKind(reflectionTypeLayout);
+
+            if (out->typeLayouts)
+                out->typeLayouts[nodeIndex] = reflectionTypeLayout;
+            if (out->fields)
+                out->fields[nodeIndex] = convert(field);
+            if (out->parentIndices)
+                out->parentIndices[nodeIndex] = parentIndex;
+            if (out->kinds)
+                out->kinds[nodeIndex] = kind;
+            if (out->uniformOffsets)
+            {
+                auto info = field ? field->FindResourceInfo(LayoutResourceKind::Uniform) : nullptr;
+                out->uniformOffsets[nodeIndex] = info ? size_t(info->index) : 0;
+            }
+            if (out->uniformSizes)
+            {
+                out->uniformSizes[nodeIndex] = spReflectionTypeLayout_GetSize(
+                    reflectionTypeLayout,
+                    SLANG_PARAMETER_CATEGORY_UNIFORM);
+            }
+            if (out->elementCounts)
+            {
+                out->elementCounts[nodeIndex] =
+                    kind == SLANG_TYPE_KIND_ARRAY
+                        ? spReflectionType_GetElementCount((SlangReflectionType*)typeLayout->type)
+                        : 0;
+            }
+        }
+
+        // Pointers are not followed, since the layout of a pointed-to struct can refer back
+        // to the pointer and form a cycle.
+        TypeLayout* elementTypeLayout = nullptr;
+        if (auto structTypeLayout = as<StructTypeLayout>(typeLayout))
+        {
+            for (auto& childField : structTypeLayout->fields)
+                addNode(childField->getTypeLayout(), childField, int32_t(nodeIndex));
+        }
+        else if (auto arrayTypeLayout = as<ArrayTypeLayout>(typeLayout))
+        {
+            elementTypeLayout = arrayTypeLayout->elementTypeLayout;
+        }
+        else if (auto parameterGroupTypeLayout = as<ParameterGroupTypeLayout>(typeLayout))
+        {
+            elementTypeLayout = parameterGroupTypeLayout->offsetElementTypeLayout;
+        }
+        else if (auto structuredBufferTypeLayout = as<StructuredBufferTypeLayout>(typeLayout))
+        {
+            elementTypeLayout = structuredBufferTypeLayout->elementTypeLayout;
+        }
+
+        if (elementTypeLayout)
+            addNode(elementTypeLayout, nullptr, int32_t(nodeIndex));
+    }
+};
+} // namespace
+
+SLANG_API SlangUInt spReflectionTypeLayout_getFlattenedTree(
+    SlangReflectionTypeLayout* inTypeLayout,
+    SlangReflectionFlattenedTypeLayout* outTree)
+{
+    auto typeLayout = convert(inTypeLayout);
+    if (!typeLayout || !outTree)
+        return 0;
+
+    FlattenedTypeLayoutContext context;
+    context.out = outTree;
+    context.addNode(typeLayout, nullptr, -1);
+    return context.count;
+}
+
 SLANG_API SlangInt spReflectionTypeLayout_findFieldIndexByName(
     SlangReflectionTypeLayout* inTypeLayout,
     const char* nameBegin,
@@ -4215,6 +4412,76 @@ SLANG_API SlangReflectionVariableLayout* spReflection_getGlobalParamsVarLayout(
     return convert(program->parametersLayout);
 }
 
+static void _addFlattenedBindings(
+    VarLayout* varLayout,
+    int32_t entryPointIndex,
+    SlangReflectionFlattenedBindings* out,
+    SlangUInt& ioCount)
+{
+    auto typeLayout = varLayout->getTypeLayout();
+    auto regSpaceInfo = varLayout->FindResourceInfo(LayoutResourceKind::RegisterSpace);
+
+    for (auto& info : varLayout->resourceInfos)
+    {
+        const SlangUInt bindingIndex = ioCount++;
+        if (bindingIndex >= out->capacity)
+            continue;
+
+        if (out->parameters)
+            out->parameters[bindingIndex] = convert(varLayout);
+        if (out->entryPointIndices)
+            out->entryPointIndices[bindingIndex] = entryPointIndex;
+        if (out->categories)
+            out->categories[bindingIndex] = getParameterCategory(info.kind);
+        if (out->indices)
+            out->indices[bindingIndex] = size_t(info.index);
+        if (out->spaces)
+        {
+            // Matches `spReflectionVariableLayout_GetSpace`.
+            UInt space = info.space;
+            if (regSpaceInfo && info.kind != LayoutResourceKind::RegisterSpace)
+                space += regSpaceInfo->index;
+            out->spaces[bindingIndex] = size_t(space);
+        }
+        if (out->counts)
+        {
+            auto sizeInfo = typeLayout ? typeLayout->FindResourceInfo(info.kind) : nullptr;
+            out->counts[bindingIndex] = sizeInfo ? getReflectionSize(sizeInfo->count) : 0;
+        }
+    }
+}
+
+SLANG_API SlangUInt spReflection_getFlattenedBindings(
+    SlangReflection* inProgram,
+    SlangReflectionFlattenedBindings* outBindings)
+{
+    auto program = convert(inProgram);
+    if (!program || !outBindings)
+        return 0;
+
+    SlangUInt count = 0;
+    if (auto globalStructLayout = getGlobalStructLayout(program))
+    {
+        for (auto& field : globalStructLayout->fields)
+            _addFlattenedBindings(field, -1, outBindings, count);
+    }
+
+    for (Index i = 0; i < program->entryPoints.getCount(); ++i)
+    {
+        auto parametersTypeLayout = program->entryPoints[i]->parametersLayout->typeLayout;
+        const unsigned parameterCount = getParameterCount(parametersTypeLayout);
+        for (unsigned j = 0; j < parameterCount; ++j)
+        {
+            _addFlattenedBindings(
+                getParameterByIndex(parametersTypeLayout, j),
+                int32_t(i),
+                outBindings,
+                count);
+        }
+    }
+    return count;
+}
+
 SLANG_API unsigned int spReflection_GetTypeParameterCount(SlangReflection* reflection)
 {
     auto program = convert(reflection);
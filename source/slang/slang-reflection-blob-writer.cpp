@@ -0,0 +1,322 @@
+// slang-reflection-blob-writer.cpp
+#include "slang-reflection-blob-writer.h"
+
+#include "../core/slang-basic.h"
+#include "../core/slang-blob.h"
+#include "slang-reflection-blob.h"
+
+namespace Slang
+{
+
+namespace Blob = slang::ReflectionBlob;
+
+/// Builds the tables of a reflection blob from the reflection API.
+///
+/// Type layouts are shared between all the variables that use them. The records that a span
+/// covers (fields, bindings and so on) have to be contiguous, so they are collected locally,
+/// including any records they refer to, and only then appended to their table.
+struct ReflectionBlobWriter
+{
+    Blob::StringRef addString(const char* text)
+    {
+        if (!text)
+            return Blob::kNone;
+
+        String string(text);
+        if (auto ref = m_stringMap.tryGetValue(string))
+            return *ref;
+
+        const auto ref = Blob::StringRef(m_strings.getCount());
+        m_strings.addRange(text, Index(string.getLength()));
+        m_strings.add(0);
+        m_stringMap.add(string, ref);
+        return ref;
+    }
+
+    template<typename T>
+    static Blob::Span appendRecords(List<T>& table, const List<T>& records)
+    {
+        Blob::Span span = {uint32_t(table.getCount()), uint32_t(records.getCount())};
+        table.addRange(records);
+        return span;
+    }
+
+    static uint32_t toSize(size_t size)
+    {
+        return size >= Blob::kUnbounded ? Blob::kUnbounded : uint32_t(size);
+    }
+
+    template<typename T>
+    Blob::Span addAttributes(T* owner)
+    {
+        List<Blob::Attribute> attributes;
+        const unsigned int count = owner ? owner->getUserAttributeCount() : 0;
+        for (unsigned int i = 0; i < count; ++i)
+        {
+            slang::UserAttribute* attribute = owner->getUserAttributeByIndex(i);
+
+            List<Blob::AttributeArg> args;
+            for (unsigned int a = 0; a < attribute->getArgumentCount(); ++a)
+            {
+                Blob::AttributeArg arg = {Blob::AttributeArgKind::Int, 0};
+
+                int intValue;
+                float floatValue;
+                size_t stringSize = 0;
+                if (SLANG_SUCCEEDED(attribute->getArgumentValueInt(a, &intValue)))
+                {
+                    memcpy(&arg.value, &intValue, sizeof(arg.value));
+                }
+                else if (SLANG_SUCCEEDED(attribute->getArgumentValueFloat(a, &floatValue)))
+                {
+                    arg.kind = Blob::AttributeArgKind::Float;
+                    memcpy(&arg.value, &floatValue, sizeof(arg.value));
+                }
+                else if (auto chars = attribute->getArgumentValueString(a, &stringSize))
+                {
+                    arg.kind = Blob::AttributeArgKind::String;
+                    arg.value = addString(String(chars, chars + stringSize).getBuffer());
+                }
+                else
+                {
+                    continue;
+                }
+                args.add(arg);
+            }
+
+            Blob::Attribute record;
+            record.name = addString(attribute->getName());
+            record.args = appendRecords(m_attributeArgs, args);
+            attributes.add(record);
+        }
+        return appendRecords(m_attributes, attributes);
+    }
+
+    Blob::Variable makeVariable(slang::VariableLayoutReflection* varLayout)
+    {
+        Blob::Variable record;
+        record.name = addString(varLayout->getName());
+        record.typeLayout = addTypeLayout(varLayout->getTypeLayout());
+        record.semanticName = addString(varLayout->getSemanticName());
+        record.semanticIndex = uint32_t(varLayout->getSemanticIndex());
+        record.stage = uint32_t(varLayout->getStage());
+
+        List<Blob::Binding> bindings;
+        for (unsigned int i = 0; i < varLayout->getCategoryCount(); ++i)
+        {
+            const auto category = SlangParameterCategory(varLayout->getCategoryByIndex(i));
+
+            Blob::Binding binding;
+            binding.category = uint32_t(category);
+            binding.offset = toSize(varLayout->getOffset(category));
+            binding.space = toSize(varLayout->getBindingSpace(category));
+            bindings.add(binding);
+        }
+        record.bindings = appendRecords(m_bindings, bindings);
+        record.attributes = addAttributes(varLayout->getVariable());
+        return record;
+    }
+
+    uint32_t addVariable(slang::VariableLayoutReflection* varLayout)
+    {
+        if (!varLayout)
+            return Blob::kNone;
+
+        auto record = makeVariable(varLayout);
+        m_variables.add(record);
+        return uint32_t(m_variables.getCount() - 1);
+    }
+
+    Blob::Span addVariables(List<slang::VariableLayoutReflection*> const& varLayouts)
+    {
+        List<Blob::Variable> records;
+        for (auto varLayout : varLayouts)
+            records.add(makeVariable(varLayout));
+        return appendRecords(m_variables, records);
+    }
+
+    uint32_t addTypeLayout(slang::TypeLayoutReflection* typeLayout)
+    {
+        if (!typeLayout)
+            return Blob::kNone;
+
+        // The index is reserved before anything the layout refers to is added, which also
+        // stops the recursion for types that refer to themselves through a pointer.
+        if (auto index = m_typeLayoutMap.tryGetValue(typeLayout))
+            return *index;
+
+        const auto index = uint32_t(m_typeLayouts.getCount());
+        m_typeLayoutMap.add(typeLayout, index);
+        m_typeLayouts.add(Blob::TypeLayout());
+
+        Blob::TypeLayout record = {};
+        auto type = typeLayout->getType();
+        record.kind = uint32_t(typeLayout->getKind());
+        record.name = addString(type ? type->getName() : nullptr);
+        record.parameterCategory = uint32_t(typeLayout->getParameterCategory());
+        record.alignment = uint32_t(typeLayout->getAlignment(SLANG_PARAMETER_CATEGORY_UNIFORM));
+        record.stride = toSize(typeLayout->getStride(SLANG_PARAMETER_CATEGORY_UNIFORM));
+        if (type)
+        {
+            record.scalarType = uint32_t(type->getScalarType());
+            record.rowCount = type->getRowCount();
+            record.columnCount = type->getColumnCount();
+            record.elementCount =
+                type->getKind() == slang::TypeReflection::Kind::Array
+                    ? toSize(type->getElementCount())
+                    : 0;
+            record.resourceShape = uint32_t(type->getResourceShape());
+            record.resourceAccess = uint32_t(type->getResourceAccess());
+        }
+
+        // Pointers are left without an element layout, like the JSON output does, because
+        // the pointed-to type may only be complete once the pointer type is.
+        record.elementTypeLayout = typeLayout->getKind() == slang::TypeReflection::Kind::Pointer
+                                       ? Blob::kNone
+                                       : addTypeLayout(typeLayout->getElementTypeLayout());
+        record.elementVariable = addVariable(typeLayout->getElementVarLayout());
+        record.containerVariable = addVariable(typeLayout->getContainerVarLayout());
+
+        List<Blob::Size> sizes;
+        for (unsigned int i = 0; i < typeLayout->getCategoryCount(); ++i)
+        {
+            const auto category = SlangParameterCategory(typeLayout->getCategoryByIndex(i));
+
+            Blob::Size size;
+            size.category = uint32_t(category);
+            size.size = toSize(typeLayout->getSize(category));
+            sizes.add(size);
+        }
+        record.sizes = appendRecords(m_sizes, sizes);
+
+        List<slang::VariableLayoutReflection*> fields;
+        for (unsigned int i = 0; i < typeLayout->getFieldCount(); ++i)
+            fields.add(typeLayout->getFieldByIndex(i));
+        record.fields = addVariables(fields);
+        record.attributes = addAttributes(type);
+
+        m_typeLayouts[index] = record;
+        return index;
+    }
+
+    void addEntryPoint(slang::EntryPointReflection* entryPoint)
+    {
+        Blob::EntryPoint record = {};
+        record.name = addString(entryPoint->getName());
+        record.nameOverride = addString(entryPoint->getNameOverride());
+        record.stage = uint32_t(entryPoint->getStage());
+        if (entryPoint->getStage() == SLANG_STAGE_COMPUTE)
+        {
+            SlangUInt threadGroupSize[3];
+            entryPoint->getComputeThreadGroupSize(3, threadGroupSize);
+            for (int i = 0; i < 3; ++i)
+                record.threadGroupSize[i] = toSize(threadGroupSize[i]);
+        }
+        record.usesAnySampleRateInput = entryPoint->usesAnySampleRateInput() ? 1 : 0;
+        record.resultVariable = addVariable(entryPoint->getResultVarLayout());
+
+        List<slang::VariableLayoutReflection*> parameters;
+        for (unsigned int i = 0; i < entryPoint->getParameterCount(); ++i)
+            parameters.add(entryPoint->getParameterByIndex(i));
+        record.parameters = addVariables(parameters);
+        record.attributes = addAttributes(entryPoint->getFunction());
+
+        m_entryPoints.add(record);
+    }
+
+    void addProgram(slang::ShaderReflection* program)
+    {
+        List<slang::VariableLayoutReflection*> parameters;
+        for (unsigned int i = 0; i < program->getParameterCount(); ++i)
+            parameters.add(program->getParameterByIndex(i));
+        m_parameters = addVariables(parameters);
+
+        for (SlangUInt i = 0; i < program->getEntryPointCount(); ++i)
+            addEntryPoint(program->getEntryPointByIndex(i));
+
+        for (SlangUInt i = 0; i < program->getHashedStringCount(); ++i)
+        {
+            size_t charCount = 0;
+            const char* chars = program->getHashedString(i, &charCount);
+
+            Blob::HashedString record;
+            record.string = addString(String(chars, chars + charCount).getBuffer());
+            record.hash = uint32_t(spComputeStringHash(chars, charCount));
+            m_hashedStrings.add(record);
+        }
+    }
+
+    template<typename T>
+    Blob::Table writeTable(List<uint8_t>& data, const List<T>& records)
+    {
+        // Every record is made of 32 bit values, so keeping each table 4 byte aligned
+        // keeps every record aligned.
+        while (data.getCount() & 3)
+            data.add(0);
+
+        Blob::Table table = {uint32_t(data.getCount()), uint32_t(records.getCount())};
+        data.addRange((const uint8_t*)records.getBuffer(), records.getCount() * sizeof(T));
+        return table;
+    }
+
+    ComPtr<ISlangBlob> write()
+    {
+        List<uint8_t> data;
+        data.setCount(sizeof(Blob::Header));
+
+        Blob::Header header = {};
+        header.magic = Blob::kMagic;
+        header.version = Blob::kVersion;
+        header.parameters = m_parameters;
+        header.typeLayouts = writeTable(data, m_typeLayouts);
+        header.variables = writeTable(data, m_variables);
+        header.bindings = writeTable(data, m_bindings);
+        header.sizes = writeTable(data, m_sizes);
+        header.attributes = writeTable(data, m_attributes);
+        header.attributeArgs = writeTable(data, m_attributeArgs);
+        header.entryPoints = writeTable(data, m_entryPoints);
+        header.hashedStrings = writeTable(data, m_hashedStrings);
+        header.strings = writeTable(data, m_strings);
+        while (data.getCount() & 3)
+            data.add(0);
+        header.size = uint32_t(data.getCount());
+
+        memcpy(data.getBuffer(), &header, sizeof(header));
+        return ListBlob::moveCreate(data);
+    }
+
+    Dictionary<String, Blob::StringRef> m_stringMap;
+    Dictionary<slang::TypeLayoutReflection*, uint32_t> m_typeLayoutMap;
+
+    Blob::Span m_parameters = {0, 0};
+    List<char> m_strings;
+    List<Blob::TypeLayout> m_typeLayouts;
+    List<Blob::Variable> m_variables;
+    List<Blob::Binding> m_bindings;
+    List<Blob::Size> m_sizes;
+    List<Blob::Attribute> m_attributes;
+    List<Blob::AttributeArg> m_attributeArgs;
+    List<Blob::EntryPoint> m_entryPoints;
+    List<Blob::HashedString> m_hashedStrings;
+};
+
+SlangResult writeReflectionBlob(SlangReflection* reflection, ISlangBlob** outBlob)
+{
+    if (!reflection)
+        return SLANG_E_INVALID_ARG;
+
+    ReflectionBlobWriter writer;
+    writer.addProgram((slang::ShaderReflection*)reflection);
+    *outBlob = writer.write().detach();
+    return SLANG_OK;
+}
+
+} // namespace Slang
+
+extern "C"
+{
+    SLANG_API SlangResult spReflection_ToBlob(SlangReflection* reflection, ISlangBlob** outBlob)
+    {
+        return Slang::writeReflectionBlob(reflection, outBlob);
+    }
+}
@@ -0,0 +1,15 @@
+#ifndef SLANG_REFLECTION_BLOB_WRITER_H
+#define SLANG_REFLECTION_BLOB_WRITER_H
+
+#include "slang.h"
+
+namespace Slang
+{
+
+/// Write the reflection information of `reflection` in the flat binary format described in
+/// `include/slang-reflection-blob.h`, which can be read at runtime without the compiler.
+SlangResult writeReflectionBlob(SlangReflection* reflection, ISlangBlob** outBlob);
+
+} // namespace Slang
+
+#endif
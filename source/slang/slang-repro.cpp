@@ -4,7 +4,10 @@
 #include "../compiler-core/slang-artifact-desc-util.h"
 #include "../compiler-core/slang-artifact-util.h"
 #include "../compiler-core/slang-source-loc.h"
+#include "../core/slang-block-compression-util.h"
 #include "../core/slang-castable.h"
+#include "../core/slang-crypto.h"
+#include "../core/slang-lz4-compression-system.h"
 #include "../core/slang-math.h"
 #include "../core/slang-stream.h"
 #include "../core/slang-text-io.h"
@@ -127,7 +130,7 @@ struct StoreContext
         // If the contents is not set add it
         if (!base[file]->contents && content)
         {
-            auto offsetContent = m_container->newString(*content);
+            auto offsetContent = fromContents(*content);
             base[file]->contents = offsetContent;
         }
 
@@ -190,6 +193,20 @@ struct StoreContext
         m_stringMap.add(in, value);
         return value;
     }
+    /// Get the contents of a file, stored once however many files have them
+    Offset32Ptr<OffsetString> fromContents(const UnownedStringSlice& contents)
+    {
+        const SHA1::Digest digest = SHA1::compute(contents.begin(), contents.getLength());
+
+        Offset32Ptr<OffsetString> value;
+        if (m_contentsMap.tryGetValue(digest, value))
+        {
+            return value;
+        }
+        value = m_container->newString(contents);
+        m_contentsMap.add(digest, value);
+        return value;
+    }
     Offset32Ptr<OffsetString> fromName(Name* name)
     {
         if (name)
@@ -250,7 +267,7 @@ struct StoreContext
                 UnownedStringSlice contents(
                     (const char*)srcPathInfo->m_fileBlob->getBufferPointer(),
                     srcPathInfo->m_fileBlob->getBufferSize());
-                const auto offsetContents = m_container->newString(contents);
+                const auto offsetContents = fromContents(contents);
                 base[fileState]->contents = offsetContents;
             }
 
@@ -311,6 +328,8 @@ struct StoreContext
 
     Dictionary<String, Offset32Ptr<OffsetString>> m_stringMap;
 
+    Dictionary<SHA1::Digest, Offset32Ptr<OffsetString>> m_contentsMap;
+
     Dictionary<SourceFile*, Offset32Ptr<ReproUtil::SourceFileState>> m_sourceFileMap;
 
     Dictionary<String, Offset32Ptr<ReproUtil::FileState>> m_uniqueToFileMap;
@@ -1173,16 +1192,29 @@ struct LoadContext
     Offset32Ptr<RequestState> requestState;
     SLANG_RETURN_ON_FAIL(store(request, container, requestState));
 
+    // The state is mostly source, so compressing it takes less time than is saved writing it,
+    // and keeps repro files of large requests to a manageable size. It is compressed as blocks,
+    // so that the state of a large request is compressed and decompressed on several threads.
+    CompressionStyle style;
+    style.m_type = CompressionStyle::Type::BestSpeed;
+    List<uint8_t> payload;
+    SLANG_RETURN_ON_FAIL(BlockCompressionUtil::compress(
+        LZ4CompressionSystem::getSingleton(),
+        &style,
+        container.getData(),
+        container.getDataCount(),
+        payload));
+
     Header header;
-    header.m_chunk.type = kSlangStateFourCC;
+    header.m_chunk.type = kSlangBlockCompressedStateFourCC;
     header.m_semanticVersion = g_semanticVersion;
     header.m_typeHash = _getTypeHash();
 
     return RiffUtil::writeData(
         &header.m_chunk,
         sizeof(header),
-        container.getData(),
-        container.getDataCount(),
+        payload.getBuffer(),
+        payload.getCount(),
         stream);
 }
 
@@ -1222,7 +1254,9 @@ struct LoadContext
             return res;
         }
     }
-    if (header.m_chunk.type != kSlangStateFourCC)
+    if (header.m_chunk.type != kSlangStateFourCC &&
+        header.m_chunk.type != kSlangCompressedStateFourCC &&
+        header.m_chunk.type != kSlangBlockCompressedStateFourCC)
     {
         sink->diagnose(SourceLoc(), Diagnostics::expectingSlangRiffContainer);
         return SLANG_FAIL;
@@ -1248,6 +1282,46 @@ struct LoadContext
         return SLANG_FAIL;
     }
 
+    if (header.m_chunk.type == kSlangCompressedStateFourCC)
+    {
+        uint64_t stateSize = 0;
+        if (size_t(buffer.getCount()) < sizeof(stateSize))
+        {
+            sink->diagnose(SourceLoc(), Diagnostics::unableToReadRiff);
+            return SLANG_FAIL;
+        }
+        ::memcpy(&stateSize, buffer.getBuffer(), sizeof(stateSize));
+
+        List<uint8_t> state;
+        state.setCount(Index(stateSize));
+        const SlangResult res = LZ4CompressionSystem::getSingleton()->decompress(
+            buffer.getBuffer() + sizeof(stateSize),
+            size_t(buffer.getCount()) - sizeof(stateSize),
+            size_t(stateSize),
+            state.getBuffer());
+        if (SLANG_FAILED(res))
+        {
+            sink->diagnose(SourceLoc(), Diagnostics::unableToReadRiff);
+            return res;
+        }
+        buffer.swapWith(state);
+    }
+    else if (header.m_chunk.type == kSlangBlockCompressedStateFourCC)
+    {
+        List<uint8_t> state;
+        const SlangResult res = BlockCompressionUtil::decompress(
+            LZ4CompressionSystem::getSingleton(),
+            buffer.getBuffer(),
+            size_t(buffer.getCount()),
+            state);
+        if (SLANG_FAILED(res))
+        {
+            sink->diagnose(SourceLoc(), Diagnostics::unableToReadRiff);
+            return res;
+        }
+        buffer.swapWith(state);
+    }
+
     return SLANG_OK;
 }
 
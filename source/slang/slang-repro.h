@@ -31,6 +31,12 @@ struct ReproUtil
 
     static const uint32_t kSlangStateFourCC =
         SLANG_FOUR_CC('S', 'L', 'S', 'T'); ///< Holds all the slang specific chunks
+    /// The state of kSlangStateFourCC LZ4 compressed. The payload is the size of the state
+    /// uncompressed as a uint64_t, followed by the compressed state.
+    static const uint32_t kSlangCompressedStateFourCC = SLANG_FOUR_CC('S', 'L', 'S', 'Z');
+    /// The state of kSlangStateFourCC compressed as blocks by BlockCompressionUtil with LZ4. This
+    /// is what is written, kSlangCompressedStateFourCC can still be read.
+    static const uint32_t kSlangBlockCompressedStateFourCC = SLANG_FOUR_CC('S', 'L', 'S', 'B');
     static const RiffSemanticVersion g_semanticVersion;
 
     struct Header
@@ -4,6 +4,7 @@
 #include "../core/slang-byte-encode-util.h"
 #include "../core/slang-math.h"
 #include "../core/slang-stream.h"
+#include "../core/slang-task-util.h"
 #include "../core/slang-text-io.h"
 #include "slang-compiler.h"
 #include "slang-mangled-lexer.h"
@@ -13,6 +14,8 @@
 #include "slang-serialize-ir.h"
 #include "slang-serialize-source-loc.h"
 
+#include <atomic>
+
 namespace Slang
 {
 
@@ -191,7 +194,11 @@ namespace Slang
                 dstModule.dependentFiles.add(file->getPathInfo().getMostUniqueIdentity());
             }
         }
+        for (const auto& macroName : module->getDefineDependencies())
+            dstModule.defineDependencies.add(macroName);
+        dstModule.defineDependencies.sort();
         dstModule.digest = module->computeDigest();
+        dstModule.sourceDigest = module->computeSourceDigest();
         outData.modules.add(dstModule);
     }
 
@@ -325,7 +332,9 @@ namespace Slang
 
             // First, we write a header that can be used to verify if the precompiled module is
             // up-to-date. The header has: 1) a digest of all compile options and dependent source
-            // files. 2) a list of source file paths.
+            // files. 2) a list of source file paths. 3) a list of the macro names whose
+            // definitions in the compile options are included in the digest. 4) a digest of the
+            // dependent source files alone.
             //
             {
                 RiffContainer::ScopeChunk scopeHeader(
@@ -340,61 +349,111 @@ namespace Slang
                 uint32_t fileListLength = (uint32_t)filePathsSB.getLength();
                 headerMemStream.write(&fileListLength, sizeof(uint32_t));
                 headerMemStream.write(filePathsSB.getBuffer(), fileListLength);
+                StringBuilder macroNamesSB;
+                for (const auto& macroName : module.defineDependencies)
+                    macroNamesSB << macroName << "\n";
+                uint32_t macroListLength = (uint32_t)macroNamesSB.getLength();
+                headerMemStream.write(&macroListLength, sizeof(uint32_t));
+                headerMemStream.write(macroNamesSB.getBuffer(), macroListLength);
+                headerMemStream.write(module.sourceDigest.data, sizeof(module.sourceDigest.data));
                 container->write(
                     headerMemStream.getContents().getBuffer(),
                     headerMemStream.getContents().getCount());
             }
 
-            // Write the IR information
-            if ((options.optionFlags & SerialOptionFlag::IRModule) && module.irModule)
+            IRModule* irModule =
+                (options.optionFlags & SerialOptionFlag::IRModule) ? module.irModule : nullptr;
+            ModuleDecl* moduleDecl = (options.optionFlags & SerialOptionFlag::ASTModule)
+                                         ? as<ModuleDecl>(module.astRootNode)
+                                         : nullptr;
+
+            // Encode the IR and the AST, which is most of the work of writing a module, before
+            // writing either into the container.
+            IRSerialData irSerialData;
+            SlangResult irResult = SLANG_OK;
+            auto encodeIR = [&]()
             {
-                IRSerialData serialData;
                 IRSerialWriter writer;
-                SLANG_RETURN_ON_FAIL(writer.write(
-                    module.irModule,
-                    sourceLocWriter,
-                    options.optionFlags,
-                    &serialData));
-                SLANG_RETURN_ON_FAIL(
-                    IRSerialWriter::writeContainer(serialData, options.compressionType, container));
-            }
+                irResult =
+                    writer.write(irModule, sourceLocWriter, options.optionFlags, &irSerialData);
+            };
 
-            // Write the AST information
-
-            if (options.optionFlags & SerialOptionFlag::ASTModule)
+            RefPtr<SerialWriter> astWriter;
+            ModuleSerialFilter astFilter(moduleDecl);
+            if (moduleDecl)
             {
-                if (ModuleDecl* moduleDecl = as<ModuleDecl>(module.astRootNode))
+                if (!serialClasses)
                 {
-                    // Put in AST module
-                    RiffContainer::ScopeChunk scopeASTModule(
-                        container,
-                        RiffContainer::Chunk::Kind::List,
-                        ASTSerialBinary::kSlangASTModuleFourCC);
+                    SLANG_RETURN_ON_FAIL(SerialClassesUtil::create(serialClasses));
+                }
 
-                    if (!serialClasses)
+                auto astWriterFlag = SerialWriter::Flag::ZeroInitialize;
+                if ((options.optionFlags & SerialOptionFlag::ASTFunctionBody) == 0)
+                    astWriterFlag = (SerialWriter::Flag::Enum)(
+                        astWriterFlag | SerialWriter::Flag::SkipFunctionBody);
+
+                astWriter = new SerialWriter(serialClasses, &astFilter, astWriterFlag);
+                astWriter->getExtraObjects().set(sourceLocWriter);
+            }
+            auto encodeAST = [&]()
+            {
+                // Add the module and everything that isn't filtered out in the filter.
+                astWriter->addPointer(moduleDecl);
+            };
+
+            // The IR and the AST only share state through the source locations, which are
+            // numbered in the order they are added, so without them they are encoded at the
+            // same time.
+            if (irModule && moduleDecl && !sourceLocWriter)
+            {
+                std::atomic<Index> nextEncodingIndex(0);
+                auto worker = [&]()
+                {
+                    for (Index i = nextEncodingIndex++; i < 2; i = nextEncodingIndex++)
                     {
-                        SLANG_RETURN_ON_FAIL(SerialClassesUtil::create(serialClasses));
+                        if (i == 0)
+                            encodeIR();
+                        else
+                            encodeAST();
                     }
+                };
+                TaskUtil::runWorkers(
+                    options.taskScheduler,
+                    TaskUtil::calcExtraWorkerCount(2),
+                    worker);
+            }
+            else
+            {
+                if (irModule)
+                    encodeIR();
+                if (moduleDecl)
+                    encodeAST();
+            }
 
-                    ModuleSerialFilter filter(moduleDecl);
-                    auto astWriterFlag = SerialWriter::Flag::ZeroInitialize;
-                    if ((options.optionFlags & SerialOptionFlag::ASTFunctionBody) == 0)
-                        astWriterFlag = (SerialWriter::Flag::Enum)(
-                            astWriterFlag | SerialWriter::Flag::SkipFunctionBody);
-
-                    SerialWriter writer(serialClasses, &filter, astWriterFlag);
-
-                    writer.getExtraObjects().set(sourceLocWriter);
+            // Write the IR information
+            if (irModule)
+            {
+                SLANG_RETURN_ON_FAIL(irResult);
+                SLANG_RETURN_ON_FAIL(IRSerialWriter::writeContainer(
+                    irSerialData,
+                    options.compressionType,
+                    container));
+            }
 
-                    // Add the module and everything that isn't filtered out in the filter.
-                    writer.addPointer(moduleDecl);
+            // Write the AST information
 
+            if (moduleDecl)
+            {
+                // Put in AST module
+                RiffContainer::ScopeChunk scopeASTModule(
+                    container,
+                    RiffContainer::Chunk::Kind::List,
+                    ASTSerialBinary::kSlangASTModuleFourCC);
 
-                    // We can now serialize it into the riff container.
-                    SLANG_RETURN_ON_FAIL(writer.writeIntoContainer(
-                        ASTSerialBinary::kSlangASTModuleDataFourCC,
-                        container));
-                }
+                // We can now serialize it into the riff container.
+                SLANG_RETURN_ON_FAIL(astWriter->writeIntoContainer(
+                    ASTSerialBinary::kSlangASTModuleDataFourCC,
+                    container));
             }
         }
 
@@ -567,6 +626,7 @@ static List<ExtensionDecl*>& _getCandidateExtensionList(
             RefPtr<ASTBuilder> astBuilder = options.astBuilder;
             NodeBase* astRootNode = nullptr;
             RefPtr<IRModule> irModule;
+            RefPtr<IRSerialDeferredModule> deferredIRModule;
             SerialContainerData::Module module;
             if (auto headerChunk =
                     as<RiffContainer::DataChunk>(chunk, SerialBinary::kModuleHeaderFourCc))
@@ -600,13 +660,53 @@ static List<ExtensionDecl*>& _getCandidateExtensionList(
                         module.dependentFiles.add(file);
                     }
                 }
+                // Headers written before the macro list was added end after the file list.
+                uint32_t macroListLength = 0;
+                memStream.read(&macroListLength, sizeof(uint32_t), readSize);
+                if (readSize == sizeof(uint32_t))
+                {
+                    List<uint8_t> macroListContent;
+                    macroListContent.setCount(macroListLength);
+                    memStream.read(
+                        macroListContent.getBuffer(),
+                        macroListContent.getCount(),
+                        readSize);
+                    if (readSize != (size_t)macroListContent.getCount())
+                        return SLANG_FAIL;
+                    UnownedStringSlice macroListString(
+                        (const char*)macroListContent.getBuffer(),
+                        macroListContent.getCount());
+                    List<UnownedStringSlice> macroList;
+                    StringUtil::split(macroListString, '\n', macroList);
+                    for (auto macroName : macroList)
+                    {
+                        if (macroName.getLength())
+                        {
+                            module.defineDependencies.add(macroName);
+                        }
+                    }
+                }
+                // Headers written before the source digest was added end after the macro list.
+                memStream.read(module.sourceDigest.data, sizeof(SHA1::Digest), readSize);
+                if (readSize != sizeof(SHA1::Digest))
+                    module.sourceDigest = SHA1::Digest();
                 // Onto next chunk
                 chunk = chunk->m_next;
             }
 
             if (auto irChunk = as<RiffContainer::ListChunk>(chunk, IRSerialBinary::kIRModuleFourCc))
             {
-                if (!options.readHeaderOnly)
+                if (!options.readHeaderOnly && options.deferIRModule)
+                {
+                    deferredIRModule = new IRSerialDeferredModule;
+                    deferredIRModule->m_session = options.session;
+                    deferredIRModule->m_sourceLocReader = sourceLocReader;
+                    SLANG_RETURN_ON_FAIL(IRSerialReader::readContainer(
+                        irChunk,
+                        containerCompressionType,
+                        &deferredIRModule->m_serialData));
+                }
+                else if (!options.readHeaderOnly)
                 {
                     IRSerialData serialData;
                     SLANG_RETURN_ON_FAIL(IRSerialReader::readContainer(
@@ -882,11 +982,12 @@ static List<ExtensionDecl*>& _getCandidateExtensionList(
                 chunk = chunk->m_next;
             }
 
-            if (astBuilder || irModule)
+            if (astBuilder || irModule || deferredIRModule)
             {
                 module.astBuilder = astBuilder;
                 module.astRootNode = astRootNode;
                 module.irModule = irModule;
+                module.deferredIRModule = deferredIRModule;
 
                 out.modules.add(module);
             }
@@ -5,6 +5,7 @@
 #include "../core/slang-riff.h"
 #include "slang-ir-insts.h"
 #include "slang-profile.h"
+#include "slang-serialize-ir.h"
 #include "slang-serialize-types.h"
 
 namespace Slang
@@ -34,10 +35,17 @@ struct SerialContainerBinary
 struct SerialContainerDataModule
 {
     RefPtr<IRModule> irModule;       ///< The IR for the module
+    /// The IR for the module, if reading it into `irModule` was deferred
+    RefPtr<IRSerialDeferredModule> deferredIRModule;
     RefPtr<ASTBuilder> astBuilder;   ///< The astBuilder that owns the astRootNode
     NodeBase* astRootNode = nullptr; ///< The module decl
     List<String> dependentFiles;
+    /// Names of the macros (from the compile options) that `digest` depends on
+    List<String> defineDependencies;
     SHA1::Digest digest;
+    /// Digest of the dependent source files alone, without the compile options. Zero if the
+    /// module was written before this digest was recorded.
+    SHA1::Digest sourceDigest;
 };
 
 /* Struct that holds all the data that can be held in a 'container' */
@@ -91,6 +99,8 @@ struct SerialContainerUtil
             SerialOptionFlag::IRModule; ///< Flags controlling what is written
         SourceManager* sourceManager =
             nullptr; ///< The source manager used for the SourceLoc in the input
+        slang::ITaskScheduler_Experimental* taskScheduler =
+            nullptr; ///< Where work done in parallel is submitted (see `TaskUtil::runWorkers`)
     };
 
     struct ReadOptions
@@ -104,6 +114,8 @@ struct SerialContainerUtil
         Linkage* linkage = nullptr;
         DiagnosticSink* sink = nullptr;
         bool readHeaderOnly = false;
+        /// If set, a module's IR is read into `deferredIRModule` rather than `irModule`
+        bool deferIRModule = false;
         String modulePath;
     };
 
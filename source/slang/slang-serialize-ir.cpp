@@ -1050,4 +1050,10 @@ Result IRSerialReader::read(
     return SLANG_OK;
 }
 
+Result IRSerialDeferredModule::read(RefPtr<IRModule>& outModule)
+{
+    IRSerialReader reader;
+    return reader.read(m_serialData, m_session, m_sourceLocReader, outModule);
+}
+
 } // namespace Slang
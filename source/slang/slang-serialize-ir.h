@@ -120,6 +120,23 @@ protected:
     IRModule* m_module;
 };
 
+/// The IR for a module that has been read out of a container, but not yet turned into
+/// an `IRModule`.
+///
+/// Reading the instruction arrays out of a container is cheap compared to creating each
+/// of the instructions, so a module whose IR is deferred like this only pays for the
+/// latter if something (typically the linker) asks for its IR.
+class IRSerialDeferredModule : public RefObject
+{
+public:
+    /// Create the `IRModule` from the serialized data
+    Result read(RefPtr<IRModule>& outModule);
+
+    IRSerialData m_serialData;
+    Session* m_session = nullptr;
+    RefPtr<SerialSourceLocReader> m_sourceLocReader;
+};
+
 } // namespace Slang
 
 #endif
@@ -1926,8 +1926,41 @@ struct MetalArgumentBufferElementLayoutRulesImpl : ObjectLayoutRulesImpl, Defaul
     }
 };
 
+// In a tier-2 argument buffer, a buffer is stored as its GPU address, and a texture or sampler
+// as its `MTLResourceID`, both of which are 8 bytes.
+struct MetalArgumentBufferTier2ObjectLayoutRulesImpl : ObjectLayoutRulesImpl
+{
+    virtual ObjectLayoutInfo GetObjectLayout(ShaderParameterKind kind, const Options& /* options */)
+        override
+    {
+        switch (kind)
+        {
+        case ShaderParameterKind::ConstantBuffer:
+        case ShaderParameterKind::StructuredBuffer:
+        case ShaderParameterKind::MutableStructuredBuffer:
+        case ShaderParameterKind::RawBuffer:
+        case ShaderParameterKind::Buffer:
+        case ShaderParameterKind::MutableRawBuffer:
+        case ShaderParameterKind::MutableBuffer:
+        case ShaderParameterKind::MutableTexture:
+        case ShaderParameterKind::TextureUniformBuffer:
+        case ShaderParameterKind::Texture:
+        case ShaderParameterKind::SamplerState:
+            return SimpleLayoutInfo(LayoutResourceKind::Uniform, 8, 8);
+        case ShaderParameterKind::TextureSampler:
+        case ShaderParameterKind::AppendConsumeStructuredBuffer:
+        case ShaderParameterKind::MutableTextureSampler:
+            return SimpleLayoutInfo(LayoutResourceKind::Uniform, 16, 8);
+        default:
+            SLANG_UNEXPECTED("unhandled shader parameter kind");
+            UNREACHABLE_RETURN(SimpleLayoutInfo());
+        }
+    }
+};
+
 static MetalObjectLayoutRulesImpl kMetalObjectLayoutRulesImpl;
 static MetalArgumentBufferElementLayoutRulesImpl kMetalArgumentBufferElementLayoutRulesImpl;
+static MetalArgumentBufferTier2ObjectLayoutRulesImpl kMetalArgumentBufferTier2ObjectLayoutRulesImpl;
 static MetalLayoutRulesImpl kMetalLayoutRulesImpl;
 
 LayoutRulesImpl kMetalAnyValueLayoutRulesImpl_ = {
@@ -1948,6 +1981,12 @@ LayoutRulesImpl kMetalParameterBlockLayoutRulesImpl_ = {
     &kMetalArgumentBufferElementLayoutRulesImpl,
 };
 
+LayoutRulesImpl kMetalArgumentBufferTier2LayoutRulesImpl_ = {
+    &kMetalLayoutRulesFamilyImpl,
+    &kMetalLayoutRulesImpl,
+    &kMetalArgumentBufferTier2ObjectLayoutRulesImpl,
+};
+
 LayoutRulesImpl kMetalStructuredBufferLayoutRulesImpl_ = {
     &kMetalLayoutRulesFamilyImpl,
     &kMetalLayoutRulesImpl,
@@ -1976,8 +2015,11 @@ LayoutRulesImpl* MetalLayoutRulesFamilyImpl::getConstantBufferRules(CompilerOpti
     return &kMetalConstantBufferLayoutRulesImpl_;
 }
 
-LayoutRulesImpl* MetalLayoutRulesFamilyImpl::getParameterBlockRules(CompilerOptionSet&)
+LayoutRulesImpl* MetalLayoutRulesFamilyImpl::getParameterBlockRules(
+    CompilerOptionSet& compilerOptions)
 {
+    if (compilerOptions.getBoolOption(CompilerOptionName::MetalArgumentBufferTier2))
+        return &kMetalArgumentBufferTier2LayoutRulesImpl_;
     return &kMetalParameterBlockLayoutRulesImpl_;
 }
 
@@ -3669,6 +3711,9 @@ Type* findGlobalGenericSpecializationArg(
     TypeLayoutContext const& context,
     GlobalGenericParamDecl* decl)
 {
+    if (context.dependsOnContext)
+        *context.dependsOnContext = true;
+
     Val* arg = nullptr;
     context.programLayout->globalGenericArgs.tryGetValue(decl, arg);
     return as<Type>(arg);
@@ -4211,6 +4256,9 @@ static TypeLayoutResult _createTypeLayoutForGlobalGenericTypeParam(
     info.size = 0;
     info.kind = LayoutResourceKind::GenericResource;
 
+    if (context.dependsOnContext)
+        *context.dependsOnContext = true;
+
     RefPtr<GenericParamTypeLayout> typeLayout = new GenericParamTypeLayout();
     // we should have already populated ProgramLayout::genericEntryPointParams list at this point,
     // so we can find the index of this generic param decl in the list
@@ -4447,13 +4495,100 @@ static TypeLayoutResult _updateLayout(
     return result;
 }
 
+/// The `struct` type layouts created for a target, shared by all the programs laid out for it.
+///
+/// On a given target, the layout of a type only depends on the layout rules and the
+/// matrix layout mode, unless it refers to the global generic arguments of the program or
+/// to the specialization arguments in scope, which are checked for before a layout is shared.
+///
+struct TargetTypeLayoutCache : RefObject
+{
+    struct Key
+    {
+        Type* type;
+        LayoutRulesImpl* rules;
+        MatrixLayoutMode matrixLayoutMode;
+
+        HashCode getHashCode() const
+        {
+            Hasher hasher;
+            hasher.hashValue(type);
+            hasher.hashValue(rules);
+            hasher.hashValue(matrixLayoutMode);
+            return hasher.getResult();
+        }
+        bool operator==(Key const& other) const
+        {
+            return type == other.type && rules == other.rules &&
+                   matrixLayoutMode == other.matrixLayoutMode;
+        }
+    };
+
+    Dictionary<Key, TypeLayoutResult> layouts;
+};
+
+/// Get the cache that the layout of `type` can be shared through, if any.
+static TargetTypeLayoutCache* _getTargetTypeLayoutCache(TypeLayoutContext& context, Type* type)
+{
+    // Only `struct` layouts are shared. They are the ones that are expensive to
+    // create, and like the other layouts in `layoutMap` they are not changed once
+    // they are complete.
+    //
+    auto declRefType = as<DeclRefType>(type);
+    if (!declRefType || !declRefType->getDeclRef().as<StructDecl>())
+        return nullptr;
+    if (!context.targetReq || context.specializationArgCount != 0)
+        return nullptr;
+
+    auto cache = static_cast<TargetTypeLayoutCache*>(context.targetReq->getTypeLayoutCache());
+    if (!cache)
+    {
+        cache = new TargetTypeLayoutCache();
+        context.targetReq->setTypeLayoutCache(cache);
+    }
+    return cache;
+}
+
+static TypeLayoutResult _createTypeLayoutImpl(TypeLayoutContext& context, Type* type);
+
 static TypeLayoutResult _createTypeLayout(TypeLayoutContext& context, Type* type)
 {
+    auto cache = _getTargetTypeLayoutCache(context, type);
+    const TargetTypeLayoutCache::Key key = {type, context.rules, context.matrixLayoutMode};
+    if (cache)
+    {
+        if (auto cachedResult = cache->layouts.tryGetValue(key))
+            return *cachedResult;
+    }
+
     if (auto layoutResultPtr = context.layoutMap.tryGetValue(type))
     {
+        // The layout may still be in the middle of being built (for a type that
+        // refers to itself through a pointer), so anything using it can't be shared.
+        //
+        if (context.dependsOnContext)
+            *context.dependsOnContext = true;
         return *layoutResultPtr;
     }
 
+    if (!cache)
+        return _createTypeLayoutImpl(context, type);
+
+    bool* outerDependsOnContext = context.dependsOnContext;
+    bool dependsOnContext = false;
+    context.dependsOnContext = &dependsOnContext;
+    auto result = _createTypeLayoutImpl(context, type);
+    context.dependsOnContext = outerDependsOnContext;
+
+    if (!dependsOnContext)
+        cache->layouts.add(key, result);
+    else if (outerDependsOnContext)
+        *outerDependsOnContext = true;
+    return result;
+}
+
+static TypeLayoutResult _createTypeLayoutImpl(TypeLayoutContext& context, Type* type)
+{
     auto rules = context.rules;
 
     if (auto parameterGroupType = as<ParameterGroupType>(type))
@@ -5475,7 +5610,13 @@ RefPtr<TypeLayout> getSimpleVaryingParameterTypeLayout(
 
 RefPtr<TypeLayout> createTypeLayout(TypeLayoutContext& context, Type* type)
 {
-    return _createTypeLayout(context, type).layout;
+    // The outermost layout is never taken from the target's cache, because callers
+    // such as parameter binding may still add resource usage to it. Only the layouts
+    // nested inside it are shared.
+    //
+    if (auto layoutResultPtr = context.layoutMap.tryGetValue(type))
+        return layoutResultPtr->layout;
+    return _createTypeLayoutImpl(context, type).layout;
 }
 
 RefPtr<TypeLayout> createTypeLayoutWith(
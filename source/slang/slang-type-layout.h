@@ -927,6 +927,17 @@ public:
 
     /// Holds all of the string literals that have been hashed
     StringSlicePool hashedStringLiteralPool;
+
+    /// The type layouts of the global shader parameters that don't depend on any
+    /// specialization or global generic argument.
+    ///
+    /// A specialization of the program lays out its parameters again, but can reuse
+    /// these for every parameter that specialization didn't plug a type into.
+    ///
+    Dictionary<VarDeclBase*, RefPtr<TypeLayout>> contextFreeParameterTypeLayouts;
+
+    /// The results of looking up types and functions by name through reflection.
+    RefPtr<RefObject> nameLookupCache;
 };
 
 StructTypeLayout* getGlobalStructLayout(ProgramLayout* programLayout);
@@ -1178,6 +1189,12 @@ struct TypeLayoutContext
     // Map types to their type layout
     Dictionary<Type*, TypeLayoutResult> layoutMap;
 
+    // Set when a layout depends on more than its type, rules and matrix layout mode
+    // (on the global generic arguments of the program, or on a layout that is still
+    // being built), so that it can't be shared through the target's type layout cache.
+    //
+    bool* dependsOnContext = nullptr;
+
     // Options passed to object layout
     ObjectLayoutRulesImpl::Options objectLayoutOptions;
 
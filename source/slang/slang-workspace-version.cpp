@@ -35,8 +35,10 @@ DocumentVersion* Workspace::openDoc(String path, String text)
     doc->setText(text.getUnownedSlice());
     doc->setPath(path);
     openedDocuments[path] = doc;
-    workspaceSearchPaths.add(Path::getParentDirectory(path));
-    invalidate();
+    if (workspaceSearchPaths.add(Path::getParentDirectory(path)) || !searchInWorkspace)
+        invalidate();
+    else
+        invalidateDocument(path);
     return doc.Ptr();
 }
 
@@ -53,27 +55,29 @@ void Workspace::changeDoc(
         auto startOffset = doc->getOffset(line, col);
         doc->zeroBasedUTF16LocToOneBasedUTF8Loc(range.end.line, range.end.character, line, col);
         auto endOffset = doc->getOffset(line, col);
-        auto originalText = doc->getText().getUnownedSlice();
-        StringBuilder newText;
-        if (startOffset != -1)
-            newText << originalText.head(startOffset);
-        newText << text;
-        if (endOffset != -1)
-            newText << originalText.tail(endOffset);
-        changeDoc(doc.Ptr(), newText.produceString());
+        if (startOffset == -1)
+            startOffset = 0;
+        if (endOffset == -1)
+            endOffset = doc->getText().getLength();
+        doc->applyEdit(startOffset, endOffset, text.getUnownedSlice());
+        invalidateDocument(doc->getPath());
     }
 }
 
 void Workspace::changeDoc(DocumentVersion* doc, const String& newText)
 {
     doc->setText(newText);
-    invalidate();
+    invalidateDocument(doc->getPath());
 }
 
 void Workspace::closeDoc(const String& path)
 {
     openedDocuments.remove(path);
-    invalidate();
+    // Without workspace search the set of search paths depends on the opened documents.
+    if (searchInWorkspace)
+        invalidateDocument(path);
+    else
+        invalidate();
 }
 
 bool Workspace::updatePredefinedMacros(List<String> macros)
@@ -153,6 +157,17 @@ bool Workspace::updateSearchInWorkspace(bool value)
     return changed;
 }
 
+bool Workspace::updateModuleCachePath(const String& path)
+{
+    bool changed = moduleCachePath != path;
+    moduleCachePath = path;
+    if (changed)
+    {
+        invalidate();
+    }
+    return changed;
+}
+
 void Workspace::init(List<URI> rootDirURI, slang::IGlobalSession* globalSession)
 {
     for (auto uri : rootDirURI)
@@ -197,6 +212,23 @@ void Workspace::init(List<URI> rootDirURI, slang::IGlobalSession* globalSession)
 void Workspace::invalidate()
 {
     currentVersion = nullptr;
+    staleVersion = nullptr;
+    changedDocumentPaths.clear();
+}
+
+void Workspace::invalidateDocument(const String& path)
+{
+    // Keep the invalidated version around, so that the next version only needs to
+    // re-check the modules affected by the edited document.
+    if (currentVersion)
+    {
+        staleVersion = currentVersion;
+        currentVersion = nullptr;
+    }
+    String canonicalPath;
+    if (SLANG_FAILED(Path::getCanonical(path, canonicalPath)))
+        canonicalPath = path;
+    changedDocumentPaths.add(canonicalPath);
 }
 
 void WorkspaceVersion::parseDiagnostics(String compilerOutput)
@@ -348,6 +380,16 @@ RefPtr<WorkspaceVersion> Workspace::createWorkspaceVersion()
     }
     desc.preprocessorMacros = macroDescs.getBuffer();
 
+    slang::CompilerOptionEntry moduleCacheEntry;
+    if (moduleCachePath.getLength())
+    {
+        moduleCacheEntry.name = slang::CompilerOptionName::ModuleCachePath;
+        moduleCacheEntry.value.kind = slang::CompilerOptionValueKind::String;
+        moduleCacheEntry.value.stringValue0 = moduleCachePath.getBuffer();
+        desc.compilerOptionEntries = &moduleCacheEntry;
+        desc.compilerOptionEntryCount = 1;
+    }
+
     ComPtr<slang::ISession> session;
     slangGlobalSession->createSession(desc, session.writeRef());
     version->linkage = static_cast<Linkage*>(session.get());
@@ -369,8 +411,26 @@ SlangResult Workspace::loadFile(const char* path, ISlangBlob** outBlob)
 }
 WorkspaceVersion* Workspace::getCurrentVersion()
 {
-    if (!currentVersion)
+    if (currentVersion)
+        return currentVersion.Ptr();
+
+    // Unloaded modules stay allocated in the linkage's AST builder, so start over with a
+    // fresh linkage once the current one has been reused for many edits.
+    static const Index kMaxLinkageReuseCount = 64;
+    if (staleVersion && linkageReuseCount < kMaxLinkageReuseCount)
+    {
+        currentVersion = new WorkspaceVersion();
+        currentVersion->workspace = this;
+        currentVersion->reuseFrom(staleVersion, changedDocumentPaths);
+        linkageReuseCount++;
+    }
+    else
+    {
         currentVersion = createWorkspaceVersion();
+        linkageReuseCount = 0;
+    }
+    staleVersion = nullptr;
+    changedDocumentPaths.clear();
     return currentVersion.Ptr();
 }
 WorkspaceVersion* Workspace::createVersionForCompletion()
@@ -412,64 +472,165 @@ void DocumentVersion::setText(const String& newText)
     StringUtil::calcLines(text.getUnownedSlice(), lines);
     mapUTF16CharIndexToCodePointIndex.clear();
     mapCodePointIndexToUTF8ByteOffset.clear();
+    mapUTF16CharIndexToCodePointIndex.setCount(lines.getCount());
+    mapCodePointIndexToUTF8ByteOffset.setCount(lines.getCount());
 }
 
-void DocumentVersion::ensureUTFBoundsAvailable()
+Index DocumentVersion::_findLineIndex(Index offset)
 {
-    for (auto slice : lines)
+    auto firstGreater = std::upper_bound(
+        lines.begin(),
+        lines.end(),
+        offset,
+        [this](Index first, UnownedStringSlice second) { return first < getLineStart(second); });
+    return Math::Max(Index(firstGreater - lines.begin()) - 1, Index(0));
+}
+
+void DocumentVersion::applyEdit(Index startOffset, Index endOffset, UnownedStringSlice newText)
+{
+    const Index oldLength = text.getLength();
+    startOffset = Math::Clamp(startOffset, Index(0), oldLength);
+    endOffset = Math::Clamp(endOffset, startOffset, oldLength);
+
+    StringBuilder sb;
+    sb << text.getUnownedSlice().head(startOffset);
+    sb << newText;
+    sb << text.getUnownedSlice().tail(endOffset);
+
+    if (lines.getCount() == 0 || sb.getLength() == 0)
+    {
+        setText(sb.produceString());
+        return;
+    }
+
+    // The lines before the one preceding the edit are unchanged. Splitting starts from the line
+    // before the edit, since a line break just before the edit can pair with an inserted one.
+    const Index firstLine = Math::Max(_findLineIndex(startOffset) - 1, Index(0));
+    const Index splitStart = getLineStart(lines[firstLine]);
+    const Index delta = newText.getLength() - (endOffset - startOffset);
+    const Index editEnd = startOffset + newText.getLength();
+
+    // Keep the old text alive while its lines are rebased onto the new one.
+    String oldText = text;
+    text = sb.produceString();
+    const char* oldBegin = oldText.begin();
+    const char* newBegin = text.begin();
+
+    auto findOldLineStartingAt = [&](Index oldOffset) -> Index
+    {
+        auto firstNotLess = std::lower_bound(
+            lines.begin(),
+            lines.end(),
+            oldOffset,
+            [&](UnownedStringSlice line, Index offset)
+            { return line.begin() - oldBegin < offset; });
+        if (firstNotLess == lines.end() || firstNotLess->begin() - oldBegin != oldOffset)
+            return -1;
+        return Index(firstNotLess - lines.begin());
+    };
+
+    List<UnownedStringSlice> newLines;
+    List<List<Index>> newUTF16Maps;
+    List<List<Index>> newUTF8Maps;
+    newLines.reserve(lines.getCount());
+    newUTF16Maps.reserve(lines.getCount());
+    newUTF8Maps.reserve(lines.getCount());
+
+    for (Index i = 0; i < firstLine; i++)
     {
-        List<Index> bounds;
-        List<Index> utf8Bounds;
-        Index index = 0;
-        Index codePointIndex = 0;
-        while (index < slice.getLength())
+        const char* begin = newBegin + (lines[i].begin() - oldBegin);
+        newLines.add(UnownedStringSlice(begin, begin + lines[i].getLength()));
+        newUTF16Maps.add(_Move(mapUTF16CharIndexToCodePointIndex[i]));
+        newUTF8Maps.add(_Move(mapCodePointIndexToUTF8ByteOffset[i]));
+    }
+
+    // Split the new text from there until a line starts after the edit where an old line
+    // started. From that point the text is the same, so the remaining lines are too.
+    UnownedStringSlice remaining(newBegin + splitStart, newBegin + text.getLength());
+    Index firstKeptLine = -1;
+    UnownedStringSlice line;
+    while (StringUtil::extractLine(remaining, line))
+    {
+        newLines.add(line);
+        newUTF16Maps.add(List<Index>());
+        newUTF8Maps.add(List<Index>());
+
+        if (!remaining.begin())
+            break;
+        const Index nextLineStart = remaining.begin() - newBegin;
+        if (nextLineStart >= editEnd)
         {
-            auto startIndex = index;
-            const Char32 codePoint = getUnicodePointFromUTF8(
-                [&]() -> Byte
-                {
-                    if (index < slice.getLength())
-                        return slice[index++];
-                    else
-                        return '\0';
-                });
-            if (!codePoint)
+            firstKeptLine = findOldLineStartingAt(nextLineStart - delta);
+            if (firstKeptLine != -1)
                 break;
-
-            Char16 buffer[2];
-            int count = encodeUnicodePointToUTF16Reversed(codePoint, buffer);
-            for (int i = 0; i < count; i++)
-                bounds.add(codePointIndex);
-            utf8Bounds.add(startIndex);
-            codePointIndex++;
         }
-        bounds.add(slice.getLength());
-        utf8Bounds.add(slice.getLength());
-        mapUTF16CharIndexToCodePointIndex.add(_Move(bounds));
-        mapCodePointIndexToUTF8ByteOffset.add(_Move(utf8Bounds));
     }
+    if (firstKeptLine != -1)
+    {
+        for (Index i = firstKeptLine; i < lines.getCount(); i++)
+        {
+            const char* begin = newBegin + (lines[i].begin() - oldBegin) + delta;
+            newLines.add(UnownedStringSlice(begin, begin + lines[i].getLength()));
+            newUTF16Maps.add(_Move(mapUTF16CharIndexToCodePointIndex[i]));
+            newUTF8Maps.add(_Move(mapCodePointIndexToUTF8ByteOffset[i]));
+        }
+    }
+    lines = _Move(newLines);
+    mapUTF16CharIndexToCodePointIndex = _Move(newUTF16Maps);
+    mapCodePointIndexToUTF8ByteOffset = _Move(newUTF8Maps);
 }
 
-ArrayView<Index> DocumentVersion::getUTF16Boundaries(Index line)
+void DocumentVersion::ensureUTFBoundsAvailable(Index lineIndex)
 {
-    if (!mapUTF16CharIndexToCodePointIndex.getCount())
+    if (mapCodePointIndexToUTF8ByteOffset[lineIndex].getCount())
+        return;
+
+    auto slice = lines[lineIndex];
+    List<Index> bounds;
+    List<Index> utf8Bounds;
+    Index index = 0;
+    Index codePointIndex = 0;
+    while (index < slice.getLength())
     {
-        ensureUTFBoundsAvailable();
+        auto startIndex = index;
+        const Char32 codePoint = getUnicodePointFromUTF8(
+            [&]() -> Byte
+            {
+                if (index < slice.getLength())
+                    return slice[index++];
+                else
+                    return '\0';
+            });
+        if (!codePoint)
+            break;
+
+        Char16 buffer[2];
+        int count = encodeUnicodePointToUTF16Reversed(codePoint, buffer);
+        for (int i = 0; i < count; i++)
+            bounds.add(codePointIndex);
+        utf8Bounds.add(startIndex);
+        codePointIndex++;
     }
-    return line >= 1 && line <= mapUTF16CharIndexToCodePointIndex.getCount()
-               ? mapUTF16CharIndexToCodePointIndex[line - 1].getArrayView()
-               : ArrayView<Index>();
+    bounds.add(slice.getLength());
+    utf8Bounds.add(slice.getLength());
+    mapUTF16CharIndexToCodePointIndex[lineIndex] = _Move(bounds);
+    mapCodePointIndexToUTF8ByteOffset[lineIndex] = _Move(utf8Bounds);
+}
+
+ArrayView<Index> DocumentVersion::getUTF16Boundaries(Index line)
+{
+    if (line < 1 || line > lines.getCount())
+        return ArrayView<Index>();
+    ensureUTFBoundsAvailable(line - 1);
+    return mapUTF16CharIndexToCodePointIndex[line - 1].getArrayView();
 }
 
 ArrayView<Index> DocumentVersion::getUTF8Boundaries(Index line)
 {
-    if (!mapCodePointIndexToUTF8ByteOffset.getCount())
-    {
-        ensureUTFBoundsAvailable();
-    }
-    return line >= 1 && line <= mapCodePointIndexToUTF8ByteOffset.getCount()
-               ? mapCodePointIndexToUTF8ByteOffset[line - 1].getArrayView()
-               : ArrayView<Index>();
+    if (line < 1 || line > lines.getCount())
+        return ArrayView<Index>();
+    ensureUTFBoundsAvailable(line - 1);
+    return mapCodePointIndexToUTF8ByteOffset[line - 1].getArrayView();
 }
 
 void DocumentVersion::oneBasedUTF8LocToZeroBasedUTF16Loc(
@@ -596,6 +757,20 @@ void WorkspaceVersion::ensureWorkspaceFlavor(UnownedStringSlice path)
     }
 }
 
+bool WorkspaceVersion::checkOpenedDocuments(const std::function<bool()>& shouldStop)
+{
+    for (const auto& [path, _] : workspace->openedDocuments)
+    {
+        // A document that failed to load is not tried again for this version.
+        if (modules.containsKey(path) || !backgroundCheckedPaths.add(path))
+            continue;
+        getOrLoadModule(path);
+        if (shouldStop())
+            return false;
+    }
+    return true;
+}
+
 Module* WorkspaceVersion::getOrLoadModule(String path)
 {
     Module* module;
@@ -643,6 +818,65 @@ Module* WorkspaceVersion::getOrLoadModule(String path)
     return static_cast<Module*>(parsedModule);
 }
 
+static bool _isSourceFileChanged(SourceFile* sourceFile, const HashSet<String>& changedPaths)
+{
+    auto& pathInfo = sourceFile->getPathInfo();
+    if (!pathInfo.hasFoundPath())
+        return false;
+    String canonicalPath;
+    if (SLANG_FAILED(Path::getCanonical(pathInfo.foundPath, canonicalPath)))
+        canonicalPath = pathInfo.foundPath;
+    return changedPaths.contains(canonicalPath);
+}
+
+void WorkspaceVersion::reuseFrom(
+    WorkspaceVersion* previousVersion,
+    const HashSet<String>& changedPaths)
+{
+    linkage = previousVersion->linkage;
+    flavor = previousVersion->flavor;
+
+    // Find every loaded module that has a changed file among its (transitive) file
+    // dependencies. Such a module has to be parsed and checked again.
+    HashSet<Module*> modulesToUnload;
+    for (const auto& module : linkage->loadedModulesList)
+    {
+        for (auto sourceFile : module->getFileDependencies())
+        {
+            if (_isSourceFileChanged(sourceFile, changedPaths))
+            {
+                modulesToUnload.add(module.Ptr());
+                break;
+            }
+        }
+    }
+    linkage->unloadModules(modulesToUnload);
+
+    // Make sure the changed files are read again instead of being found in the source manager.
+    auto sourceManager = linkage->getSourceManager();
+    for (auto sourceFile : sourceManager->getSourceFiles())
+    {
+        if (!_isSourceFileChanged(sourceFile, changedPaths))
+            continue;
+        auto& pathInfo = sourceFile->getPathInfo();
+        if (pathInfo.hasUniqueIdentity())
+            sourceManager->removeSourceFile(pathInfo.uniqueIdentity);
+        sourceManager->removeSourceFile(pathInfo.getMostUniqueIdentity());
+    }
+
+    for (const auto& [path, module] : previousVersion->modules)
+    {
+        if (modulesToUnload.contains(module))
+            continue;
+        modules[path] = module;
+        if (auto docDiagnostics = previousVersion->diagnostics.tryGetValue(path))
+            diagnostics[path] = *docDiagnostics;
+        RefPtr<ASTMarkup> astMarkup;
+        if (previousVersion->markupASTs.tryGetValue(module->getModuleDecl(), astMarkup))
+            markupASTs[module->getModuleDecl()] = astMarkup;
+    }
+}
+
 MacroDefinitionContentAssistInfo* WorkspaceVersion::tryGetMacroDefinition(UnownedStringSlice name)
 {
     if (macroDefinitions.getCount() == 0)
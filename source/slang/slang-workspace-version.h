@@ -9,6 +9,8 @@
 #include "slang-doc-ast.h"
 #include "slang.h"
 
+#include <functional>
+
 namespace Slang
 {
 class Workspace;
@@ -20,9 +22,14 @@ private:
     String path;
     String text;
     List<UnownedStringSlice> lines;
+    // Per-line column maps, with one entry per line. A map is computed when its line is first
+    // queried, and is empty until then.
     List<List<Index>> mapUTF16CharIndexToCodePointIndex;
     List<List<Index>> mapCodePointIndexToUTF8ByteOffset;
 
+    // Get the zero-based index of the line containing `offset`.
+    Index _findLineIndex(Index offset);
+
 public:
     void setPath(String filePath)
     {
@@ -34,7 +41,14 @@ public:
     const String& getText() { return text; }
     void setText(const String& newText);
 
-    void ensureUTFBoundsAvailable();
+    /// Replace the bytes in [startOffset, endOffset) with `newText`.
+    ///
+    /// Only the lines around the edit are split again, and the column maps of the other lines
+    /// are kept, so the cost of an edit does not depend on the number of lines in the document.
+    void applyEdit(Index startOffset, Index endOffset, UnownedStringSlice newText);
+
+    // Compute the column maps of the zero-based line `lineIndex`, if not computed yet.
+    void ensureUTFBoundsAvailable(Index lineIndex);
     ArrayView<Index> getUTF16Boundaries(Index line);
     ArrayView<Index> getUTF8Boundaries(Index line);
 
@@ -141,6 +155,8 @@ private:
     Dictionary<String, Module*> modules;
     Dictionary<ModuleDecl*, RefPtr<ASTMarkup>> markupASTs;
     Dictionary<Name*, MacroDefinitionContentAssistInfo*> macroDefinitions;
+    // Opened documents that `checkOpenedDocuments` has already tried to load.
+    HashSet<String> backgroundCheckedPaths;
     void parseDiagnostics(String compilerOutput);
 
 public:
@@ -152,6 +168,19 @@ public:
     Module* getOrLoadModule(String path);
     void ensureWorkspaceFlavor(UnownedStringSlice path);
     MacroDefinitionContentAssistInfo* tryGetMacroDefinition(UnownedStringSlice name);
+
+    /// Load and check the opened documents that no request has needed yet, so that their
+    /// diagnostics are available, until `shouldStop` returns true after a document.
+    ///
+    /// Returns true if every opened document has been checked.
+    bool checkOpenedDocuments(const std::function<bool()>& shouldStop);
+
+    /// Set up this version to share the linkage of `previousVersion`, in which only the
+    /// documents at `changedPaths` have been edited.
+    ///
+    /// Modules that depend on a changed file are unloaded, so they are checked again when
+    /// requested. All other modules, along with their diagnostics, are carried over.
+    void reuseFrom(WorkspaceVersion* previousVersion, const HashSet<String>& changedPaths);
 };
 
 struct OwnedPreprocessorMacroDefinition
@@ -166,12 +195,22 @@ private:
     RefPtr<WorkspaceVersion> currentCompletionVersion;
     RefPtr<WorkspaceVersion> createWorkspaceVersion();
 
+    // The version invalidated by document edits, whose linkage the next version may reuse,
+    // and the canonical paths of the documents edited since it was current.
+    RefPtr<WorkspaceVersion> staleVersion;
+    HashSet<String> changedDocumentPaths;
+    // The number of consecutive versions that have shared the current linkage.
+    Index linkageReuseCount = 0;
+
 public:
     List<String> rootDirectories;
     List<String> additionalSearchPaths;
     OrderedHashSet<String> workspaceSearchPaths;
     List<OwnedPreprocessorMacroDefinition> predefinedMacros;
     bool searchInWorkspace = true;
+    // The module cache directory of the workspace's builds, from which imported modules whose
+    // sources are unchanged are loaded instead of being checked from source.
+    String moduleCachePath;
 
     slang::IGlobalSession* slangGlobalSession;
     Dictionary<String, RefPtr<DocumentVersion>> openedDocuments;
@@ -186,9 +225,11 @@ public:
     bool updatePredefinedMacros(List<String> predefinedMacros);
     bool updateSearchPaths(List<String> searchPaths);
     bool updateSearchInWorkspace(bool value);
+    bool updateModuleCachePath(const String& path);
 
     void init(List<URI> rootDirURI, slang::IGlobalSession* globalSession);
     void invalidate();
+    void invalidateDocument(const String& path);
     WorkspaceVersion* getCurrentVersion();
     WorkspaceVersion* getCurrentCompletionVersion() { return currentCompletionVersion.Ptr(); }
     WorkspaceVersion* createVersionForCompletion();
@@ -2,10 +2,12 @@
 
 #include "../core/slang-archive-file-system.h"
 #include "../core/slang-castable.h"
+#include "../core/slang-char-util.h"
 #include "../core/slang-io.h"
 #include "../core/slang-performance-profiler.h"
 #include "../core/slang-shared-library.h"
 #include "../core/slang-string-util.h"
+#include "../core/slang-task-util.h"
 #include "../core/slang-type-convert-util.h"
 #include "../core/slang-type-text-util.h"
 // Artifact
@@ -21,6 +23,7 @@
 #include "slang-ast-dump.h"
 #include "slang-check-impl.h"
 #include "slang-check.h"
+#include "slang-compile-task.h"
 #include "slang-doc-ast.h"
 #include "slang-doc-markdown-writer.h"
 #include "slang-lookup.h"
@@ -31,14 +34,18 @@
 #include "slang-parameter-binding.h"
 #include "slang-parser.h"
 #include "slang-preprocessor.h"
+#include "slang-reflection-blob-writer.h"
 #include "slang-reflection-json.h"
 #include "slang-repro.h"
 #include "slang-serialize-ast.h"
 #include "slang-serialize-container.h"
 #include "slang-serialize-ir.h"
+#include "slang-serialize-source-loc.h"
 #include "slang-tag-version.h"
 #include "slang-type-layout.h"
 
+#include <atomic>
+#include <mutex>
 #include <sys/stat.h>
 
 // Used to print exception type names in internal-compiler-error messages
@@ -166,6 +173,27 @@ void Session::init()
     DownstreamCompilerUtil::setDefaultLocators(m_downstreamCompilerLocators);
     m_downstreamCompilerSet = new DownstreamCompilerSet;
 
+    {
+        StringBuilder cachePath;
+        if (SLANG_SUCCEEDED(PlatformUtil::getEnvironmentVariable(
+                toSlice("SLANG_DOWNSTREAM_CACHE_PATH"),
+                cachePath)) &&
+            cachePath.getLength())
+        {
+            PersistentCache::Desc cacheDesc;
+            cacheDesc.directory = cachePath.getBuffer();
+
+            // Store the results in pack files, which are cheaper to create and copy around
+            // than a file per result.
+            StringBuilder usePackFiles;
+            cacheDesc.usePackFiles = SLANG_SUCCEEDED(PlatformUtil::getEnvironmentVariable(
+                                         toSlice("SLANG_DOWNSTREAM_CACHE_PACK_FILES"),
+                                         usePackFiles)) &&
+                                     usePackFiles.getLength() && usePackFiles != "0";
+            m_persistentDownstreamCompileResults = new PersistentCache(cacheDesc);
+        }
+    }
+
     // Initialize name pool
     getNamePool()->setRootNamePool(getRootNamePool());
     m_completionTokenName = getNamePool()->getName("#?");
@@ -423,6 +451,54 @@ SlangResult Session::compileCoreModule(slang::CompileCoreModuleFlags compileFlag
     return SLANG_OK;
 }
 
+// Extract the serialized module `moduleName` from a builtin module archive.
+static SlangResult _loadBuiltinModuleBlob(
+    const void* archive,
+    size_t archiveSizeInBytes,
+    const String& moduleName,
+    ComPtr<ISlangBlob>& outBlob)
+{
+    // Make a file system to read it from
+    ComPtr<ISlangFileSystemExt> fileSystem;
+    SLANG_RETURN_ON_FAIL(loadArchiveFileSystem(archive, archiveSizeInBytes, fileSystem));
+
+    StringBuilder moduleFilename;
+    moduleFilename << moduleName << ".slang-module";
+    return fileSystem->loadFile(moduleFilename.getBuffer(), outBlob.writeRef());
+}
+
+// Get the serialized core module held in the archive at `archive`.
+//
+// Extracting the module means decompressing it out of the archive. When the
+// archive is the embedded core module, which lives as long as the process,
+// every global session would extract exactly the same data, so the result is
+// extracted once and shared. Blobs are immutable and use atomic reference
+// counts, so sharing them between global sessions on different threads is safe.
+static SlangResult _loadCoreModuleBlob(
+    const void* archive,
+    size_t archiveSizeInBytes,
+    ComPtr<ISlangBlob>& outBlob)
+{
+    ISlangBlob* embeddedCoreModule = slang_getEmbeddedCoreModule();
+    if (!embeddedCoreModule || embeddedCoreModule->getBufferPointer() != archive ||
+        embeddedCoreModule->getBufferSize() != archiveSizeInBytes)
+    {
+        return _loadBuiltinModuleBlob(archive, archiveSizeInBytes, "core", outBlob);
+    }
+
+    static std::mutex mutex;
+    static ComPtr<ISlangBlob> embeddedCoreModuleBlob;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!embeddedCoreModuleBlob)
+    {
+        SLANG_RETURN_ON_FAIL(
+            _loadBuiltinModuleBlob(archive, archiveSizeInBytes, "core", embeddedCoreModuleBlob));
+    }
+    outBlob = embeddedCoreModuleBlob;
+    return SLANG_OK;
+}
+
 SlangResult Session::loadCoreModule(const void* coreModule, size_t coreModuleSizeInBytes)
 {
     SLANG_PROFILE;
@@ -435,17 +511,43 @@ SlangResult Session::loadCoreModule(const void* coreModule, size_t coreModuleSiz
 
     SLANG_AST_BUILDER_RAII(m_builtinLinkage->getASTBuilder());
 
-    // Make a file system to read it from
-    ComPtr<ISlangFileSystemExt> fileSystem;
-    SLANG_RETURN_ON_FAIL(loadArchiveFileSystem(coreModule, coreModuleSizeInBytes, fileSystem));
+    ComPtr<ISlangBlob> coreModuleBlob;
+    SLANG_RETURN_ON_FAIL(_loadCoreModuleBlob(coreModule, coreModuleSizeInBytes, coreModuleBlob));
 
     // Let's try loading serialized modules and adding them
-    SLANG_RETURN_ON_FAIL(_readBuiltinModule(fileSystem, coreLanguageScope, "core"));
+    SLANG_RETURN_ON_FAIL(_readBuiltinModule(coreModuleBlob, coreLanguageScope, "core"));
+
+    // The `glsl` module saved with the core module is only extracted if something imports it.
+    // That can only wait if the archive outlives this call, as the embedded one does.
+    ISlangBlob* embeddedCoreModule = slang_getEmbeddedCoreModule();
+    if (embeddedCoreModule && embeddedCoreModule->getBufferPointer() == coreModule &&
+        embeddedCoreModule->getBufferSize() == coreModuleSizeInBytes)
+    {
+        m_embeddedCoreModuleArchive = coreModule;
+        m_embeddedCoreModuleArchiveSize = coreModuleSizeInBytes;
+    }
 
     finalizeSharedASTBuilder();
     return SLANG_OK;
 }
 
+SlangResult Session::getPrecompiledGLSLModule(ComPtr<ISlangBlob>& outBlob)
+{
+    if (!m_hasTriedPrecompiledGLSLModule && m_embeddedCoreModuleArchive)
+    {
+        m_hasTriedPrecompiledGLSLModule = true;
+        _loadBuiltinModuleBlob(
+            m_embeddedCoreModuleArchive,
+            m_embeddedCoreModuleArchiveSize,
+            "glsl",
+            m_precompiledGLSLModule);
+    }
+    if (!m_precompiledGLSLModule)
+        return SLANG_E_NOT_AVAILABLE;
+    outBlob = m_precompiledGLSLModule;
+    return SLANG_OK;
+}
+
 SlangResult Session::saveCoreModule(SlangArchiveType archiveType, ISlangBlob** outBlob)
 {
     if (m_builtinLinkage->mapNameToLoadedModules.getCount() == 0)
@@ -467,8 +569,20 @@ SlangResult Session::saveCoreModule(SlangArchiveType archiveType, ISlangBlob** o
 
     SLANG_AST_BUILDER_RAII(m_builtinLinkage->getASTBuilder());
 
+    // The `glsl` module is saved too, so that sessions importing it can load it instead of
+    // checking its source. It isn't part of the core module, so it is only loaded on import.
+    {
+        DiagnosticSink sink(m_builtinLinkage->getSourceManager(), Lexer::sourceLocationLexer);
+        auto glslName = m_builtinLinkage->getNamePool()->getName("glsl");
+        m_builtinLinkage->findOrImportModule(glslName, SourceLoc(), &sink);
+    }
+
     for (const auto& [moduleName, module] : m_builtinLinkage->mapNameToLoadedModules)
     {
+        // A module that failed to load is recorded as null.
+        if (!module)
+            continue;
+
         // Set up options
         SerialContainerUtil::WriteOptions options;
 
@@ -497,27 +611,15 @@ SlangResult Session::saveCoreModule(SlangArchiveType archiveType, ISlangBlob** o
     return SLANG_OK;
 }
 
-SlangResult Session::_readBuiltinModule(
-    ISlangFileSystem* fileSystem,
-    Scope* scope,
-    String moduleName)
+SlangResult Session::_readBuiltinModule(ISlangBlob* moduleBlob, Scope* scope, String moduleName)
 {
-    // Get the name of the module
-    StringBuilder moduleFilename;
-    moduleFilename << moduleName << ".slang-module";
-
+    // Note that the container references the module data in place rather
+    // than holding a copy of it, so `moduleBlob` must outlive it.
     RiffContainer riffContainer;
-    {
-        // Load it
-        ComPtr<ISlangBlob> blob;
-        SLANG_RETURN_ON_FAIL(fileSystem->loadFile(moduleFilename.getBuffer(), blob.writeRef()));
-
-        // Set up a stream
-        MemoryStreamBase stream(FileAccess::Read, blob->getBufferPointer(), blob->getBufferSize());
-
-        // Load the riff container
-        SLANG_RETURN_ON_FAIL(RiffUtil::read(&stream, riffContainer));
-    }
+    SLANG_RETURN_ON_FAIL(RiffUtil::readInPlace(
+        moduleBlob->getBufferPointer(),
+        moduleBlob->getBufferSize(),
+        riffContainer));
 
     // Load up the module
 
@@ -549,6 +651,8 @@ SlangResult Session::_readBuiltinModule(
         RefPtr<Module> module(new Module(linkage, srcModule.astBuilder));
         module->setName(moduleName);
         module->setDigest(srcModule.digest);
+        for (const auto& macroName : srcModule.defineDependencies)
+            module->addDefineDependency(macroName);
 
         ModuleDecl* moduleDecl = as<ModuleDecl>(srcModule.astRootNode);
         // Set the module back reference on the decl
@@ -689,6 +793,8 @@ Session::createSession(slang::SessionDesc const& inDesc, slang::ISession** outSe
         linkage->setFileSystem(desc.fileSystem);
     }
 
+    linkage->m_taskScheduler = desc.taskScheduler;
+
     if (desc.structureSize >= offsetof(slang::SessionDesc, enableEffectAnnotations))
     {
         linkage->m_optionSet.set(
@@ -790,6 +896,7 @@ Session::setLanguagePrelude(SlangSourceLanguage inSourceLanguage, char const* pr
     if (sourceLanguage != SourceLanguage::Unknown)
     {
         m_languagePreludes[int(sourceLanguage)] = prelude;
+        m_downstreamCompilerDigestsValid = 0;
     }
 }
 
@@ -1147,13 +1254,90 @@ ISlangUnknown* Linkage::getInterface(const Guid& guid)
 {
     if (guid == ISlangUnknown::getTypeGuid() || guid == ISession::getTypeGuid())
         return asExternal(this);
+    if (guid == ISessionMemory_Experimental::getTypeGuid())
+        return static_cast<slang::ISessionMemory_Experimental*>(this);
+    if (guid == ISessionReload_Experimental::getTypeGuid())
+        return static_cast<slang::ISessionReload_Experimental*>(this);
 
     return nullptr;
 }
 
+SLANG_NO_THROW void SLANG_MCALL Linkage::setMemoryBudget(size_t budgetInBytes)
+{
+    SLANG_LINKAGE_API_LOCK(this);
+    m_memoryTracker->setBudget(budgetInBytes);
+}
+
+SLANG_NO_THROW SlangResult SLANG_MCALL
+Linkage::getMemoryStats(slang::SessionMemoryStats* outStats)
+{
+    if (!outStats || outStats->structureSize < sizeof(slang::SessionMemoryStats))
+        return SLANG_E_INVALID_ARG;
+
+    SLANG_LINKAGE_API_LOCK(this);
+    calcMemoryStats(*outStats);
+    return SLANG_OK;
+}
+
+void Linkage::calcMemoryStats(slang::SessionMemoryStats& outStats, size_t codeGenIRBytes)
+{
+    m_memoryTracker->getStats(outStats);
+    outStats.loadedModuleCount = loadedModulesList.getCount();
+
+    // Modules usually share the AST builder of the linkage, so each builder is only
+    // counted once.
+    HashSet<ASTBuilder*> astBuilders;
+    astBuilders.add(m_astBuilder);
+
+    outStats.astBytes = 0;
+    outStats.irBytes = 0;
+    outStats.irContainerPoolBytes = ContainerPool::getThreadLocal().calcMemoryUsed();
+    outStats.stringPoolBytes = getSourceManager()->getStringSlicePool().calcMemoryUsed();
+    for (auto module : loadedModulesList)
+    {
+        if (auto astBuilder = module->getASTBuilder())
+            astBuilders.add(astBuilder);
+        if (auto irModule = module->getExistingIRModule())
+            outStats.irBytes += irModule->getMemoryArena().calcTotalMemoryAllocated();
+        outStats.stringPoolBytes += module->getMangledExportPool().calcMemoryUsed();
+    }
+    for (auto astBuilder : astBuilders)
+        outStats.astBytes += astBuilder->getArena().calcTotalMemoryAllocated();
+
+    m_memoryTracker->updatePeaks(outStats, codeGenIRBytes);
+}
+
+void Linkage::appendMemoryReport(const slang::SessionMemoryStats& stats, StringBuilder& out)
+{
+    out << "AST: " << UInt64(stats.astBytes) << " bytes\n";
+    out << "IR: " << UInt64(stats.irBytes) << " bytes\n";
+    out << "IR container pools: " << UInt64(stats.irContainerPoolBytes) << " bytes\n";
+    out << "String pools: " << UInt64(stats.stringPoolBytes) << " bytes\n";
+    out << "Target code: " << UInt64(stats.targetCodeBytes) << " bytes in "
+        << Int64(stats.targetCodeCount) << " results\n";
+    out << "Loaded modules: " << Int64(stats.loadedModuleCount) << "\n";
+    out << "Peak code generation IR: " << UInt64(stats.peakCodeGenIRBytes) << " bytes\n";
+    out << "Peak total: " << UInt64(stats.peakTotalBytes) << " bytes\n";
+}
+
+SLANG_NO_THROW void SLANG_MCALL Linkage::trimMemory()
+{
+    SLANG_LINKAGE_API_LOCK(this);
+    m_memoryTracker->evictAll();
+
+    // The type layouts shared between programs are recreated as programs are laid out
+    // again, while the layouts already handed out stay alive through their programs.
+    for (auto target : targets)
+        target->setTypeLayoutCache(nullptr);
+}
+
 Linkage::~Linkage()
 {
     destroyTypeCheckingCache();
+
+    // A module waiting to be lowered holds its translation unit, which holds the module.
+    for (auto module : loadedModulesList)
+        module->discardDeferredIRTranslationUnit();
 }
 
 SearchDirectoryList& Linkage::getSearchDirectories()
@@ -1183,6 +1367,38 @@ void Linkage::destroyTypeCheckingCache()
     m_typeCheckingCache = nullptr;
 }
 
+SharedTypeCheckingCache* Session::getSharedTypeCheckingCache()
+{
+    if (!m_sharedTypeCheckingCache)
+    {
+        m_sharedTypeCheckingCache = new SharedTypeCheckingCache();
+    }
+    return m_sharedTypeCheckingCache;
+}
+
+ISlangBlob* Session::findDownstreamCompileResult(const SHA1::Digest& key)
+{
+    if (auto result = m_downstreamCompileResults.tryGetValue(key))
+        return *result;
+
+    ComPtr<ISlangBlob> result;
+    if (m_persistentDownstreamCompileResults &&
+        SLANG_SUCCEEDED(m_persistentDownstreamCompileResults->readEntry(key, result.writeRef())))
+    {
+        m_downstreamCompileResults[key] = result;
+        return result;
+    }
+    return nullptr;
+}
+
+void Session::addDownstreamCompileResult(const SHA1::Digest& key, ISlangBlob* result)
+{
+    m_downstreamCompileResults[key] = result;
+
+    if (m_persistentDownstreamCompileResults)
+        m_persistentDownstreamCompileResults->writeEntry(key, result);
+}
+
 SLANG_NO_THROW slang::IGlobalSession* SLANG_MCALL Linkage::getGlobalSession()
 {
     return asExternal(getSessionImpl());
@@ -1222,6 +1438,7 @@ SLANG_NO_THROW slang::ITarget* SLANG_MCALL Linkage::getTargetByIndex(SlangInt in
 SLANG_NO_THROW slang::IModule* SLANG_MCALL
 Linkage::loadModule(const char* moduleName, slang::IBlob** outDiagnostics)
 {
+    SLANG_LINKAGE_API_LOCK(this);
     SLANG_AST_BUILDER_RAII(getASTBuilder());
 
     DiagnosticSink sink(getSourceManager(), Lexer::sourceLocationLexer);
@@ -1231,6 +1448,7 @@ Linkage::loadModule(const char* moduleName, slang::IBlob** outDiagnostics)
     {
         sink.setFlags(DiagnosticSink::Flag::HumaneLoc | DiagnosticSink::Flag::LanguageServer);
     }
+    sink.setCountOnlyIfNoBlob(outDiagnostics);
 
     try
     {
@@ -1255,6 +1473,7 @@ slang::IModule* Linkage::loadModuleFromBlob(
     ModuleBlobType blobType,
     slang::IBlob** outDiagnostics)
 {
+    SLANG_LINKAGE_API_LOCK(this);
     SLANG_AST_BUILDER_RAII(getASTBuilder());
 
     DiagnosticSink sink(getSourceManager(), Lexer::sourceLocationLexer);
@@ -1264,6 +1483,7 @@ slang::IModule* Linkage::loadModuleFromBlob(
     {
         sink.setFlags(DiagnosticSink::Flag::HumaneLoc | DiagnosticSink::Flag::LanguageServer);
     }
+    sink.setCountOnlyIfNoBlob(outDiagnostics);
 
 
     try
@@ -1345,6 +1565,7 @@ SLANG_NO_THROW SlangResult SLANG_MCALL Linkage::createCompositeComponentType(
     slang::IComponentType** outCompositeComponentType,
     ISlangBlob** outDiagnostics)
 {
+    SLANG_LINKAGE_API_LOCK(this);
     if (outCompositeComponentType == nullptr)
         return SLANG_E_INVALID_ARG;
 
@@ -1384,6 +1605,7 @@ SLANG_NO_THROW slang::TypeReflection* SLANG_MCALL Linkage::specializeType(
     SlangInt specializationArgCount,
     ISlangBlob** outDiagnostics)
 {
+    SLANG_LINKAGE_API_LOCK(this);
     SLANG_AST_BUILDER_RAII(getASTBuilder());
 
     auto unspecializedType = asInternal(inUnspecializedType);
@@ -1564,6 +1786,7 @@ SLANG_NO_THROW slang::TypeLayoutReflection* SLANG_MCALL Linkage::getTypeLayout(
     slang::LayoutRules rules,
     ISlangBlob** outDiagnostics)
 {
+    SLANG_LINKAGE_API_LOCK(this);
     SLANG_AST_BUILDER_RAII(getASTBuilder());
 
     auto type = asInternal(inType);
@@ -1596,6 +1819,7 @@ SLANG_NO_THROW slang::TypeReflection* SLANG_MCALL Linkage::getContainerType(
     slang::ContainerType containerType,
     ISlangBlob** outDiagnostics)
 {
+    SLANG_LINKAGE_API_LOCK(this);
     SLANG_AST_BUILDER_RAII(getASTBuilder());
 
     auto type = asInternal(inType);
@@ -1647,6 +1871,7 @@ SLANG_NO_THROW slang::TypeReflection* SLANG_MCALL Linkage::getContainerType(
 
 SLANG_NO_THROW slang::TypeReflection* SLANG_MCALL Linkage::getDynamicType()
 {
+    SLANG_LINKAGE_API_LOCK(this);
     SLANG_AST_BUILDER_RAII(getASTBuilder());
 
     return asExternal(getASTBuilder()->getSharedASTBuilder()->getDynamicType());
@@ -1655,6 +1880,7 @@ SLANG_NO_THROW slang::TypeReflection* SLANG_MCALL Linkage::getDynamicType()
 SLANG_NO_THROW SlangResult SLANG_MCALL
 Linkage::getTypeRTTIMangledName(slang::TypeReflection* type, ISlangBlob** outNameBlob)
 {
+    SLANG_LINKAGE_API_LOCK(this);
     SLANG_AST_BUILDER_RAII(getASTBuilder());
 
     auto internalType = asInternal(type);
@@ -1673,6 +1899,7 @@ SLANG_NO_THROW SlangResult SLANG_MCALL Linkage::getTypeConformanceWitnessMangled
     slang::TypeReflection* interfaceType,
     ISlangBlob** outNameBlob)
 {
+    SLANG_LINKAGE_API_LOCK(this);
     SLANG_AST_BUILDER_RAII(getASTBuilder());
 
     auto subType = asInternal(type);
@@ -1688,6 +1915,7 @@ SLANG_NO_THROW SlangResult SLANG_MCALL Linkage::getTypeConformanceWitnessSequent
     slang::TypeReflection* interfaceType,
     uint32_t* outId)
 {
+    SLANG_LINKAGE_API_LOCK(this);
     SLANG_AST_BUILDER_RAII(getASTBuilder());
 
     auto subType = asInternal(type);
@@ -1726,6 +1954,7 @@ SLANG_NO_THROW SlangResult SLANG_MCALL Linkage::createTypeConformanceComponentTy
     SlangInt conformanceIdOverride,
     ISlangBlob** outDiagnostics)
 {
+    SLANG_LINKAGE_API_LOCK(this);
     if (outConformanceComponentType == nullptr)
         return SLANG_E_INVALID_ARG;
 
@@ -1769,11 +1998,13 @@ Linkage::createCompileRequest(SlangCompileRequest** outCompileRequest)
 
 SLANG_NO_THROW SlangInt SLANG_MCALL Linkage::getLoadedModuleCount()
 {
+    SLANG_LINKAGE_API_LOCK(this);
     return loadedModulesList.getCount();
 }
 
 SLANG_NO_THROW slang::IModule* SLANG_MCALL Linkage::getLoadedModule(SlangInt index)
 {
+    SLANG_LINKAGE_API_LOCK(this);
     if (index >= 0 && index < loadedModulesList.getCount())
         return loadedModulesList[index].get();
     return nullptr;
@@ -1792,39 +2023,10 @@ void Linkage::buildHash(DigestBuilder<SHA1>& builder, SlangInt targetIndex)
     {
         targetReq->getOptionSet().buildHash(builder);
 
+        // Add the prelude and version of the downstream compiler for the target.
         const PassThroughMode passThroughMode =
             getDownstreamCompilerRequiredForTarget(targetReq->getTarget());
-        const SourceLanguage sourceLanguage =
-            getDefaultSourceLanguageForDownstreamCompiler(passThroughMode);
-
-        // Add prelude for the given downstream compiler.
-        ComPtr<ISlangBlob> prelude;
-        getGlobalSession()->getLanguagePrelude(
-            (SlangSourceLanguage)sourceLanguage,
-            prelude.writeRef());
-        if (prelude)
-        {
-            builder.append(prelude);
-        }
-
-        // TODO: Downstream compilers (specifically dxc) can currently #include additional
-        // dependencies. This is currently the case for NVAPI headers included in the prelude. These
-        // dependencies are currently not picked up by the shader cache which is a significant
-        // issue. This can only be fixed by running the preprocessor in the slang compiler so dxc
-        // (or any other downstream compiler for that matter) isn't resolving any includes
-        // implicitly.
-
-        // Add the downstream compiler version (if it exists) to the hash
-        auto downstreamCompiler =
-            getSessionImpl()->getOrLoadDownstreamCompiler(passThroughMode, nullptr);
-        if (downstreamCompiler)
-        {
-            ComPtr<ISlangBlob> versionString;
-            if (SLANG_SUCCEEDED(downstreamCompiler->getVersionString(versionString.writeRef())))
-            {
-                builder.append(versionString);
-            }
-        }
+        builder.append(getSessionImpl()->getDownstreamCompilerDigest(passThroughMode));
     };
 
     // Add the target specified by targetIndex
@@ -2722,6 +2924,17 @@ protected:
         m_module->addFileDependency(sourceFile);
     }
 
+    // Similarly, we capture the macros whose definitions from the compile options
+    // could affect the module, so that the module digest can ignore any others.
+    //
+    void _addDefineDependencies(Preprocessor* preprocessor)
+    {
+        List<Name*> macroNames;
+        getDefineDependencies(preprocessor, macroNames);
+        for (auto macroName : macroNames)
+            m_module->addDefineDependency(getText(macroName));
+    }
+
     // The second task that this handler deals with is detecting
     // whether any macro values were set in a given source file
     // that are semantically relevant to other stages of compilation.
@@ -2799,6 +3012,9 @@ protected:
                 addModifier(moduleDecl, modifier);
             }
         }
+
+        // This is done last, so that it includes the macros looked up above.
+        _addDefineDependencies(preprocessor);
     }
 
     /// Validate that a re-defintion of an NVAPI-related macro matches any previous definition
@@ -3003,7 +3219,9 @@ static void _outputIncludes(
 
 void FrontEndCompileRequest::parseTranslationUnit(TranslationUnitRequest* translationUnit)
 {
-    SLANG_PROFILE;
+    SLANG_PROFILE_SECTION_TAGGED(
+        parseTranslationUnit,
+        getText(translationUnit->moduleName).getUnownedSlice());
     if (translationUnit->isChecked)
         return;
 
@@ -3020,7 +3238,8 @@ void FrontEndCompileRequest::parseTranslationUnit(TranslationUnitRequest* transl
     IncludeSystem includeSystem(
         &linkage->getSearchDirectories(),
         linkage->getFileSystemExt(),
-        linkage->getSourceManager());
+        linkage->getSourceManager(),
+        linkage->getMissingFilePathTracker());
 
     auto combinedPreprocessorDefinitions = translationUnit->getCombinedPreprocessorDefinitions();
 
@@ -3174,6 +3393,12 @@ void FrontEndCompileRequest::checkAllTranslationUnits()
     if (additionalLoadedModules)
         loadedModules = *additionalLoadedModules;
 
+    // Checking imports modules one at a time, each found, read and parsed before the next
+    // is looked at, so the files of the whole import graph are read ahead of it.
+    Linkage::ImportedModuleFilesPrefetchRAII prefetchImportedModuleFiles(
+        getLinkage(),
+        translationUnits);
+
     // Iterate over all translation units and
     // apply the semantic checking logic.
     for (auto& translationUnit : translationUnits)
@@ -3296,11 +3521,69 @@ static SourceLanguage inferSourceLanguage(FrontEndCompileRequest* request)
     return language;
 }
 
+void FrontEndCompileRequest::loadTranslationUnitSourcesInParallel()
+{
+    auto linkage = getLinkage();
+    if (linkage->m_fileSystem || linkage->m_requireCacheFileSystem)
+        return;
+
+    // Find the source files that are going to be read from disk.
+    //
+    List<IArtifact*> artifacts;
+    List<String> paths;
+    for (TranslationUnitRequest* translationUnit : translationUnits)
+    {
+        for (auto& artifact : translationUnit->getSourceArtifacts())
+        {
+            if (findRepresentation<ISlangBlob>(artifact))
+                continue;
+            auto pathRep = findRepresentation<IPathArtifactRepresentation>(artifact);
+            if (!pathRep || pathRep->getPathType() != SLANG_PATH_TYPE_FILE)
+                continue;
+            artifacts.add(artifact);
+            paths.add(pathRep->getPath());
+        }
+    }
+    const Index fileCount = paths.getCount();
+    if (fileCount < 2)
+        return;
+
+    List<ComPtr<ISlangBlob>> blobs;
+    blobs.setCount(fileCount);
+
+    // Each worker only touches its own slots, and the OS file system holds no state.
+    //
+    ISlangFileSystemExt* fileSystem = OSFileSystem::getExtSingleton();
+    std::atomic<Index> nextFileIndex(0);
+    auto worker = [&]()
+    {
+        for (Index i = nextFileIndex++; i < fileCount; i = nextFileIndex++)
+        {
+            fileSystem->loadFile(paths[i].getBuffer(), blobs[i].writeRef());
+        }
+    };
+    TaskUtil::runWorkers(
+        linkage->m_taskScheduler,
+        TaskUtil::calcExtraWorkerCount(fileCount),
+        worker);
+
+    // Once an artifact holds its contents, `requireSourceFiles` uses them instead of
+    // reading the file again.
+    //
+    for (Index i = 0; i < fileCount; ++i)
+    {
+        if (blobs[i])
+            artifacts[i]->addRepresentationUnknown(blobs[i]);
+    }
+}
+
 SlangResult FrontEndCompileRequest::executeActionsInner()
 {
     SLANG_PROFILE_SECTION(frontEndExecute);
     SLANG_AST_BUILDER_RAII(getLinkage()->getASTBuilder());
 
+    loadTranslationUnitSourcesInParallel();
+
     for (TranslationUnitRequest* translationUnit : translationUnits)
     {
         // Make sure SourceFile representation is available for all translationUnits
@@ -3350,17 +3633,17 @@ SlangResult FrontEndCompileRequest::executeActionsInner()
     if (getSink()->getErrorCount() != 0)
         return SLANG_FAIL;
 
-    // We always generate IR for all the translation units.
-    //
-    // TODO: We may eventually have a mode where we skip
-    // IR codegen and only produce an AST (e.g., for use when
-    // debugging problems in the parser or semantic checking),
-    // but for now there are no cases where not having IR
-    // makes sense.
+    // We generate IR for all the translation units, unless only
+    // reflection information was requested. Parameter binding works
+    // from the checked AST, so it does not need the IR.
     //
-    generateIR();
-    if (getSink()->getErrorCount() != 0)
-        return SLANG_FAIL;
+    const bool isReflectionOnly = optionSet.getBoolOption(CompilerOptionName::ReflectionOnly);
+    if (!isReflectionOnly)
+    {
+        generateIR();
+        if (getSink()->getErrorCount() != 0)
+            return SLANG_FAIL;
+    }
 
     // Do parameter binding generation, for each compilation target.
     //
@@ -3368,7 +3651,8 @@ SlangResult FrontEndCompileRequest::executeActionsInner()
     {
         auto targetProgram = m_globalAndEntryPointsComponentType->getTargetProgram(targetReq);
         targetProgram->getOrCreateLayout(getSink());
-        targetProgram->getOrCreateIRModuleForLayout(getSink());
+        if (!isReflectionOnly)
+            targetProgram->getOrCreateIRModuleForLayout(getSink());
     }
     if (getSink()->getErrorCount() != 0)
         return SLANG_FAIL;
@@ -3477,7 +3761,11 @@ SlangResult EndToEndCompileRequest::executeActionsInner()
     // If command line specifies to skip codegen, we exit here.
     // Note: this is a debugging option.
     //
-    if (getOptionSet().getBoolOption(CompilerOptionName::SkipCodeGen))
+    // There is no IR to generate code from in reflection-only mode,
+    // so we stop at the same point.
+    //
+    if (getOptionSet().getBoolOption(CompilerOptionName::SkipCodeGen) ||
+        getOptionSet().getBoolOption(CompilerOptionName::ReflectionOnly))
     {
         // We will use the program (and matching layout information)
         // that was computed in the front-end for all subsequent
@@ -3760,6 +4048,10 @@ void Linkage::loadParsedModule(
         // Ideally we want to run those passes, but that is too risky for what it is worth right
         // now.
     }
+    else if (m_optionSet.getBoolOption(CompilerOptionName::ReflectionOnly))
+    {
+        // Only reflection information was requested, which doesn't need IR.
+    }
     else
     {
         if (errorCountAfter != errorCountBefore)
@@ -3772,8 +4064,11 @@ void Linkage::loadParsedModule(
             // IR code for the imported module.
             if (errorCountAfter == 0)
             {
-                loadedModule->setIRModule(
-                    generateIRForTranslationUnit(getASTBuilder(), translationUnit));
+                if (m_optionSet.getBoolOption(CompilerOptionName::LazyImportLowering))
+                    loadedModule->setDeferredIRTranslationUnit(translationUnit);
+                else
+                    loadedModule->setIRModule(
+                        generateIRForTranslationUnit(getASTBuilder(), translationUnit));
             }
         }
     }
@@ -3802,6 +4097,112 @@ RefPtr<Module> Linkage::loadDeserializedModule(
     return resultModule;
 }
 
+void Linkage::unloadModules(const HashSet<Module*>& modules)
+{
+    if (modules.getCount() == 0)
+        return;
+
+    List<String> pathsToRemove;
+    for (const auto& [path, module] : mapPathToLoadedModule)
+    {
+        if (modules.contains(module.Ptr()))
+            pathsToRemove.add(path);
+    }
+    for (const auto& path : pathsToRemove)
+        mapPathToLoadedModule.remove(path);
+
+    List<Name*> namesToRemove;
+    for (const auto& [name, module] : mapNameToLoadedModules)
+    {
+        if (modules.contains(module.Ptr()))
+            namesToRemove.add(name);
+    }
+    for (auto name : namesToRemove)
+        mapNameToLoadedModules.remove(name);
+
+    List<RefPtr<LoadedModule>> remainingModules;
+    for (const auto& module : loadedModulesList)
+    {
+        if (!modules.contains(module.Ptr()))
+            remainingModules.add(module);
+    }
+    loadedModulesList = _Move(remainingModules);
+
+    // Cached checking results may refer to declarations of the unloaded modules.
+    destroyTypeCheckingCache();
+}
+
+SLANG_NO_THROW slang::IModule* SLANG_MCALL Linkage::reloadModule(
+    const char* moduleName,
+    slang::IBlob* source,
+    slang::IBlob** outDiagnostics)
+{
+    SLANG_LINKAGE_API_LOCK(this);
+
+    RefPtr<LoadedModule> previousModule;
+    if (!mapNameToLoadedModules.tryGetValue(getNamePool()->getName(moduleName), previousModule))
+    {
+        if (source)
+            return loadModuleFromSource(moduleName, "", source, outDiagnostics);
+        return loadModule(moduleName, outDiagnostics);
+    }
+
+    // The modules that import the previous version, directly or indirectly, refer to its
+    // declarations, and so have to be checked again along with it.
+    HashSet<Module*> modulesToUnload;
+    modulesToUnload.add(previousModule.Ptr());
+    for (const auto& module : loadedModulesList)
+    {
+        if (module->getModuleDependencies().contains(previousModule.Ptr()))
+            modulesToUnload.add(module.Ptr());
+    }
+
+    // The files that only the unloaded modules depend on are read again when they are next
+    // loaded, so that edits to included files are seen too.
+    HashSet<SourceFile*> keptFiles;
+    for (const auto& module : loadedModulesList)
+    {
+        if (modulesToUnload.contains(module.Ptr()))
+            continue;
+        for (auto sourceFile : module->getFileDependencies())
+            keptFiles.add(sourceFile);
+    }
+    auto sourceManager = getSourceManager();
+    for (auto module : modulesToUnload)
+    {
+        for (auto sourceFile : module->getFileDependencies())
+        {
+            if (keptFiles.contains(sourceFile))
+                continue;
+            auto& pathInfo = sourceFile->getPathInfo();
+            if (pathInfo.hasUniqueIdentity())
+                sourceManager->removeSourceFile(pathInfo.uniqueIdentity);
+            sourceManager->removeSourceFile(pathInfo.getMostUniqueIdentity());
+        }
+    }
+    if (!m_fileSystem && !m_requireCacheFileSystem)
+        getSessionImpl()->getSharedOSFileSystemCache()->invalidateChanged();
+
+    String path;
+    if (auto filePath = previousModule->getFilePath())
+        path = filePath;
+    m_memoryTracker->evictUsingModules(modulesToUnload);
+    unloadModules(modulesToUnload);
+
+    ComPtr<slang::IBlob> sourceBlob(source);
+    if (!sourceBlob)
+    {
+        // A module that wasn't loaded from a source file, such as a precompiled module, is
+        // found again the same way that importing it would.
+        if (Path::getPathExt(path) != "slang" ||
+            SLANG_FAILED(m_fileSystemExt->loadFile(path.getBuffer(), sourceBlob.writeRef())))
+        {
+            return loadModule(moduleName, outDiagnostics);
+        }
+    }
+    return loadModuleFromSource(moduleName, path.getBuffer(), sourceBlob.get(), outDiagnostics);
+}
+
 RefPtr<Module> Linkage::loadModuleFromIRBlobImpl(
     Name* name,
     const PathInfo& filePathInfo,
@@ -3820,13 +4221,14 @@ RefPtr<Module> Linkage::loadModuleFromIRBlobImpl(
     SLANG_ASSERT(mostUniqueIdentity.getLength() > 0);
 
     RiffContainer container;
-    MemoryStreamBase readStream(
-        FileAccess::Read,
+    SLANG_RETURN_NULL_ON_FAIL(RiffUtil::readInPlace(
         fileContentsBlob->getBufferPointer(),
-        fileContentsBlob->getBufferSize());
-    SLANG_RETURN_NULL_ON_FAIL(RiffUtil::read(&readStream, container));
+        fileContentsBlob->getBufferSize(),
+        container));
 
-    if (m_optionSet.getBoolOption(CompilerOptionName::UseUpToDateBinaryModule))
+    // The language server must not use a module whose sources have since been edited.
+    if (m_optionSet.getBoolOption(CompilerOptionName::UseUpToDateBinaryModule) ||
+        isInLanguageServer())
     {
         if (!isBinaryModuleUpToDate(filePathInfo.foundPath, &container))
             return nullptr;
@@ -3844,6 +4246,9 @@ RefPtr<Module> Linkage::loadModuleFromIRBlobImpl(
     readOptions.sourceManager = getSourceManager();
     readOptions.namePool = getNamePool();
     readOptions.modulePath = filePathInfo.foundPath;
+    // Most of the cost of loading a module's IR is in creating its instructions, which isn't
+    // needed unless the module ends up being linked into a program.
+    readOptions.deferIRModule = true;
     SerialContainerData containerData;
     if (SLANG_FAILED(SerialContainerUtil::read(
             &container,
@@ -3896,6 +4301,8 @@ RefPtr<Module> Linkage::loadModule(
     const LoadedModuleDictionary* additionalLoadedModules,
     ModuleBlobType blobType)
 {
+    SLANG_PROFILE_SECTION_TAGGED(loadModule, getText(name).getUnownedSlice());
+
     if (blobType == ModuleBlobType::IR)
         return loadModuleFromIRBlobImpl(
             name,
@@ -4085,7 +4492,11 @@ RefPtr<Module> Linkage::findOrImportModule(
     // Next, try to find the file of the given name,
     // using our ordinary include-handling logic.
 
-    IncludeSystem includeSystem(&getSearchDirectories(), getFileSystemExt(), getSourceManager());
+    IncludeSystem includeSystem(
+        &getSearchDirectories(),
+        getFileSystemExt(),
+        getSourceManager(),
+        getMissingFilePathTracker());
 
     // Get the original path info
     PathInfo pathIncludedFromInfo = getSourceManager()->getPathInfo(loc, SourceLocType::Actual);
@@ -4097,10 +4508,6 @@ RefPtr<Module> Linkage::findOrImportModule(
 
     for (auto checkBinaryModule : shouldCheckBinaryModuleSettings)
     {
-        // When in language server, we always prefer to use source module if it is available.
-        if (isInLanguageServer())
-            checkBinaryModule = !checkBinaryModule;
-
         // Try without translating `_` to `-` first, if that fails, try translating.
         for (int translateUnderScore = 0; translateUnderScore <= 1; translateUnderScore++)
         {
@@ -4119,10 +4526,15 @@ RefPtr<Module> Linkage::findOrImportModule(
             {
                 if (name && name->text == "glsl")
                 {
-                    // This is a builtin glsl module, just load it from embedded definition.
-                    fileContents = getSessionImpl()->getGLSLLibraryCode();
+                    // This is a builtin glsl module. Load the one saved with the core module
+                    // if there is one, and otherwise check its embedded definition.
                     filePathInfo = PathInfo::makeFromString("glsl");
-                    checkBinaryModule = 0;
+                    if (checkBinaryModule == 0 ||
+                        SLANG_FAILED(getSessionImpl()->getPrecompiledGLSLModule(fileContents)))
+                    {
+                        fileContents = getSessionImpl()->getGLSLLibraryCode();
+                        checkBinaryModule = 0;
+                    }
                 }
                 else
                 {
@@ -4136,12 +4548,49 @@ RefPtr<Module> Linkage::findOrImportModule(
                     loadedModule))
                 return loadedModule;
 
+            // A file that was read ahead of time is added to the source manager, where
+            // loading it finds it.
+            ComPtr<ISlangBlob> prefetchedContents;
+            if (!fileContents && filePathInfo.hasUniqueIdentity() &&
+                m_prefetchedModuleFiles.tryGetValue(
+                    filePathInfo.uniqueIdentity,
+                    prefetchedContents))
+            {
+                auto sourceManager = getSourceManager();
+                if (!sourceManager->findSourceFileRecursively(filePathInfo.uniqueIdentity))
+                {
+                    auto sourceFile =
+                        sourceManager->createSourceFileWithBlob(filePathInfo, prefetchedContents);
+                    sourceManager->addSourceFile(filePathInfo.uniqueIdentity, sourceFile);
+                }
+            }
+
             // Try to load it
             if (!fileContents && SLANG_FAILED(includeSystem.loadFile(filePathInfo, fileContents)))
             {
                 continue;
             }
 
+            // If a module cache is in use, a previous compilation may already have
+            // checked this module and stored its serialized form, in which case we
+            // can skip the front-end work for it entirely.
+            String cacheFilePath;
+            if (checkBinaryModule == 0)
+            {
+                cacheFilePath = getModuleCacheFilePath(filePathInfo);
+                if (cacheFilePath.getLength())
+                {
+                    if (auto cachedModule = loadModuleFromCache(
+                            name,
+                            filePathInfo,
+                            cacheFilePath,
+                            loc,
+                            sink,
+                            loadedModules))
+                        return cachedModule;
+                }
+            }
+
             // We've found a file that we can load for the given module, so
             // go ahead and perform the module-load action
             auto resultModule = loadModule(
@@ -4153,7 +4602,14 @@ RefPtr<Module> Linkage::findOrImportModule(
                 loadedModules,
                 (checkBinaryModule == 1 ? ModuleBlobType::IR : ModuleBlobType::Source));
             if (resultModule)
+            {
+                // Failing to write the cache entry is not an error, the module
+                // will just be compiled from source again next time. The language
+                // server does not generate IR, so it only reads the cache.
+                if (cacheFilePath.getLength() && !isInLanguageServer())
+                    resultModule->writeToCacheFile(cacheFilePath);
                 return resultModule;
+            }
         }
     }
 
@@ -4163,53 +4619,319 @@ RefPtr<Module> Linkage::findOrImportModule(
     return nullptr;
 }
 
-SourceFile* Linkage::loadSourceFile(String pathFrom, String path)
+/// Find the file `findOrImportModule` would load for the module `name` imported from
+/// `pathIncludedFrom`, other than the embedded `glsl` module.
+static SlangResult _findImportedModuleFile(
+    IncludeSystem& includeSystem,
+    Name* name,
+    const String& pathIncludedFrom,
+    PathInfo& outPathInfo)
 {
-    IncludeSystem includeSystem(&getSearchDirectories(), getFileSystemExt(), getSourceManager());
-    ComPtr<slang::IBlob> blob;
-    PathInfo pathInfo;
-    SLANG_RETURN_NULL_ON_FAIL(includeSystem.findFile(path, pathFrom, pathInfo));
-    SourceFile* sourceFile = nullptr;
-    SLANG_RETURN_NULL_ON_FAIL(includeSystem.loadFile(pathInfo, blob, sourceFile));
-    return sourceFile;
+    for (bool checkBinaryModule : {true, false})
+    {
+        for (bool translateUnderScore : {false, true})
+        {
+            auto fileName = getFileNameFromModuleName(name, translateUnderScore);
+            if (checkBinaryModule)
+                fileName = Path::replaceExt(fileName, "slang-module");
+            if (SLANG_SUCCEEDED(includeSystem.findFile(fileName, pathIncludedFrom, outPathInfo)))
+                return SLANG_OK;
+        }
+    }
+    return SLANG_E_NOT_FOUND;
 }
 
-// Check if a serialized module is up-to-date with current compiler options and source files.
-bool Linkage::isBinaryModuleUpToDate(String fromPath, RiffContainer* container)
+/// Skip a string literal starting at `cursor`. Returns false if it isn't closed on its line.
+static bool _skipStringLiteral(const char*& cursor, const char* end)
 {
-    DiagnosticSink sink;
-    SerialContainerUtil::ReadOptions readOptions;
-    readOptions.linkage = this;
-    readOptions.astBuilder = getASTBuilder();
-    readOptions.session = getSessionImpl();
-    readOptions.sharedASTBuilder = getASTBuilder()->getSharedASTBuilder();
-    readOptions.sink = &sink;
-    readOptions.sourceManager = getSourceManager();
-    readOptions.namePool = getNamePool();
-    readOptions.readHeaderOnly = true;
-
-    SerialContainerData containerData;
-    if (SLANG_FAILED(SerialContainerUtil::read(container, readOptions, nullptr, containerData)))
-        return false;
-
-    if (containerData.modules.getCount() != 1)
+    for (cursor++; cursor < end && *cursor != '"' && *cursor != '\n'; cursor++)
+    {
+        if (*cursor == '\\' && cursor + 1 < end)
+            cursor++;
+    }
+    if (cursor >= end || *cursor != '"')
         return false;
+    cursor++;
+    return true;
+}
 
-    auto& moduleHeader = containerData.modules[0];
-    DigestBuilder<SHA1> digestBuilder;
-    auto version = String(getBuildTagString());
-    digestBuilder.append(version);
-    m_optionSet.buildHash(digestBuilder);
+/// Find the names of the modules that the `import` declarations in `text` name, in the form
+/// the parser gives them.
+///
+/// Nothing is preprocessed, so an import that is disabled is found, and one that a macro
+/// produces isn't. The names are only used to read files ahead of time, so either just
+/// costs a read.
+static void _scanImportedModuleNames(UnownedStringSlice text, List<String>& outNames)
+{
+    const char* cursor = text.begin();
+    const char* const end = text.end();
 
-    // Find the canonical path of the directory containing the module source file.
-    String moduleSrcPath = "";
-    if (moduleHeader.dependentFiles.getCount())
+    auto isIdentifierStart = [](char c) { return CharUtil::isAlpha(c) || c == '_'; };
+    auto skipSpaceAndComments = [&]()
     {
-        moduleSrcPath = moduleHeader.dependentFiles.getFirst();
-        IncludeSystem includeSystem(
+        while (cursor < end)
+        {
+            if (CharUtil::isWhitespace(*cursor))
+            {
+                cursor++;
+            }
+            else if (cursor + 1 < end && cursor[0] == '/' && cursor[1] == '/')
+            {
+                while (cursor < end && *cursor != '\n')
+                    cursor++;
+            }
+            else if (cursor + 1 < end && cursor[0] == '/' && cursor[1] == '*')
+            {
+                for (cursor += 2; cursor + 1 < end && !(cursor[0] == '*' && cursor[1] == '/');)
+                    cursor++;
+                cursor = Math::Min(cursor + 2, end);
+            }
+            else
+            {
+                break;
+            }
+        }
+    };
+    auto readIdentifier = [&]()
+    {
+        const char* start = cursor;
+        while (cursor < end && (CharUtil::isAlphaOrDigit(*cursor) || *cursor == '_'))
+            cursor++;
+        return UnownedStringSlice(start, cursor);
+    };
+
+    while (cursor < end)
+    {
+        skipSpaceAndComments();
+        if (cursor >= end)
+            break;
+        if (*cursor == '"')
+        {
+            _skipStringLiteral(cursor, end);
+            continue;
+        }
+        if (!isIdentifierStart(*cursor))
+        {
+            // Skipping a number whole keeps a suffix such as the `f` of `1.0f` from being
+            // read as a word.
+            if (CharUtil::isDigit(*cursor))
+                readIdentifier();
+            else
+                cursor++;
+            continue;
+        }
+        const UnownedStringSlice word = readIdentifier();
+        if (word != toSlice("import") && word != toSlice("__import"))
+            continue;
+
+        // As in the parser, a dotted name such as `a.b` names the module `a/b`.
+        skipSpaceAndComments();
+        StringBuilder name;
+        if (cursor < end && *cursor == '"')
+        {
+            const char* start = cursor + 1;
+            if (!_skipStringLiteral(cursor, end))
+                continue;
+            name << UnownedStringSlice(start, cursor - 1);
+        }
+        else if (cursor < end && isIdentifierStart(*cursor))
+        {
+            name << readIdentifier();
+            for (;;)
+            {
+                skipSpaceAndComments();
+                if (cursor >= end || *cursor != '.')
+                    break;
+                cursor++;
+                skipSpaceAndComments();
+                if (cursor >= end || !isIdentifierStart(*cursor))
+                    break;
+                name << "/" << readIdentifier();
+            }
+        }
+        else
+        {
+            continue;
+        }
+        skipSpaceAndComments();
+        if (cursor < end && *cursor == ';' && name.getLength())
+            outNames.add(name.produceString());
+    }
+}
+
+void Linkage::_prefetchImportedModuleFiles(
+    List<RefPtr<TranslationUnitRequest>> const& translationUnits)
+{
+    if (m_fileSystem || m_requireCacheFileSystem)
+        return;
+
+    struct PendingImport
+    {
+        Name* name;
+        String pathIncludedFrom;
+    };
+    List<PendingImport> imports;
+
+    auto sourceManager = getSourceManager();
+    auto addImportDecls = [&](ContainerDecl* containerDecl)
+    {
+        for (auto importDecl : containerDecl->getMembersOfType<ImportDecl>())
+        {
+            auto pathInfo =
+                sourceManager->getPathInfo(importDecl->moduleNameAndLoc.loc, SourceLocType::Actual);
+            imports.add({importDecl->moduleNameAndLoc.name, pathInfo.foundPath});
+        }
+    };
+    for (auto& translationUnit : translationUnits)
+    {
+        if (translationUnit->isChecked)
+            continue;
+        auto moduleDecl = translationUnit->getModuleDecl();
+        if (!moduleDecl)
+            continue;
+        addImportDecls(moduleDecl);
+        for (auto fileDecl : moduleDecl->getMembersOfType<FileDecl>())
+            addImportDecls(fileDecl);
+    }
+
+    // Missing files aren't tracked here: `findOrImportModule` probes the same paths for the
+    // imports that are real.
+    IncludeSystem includeSystem(&getSearchDirectories(), getFileSystemExt(), sourceManager);
+    ISlangFileSystemExt* fileSystem = OSFileSystem::getExtSingleton();
+    HashSet<String> visitedFiles;
+
+    while (imports.getCount())
+    {
+        // Find the files of this level of the graph that haven't been read.
+        //
+        List<PathInfo> pathInfos;
+        for (auto& import : imports)
+        {
+            if (mapNameToLoadedModules.containsKey(import.name))
+                continue;
+            PathInfo pathInfo;
+            if (SLANG_FAILED(_findImportedModuleFile(
+                    includeSystem,
+                    import.name,
+                    import.pathIncludedFrom,
+                    pathInfo)) ||
+                !pathInfo.hasUniqueIdentity() || !visitedFiles.add(pathInfo.uniqueIdentity))
+                continue;
+            if (mapPathToLoadedModule.containsKey(pathInfo.getMostUniqueIdentity()) ||
+                sourceManager->findSourceFileRecursively(pathInfo.uniqueIdentity))
+                continue;
+            pathInfos.add(pathInfo);
+        }
+        imports.clear();
+
+        const Index fileCount = pathInfos.getCount();
+        List<ComPtr<ISlangBlob>> blobs;
+        blobs.setCount(fileCount);
+        List<List<String>> importedNames;
+        importedNames.setCount(fileCount);
+
+        // Each worker only touches its own slots, and the OS file system holds no state.
+        //
+        std::atomic<Index> nextFileIndex(0);
+        auto worker = [&]()
+        {
+            for (Index i = nextFileIndex++; i < fileCount; i = nextFileIndex++)
+            {
+                const String& path = pathInfos[i].foundPath;
+                if (SLANG_FAILED(fileSystem->loadFile(path.getBuffer(), blobs[i].writeRef())))
+                    continue;
+                if (Path::getPathExt(path) != "slang-module")
+                    _scanImportedModuleNames(StringUtil::getSlice(blobs[i]), importedNames[i]);
+            }
+        };
+        TaskUtil::runWorkers(m_taskScheduler, TaskUtil::calcExtraWorkerCount(fileCount), worker);
+
+        for (Index i = 0; i < fileCount; ++i)
+        {
+            if (!blobs[i])
+                continue;
+            m_prefetchedModuleFiles[pathInfos[i].uniqueIdentity] = blobs[i];
+            for (auto& importedName : importedNames[i])
+                imports.add({getNamePool()->getName(importedName), pathInfos[i].foundPath});
+        }
+    }
+}
+
+SourceFile* Linkage::loadSourceFile(String pathFrom, String path)
+{
+    IncludeSystem includeSystem(
+        &getSearchDirectories(),
+        getFileSystemExt(),
+        getSourceManager(),
+        getMissingFilePathTracker());
+    ComPtr<slang::IBlob> blob;
+    PathInfo pathInfo;
+    SLANG_RETURN_NULL_ON_FAIL(includeSystem.findFile(path, pathFrom, pathInfo));
+    SourceFile* sourceFile = nullptr;
+    SLANG_RETURN_NULL_ON_FAIL(includeSystem.loadFile(pathInfo, blob, sourceFile));
+    return sourceFile;
+}
+
+static bool _hasSourceLocations(RiffContainer* container)
+{
+    auto containerChunk = container->getRoot()->findListRec(SerialBinary::kContainerFourCc);
+    return containerChunk && containerChunk->findContainedList(SerialSourceLocData::kDebugFourCc);
+}
+
+// Check if a serialized module is up-to-date with current compiler options and source files.
+//
+// The language server only uses the AST of a serialized module, which does not depend on the
+// compile options, so there only the source files are checked. It also needs the module to
+// carry source locations, to navigate into it.
+bool Linkage::isBinaryModuleUpToDate(String fromPath, RiffContainer* container)
+{
+    const bool checkSourcesOnly = isInLanguageServer();
+    if (checkSourcesOnly && !_hasSourceLocations(container))
+        return false;
+
+    DiagnosticSink sink;
+    SerialContainerUtil::ReadOptions readOptions;
+    readOptions.linkage = this;
+    readOptions.astBuilder = getASTBuilder();
+    readOptions.session = getSessionImpl();
+    readOptions.sharedASTBuilder = getASTBuilder()->getSharedASTBuilder();
+    readOptions.sink = &sink;
+    readOptions.sourceManager = getSourceManager();
+    readOptions.namePool = getNamePool();
+    readOptions.readHeaderOnly = true;
+
+    SerialContainerData containerData;
+    if (SLANG_FAILED(SerialContainerUtil::read(container, readOptions, nullptr, containerData)))
+        return false;
+
+    if (containerData.modules.getCount() != 1)
+        return false;
+
+    auto& moduleHeader = containerData.modules[0];
+    if (checkSourcesOnly && moduleHeader.sourceDigest == SHA1::Digest())
+        return false;
+
+    DigestBuilder<SHA1> digestBuilder;
+    auto version = String(getBuildTagString());
+    digestBuilder.append(version);
+    if (!checkSourcesOnly)
+    {
+        HashSet<String> defineDependencies;
+        for (const auto& macroName : moduleHeader.defineDependencies)
+            defineDependencies.add(macroName);
+        m_optionSet.buildHash(digestBuilder, defineDependencies);
+    }
+
+    // Find the canonical path of the directory containing the module source file.
+    String moduleSrcPath = "";
+    if (moduleHeader.dependentFiles.getCount())
+    {
+        moduleSrcPath = moduleHeader.dependentFiles.getFirst();
+        IncludeSystem includeSystem(
             &getSearchDirectories(),
             getFileSystemExt(),
-            getSourceManager());
+            getSourceManager(),
+            getMissingFilePathTracker());
         PathInfo modulePathInfo;
         if (SLANG_SUCCEEDED(includeSystem.findFile(moduleSrcPath, fromPath, modulePathInfo)))
         {
@@ -4232,18 +4954,66 @@ bool Linkage::isBinaryModuleUpToDate(String fromPath, RiffContainer* container)
             return false;
         digestBuilder.append(sourceFile->getDigest());
     }
-    return digestBuilder.finalize() == moduleHeader.digest;
+    return digestBuilder.finalize() ==
+           (checkSourcesOnly ? moduleHeader.sourceDigest : moduleHeader.digest);
+}
+
+String Linkage::getModuleCacheFilePath(const PathInfo& filePathInfo)
+{
+    String cacheDir = m_optionSet.getStringOption(CompilerOptionName::ModuleCachePath);
+    if (cacheDir.getLength() == 0 || !filePathInfo.hasFileFoundPath())
+        return String();
+
+    if (!Path::createDirectoryRecursive(cacheDir))
+        return String();
+
+    // The cache entry is keyed on the identity of the source file, so that modules
+    // with the same name in different directories do not collide. Whether an entry
+    // can be used for the current source and options is decided when it is loaded.
+    String identity = filePathInfo.getMostUniqueIdentity();
+    auto identityDigest = SHA1::compute(identity.getBuffer(), identity.getLength());
+
+    StringBuilder fileName;
+    fileName << Path::getFileNameWithoutExt(filePathInfo.foundPath) << "-"
+             << identityDigest.toString() << ".slang-module";
+    return Path::combine(cacheDir, fileName.produceString());
+}
+
+RefPtr<Module> Linkage::loadModuleFromCache(
+    Name* name,
+    const PathInfo& filePathInfo,
+    const String& cacheFilePath,
+    SourceLoc const& loc,
+    DiagnosticSink* sink,
+    const LoadedModuleDictionary* additionalLoadedModules)
+{
+    ScopedAllocation data;
+    if (SLANG_FAILED(File::readAllBytes(cacheFilePath, data)))
+        return nullptr;
+    auto blob = RawBlob::moveCreate(data);
+
+    // Dependent files recorded in the cache entry are resolved relative to the
+    // original source location, not to the cache directory.
+    if (!isBinaryModuleUpToDate(filePathInfo.foundPath.getBuffer(), blob))
+        return nullptr;
+
+    return loadModuleFromIRBlobImpl(
+        name,
+        filePathInfo,
+        blob,
+        loc,
+        sink,
+        additionalLoadedModules);
 }
 
 SLANG_NO_THROW bool SLANG_MCALL
 Linkage::isBinaryModuleUpToDate(const char* modulePath, slang::IBlob* binaryModuleBlob)
 {
     RiffContainer container;
-    MemoryStreamBase readStream(
-        FileAccess::Read,
-        binaryModuleBlob->getBufferPointer(),
-        binaryModuleBlob->getBufferSize());
-    if (SLANG_FAILED(RiffUtil::read(&readStream, container)))
+    if (SLANG_FAILED(RiffUtil::readInPlace(
+            binaryModuleBlob->getBufferPointer(),
+            binaryModuleBlob->getBufferSize(),
+            container)))
         return false;
     return isBinaryModuleUpToDate(modulePath, &container);
 }
@@ -4258,7 +5028,11 @@ SourceFile* Linkage::findFile(Name* name, SourceLoc loc, IncludeSystem& outInclu
         // using our ordinary include-handling logic.
 
         auto& searchDirs = getSearchDirectories();
-        outIncludeSystem = IncludeSystem(&searchDirs, getFileSystemExt(), getSourceManager());
+        outIncludeSystem = IncludeSystem(
+            &searchDirs,
+            getFileSystemExt(),
+            getSourceManager(),
+            getMissingFilePathTracker());
 
         // Get the original path info
         PathInfo pathIncludedFromInfo = getSourceManager()->getPathInfo(loc, SourceLocType::Actual);
@@ -4476,7 +5250,7 @@ SHA1::Digest Module::computeDigest()
         DigestBuilder<SHA1> digestBuilder;
         auto version = String(getBuildTagString());
         digestBuilder.append(version);
-        getOptionSet().buildHash(digestBuilder);
+        getOptionSet().buildHash(digestBuilder, m_defineDependencies);
 
         auto fileDependencies = getFileDependencies();
 
@@ -4489,10 +5263,22 @@ SHA1::Digest Module::computeDigest()
     return m_digest;
 }
 
+SHA1::Digest Module::computeSourceDigest()
+{
+    DigestBuilder<SHA1> digestBuilder;
+    auto version = String(getBuildTagString());
+    digestBuilder.append(version);
+    for (auto file : getFileDependencies())
+        digestBuilder.append(file->getDigest());
+    return digestBuilder.finalize();
+}
+
 void Module::addModuleDependency(Module* module)
 {
     m_moduleDependencyList.addDependency(module);
     m_fileDependencyList.addDependency(module);
+    for (const auto& macroName : module->getDefineDependencies())
+        m_defineDependencies.add(macroName);
 }
 
 void Module::addFileDependency(SourceFile* sourceFile)
@@ -4500,6 +5286,42 @@ void Module::addFileDependency(SourceFile* sourceFile)
     m_fileDependencyList.addDependency(sourceFile);
 }
 
+IRModule* Module::getIRModule()
+{
+    if (m_deferredIRModule)
+    {
+        // A module's IR is only read once, even if that fails.
+        RefPtr<IRSerialDeferredModule> deferredIRModule =
+            static_cast<IRSerialDeferredModule*>(m_deferredIRModule.Ptr());
+        m_deferredIRModule = nullptr;
+
+        RefPtr<IRModule> irModule;
+        if (SLANG_SUCCEEDED(deferredIRModule->read(irModule)))
+            m_irModule = irModule;
+    }
+    if (m_deferredIRTranslationUnit)
+    {
+        DiagnosticSink sink(getLinkage()->getSourceManager(), Lexer::sourceLocationLexer);
+        ensureIRModule(&sink);
+    }
+    return m_irModule;
+}
+
+void Module::ensureIRModule(DiagnosticSink* sink)
+{
+    if (!m_deferredIRTranslationUnit)
+        return;
+    RefPtr<TranslationUnitRequest> translationUnit = m_deferredIRTranslationUnit;
+    m_deferredIRTranslationUnit = nullptr;
+
+    // The request the module was loaded by is gone, so lowering is given a new one.
+    RefPtr<FrontEndCompileRequest> compileRequest =
+        new FrontEndCompileRequest(getLinkage(), nullptr, sink);
+    translationUnit->compileRequest = compileRequest;
+    m_irModule = generateIRForTranslationUnit(getLinkage()->getASTBuilder(), translationUnit);
+    translationUnit->compileRequest = nullptr;
+}
+
 void Module::setModuleDecl(ModuleDecl* moduleDecl)
 {
     m_moduleDecl = moduleDecl;
@@ -4528,6 +5350,8 @@ RefPtr<EntryPoint> Module::findAndCheckEntryPoint(
     SlangStage stage,
     ISlangBlob** outDiagnostics)
 {
+    SLANG_LINKAGE_API_LOCK(getLinkage());
+
     // If there is already an entrypoint marked with the [shader] attribute,
     // we should just return that.
     //
@@ -4653,6 +5477,32 @@ ComponentType::ComponentType(Linkage* linkage)
 {
 }
 
+ComponentType::~ComponentType()
+{
+    // The target programs are released first, so that the session memory tracker can't
+    // evict the caches of one of them after the rest of this component type is gone.
+    m_targetPrograms.clear();
+}
+
+SHA1::Digest ComponentType::getHashDigest()
+{
+    if (!m_hasHashDigest)
+    {
+        DigestBuilder<SHA1> builder;
+        buildHash(builder);
+        m_hashDigest = builder.finalize();
+        m_hasHashDigest = true;
+    }
+    return m_hashDigest;
+}
+
+IArtifact* ComponentType::findCachedTargetArtifact(Int targetIndex)
+{
+    ComPtr<IArtifact> artifact;
+    m_targetArtifacts.tryGetValue(targetIndex, artifact);
+    return artifact.get();
+}
+
 ComponentType* asInternal(slang::IComponentType* inComponentType)
 {
     // Note: we use a `queryInterface` here instead of just a `static_cast`
@@ -4676,6 +5526,10 @@ ISlangUnknown* ComponentType::getInterface(Guid const& guid)
     }
     if (guid == IModulePrecompileService_Experimental::getTypeGuid())
         return static_cast<slang::IModulePrecompileService_Experimental*>(this);
+    if (guid == IComponentTypeAsync_Experimental::getTypeGuid())
+        return static_cast<slang::IComponentTypeAsync_Experimental*>(this);
+    if (guid == IComponentTypeOutput_Experimental::getTypeGuid())
+        return static_cast<slang::IComponentTypeOutput_Experimental*>(this);
     return nullptr;
 }
 
@@ -4687,6 +5541,7 @@ SLANG_NO_THROW slang::ISession* SLANG_MCALL ComponentType::getSession()
 SLANG_NO_THROW slang::ProgramLayout* SLANG_MCALL
 ComponentType::getLayout(Int targetIndex, slang::IBlob** outDiagnostics)
 {
+    SLANG_LINKAGE_API_LOCK(getLinkage());
     auto linkage = getLinkage();
     if (targetIndex < 0 || targetIndex >= linkage->targets.getCount())
         return nullptr;
@@ -4737,6 +5592,7 @@ SLANG_NO_THROW SlangResult SLANG_MCALL ComponentType::getResultAsFileSystem(
     Int targetIndex,
     ISlangMutableFileSystem** outFileSystem)
 {
+    SLANG_LINKAGE_API_LOCK(getLinkage());
     ComPtr<ISlangBlob> diagnostics;
     ComPtr<ISlangBlob> code;
 
@@ -4812,6 +5668,7 @@ SLANG_NO_THROW SlangResult SLANG_MCALL ComponentType::getEntryPointCode(
     slang::IBlob** outCode,
     slang::IBlob** outDiagnostics)
 {
+    SLANG_LINKAGE_API_LOCK(getLinkage());
     auto linkage = getLinkage();
     if (targetIndex < 0 || targetIndex >= linkage->targets.getCount())
         return SLANG_E_INVALID_ARG;
@@ -4822,12 +5679,14 @@ SLANG_NO_THROW SlangResult SLANG_MCALL ComponentType::getEntryPointCode(
     DiagnosticSink sink(linkage->getSourceManager(), Lexer::sourceLocationLexer);
     applySettingsToDiagnosticSink(&sink, &sink, linkage->m_optionSet);
     applySettingsToDiagnosticSink(&sink, &sink, m_optionSet);
+    sink.setCountOnlyIfNoBlob(outDiagnostics);
 
     IArtifact* artifact = targetProgram->getOrCreateEntryPointResult(entryPointIndex, &sink);
     sink.getBlobIfNeeded(outDiagnostics);
 
     if (artifact == nullptr)
         return SLANG_FAIL;
+    targetProgram->noteCacheUse();
 
     return artifact->loadBlob(ArtifactKeep::Yes, outCode);
 }
@@ -4837,6 +5696,7 @@ SLANG_NO_THROW void SLANG_MCALL ComponentType::getEntryPointHash(
     SlangInt targetIndex,
     slang::IBlob** outHash)
 {
+    SLANG_LINKAGE_API_LOCK(getLinkage());
     DigestBuilder<SHA1> builder;
 
     // A note on enums that may be hashed in as part of the following two function calls:
@@ -4847,7 +5707,7 @@ SLANG_NO_THROW void SLANG_MCALL ComponentType::getEntryPointHash(
     // will already be reflected in the resulting hash.
     getLinkage()->buildHash(builder, targetIndex);
 
-    buildHash(builder);
+    builder.append(getHashDigest());
 
     // Add the name and name override for the specified entry point to the hash.
     auto entryPointName = getEntryPoint(entryPointIndex)->getName()->text;
@@ -4867,6 +5727,7 @@ SLANG_NO_THROW SlangResult SLANG_MCALL ComponentType::getEntryPointHostCallable(
     ISlangSharedLibrary** outSharedLibrary,
     slang::IBlob** outDiagnostics)
 {
+    SLANG_LINKAGE_API_LOCK(getLinkage());
     auto linkage = getLinkage();
     if (targetIndex < 0 || targetIndex >= linkage->targets.getCount())
         return SLANG_E_INVALID_ARG;
@@ -4876,12 +5737,14 @@ SLANG_NO_THROW SlangResult SLANG_MCALL ComponentType::getEntryPointHostCallable(
 
     DiagnosticSink sink(linkage->getSourceManager(), Lexer::sourceLocationLexer);
     applySettingsToDiagnosticSink(&sink, &sink, m_optionSet);
+    sink.setCountOnlyIfNoBlob(outDiagnostics);
 
     IArtifact* artifact = targetProgram->getOrCreateEntryPointResult(entryPointIndex, &sink);
     sink.getBlobIfNeeded(outDiagnostics);
 
     if (artifact == nullptr)
         return SLANG_FAIL;
+    targetProgram->noteCacheUse();
 
     return artifact->loadSharedLibrary(ArtifactKeep::Yes, outSharedLibrary);
 }
@@ -4892,6 +5755,7 @@ SLANG_NO_THROW SlangResult SLANG_MCALL ComponentType::getEntryPointMetadata(
     slang::IMetadata** outMetadata,
     slang::IBlob** outDiagnostics)
 {
+    SLANG_LINKAGE_API_LOCK(getLinkage());
     auto linkage = getLinkage();
     if (targetIndex < 0 || targetIndex >= linkage->targets.getCount())
         return SLANG_E_INVALID_ARG;
@@ -4902,12 +5766,14 @@ SLANG_NO_THROW SlangResult SLANG_MCALL ComponentType::getEntryPointMetadata(
     DiagnosticSink sink(linkage->getSourceManager(), Lexer::sourceLocationLexer);
     applySettingsToDiagnosticSink(&sink, &sink, linkage->m_optionSet);
     applySettingsToDiagnosticSink(&sink, &sink, m_optionSet);
+    sink.setCountOnlyIfNoBlob(outDiagnostics);
 
     IArtifact* artifact = targetProgram->getOrCreateEntryPointResult(entryPointIndex, &sink);
     sink.getBlobIfNeeded(outDiagnostics);
 
     if (artifact == nullptr)
         return SLANG_E_NOT_AVAILABLE;
+    targetProgram->noteCacheUse();
 
     auto metadata = findAssociatedRepresentation<IArtifactPostEmitMetadata>(artifact);
     if (!metadata)
@@ -4948,6 +5814,7 @@ SLANG_NO_THROW SlangResult SLANG_MCALL ComponentType::specialize(
     slang::IComponentType** outSpecializedComponentType,
     ISlangBlob** outDiagnostics)
 {
+    SLANG_LINKAGE_API_LOCK(getLinkage());
     DiagnosticSink sink(getLinkage()->getSourceManager(), Lexer::sourceLocationLexer);
 
     // First let's check if the number of arguments given matches
@@ -4997,6 +5864,7 @@ SLANG_NO_THROW SlangResult SLANG_MCALL ComponentType::specialize(
 SLANG_NO_THROW SlangResult SLANG_MCALL
 ComponentType::renameEntryPoint(const char* newName, IComponentType** outEntryPoint)
 {
+    SLANG_LINKAGE_API_LOCK(getLinkage());
     RefPtr<RenamedEntryPointComponentType> result =
         new RenamedEntryPointComponentType(this, newName);
     *outEntryPoint = result.detach();
@@ -5008,6 +5876,7 @@ RefPtr<ComponentType> fillRequirements(ComponentType* inComponentType);
 SLANG_NO_THROW SlangResult SLANG_MCALL
 ComponentType::link(slang::IComponentType** outLinkedComponentType, ISlangBlob** outDiagnostics)
 {
+    SLANG_LINKAGE_API_LOCK(getLinkage());
     // TODO: It should be possible for `fillRequirements` to fail,
     // in cases where we have a dependency that can't be automatically
     // resolved.
@@ -5028,6 +5897,7 @@ SLANG_NO_THROW SlangResult SLANG_MCALL ComponentType::linkWithOptions(
     slang::CompilerOptionEntry* entries,
     ISlangBlob** outDiagnostics)
 {
+    SLANG_LINKAGE_API_LOCK(getLinkage());
     SLANG_RETURN_ON_FAIL(link(outLinkedComponentType, outDiagnostics));
 
     auto linked = *outLinkedComponentType;
@@ -5195,6 +6065,7 @@ IArtifact* ComponentType::getTargetArtifact(Int targetIndex, slang::IBlob** outD
     DiagnosticSink sink(linkage->getSourceManager(), Lexer::sourceLocationLexer);
     applySettingsToDiagnosticSink(&sink, &sink, linkage->m_optionSet);
     applySettingsToDiagnosticSink(&sink, &sink, m_optionSet);
+    sink.setCountOnlyIfNoBlob(outDiagnostics);
 
     IArtifact* targetArtifact = targetProgram->getOrCreateWholeProgramResult(&sink);
     sink.getBlobIfNeeded(outDiagnostics);
@@ -5205,10 +6076,12 @@ IArtifact* ComponentType::getTargetArtifact(Int targetIndex, slang::IBlob** outD
 SLANG_NO_THROW SlangResult SLANG_MCALL
 ComponentType::getTargetCode(Int targetIndex, slang::IBlob** outCode, slang::IBlob** outDiagnostics)
 {
+    SLANG_LINKAGE_API_LOCK(getLinkage());
     IArtifact* artifact = getTargetArtifact(targetIndex, outDiagnostics);
 
     if (artifact == nullptr)
         return SLANG_FAIL;
+    getTargetProgram(getLinkage()->targets[targetIndex])->noteCacheUse();
 
     return artifact->loadBlob(ArtifactKeep::Yes, outCode);
 }
@@ -5218,10 +6091,12 @@ SLANG_NO_THROW SlangResult SLANG_MCALL ComponentType::getTargetMetadata(
     slang::IMetadata** outMetadata,
     slang::IBlob** outDiagnostics)
 {
+    SLANG_LINKAGE_API_LOCK(getLinkage());
     IArtifact* artifact = getTargetArtifact(targetIndex, outDiagnostics);
 
     if (artifact == nullptr)
         return SLANG_FAIL;
+    getTargetProgram(getLinkage()->targets[targetIndex])->noteCacheUse();
 
     auto metadata = findAssociatedRepresentation<IArtifactPostEmitMetadata>(artifact);
     if (!metadata)
@@ -5231,6 +6106,112 @@ SLANG_NO_THROW SlangResult SLANG_MCALL ComponentType::getTargetMetadata(
     return SLANG_OK;
 }
 
+// The blobs returned by `getEntryPointCode` and `getTargetCode` are the ones the artifacts
+// of the target program keep, so writing or copying from them is the only copy made.
+
+static SlangResult _writeCode(ISlangBlob* code, ISlangWriter* writer)
+{
+    if (!writer)
+        return SLANG_E_INVALID_ARG;
+    return writer->write((const char*)code->getBufferPointer(), code->getBufferSize());
+}
+
+static SlangResult _copyCode(
+    ISlangBlob* code,
+    void* buffer,
+    size_t bufferSize,
+    size_t* outCodeSize)
+{
+    const size_t codeSize = code->getBufferSize();
+    if (outCodeSize)
+        *outCodeSize = codeSize;
+    if (!buffer || bufferSize < codeSize)
+        return SLANG_E_BUFFER_TOO_SMALL;
+    ::memcpy(buffer, code->getBufferPointer(), codeSize);
+    return SLANG_OK;
+}
+
+SLANG_NO_THROW SlangResult SLANG_MCALL ComponentType::writeEntryPointCode(
+    SlangInt entryPointIndex,
+    SlangInt targetIndex,
+    ISlangWriter* writer,
+    slang::IBlob** outDiagnostics)
+{
+    ComPtr<ISlangBlob> code;
+    SLANG_RETURN_ON_FAIL(
+        getEntryPointCode(entryPointIndex, targetIndex, code.writeRef(), outDiagnostics));
+    return _writeCode(code, writer);
+}
+
+SLANG_NO_THROW SlangResult SLANG_MCALL ComponentType::writeTargetCode(
+    SlangInt targetIndex,
+    ISlangWriter* writer,
+    slang::IBlob** outDiagnostics)
+{
+    ComPtr<ISlangBlob> code;
+    SLANG_RETURN_ON_FAIL(getTargetCode(targetIndex, code.writeRef(), outDiagnostics));
+    return _writeCode(code, writer);
+}
+
+SLANG_NO_THROW SlangResult SLANG_MCALL ComponentType::copyEntryPointCode(
+    SlangInt entryPointIndex,
+    SlangInt targetIndex,
+    void* buffer,
+    size_t bufferSize,
+    size_t* outCodeSize,
+    slang::IBlob** outDiagnostics)
+{
+    ComPtr<ISlangBlob> code;
+    SLANG_RETURN_ON_FAIL(
+        getEntryPointCode(entryPointIndex, targetIndex, code.writeRef(), outDiagnostics));
+    return _copyCode(code, buffer, bufferSize, outCodeSize);
+}
+
+SLANG_NO_THROW SlangResult SLANG_MCALL ComponentType::copyTargetCode(
+    SlangInt targetIndex,
+    void* buffer,
+    size_t bufferSize,
+    size_t* outCodeSize,
+    slang::IBlob** outDiagnostics)
+{
+    ComPtr<ISlangBlob> code;
+    SLANG_RETURN_ON_FAIL(getTargetCode(targetIndex, code.writeRef(), outDiagnostics));
+    return _copyCode(code, buffer, bufferSize, outCodeSize);
+}
+
+SLANG_NO_THROW SlangResult SLANG_MCALL ComponentType::getEntryPointCodeAsync(
+    SlangInt entryPointIndex,
+    SlangInt targetIndex,
+    slang::ITaskScheduler_Experimental* scheduler,
+    slang::ICompileTask_Experimental** outTask)
+{
+    if (entryPointIndex < 0 || entryPointIndex >= getEntryPointCount())
+        return SLANG_E_INVALID_ARG;
+    if (targetIndex < 0 || targetIndex >= getLinkage()->targets.getCount())
+        return SLANG_E_INVALID_ARG;
+
+    ComPtr<CompileTask> task(new CompileTask(this, entryPointIndex, targetIndex));
+    task->start(scheduler);
+
+    *outTask = task.detach();
+    return SLANG_OK;
+}
+
+SLANG_NO_THROW SlangResult SLANG_MCALL ComponentType::getTargetCodeAsync(
+    SlangInt targetIndex,
+    slang::ITaskScheduler_Experimental* scheduler,
+    slang::ICompileTask_Experimental** outTask)
+{
+    if (targetIndex < 0 || targetIndex >= getLinkage()->targets.getCount())
+        return SLANG_E_INVALID_ARG;
+
+    ComPtr<CompileTask> task(new CompileTask(this, -1, targetIndex));
+    task->start(scheduler);
+
+    *outTask = task.detach();
+    return SLANG_OK;
+}
+
 //
 // CompositeComponentType
 //
@@ -5330,7 +6311,7 @@ void CompositeComponentType::buildHash(DigestBuilder<SHA1>& builder)
 
     for (Index i = 0; i < componentCount; ++i)
     {
-        getChildComponent(i)->buildHash(builder);
+        builder.append(getChildComponent(i)->getHashDigest());
     }
 }
 
@@ -5791,7 +6772,7 @@ void SpecializedComponentType::buildHash(DigestBuilder<SHA1>& builder)
         builder.append(argString);
     }
 
-    getBaseComponentType()->buildHash(builder);
+    builder.append(getBaseComponentType()->getHashDigest());
 }
 
 void SpecializedComponentType::acceptVisitor(
@@ -5887,6 +6868,206 @@ TargetProgram::TargetProgram(ComponentType* componentType, TargetRequest* target
     m_optionSet.inheritFrom(targetReq->getOptionSet());
 }
 
+TargetProgram::~TargetProgram()
+{
+    if (m_memoryTracker)
+        m_memoryTracker->remove(this);
+}
+
+void TargetProgram::noteCacheUse()
+{
+    auto tracker = m_targetReq->getLinkage()->getMemoryTracker();
+    m_memoryTracker = tracker;
+    tracker->noteUse(this);
+}
+
+size_t TargetProgram::getCachedCodeSize(Index* outCount)
+{
+    List<IArtifact*> artifacts;
+    if (m_wholeProgramResult)
+        artifacts.add(m_wholeProgramResult);
+    for (auto& entryPointResult : m_entryPointResults)
+    {
+        if (entryPointResult)
+            artifacts.add(entryPointResult);
+    }
+
+    // `ComponentType::getTargetCode` may hold on to the code for the whole program separately.
+    const Index targetIndex = m_targetReq->getLinkage()->targets.indexOf(m_targetReq);
+    if (auto targetArtifact = m_program->findCachedTargetArtifact(targetIndex))
+    {
+        if (!artifacts.contains(targetArtifact))
+            artifacts.add(targetArtifact);
+    }
+
+    size_t size = 0;
+    for (auto artifact : artifacts)
+    {
+        ComPtr<ISlangBlob> blob;
+        if (SLANG_SUCCEEDED(artifact->loadBlob(ArtifactKeep::Yes, blob.writeRef())))
+            size += blob->getBufferSize();
+    }
+
+    if (outCount)
+        *outCount = artifacts.getCount();
+    return size;
+}
+
+void TargetProgram::evictCaches()
+{
+    m_wholeProgramResult.setNull();
+    for (auto& entryPointResult : m_entryPointResults)
+        entryPointResult.setNull();
+
+    m_irModuleForLayout = nullptr;
+    m_linkSymbolTable = nullptr;
+    m_specializationCache = nullptr;
+
+    const Index targetIndex = m_targetReq->getLinkage()->targets.indexOf(m_targetReq);
+    m_program->evictCachedTargetArtifact(targetIndex);
+}
+
+//
+// SessionMemoryTracker
+//
+
+void SessionMemoryTracker::noteUse(TargetProgram* targetProgram)
+{
+    Index codeCount = 0;
+    const size_t codeSize = targetProgram->getCachedCodeSize(&codeCount);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto& entry = m_entries[targetProgram];
+    m_totalCodeSize = m_totalCodeSize - entry.codeSize + codeSize;
+    entry.lastUse = ++m_useCounter;
+    entry.codeSize = codeSize;
+    entry.codeCount = codeCount;
+
+    _evictOverBudget(targetProgram);
+}
+
+void SessionMemoryTracker::remove(TargetProgram* targetProgram)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (auto entry = m_entries.tryGetValue(targetProgram))
+    {
+        m_totalCodeSize -= entry->codeSize;
+        m_entries.remove(targetProgram);
+    }
+}
+
+void SessionMemoryTracker::evictAll()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    for (auto& [targetProgram, entry] : m_entries)
+    {
+        targetProgram->evictCaches();
+        m_evictionCount++;
+    }
+    m_entries.clear();
+    m_totalCodeSize = 0;
+}
+
+void SessionMemoryTracker::evictUsingModules(const HashSet<Module*>& modules)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    List<TargetProgram*> programsToEvict;
+    for (auto& [targetProgram, entry] : m_entries)
+    {
+        for (auto module : targetProgram->getProgram()->getModuleDependencies())
+        {
+            if (modules.contains(module))
+            {
+                programsToEvict.add(targetProgram);
+                break;
+            }
+        }
+    }
+    for (auto targetProgram : programsToEvict)
+    {
+        _evict(targetProgram, m_entries[targetProgram]);
+        m_entries.remove(targetProgram);
+    }
+}
+
+void SessionMemoryTracker::setBudget(size_t budget)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_budget = budget;
+    _evictOverBudget(nullptr);
+}
+
+void SessionMemoryTracker::getStats(slang::SessionMemoryStats& outStats)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    outStats.memoryBudget = m_budget;
+    outStats.targetCodeBytes = m_totalCodeSize;
+    outStats.targetCodeCount = 0;
+    for (auto& [targetProgram, entry] : m_entries)
+        outStats.targetCodeCount += entry.codeCount;
+    outStats.cachedProgramCount = m_entries.getCount();
+    outStats.evictionCount = m_evictionCount;
+}
+
+bool SessionMemoryTracker::isTracked(TargetProgram* targetProgram)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_entries.containsKey(targetProgram);
+}
+
+void SessionMemoryTracker::updatePeaks(slang::SessionMemoryStats& ioStats, size_t codeGenIRBytes)
+{
+    const size_t totalBytes = ioStats.astBytes + ioStats.irBytes + ioStats.irContainerPoolBytes +
+                              ioStats.stringPoolBytes + ioStats.targetCodeBytes + codeGenIRBytes;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_peakCodeGenIRBytes = Math::Max(m_peakCodeGenIRBytes, codeGenIRBytes);
+    m_peakTotalBytes = Math::Max(m_peakTotalBytes, totalBytes);
+    ioStats.peakCodeGenIRBytes = m_peakCodeGenIRBytes;
+    ioStats.peakTotalBytes = m_peakTotalBytes;
+}
+
+void SessionMemoryTracker::_evict(TargetProgram* targetProgram, Entry& entry)
+{
+    // Called with `m_mutex` held, which keeps `targetProgram` from being destroyed
+    // while its caches are dropped.
+    targetProgram->evictCaches();
+    m_totalCodeSize -= entry.codeSize;
+    m_evictionCount++;
+}
+
+void SessionMemoryTracker::_evictOverBudget(TargetProgram* inUse)
+{
+    if (m_budget == 0 || m_totalCodeSize <= m_budget)
+        return;
+
+    List<KeyValuePair<uint64_t, TargetProgram*>> programsByLastUse;
+    for (auto& [targetProgram, entry] : m_entries)
+    {
+        if (targetProgram != inUse)
+            programsByLastUse.add(KeyValuePair<uint64_t, TargetProgram*>(
+                entry.lastUse,
+                targetProgram));
+    }
+    programsByLastUse.sort([](auto const& a, auto const& b) { return a.key < b.key; });
+
+    for (auto& program : programsByLastUse)
+    {
+        if (m_totalCodeSize <= m_budget)
+            break;
+        auto targetProgram = program.value;
+        _evict(targetProgram, m_entries[targetProgram]);
+        m_entries.remove(targetProgram);
+    }
+}
+
 //
 
 Session* CompileRequestBase::getSession()
@@ -5894,6 +7075,24 @@ Session* CompileRequestBase::getSession()
     return getLinkage()->getSessionImpl();
 }
 
+CacheFileSystem* Session::getSharedOSFileSystemCache()
+{
+    if (!m_sharedOSFileSystemCache)
+    {
+        m_sharedOSFileSystemCache = new CacheFileSystem(OSFileSystem::getExtSingleton());
+        m_sharedOSFileSystemCache->setTrackModificationTimes(true);
+    }
+    return m_sharedOSFileSystemCache;
+}
+
+HashSet<String>* Linkage::getMissingFilePathTracker()
+{
+    // Only tracked when an input manifest is written, as that is the only use
+    if (m_optionSet.getStringOption(CompilerOptionName::InputManifest).getLength() == 0)
+        return nullptr;
+    return &m_missingFilePaths;
+}
+
 void Linkage::setFileSystem(ISlangFileSystem* inFileSystem)
 {
     // Set the fileSystem
@@ -5905,7 +7104,19 @@ void Linkage::setFileSystem(ISlangFileSystem* inFileSystem)
     // If nullptr passed in set up default
     if (inFileSystem == nullptr)
     {
-        m_fileSystemExt = new Slang::CacheFileSystem(Slang::OSFileSystem::getExtSingleton());
+        if (m_requireCacheFileSystem)
+        {
+            // The contents of the cache are used for repros, so must only hold this linkage's
+            m_fileSystemExt = new Slang::CacheFileSystem(Slang::OSFileSystem::getExtSingleton());
+        }
+        else
+        {
+            // Use the cache shared by the global session, dropping anything that changed since
+            // it was last used.
+            auto sharedCache = getSessionImpl()->getSharedOSFileSystemCache();
+            sharedCache->invalidateChanged();
+            m_fileSystemExt = sharedCache;
+        }
     }
     else
     {
@@ -5949,6 +7160,7 @@ void Linkage::prepareDeserializedModule(
     DiagnosticSink* sink)
 {
     module->setIRModule(moduleEntry.irModule);
+    module->setDeferredIRModule(moduleEntry.deferredIRModule);
     module->setModuleDecl(as<ModuleDecl>(moduleEntry.astRootNode));
     module->clearFileDependency();
     String moduleSourcePath = filePathInfo.foundPath;
@@ -5978,6 +7190,8 @@ void Linkage::prepareDeserializedModule(
     }
     module->setPathInfo(filePathInfo);
     module->setDigest(moduleEntry.digest);
+    for (const auto& macroName : moduleEntry.defineDependencies)
+        module->addDefineDependency(macroName);
     module->_collectShaderParams();
     module->_discoverEntryPoints(sink, targets);
 
@@ -6094,6 +7308,8 @@ Session::~Session()
 
     // destroy modules next
     coreModules = decltype(coreModules)();
+
+    delete m_sharedTypeCheckingCache;
 }
 
 } // namespace Slang
@@ -6743,6 +7959,11 @@ SlangResult EndToEndCompileRequest::compile()
         getSession()->getCompilerElapsedTime(&totalStartTime, &downstreamStartTime);
         PerformanceProfiler::getProfiler()->clear();
     }
+    const String traceJSONPath = getOptionSet().getStringOption(CompilerOptionName::TraceJSONPath);
+    if (traceJSONPath.getLength())
+    {
+        PerformanceProfiler::getProfiler()->setTraceEnabled(true);
+    }
 #if !defined(SLANG_DEBUG_INTERNAL_ERROR)
     // By default we'd like to catch as many internal errors as possible,
     // and report them to the user nicely (rather than just crash their
@@ -6824,6 +8045,43 @@ SlangResult EndToEndCompileRequest::compile()
             Diagnostics::performanceBenchmarkResult,
             perfResult.produceString());
     }
+    if (getOptionSet().getBoolOption(CompilerOptionName::ReportMemory))
+    {
+        auto linkage = getLinkage();
+        slang::SessionMemoryStats memoryStats;
+        linkage->calcMemoryStats(memoryStats);
+
+        // The code generated here is held by the program of this request, which isn't
+        // tracked by the session unless it is used through `IComponentType`.
+        if (auto program = getSpecializedGlobalAndEntryPointsComponentType())
+        {
+            for (auto targetReq : linkage->targets)
+            {
+                auto targetProgram = program->getTargetProgram(targetReq);
+                if (linkage->getMemoryTracker()->isTracked(targetProgram))
+                    continue;
+                Index codeCount = 0;
+                memoryStats.targetCodeBytes += targetProgram->getCachedCodeSize(&codeCount);
+                memoryStats.targetCodeCount += codeCount;
+            }
+            linkage->getMemoryTracker()->updatePeaks(memoryStats, 0);
+        }
+
+        StringBuilder report;
+        Linkage::appendMemoryReport(memoryStats, report);
+        getSink()->diagnose(SourceLoc(), Diagnostics::memoryReport, report.produceString());
+    }
+    if (traceJSONPath.getLength())
+    {
+        auto profiler = PerformanceProfiler::getProfiler();
+        StringBuilder traceJSON;
+        profiler->getTraceJSON(traceJSON);
+        profiler->setTraceEnabled(false);
+        if (SLANG_FAILED(File::writeAllText(traceJSONPath, traceJSON.produceString())))
+        {
+            getSink()->diagnose(SourceLoc(), Diagnostics::unableToWriteFile, traceJSONPath);
+        }
+    }
 
     // Repro dump handling
     {
@@ -6876,6 +8134,21 @@ SlangResult EndToEndCompileRequest::compile()
         }
     }
 
+    auto reflectionBlobPath =
+        getOptionSet().getStringOption(CompilerOptionName::EmitReflectionBlob);
+    if (reflectionBlobPath.getLength() != 0)
+    {
+        ComPtr<ISlangBlob> reflectionBlob;
+        if (SLANG_FAILED(writeReflectionBlob(this->getReflection(), reflectionBlob.writeRef())) ||
+            SLANG_FAILED(File::writeAllBytes(
+                reflectionBlobPath,
+                reflectionBlob->getBufferPointer(),
+                reflectionBlob->getBufferSize())))
+        {
+            getSink()->diagnose(SourceLoc(), Diagnostics::unableToWriteFile, reflectionBlobPath);
+        }
+    }
+
     return res;
 }
 
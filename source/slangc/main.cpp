@@ -4,12 +4,21 @@
 
 SLANG_API void spSetCommandLineCompilerMode(SlangCompileRequest* request);
 
+#include "../compiler-core/slang-compile-server-protocol.h"
+#include "../compiler-core/slang-json-rpc-connection.h"
 #include "../core/slang-io.h"
+#include "../core/slang-string-escape-util.h"
+#include "../core/slang-string-util.h"
+#include "../core/slang-task-util.h"
 #include "../core/slang-test-tool-util.h"
+#include "../core/slang-writer.h"
 
 using namespace Slang;
 
 #include <assert.h>
+#include <atomic>
+#include <mutex>
+#include <stdio.h>
 
 #ifdef _WIN32
 #define MAIN slangc_main
@@ -17,16 +26,34 @@ using namespace Slang;
 #define MAIN main
 #endif
 
-static void _diagnosticCallback(char const* message, void* /*userData*/)
+static void _diagnosticCallback(char const* message, void* userData)
 {
-    auto stdError = StdWriters::getError();
+    WriterHelper stdError((ISlangWriter*)userData);
     stdError.put(message);
     stdError.flush();
 }
 
-static SlangResult _compile(SlangCompileRequest* compileRequest, int argc, const char* const* argv)
+static SlangResult _compile(
+    SlangCompileRequest* compileRequest,
+    StdWriters* stdWriters,
+    int argc,
+    const char* const* argv)
 {
-    spSetDiagnosticCallback(compileRequest, &_diagnosticCallback, nullptr);
+    // All output goes to `stdWriters`, rather than the process' streams or the singleton, so
+    // that the output of a compile can be captured, and compiles can run on multiple threads.
+    spSetWriter(
+        compileRequest,
+        SLANG_WRITER_CHANNEL_STD_OUTPUT,
+        stdWriters->getWriter(SLANG_WRITER_CHANNEL_STD_OUTPUT));
+    spSetWriter(
+        compileRequest,
+        SLANG_WRITER_CHANNEL_STD_ERROR,
+        stdWriters->getWriter(SLANG_WRITER_CHANNEL_STD_ERROR));
+    // Diagnostics go to the error writer
+    spSetDiagnosticCallback(
+        compileRequest,
+        &_diagnosticCallback,
+        stdWriters->getWriter(SLANG_WRITER_CHANNEL_STD_ERROR));
     spSetCommandLineCompilerMode(compileRequest);
 
     char const* appName = "slangc";
@@ -59,7 +86,8 @@ static SlangResult _compile(SlangCompileRequest* compileRequest, int argc, const
 #ifndef _DEBUG
     catch (const Exception& e)
     {
-        StdWriters::getOut().print("internal compiler error: %S\n", e.Message.toWString().begin());
+        WriterHelper(stdWriters->getWriter(SLANG_WRITER_CHANNEL_STD_OUTPUT))
+            .print("internal compiler error: %S\n", e.Message.toWString().begin());
         res = SLANG_FAIL;
     }
 #endif
@@ -77,14 +105,15 @@ bool shouldEmbedPrelude(const char* const* argv, int argc)
     return false;
 }
 
-SLANG_TEST_TOOL_API SlangResult innerMain(
+// Compile a command line with its output going to `stdWriters`. Unlike `innerMain` this doesn't
+// set the `StdWriters` singleton, so it can be used from multiple threads, as long as each has
+// its own `sharedSession`.
+static SlangResult _compileCommandLine(
     StdWriters* stdWriters,
     slang::IGlobalSession* sharedSession,
     int argc,
     const char* const* argv)
 {
-    StdWriters::setSingleton(stdWriters);
-
     // Assume we will used the shared session
     ComPtr<slang::IGlobalSession> session(sharedSession);
 
@@ -108,15 +137,314 @@ SLANG_TEST_TOOL_API SlangResult innerMain(
 
     SlangCompileRequest* compileRequest = spCreateCompileRequest(session);
     compileRequest->addSearchPath(Path::getParentDirectory(Path::getExecutablePath()).getBuffer());
-    SlangResult res = _compile(compileRequest, argc, argv);
+    SlangResult res = _compile(compileRequest, stdWriters, argc, argv);
     // Now that we are done, clean up after ourselves
     spDestroyCompileRequest(compileRequest);
 
     return res;
 }
 
+SLANG_TEST_TOOL_API SlangResult innerMain(
+    StdWriters* stdWriters,
+    slang::IGlobalSession* sharedSession,
+    int argc,
+    const char* const* argv)
+{
+    StdWriters::setSingleton(stdWriters);
+    return _compileCommandLine(stdWriters, sharedSession, argc, argv);
+}
+
+// Compile the command line of a `compile` call with `session`, and send back what it output
+static SlangResult _executeDaemonCompile(
+    JSONRPCConnection* connection,
+    slang::IGlobalSession* session,
+    const char* exePath,
+    const JSONRPCCall& call)
+{
+    auto id = connection->getPersistentValue(call.id);
+
+    CompileServerProtocol::CompileArgs args;
+    SLANG_RETURN_ON_FAIL(connection->toNativeArgsOrSendError(call.params, &args, id));
+
+    List<const char*> toolArgs;
+    toolArgs.add(exePath);
+    for (const auto& arg : args.args)
+    {
+        toolArgs.add(arg.getBuffer());
+    }
+
+    StdWriters stdWriters;
+    StringBuilder stdOut;
+    StringBuilder stdError;
+
+    // Make the writers act as if they are the console, as they would be for a slangc process
+    RefPtr<StringWriter> stdOutWriter(new StringWriter(&stdOut, WriterFlag::IsConsole));
+    RefPtr<StringWriter> stdErrorWriter(new StringWriter(&stdError, WriterFlag::IsConsole));
+    stdWriters.setWriter(SLANG_WRITER_CHANNEL_STD_ERROR, stdErrorWriter);
+    stdWriters.setWriter(SLANG_WRITER_CHANNEL_STD_OUTPUT, stdOutWriter);
+    stdWriters.setWriter(SLANG_WRITER_CHANNEL_DIAGNOSTIC, stdErrorWriter);
+
+    CompileServerProtocol::CompileResult result;
+
+    const String previousPath = Path::getCurrentPath();
+    if (args.workingDirectory.getLength() &&
+        SLANG_FAILED(Path::setCurrentPath(args.workingDirectory)))
+    {
+        stdError << "error: unable to change to the directory '" << args.workingDirectory
+                 << "'\n";
+        result.result = SLANG_FAIL;
+    }
+    else
+    {
+        result.result = innerMain(&stdWriters, session, int(toolArgs.getCount()), toolArgs.begin());
+    }
+
+    if (args.workingDirectory.getLength())
+    {
+        Path::setCurrentPath(previousPath);
+    }
+
+    result.stdError = stdError;
+    result.stdOut = stdOut;
+    result.returnCode = int32_t(TestToolUtil::getReturnCode(result.result));
+    return connection->sendResult(&result, id);
+}
+
+// Serve `compile` calls sent as JSON-RPC over stdin until a `quit` call, or until stdin is closed.
+// Every compile uses the same global session, so the core module is only loaded once.
+static SlangResult _runDaemon(const char* exePath)
+{
+    ComPtr<slang::IGlobalSession> session;
+    SLANG_RETURN_ON_FAIL(slang_createGlobalSession(SLANG_API_VERSION, session.writeRef()));
+
+    RefPtr<JSONRPCConnection> connection(new JSONRPCConnection);
+    SLANG_RETURN_ON_FAIL(connection->initWithStdStreams());
+
+    while (connection->isActive())
+    {
+        // Block waiting for content (or error/closed)
+        if (SLANG_FAILED(connection->waitForResult()) || !connection->hasMessage())
+        {
+            continue;
+        }
+
+        if (connection->getMessageType() != JSONRPCMessageType::Call)
+        {
+            connection->sendError(
+                JSONRPC::ErrorCode::InvalidRequest,
+                connection->getCurrentMessageId());
+            continue;
+        }
+
+        JSONRPCCall call;
+        if (SLANG_FAILED(connection->getRPCOrSendError(&call)))
+        {
+            continue;
+        }
+
+        if (call.method == CompileServerProtocol::QuitArgs::g_methodName)
+        {
+            break;
+        }
+        else if (call.method == CompileServerProtocol::CompileArgs::g_methodName)
+        {
+            // Failure doesn't make the daemon terminate
+            [[maybe_unused]] const SlangResult res =
+                _executeDaemonCompile(connection, session, exePath, call);
+        }
+        else
+        {
+            connection->sendError(JSONRPC::ErrorCode::MethodNotFound, call.id);
+        }
+    }
+
+    return SLANG_OK;
+}
+
+// Split a line of a batch file into arguments. Arguments are separated by whitespace, and may
+// be double quoted to hold whitespace.
+static SlangResult _parseBatchLine(const UnownedStringSlice& line, List<String>& outArgs)
+{
+    auto escapeHandler = StringEscapeUtil::getHandler(StringEscapeUtil::Style::Space);
+
+    // The lexer relies on the text being zero terminated
+    const String text(line);
+    const char* cursor = text.getBuffer();
+    for (;;)
+    {
+        while (*cursor == ' ' || *cursor == '\t' || *cursor == '\r')
+            ++cursor;
+        if (*cursor == 0)
+            return SLANG_OK;
+
+        const char* const argBegin = cursor;
+        while (*cursor != 0 && *cursor != ' ' && *cursor != '\t' && *cursor != '\r')
+        {
+            if (*cursor == '"')
+            {
+                SLANG_RETURN_ON_FAIL(escapeHandler->lexQuoted(cursor, &cursor));
+            }
+            else
+            {
+                ++cursor;
+            }
+        }
+
+        const UnownedStringSlice arg(argBegin, cursor);
+        StringBuilder buf;
+        SLANG_RETURN_ON_FAIL(StringEscapeUtil::unescapeShellLike(escapeHandler, arg, buf));
+        outArgs.add(buf.produceString());
+    }
+}
+
+struct BatchJob
+{
+    Index lineNumber = 0;
+    List<String> args;
+};
+
+// Compile every command line in the batch file at `batchPath` in this process, on up to
+// `workerCount` threads (or as many as are useful if 0). The combined output of each job is
+// written when the job completes, so the output of jobs is never interleaved.
+//
+// A global session can only be used by one thread at a time, so each worker has its own, which
+// it reuses for all the jobs it takes.
+static SlangResult _runBatch(const char* exePath, const String& batchPath, Index workerCount)
+{
+    auto stdWriters = StdWriters::initDefaultSingleton();
+    WriterHelper stdErrorHelper(stdWriters->getWriter(SLANG_WRITER_CHANNEL_STD_ERROR));
+
+    String contents;
+    if (SLANG_FAILED(File::readAllText(batchPath, contents)))
+    {
+        stdErrorHelper.print("error: unable to read the batch file '%s'\n", batchPath.getBuffer());
+        return SLANG_E_NOT_FOUND;
+    }
+
+    List<BatchJob> jobs;
+    {
+        List<UnownedStringSlice> lines;
+        StringUtil::calcLines(contents.getUnownedSlice(), lines);
+        for (Index i = 0; i < lines.getCount(); ++i)
+        {
+            const auto line = lines[i].trim();
+            if (line.getLength() == 0 || line[0] == '#')
+                continue;
+
+            BatchJob job;
+            job.lineNumber = i + 1;
+            if (SLANG_FAILED(_parseBatchLine(line, job.args)))
+            {
+                stdErrorHelper.print(
+                    "%s(%d): error: unable to parse the command line\n",
+                    batchPath.getBuffer(),
+                    int(job.lineNumber));
+                return SLANG_FAIL;
+            }
+            jobs.add(_Move(job));
+        }
+    }
+
+    const Index extraWorkerCount = workerCount > 0
+                                       ? Math::Min(workerCount, jobs.getCount()) - 1
+                                       : TaskUtil::calcExtraWorkerCount(jobs.getCount());
+
+    std::atomic<Index> nextJobIndex(0);
+    std::atomic<Index> failedCount(0);
+    std::mutex outputMutex;
+
+    TaskUtil::runWorkers(
+        nullptr,
+        extraWorkerCount,
+        [&]()
+        {
+            ComPtr<slang::IGlobalSession> session;
+            for (;;)
+            {
+                const Index jobIndex = nextJobIndex++;
+                if (jobIndex >= jobs.getCount())
+                    break;
+                const auto& job = jobs[jobIndex];
+
+                List<const char*> toolArgs;
+                toolArgs.add(exePath);
+                for (const auto& arg : job.args)
+                {
+                    toolArgs.add(arg.getBuffer());
+                }
+
+                StringBuilder stdOut;
+                StringBuilder stdError;
+                RefPtr<StdWriters> jobWriters(new StdWriters);
+                RefPtr<StringWriter> stdOutWriter(new StringWriter(&stdOut, WriterFlag::IsConsole));
+                RefPtr<StringWriter> stdErrorWriter(
+                    new StringWriter(&stdError, WriterFlag::IsConsole));
+                jobWriters->setWriter(SLANG_WRITER_CHANNEL_STD_OUTPUT, stdOutWriter);
+                jobWriters->setWriter(SLANG_WRITER_CHANNEL_STD_ERROR, stdErrorWriter);
+
+                SlangResult res = SLANG_OK;
+                if (!session)
+                {
+                    res = slang_createGlobalSession(SLANG_API_VERSION, session.writeRef());
+                }
+                if (SLANG_SUCCEEDED(res))
+                {
+                    res = _compileCommandLine(
+                        jobWriters,
+                        session,
+                        int(toolArgs.getCount()),
+                        toolArgs.begin());
+                }
+                if (SLANG_FAILED(res))
+                {
+                    failedCount++;
+                    stdError << batchPath << "(" << job.lineNumber << "): error: job failed\n";
+                }
+
+                std::lock_guard<std::mutex> lock(outputMutex);
+                WriterHelper(stdWriters->getWriter(SLANG_WRITER_CHANNEL_STD_OUTPUT))
+                    .write(stdOut.getBuffer(), stdOut.getLength());
+                stdErrorHelper.write(stdError.getBuffer(), stdError.getLength());
+            }
+        });
+
+    if (failedCount > 0)
+    {
+        stdErrorHelper.print(
+            "%d of %d jobs failed\n",
+            int(failedCount.load()),
+            int(jobs.getCount()));
+        return SLANG_E_INTERNAL_FAIL;
+    }
+    return SLANG_OK;
+}
+
 int MAIN(int argc, char** argv)
 {
+    if (argc == 2 && UnownedStringSlice(argv[1]) == "-daemon")
+    {
+        const SlangResult res = _runDaemon(argv[0]);
+        slang::shutdown();
+        return (int)TestToolUtil::getReturnCode(res);
+    }
+
+    if ((argc == 3 || argc == 5) && UnownedStringSlice(argv[1]) == "-batch")
+    {
+        Index workerCount = 0;
+        if (argc == 5)
+        {
+            if (UnownedStringSlice(argv[3]) != "-j")
+            {
+                fprintf(stderr, "error: expected -batch <file> [-j <count>]\n");
+                return 1;
+            }
+            workerCount = Index(stringToInt(argv[4]));
+        }
+        const SlangResult res = _runBatch(argv[0], argv[2], workerCount);
+        slang::shutdown();
+        return (int)TestToolUtil::getReturnCode(res);
+    }
+
     auto stdWriters = StdWriters::initDefaultSingleton();
     SlangResult res = innerMain(stdWriters, nullptr, argc, argv);
     slang::shutdown();
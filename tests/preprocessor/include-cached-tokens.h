@@ -0,0 +1,5 @@
+// include-cached-tokens.h
+
+// Used by the `include-cached-tokens.slang` test
+
+`
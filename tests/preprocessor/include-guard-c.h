@@ -0,0 +1,9 @@
+// include-guard-c.h
+
+// Used by the `include-guard.slang` test
+
+#ifndef INCLUDE_GUARD_C_H
+#define INCLUDE_GUARD_C_H
+#else
+C_BODY
+#endif
@@ -0,0 +1,609 @@
+#!/usr/bin/env python3
+"""Generate the large shaders of the benchmark corpus.
+
+The generated files are checked in, so that slang-benchmark can be run without Python. Run this
+script again after changing it:
+
+    python tools/benchmark/generate-corpus.py
+
+The shapes are meant to stress the compiler the way large production shaders do:
+
+  instantiations.slang  thousands of specializations of generic types and functions
+  network.slang         a deep differentiable network with forward and backward derivatives
+  raytracing.slang      a ray tracing pipeline with many hit groups
+  permutations.slang    many preprocessor permutations of a material include tree
+"""
+
+import os
+
+CORPUS_DIR = os.path.join(os.path.dirname(os.path.abspath(__file__)), "corpus")
+
+
+def write(name, description, lines, targets=None):
+    header = [f"// {name}", "//"]
+    header += [f"// {line}" if line else "//" for line in description]
+    header += ["//", "// Generated by tools/benchmark/generate-corpus.py, do not edit."]
+    if targets:
+        header += ["//", f"// benchmark-targets: {' '.join(targets)}"]
+    path = os.path.join(CORPUS_DIR, name)
+    with open(path, "w", newline="\n") as f:
+        f.write("\n".join(header + [""] + lines) + "\n")
+
+
+### instantiations.slang ###
+
+OP_COUNT = 16
+TRIPLE_COUNT = 8
+
+
+def generate_instantiations():
+    lines = [
+        "interface IOp",
+        "{",
+        "    static float apply(float x);",
+        "}",
+        "",
+    ]
+    for i in range(OP_COUNT):
+        kind = i % 4
+        scale = 1.0 + i / 64.0
+        if kind == 0:
+            body = f"return x * {scale:.4f} + {i / 16.0:.4f};"
+        elif kind == 1:
+            body = f"return sin(x * {scale:.4f});"
+        elif kind == 2:
+            body = f"return x * x * {1.0 / (i + 1):.4f} - x;"
+        else:
+            body = f"return max(x, {i / 32.0:.4f}) * {scale:.4f};"
+        lines += [
+            f"struct Op{i} : IOp",
+            "{",
+            f"    static float apply(float x) {{ {body} }}",
+            "}",
+            "",
+        ]
+
+    lines += [
+        "struct Compose<A : IOp, B : IOp> : IOp",
+        "{",
+        "    static float apply(float x) { return B.apply(A.apply(x)); }",
+        "}",
+        "",
+        "struct Repeat<T : IOp, let N : int> : IOp",
+        "{",
+        "    static float apply(float x)",
+        "    {",
+        "        for (int i = 0; i < N; ++i)",
+        "            x = T.apply(x);",
+        "        return x;",
+        "    }",
+        "}",
+        "",
+        "float run<T : IOp>(float x)",
+        "{",
+        "    return T.apply(x);",
+        "}",
+        "",
+        "RWStructuredBuffer<float> gOutput;",
+        "StructuredBuffer<float> gInput;",
+        "",
+    ]
+
+    # Every pair, every pair followed by some third operation, and repeats of all of them.
+    calls = []
+    for a in range(OP_COUNT):
+        for b in range(OP_COUNT):
+            calls.append(f"Compose<Op{a}, Op{b}>")
+    for a in range(OP_COUNT):
+        for b in range(OP_COUNT):
+            for c in range(TRIPLE_COUNT):
+                calls.append(f"Compose<Compose<Op{a}, Op{b}>, Op{(a + b + c) % OP_COUNT}>")
+    for a in range(OP_COUNT):
+        for n in range(1, 5):
+            calls.append(f"Repeat<Op{a}, {n}>")
+            calls.append(f"Repeat<Compose<Op{a}, Op{(a + n) % OP_COUNT}>, {n}>")
+
+    # Split into several functions, so no single function is unreasonably large.
+    chunk_size = 256
+    chunks = [calls[i : i + chunk_size] for i in range(0, len(calls), chunk_size)]
+    for index, chunk in enumerate(chunks):
+        lines += [f"float sum{index}(float x)", "{", "    float result = 0.0;"]
+        lines += [f"    result += run<{call}>(x);" for call in chunk]
+        lines += ["    return result;", "}", ""]
+
+    lines += [
+        '[shader("compute")]',
+        "[numthreads(64, 1, 1)]",
+        "void computeMain(uint3 threadId: SV_DispatchThreadID)",
+        "{",
+        "    float x = gInput[threadId.x];",
+        "    float result = 0.0;",
+    ]
+    lines += [f"    result += sum{index}(x);" for index in range(len(chunks))]
+    lines += ["    gOutput[threadId.x] = result;", "}"]
+
+    write(
+        "instantiations.slang",
+        [
+            f"{len(calls)} distinct specializations of generic types and of a generic",
+            "function, which exercise checking, specialization and deduplication of the IR.",
+        ],
+        lines,
+    )
+
+
+### network.slang ###
+
+LAYER_COUNT = 32
+ACTIVATIONS = [
+    ("leakyRelu", "return max(x, 0.01 * x);"),
+    ("softplus", "return log(1.0 + exp(x));"),
+    ("sine", "return sin(x);"),
+    ("tanhActivation", "return tanh(x);"),
+]
+
+
+def generate_network():
+    lines = [
+        "static const int kLayerCount = " + str(LAYER_COUNT) + ";",
+        "",
+        "RWStructuredBuffer<float> gParameters;",
+        "RWStructuredBuffer<float> gGradients;",
+        "StructuredBuffer<float4> gInputs;",
+        "",
+        "struct LayerParams : IDifferentiable",
+        "{",
+        "    float4 w0;",
+        "    float4 w1;",
+        "    float4 w2;",
+        "    float4 w3;",
+        "    float4 bias;",
+        "}",
+        "",
+    ]
+    for name, body in ACTIVATIONS:
+        lines += [
+            "[Differentiable]",
+            f"float4 {name}(float4 x)",
+            "{",
+            f"    {body}",
+            "}",
+            "",
+        ]
+
+    for i in range(LAYER_COUNT):
+        activation = ACTIVATIONS[i % len(ACTIVATIONS)][0]
+        lines += [
+            "[Differentiable]",
+            f"float4 layer{i}(float4 x, LayerParams p)",
+            "{",
+            "    float4 y = float4(dot(p.w0, x), dot(p.w1, x), dot(p.w2, x), dot(p.w3, x));",
+        ]
+        if i % 8 == 7:
+            # A residual connection, iterated, so the backward pass has a loop to reverse.
+            lines += [
+                "    [MaxIters(3)]",
+                "    for (int i = 0; i < 3; ++i)",
+                "        y = y + 0.5 * " + activation + "(y * p.bias);",
+                "    return y;",
+            ]
+        else:
+            lines += [f"    return {activation}(y + p.bias);"]
+        lines += ["}", ""]
+
+    lines += [
+        "[Differentiable]",
+        "float evaluate(no_diff float4 input, LayerParams params[kLayerCount])",
+        "{",
+        "    float4 x = input;",
+    ]
+    lines += [f"    x = layer{i}(x, params[{i}]);" for i in range(LAYER_COUNT)]
+    lines += [
+        "    return dot(x, x);",
+        "}",
+        "",
+        "float4 load4(int offset)",
+        "{",
+        "    return float4(",
+        "        gParameters[offset],",
+        "        gParameters[offset + 1],",
+        "        gParameters[offset + 2],",
+        "        gParameters[offset + 3]);",
+        "}",
+        "",
+        "LayerParams loadLayer(int index)",
+        "{",
+        "    LayerParams p;",
+        "    int base = index * 20;",
+        "    p.w0 = load4(base);",
+        "    p.w1 = load4(base + 4);",
+        "    p.w2 = load4(base + 8);",
+        "    p.w3 = load4(base + 12);",
+        "    p.bias = load4(base + 16);",
+        "    return p;",
+        "}",
+        "",
+        "LayerParams.Differential toDifferential(LayerParams p)",
+        "{",
+        "    LayerParams.Differential d;",
+        "    d.w0 = p.w0;",
+        "    d.w1 = p.w1;",
+        "    d.w2 = p.w2;",
+        "    d.w3 = p.w3;",
+        "    d.bias = p.bias;",
+        "    return d;",
+        "}",
+        "",
+        "void storeGradient(uint thread, int index, LayerParams.Differential d)",
+        "{",
+        "    uint base = (thread * kLayerCount + index) * 20;",
+        "    for (int i = 0; i < 4; ++i)",
+        "    {",
+        "        gGradients[base + i] = d.w0[i];",
+        "        gGradients[base + 4 + i] = d.w1[i];",
+        "        gGradients[base + 8 + i] = d.w2[i];",
+        "        gGradients[base + 12 + i] = d.w3[i];",
+        "        gGradients[base + 16 + i] = d.bias[i];",
+        "    }",
+        "}",
+        "",
+        '[shader("compute")]',
+        "[numthreads(32, 1, 1)]",
+        "void backward(uint3 threadId: SV_DispatchThreadID)",
+        "{",
+        "    LayerParams params[kLayerCount];",
+        "    for (int i = 0; i < kLayerCount; ++i)",
+        "        params[i] = loadLayer(i);",
+        "",
+        "    var dpParams = diffPair(params);",
+        "    bwd_diff(evaluate)(gInputs[threadId.x], dpParams, 1.0);",
+        "",
+        "    for (int i = 0; i < kLayerCount; ++i)",
+        "        storeGradient(threadId.x, i, dpParams.d[i]);",
+        "}",
+        "",
+        '[shader("compute")]',
+        "[numthreads(32, 1, 1)]",
+        "void forward(uint3 threadId: SV_DispatchThreadID)",
+        "{",
+        "    LayerParams params[kLayerCount];",
+        "    LayerParams.Differential dParams[kLayerCount];",
+        "    for (int i = 0; i < kLayerCount; ++i)",
+        "    {",
+        "        params[i] = loadLayer(i);",
+        "        dParams[i] = toDifferential(loadLayer((i + int(threadId.x)) % kLayerCount));",
+        "    }",
+        "",
+        "    let result = fwd_diff(evaluate)(gInputs[threadId.x], diffPair(params, dParams));",
+        "    gGradients[threadId.x] = result.d;",
+        "}",
+    ]
+
+    write(
+        "network.slang",
+        [
+            f"Forward and backward derivatives of a network of {LAYER_COUNT} layers with",
+            "different activations and iterated residual connections, which exercise the",
+            "automatic differentiation passes on functions the size users write.",
+        ],
+        lines,
+    )
+
+
+### raytracing.slang ###
+
+HIT_GROUP_COUNT = 24
+
+
+def generate_raytracing():
+    lines = [
+        "struct RayPayload",
+        "{",
+        "    float3 color;",
+        "    float hitT;",
+        "    uint depth;",
+        "}",
+        "",
+        "struct ShadowPayload",
+        "{",
+        "    float visibility;",
+        "}",
+        "",
+        "typealias TriangleAttributes = BuiltInTriangleIntersectionAttributes;",
+        "",
+        "struct SphereAttributes",
+        "{",
+        "    float3 normal;",
+        "}",
+        "",
+        "struct Camera",
+        "{",
+        "    float3 position;",
+        "    float3 forward;",
+        "    float3 right;",
+        "    float3 up;",
+        "}",
+        "",
+        "struct MaterialData",
+        "{",
+        "    float4 baseColor;",
+        "    float3 lightDirection;",
+        "    float roughness;",
+        "    float metallic;",
+        "    float alphaCutoff;",
+        "    uint textureIndex;",
+        "}",
+        "",
+        "RaytracingAccelerationStructure gScene;",
+        "RWTexture2D<float4> gOutput;",
+        "ConstantBuffer<Camera> gCamera;",
+        f"Texture2D<float4> gTextures[{HIT_GROUP_COUNT}];",
+        "SamplerState gLinearSampler;",
+        "StructuredBuffer<MaterialData> gMaterials;",
+        "",
+        "float traceShadow(float3 origin, float3 direction)",
+        "{",
+        "    RayDesc ray;",
+        "    ray.Origin = origin;",
+        "    ray.Direction = direction;",
+        "    ray.TMin = 0.001;",
+        "    ray.TMax = 10000.0;",
+        "",
+        "    ShadowPayload payload;",
+        "    payload.visibility = 0.0;",
+        "    TraceRay(",
+        "        gScene,",
+        "        RAY_FLAG_ACCEPT_FIRST_HIT_AND_END_SEARCH | RAY_FLAG_SKIP_CLOSEST_HIT_SHADER,",
+        "        0xff,",
+        "        0,",
+        "        1,",
+        "        1,",
+        "        ray,",
+        "        payload);",
+        "    return payload.visibility;",
+        "}",
+        "",
+        "float3 traceReflection(float3 origin, float3 direction, uint depth)",
+        "{",
+        "    if (depth >= 2)",
+        "        return float3(0.0);",
+        "",
+        "    RayDesc ray;",
+        "    ray.Origin = origin;",
+        "    ray.Direction = direction;",
+        "    ray.TMin = 0.001;",
+        "    ray.TMax = 10000.0;",
+        "",
+        "    RayPayload payload;",
+        "    payload.color = float3(0.0);",
+        "    payload.hitT = -1.0;",
+        "    payload.depth = depth + 1;",
+        "    TraceRay(gScene, RAY_FLAG_NONE, 0xff, 0, 1, 0, ray, payload);",
+        "    return payload.color;",
+        "}",
+        "",
+        '[shader("raygeneration")]',
+        "void rayGen()",
+        "{",
+        "    uint2 pixel = DispatchRaysIndex().xy;",
+        "    float2 uv = (float2(pixel) + 0.5) / float2(DispatchRaysDimensions().xy);",
+        "    float2 ndc = uv * 2.0 - 1.0;",
+        "",
+        "    RayDesc ray;",
+        "    ray.Origin = gCamera.position;",
+        "    ray.Direction =",
+        "        normalize(gCamera.forward + ndc.x * gCamera.right - ndc.y * gCamera.up);",
+        "    ray.TMin = 0.001;",
+        "    ray.TMax = 10000.0;",
+        "",
+        "    RayPayload payload;",
+        "    payload.color = float3(0.0);",
+        "    payload.hitT = -1.0;",
+        "    payload.depth = 0;",
+        "    TraceRay(gScene, RAY_FLAG_NONE, 0xff, 0, 1, 0, ray, payload);",
+        "    gOutput[pixel] = float4(payload.color, payload.hitT);",
+        "}",
+        "",
+        '[shader("miss")]',
+        "void missEnvironment(inout RayPayload payload)",
+        "{",
+        "    float t = 0.5 * (WorldRayDirection().y + 1.0);",
+        "    payload.color = lerp(float3(1.0, 1.0, 1.0), float3(0.5, 0.7, 1.0), t);",
+        "}",
+        "",
+        '[shader("miss")]',
+        "void missShadow(inout ShadowPayload payload)",
+        "{",
+        "    payload.visibility = 1.0;",
+        "}",
+        "",
+        '[shader("intersection")]',
+        "void intersectSphere()",
+        "{",
+        "    float3 origin = ObjectRayOrigin();",
+        "    float3 direction = ObjectRayDirection();",
+        "    float b = dot(origin, direction);",
+        "    float c = dot(origin, origin) - 1.0;",
+        "    float discriminant = b * b - c * dot(direction, direction);",
+        "    if (discriminant < 0.0)",
+        "        return;",
+        "",
+        "    float t = (-b - sqrt(discriminant)) / dot(direction, direction);",
+        "    SphereAttributes attributes;",
+        "    attributes.normal = normalize(origin + t * direction);",
+        "    ReportHit(t, 0, attributes);",
+        "}",
+        "",
+        '[shader("closesthit")]',
+        "void closestHitSphere(inout RayPayload payload, SphereAttributes attributes)",
+        "{",
+        "    float3 position = WorldRayOrigin() + WorldRayDirection() * RayTCurrent();",
+        "    MaterialData material = gMaterials[InstanceID()];",
+        "    float nDotL = max(dot(attributes.normal, material.lightDirection), 0.0);",
+        "    float visibility = traceShadow(position, material.lightDirection);",
+        "    payload.color = material.baseColor.rgb * nDotL * visibility;",
+        "    payload.hitT = RayTCurrent();",
+        "}",
+        "",
+    ]
+
+    for i in range(HIT_GROUP_COUNT):
+        kind = i % 4
+        lines += [
+            f"float3 shade{i}(MaterialData material, float3 normal, float2 uv, float3 position)",
+            "{",
+            f"    float4 texel = gTextures[{i}].SampleLevel(gLinearSampler, uv, 0.0);",
+            "    float3 albedo = material.baseColor.rgb * texel.rgb;",
+            "    float3 lightDirection = normalize(material.lightDirection);",
+            "    float nDotL = max(dot(normal, lightDirection), 0.0);",
+        ]
+        if kind == 0:
+            # Lambertian
+            lines += ["    float3 color = albedo * nDotL;"]
+        elif kind == 1:
+            # Blinn-Phong
+            lines += [
+                "    float3 halfVector = normalize(lightDirection - WorldRayDirection());",
+                "    float exponent = exp2(10.0 * (1.0 - material.roughness) + 1.0);",
+                "    float specular = pow(max(dot(normal, halfVector), 0.0), exponent);",
+                "    float3 color = albedo * nDotL + specular * material.metallic;",
+            ]
+        elif kind == 2:
+            # GGX with a reflection ray
+            lines += [
+                "    float3 view = -WorldRayDirection();",
+                "    float3 halfVector = normalize(lightDirection + view);",
+                "    float alpha = material.roughness * material.roughness;",
+                "    float nDotH = max(dot(normal, halfVector), 0.0);",
+                "    float denominator = nDotH * nDotH * (alpha * alpha - 1.0) + 1.0;",
+                "    float distribution =",
+                "        alpha * alpha / (3.14159265 * denominator * denominator);",
+                "    float3 f0 = lerp(float3(0.04, 0.04, 0.04), albedo, material.metallic);",
+                "    float vDotH = max(dot(view, halfVector), 0.0);",
+                "    float3 fresnel = f0 + (1.0 - f0) * pow(1.0 - vDotH, 5.0);",
+                "    float3 diffuse = albedo * (1.0 - material.metallic);",
+                "    float3 color = (diffuse + fresnel * distribution) * nDotL;",
+                "    color += fresnel * traceReflection(position, reflect(-view, normal), 1);",
+            ]
+        else:
+            # Emissive with a rim
+            lines += [
+                "    float rim = pow(1.0 - abs(dot(normal, -WorldRayDirection())), 3.0);",
+                "    float3 color = albedo * (nDotL + 0.2) + texel.a * rim * material.baseColor.a;",
+            ]
+        lines += ["    return color;", "}", ""]
+
+        lines += [
+            '[shader("closesthit")]',
+            f"void closestHit{i}(inout RayPayload payload, TriangleAttributes attributes)",
+            "{",
+            "    float2 uv = attributes.barycentrics;",
+            "    float3 position = WorldRayOrigin() + WorldRayDirection() * RayTCurrent();",
+            f"    MaterialData material = gMaterials[InstanceID() * {HIT_GROUP_COUNT} + {i}];",
+            "    float3 objectNormal = normalize(float3(uv, 1.0 - uv.x - uv.y));",
+            "    float3 normal = normalize(mul(ObjectToWorld3x4(), float4(objectNormal, 0.0)));",
+            f"    float3 color = shade{i}(material, normal, uv, position);",
+            "    float visibility = traceShadow(position, normalize(material.lightDirection));",
+            "    payload.color = color * (0.25 + 0.75 * visibility);",
+            "    payload.hitT = RayTCurrent();",
+            "}",
+            "",
+        ]
+
+        if i % 2 == 0:
+            lines += [
+                '[shader("anyhit")]',
+                f"void anyHit{i}(inout RayPayload payload, TriangleAttributes attributes)",
+                "{",
+                f"    MaterialData material = gMaterials[InstanceID() * {HIT_GROUP_COUNT} + {i}];",
+                "    float2 uv = attributes.barycentrics;",
+                f"    float4 texel = gTextures[{i}].SampleLevel(gLinearSampler, uv, 0.0);",
+                "    if (texel.a < material.alphaCutoff)",
+                "        IgnoreHit();",
+                "}",
+                "",
+            ]
+
+    write(
+        "raytracing.slang",
+        [
+            f"A ray tracing pipeline with {HIT_GROUP_COUNT} triangle hit groups, half of them",
+            "alpha tested, a procedural hit group, shadow and reflection rays, which exercise",
+            "compiling many entry points of one module.",
+        ],
+        lines[:-1],
+        targets=["spirv", "hlsl", "dxil", "glsl"],
+    )
+
+
+### permutations.slang ###
+
+FEATURES = ["USE_NORMAL_MAP", "USE_EMISSIVE", "USE_CLEARCOAT", "USE_ALPHA_TEST", "USE_SHEEN"]
+
+
+def generate_permutations():
+    count = 1 << len(FEATURES)
+    lines = [
+        '#include "include/material-common.slangh"',
+        "",
+    ]
+    for index in range(count):
+        lines.append(f"#define MATERIAL_NAME evaluateMaterial{index}")
+        for bit, feature in enumerate(FEATURES):
+            lines.append(f"#define {feature} {(index >> bit) & 1}")
+        lines.append('#include "include/material-permutation.slangh"')
+        lines.append("")
+
+    lines += [
+        "cbuffer MaterialSelection",
+        "{",
+        "    uint gPermutation;",
+        "}",
+        "",
+        "float4 evaluate(MaterialInputs inputs)",
+        "{",
+        "    switch (gPermutation)",
+        "    {",
+    ]
+    for index in range(count):
+        lines.append(f"    case {index}:")
+        lines.append(f"        return evaluateMaterial{index}(inputs);")
+    lines += [
+        "    default:",
+        "        return float4(1.0, 0.0, 1.0, 1.0);",
+        "    }",
+        "}",
+        "",
+        '[shader("fragment")]',
+        "float4 fragmentMain(",
+        "    float3 position: POSITION,",
+        "    float3 normal: NORMAL,",
+        "    float4 tangent: TANGENT,",
+        "    float2 uv: TEXCOORD0)",
+        "    : SV_Target",
+        "{",
+        "    MaterialInputs inputs;",
+        "    inputs.position = position;",
+        "    inputs.normal = normalize(normal);",
+        "    inputs.tangent = tangent;",
+        "    inputs.uv = uv;",
+        "    return evaluate(inputs);",
+        "}",
+    ]
+
+    write(
+        "permutations.slang",
+        [
+            f"{count} permutations of a material, each including the same tree of headers",
+            "with a different combination of features, which exercise the preprocessor and",
+            "checking many similar functions.",
+        ],
+        lines,
+    )
+
+
+if __name__ == "__main__":
+    generate_instantiations()
+    generate_network()
+    generate_raytracing()
+    generate_permutations()
@@ -82,26 +82,46 @@ struct ShaderCacheTest
 
         struct Context
         {
+            ShaderCacheTest* test;
             ISlangMutableFileSystem* fileSystem;
             const String& directory;
-        } context{osFileSystem, directory};
+        } context{this, osFileSystem, directory};
 
+        // The cache directory also holds the directory of cached modules.
         osFileSystem->enumeratePathContents(
             directory.getBuffer(),
             [](SlangPathType pathType, const char* fileName, void* userData)
             {
                 struct Context* context = static_cast<Context*>(userData);
+                String path = Path::simplify(context->directory + "/" + fileName);
                 if (pathType == SlangPathType::SLANG_PATH_TYPE_FILE)
                 {
-                    String path = Path::simplify(context->directory + "/" + fileName);
                     context->fileSystem->remove(path.getBuffer());
                 }
+                else if (pathType == SlangPathType::SLANG_PATH_TYPE_DIRECTORY)
+                {
+                    context->test->removeDirectory(path);
+                }
             },
             &context);
 
         osFileSystem->remove(directory.getBuffer());
     }
 
+    Index countModuleCacheFiles()
+    {
+        Index count = 0;
+        OSFileSystem::getMutableSingleton()->enumeratePathContents(
+            Path::simplify(cacheDirectory + "/modules").getBuffer(),
+            [](SlangPathType pathType, const char* fileName, void* userData)
+            {
+                if (pathType == SlangPathType::SLANG_PATH_TYPE_FILE)
+                    ++*static_cast<Index*>(userData);
+            },
+            &count);
+        return count;
+    }
+
     void writeShader(const String& source, const String& fileName)
     {
         diskFileSystem->saveFile(fileName.getBuffer(), source.getBuffer(), source.getLength());
@@ -316,6 +336,8 @@ struct ShaderCacheSourceFile : ShaderCacheTest
                 SLANG_CHECK(getStats().missCount == 3);
                 SLANG_CHECK(getStats().hitCount == 0);
                 SLANG_CHECK(getStats().entryCount == 3);
+                // The checked modules are cached too, so that they aren't checked again.
+                SLANG_CHECK(countModuleCacheFiles() == 3);
             });
 
         // Cache is hot and we expect 3 hits.
@@ -9,7 +9,10 @@
 #include "cpu-shader-program.h"
 #include "cpu-texture.h"
 
+#include <algorithm>
 #include <chrono>
+#include <thread>
+#include <vector>
 
 namespace gfx
 {
@@ -31,7 +34,8 @@ SLANG_NO_THROW Result SLANG_MCALL DeviceImpl::initialize(const Desc& desc)
         desc.extendedDescs,
         SLANG_SHADER_HOST_CALLABLE,
         "sm_5_1",
-        makeArray(slang::PreprocessorMacroDesc{"__CPU__", "1"}).getView()));
+        makeArray(slang::PreprocessorMacroDesc{"__CPU__", "1"}).getView(),
+        desc.shaderCache.shaderCachePath));
 
     SLANG_RETURN_ON_FAIL(RendererBase::initialize(desc));
 
@@ -289,7 +293,45 @@ void DeviceImpl::dispatchCompute(int x, int y, int z)
 
     auto globalParamsData = m_currentRootObject->getDataBuffer();
     auto entryPointParamsData = entryPointObject->getDataBuffer();
-    func(&varyingInput, entryPointParamsData, globalParamsData);
+
+    // The groups of a dispatch are independent, so the range of groups is split into slabs
+    // along its longest axis, and each slab is run on a thread of its own. The kernel runs the
+    // groups of a range one after another, and `groupshared` variables are thread local.
+    size_t axis = 0;
+    for (size_t i = 1; i < 3; ++i)
+    {
+        if (varyingInput.endGroupID[i] > varyingInput.endGroupID[axis])
+            axis = i;
+    }
+    const uint32_t axisCount = varyingInput.endGroupID[axis];
+    const uint32_t threadCount =
+        std::min(uint32_t(std::thread::hardware_concurrency()), axisCount);
+    if (threadCount <= 1)
+    {
+        func(&varyingInput, entryPointParamsData, globalParamsData);
+        return;
+    }
+
+    std::vector<slang_prelude::ComputeVaryingInput> slabs(threadCount, varyingInput);
+    std::vector<std::thread> threads;
+    threads.reserve(threadCount - 1);
+    for (uint32_t i = 0; i < threadCount; ++i)
+    {
+        auto& slab = slabs[i];
+        slab.startGroupID[axis] = uint32_t(uint64_t(axisCount) * i / threadCount);
+        slab.endGroupID[axis] = uint32_t(uint64_t(axisCount) * (i + 1) / threadCount);
+        if (i + 1 == threadCount)
+        {
+            // The calling thread runs the last slab itself.
+            func(&slab, entryPointParamsData, globalParamsData);
+            break;
+        }
+        threads.emplace_back(
+            [func, &slab, entryPointParamsData, globalParamsData]()
+            { func(&slab, entryPointParamsData, globalParamsData); });
+    }
+    for (auto& thread : threads)
+        thread.join();
 }
 
 void DeviceImpl::copyBuffer(
@@ -150,7 +150,8 @@ SLANG_NO_THROW SlangResult SLANG_MCALL DeviceImpl::initialize(const Desc& desc)
         desc.extendedDescs,
         SLANG_PTX,
         "sm_5_1",
-        makeArray(slang::PreprocessorMacroDesc{"__CUDA_COMPUTE__", "1"}).getView()));
+        makeArray(slang::PreprocessorMacroDesc{"__CUDA_COMPUTE__", "1"}).getView(),
+        desc.shaderCache.shaderCachePath));
 
     SLANG_RETURN_ON_FAIL(RendererBase::initialize(desc));
 
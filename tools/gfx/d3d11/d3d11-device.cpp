@@ -37,7 +37,8 @@ SlangResult DeviceImpl::initialize(const Desc& desc)
         desc.extendedDescs,
         SLANG_DXBC,
         "sm_5_0",
-        makeArray(slang::PreprocessorMacroDesc{"__D3D11__", "1"}).getView()));
+        makeArray(slang::PreprocessorMacroDesc{"__D3D11__", "1"}).getView(),
+        desc.shaderCache.shaderCachePath));
 
     SLANG_RETURN_ON_FAIL(RendererBase::initialize(desc));
 
@@ -44,6 +44,7 @@ void CommandQueueImpl::executeCommandBuffers(
     IFence* fence,
     uint64_t valueToSignal)
 {
+    std::lock_guard<std::mutex> lock(m_mutex);
     ShortList<ID3D12CommandList*> commandLists;
     for (GfxCount i = 0; i < count; i++)
     {
@@ -78,6 +79,7 @@ void CommandQueueImpl::executeCommandBuffers(
 
 void CommandQueueImpl::waitOnHost()
 {
+    std::lock_guard<std::mutex> lock(m_mutex);
     m_fenceValue++;
     m_d3dQueue->Signal(m_fence, m_fenceValue);
     ResetEvent(globalWaitHandle);
@@ -25,6 +25,8 @@ public:
     ComPtr<ID3D12CommandQueue> m_d3dQueue;
     ComPtr<ID3D12Fence> m_fence;
     uint64_t m_fenceValue = 0;
+    /// Guards submission and `m_fenceValue`, which may be used from several threads.
+    std::mutex m_mutex;
     HANDLE globalWaitHandle;
     Desc m_desc;
     uint32_t m_queueIndex = 0;
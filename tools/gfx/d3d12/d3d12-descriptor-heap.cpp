@@ -10,6 +10,17 @@ D3D12DescriptorHeap::D3D12DescriptorHeap()
 {
 }
 
+D3D12DescriptorHeap& D3D12DescriptorHeap::operator=(const ThisType& rhs)
+{
+    m_device = rhs.m_device;
+    m_heap = rhs.m_heap;
+    m_totalSize = rhs.m_totalSize;
+    m_currentIndex.store(rhs.getUsedSize(), std::memory_order_relaxed);
+    m_descriptorSize = rhs.m_descriptorSize;
+    m_heapFlags = rhs.m_heapFlags;
+    return *this;
+}
+
 Result D3D12DescriptorHeap::init(
     ID3D12Device* device,
     int size,
@@ -6,15 +6,18 @@
 #include "core/slang-virtual-object-pool.h"
 #include "slang-com-ptr.h"
 
+#include <atomic>
 #include <d3d12.h>
 #include <dxgi.h>
+#include <mutex>
 
 namespace gfx
 {
 
 /*! \brief A simple class to manage an underlying Dx12 Descriptor Heap. Allocations are made
 linearly in order. It is not possible to free individual allocations, but all allocations can be
-deallocated with 'deallocateAll'. */
+deallocated with 'deallocateAll'. 'tryAllocate' is lock-free and may be called from several threads
+at once; growing a heap that isn't shader visible is not thread-safe. */
 class D3D12DescriptorHeap
 {
 public:
@@ -35,7 +38,10 @@ public:
         D3D12_DESCRIPTOR_HEAP_FLAGS flags);
 
     /// Returns the number of slots that have been used
-    SLANG_FORCE_INLINE int getUsedSize() const { return m_currentIndex; }
+    SLANG_FORCE_INLINE int getUsedSize() const
+    {
+        return m_currentIndex.load(std::memory_order_relaxed);
+    }
 
     /// Get the total amount of descriptors possible on the heap
     SLANG_FORCE_INLINE int getTotalSize() const { return m_totalSize; }
@@ -43,13 +49,16 @@ public:
     SLANG_FORCE_INLINE int allocate();
     /// Allocate a number of descriptors. Returns the start index (or -1 if not possible)
     SLANG_FORCE_INLINE int allocate(int numDescriptors);
+    /// Allocate a number of descriptors without growing the heap. Returns the start index, or -1
+    /// if there isn't enough space left.
+    SLANG_FORCE_INLINE int tryAllocate(int numDescriptors);
 
     ///
     SLANG_FORCE_INLINE int placeAt(int index);
 
     /// Deallocates all allocations, and starts allocation from the start of the underlying heap
     /// again
-    SLANG_FORCE_INLINE void deallocateAll() { m_currentIndex = 0; }
+    SLANG_FORCE_INLINE void deallocateAll() { m_currentIndex.store(0, std::memory_order_relaxed); }
 
     /// Get the size of each
     SLANG_FORCE_INLINE int getDescriptorSize() const { return m_descriptorSize; }
@@ -75,12 +84,14 @@ public:
 
     /// Ctor
     D3D12DescriptorHeap();
+    D3D12DescriptorHeap(const ThisType& rhs) { *this = rhs; }
+    ThisType& operator=(const ThisType& rhs);
 
 protected:
     Slang::ComPtr<ID3D12Device> m_device;
     Slang::ComPtr<ID3D12DescriptorHeap> m_heap; ///< The underlying heap being allocated from
     int m_totalSize;                         ///< Total amount of allocations available on the heap
-    int m_currentIndex;                      ///< The current descriptor
+    std::atomic<int> m_currentIndex;         ///< The current descriptor
     int m_descriptorSize;                    ///< The size of each descriptor
     D3D12_DESCRIPTOR_HEAP_FLAGS m_heapFlags; ///< The flags of the heap
 };
@@ -289,28 +300,49 @@ public:
     }
 };
 
+/// A linear allocator that adds sub-heaps as it fills up.
+///
+/// Allocating is lock-free unless the current sub-heap is full, in which case a lock is taken
+/// to move on to the next sub-heap, so several threads can allocate staging descriptors at once.
 class D3D12LinearExpandingDescriptorHeap : public Slang::RefObject
 {
+    /// Indices encode the sub-heap in their top 8 bits.
+    static const int kMaxSubHeapCount = 256;
+
     ID3D12Device* m_device;
     D3D12_DESCRIPTOR_HEAP_TYPE m_type;
     D3D12_DESCRIPTOR_HEAP_FLAGS m_flag;
     int m_chunkSize;
-    Slang::ShortList<D3D12DescriptorHeap, 4> m_subHeaps;
-    int32_t m_subHeapIndex;
-
-public:
-    Slang::Result newSubHeap()
-    {
-        m_subHeapIndex++;
-        if (m_subHeapIndex <= m_subHeaps.getCount())
+    D3D12DescriptorHeap m_subHeaps[kMaxSubHeapCount];
+    /// The number of sub-heaps that have been created. Guarded by `m_mutex`.
+    int32_t m_subHeapCount = 0;
+    std::atomic<int32_t> m_subHeapIndex;
+    std::mutex m_mutex;
+
+    /// Moves on from the sub-heap at `fullIndex`, unless another thread already has.
+    Slang::Result newSubHeap(int32_t fullIndex)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        const int32_t nextIndex = fullIndex + 1;
+        if (m_subHeapIndex.load(std::memory_order_relaxed) != fullIndex)
+            return SLANG_OK;
+        if (nextIndex >= kMaxSubHeapCount)
+            return SLANG_E_OUT_OF_MEMORY;
+        if (nextIndex < m_subHeapCount)
+        {
+            m_subHeaps[nextIndex].deallocateAll();
+        }
+        else
         {
-            D3D12DescriptorHeap subHeap;
-            SLANG_RETURN_ON_FAIL(subHeap.init(m_device, m_chunkSize, m_type, m_flag));
-            m_subHeaps.add(Slang::_Move(subHeap));
+            SLANG_RETURN_ON_FAIL(
+                m_subHeaps[nextIndex].init(m_device, m_chunkSize, m_type, m_flag));
+            m_subHeapCount = nextIndex + 1;
         }
+        m_subHeapIndex.store(nextIndex, std::memory_order_release);
         return SLANG_OK;
     }
 
+public:
     Slang::Result init(
         ID3D12Device* device,
         int chunkSize,
@@ -321,21 +353,25 @@ public:
         m_chunkSize = chunkSize;
         m_type = type;
         m_flag = flag;
-        m_subHeapIndex = -1;
-        return newSubHeap();
+        m_subHeapIndex.store(-1, std::memory_order_relaxed);
+        return newSubHeap(-1);
     }
 
     int allocate(int count)
     {
-        auto result = m_subHeaps[m_subHeapIndex].allocate(count);
-        if (result == -1)
+        assert(count <= m_chunkSize);
+        for (;;)
         {
-            newSubHeap();
-            return allocate(count);
+            const int32_t subHeapIndex = m_subHeapIndex.load(std::memory_order_acquire);
+            const int result = m_subHeaps[subHeapIndex].tryAllocate(count);
+            if (result != -1)
+            {
+                assert(result <= 0xFFFFFF);
+                return (subHeapIndex << 24) + result;
+            }
+            if (SLANG_FAILED(newSubHeap(subHeapIndex)))
+                return -1;
         }
-        assert(result <= 0xFFFFFF);
-        assert(m_subHeapIndex <= 255);
-        return (m_subHeapIndex << 24) + result;
     }
 
     SLANG_FORCE_INLINE D3D12_CPU_DESCRIPTOR_HANDLE getCpuHandle(int index) const
@@ -348,11 +384,12 @@ public:
 
     void free(D3D12Descriptor descriptor) { assert(0 && "not supported"); }
 
+    /// Must not be called while another thread is allocating.
     void freeAll()
     {
-        for (auto& subHeap : m_subHeaps)
-            subHeap.deallocateAll();
-        m_subHeapIndex = 0;
+        for (int32_t i = 0; i < m_subHeapCount; ++i)
+            m_subHeaps[i].deallocateAll();
+        m_subHeapIndex.store(0, std::memory_order_relaxed);
     }
 };
 
@@ -475,14 +512,25 @@ int D3D12DescriptorHeap::allocate()
     return allocate(1);
 }
 // ---------------------------------------------------------------------------
+int D3D12DescriptorHeap::tryAllocate(int numDescriptors)
+{
+    int index = m_currentIndex.load(std::memory_order_relaxed);
+    do
+    {
+        if (index + numDescriptors > m_totalSize)
+            return -1;
+    } while (!m_currentIndex.compare_exchange_weak(
+        index,
+        index + numDescriptors,
+        std::memory_order_relaxed));
+    return index;
+}
+// ---------------------------------------------------------------------------
 int D3D12DescriptorHeap::allocate(int numDescriptors)
 {
-    if (m_currentIndex + numDescriptors <= m_totalSize)
-    {
-        const int index = m_currentIndex;
-        m_currentIndex += numDescriptors;
-        return index;
-    }
+    const int allocatedIndex = tryAllocate(numDescriptors);
+    if (allocatedIndex != -1)
+        return allocatedIndex;
     if (m_heapFlags & D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE)
     {
         // No automatic resizing for GPU visible heaps.
@@ -491,7 +539,7 @@ int D3D12DescriptorHeap::allocate(int numDescriptors)
     // We don't have enough heap size, resize the heap.
     auto oldHeap = m_heap;
     auto oldSize = m_totalSize;
-    auto currentIndex = m_currentIndex;
+    int currentIndex = m_currentIndex.load(std::memory_order_relaxed);
     auto desc = m_heap->GetDesc();
     this->init(m_device, (int)desc.NumDescriptors * 2, desc.Type, desc.Flags);
     m_device->CopyDescriptorsSimple(
@@ -499,17 +547,15 @@ int D3D12DescriptorHeap::allocate(int numDescriptors)
         m_heap->GetCPUDescriptorHandleForHeapStart(),
         oldHeap->GetCPUDescriptorHandleForHeapStart(),
         desc.Type);
-    m_currentIndex = currentIndex;
     // Now allocate again.
-    const int index = m_currentIndex;
-    m_currentIndex += numDescriptors;
-    return index;
+    m_currentIndex.store(currentIndex + numDescriptors, std::memory_order_relaxed);
+    return currentIndex;
 }
 // ---------------------------------------------------------------------------
 SLANG_FORCE_INLINE int D3D12DescriptorHeap::placeAt(int index)
 {
     assert(index >= 0 && index < m_totalSize);
-    m_currentIndex = index + 1;
+    m_currentIndex.store(index + 1, std::memory_order_relaxed);
     return index;
 }
 
@@ -957,7 +957,8 @@ Result DeviceImpl::initialize(const Desc& desc)
         desc.extendedDescs,
         compileTarget,
         profileName,
-        makeArray(slang::PreprocessorMacroDesc{"__D3D12__", "1"}).getView()));
+        makeArray(slang::PreprocessorMacroDesc{"__D3D12__", "1"}).getView(),
+        desc.shaderCache.shaderCachePath));
 
     // Allocate a D3D12 "command signature" object that matches the behavior
     // of a D3D11-style `DrawInstancedIndirect` operation.
@@ -2317,6 +2318,7 @@ void* DeviceImpl::loadProc(SharedLibrary::Handle module, char const* name)
 DeviceImpl::~DeviceImpl()
 {
     m_shaderObjectLayoutCache = decltype(m_shaderObjectLayoutCache)();
+    m_shaderObjectLayoutsByKey = decltype(m_shaderObjectLayoutsByKey)();
 }
 
 
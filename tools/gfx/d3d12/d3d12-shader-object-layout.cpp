@@ -48,13 +48,38 @@ bool ShaderObjectLayoutImpl::isBindingRangeRootParameter(
     return isRootParameter;
 }
 
+Result ShaderObjectLayoutImpl::Builder::_getSubObjectLayout(
+    slang::TypeLayoutReflection* elementType,
+    RefPtr<ShaderObjectLayoutImpl>& outLayout)
+{
+    // Building a layout walks the reflection of the type, and counts its root parameters and
+    // descriptors, which needs doing only once for all the programs that use the type.
+    std::lock_guard<std::recursive_mutex> lock(m_renderer->m_specializationMutex);
+    String key;
+    if (auto layout = m_renderer->findShaderObjectLayoutByKey(m_session, elementType, key))
+    {
+        outLayout = static_cast<ShaderObjectLayoutImpl*>(layout);
+        return SLANG_OK;
+    }
+    SLANG_RETURN_ON_FAIL(createForElementType(
+        m_renderer,
+        m_session,
+        elementType,
+        outLayout.writeRef(),
+        m_typeLayoutOwner));
+    m_renderer->addShaderObjectLayoutForKey(key, m_session, outLayout, m_typeLayoutOwner);
+    return SLANG_OK;
+}
+
 Result ShaderObjectLayoutImpl::createForElementType(
     RendererBase* renderer,
     slang::ISession* session,
     slang::TypeLayoutReflection* elementType,
-    ShaderObjectLayoutImpl** outLayout)
+    ShaderObjectLayoutImpl** outLayout,
+    slang::IComponentType* typeLayoutOwner)
 {
     Builder builder(renderer, session);
+    builder.m_typeLayoutOwner = typeLayoutOwner;
     builder.setElementTypeLayout(elementType);
     return builder.build(outLayout);
 }
@@ -240,20 +265,12 @@ Result ShaderObjectLayoutImpl::Builder::setElementTypeLayout(
         {
             if (auto pendingTypeLayout = slangLeafTypeLayout->getPendingDataTypeLayout())
             {
-                createForElementType(
-                    m_renderer,
-                    m_session,
-                    pendingTypeLayout,
-                    subObjectLayout.writeRef());
+                _getSubObjectLayout(pendingTypeLayout, subObjectLayout);
             }
         }
         else
         {
-            createForElementType(
-                m_renderer,
-                m_session,
-                slangLeafTypeLayout->getElementTypeLayout(),
-                subObjectLayout.writeRef());
+            _getSubObjectLayout(slangLeafTypeLayout->getElementTypeLayout(), subObjectLayout);
         }
 
         SubObjectRangeInfo subObjectRange;
@@ -1023,7 +1040,8 @@ Result RootShaderObjectLayoutImpl::create(
             device,
             program->getSession(),
             slangEntryPoint->getTypeLayout(),
-            entryPointLayout.writeRef()));
+            entryPointLayout.writeRef(),
+            program));
         builder.addEntryPoint(slangEntryPoint->getStage(), entryPointLayout);
     }
 
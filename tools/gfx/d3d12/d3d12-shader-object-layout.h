@@ -136,6 +136,11 @@ public:
         RendererBase* m_renderer;
         slang::ISession* m_session;
         slang::TypeLayoutReflection* m_elementTypeLayout;
+
+        /// The program that the type layouts belong to, or nullptr if they belong to the
+        /// session. Sub-object layouts shared through the device keep it alive.
+        slang::IComponentType* m_typeLayoutOwner = nullptr;
+
         List<BindingRangeInfo> m_bindingRanges;
         List<SubObjectRangeInfo> m_subObjectRanges;
         List<RootParameterInfo> m_rootParamsInfo;
@@ -166,6 +171,12 @@ public:
 
         Result setElementTypeLayout(slang::TypeLayoutReflection* typeLayout);
 
+        /// Get the layout of sub-objects of `elementType`, using the one the device built
+        /// for the same type layout in another program if there is one.
+        Result _getSubObjectLayout(
+            slang::TypeLayoutReflection* elementType,
+            RefPtr<ShaderObjectLayoutImpl>& outLayout);
+
         Result build(ShaderObjectLayoutImpl** outLayout);
     };
 
@@ -173,7 +184,8 @@ public:
         RendererBase* renderer,
         slang::ISession* session,
         slang::TypeLayoutReflection* elementType,
-        ShaderObjectLayoutImpl** outLayout);
+        ShaderObjectLayoutImpl** outLayout,
+        slang::IComponentType* typeLayoutOwner = nullptr);
 
     List<BindingRangeInfo> const& getBindingRanges() { return m_bindingRanges; }
 
@@ -249,6 +261,7 @@ public:
             , m_program(program)
             , m_programLayout(programLayout)
         {
+            m_typeLayoutOwner = program;
         }
 
         Result build(RootShaderObjectLayoutImpl** outLayout);
@@ -244,6 +244,7 @@ Result ShaderObjectImpl::init(
 Result ShaderObjectImpl::_writeOrdinaryData(
     PipelineCommandEncoder* encoder,
     BufferResourceImpl* buffer,
+    void* mappedData,
     Offset offset,
     Size destSize,
     ShaderObjectLayoutImpl* specializedLayout)
@@ -253,14 +254,21 @@ Result ShaderObjectImpl::_writeOrdinaryData(
 
     SLANG_ASSERT(srcSize <= destSize);
 
-    uploadBufferDataImpl(
-        encoder->m_device,
-        encoder->m_d3dCmdList,
-        encoder->m_transientHeap,
-        buffer,
-        offset,
-        srcSize,
-        src);
+    if (mappedData)
+    {
+        memcpy((char*)mappedData + offset, src, srcSize);
+    }
+    else
+    {
+        uploadBufferDataImpl(
+            encoder->m_device,
+            encoder->m_d3dCmdList,
+            encoder->m_transientHeap,
+            buffer,
+            offset,
+            srcSize,
+            src);
+    }
 
     // In the case where this object has any sub-objects of
     // existential/interface type, we need to recurse on those objects
@@ -342,6 +350,7 @@ Result ShaderObjectImpl::_writeOrdinaryData(
             subObject->_writeOrdinaryData(
                 encoder,
                 buffer,
+                mappedData,
                 offset + subObjectOffset,
                 destSize - subObjectOffset,
                 subObjectLayout);
@@ -395,10 +404,12 @@ Result ShaderObjectImpl::_ensureOrdinaryDataBufferCreatedIfNeeded(
     // it from the transient resource heap.
     //
     auto alignedConstantBufferSize = D3DUtil::calcAligned(m_constantBufferSize, 256);
+    void* mappedData = nullptr;
     SLANG_RETURN_ON_FAIL(encoder->m_commandBuffer->m_transientHeap->allocateConstantBuffer(
         alignedConstantBufferSize,
         m_constantBufferWeakPtr,
-        m_constantBufferOffset));
+        m_constantBufferOffset,
+        &mappedData));
 
     // Once the buffer is allocated, we can use `_writeOrdinaryData` to fill it in.
     //
@@ -409,6 +420,7 @@ Result ShaderObjectImpl::_ensureOrdinaryDataBufferCreatedIfNeeded(
     SLANG_RETURN_ON_FAIL(_writeOrdinaryData(
         encoder,
         static_cast<BufferResourceImpl*>(m_constantBufferWeakPtr),
+        mappedData,
         m_constantBufferOffset,
         m_constantBufferSize,
         specializedLayout));
@@ -593,7 +605,7 @@ bool ShaderObjectImpl::checkIfCachedDescriptorSetIsValidRecursive(BindingContext
             auto subObject = m_objects[objectIndex].Ptr();
             if (!subObject)
                 continue;
-            if (subObject->checkIfCachedDescriptorSetIsValidRecursive(context))
+            if (!subObject->checkIfCachedDescriptorSetIsValidRecursive(context))
                 return false;
         }
     }
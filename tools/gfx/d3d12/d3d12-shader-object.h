@@ -130,10 +130,12 @@ protected:
         DescriptorHeapReference samplerHeap);
 
     /// Write the uniform/ordinary data of this object into the given `dest` buffer at the given
-    /// `offset`
+    /// `offset`. If `mappedData` is the mapped memory of `buffer`, the data is written there
+    /// directly; otherwise it is uploaded through the encoder.
     Result _writeOrdinaryData(
         PipelineCommandEncoder* encoder,
         BufferResourceImpl* buffer,
+        void* mappedData,
         Offset offset,
         Size destSize,
         ShaderObjectLayoutImpl* specializedLayout);
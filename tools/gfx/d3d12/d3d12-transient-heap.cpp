@@ -124,7 +124,7 @@ Result TransientResourceHeapImpl::init(
     uint32_t viewHeapSize,
     uint32_t samplerHeapSize)
 {
-    Super::init(desc, D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT, device);
+    Super::init(desc, D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT, device, true);
     m_canResize = (desc.flags & ITransientResourceHeap::Flags::AllowResizing) != 0;
     m_viewHeapSize = viewHeapSize;
     m_samplerHeapSize = samplerHeapSize;
@@ -81,7 +81,8 @@ SlangResult DeviceImpl::initialize(const Desc& desc)
         desc.extendedDescs,
         SLANG_METAL_LIB,
         "",
-        makeArray(slang::PreprocessorMacroDesc{"__METAL__", "1"}).getView()));
+        makeArray(slang::PreprocessorMacroDesc{"__METAL__", "1"}).getView(),
+        desc.shaderCache.shaderCachePath));
 
     // TODO: expose via some other means
     if (captureEnabled())
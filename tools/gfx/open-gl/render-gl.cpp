@@ -2130,7 +2130,8 @@ SLANG_NO_THROW Result SLANG_MCALL GLDevice::initialize(const Desc& desc)
         desc.extendedDescs,
         SLANG_GLSL,
         "glsl_440",
-        makeArray(slang::PreprocessorMacroDesc{"__GL__", "1"}).getView()));
+        makeArray(slang::PreprocessorMacroDesc{"__GL__", "1"}).getView(),
+        desc.shaderCache.shaderCachePath));
 
     SLANG_RETURN_ON_FAIL(RendererBase::initialize(desc));
 
@@ -425,6 +425,12 @@ SLANG_NO_THROW Result SLANG_MCALL RendererBase::initialize(const Desc& desc)
         cacheDesc.directory = desc.shaderCache.shaderCachePath;
         cacheDesc.maxEntryCount = desc.shaderCache.maxEntryCount;
         persistentShaderCache = new PersistentCache(cacheDesc);
+        moduleCachePath = SlangContext::getModuleCachePath(desc.shaderCache.shaderCachePath);
+
+        String pipelineCachePath = Path::combine(desc.shaderCache.shaderCachePath, "pipelines");
+        PersistentCache::Desc pipelineCacheDesc;
+        pipelineCacheDesc.directory = pipelineCachePath.getBuffer();
+        persistentPipelineCache = new PersistentCache(pipelineCacheDesc);
     }
 
     if (desc.apiCommandDispatcher)
@@ -799,6 +805,7 @@ Result RendererBase::getShaderObjectLayout(
     slang::TypeLayoutReflection* typeLayout,
     ShaderObjectLayoutBase** outLayout)
 {
+    std::lock_guard<std::recursive_mutex> lock(m_specializationMutex);
     RefPtr<ShaderObjectLayoutBase> shaderObjectLayout;
     if (!m_shaderObjectLayoutCache.tryGetValue(typeLayout, shaderObjectLayout))
     {
@@ -810,9 +817,168 @@ Result RendererBase::getShaderObjectLayout(
     return SLANG_OK;
 }
 
+static void _appendVarLayoutKey(slang::VariableLayoutReflection* varLayout, StringBuilder& out)
+{
+    if (!varLayout)
+    {
+        out << "-;";
+        return;
+    }
+    out << "v" << (uint64_t)varLayout->getVariable();
+    const unsigned categoryCount = varLayout->getCategoryCount();
+    for (unsigned i = 0; i < categoryCount; ++i)
+    {
+        const auto category = varLayout->getCategoryByIndex(i);
+        out << "," << int(category) << ":" << uint64_t(varLayout->getOffset(category)) << ":"
+            << uint64_t(varLayout->getBindingSpace(category));
+    }
+    out << ";";
+}
+
+static void _appendTypeLayoutKey(slang::TypeLayoutReflection* typeLayout, StringBuilder& out)
+{
+    if (!typeLayout)
+    {
+        out << "-;";
+        return;
+    }
+
+    out << "t" << (uint64_t)typeLayout->getType() << "," << int(typeLayout->getKind());
+    const unsigned categoryCount = typeLayout->getCategoryCount();
+    for (unsigned i = 0; i < categoryCount; ++i)
+    {
+        const auto category = typeLayout->getCategoryByIndex(i);
+        out << "," << int(category) << ":" << uint64_t(typeLayout->getSize(category)) << ":"
+            << uint64_t(typeLayout->getStride(category)) << ":"
+            << typeLayout->getAlignment(category);
+    }
+    out << ";";
+
+    // The fields carry the offsets of ordinary data within the object.
+    const unsigned fieldCount = typeLayout->getFieldCount();
+    for (unsigned i = 0; i < fieldCount; ++i)
+        _appendVarLayoutKey(typeLayout->getFieldByIndex(i), out);
+
+    const SlangInt bindingRangeCount = typeLayout->getBindingRangeCount();
+    out << "b" << bindingRangeCount;
+    for (SlangInt r = 0; r < bindingRangeCount; ++r)
+    {
+        auto leafTypeLayout = typeLayout->getBindingRangeLeafTypeLayout(r);
+        out << "," << int(typeLayout->getBindingRangeType(r)) << ":"
+            << typeLayout->getBindingRangeBindingCount(r) << ":"
+            << int(typeLayout->isBindingRangeSpecializable(r)) << ":"
+            << typeLayout->getBindingRangeDescriptorSetIndex(r) << ":"
+            << typeLayout->getBindingRangeFirstDescriptorRangeIndex(r) << ":"
+            << typeLayout->getBindingRangeDescriptorRangeCount(r) << ":"
+            << (uint64_t)typeLayout->getBindingRangeLeafVariable(r) << ":"
+            << (uint64_t)(leafTypeLayout ? leafTypeLayout->getType() : nullptr);
+    }
+    out << ";";
+
+    const SlangInt descriptorSetCount = typeLayout->getDescriptorSetCount();
+    out << "d" << descriptorSetCount;
+    for (SlangInt s = 0; s < descriptorSetCount; ++s)
+    {
+        const SlangInt rangeCount = typeLayout->getDescriptorSetDescriptorRangeCount(s);
+        out << "," << typeLayout->getDescriptorSetSpaceOffset(s) << ":" << rangeCount;
+        for (SlangInt r = 0; r < rangeCount; ++r)
+        {
+            out << ":" << typeLayout->getDescriptorSetDescriptorRangeIndexOffset(s, r) << "/"
+                << typeLayout->getDescriptorSetDescriptorRangeDescriptorCount(s, r) << "/"
+                << int(typeLayout->getDescriptorSetDescriptorRangeType(s, r)) << "/"
+                << int(typeLayout->getDescriptorSetDescriptorRangeCategory(s, r));
+        }
+    }
+    out << ";";
+
+    // Sub-objects are laid out by what their containers hold, including the concrete
+    // types that interface-typed ranges were specialized to.
+    const SlangInt subObjectRangeCount = typeLayout->getSubObjectRangeCount();
+    out << "s" << subObjectRangeCount << ";";
+    for (SlangInt r = 0; r < subObjectRangeCount; ++r)
+    {
+        const SlangInt bindingRangeIndex = typeLayout->getSubObjectRangeBindingRangeIndex(r);
+        out << bindingRangeIndex << ";";
+        _appendVarLayoutKey(typeLayout->getSubObjectRangeOffset(r), out);
+
+        auto leafTypeLayout = typeLayout->getBindingRangeLeafTypeLayout(bindingRangeIndex);
+        if (!leafTypeLayout)
+            continue;
+        if (auto pendingTypeLayout = leafTypeLayout->getPendingDataTypeLayout())
+        {
+            out << "p";
+            _appendTypeLayoutKey(pendingTypeLayout, out);
+        }
+        if (auto elementVarLayout = leafTypeLayout->getElementVarLayout())
+        {
+            out << "c";
+            _appendVarLayoutKey(leafTypeLayout->getContainerVarLayout(), out);
+            _appendVarLayoutKey(elementVarLayout, out);
+            _appendTypeLayoutKey(elementVarLayout->getTypeLayout(), out);
+        }
+    }
+}
+
+String RendererBase::calcShaderObjectLayoutKey(
+    slang::ISession* session,
+    slang::TypeLayoutReflection* typeLayout)
+{
+    StringBuilder key;
+    key << (uint64_t)session << ";";
+    _appendTypeLayoutKey(typeLayout, key);
+    return key.produceString();
+}
+
+ShaderObjectLayoutBase* RendererBase::findShaderObjectLayoutByKey(
+    slang::ISession* session,
+    slang::TypeLayoutReflection* typeLayout,
+    String& outKey)
+{
+    outKey = calcShaderObjectLayoutKey(session, typeLayout);
+    if (auto entry = m_shaderObjectLayoutsByKey.tryGetValue(outKey))
+        return entry->layout;
+    return nullptr;
+}
+
+void RendererBase::addShaderObjectLayoutForKey(
+    const String& key,
+    slang::ISession* session,
+    ShaderObjectLayoutBase* layout,
+    ISlangUnknown* typeLayoutOwner)
+{
+    KeyedShaderObjectLayout entry;
+    entry.layout = layout;
+    entry.typeLayoutOwner = typeLayoutOwner;
+    entry.session = session;
+    m_shaderObjectLayoutsByKey[key] = entry;
+}
+
 Result RendererBase::clearShaderCache()
 {
     SLANG_ASSERT(persistentShaderCache);
+
+    // Also remove the modules the session cached, which are kept in a directory of their own.
+    struct Visitor : Path::Visitor
+    {
+        const String& directory;
+
+        Visitor(const String& directory)
+            : directory(directory)
+        {
+        }
+
+        void accept(Path::Type type, const UnownedStringSlice& fileName) SLANG_OVERRIDE
+        {
+            if (type == Path::Type::File)
+            {
+                Path::remove(Path::combine(directory, fileName));
+            }
+        }
+    };
+    Visitor visitor(moduleCachePath);
+    Path::find(moduleCachePath, nullptr, &visitor);
+
+    persistentPipelineCache->clear();
     return persistentShaderCache->clear();
 }
 
@@ -889,6 +1055,7 @@ ShaderComponentID ShaderCache::getComponentId(UnownedStringSlice name)
 
 ShaderComponentID ShaderCache::getComponentId(ComponentKey key)
 {
+    std::lock_guard<std::mutex> lock(m_mutex);
     ShaderComponentID componentId = 0;
     if (componentIds.tryGetValue(key, componentId))
         return componentId;
@@ -905,6 +1072,7 @@ void ShaderCache::addSpecializedPipeline(
     PipelineKey key,
     Slang::RefPtr<PipelineStateBase> specializedPipeline)
 {
+    std::lock_guard<std::mutex> lock(m_mutex);
     specializedPipelines[key] = specializedPipeline;
 }
 
@@ -1201,7 +1369,7 @@ Result RendererBase::maybeSpecializePipeline(
     // shader objects.
     if (currentPipeline->isSpecializable)
     {
-        specializationArgs.clear();
+        ExtendedShaderObjectTypeList specializationArgs;
         SLANG_RETURN_ON_FAIL(rootObject->collectSpecializationArgs(specializationArgs));
 
         // Construct a shader cache key that represents the specialized shader kernels.
@@ -1212,6 +1380,18 @@ Result RendererBase::maybeSpecializePipeline(
 
         RefPtr<PipelineStateBase> specializedPipelineState =
             shaderCache.getSpecializedPipelineState(pipelineKey);
+
+        // Only one thread specializes at a time, and another thread may have created
+        // this pipeline while we waited for it.
+        std::unique_lock<std::recursive_mutex> specializationLock(
+            m_specializationMutex,
+            std::defer_lock);
+        if (!specializedPipelineState)
+        {
+            specializationLock.lock();
+            specializedPipelineState = shaderCache.getSpecializedPipelineState(pipelineKey);
+        }
+
         // Try to find specialized pipeline from shader cache.
         if (!specializedPipelineState)
         {
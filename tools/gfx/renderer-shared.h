@@ -7,6 +7,9 @@
 #include "slang-context.h"
 #include "slang-gfx.h"
 
+#include <atomic>
+#include <mutex>
+
 namespace gfx
 {
 
@@ -1111,6 +1114,8 @@ struct OwningComponentKey
 };
 
 // A cache from specialization keys to a specialized `ShaderKernel`.
+/// Caches the IDs of specialization components and the pipelines specialized from them. Safe to
+/// use from several threads recording command buffers at once.
 class ShaderCache : public Slang::RefObject
 {
 public:
@@ -1120,6 +1125,7 @@ public:
 
     Slang::RefPtr<PipelineStateBase> getSpecializedPipelineState(PipelineKey programKey)
     {
+        std::lock_guard<std::mutex> lock(m_mutex);
         Slang::RefPtr<PipelineStateBase> result;
         if (specializedPipelines.tryGetValue(programKey, result))
             return result;
@@ -1130,11 +1136,13 @@ public:
         Slang::RefPtr<PipelineStateBase> specializedPipeline);
     void free()
     {
+        std::lock_guard<std::mutex> lock(m_mutex);
         specializedPipelines = decltype(specializedPipelines)();
         componentIds = decltype(componentIds)();
     }
 
 protected:
+    std::mutex m_mutex;
     Slang::OrderedDictionary<OwningComponentKey, ShaderComponentID> componentIds;
     Slang::OrderedDictionary<PipelineKey, Slang::RefPtr<PipelineStateBase>> specializedPipelines;
 };
@@ -1144,9 +1152,9 @@ class TransientResourceHeapBase : public ITransientResourceHeap, public Slang::C
 public:
     uint64_t m_version = 0;
     uint64_t getVersion() { return m_version; }
-    uint64_t& getVersionCounter()
+    std::atomic<uint64_t>& getVersionCounter()
     {
-        static uint64_t version = 1;
+        static std::atomic<uint64_t> version{1};
         return version;
     }
     TransientResourceHeapBase() { m_version = getVersionCounter()++; }
@@ -1356,8 +1364,41 @@ public:
         slang::TypeLayoutReflection* typeLayout,
         ShaderObjectLayoutBase** outLayout);
 
+    /// Find a layout that was built for a type layout with the same key as `typeLayout` (see
+    /// `calcShaderObjectLayoutKey`). If there is none, `outKey` is set to the key, for adding
+    /// the layout once it is built with `addShaderObjectLayoutForKey`.
+    ///
+    /// The same type has a different type layout in every program that uses it, so unlike
+    /// `m_shaderObjectLayoutCache` this finds the layouts built for other programs.
+    /// Must be called with `m_specializationMutex` held.
+    ShaderObjectLayoutBase* findShaderObjectLayoutByKey(
+        slang::ISession* session,
+        slang::TypeLayoutReflection* typeLayout,
+        Slang::String& outKey);
+
+    /// Add `layout` built for a type layout with the given key. `typeLayoutOwner` is the
+    /// object, such as a program, that keeps the type layouts `layout` refers to alive, or
+    /// nullptr if they belong to the session.
+    void addShaderObjectLayoutForKey(
+        const Slang::String& key,
+        slang::ISession* session,
+        ShaderObjectLayoutBase* layout,
+        ISlangUnknown* typeLayoutOwner);
+
+    /// Get a key for the layout of shader objects of `typeLayout`, which is the same for type
+    /// layouts that such a layout is built the same from.
+    ///
+    /// The key is made from the reflection of the type layout that shader object layouts are
+    /// built from: the binding ranges, descriptor sets and sub-object ranges, with the keys of
+    /// the layouts of the sub-objects.
+    static Slang::String calcShaderObjectLayoutKey(
+        slang::ISession* session,
+        slang::TypeLayoutReflection* typeLayout);
+
 public:
-    ExtendedShaderObjectTypeList specializationArgs;
+    /// Serializes specializing pipelines and creating shader object layouts, both of which use
+    /// the Slang session. Recursive because specializing a pipeline creates layouts.
+    std::recursive_mutex m_specializationMutex;
     // Given current pipeline and root shader object binding, generate and bind a specialized
     // pipeline if necessary. The newly specialized pipeline is held alive by the pipeline cache so
     // users of `outNewPipeline` do not need to maintain its lifespan.
@@ -1398,9 +1439,27 @@ public:
     ShaderCache shaderCache;
 
     Slang::RefPtr<Slang::PersistentCache> persistentShaderCache;
+    // Where the session caches the modules it checked, when there is a shader cache.
+    Slang::String moduleCachePath;
+    // Holds the data of the API's pipeline caches, when there is a shader cache.
+    // It is kept apart from the shader code, so it doesn't count towards its entries.
+    Slang::RefPtr<Slang::PersistentCache> persistentPipelineCache;
 
     Slang::Dictionary<slang::TypeLayoutReflection*, Slang::RefPtr<ShaderObjectLayoutBase>>
         m_shaderObjectLayoutCache;
+
+    /// A layout in `m_shaderObjectLayoutsByKey`, with what keeps the type layouts it was
+    /// built from alive.
+    struct KeyedShaderObjectLayout
+    {
+        Slang::RefPtr<ShaderObjectLayoutBase> layout;
+        Slang::ComPtr<ISlangUnknown> typeLayoutOwner;
+        /// The key holds the address of the session.
+        Slang::ComPtr<slang::ISession> session;
+    };
+    /// Layouts of sub-objects, shared by all the programs of the device that use an identical
+    /// type layout for them (see `findShaderObjectLayoutByKey`).
+    Slang::Dictionary<Slang::String, KeyedShaderObjectLayout> m_shaderObjectLayoutsByKey;
     Slang::ComPtr<IPipelineCreationAPIDispatcher> m_pipelineCreationAPIDispatcher;
 };
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "core/slang-basic.h"
+#include "core/slang-io.h"
 #include "slang-gfx.h"
 
 namespace gfx
@@ -10,13 +11,21 @@ class SlangContext
 public:
     Slang::ComPtr<slang::IGlobalSession> globalSession;
     Slang::ComPtr<slang::ISession> session;
+
+    /// The directory that the session caches checked modules in, for a shader cache directory.
+    static Slang::String getModuleCachePath(const char* shaderCachePath)
+    {
+        return Slang::Path::combine(shaderCachePath, "modules");
+    }
+
     Result initialize(
         const gfx::IDevice::SlangDesc& desc,
         uint32_t extendedDescCount,
         void** extendedDescs,
         SlangCompileTarget compileTarget,
         const char* defaultProfileName,
-        Slang::ConstArrayView<slang::PreprocessorMacroDesc> additionalMacros)
+        Slang::ConstArrayView<slang::PreprocessorMacroDesc> additionalMacros,
+        const char* shaderCachePath)
     {
         if (desc.slangGlobalSession)
         {
@@ -51,17 +60,39 @@ public:
         slangSessionDesc.targets = &targetDesc;
         slangSessionDesc.targetCount = 1;
 
+        Slang::List<slang::CompilerOptionEntry> compilerOptions;
         for (uint32_t i = 0; i < extendedDescCount; i++)
         {
             if ((*(StructType*)extendedDescs[i]) == StructType::SlangSessionExtendedDesc)
             {
                 auto extDesc = (SlangSessionExtendedDesc*)extendedDescs[i];
-                slangSessionDesc.compilerOptionEntryCount = extDesc->compilerOptionEntryCount;
-                slangSessionDesc.compilerOptionEntries = extDesc->compilerOptionEntries;
+                compilerOptions.addRange(
+                    extDesc->compilerOptionEntries,
+                    extDesc->compilerOptionEntryCount);
                 break;
             }
         }
 
+        // With a shader cache, the checked modules are cached next to the code, so that
+        // loading them again skips parsing and checking as long as their sources and the
+        // options are unchanged. The cached code is keyed on the same digests, so a warm
+        // start doesn't need the front-end for either.
+        Slang::String moduleCachePath;
+        if (shaderCachePath &&
+            compilerOptions.findFirstIndex(
+                [](const slang::CompilerOptionEntry& entry)
+                { return entry.name == slang::CompilerOptionName::ModuleCachePath; }) == -1)
+        {
+            moduleCachePath = getModuleCachePath(shaderCachePath);
+            slang::CompilerOptionEntry entry;
+            entry.name = slang::CompilerOptionName::ModuleCachePath;
+            entry.value.kind = slang::CompilerOptionValueKind::String;
+            entry.value.stringValue0 = moduleCachePath.getBuffer();
+            compilerOptions.add(entry);
+        }
+        slangSessionDesc.compilerOptionEntryCount = (uint32_t)compilerOptions.getCount();
+        slangSessionDesc.compilerOptionEntries = compilerOptions.getBuffer();
+
         SLANG_RETURN_ON_FAIL(globalSession->createSession(slangSessionDesc, session.writeRef()));
         return SLANG_OK;
     }
@@ -11,18 +11,25 @@ public:
     {
         Slang::RefPtr<TBufferResource> resource;
         size_t size;
+        /// The mapped memory of `resource`, if the pool keeps its pages mapped.
+        void* mappedData = nullptr;
     };
 
     struct Allocation
     {
         TBufferResource* resource;
         size_t offset;
+        /// The mapped memory of `resource` (not offset), or null if it isn't kept mapped. Data
+        /// can be written here directly instead of being uploaded through a command.
+        void* mappedData = nullptr;
     };
 
     TDevice* m_device;
     MemoryType m_memoryType;
     uint32_t m_alignment;
     ResourceStateSet m_allowedStates;
+    /// Map every page once when it is created, and leave it mapped for the life of the pool.
+    bool m_persistentlyMapped = false;
 
     Slang::List<StagingBufferPage> m_pages;
     Slang::List<Slang::RefPtr<TBufferResource>> m_largeAllocations;
@@ -36,12 +43,14 @@ public:
         TDevice* device,
         MemoryType memoryType,
         uint32_t alignment,
-        ResourceStateSet allowedStates)
+        ResourceStateSet allowedStates,
+        bool persistentlyMapped = false)
     {
         m_device = device;
         m_memoryType = memoryType;
         m_alignment = alignment;
         m_allowedStates = allowedStates;
+        m_persistentlyMapped = persistentlyMapped;
     }
 
     static size_t alignUp(size_t value, uint32_t alignment)
@@ -73,6 +82,8 @@ public:
 
         page.resource = static_cast<TBufferResource*>(bufferPtr.get());
         page.size = pageSize;
+        if (m_persistentlyMapped)
+            SLANG_RETURN_ON_FAIL(bufferPtr->map(nullptr, &page.mappedData));
         m_pages.add(page);
         return SLANG_OK;
     }
@@ -127,6 +138,7 @@ public:
         Allocation result;
         result.resource = m_pages[bufferId].resource.Ptr();
         result.offset = bufferAllocOffset;
+        result.mappedData = m_pages[bufferId].mappedData;
         m_pageAllocCounter = bufferId;
         m_offsetAllocCounter = bufferAllocOffset + size;
         return result;
@@ -145,7 +157,13 @@ public:
     StagingBufferPool<TDevice, TBufferResource> m_uploadBufferPool;
     StagingBufferPool<TDevice, TBufferResource> m_readbackBufferPool;
 
-    Result init(const ITransientResourceHeap::Desc& desc, uint32_t alignment, TDevice* device)
+    /// If `mapConstantBuffers` is set, the pages of constant buffers stay mapped, so shader
+    /// objects can write their ordinary data directly into them.
+    Result init(
+        const ITransientResourceHeap::Desc& desc,
+        uint32_t alignment,
+        TDevice* device,
+        bool mapConstantBuffers = false)
     {
         m_device = device;
 
@@ -156,7 +174,8 @@ public:
             ResourceStateSet(
                 ResourceState::ConstantBuffer,
                 ResourceState::CopySource,
-                ResourceState::CopyDestination));
+                ResourceState::CopyDestination),
+            mapConstantBuffers);
 
         m_uploadBufferPool.init(
             device,
@@ -170,8 +189,7 @@ public:
             256,
             ResourceStateSet(ResourceState::CopySource, ResourceState::CopyDestination));
 
-        m_version = getVersionCounter();
-        getVersionCounter()++;
+        m_version = getVersionCounter()++;
         return SLANG_OK;
     }
 
@@ -205,11 +223,14 @@ public:
     Result allocateConstantBuffer(
         size_t size,
         IBufferResource*& outBufferWeakPtr,
-        size_t& outOffset)
+        size_t& outOffset,
+        void** outMappedData = nullptr)
     {
         auto allocation = m_constantBufferPool.allocate(size, false);
         outBufferWeakPtr = allocation.resource;
         outOffset = allocation.offset;
+        if (outMappedData)
+            *outMappedData = allocation.mappedData;
         return SLANG_OK;
     }
 
@@ -218,8 +239,7 @@ public:
         m_constantBufferPool.reset();
         m_uploadBufferPool.reset();
         m_readbackBufferPool.reset();
-        m_version = getVersionCounter();
-        getVersionCounter()++;
+        m_version = getVersionCounter()++;
     }
 };
 
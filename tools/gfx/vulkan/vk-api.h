@@ -58,6 +58,9 @@ namespace gfx
     x(vkDestroyPipelineLayout) \
     x(vkCreateComputePipelines) \
     x(vkCreateGraphicsPipelines) \
+    x(vkCreatePipelineCache) \
+    x(vkDestroyPipelineCache) \
+    x(vkGetPipelineCacheData) \
     x(vkDestroyPipeline) \
     x(vkCreateShaderModule) \
     x(vkDestroyShaderModule) \
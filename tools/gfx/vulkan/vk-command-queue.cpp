@@ -63,6 +63,7 @@ Result CommandQueueImpl::waitForFenceValuesOnDevice(
     IFence** fences,
     uint64_t* waitValues)
 {
+    std::lock_guard<std::mutex> lock(m_mutex);
     for (GfxIndex i = 0; i < fenceCount; ++i)
     {
         FenceWaitInfo waitInfo;
@@ -148,6 +149,27 @@ void CommandQueueImpl::queueSubmitImpl(
         commandBufferImpl->m_transientHeap->advanceFence();
     }
     vkAPI.vkQueueSubmit(m_queue, 1, &submitInfo, vkFence);
+
+    // A submission signals only one fence, so the fences of any other transient heaps in
+    // the batch are signaled by empty submissions, which complete once all of the work
+    // submitted before them has.
+    for (uint32_t i = 1; i < count; i++)
+    {
+        auto transientHeap = static_cast<CommandBufferImpl*>(commandBuffers[i])->m_transientHeap;
+        bool isFenced = false;
+        for (uint32_t j = 0; j < i && !isFenced; j++)
+        {
+            isFenced = static_cast<CommandBufferImpl*>(commandBuffers[j])->m_transientHeap.get() ==
+                       transientHeap.get();
+        }
+        if (isFenced)
+            continue;
+        VkFence heapFence = transientHeap->getCurrentFence();
+        vkAPI.vkResetFences(vkAPI.m_device, 1, &heapFence);
+        transientHeap->advanceFence();
+        vkAPI.vkQueueSubmit(m_queue, 0, nullptr, heapFence);
+    }
+
     m_pendingWaitSemaphores[0] = m_semaphore;
     m_pendingWaitSemaphores[1] = VK_NULL_HANDLE;
 }
@@ -160,6 +182,7 @@ void CommandQueueImpl::executeCommandBuffers(
 {
     if (count == 0 && fence == nullptr)
         return;
+    std::lock_guard<std::mutex> lock(m_mutex);
     queueSubmitImpl(count, commandBuffers, fence, valueToSignal);
 }
 
@@ -32,6 +32,8 @@ public:
     VkSemaphore m_pendingWaitSemaphores[2] = {VK_NULL_HANDLE, VK_NULL_HANDLE};
     List<VkCommandBuffer> m_submitCommandBuffers;
     VkSemaphore m_semaphore;
+    /// Guards submission, which may come from several threads.
+    std::mutex m_mutex;
     ~CommandQueueImpl();
 
     void init(DeviceImpl* renderer, VkQueue queue, uint32_t queueFamilyIndex);
@@ -2,9 +2,76 @@
 
 #include "vk-util.h"
 
+#include <atomic>
+
 namespace gfx
 {
-VkDescriptorPool DescriptorSetAllocator::newPool()
+namespace
+{
+std::atomic<uint64_t> g_nextAllocatorId{1};
+std::atomic<uint32_t> g_nextThreadIndex{0};
+
+uint32_t _getThreadIndex()
+{
+    thread_local uint32_t threadIndex = g_nextThreadIndex++;
+    return threadIndex;
+}
+
+/// The arena the current thread last used, and the allocator it belongs to.
+struct CachedArena
+{
+    uint64_t allocatorId = 0;
+    void* arena = nullptr;
+};
+thread_local CachedArena t_cachedArena;
+} // namespace
+
+DescriptorSetAllocator::DescriptorSetAllocator()
+    : m_id(g_nextAllocatorId++)
+{
+}
+
+DescriptorSetAllocator::Arena* DescriptorSetAllocator::getArena()
+{
+    if (t_cachedArena.allocatorId == m_id)
+        return (Arena*)t_cachedArena.arena;
+
+    Arena* arena = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto& arenaRef = m_arenas.getOrAddValue(_getThreadIndex(), nullptr);
+        if (!arenaRef)
+            arenaRef = new Arena();
+        arena = arenaRef;
+    }
+    t_cachedArena.allocatorId = m_id;
+    t_cachedArena.arena = arena;
+    return arena;
+}
+
+void DescriptorSetAllocator::reset()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (const auto& [_, arena] : m_arenas)
+    {
+        for (auto pool : arena->pools)
+            m_api->vkResetDescriptorPool(m_api->m_device, pool, 0);
+    }
+}
+
+void DescriptorSetAllocator::close()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (const auto& [_, arena] : m_arenas)
+    {
+        for (auto pool : arena->pools)
+            m_api->vkDestroyDescriptorPool(m_api->m_device, pool, nullptr);
+    }
+    m_arenas.clear();
+    m_id = g_nextAllocatorId++;
+}
+
+VkDescriptorPool DescriptorSetAllocator::newPool(Arena* arena)
 {
     VkDescriptorPoolCreateInfo descriptorPoolInfo = {VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO};
     Slang::Array<VkDescriptorPoolSize, 32> poolSizes;
@@ -43,16 +110,19 @@ VkDescriptorPool DescriptorSetAllocator::newPool()
         &descriptorPoolInfo,
         nullptr,
         &descriptorPool));
-    pools.add(descriptorPool);
+    arena->pools.add(descriptorPool);
     return descriptorPool;
 }
 
 VulkanDescriptorSet DescriptorSetAllocator::allocate(VkDescriptorSetLayout layout)
 {
+    Arena* arena = getArena();
+    auto& pools = arena->pools;
+
     VulkanDescriptorSet rs = {};
     VkDescriptorSetAllocateInfo allocInfo = {};
     allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-    allocInfo.descriptorPool = getPool();
+    allocInfo.descriptorPool = pools.getCount() ? pools.getLast() : newPool(arena);
     allocInfo.descriptorSetCount = 1;
     allocInfo.pSetLayouts = &layout;
     if (m_api->vkAllocateDescriptorSets(m_api->m_device, &allocInfo, &rs.handle) == VK_SUCCESS)
@@ -71,7 +141,7 @@ VulkanDescriptorSet DescriptorSetAllocator::allocate(VkDescriptorSetLayout layou
         }
     }
     // If we still cannot allocate the descriptor set, add a new pool.
-    auto pool = newPool();
+    auto pool = newPool(arena);
     allocInfo.descriptorPool = pool;
     if (m_api->vkAllocateDescriptorSets(m_api->m_device, &allocInfo, &rs.handle) == VK_SUCCESS)
     {
@@ -2,9 +2,13 @@
 
 #pragma once
 
+#include "core/slang-dictionary.h"
 #include "core/slang-list.h"
+#include "core/slang-smart-pointer.h"
 #include "vk-api.h"
 
+#include <mutex>
+
 namespace gfx
 {
 struct VulkanDescriptorSet
@@ -12,32 +16,44 @@ struct VulkanDescriptorSet
     VkDescriptorSet handle;
     VkDescriptorPool pool;
 };
+
+/// Allocates descriptor sets from growing lists of descriptor pools.
+///
+/// Descriptor pools must be externally synchronized, so every thread that allocates gets an
+/// arena with pools of its own. Once a thread has found its arena, allocating takes no lock,
+/// which lets several threads encode command buffers from the same transient heap at once.
+/// `reset` and `close` must not be called while another thread is allocating.
 class DescriptorSetAllocator
 {
 public:
-    Slang::List<VkDescriptorPool> pools;
-    const VulkanApi* m_api;
-    VkDescriptorPool newPool();
-    VkDescriptorPool getPool()
-    {
-        if (pools.getCount())
-            return pools.getLast();
-        return newPool();
-    }
+    const VulkanApi* m_api = nullptr;
+
+    DescriptorSetAllocator();
+
     VulkanDescriptorSet allocate(VkDescriptorSetLayout layout);
+
+    /// Frees a set. Must be called on the thread that allocated it.
     void free(VulkanDescriptorSet set)
     {
         m_api->vkFreeDescriptorSets(m_api->m_device, set.pool, 1, &set.handle);
     }
-    void reset()
-    {
-        for (auto pool : pools)
-            m_api->vkResetDescriptorPool(m_api->m_device, pool, 0);
-    }
-    void close()
+    void reset();
+    void close();
+
+private:
+    struct Arena : public Slang::RefObject
     {
-        for (auto pool : pools)
-            m_api->vkDestroyDescriptorPool(m_api->m_device, pool, nullptr);
-    }
+        Slang::List<VkDescriptorPool> pools;
+    };
+
+    Arena* getArena();
+    VkDescriptorPool newPool(Arena* arena);
+
+    /// Identifies this allocator in the per-thread arena caches. Never reused, and changed by
+    /// `close`, so a cache can't refer to an arena that has been destroyed.
+    uint64_t m_id;
+
+    std::mutex m_mutex;
+    Slang::Dictionary<uint32_t, Slang::RefPtr<Arena>> m_arenas; ///< Keyed by thread index
 };
 } // namespace gfx
@@ -54,9 +54,17 @@ DeviceImpl::~DeviceImpl()
     }
 
     m_shaderObjectLayoutCache = decltype(m_shaderObjectLayoutCache)();
+    m_shaderObjectLayoutsByKey = decltype(m_shaderObjectLayoutsByKey)();
     shaderCache.free();
     m_deviceObjectsWithPotentialBackReferences.clearAndDeallocate();
 
+    if (m_pipelineCache != VK_NULL_HANDLE)
+    {
+        savePipelineCache();
+        m_api.vkDestroyPipelineCache(m_device, m_pipelineCache, nullptr);
+        m_pipelineCache = VK_NULL_HANDLE;
+    }
+
     if (m_api.vkDestroySampler)
     {
         m_api.vkDestroySampler(m_device, m_defaultSampler, nullptr);
@@ -81,6 +89,74 @@ DeviceImpl::~DeviceImpl()
     }
 }
 
+// The saved data of a pipeline cache is only usable on the same device and driver.
+static PersistentCache::Key _getPipelineCacheKey(const VkPhysicalDeviceProperties& properties)
+{
+    DigestBuilder<SHA1> builder;
+    builder.append(toSlice("VkPipelineCache"));
+    builder.append(properties.vendorID);
+    builder.append(properties.deviceID);
+    builder.append(properties.driverVersion);
+    builder.append(properties.pipelineCacheUUID, sizeof(properties.pipelineCacheUUID));
+    return builder.finalize();
+}
+
+Result DeviceImpl::initPipelineCache()
+{
+    ComPtr<ISlangBlob> initialData;
+    if (persistentPipelineCache)
+    {
+        persistentPipelineCache->readEntry(
+            _getPipelineCacheKey(m_api.m_deviceProperties),
+            initialData.writeRef());
+    }
+
+    VkPipelineCacheCreateInfo createInfo = {VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO};
+    if (initialData)
+    {
+        createInfo.initialDataSize = initialData->getBufferSize();
+        createInfo.pInitialData = initialData->getBufferPointer();
+        if (m_api.vkCreatePipelineCache(m_device, &createInfo, nullptr, &m_pipelineCache) ==
+            VK_SUCCESS)
+        {
+            return SLANG_OK;
+        }
+        // Drivers ignore data they don't recognize, but start over if one rejects it anyway.
+        createInfo.initialDataSize = 0;
+        createInfo.pInitialData = nullptr;
+    }
+    SLANG_VK_RETURN_ON_FAIL(
+        m_api.vkCreatePipelineCache(m_device, &createInfo, nullptr, &m_pipelineCache));
+    return SLANG_OK;
+}
+
+void DeviceImpl::savePipelineCache()
+{
+    if (!persistentPipelineCache)
+    {
+        return;
+    }
+
+    size_t size = 0;
+    if (m_api.vkGetPipelineCacheData(m_device, m_pipelineCache, &size, nullptr) != VK_SUCCESS ||
+        size == 0)
+    {
+        return;
+    }
+    List<uint8_t> data;
+    data.setCount(Index(size));
+    if (m_api.vkGetPipelineCacheData(m_device, m_pipelineCache, &size, data.getBuffer()) !=
+        VK_SUCCESS)
+    {
+        return;
+    }
+    data.setCount(Index(size));
+
+    persistentPipelineCache->writeEntry(
+        _getPipelineCacheKey(m_api.m_deviceProperties),
+        ListBlob::moveCreate(data));
+}
+
 // TODO: Is "location" still needed for this function?
 VkBool32 DeviceImpl::handleDebugMessage(
     VkDebugReportFlagsEXT flags,
@@ -1028,13 +1104,16 @@ SlangResult DeviceImpl::initialize(const Desc& desc)
         SLANG_RETURN_ON_FAIL(m_deviceQueue.init(m_api, queue, m_queueFamilyIndex));
     }
 
+    SLANG_RETURN_ON_FAIL(initPipelineCache());
+
     SLANG_RETURN_ON_FAIL(slangContext.initialize(
         desc.slang,
         desc.extendedDescCount,
         desc.extendedDescs,
         SLANG_SPIRV,
         "sm_5_1",
-        makeArray(slang::PreprocessorMacroDesc{"__VK__", "1"}).getView()));
+        makeArray(slang::PreprocessorMacroDesc{"__VK__", "1"}).getView(),
+        desc.shaderCache.shaderCachePath));
 
     // Create default sampler.
     {
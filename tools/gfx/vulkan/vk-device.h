@@ -140,6 +140,12 @@ public:
 
     void waitForGpu();
 
+    /// Create the pipeline cache, starting from the data saved by an earlier device if the
+    /// shader cache has it.
+    Result initPipelineCache();
+    /// Save the data of the pipeline cache for later devices.
+    void savePipelineCache();
+
     virtual SLANG_NO_THROW const DeviceInfo& SLANG_MCALL getDeviceInfo() const override;
 
     virtual SLANG_NO_THROW Result SLANG_MCALL
@@ -220,6 +226,9 @@ public:
 
     VkSampler m_defaultSampler;
 
+    // Used for creating all pipelines, so that drivers can reuse their compiled code.
+    VkPipelineCache m_pipelineCache = VK_NULL_HANDLE;
+
     RefPtr<FramebufferImpl> m_emptyFramebuffer;
 };
 
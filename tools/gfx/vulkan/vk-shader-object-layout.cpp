@@ -457,22 +457,14 @@ void ShaderObjectLayoutImpl::Builder::addBindingRanges(slang::TypeLayoutReflecti
             {
                 auto varLayout = slangLeafTypeLayout->getElementVarLayout();
                 auto subTypeLayout = varLayout->getTypeLayout();
-                ShaderObjectLayoutImpl::createForElementType(
-                    m_renderer,
-                    m_session,
-                    subTypeLayout,
-                    subObjectLayout.writeRef());
+                _getSubObjectLayout(subTypeLayout, subObjectLayout);
             }
             break;
 
         case slang::BindingType::ExistentialValue:
             if (auto pendingTypeLayout = slangLeafTypeLayout->getPendingDataTypeLayout())
             {
-                ShaderObjectLayoutImpl::createForElementType(
-                    m_renderer,
-                    m_session,
-                    pendingTypeLayout,
-                    subObjectLayout.writeRef());
+                _getSubObjectLayout(pendingTypeLayout, subObjectLayout);
             }
             break;
         }
@@ -564,13 +556,38 @@ SlangResult ShaderObjectLayoutImpl::Builder::build(ShaderObjectLayoutImpl** outL
     return SLANG_OK;
 }
 
+Result ShaderObjectLayoutImpl::Builder::_getSubObjectLayout(
+    slang::TypeLayoutReflection* elementType,
+    RefPtr<ShaderObjectLayoutImpl>& outLayout)
+{
+    // Building a layout walks the reflection of the type, and creates its descriptor set
+    // layouts, which needs doing only once for all the programs that use the type.
+    std::lock_guard<std::recursive_mutex> lock(m_renderer->m_specializationMutex);
+    String key;
+    if (auto layout = m_renderer->findShaderObjectLayoutByKey(m_session, elementType, key))
+    {
+        outLayout = static_cast<ShaderObjectLayoutImpl*>(layout);
+        return SLANG_OK;
+    }
+    SLANG_RETURN_ON_FAIL(createForElementType(
+        m_renderer,
+        m_session,
+        elementType,
+        outLayout.writeRef(),
+        m_typeLayoutOwner));
+    m_renderer->addShaderObjectLayoutForKey(key, m_session, outLayout, m_typeLayoutOwner);
+    return SLANG_OK;
+}
+
 Result ShaderObjectLayoutImpl::createForElementType(
     DeviceImpl* renderer,
     slang::ISession* session,
     slang::TypeLayoutReflection* elementType,
-    ShaderObjectLayoutImpl** outLayout)
+    ShaderObjectLayoutImpl** outLayout,
+    slang::IComponentType* typeLayoutOwner)
 {
     Builder builder(renderer, session);
+    builder.m_typeLayoutOwner = typeLayoutOwner;
     builder.setElementTypeLayout(elementType);
 
     // When constructing a shader object layout directly from a reflected
@@ -748,6 +765,7 @@ Result RootShaderObjectLayout::create(
         auto slangEntryPoint = programLayout->getEntryPointByIndex(e);
 
         EntryPointLayout::Builder entryPointBuilder(renderer, program->getSession());
+        entryPointBuilder.m_typeLayoutOwner = program;
         entryPointBuilder.addEntryPointParams(slangEntryPoint);
 
         RefPtr<EntryPointLayout> entryPointLayout;
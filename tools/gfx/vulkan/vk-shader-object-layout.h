@@ -143,6 +143,10 @@ public:
         slang::ISession* m_session;
         slang::TypeLayoutReflection* m_elementTypeLayout;
 
+        /// The program that the type layouts belong to, or nullptr if they belong to the
+        /// session. Sub-object layouts shared through the device keep it alive.
+        slang::IComponentType* m_typeLayoutOwner = nullptr;
+
         /// The container type of this shader object. When `m_containerType` is
         /// `StructuredBuffer` or `UnsizedArray`, this shader object represents a collection
         /// instead of a single object.
@@ -210,6 +214,12 @@ public:
         /// `typeLayout`
         void addBindingRanges(slang::TypeLayoutReflection* typeLayout);
 
+        /// Get the layout of sub-objects of `elementType`, using the one the device built
+        /// for the same type layout in another program if there is one.
+        Result _getSubObjectLayout(
+            slang::TypeLayoutReflection* elementType,
+            RefPtr<ShaderObjectLayoutImpl>& outLayout);
+
         Result setElementTypeLayout(slang::TypeLayoutReflection* typeLayout);
 
         SlangResult build(ShaderObjectLayoutImpl** outLayout);
@@ -219,7 +229,8 @@ public:
         DeviceImpl* renderer,
         slang::ISession* session,
         slang::TypeLayoutReflection* elementType,
-        ShaderObjectLayoutImpl** outLayout);
+        ShaderObjectLayoutImpl** outLayout,
+        slang::IComponentType* typeLayoutOwner = nullptr);
 
     ~ShaderObjectLayoutImpl();
 
@@ -376,6 +387,7 @@ public:
             , m_program(program)
             , m_programLayout(programLayout)
         {
+            m_typeLayoutOwner = program;
         }
 
         Result build(RootShaderObjectLayout** outLayout);
@@ -5,6 +5,8 @@
 #include "vk-command-encoder.h"
 #include "vk-transient-heap.h"
 
+#include <atomic>
+
 namespace gfx
 {
 
@@ -13,6 +15,24 @@ using namespace Slang;
 namespace vk
 {
 
+static std::atomic<uint64_t> g_shaderObjectVersionCounter{1};
+
+void ShaderObjectImpl::_markChanged()
+{
+    m_version = g_shaderObjectVersionCounter++;
+}
+
+uint64_t ShaderObjectImpl::_getVersionRecursive()
+{
+    uint64_t version = m_version;
+    for (auto& subObject : m_objects)
+    {
+        if (subObject)
+            version = Math::Max(version, subObject->_getVersionRecursive());
+    }
+    return version;
+}
+
 Result ShaderObjectImpl::create(
     IDevice* device,
     ShaderObjectLayoutImpl* layout,
@@ -77,6 +97,7 @@ Result ShaderObjectImpl::setData(ShaderOffset const& inOffset, void const* data,
     memcpy(dest + offset, data, size);
 
     m_isConstantBufferDirty = true;
+    _markChanged();
 
     return SLANG_OK;
 }
@@ -106,6 +127,7 @@ Result ShaderObjectImpl::setResource(ShaderOffset const& offset, IResourceView*
                 static_cast<ResourceViewImpl*>(resourceView);
         }
     }
+    _markChanged();
     return SLANG_OK;
 }
 
@@ -120,6 +142,7 @@ Result ShaderObjectImpl::setSampler(ShaderOffset const& offset, ISamplerState* s
 
     m_samplers[bindingRange.baseIndex + offset.bindingArrayIndex] =
         static_cast<SamplerStateImpl*>(sampler);
+    _markChanged();
     return SLANG_OK;
 }
 
@@ -138,6 +161,14 @@ Result ShaderObjectImpl::setCombinedTextureSampler(
     auto& slot = m_combinedTextureSamplers[bindingRange.baseIndex + offset.bindingArrayIndex];
     slot.textureView = static_cast<TextureResourceViewImpl*>(textureView);
     slot.sampler = static_cast<SamplerStateImpl*>(sampler);
+    _markChanged();
+    return SLANG_OK;
+}
+
+Result ShaderObjectImpl::setObject(ShaderOffset const& offset, IShaderObject* object)
+{
+    SLANG_RETURN_ON_FAIL(Super::setObject(offset, object));
+    _markChanged();
     return SLANG_OK;
 }
 
@@ -221,6 +252,7 @@ Result ShaderObjectImpl::init(IDevice* device, ShaderObjectLayoutImpl* layout)
 Result ShaderObjectImpl::_writeOrdinaryData(
     PipelineCommandEncoder* encoder,
     IBufferResource* buffer,
+    void* mappedData,
     Offset offset,
     Size destSize,
     ShaderObjectLayoutImpl* specializedLayout)
@@ -231,7 +263,10 @@ Result ShaderObjectImpl::_writeOrdinaryData(
 
     SLANG_ASSERT(srcSize <= destSize);
 
-    encoder->uploadBufferDataImpl(buffer, offset, srcSize, src);
+    if (mappedData)
+        memcpy((char*)mappedData + offset, src, srcSize);
+    else
+        encoder->uploadBufferDataImpl(buffer, offset, srcSize, src);
 
     // In the case where this object has any sub-objects of
     // existential/interface type, we need to recurse on those objects
@@ -313,6 +348,7 @@ Result ShaderObjectImpl::_writeOrdinaryData(
             subObject->_writeOrdinaryData(
                 encoder,
                 buffer,
+                mappedData,
                 offset + subObjectOffset,
                 destSize - subObjectOffset,
                 subObjectLayout);
@@ -631,10 +667,12 @@ Result ShaderObjectImpl::_ensureOrdinaryDataBufferCreatedIfNeeded(
     // Once we have computed how large the buffer should be, we can allocate
     // it from the transient resource heap.
     //
+    void* mappedData = nullptr;
     SLANG_RETURN_ON_FAIL(encoder->m_commandBuffer->m_transientHeap->allocateConstantBuffer(
         m_constantBufferSize,
         m_constantBuffer,
-        m_constantBufferOffset));
+        m_constantBufferOffset,
+        &mappedData));
 
     // Once the buffer is allocated, we can use `_writeOrdinaryData` to fill it in.
     //
@@ -645,6 +683,7 @@ Result ShaderObjectImpl::_ensureOrdinaryDataBufferCreatedIfNeeded(
     SLANG_RETURN_ON_FAIL(_writeOrdinaryData(
         encoder,
         m_constantBuffer,
+        mappedData,
         m_constantBufferOffset,
         m_constantBufferSize,
         specializedLayout));
@@ -919,6 +958,23 @@ Result ShaderObjectImpl::bindAsParameterBlock(
     // value for `offset.pending.binding`, so that it writes after
     // all the other bindings.
 
+    // If the sets written the last time this object was bound are still valid, they
+    // can be bound again without writing any descriptors. Bindings for "pending" data
+    // are written into the sets of a parent object, so objects that have any are
+    // always written in full.
+    //
+    auto transientHeap = encoder->m_commandBuffer->m_transientHeap;
+    auto& cache = m_cachedDescriptorSets;
+    const bool canCache =
+        specializedLayout->getElementTypeLayout()->getPendingDataTypeLayout() == nullptr;
+    if (canCache && cache.transientHeap == transientHeap &&
+        cache.transientHeapVersion == transientHeap->getVersion() &&
+        cache.layout == specializedLayout && cache.version == _getVersionRecursive())
+    {
+        context.descriptorSets->addRange(cache.descriptorSets);
+        return SLANG_OK;
+    }
+
     // Writing the bindings for a parameter block is relatively easy:
     // we just need to allocate the descriptor set(s) needed for this
     // object and then fill it in like a `ConstantBuffer<X>`.
@@ -928,6 +984,21 @@ Result ShaderObjectImpl::bindAsParameterBlock(
     assert(offset.bindingSet < (uint32_t)context.descriptorSets->getCount());
     SLANG_RETURN_ON_FAIL(bindAsConstantBuffer(encoder, context, offset, specializedLayout));
 
+    if (canCache)
+    {
+        // The sets of this object and of any nested parameter blocks were all
+        // added after `offset.bindingSet`.
+        //
+        cache.transientHeap = transientHeap;
+        cache.transientHeapVersion = transientHeap->getVersion();
+        cache.layout = specializedLayout;
+        cache.version = _getVersionRecursive();
+        cache.descriptorSets.clear();
+        cache.descriptorSets.addRange(
+            context.descriptorSets->getBuffer() + offset.bindingSet,
+            context.descriptorSets->getCount() - offset.bindingSet);
+    }
+
     return SLANG_OK;
 }
 
@@ -25,6 +25,9 @@ struct CombinedTextureSamplerSlot
 class ShaderObjectImpl
     : public ShaderObjectBaseImpl<ShaderObjectImpl, ShaderObjectLayoutImpl, SimpleShaderObjectData>
 {
+    typedef ShaderObjectBaseImpl<ShaderObjectImpl, ShaderObjectLayoutImpl, SimpleShaderObjectData>
+        Super;
+
 public:
     static Result create(
         IDevice* device,
@@ -57,16 +60,27 @@ public:
         IResourceView* textureView,
         ISamplerState* sampler) override;
 
+    virtual SLANG_NO_THROW Result SLANG_MCALL
+    setObject(ShaderOffset const& offset, IShaderObject* object) override;
+
 protected:
     friend class RootShaderObjectLayout;
 
+    /// Record that the contents of this object have changed.
+    void _markChanged();
+
+    /// The latest version of this object or any of its sub-objects.
+    uint64_t _getVersionRecursive();
+
     Result init(IDevice* device, ShaderObjectLayoutImpl* layout);
 
     /// Write the uniform/ordinary data of this object into the given `dest` buffer at the given
-    /// `offset`
+    /// `offset`. If `mappedData` is the mapped memory of `buffer`, the data is written there
+    /// directly; otherwise it is uploaded through the encoder.
     Result _writeOrdinaryData(
         PipelineCommandEncoder* encoder,
         IBufferResource* buffer,
+        void* mappedData,
         Offset offset,
         Size destSize,
         ShaderObjectLayoutImpl* specializedLayout);
@@ -194,6 +208,23 @@ public:
     /// The version of the transient heap when the constant buffer is allocated.
     uint64_t m_constantBufferTransientHeapVersion;
 
+    /// Set from a global counter whenever the contents of this object change, so a later change
+    /// to any object always has a greater version.
+    uint64_t m_version = 0;
+
+    /// The descriptor sets written the last time this object was bound as a parameter block.
+    /// They are bound again, rather than allocated and written anew, until this object or one
+    /// of its sub-objects changes or the transient heap they came from is reset.
+    struct CachedDescriptorSets
+    {
+        TransientResourceHeapImpl* transientHeap = nullptr;
+        uint64_t transientHeapVersion = 0;
+        RefPtr<ShaderObjectLayoutImpl> layout;
+        uint64_t version = 0;
+        List<VkDescriptorSet> descriptorSets;
+    };
+    CachedDescriptorSets m_cachedDescriptorSets;
+
     /// Get the layout of this shader object with specialization arguments considered
     ///
     /// This operation should only be called after the shader object has been
@@ -338,6 +338,8 @@ Result SwapchainImpl::resize(GfxCount width, GfxCount height)
 
 Result SwapchainImpl::present()
 {
+    std::lock_guard<std::mutex> lock(m_queue->m_mutex);
+
     // If there are pending fence wait operations, flush them as an
     // empty vkQueueSubmit.
     if (m_queue->m_pendingWaitFences.getCount() != 0)
@@ -376,6 +378,7 @@ int SwapchainImpl::acquireNextImage()
 {
     if (!m_images.getCount())
     {
+        std::lock_guard<std::mutex> lock(m_queue->m_mutex);
         m_queue->m_pendingWaitSemaphores[1] = VK_NULL_HANDLE;
         return -1;
     }
@@ -400,6 +403,7 @@ int SwapchainImpl::acquireNextImage()
         return m_currentImageIndex;
     }
     // Make the queue's next submit wait on `m_nextImageSemaphore`.
+    std::lock_guard<std::mutex> lock(m_queue->m_mutex);
     m_queue->m_pendingWaitSemaphores[1] = m_nextImageSemaphore;
     return m_currentImageIndex;
 }
@@ -34,7 +34,8 @@ Result TransientResourceHeapImpl::init(const ITransientResourceHeap::Desc& desc,
     Super::init(
         desc,
         (uint32_t)device->m_api.m_deviceProperties.limits.minUniformBufferOffsetAlignment,
-        device);
+        device,
+        true);
 
     m_descSetAllocator.m_api = &device->m_api;
 
@@ -174,6 +174,28 @@ static rhi::DeviceType _toRenderType(Slang::RenderApiType apiType)
         {
             outOptions.performanceProfile = true;
         }
+        else if (argValue == "-perf")
+        {
+            outOptions.perfMode = true;
+        }
+        else if (argValue == "-perf-iterations" || argValue == "-perf-warm-up")
+        {
+            CommandLineArg count;
+            SLANG_RETURN_ON_FAIL(reader.expectArg(count));
+
+            const bool isIterations = argValue == "-perf-iterations";
+            const int v = stringToInt(count.value);
+            if (v < (isIterations ? 1 : 0))
+            {
+                sink.diagnose(count.loc, RenderTestDiagnostics::expectingPerfCount, argValue);
+                return SLANG_FAIL;
+            }
+            (isIterations ? outOptions.perfIterationCount : outOptions.perfWarmUpCount) = v;
+        }
+        else if (argValue == "-perf-output")
+        {
+            SLANG_RETURN_ON_FAIL(reader.expectArg(outOptions.perfOutputPath));
+        }
         else if (argValue == "-output-using-type")
         {
             outOptions.outputUsingType = true;
@@ -69,6 +69,15 @@ struct Options
 
     bool performanceProfile = false;
 
+    /// Dispatch the compute shader repeatedly, and report the time each dispatch took as JSON
+    bool perfMode = false;
+    /// The number of dispatches timed in perf mode
+    int perfIterationCount = 100;
+    /// The number of dispatches in perf mode before the timed ones, which aren't reported
+    int perfWarmUpCount = 5;
+    /// The file the perf mode JSON is written to. Written to stdout if not set.
+    Slang::String perfOutputPath;
+
     bool dontAddDefaultEntryPoints = false;
 
     bool disableDebugInfo = false;
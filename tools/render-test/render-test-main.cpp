@@ -4,6 +4,7 @@
 
 #include "../../source/core/slang-test-tool-util.h"
 #include "../source/core/slang-io.h"
+#include "../source/core/slang-string-escape-util.h"
 #include "../source/core/slang-string-util.h"
 #include "core/slang-token-reader.h"
 #include "options.h"
@@ -102,6 +103,9 @@ public:
 
     Result writeScreen(const String& filename);
 
+    /// Dispatch the compute shader repeatedly, timing each dispatch, and write the times as JSON
+    Result runPerformanceMode();
+
 protected:
     /// Called in initialize
     Result _initializeShaders(
@@ -111,6 +115,8 @@ protected:
         const ShaderCompilerUtil::Input& input);
     void _initializeRenderPass();
     void _initializeAccelerationStructure();
+    /// Write the times of the dispatches of runPerformanceMode as JSON
+    Result _writePerformanceReport(const char* timer, const List<double>& timesMs);
 
     uint64_t m_startTicks;
 
@@ -947,6 +953,162 @@ Result RenderTestApp::writeScreen(const String& filename)
     return PngSerializeUtil::write(filename.getBuffer(), blob, width, height);
 }
 
+Result RenderTestApp::runPerformanceMode()
+{
+    if (m_options.shaderType != Options::ShaderProgramType::Compute)
+    {
+        StdWriters::getError().print("error: -perf only supports compute tests (-compute)\n");
+        return SLANG_FAIL;
+    }
+
+    auto rootObject = m_device->createRootShaderObject(m_pipeline);
+    SLANG_RETURN_ON_FAIL(applyBinding(rootObject));
+    rootObject->finalize();
+
+    // Each dispatch is submitted and waited on by itself, so the time of one dispatch doesn't
+    // overlap with the next. Timestamps are written around the pass if there is a query pool.
+    auto dispatch = [&](IQueryPool* queryPool, uint32_t queryIndex)
+    {
+        auto encoder = m_queue->createCommandEncoder();
+        if (queryPool)
+            encoder->writeTimestamp(queryPool, queryIndex);
+
+        auto passEncoder = encoder->beginComputePass();
+        ComputeState state;
+        state.pipeline = static_cast<IComputePipeline*>(m_pipeline.get());
+        state.rootObject = rootObject;
+        passEncoder->setComputeState(state);
+        passEncoder->dispatchCompute(
+            m_options.computeDispatchSize[0],
+            m_options.computeDispatchSize[1],
+            m_options.computeDispatchSize[2]);
+        passEncoder->end();
+
+        if (queryPool)
+            encoder->writeTimestamp(queryPool, queryIndex + 1);
+        m_queue->submit(encoder->finish());
+        m_queue->waitOnHost();
+    };
+
+    for (int i = 0; i < m_options.perfWarmUpCount; ++i)
+    {
+        dispatch(nullptr, 0);
+    }
+
+    // GPU timestamps don't include the time taken to submit and wait on the dispatch, so they
+    // are used when the device has them. Otherwise each dispatch is timed on the host.
+    const int count = m_options.perfIterationCount;
+    const uint64_t timestampFrequency = m_device->getDeviceInfo().timestampFrequency;
+    ComPtr<IQueryPool> queryPool;
+    if (timestampFrequency)
+    {
+        QueryPoolDesc queryPoolDesc = {};
+        queryPoolDesc.count = uint32_t(count * 2);
+        queryPoolDesc.type = QueryType::Timestamp;
+        if (SLANG_SUCCEEDED(m_device->createQueryPool(queryPoolDesc, queryPool.writeRef())))
+        {
+            queryPool->reset();
+        }
+        else
+        {
+            queryPool = nullptr;
+        }
+    }
+
+    List<double> timesMs;
+    timesMs.setCount(count);
+    for (int i = 0; i < count; ++i)
+    {
+        const uint64_t startTicks = Process::getClockTick();
+        dispatch(queryPool, uint32_t(i * 2));
+        const uint64_t endTicks = Process::getClockTick();
+        timesMs[i] = double(endTicks - startTicks) * 1000.0 / Process::getClockFrequency();
+    }
+
+    if (queryPool)
+    {
+        List<uint64_t> timestamps;
+        timestamps.setCount(count * 2);
+        SLANG_RETURN_ON_FAIL(queryPool->getResult(0, uint32_t(count * 2), timestamps.getBuffer()));
+        for (int i = 0; i < count; ++i)
+        {
+            timesMs[i] = double(timestamps[i * 2 + 1] - timestamps[i * 2]) * 1000.0 /
+                         double(timestampFrequency);
+        }
+    }
+
+    return _writePerformanceReport(queryPool ? "gpu" : "host", timesMs);
+}
+
+static void _appendJSONString(const char* text, StringBuilder& out)
+{
+    auto handler = StringEscapeUtil::getHandler(StringEscapeUtil::Style::JSON);
+    StringEscapeUtil::appendQuoted(handler, UnownedStringSlice(text ? text : ""), out);
+}
+
+Result RenderTestApp::_writePerformanceReport(const char* timer, const List<double>& timesMs)
+{
+    List<double> sortedTimesMs = timesMs;
+    sortedTimesMs.sort();
+
+    double totalMs = 0.0;
+    for (auto time : timesMs)
+    {
+        totalMs += time;
+    }
+
+    const Index count = sortedTimesMs.getCount();
+    const Index middle = count / 2;
+    const double medianMs = (count & 1)
+                                ? sortedTimesMs[middle]
+                                : (sortedTimesMs[middle - 1] + sortedTimesMs[middle]) * 0.5;
+
+    StringBuilder out;
+    char buffer[64];
+    auto appendTime = [&](const char* name, double value)
+    {
+        snprintf(buffer, sizeof(buffer), "%.4f", value);
+        out << "  \"" << name << "\": " << buffer << ",\n";
+    };
+    out << "{\n";
+    out << "  \"version\": 1,\n";
+    out << "  \"device\": ";
+    _appendJSONString(getRHI()->getDeviceTypeName(m_options.deviceType), out);
+    out << ",\n";
+    out << "  \"adapter\": ";
+    _appendJSONString(m_device->getDeviceInfo().adapterName, out);
+    out << ",\n";
+    out << "  \"source\": ";
+    _appendJSONString(m_options.sourcePath.getBuffer(), out);
+    out << ",\n";
+    out << "  \"entryPoint\": ";
+    _appendJSONString(m_options.entryPointName.getBuffer(), out);
+    out << ",\n";
+    out << "  \"dispatchSize\": [" << m_options.computeDispatchSize[0] << ", "
+        << m_options.computeDispatchSize[1] << ", " << m_options.computeDispatchSize[2] << "],\n";
+    out << "  \"timer\": \"" << timer << "\",\n";
+    out << "  \"iterations\": " << count << ",\n";
+    appendTime("minMs", sortedTimesMs[0]);
+    appendTime("medianMs", medianMs);
+    appendTime("meanMs", totalMs / double(count));
+    appendTime("maxMs", sortedTimesMs[count - 1]);
+    out << "  \"timesMs\": [";
+    for (Index i = 0; i < count; ++i)
+    {
+        snprintf(buffer, sizeof(buffer), "%.4f", timesMs[i]);
+        out << (i ? ", " : "") << buffer;
+    }
+    out << "]\n";
+    out << "}\n";
+
+    if (m_options.perfOutputPath.getLength())
+    {
+        return File::writeAllText(m_options.perfOutputPath, out.produceString());
+    }
+    StdWriters::getOut().put(out.getUnownedSlice());
+    return SLANG_OK;
+}
+
 Result RenderTestApp::update()
 {
     auto encoder = m_queue->createCommandEncoder();
@@ -1443,6 +1605,12 @@ static SlangResult _innerMain(
         SLANG_RETURN_ON_FAIL(app.initialize(session, device, options, input));
         app.update();
         renderDocEndFrame();
+        if (options.perfMode)
+        {
+            const Result perfResult = app.runPerformanceMode();
+            app.finalize();
+            return perfResult;
+        }
         app.finalize();
     }
     return SLANG_OK;
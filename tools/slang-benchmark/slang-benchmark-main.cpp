@@ -0,0 +1,682 @@
+// slang-benchmark-main.cpp
+
+// Measures how long the phases of compilation take for every shader in a corpus,
+// through the public API, and compares the results against a stored baseline.
+//
+// See tools/benchmark/README.md for how to run it.
+
+#include "../../source/compiler-core/slang-json-rpc.h"
+#include "../../source/compiler-core/slang-json-value.h"
+#include "../../source/compiler-core/slang-source-loc.h"
+#include "../../source/core/slang-io.h"
+#include "../../source/core/slang-process.h"
+#include "../../source/core/slang-string-util.h"
+#include "slang-com-helper.h"
+#include "slang-com-ptr.h"
+#include "slang.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#if SLANG_WINDOWS_FAMILY
+#include <windows.h>
+// Must come after windows.h
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+using namespace Slang;
+
+namespace
+{
+
+enum class Phase
+{
+    FrontEnd,   ///< Parsing, checking and lowering a module to IR
+    Link,       ///< Composing and linking the program
+    IRPasses,   ///< Linking and optimizing the IR for the target
+    Emit,       ///< Emitting target code from the optimized IR
+    Downstream, ///< Downstream compilers, such as DXC or spirv-opt
+    CodeGen,    ///< All of getting the code of the entry points
+    Reflection, ///< Getting and walking the layout of the program
+    Total,
+    CountOf,
+};
+
+const char* const kPhaseNames[] = {
+    "frontEndMs",
+    "linkMs",
+    "irPassesMs",
+    "emitMs",
+    "downstreamMs",
+    "codeGenMs",
+    "reflectionMs",
+    "totalMs",
+};
+static_assert(SLANG_COUNT_OF(kPhaseNames) == Index(Phase::CountOf), "A phase is missing a name");
+
+struct TargetInfo
+{
+    const char* name;
+    SlangCompileTarget format;
+    const char* profile;
+};
+
+const TargetInfo kTargets[] = {
+    {"spirv", SLANG_SPIRV, "spirv_1_5"},
+    {"hlsl", SLANG_HLSL, "sm_6_5"},
+    {"dxil", SLANG_DXIL, "sm_6_5"},
+    {"glsl", SLANG_GLSL, "glsl_460"},
+    {"metal", SLANG_METAL, nullptr},
+    {"wgsl", SLANG_WGSL, nullptr},
+    {"cpp", SLANG_CPP_SOURCE, nullptr},
+};
+
+struct Options
+{
+    String corpusDirectory = "tools/benchmark/corpus";
+    const TargetInfo* target = &kTargets[0];
+    Index sampleCount = 3;
+    Index warmUpCount = 1;
+    String outputPath;
+    String baselinePath;
+    /// How much slower than the baseline a phase may get before it is a regression.
+    double tolerance = 0.1;
+    /// Phases that took less than this in the baseline are too noisy to compare.
+    double minComparedMs = 0.5;
+};
+
+struct FileResult
+{
+    String name;
+    Index entryPointCount = 0;
+    /// Average over the samples, in milliseconds.
+    double phaseMs[Index(Phase::CountOf)] = {};
+    double cpuMs = 0;
+    /// Peak resident memory of the whole process once the file was done.
+    uint64_t peakRSSBytes = 0;
+};
+
+double getWallTimeMs()
+{
+    return double(Process::getClockTick()) * 1000.0 / double(Process::getClockFrequency());
+}
+
+/// CPU time used by the process in milliseconds, over all threads.
+double getProcessCPUTimeMs()
+{
+#if SLANG_WINDOWS_FAMILY
+    FILETIME creationTime, exitTime, kernelTime, userTime;
+    if (!GetProcessTimes(GetCurrentProcess(), &creationTime, &exitTime, &kernelTime, &userTime))
+        return 0;
+    const auto toMs = [](const FILETIME& time)
+    { return double((uint64_t(time.dwHighDateTime) << 32) | time.dwLowDateTime) / 10000.0; };
+    return toMs(kernelTime) + toMs(userTime);
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+    const auto toMs = [](const struct timeval& time)
+    { return double(time.tv_sec) * 1000.0 + double(time.tv_usec) / 1000.0; };
+    return toMs(usage.ru_utime) + toMs(usage.ru_stime);
+#endif
+}
+
+uint64_t getPeakRSSBytes()
+{
+#if SLANG_WINDOWS_FAMILY
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        return 0;
+    return uint64_t(counters.PeakWorkingSetSize);
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+#if SLANG_APPLE_FAMILY
+    // Reported in bytes on macOS, and in kilobytes elsewhere
+    return uint64_t(usage.ru_maxrss);
+#else
+    return uint64_t(usage.ru_maxrss) * 1024;
+#endif
+#endif
+}
+
+/// The times of the profiled functions that tell the passes and emission apart.
+struct ProfileTimes
+{
+    double linkAndOptimizeMs = 0;
+    double emitSourceMs = 0;
+    double emitSPIRVMs = 0;
+};
+
+ProfileTimes readProfile(slang::ICompileRequest* request)
+{
+    ProfileTimes times;
+    ComPtr<ISlangProfiler> profiler;
+    if (SLANG_FAILED(request->getCompileTimeProfile(profiler.writeRef(), true)))
+        return times;
+
+    for (uint32_t i = 0; i < uint32_t(profiler->getEntryCount()); ++i)
+    {
+        const UnownedStringSlice name(profiler->getEntryName(i));
+        const double ms = double(profiler->getEntryTimeMS(i));
+        if (name == "linkAndOptimizeIR")
+            times.linkAndOptimizeMs = ms;
+        else if (name == "emitEntryPointsSourceFromIR")
+            times.emitSourceMs = ms;
+        else if (name == "emitSPIRVFromIR")
+            times.emitSPIRVMs = ms;
+    }
+    return times;
+}
+
+/// Walk every parameter of the layout, so that all of the type layouts get created.
+Index walkTypeLayout(slang::TypeLayoutReflection* typeLayout, int depth)
+{
+    if (!typeLayout || depth > 8)
+        return 0;
+    Index count = 1;
+    for (unsigned i = 0; i < typeLayout->getFieldCount(); ++i)
+    {
+        count += walkTypeLayout(typeLayout->getFieldByIndex(i)->getTypeLayout(), depth + 1);
+    }
+    count += walkTypeLayout(typeLayout->getElementTypeLayout(), depth + 1);
+    return count;
+}
+
+Index walkLayout(slang::ProgramLayout* layout)
+{
+    Index count = 0;
+    for (unsigned i = 0; i < layout->getParameterCount(); ++i)
+    {
+        count += walkTypeLayout(layout->getParameterByIndex(i)->getTypeLayout(), 0);
+    }
+    for (SlangUInt i = 0; i < layout->getEntryPointCount(); ++i)
+    {
+        auto entryPoint = layout->getEntryPointByIndex(i);
+        for (unsigned j = 0; j < entryPoint->getParameterCount(); ++j)
+        {
+            count += walkTypeLayout(entryPoint->getParameterByIndex(j)->getTypeLayout(), 0);
+        }
+    }
+    return count;
+}
+
+void printDiagnostics(slang::IBlob* diagnostics)
+{
+    if (diagnostics && diagnostics->getBufferSize())
+    {
+        fprintf(stderr, "%s\n", (const char*)diagnostics->getBufferPointer());
+    }
+}
+
+/// Whether `source` should be compiled for `target`. Files can list the targets they support on
+/// a `// benchmark-targets:` line, for example when they use stages that only some targets have.
+bool isTargetListed(const String& source, const char* target)
+{
+    const UnownedStringSlice directive("// benchmark-targets:");
+    const Index start = source.indexOf(directive);
+    if (start < 0)
+        return true;
+
+    UnownedStringSlice line = source.getUnownedSlice().tail(start + directive.getLength());
+    const Index end = line.indexOf('\n');
+    if (end >= 0)
+        line = line.head(end);
+
+    List<UnownedStringSlice> targets;
+    StringUtil::splitOnWhitespace(line, targets);
+    for (const auto& listed : targets)
+    {
+        if (listed == UnownedStringSlice(target))
+            return true;
+    }
+    return false;
+}
+
+/// Compile `source`, read from `path`, once, adding the time taken by each phase to `ioPhaseMs`.
+SlangResult compileSample(
+    slang::IGlobalSession* globalSession,
+    const Options& options,
+    const String& path,
+    const String& source,
+    double* ioPhaseMs,
+    Index& outEntryPointCount)
+{
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = options.target->format;
+    if (options.target->profile)
+        targetDesc.profile = globalSession->findProfile(options.target->profile);
+
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targets = &targetDesc;
+    sessionDesc.targetCount = 1;
+
+    const double startMs = getWallTimeMs();
+
+    ComPtr<slang::ISession> session;
+    SLANG_RETURN_ON_FAIL(globalSession->createSession(sessionDesc, session.writeRef()));
+
+    // Only used to get at the profile of the compile
+    ComPtr<slang::ICompileRequest> request;
+    SLANG_RETURN_ON_FAIL(session->createCompileRequest(request.writeRef()));
+    readProfile(request);
+
+    ComPtr<slang::IBlob> diagnostics;
+    // The path lets the file include headers relative to itself
+    const String moduleName = Path::getFileNameWithoutExt(path);
+    slang::IModule* module = session->loadModuleFromSourceString(
+        moduleName.getBuffer(),
+        path.getBuffer(),
+        source.getBuffer(),
+        diagnostics.writeRef());
+    printDiagnostics(diagnostics);
+    if (!module)
+        return SLANG_FAIL;
+
+    const double frontEndEndMs = getWallTimeMs();
+
+    List<ComPtr<slang::IComponentType>> components;
+    components.add(ComPtr<slang::IComponentType>(module));
+    for (SlangInt32 i = 0; i < module->getDefinedEntryPointCount(); ++i)
+    {
+        ComPtr<slang::IEntryPoint> entryPoint;
+        SLANG_RETURN_ON_FAIL(module->getDefinedEntryPoint(i, entryPoint.writeRef()));
+        components.add(ComPtr<slang::IComponentType>(entryPoint.get()));
+    }
+    outEntryPointCount = components.getCount() - 1;
+
+    ComPtr<slang::IComponentType> composite;
+    SLANG_RETURN_ON_FAIL(session->createCompositeComponentType(
+        (slang::IComponentType**)components.getBuffer(),
+        components.getCount(),
+        composite.writeRef(),
+        diagnostics.writeRef()));
+    ComPtr<slang::IComponentType> program;
+    SLANG_RETURN_ON_FAIL(composite->link(program.writeRef(), diagnostics.writeRef()));
+
+    const double linkEndMs = getWallTimeMs();
+
+    double downstreamStartMs = 0;
+    double totalStartMs = 0;
+    globalSession->getCompilerElapsedTime(&totalStartMs, &downstreamStartMs);
+
+    for (Index i = 0; i < outEntryPointCount; ++i)
+    {
+        ComPtr<slang::IBlob> code;
+        const SlangResult result =
+            program->getEntryPointCode(SlangInt(i), 0, code.writeRef(), diagnostics.writeRef());
+        printDiagnostics(diagnostics);
+        SLANG_RETURN_ON_FAIL(result);
+    }
+
+    const double codeGenEndMs = getWallTimeMs();
+
+    double downstreamEndMs = 0;
+    double totalEndMs = 0;
+    globalSession->getCompilerElapsedTime(&totalEndMs, &downstreamEndMs);
+    const ProfileTimes profile = readProfile(request);
+
+    slang::ProgramLayout* layout = program->getLayout(0, diagnostics.writeRef());
+    if (!layout)
+        return SLANG_FAIL;
+    walkLayout(layout);
+
+    const double endMs = getWallTimeMs();
+
+    // Source emission includes linking and optimizing the IR, SPIR-V emission doesn't.
+    const double irPassesMs = profile.linkAndOptimizeMs;
+    const double emitMs = Math::Max(profile.emitSourceMs - irPassesMs, 0.0) + profile.emitSPIRVMs;
+
+    ioPhaseMs[Index(Phase::FrontEnd)] += frontEndEndMs - startMs;
+    ioPhaseMs[Index(Phase::Link)] += linkEndMs - frontEndEndMs;
+    ioPhaseMs[Index(Phase::IRPasses)] += irPassesMs;
+    ioPhaseMs[Index(Phase::Emit)] += emitMs;
+    ioPhaseMs[Index(Phase::Downstream)] += (downstreamEndMs - downstreamStartMs) * 1000.0;
+    ioPhaseMs[Index(Phase::CodeGen)] += codeGenEndMs - linkEndMs;
+    ioPhaseMs[Index(Phase::Reflection)] += endMs - codeGenEndMs;
+    ioPhaseMs[Index(Phase::Total)] += endMs - startMs;
+    return SLANG_OK;
+}
+
+SlangResult benchmarkFile(
+    slang::IGlobalSession* globalSession,
+    const Options& options,
+    const String& name,
+    FileResult& outResult)
+{
+    const String path = Path::combine(options.corpusDirectory, name);
+    String source;
+    SLANG_RETURN_ON_FAIL(File::readAllText(path, source));
+    if (!isTargetListed(source, options.target->name))
+        return SLANG_E_NOT_AVAILABLE;
+
+    outResult.name = name;
+
+    double warmUpMs[Index(Phase::CountOf)] = {};
+    for (Index i = 0; i < options.warmUpCount; ++i)
+    {
+        SLANG_RETURN_ON_FAIL(compileSample(
+            globalSession,
+            options,
+            path,
+            source,
+            warmUpMs,
+            outResult.entryPointCount));
+    }
+
+    const double cpuStartMs = getProcessCPUTimeMs();
+    for (Index i = 0; i < options.sampleCount; ++i)
+    {
+        SLANG_RETURN_ON_FAIL(compileSample(
+            globalSession,
+            options,
+            path,
+            source,
+            outResult.phaseMs,
+            outResult.entryPointCount));
+    }
+    outResult.cpuMs = (getProcessCPUTimeMs() - cpuStartMs) / double(options.sampleCount);
+
+    for (auto& ms : outResult.phaseMs)
+        ms /= double(options.sampleCount);
+    outResult.peakRSSBytes = getPeakRSSBytes();
+    return SLANG_OK;
+}
+
+void writeJSON(
+    const Options& options,
+    double globalSessionMs,
+    const List<FileResult>& results,
+    StringBuilder& out)
+{
+    char buffer[64];
+    const auto appendNumber = [&](double value)
+    {
+        snprintf(buffer, sizeof(buffer), "%.4f", value);
+        out << buffer;
+    };
+
+    out << "{\n";
+    out << "    \"version\": 1,\n";
+    out << "    \"target\": \"" << options.target->name << "\",\n";
+    out << "    \"samples\": " << options.sampleCount << ",\n";
+    out << "    \"globalSessionMs\": ";
+    appendNumber(globalSessionMs);
+    out << ",\n";
+    out << "    \"peakRSSBytes\": " << getPeakRSSBytes() << ",\n";
+    out << "    \"results\": [\n";
+    for (Index i = 0; i < results.getCount(); ++i)
+    {
+        const auto& result = results[i];
+        out << "        {\n";
+        out << "            \"name\": \"" << result.name << "\",\n";
+        out << "            \"entryPoints\": " << result.entryPointCount << ",\n";
+        for (Index p = 0; p < Index(Phase::CountOf); ++p)
+        {
+            out << "            \"" << kPhaseNames[p] << "\": ";
+            appendNumber(result.phaseMs[p]);
+            out << ",\n";
+        }
+        out << "            \"cpuMs\": ";
+        appendNumber(result.cpuMs);
+        out << ",\n";
+        out << "            \"peakRSSBytes\": " << result.peakRSSBytes << "\n";
+        out << "        }" << ((i + 1 < results.getCount()) ? "," : "") << "\n";
+    }
+    out << "    ]\n";
+    out << "}\n";
+}
+
+/// Report every phase of `results` that got slower than in the baseline by more than the
+/// tolerance. Returns SLANG_FAIL if there is any such regression.
+SlangResult compareWithBaseline(const Options& options, const List<FileResult>& results)
+{
+    String baselineText;
+    if (SLANG_FAILED(File::readAllText(options.baselinePath, baselineText)))
+    {
+        fprintf(stderr, "error: unable to read baseline '%s'\n", options.baselinePath.getBuffer());
+        return SLANG_FAIL;
+    }
+
+    SourceManager sourceManager;
+    sourceManager.initialize(nullptr, nullptr);
+    DiagnosticSink sink(&sourceManager, nullptr);
+    RefPtr<JSONContainer> container = new JSONContainer(&sourceManager);
+
+    JSONValue root;
+    if (SLANG_FAILED(
+            JSONRPCUtil::parseJSON(baselineText.getUnownedSlice(), container, &sink, root)) ||
+        root.getKind() != JSONValue::Kind::Object)
+    {
+        fprintf(
+            stderr,
+            "error: '%s' is not a benchmark result\n",
+            options.baselinePath.getBuffer());
+        return SLANG_FAIL;
+    }
+
+    const JSONValue baselineResults =
+        container->findObjectValue(root, container->getKey(UnownedStringSlice("results")));
+    if (baselineResults.getKind() != JSONValue::Kind::Array)
+        return SLANG_FAIL;
+
+    Index regressionCount = 0;
+    const auto compare = [&](const FileResult& result,
+                             const JSONValue& baseline,
+                             const char* key,
+                             double current,
+                             double minBaseline)
+    {
+        const JSONValue value =
+            container->findObjectValue(baseline, container->getKey(UnownedStringSlice(key)));
+        if (!value.isValid())
+            return;
+        const double base = container->asFloat(value);
+        if (base < minBaseline || current <= base * (1.0 + options.tolerance))
+            return;
+
+        fprintf(
+            stderr,
+            "regression: %s %s %.3f -> %.3f (+%.1f%%)\n",
+            result.name.getBuffer(),
+            key,
+            base,
+            current,
+            (current / base - 1.0) * 100.0);
+        regressionCount++;
+    };
+
+    for (const auto& result : results)
+    {
+        for (const auto& baseline : container->getArray(baselineResults))
+        {
+            const JSONValue name =
+                container->findObjectValue(baseline, container->getKey(UnownedStringSlice("name")));
+            if (!name.isValid() || container->getString(name) != result.name.getUnownedSlice())
+                continue;
+
+            for (Index p = 0; p < Index(Phase::CountOf); ++p)
+            {
+                compare(result, baseline, kPhaseNames[p], result.phaseMs[p], options.minComparedMs);
+            }
+            compare(result, baseline, "peakRSSBytes", double(result.peakRSSBytes), 1.0);
+        }
+    }
+
+    if (regressionCount)
+    {
+        fprintf(
+            stderr,
+            "%d regressions against '%s'\n",
+            int(regressionCount),
+            options.baselinePath.getBuffer());
+        return SLANG_FAIL;
+    }
+    printf("No regressions against '%s'\n", options.baselinePath.getBuffer());
+    return SLANG_OK;
+}
+
+void printUsage()
+{
+    printf(
+        "Usage: slang-benchmark [options]\n"
+        "\n"
+        "  -corpus <dir>       Directory of .slang files to compile\n"
+        "                      (default tools/benchmark/corpus)\n"
+        "  -target <name>      spirv, hlsl, dxil, glsl, metal, wgsl or cpp (default spirv)\n"
+        "  -samples <count>    Compiles of each file that are measured (default 3)\n"
+        "  -warm-up <count>    Compiles of each file before measuring (default 1)\n"
+        "  -output <file>      Write the results as JSON to <file> instead of stdout\n"
+        "  -baseline <file>    Compare the results with those stored in <file>\n"
+        "  -tolerance <value>  Fraction a phase may get slower than the baseline (default 0.1)\n");
+}
+
+SlangResult parseOptions(int argc, char** argv, Options& outOptions)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        const UnownedStringSlice arg(argv[i]);
+        if (arg == "-h" || arg == "-help" || arg == "--help")
+        {
+            printUsage();
+            return SLANG_E_NOT_AVAILABLE;
+        }
+        if (i + 1 >= argc)
+        {
+            fprintf(stderr, "error: missing value for '%s'\n", argv[i]);
+            return SLANG_E_INVALID_ARG;
+        }
+
+        const char* value = argv[++i];
+        if (arg == "-corpus")
+        {
+            outOptions.corpusDirectory = value;
+        }
+        else if (arg == "-target")
+        {
+            outOptions.target = nullptr;
+            for (const auto& target : kTargets)
+            {
+                if (UnownedStringSlice(target.name) == UnownedStringSlice(value))
+                    outOptions.target = &target;
+            }
+            if (!outOptions.target)
+            {
+                fprintf(stderr, "error: unknown target '%s'\n", value);
+                return SLANG_E_INVALID_ARG;
+            }
+        }
+        else if (arg == "-samples")
+        {
+            outOptions.sampleCount = Math::Max(Index(atoi(value)), Index(1));
+        }
+        else if (arg == "-warm-up")
+        {
+            outOptions.warmUpCount = Math::Max(Index(atoi(value)), Index(0));
+        }
+        else if (arg == "-output")
+        {
+            outOptions.outputPath = value;
+        }
+        else if (arg == "-baseline")
+        {
+            outOptions.baselinePath = value;
+        }
+        else if (arg == "-tolerance")
+        {
+            outOptions.tolerance = atof(value);
+        }
+        else
+        {
+            fprintf(stderr, "error: unknown option '%s'\n", argv[i - 1]);
+            printUsage();
+            return SLANG_E_INVALID_ARG;
+        }
+    }
+    return SLANG_OK;
+}
+
+SlangResult innerMain(int argc, char** argv)
+{
+    Options options;
+    {
+        const SlangResult res = parseOptions(argc, argv, options);
+        if (res == SLANG_E_NOT_AVAILABLE)
+            return SLANG_OK;
+        SLANG_RETURN_ON_FAIL(res);
+    }
+
+    // Files are compiled in name order, so the results of runs can be diffed.
+    struct Visitor : Path::Visitor
+    {
+        void accept(Path::Type type, const UnownedStringSlice& fileName) SLANG_OVERRIDE
+        {
+            if (type == Path::Type::File && fileName.endsWith(".slang"))
+                names.add(fileName);
+        }
+        List<String> names;
+    };
+    Visitor visitor;
+    if (SLANG_FAILED(Path::find(options.corpusDirectory, nullptr, &visitor)) ||
+        visitor.names.getCount() == 0)
+    {
+        fprintf(stderr, "error: no .slang files in '%s'\n", options.corpusDirectory.getBuffer());
+        return SLANG_FAIL;
+    }
+    visitor.names.sort();
+
+    const double globalSessionStartMs = getWallTimeMs();
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_RETURN_ON_FAIL(slang::createGlobalSession(globalSession.writeRef()));
+    const double globalSessionMs = getWallTimeMs() - globalSessionStartMs;
+
+    List<FileResult> results;
+    for (const auto& name : visitor.names)
+    {
+        FileResult result;
+        const SlangResult res = benchmarkFile(globalSession, options, name, result);
+        if (res == SLANG_E_NOT_AVAILABLE)
+        {
+            fprintf(
+                stderr,
+                "skipping '%s', which doesn't list %s\n",
+                name.getBuffer(),
+                options.target->name);
+            continue;
+        }
+        if (SLANG_FAILED(res))
+        {
+            fprintf(stderr, "error: failed to compile '%s'\n", name.getBuffer());
+            return SLANG_FAIL;
+        }
+        results.add(result);
+    }
+
+    StringBuilder json;
+    writeJSON(options, globalSessionMs, results, json);
+    if (options.outputPath.getLength())
+    {
+        SLANG_RETURN_ON_FAIL(File::writeAllText(options.outputPath, json));
+    }
+    else
+    {
+        fputs(json.getBuffer(), stdout);
+    }
+
+    if (options.baselinePath.getLength())
+    {
+        SLANG_RETURN_ON_FAIL(compareWithBaseline(options, results));
+    }
+    return SLANG_OK;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const SlangResult res = innerMain(argc, argv);
+    return SLANG_SUCCEEDED(res) ? 0 : 1;
+}
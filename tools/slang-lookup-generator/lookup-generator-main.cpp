@@ -96,7 +96,8 @@ int main(int argc, const char* const* argv)
     {
         fprintf(
             stderr,
-            "Usage: %s input.grammar.json output.cpp enum-name enumerant-prefix enum-header-file\n",
+            "Usage: %s (input.grammar.json | input.txt) output.cpp enum-name enumerant-prefix "
+            "enum-header-file\n",
             argc >= 1 ? argv[0] : "slang-lookup-generator");
         return 1;
     }
@@ -114,6 +115,7 @@ int main(int argc, const char* const* argv)
     sink.writer = writer;
 
     List<String> opnames;
+    List<String> enumerants;
 
     if (String(inPath).endsWith("json"))
     {
@@ -136,13 +138,31 @@ int main(int argc, const char* const* argv)
     }
     else
     {
-        // Otherwise, we assume the input is a text file with one name per line.
+        // Otherwise, we assume the input is a text file with one name per line. A name can be
+        // followed by the enumerant it maps to, for names that aren't valid identifiers, such
+        // as keywords. Empty lines are skipped.
         String content;
-        File::readAllText(inPath, content);
-        List<UnownedStringSlice> words;
-        StringUtil::split(content.getUnownedSlice(), '\n', words);
-        for (auto w : words)
-            opnames.add(w);
+        if (SLANG_FAILED(File::readAllText(inPath, content)))
+        {
+            sink.diagnoseRaw(Severity::Error, "Unable to read input file\n");
+            return 1;
+        }
+        List<UnownedStringSlice> lines;
+        StringUtil::calcLines(content.getUnownedSlice(), lines);
+        for (auto line : lines)
+        {
+            List<UnownedStringSlice> words;
+            StringUtil::splitOnWhitespace(line, words);
+            if (words.getCount() == 0)
+                continue;
+            if (words.getCount() > 2)
+            {
+                sink.diagnoseRaw(Severity::Error, "Expected a name and optional enumerant\n");
+                return 1;
+            }
+            opnames.add(words[0]);
+            enumerants.add(words[words.getCount() - 1]);
+        }
     }
 
     if (SLANG_FAILED(writePerfectHashLookupCppFile(
@@ -151,7 +171,8 @@ int main(int argc, const char* const* argv)
             enumName,
             enumerantPrefix,
             enumHeader,
-            &sink)))
+            &sink,
+            enumerants)))
         return -1;
 
     return 0;
@@ -1,41 +1,426 @@
 // slang-profile-main.cpp
 
+// Measures how long each phase of starting up Slang and compiling one file takes, repeated a
+// number of times, and reports percentiles of the times. Meant to be attached to reports of
+// performance problems, so that they can be reproduced with the same command.
+//
+// See tools/benchmark/README.md for how to run it.
+
 #include "../../source/core/slang-io.h"
-#include "../../source/core/slang-process-util.h"
-#include "../../source/core/slang-std-writers.h"
-#include "../../source/core/slang-string-util.h"
+#include "../../source/core/slang-process.h"
 #include "slang-com-helper.h"
+#include "slang-com-ptr.h"
+#include "slang.h"
+
+#include <stdio.h>
+#include <stdlib.h>
 
 using namespace Slang;
 
-SlangResult innerMain(int argc, char** argv)
+namespace
+{
+
+struct TargetInfo
+{
+    const char* name;
+    SlangCompileTarget format;
+    const char* profile;
+};
+
+const TargetInfo kTargets[] = {
+    {"spirv", SLANG_SPIRV, "spirv_1_5"},
+    {"hlsl", SLANG_HLSL, "sm_6_5"},
+    {"dxil", SLANG_DXIL, "sm_6_5"},
+    {"glsl", SLANG_GLSL, "glsl_460"},
+    {"metal", SLANG_METAL, nullptr},
+    {"wgsl", SLANG_WGSL, nullptr},
+    {"cpp", SLANG_CPP_SOURCE, nullptr},
+};
+
+struct Options
+{
+    /// The file to compile. Without one only the startup phases are measured.
+    String inputPath;
+    List<const TargetInfo*> targets;
+    Index iterationCount = 10;
+    Index warmUpCount = 1;
+    /// Where to write a Chrome trace of one more compile of the input, if anywhere.
+    String tracePath;
+};
+
+/// The times of one phase, in milliseconds, one per iteration.
+struct PhaseTimes
+{
+    String name;
+    List<double> samples;
+};
+
+double getWallTimeMs()
+{
+    return double(Process::getClockTick()) * 1000.0 / double(Process::getClockFrequency());
+}
+
+void printDiagnostics(slang::IBlob* diagnostics)
 {
-    auto stdWriters = StdWriters::initDefaultSingleton();
+    if (diagnostics && diagnostics->getBufferSize())
+    {
+        fprintf(stderr, "%s\n", (const char*)diagnostics->getBufferPointer());
+    }
+}
 
-    // Time the creation of the session
+/// Records the time since the previous phase as a sample of the phase `name`.
+struct PhaseTimer
+{
+    PhaseTimer(List<PhaseTimes>& phases)
+        : m_phases(phases), m_startMs(getWallTimeMs())
     {
-        const auto startTick = Process::getClockTick();
+    }
 
-        for (Int i = 0; i < 32; ++i)
+    void endPhase(const String& name)
+    {
+        const double endMs = getWallTimeMs();
+        PhaseTimes* phase = nullptr;
+        for (auto& existing : m_phases)
+        {
+            if (existing.name == name)
+                phase = &existing;
+        }
+        if (!phase)
         {
-            ComPtr<slang::IGlobalSession> slangSession;
-            slangSession.attach(spCreateSession(nullptr));
+            m_phases.add(PhaseTimes{name, {}});
+            phase = &m_phases.getLast();
         }
+        phase->samples.add(endMs - m_startMs);
+        m_startMs = endMs;
+    }
+
+    List<PhaseTimes>& m_phases;
+    double m_startMs;
+};
+
+/// Run every phase once, adding a sample for each of them to `ioPhases`.
+SlangResult runIteration(const Options& options, const String& source, List<PhaseTimes>& ioPhases)
+{
+    PhaseTimer timer(ioPhases);
+    const double startMs = timer.m_startMs;
 
-        const auto endTick = Process::getClockTick();
+    // The core module is loaded separately, so that the time it takes is told apart from
+    // the rest of creating the global session.
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_RETURN_ON_FAIL(
+        slang_createGlobalSessionWithoutCoreModule(SLANG_API_VERSION, globalSession.writeRef()));
+    timer.endPhase("globalSession");
 
-        printf("Ticks %f\n", double(endTick - startTick) / Process::getClockFrequency());
-        return SLANG_OK;
+    if (auto coreModule = slang_getEmbeddedCoreModule())
+    {
+        SLANG_RETURN_ON_FAIL(globalSession->loadCoreModule(
+            coreModule->getBufferPointer(),
+            coreModule->getBufferSize()));
+    }
+    else
+    {
+        SLANG_RETURN_ON_FAIL(globalSession->compileCoreModule(0));
     }
+    timer.endPhase("coreModule");
 
+    List<slang::TargetDesc> targetDescs;
+    for (auto target : options.targets)
+    {
+        slang::TargetDesc targetDesc = {};
+        targetDesc.format = target->format;
+        if (target->profile)
+            targetDesc.profile = globalSession->findProfile(target->profile);
+        targetDescs.add(targetDesc);
+    }
+
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targets = targetDescs.getBuffer();
+    sessionDesc.targetCount = SlangInt(targetDescs.getCount());
+
+    ComPtr<slang::ISession> session;
+    SLANG_RETURN_ON_FAIL(globalSession->createSession(sessionDesc, session.writeRef()));
+    timer.endPhase("session");
+
+    if (options.inputPath.getLength())
+    {
+        ComPtr<slang::IBlob> diagnostics;
+        // The path lets the file include headers relative to itself
+        const String moduleName = Path::getFileNameWithoutExt(options.inputPath);
+        slang::IModule* module = session->loadModuleFromSourceString(
+            moduleName.getBuffer(),
+            options.inputPath.getBuffer(),
+            source.getBuffer(),
+            diagnostics.writeRef());
+        printDiagnostics(diagnostics);
+        if (!module)
+            return SLANG_FAIL;
+        timer.endPhase("moduleLoad");
+
+        List<ComPtr<slang::IComponentType>> components;
+        components.add(ComPtr<slang::IComponentType>(module));
+        for (SlangInt32 i = 0; i < module->getDefinedEntryPointCount(); ++i)
+        {
+            ComPtr<slang::IEntryPoint> entryPoint;
+            SLANG_RETURN_ON_FAIL(module->getDefinedEntryPoint(i, entryPoint.writeRef()));
+            components.add(ComPtr<slang::IComponentType>(entryPoint.get()));
+        }
+        const Index entryPointCount = components.getCount() - 1;
+
+        ComPtr<slang::IComponentType> composite;
+        SLANG_RETURN_ON_FAIL(session->createCompositeComponentType(
+            (slang::IComponentType**)components.getBuffer(),
+            components.getCount(),
+            composite.writeRef(),
+            diagnostics.writeRef()));
+        ComPtr<slang::IComponentType> program;
+        SLANG_RETURN_ON_FAIL(composite->link(program.writeRef(), diagnostics.writeRef()));
+        timer.endPhase("link");
+
+        for (Index targetIndex = 0; targetIndex < options.targets.getCount(); ++targetIndex)
+        {
+            for (Index i = 0; i < entryPointCount; ++i)
+            {
+                ComPtr<slang::IBlob> code;
+                const SlangResult result = program->getEntryPointCode(
+                    SlangInt(i),
+                    SlangInt(targetIndex),
+                    code.writeRef(),
+                    diagnostics.writeRef());
+                printDiagnostics(diagnostics);
+                SLANG_RETURN_ON_FAIL(result);
+            }
+            timer.endPhase(String("codeGen.") + options.targets[targetIndex]->name);
+        }
+    }
+
+    // Releasing everything is part of the cost of a compile that a tool pays too.
+    session.setNull();
+    globalSession.setNull();
+    timer.endPhase("release");
+
+    timer.m_startMs = startMs;
+    timer.endPhase("total");
     return SLANG_OK;
 }
 
+/// Compile the input once more with tracing enabled, writing the trace to the trace path.
+SlangResult writeTrace(const Options& options)
+{
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_RETURN_ON_FAIL(slang::createGlobalSession(globalSession.writeRef()));
+
+    ComPtr<slang::ICompileRequest> request;
+    SLANG_RETURN_ON_FAIL(globalSession->createCompileRequest(request.writeRef()));
+
+    // The entry points are found through their `[shader(...)]` attributes, as when profiling.
+    List<const char*> args;
+    args.add(options.inputPath.getBuffer());
+    for (auto target : options.targets)
+    {
+        args.add("-target");
+        args.add(target->name);
+        if (target->profile)
+        {
+            args.add("-profile");
+            args.add(target->profile);
+        }
+    }
+    args.add("-trace-json");
+    args.add(options.tracePath.getBuffer());
+    SLANG_RETURN_ON_FAIL(
+        request->processCommandLineArguments(args.getBuffer(), int(args.getCount())));
+
+    const SlangResult result = request->compile();
+    if (auto diagnostics = request->getDiagnosticOutput())
+    {
+        if (*diagnostics)
+            fprintf(stderr, "%s\n", diagnostics);
+    }
+    return result;
+}
+
+/// The `percent` percentile of the sorted `samples`, using the nearest rank.
+double getPercentile(const List<double>& samples, double percent)
+{
+    const Index count = samples.getCount();
+    Index rank = Index(percent / 100.0 * double(count) + 0.999999);
+    rank = Math::Clamp(rank, Index(1), count);
+    return samples[rank - 1];
+}
+
+void printResults(const Options& options, List<PhaseTimes>& phases)
+{
+    printf(
+        "%s, %d iterations, times in milliseconds\n\n",
+        options.inputPath.getLength() ? options.inputPath.getBuffer() : "startup only",
+        int(options.iterationCount));
+    printf(
+        "%-20s %10s %10s %10s %10s %10s %10s\n",
+        "phase",
+        "min",
+        "p50",
+        "p90",
+        "p99",
+        "max",
+        "mean");
+    for (auto& phase : phases)
+    {
+        auto& samples = phase.samples;
+        samples.sort();
+        double sum = 0;
+        for (auto sample : samples)
+            sum += sample;
+        printf(
+            "%-20s %10.3f %10.3f %10.3f %10.3f %10.3f %10.3f\n",
+            phase.name.getBuffer(),
+            samples[0],
+            getPercentile(samples, 50),
+            getPercentile(samples, 90),
+            getPercentile(samples, 99),
+            samples.getLast(),
+            sum / double(samples.getCount()));
+    }
+}
+
+void printUsage()
+{
+    printf(
+        "Usage: slang-profile [options] [file.slang]\n"
+        "\n"
+        "Measures creating a global session, loading the core module and creating a session,\n"
+        "and when a file is given, loading it as a module, linking it with the entry points\n"
+        "it defines, and generating code for each target.\n"
+        "\n"
+        "  -target <name>       spirv, hlsl, dxil, glsl, metal, wgsl or cpp (default spirv),\n"
+        "                       can be given more than once\n"
+        "  -iterations <count>  Iterations that are measured (default 10)\n"
+        "  -warm-up <count>     Iterations before measuring (default 1)\n"
+        "  -trace <file>        Compile the file once more with tracing enabled, and write\n"
+        "                       the trace to <file> in the Chrome trace event format\n");
+}
+
+SlangResult parseOptions(int argc, char** argv, Options& outOptions)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        const UnownedStringSlice arg(argv[i]);
+        if (arg == "-h" || arg == "-help" || arg == "--help")
+        {
+            printUsage();
+            return SLANG_E_NOT_AVAILABLE;
+        }
+        if (!arg.startsWith("-"))
+        {
+            if (outOptions.inputPath.getLength())
+            {
+                fprintf(stderr, "error: only one input file can be profiled\n");
+                return SLANG_E_INVALID_ARG;
+            }
+            outOptions.inputPath = String(arg);
+            continue;
+        }
+        if (i + 1 >= argc)
+        {
+            fprintf(stderr, "error: missing value for '%s'\n", argv[i]);
+            return SLANG_E_INVALID_ARG;
+        }
+
+        const char* value = argv[++i];
+        if (arg == "-target")
+        {
+            const TargetInfo* found = nullptr;
+            for (const auto& target : kTargets)
+            {
+                if (UnownedStringSlice(target.name) == UnownedStringSlice(value))
+                    found = &target;
+            }
+            if (!found)
+            {
+                fprintf(stderr, "error: unknown target '%s'\n", value);
+                return SLANG_E_INVALID_ARG;
+            }
+            outOptions.targets.add(found);
+        }
+        else if (arg == "-iterations")
+        {
+            outOptions.iterationCount = Math::Max(Index(atoi(value)), Index(1));
+        }
+        else if (arg == "-warm-up")
+        {
+            outOptions.warmUpCount = Math::Max(Index(atoi(value)), Index(0));
+        }
+        else if (arg == "-trace")
+        {
+            outOptions.tracePath = value;
+        }
+        else
+        {
+            fprintf(stderr, "error: unknown option '%s'\n", argv[i - 1]);
+            printUsage();
+            return SLANG_E_INVALID_ARG;
+        }
+    }
+
+    if (outOptions.targets.getCount() == 0)
+        outOptions.targets.add(&kTargets[0]);
+    if (outOptions.tracePath.getLength() && !outOptions.inputPath.getLength())
+    {
+        fprintf(stderr, "error: -trace needs a file to compile\n");
+        return SLANG_E_INVALID_ARG;
+    }
+    return SLANG_OK;
+}
+
+SlangResult innerMain(int argc, char** argv)
+{
+    Options options;
+    {
+        const SlangResult res = parseOptions(argc, argv, options);
+        if (res == SLANG_E_NOT_AVAILABLE)
+            return SLANG_OK;
+        SLANG_RETURN_ON_FAIL(res);
+    }
+
+    String source;
+    if (options.inputPath.getLength() &&
+        SLANG_FAILED(File::readAllText(options.inputPath, source)))
+    {
+        fprintf(stderr, "error: can't read '%s'\n", options.inputPath.getBuffer());
+        return SLANG_FAIL;
+    }
+
+    List<PhaseTimes> warmUpPhases;
+    for (Index i = 0; i < options.warmUpCount; ++i)
+    {
+        SLANG_RETURN_ON_FAIL(runIteration(options, source, warmUpPhases));
+    }
+
+    List<PhaseTimes> phases;
+    for (Index i = 0; i < options.iterationCount; ++i)
+    {
+        SLANG_RETURN_ON_FAIL(runIteration(options, source, phases));
+    }
+    printResults(options, phases);
+
+    if (options.tracePath.getLength())
+    {
+        if (SLANG_FAILED(writeTrace(options)))
+        {
+            fprintf(
+                stderr,
+                "error: failed to write a trace to '%s'\n",
+                options.tracePath.getBuffer());
+            return SLANG_FAIL;
+        }
+        printf("\nWrote a trace of one compile to %s\n", options.tracePath.getBuffer());
+    }
+    return SLANG_OK;
+}
+
+} // namespace
+
 int main(int argc, char** argv)
 {
     const SlangResult res = innerMain(argc, argv);
-#ifdef _MSC_VER
-    _CrtDumpMemoryLeaks();
-#endif
     return SLANG_SUCCEEDED(res) ? 0 : 1;
 }
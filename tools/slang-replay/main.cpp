@@ -1,4 +1,6 @@
+#include "../../source/core/slang-dictionary.h"
 #include "../../source/core/slang-io.h"
+#include "../../source/core/slang-process.h"
 
 #include <memory>
 #include <replay/json-consumer.h>
@@ -10,9 +12,37 @@
 struct Options
 {
     bool convertToJson{false};
+    bool profile{false};
+    int repeatCount{1};
+    Slang::String traceFileName;
     Slang::String recordFileName;
 };
 
+// The time the recorded calls took to replay
+struct CallProfile
+{
+    struct CallStats
+    {
+        uint32_t count = 0;
+        double totalTime = 0;
+        double maxTime = 0;
+    };
+
+    struct TraceEvent
+    {
+        const char* name;
+        double startTime;
+        double duration;
+    };
+
+    Slang::Dictionary<SlangRecord::ApiCallId, CallStats> stats;
+    // Every call, then every replay of the record, if a trace is written
+    Slang::List<TraceEvent> traceEvents;
+    Slang::List<double> replayTimes;
+    // The tick the trace times are relative to
+    uint64_t startTick = 0;
+};
+
 void printUsage()
 {
     printf("Usage: slang-replay [options] <record-file>\n");
@@ -20,6 +50,11 @@ void printUsage()
     printf(
         "  --convert-json, -cj: Convert the record file to a JSON file in the same directory with record file.\n\
                        When this option is set, it won't replay the record file.\n");
+    printf("  --profile, -p: Time every replayed API call, and print the time each kind of\n\
+                 call took.\n");
+    printf("  --repeat <count>: Replay the record file <count> times.\n");
+    printf("  --trace <file>: Write the replayed calls to <file> in the Chrome trace event\n\
+                  format. Implies --profile.\n");
 }
 
 Options parseOption(int argc, char* argv[])
@@ -48,6 +83,37 @@ Options parseOption(int argc, char* argv[])
             option.convertToJson = true;
             argIndex++;
         }
+        else if ((strcmp("--profile", arg) == 0) || (strcmp("-p", arg) == 0))
+        {
+            option.profile = true;
+            argIndex++;
+        }
+        else if ((strcmp("--repeat", arg) == 0) || (strcmp("--trace", arg) == 0))
+        {
+            if (argIndex + 1 >= argc)
+            {
+                printf("Expected an operand for %s\n", arg);
+                printUsage();
+                exit(1);
+            }
+
+            const char* operand = argv[argIndex + 1];
+            if (strcmp("--repeat", arg) == 0)
+            {
+                option.repeatCount = atoi(operand);
+                if (option.repeatCount < 1)
+                {
+                    printf("Invalid repeat count: %s\n", operand);
+                    exit(1);
+                }
+            }
+            else
+            {
+                option.traceFileName = operand;
+                option.profile = true;
+            }
+            argIndex += 2;
+        }
         else if ((strcmp("--help", arg) == 0) || (strcmp("-h", arg) == 0))
         {
             printUsage();
@@ -71,10 +137,9 @@ Options parseOption(int argc, char* argv[])
     return option;
 }
 
-int main(int argc, char* argv[])
+// Replay the record once, adding the time every call took to `profile` unless it is null
+static void replay(const Options& options, CallProfile* profile)
 {
-    Options options = parseOption(argc, argv);
-
     SlangRecord::RecordFileProcessor recordFileProcessor(options.recordFileName);
 
     Slang::String jsonPath = Slang::Path::replaceExt(options.recordFileName, "json");
@@ -95,12 +160,124 @@ int main(int argc, char* argv[])
 
     recordFileProcessor.addDecoder(&decoder);
 
+    const double frequency = double(Slang::Process::getClockFrequency());
+    const uint64_t replayStartTick = Slang::Process::getClockTick();
     while (true)
     {
+        const uint64_t startTick = Slang::Process::getClockTick();
         if (!recordFileProcessor.processNextBlock())
         {
             break;
         }
+
+        if (profile)
+        {
+            const double time = double(Slang::Process::getClockTick() - startTick) / frequency;
+            const SlangRecord::ApiCallId callId = recordFileProcessor.getLastCallId();
+
+            CallProfile::CallStats& stats = profile->stats[callId];
+            stats.count++;
+            stats.totalTime += time;
+            stats.maxTime = std::max(stats.maxTime, time);
+
+            if (options.traceFileName.getLength())
+            {
+                profile->traceEvents.add(
+                    {SlangRecord::getApiCallName(callId),
+                     double(startTick - profile->startTick) / frequency,
+                     time});
+            }
+        }
+    }
+
+    if (profile)
+    {
+        const double time = double(Slang::Process::getClockTick() - replayStartTick) / frequency;
+        profile->replayTimes.add(time);
+        if (options.traceFileName.getLength())
+        {
+            profile->traceEvents.add(
+                {"Replay", double(replayStartTick - profile->startTick) / frequency, time});
+        }
+    }
+}
+
+static void printProfile(const CallProfile& profile)
+{
+    // The calls that took longest in total first
+    Slang::List<SlangRecord::ApiCallId> callIds;
+    for (const auto& [callId, _] : profile.stats)
+    {
+        callIds.add(callId);
+    }
+    callIds.stableSort(
+        [&](SlangRecord::ApiCallId a, SlangRecord::ApiCallId b)
+        { return profile.stats.getValue(a).totalTime > profile.stats.getValue(b).totalTime; });
+
+    printf("%-56s %8s %12s %12s %12s\n", "Call", "Count", "Total ms", "Mean ms", "Max ms");
+    for (auto callId : callIds)
+    {
+        const CallProfile::CallStats& stats = profile.stats.getValue(callId);
+        printf(
+            "%-56s %8u %12.3f %12.3f %12.3f\n",
+            SlangRecord::getApiCallName(callId),
+            stats.count,
+            stats.totalTime * 1000.0,
+            stats.totalTime * 1000.0 / stats.count,
+            stats.maxTime * 1000.0);
+    }
+
+    printf("\n");
+    for (Slang::Index i = 0; i < profile.replayTimes.getCount(); ++i)
+    {
+        printf("Replay %d: %.3f ms\n", int(i + 1), profile.replayTimes[i] * 1000.0);
+    }
+}
+
+static SlangResult writeTrace(const CallProfile& profile, const Slang::String& fileName)
+{
+    Slang::StringBuilder builder;
+    builder << "{\"traceEvents\":[\n";
+    for (Slang::Index i = 0; i < profile.traceEvents.getCount(); ++i)
+    {
+        const CallProfile::TraceEvent& event = profile.traceEvents[i];
+        builder << "{\"name\":\"" << event.name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":1"
+                << ",\"ts\":" << event.startTime * 1000000.0
+                << ",\"dur\":" << event.duration * 1000000.0 << "}";
+        builder << (i + 1 < profile.traceEvents.getCount() ? ",\n" : "\n");
+    }
+    builder << "]}\n";
+    return Slang::File::writeAllText(fileName, builder);
+}
+
+int main(int argc, char* argv[])
+{
+    Options options = parseOption(argc, argv);
+
+    // Converting to JSON gives the same file every time, so there is nothing to repeat
+    if (options.convertToJson)
+    {
+        replay(options, nullptr);
+        return 0;
+    }
+
+    CallProfile profile;
+    profile.startTick = Slang::Process::getClockTick();
+    for (int i = 0; i < options.repeatCount; ++i)
+    {
+        replay(options, options.profile ? &profile : nullptr);
+    }
+
+    if (options.profile)
+    {
+        printProfile(profile);
+    }
+
+    if (options.traceFileName.getLength() &&
+        SLANG_FAILED(writeTrace(profile, options.traceFileName)))
+    {
+        printf("Failed to write trace file %s\n", options.traceFileName.getBuffer());
+        return 1;
     }
     return 0;
 }
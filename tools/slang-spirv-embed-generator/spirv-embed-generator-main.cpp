@@ -35,105 +35,6 @@ String dictToPerfectHash(
     return perfectHashToEmbeddableCpp(hashParams, type, funcName, values);
 }
 
-//
-// Go from a dictionary to a C++ embedding of switch table
-//
-template<typename K, typename V, typename F1, typename F2>
-void dictToSwitch(
-    const Dictionary<K, V>& dict,
-    const char* funName,
-    const char* keyType,
-    const char* valueType,
-    const char* unpackKey,
-    const F1 keyToString,
-    const F2 valueToAssignmentString,
-    WriterHelper& w)
-{
-    const auto line = [&](const auto& l)
-    {
-        w.put(l);
-        w.put("\n");
-    };
-
-    w.print("static bool %s(const %s& k, %s& v)\n", funName, keyType, valueType);
-    line("{");
-    w.print("    switch(%s)\n", unpackKey);
-    line("    {");
-    for (const auto& [k, v] : dict)
-    {
-        const auto kStr = keyToString(k);
-        const auto vStr = valueToAssignmentString(v);
-        w.print(
-            "        case %s:\n"
-            "        {\n"
-            "            %s;\n"
-            "            return true;\n"
-            "        }\n",
-            kStr.getBuffer(),
-            vStr.getBuffer());
-    }
-    line("        default: return false;");
-    line("    }");
-    line("}");
-    line("");
-}
-
-//
-// Go from a dictionary to a C++ embedding of switch table, specific to the
-// two-level table of a QualifiedEnumValue
-//
-template<typename V, typename F>
-void qualifiedEnumValueNameSwitch(
-    const Dictionary<Slang::SPIRVCoreGrammarInfo::QualifiedEnumValue, V>& dict,
-    const char* funName,
-    const char* keyType,
-    const char* valueType,
-    const char* unpackKey1,
-    const F valueToAssignmentString,
-    WriterHelper& w)
-{
-    const auto line = [&](const auto& l)
-    {
-        w.put(l);
-        w.put("\n");
-    };
-
-    using K1 = Slang::SPIRVCoreGrammarInfo::OperandKind;
-    using K2 = SpvWord;
-    Dictionary<K1, Dictionary<K2, V>> stepDict;
-    for (const auto& [k, v] : dict)
-    {
-        const auto& [k1, k2] = k;
-        stepDict[k1][k2] = v;
-    }
-
-    w.print("static bool %s(const %s& k, %s& v)\n", funName, keyType, valueType);
-    line("{");
-    line("    const auto& [k1, k2] = k;");
-    w.print("    switch(%s)\n", unpackKey1);
-    line("    {");
-    for (const auto& [k1, inner] : stepDict)
-    {
-        const auto k1Str = String(k1.index);
-        w.print("        case %s:\n", k1Str.getBuffer());
-
-        line("        switch(k2)");
-        line("        {");
-        for (const auto& [k2, v] : inner)
-        {
-            const auto k2Str = String(k2);
-            const auto vStr = valueToAssignmentString(v);
-            w.print("            case %s: %s; return true;\n", k2Str.getBuffer(), vStr.getBuffer());
-        }
-        line("            default: return false;");
-        line("        }");
-    }
-    line("        default: return false;");
-    line("    }");
-    line("}");
-    line("");
-}
-
 static const char* opClassToString(Slang::SPIRVCoreGrammarInfo::OpInfo::Class c)
 {
     switch (c)
@@ -172,6 +73,207 @@ static const char* opClassToString(Slang::SPIRVCoreGrammarInfo::OpInfo::Class c)
     }
 }
 
+//
+// Write the instructions as a table ordered by opcode, which is searched for both their
+// information and their names. The operand types of all of them are in a single array.
+//
+static void writeOpTable(const SPIRVCoreGrammarInfo& info, WriterHelper& w)
+{
+    List<SpvOp> ops;
+    for (const auto& [op, opInfo] : info.opInfos.dict)
+        ops.add(op);
+    ops.sort();
+
+    List<Index> operandTypesOffsets;
+    Index operandTypeCount = 0;
+    w.put("static const OperandKind kOperandTypes[] = {\n");
+    for (const auto op : ops)
+    {
+        const auto& opInfo = info.opInfos.dict.getValue(op);
+        operandTypesOffsets.add(operandTypeCount);
+        if (!opInfo.numOperandTypes)
+            continue;
+        w.put("   ");
+        for (Index o = 0; o < opInfo.numOperandTypes; ++o)
+            w.print(" {%d},", int(opInfo.operandTypes[o].index));
+        w.put("\n");
+        operandTypeCount += opInfo.numOperandTypes;
+    }
+    w.put("};\n\n");
+
+    w.put("struct OpEntry\n");
+    w.put("{\n");
+    w.put("    SpvOp op;\n");
+    w.put("    const char* name;\n");
+    w.put("    Index nameLength;\n");
+    w.put("    SPIRVCoreGrammarInfo::OpInfo info;\n");
+    w.put("};\n\n");
+
+    w.put("static const OpEntry kOps[] = {\n");
+    for (Index i = 0; i < ops.getCount(); ++i)
+    {
+        const auto& opInfo = info.opInfos.dict.getValue(ops[i]);
+        const String name = info.opNames.dict.getValue(ops[i]);
+        const String operandTypes = opInfo.numOperandTypes
+                                        ? "kOperandTypes + " + String(operandTypesOffsets[i])
+                                        : String("nullptr");
+        const String maxOperandCount = opInfo.maxOperandCount == 0xffff
+                                           ? String("0xffff")
+                                           : String(opInfo.maxOperandCount);
+        w.print(
+            "    {static_cast<SpvOp>(%d), \"%s\", %d, {SPIRVCoreGrammarInfo::OpInfo::%s, %d, %d, "
+            "%d, %s, %d, %s}},\n",
+            int(ops[i]),
+            name.getBuffer(),
+            int(name.getLength()),
+            opClassToString(opInfo.class_),
+            int(opInfo.resultTypeIndex),
+            int(opInfo.resultIdIndex),
+            int(opInfo.minOperandCount),
+            maxOperandCount.getBuffer(),
+            int(opInfo.numOperandTypes),
+            operandTypes.getBuffer());
+    }
+    w.put("};\n\n");
+
+    w.put("static const OpEntry* findOp(SpvOp op)\n");
+    w.put("{\n");
+    w.put("    const OpEntry* const end = kOps + SLANG_COUNT_OF(kOps);\n");
+    w.put("    const OpEntry* const found = std::lower_bound(\n");
+    w.put("        kOps,\n");
+    w.put("        end,\n");
+    w.put("        op,\n");
+    w.put("        [](const OpEntry& e, SpvOp o) { return e.op < o; });\n");
+    w.put("    return (found != end && found->op == op) ? found : nullptr;\n");
+    w.put("}\n\n");
+
+    w.put("static bool getOpInfo(const SpvOp& k, SPIRVCoreGrammarInfo::OpInfo& v)\n");
+    w.put("{\n");
+    w.put("    const OpEntry* const entry = findOp(k);\n");
+    w.put("    if (!entry)\n");
+    w.put("        return false;\n");
+    w.put("    v = entry->info;\n");
+    w.put("    return true;\n");
+    w.put("}\n\n");
+
+    w.put("static bool getOpName(const SpvOp& k, UnownedStringSlice& v)\n");
+    w.put("{\n");
+    w.put("    const OpEntry* const entry = findOp(k);\n");
+    w.put("    if (!entry)\n");
+    w.put("        return false;\n");
+    w.put("    v = UnownedStringSlice(entry->name, entry->nameLength);\n");
+    w.put("    return true;\n");
+    w.put("}\n\n");
+}
+
+//
+// Write the names of the enumerants of every operand kind as a table ordered by kind and
+// value
+//
+static void writeEnumNameTable(const SPIRVCoreGrammarInfo& info, WriterHelper& w)
+{
+    using QualifiedEnumValue = SPIRVCoreGrammarInfo::QualifiedEnumValue;
+
+    List<QualifiedEnumValue> keys;
+    for (const auto& [k, name] : info.allEnumNames.dict)
+        keys.add(k);
+    keys.sort(
+        [](const QualifiedEnumValue& a, const QualifiedEnumValue& b)
+        {
+            return a.kind.index < b.kind.index ||
+                   (a.kind.index == b.kind.index && a.value < b.value);
+        });
+
+    w.put("struct EnumNameEntry\n");
+    w.put("{\n");
+    w.put("    uint8_t kind;\n");
+    w.put("    SpvWord value;\n");
+    w.put("    const char* name;\n");
+    w.put("    Index nameLength;\n");
+    w.put("};\n\n");
+
+    w.put("static const EnumNameEntry kEnumNames[] = {\n");
+    for (const auto& k : keys)
+    {
+        const String name = info.allEnumNames.dict.getValue(k);
+        w.print(
+            "    {%d, %uu, \"%s\", %d},\n",
+            int(k.kind.index),
+            unsigned(k.value),
+            name.getBuffer(),
+            int(name.getLength()));
+    }
+    w.put("};\n\n");
+
+    w.put("static bool getQualifiedEnumName(const QualifiedEnumValue& k, UnownedStringSlice& v)\n");
+    w.put("{\n");
+    w.put("    const EnumNameEntry* const end = kEnumNames + SLANG_COUNT_OF(kEnumNames);\n");
+    w.put("    const EnumNameEntry* const found = std::lower_bound(\n");
+    w.put("        kEnumNames,\n");
+    w.put("        end,\n");
+    w.put("        k,\n");
+    w.put("        [](const EnumNameEntry& e, const QualifiedEnumValue& q)\n");
+    w.put("        {\n");
+    w.put("            return e.kind < q.kind.index ||\n");
+    w.put("                   (e.kind == q.kind.index && e.value < q.value);\n");
+    w.put("        });\n");
+    w.put("    if (found == end || found->kind != k.kind.index || found->value != k.value)\n");
+    w.put("        return false;\n");
+    w.put("    v = UnownedStringSlice(found->name, found->nameLength);\n");
+    w.put("    return true;\n");
+    w.put("}\n\n");
+}
+
+//
+// Write the names of the operand kinds, and the kinds underneath the Id ones, as arrays
+// indexed by kind
+//
+static void writeOperandKindTables(const SPIRVCoreGrammarInfo& info, WriterHelper& w)
+{
+    using OperandKind = SPIRVCoreGrammarInfo::OperandKind;
+    const Index kindCount = info.operandKindNames.dict.getCount();
+
+    w.put("static const char* const kOperandKindNames[] = {\n");
+    for (Index i = 0; i < kindCount; ++i)
+    {
+        UnownedStringSlice name;
+        if (info.operandKindNames.dict.tryGetValue(OperandKind{uint8_t(i)}, name))
+            w.print("    \"%s\",\n", String(name).getBuffer());
+        else
+            w.put("    nullptr,\n");
+    }
+    w.put("};\n\n");
+
+    w.put("static bool getOperandKindName(const OperandKind& k, UnownedStringSlice& v)\n");
+    w.put("{\n");
+    w.put("    if (k.index >= SLANG_COUNT_OF(kOperandKindNames) || !kOperandKindNames[k.index])\n");
+    w.put("        return false;\n");
+    w.put("    v = UnownedStringSlice(kOperandKindNames[k.index]);\n");
+    w.put("    return true;\n");
+    w.put("}\n\n");
+
+    // 0xff marks the kinds which aren't Ids of another kind
+    w.put("static const uint8_t kOperandKindUnderneathIds[] = {\n");
+    for (Index i = 0; i < kindCount; ++i)
+    {
+        OperandKind underneath;
+        if (info.operandKindUnderneathIds.dict.tryGetValue(OperandKind{uint8_t(i)}, underneath))
+            w.print("    %d,\n", int(underneath.index));
+        else
+            w.put("    0xff,\n");
+    }
+    w.put("};\n\n");
+
+    w.put("static bool getOperandKindUnderneathId(const OperandKind& k, OperandKind& v)\n");
+    w.put("{\n");
+    w.put("    if (k.index >= SLANG_COUNT_OF(kOperandKindUnderneathIds) ||\n");
+    w.put("        kOperandKindUnderneathIds[k.index] == 0xff)\n");
+    w.put("        return false;\n");
+    w.put("    v = OperandKind{kOperandKindUnderneathIds[k.index]};\n");
+    w.put("    return true;\n");
+    w.put("}\n\n");
+}
+
 //
 // Write a C++ embedding of the SPIRVCoreGrammarInfo struct
 //
@@ -197,6 +299,9 @@ void writeInfo(const char* const outCppPath, const SPIRVCoreGrammarInfo& info)
     line("");
     line("#include \"core/slang-smart-pointer.h\"");
     line("#include \"compiler-core/slang-spirv-core-grammar.h\"");
+    line("");
+    line("#include <algorithm>");
+    line("");
     line("namespace Slang");
     line("{");
     line("using OperandKind = SPIRVCoreGrammarInfo::OperandKind;");
@@ -257,53 +362,8 @@ void writeInfo(const char* const outCppPath, const SPIRVCoreGrammarInfo& info)
 
     {
         memberAssignments.add("info->opInfos.embedded = &getOpInfo;");
-        dictToSwitch(
-            info.opInfos.dict,
-            "getOpInfo",
-            "SpvOp",
-            "SPIRVCoreGrammarInfo::OpInfo",
-            "k",
-            [&](SpvOp o) { return "Spv" + String(info.opNames.dict.getValue(o)); },
-            [](const Slang::SPIRVCoreGrammarInfo::OpInfo& i)
-            {
-                const char* classStr = opClassToString(i.class_);
-                String ret;
-                if (i.numOperandTypes)
-                {
-                    ret.append("const static OperandKind operandTypes[] = {");
-                    String operandTypes;
-                    for (Index o = 0; o < i.numOperandTypes; ++o)
-                    {
-                        if (o != 0)
-                            ret.append(", ");
-                        ret.append("{" + String(i.operandTypes[o].index) + "}");
-                    }
-                    ret.append("};\n            ");
-                }
-                ret.append(
-                    String("v = {SPIRVCoreGrammarInfo::OpInfo::") + classStr + ", " +
-                    String(i.resultTypeIndex) + ", " + String(i.resultIdIndex) + ", " +
-                    String(i.minOperandCount) + ", " +
-                    (i.maxOperandCount == 0xffff ? String("0xffff") : String(i.maxOperandCount)) +
-                    ", " + String(i.numOperandTypes) + ", " +
-                    (i.numOperandTypes ? "operandTypes" : "nullptr") + "}");
-                return ret;
-            },
-            w);
-    }
-
-    {
         memberAssignments.add("info->opNames.embedded = &getOpName;");
-        dictToSwitch(
-            info.opNames.dict,
-            "getOpName",
-            "SpvOp",
-            "UnownedStringSlice",
-            "k",
-            [&](SpvOp o) { return "Spv" + String(info.opNames.dict.getValue(o)); },
-            [](const UnownedStringSlice& i)
-            { return "v = UnownedStringSlice{\"" + String(i) + "\"}"; },
-            w);
+        writeOpTable(info, w);
     }
 
     {
@@ -364,44 +424,14 @@ void writeInfo(const char* const outCppPath, const SPIRVCoreGrammarInfo& info)
 
     {
         memberAssignments.add("info->allEnumNames.embedded = &getQualifiedEnumName;");
-        qualifiedEnumValueNameSwitch(
-            info.allEnumNames.dict,
-            "getQualifiedEnumName",
-            "QualifiedEnumValue",
-            "UnownedStringSlice",
-            "k1.index",
-            [](const UnownedStringSlice& i)
-            { return "v = UnownedStringSlice{\"" + String(i) + "\"}"; },
-            w);
+        writeEnumNameTable(info, w);
     }
 
     {
         memberAssignments.add("info->operandKindNames.embedded = &getOperandKindName;");
-        dictToSwitch(
-            info.operandKindNames.dict,
-            "getOperandKindName",
-            "OperandKind",
-            "UnownedStringSlice",
-            "k.index",
-            [&](Slang::SPIRVCoreGrammarInfo::OperandKind o) { return String(o.index); },
-            [](const UnownedStringSlice& i)
-            { return "v = UnownedStringSlice{\"" + String(i) + "\"}"; },
-            w);
-    }
-
-    {
         memberAssignments.add(
             "info->operandKindUnderneathIds.embedded = &getOperandKindUnderneathId;");
-        dictToSwitch(
-            info.operandKindUnderneathIds.dict,
-            "getOperandKindUnderneathId",
-            "OperandKind",
-            "OperandKind",
-            "k.index",
-            [](Slang::SPIRVCoreGrammarInfo::OperandKind o) { return String(o.index); },
-            [](Slang::SPIRVCoreGrammarInfo::OperandKind i)
-            { return "v = OperandKind{" + String(i.index) + "}"; },
-            w);
+        writeOperandKindTables(info, w);
     }
 
     //
@@ -154,6 +154,46 @@ static bool _isSubCommand(const char* arg)
         {
             optionsOut->apiOnly = true;
         }
+        else if (strcmp(arg, "-bench") == 0)
+        {
+            optionsOut->runBenchmarks = true;
+        }
+        else if (strcmp(arg, "-timing-report") == 0)
+        {
+            if (argCursor == argEnd)
+            {
+                stdError.print("error: expected operand for '%s'\n", arg);
+                return SLANG_FAIL;
+            }
+            optionsOut->timingReportPath = *argCursor++;
+        }
+        else if (strcmp(arg, "-timing-baseline") == 0)
+        {
+            if (argCursor == argEnd)
+            {
+                stdError.print("error: expected operand for '%s'\n", arg);
+                return SLANG_FAIL;
+            }
+            optionsOut->timingBaselinePath = *argCursor++;
+        }
+        else if (strcmp(arg, "-timing-threshold") == 0)
+        {
+            if (argCursor == argEnd)
+            {
+                stdError.print("error: expected operand for '%s'\n", arg);
+                return SLANG_FAIL;
+            }
+            optionsOut->timingThreshold = atof(*argCursor++);
+        }
+        else if (strcmp(arg, "-schedule-timing") == 0)
+        {
+            if (argCursor == argEnd)
+            {
+                stdError.print("error: expected operand for '%s'\n", arg);
+                return SLANG_FAIL;
+            }
+            optionsOut->scheduleTimingPath = *argCursor++;
+        }
         else if (strcmp(arg, "-verbose-paths") == 0)
         {
             optionsOut->verbosePaths = true;
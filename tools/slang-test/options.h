@@ -63,6 +63,23 @@ struct Options
     // When true only tests that use an api that matches the enabledApis flags will run
     bool apiOnly = false;
 
+    // When true only the benchmarks of the unit test module are run (see SLANG_UNIT_BENCHMARK)
+    bool runBenchmarks = false;
+
+    // If set, the time and memory used by every test are written to this file as JSON
+    Slang::String timingReportPath;
+
+    // If set, the times of the tests are compared with this report, failing the run if any test
+    // got slower by more than timingThreshold
+    Slang::String timingBaselinePath;
+
+    // How much slower than in the baseline a test may get, as a fraction of its baseline time
+    double timingThreshold = 0.25;
+
+    // If set, a timing report from an earlier run, used to start the tests that took longest
+    // first when tests run in parallel
+    Slang::String scheduleTimingPath;
+
     // Use verbose paths
     bool verbosePaths = false;
 
@@ -2362,6 +2362,303 @@ TestResult runCompile(TestContext* context, TestInput& input)
     return TestResult::Pass;
 }
 
+/// Measures of the size of the code generated for a target, which can be compared with a baseline
+struct CodeSizeMetrics
+{
+    Index functionCount = 0;    ///< Functions defined in the code
+    Index instructionCount = 0; ///< Instructions in the bodies of the functions
+    Index registerCount = -1;   ///< Registers declared, or -1 if the target doesn't declare them
+
+    String toString() const
+    {
+        StringBuilder buf;
+        buf << "functions = " << functionCount << "\n";
+        buf << "instructions = " << instructionCount << "\n";
+        if (registerCount >= 0)
+        {
+            buf << "registers = " << registerCount << "\n";
+        }
+        return buf.produceString();
+    }
+};
+
+/// The first token of line, and in rest what follows it
+static UnownedStringSlice _splitFirstToken(const UnownedStringSlice& line, UnownedStringSlice& rest)
+{
+    const Index end = line.indexOf(' ');
+    if (end < 0)
+    {
+        rest = UnownedStringSlice();
+        return line;
+    }
+    rest = line.tail(end + 1).trim();
+    return line.head(end);
+}
+
+static void _calcSPIRVCodeSize(const UnownedStringSlice& text, CodeSizeMetrics& outMetrics)
+{
+    List<UnownedStringSlice> lines;
+    StringUtil::calcLines(text, lines);
+
+    bool isInFunction = false;
+    for (auto line : lines)
+    {
+        line = line.trim();
+        // Skip the result id of instructions that have one
+        if (line.startsWith(toSlice("%")))
+        {
+            const Index assignIndex = line.indexOf('=');
+            if (assignIndex < 0)
+            {
+                continue;
+            }
+            line = line.tail(assignIndex + 1).trim();
+        }
+
+        UnownedStringSlice operands;
+        const UnownedStringSlice opName = _splitFirstToken(line, operands);
+        if (!opName.startsWith(toSlice("Op")))
+        {
+            continue;
+        }
+        if (opName == toSlice("OpFunction"))
+        {
+            isInFunction = true;
+            outMetrics.functionCount++;
+        }
+        else if (opName == toSlice("OpFunctionEnd"))
+        {
+            isInFunction = false;
+        }
+        else if (
+            isInFunction && opName != toSlice("OpFunctionParameter") &&
+            opName != toSlice("OpLabel") && opName != toSlice("OpLine") &&
+            opName != toSlice("OpNoLine") && operands.indexOf(toSlice(" Debug")) < 0)
+        {
+            outMetrics.instructionCount++;
+        }
+    }
+}
+
+static void _calcDXILCodeSize(const UnownedStringSlice& text, CodeSizeMetrics& outMetrics)
+{
+    List<UnownedStringSlice> lines;
+    StringUtil::calcLines(text, lines);
+
+    bool isInFunction = false;
+    for (auto line : lines)
+    {
+        line = line.trim();
+        if (line.startsWith(toSlice("define ")))
+        {
+            isInFunction = true;
+            outMetrics.functionCount++;
+        }
+        else if (line == toSlice("}"))
+        {
+            isInFunction = false;
+        }
+        else if (isInFunction && line.getLength() && !line.startsWith(toSlice(";")))
+        {
+            // Labels of basic blocks and debug information aren't instructions
+            UnownedStringSlice rest;
+            if (!_splitFirstToken(line, rest).endsWith(toSlice(":")) &&
+                line.indexOf(toSlice("@llvm.dbg.")) < 0)
+            {
+                outMetrics.instructionCount++;
+            }
+        }
+    }
+}
+
+static void _calcPTXCodeSize(const UnownedStringSlice& text, CodeSizeMetrics& outMetrics)
+{
+    List<UnownedStringSlice> lines;
+    StringUtil::calcLines(text, lines);
+
+    outMetrics.registerCount = 0;
+    Index depth = 0;
+    for (auto line : lines)
+    {
+        line = line.trim();
+        if (line.startsWith(toSlice("//")))
+        {
+            continue;
+        }
+        if (line.startsWith(toSlice(".entry ")) || line.startsWith(toSlice(".visible .entry ")) ||
+            line.startsWith(toSlice(".func ")) || line.startsWith(toSlice(".visible .func ")))
+        {
+            outMetrics.functionCount++;
+        }
+        else if (line.startsWith(toSlice("{")))
+        {
+            depth++;
+        }
+        else if (line.startsWith(toSlice("}")))
+        {
+            depth--;
+        }
+        else if (depth > 0 && line.startsWith(toSlice(".reg ")))
+        {
+            // A declaration such as `.reg .f32 %f<12>;` declares 12 registers
+            const Index countStart = line.indexOf('<');
+            const Index countEnd = line.indexOf('>');
+            Int count = 1;
+            if (countStart >= 0 && countEnd > countStart)
+            {
+                const Index length = countEnd - countStart - 1;
+                StringUtil::parseInt(line.subString(countStart + 1, length), count);
+            }
+            outMetrics.registerCount += count;
+        }
+        else if (depth > 0 && line.endsWith(toSlice(";")) && !line.startsWith(toSlice(".")))
+        {
+            outMetrics.instructionCount++;
+        }
+    }
+}
+
+/// Reads a `name = value` per line, as written by CodeSizeMetrics::toString
+static void _parseCodeSizeMetrics(
+    const UnownedStringSlice& text,
+    OrderedDictionary<String, Int>& outMetrics)
+{
+    List<UnownedStringSlice> lines;
+    StringUtil::calcLines(text, lines);
+    for (auto line : lines)
+    {
+        const Index assignIndex = line.indexOf('=');
+        Int value = 0;
+        if (assignIndex >= 0 &&
+            SLANG_SUCCEEDED(StringUtil::parseInt(line.tail(assignIndex + 1).trim(), value)))
+        {
+            outMetrics[String(line.head(assignIndex).trim())] = value;
+        }
+    }
+}
+
+TestResult runCodeSizeTest(TestContext* context, TestInput& input)
+{
+    // How much larger than its baseline a metric can be before the test fails, as a fraction
+    const double kCodeSizeTolerance = 0.02;
+
+    auto outputStem = input.outputStem;
+
+    CommandLine cmdLine;
+    cmdLine.addArg(input.filePath);
+    for (auto arg : input.testOptions->args)
+    {
+        cmdLine.addArg(arg);
+    }
+
+    if (SLANG_FAILED(_initSlangCompiler(context, cmdLine)))
+    {
+        return TestResult::Ignored;
+    }
+
+    ExecuteResult exeRes;
+    TEST_RETURN_ON_DONE(spawnAndWait(context, outputStem, input.spawnType, cmdLine, exeRes));
+    if (context->isCollectingRequirements())
+    {
+        return TestResult::Pass;
+    }
+
+    auto reporter = context->getTestReporter();
+    if (exeRes.resultCode != 0)
+    {
+        reporter->message(TestMessageType::TestFailure, getOutput(exeRes));
+        return TestResult::Fail;
+    }
+
+    SlangCompileTarget target = SLANG_TARGET_UNKNOWN;
+    {
+        const auto& args = input.testOptions->args;
+        const Index targetIndex = args.indexOf("-target");
+        if (targetIndex != Index(-1) && targetIndex + 1 < args.getCount())
+        {
+            target =
+                TypeTextUtil::findCompileTargetFromName(args[targetIndex + 1].getUnownedSlice());
+        }
+    }
+
+    CodeSizeMetrics metrics;
+    const auto code = exeRes.standardOutput.getUnownedSlice();
+    switch (target)
+    {
+    case SLANG_SPIRV_ASM:
+        _calcSPIRVCodeSize(code, metrics);
+        break;
+    case SLANG_DXIL_ASM:
+        _calcDXILCodeSize(code, metrics);
+        break;
+    case SLANG_PTX:
+        _calcPTXCodeSize(code, metrics);
+        break;
+    default:
+        reporter->message(
+            TestMessageType::RunError,
+            "CODE_SIZE tests need a target of spirv-asm, dxil-asm or ptx");
+        return TestResult::Fail;
+    }
+
+    const String actualOutput = metrics.toString();
+
+    // Each test of a file has its own baseline, as they are for different targets. Without one
+    // the metrics are only written out, so they can be checked in as the baseline.
+    String expectedOutput;
+    if (SLANG_FAILED(Slang::File::readAllText(outputStem + ".expected", expectedOutput)))
+    {
+        reporter->messageFormat(
+            TestMessageType::Info,
+            "%s has no baseline, the metrics are written to .actual\n",
+            outputStem.getBuffer());
+        Slang::File::writeAllText(outputStem + ".actual", actualOutput);
+        return TestResult::Ignored;
+    }
+
+    OrderedDictionary<String, Int> expectedMetrics;
+    _parseCodeSizeMetrics(expectedOutput.getUnownedSlice(), expectedMetrics);
+    OrderedDictionary<String, Int> actualMetrics;
+    _parseCodeSizeMetrics(actualOutput.getUnownedSlice(), actualMetrics);
+
+    // Getting larger than the baseline fails, so changes that bloat the code are noticed. Getting
+    // smaller only reports that the baseline can be updated.
+    TestResult result = TestResult::Pass;
+    for (const auto& [name, expectedValue] : expectedMetrics)
+    {
+        const Int* actualValue = actualMetrics.tryGetValue(name);
+
+        const double limit = double(expectedValue) * (1.0 + kCodeSizeTolerance);
+        if (!actualValue || double(*actualValue) > limit)
+        {
+            reporter->messageFormat(
+                TestMessageType::TestFailure,
+                "%s: %s is %d, baseline is %d\n",
+                outputStem.getBuffer(),
+                name.getBuffer(),
+                int(actualValue ? *actualValue : -1),
+                int(expectedValue));
+            result = TestResult::Fail;
+        }
+        else if (double(*actualValue) < double(expectedValue) * (1.0 - kCodeSizeTolerance))
+        {
+            reporter->messageFormat(
+                TestMessageType::Info,
+                "%s: %s went down from %d to %d, the baseline can be updated\n",
+                outputStem.getBuffer(),
+                name.getBuffer(),
+                int(expectedValue),
+                int(*actualValue));
+        }
+    }
+
+    if (result == TestResult::Fail)
+    {
+        Slang::File::writeAllText(outputStem + ".actual", actualOutput);
+    }
+    return result;
+}
+
 TestResult runSimpleCompareCommandLineTest(TestContext* context, TestInput& input)
 {
     TestInput workInput(input);
@@ -3896,6 +4193,7 @@ static const TestCommandInfo s_testCommandInfos[] = {
     {"CPP_COMPILER_COMPILE", &runCPPCompilerCompile, RenderApiFlag::CPU},
     {"PERFORMANCE_PROFILE", &runPerformanceProfile, 0},
     {"COMPILE", &runCompile, 0},
+    {"CODE_SIZE", &runCodeSizeTest, 0},
     {"DOC", &runDocTest, 0},
     {"LANG_SERVER", &runLanguageServerTest, 0},
     {"EXECUTABLE", &runExecutableTest, RenderApiFlag::CPU}};
@@ -4391,6 +4689,68 @@ void getFilesInDirectory(String directoryPath, List<String>& files)
     }
 }
 
+/// The file of the test named `testName`. The name of a test is the path of its file, then a
+/// dot and the index of the test in the file unless it is the first, then anything else after a
+/// space (see `_runTestsOnFile`).
+static UnownedStringSlice _getTestFilePath(UnownedStringSlice testName)
+{
+    const Index spaceIndex = testName.indexOf(' ');
+    if (spaceIndex >= 0)
+        testName = testName.head(spaceIndex);
+
+    const Index dotIndex = testName.lastIndexOf('.');
+    if (dotIndex >= 0)
+    {
+        const UnownedStringSlice suffix = testName.tail(dotIndex + 1);
+        bool isIndex = suffix.getLength() > 0;
+        for (const char c : suffix)
+            isIndex = isIndex && CharUtil::isDigit(c);
+        if (isIndex)
+            testName = testName.head(dotIndex);
+    }
+    return testName;
+}
+
+/// Sort `ioItems` so that those that took longest in an earlier run come first, so that a long
+/// test started near the end doesn't keep the other threads waiting. `getTime` returns the time
+/// an item took, or a negative value if it isn't known, in which case the item is assumed to take
+/// the average time.
+template<typename T, typename GetTime>
+static void _sortLongestFirst(List<T>& ioItems, const GetTime& getTime)
+{
+    List<double> times;
+    double knownTotal = 0;
+    Index knownCount = 0;
+    for (const auto& item : ioItems)
+    {
+        const double time = getTime(item);
+        times.add(time);
+        if (time >= 0)
+        {
+            knownTotal += time;
+            knownCount++;
+        }
+    }
+    if (knownCount == 0)
+        return;
+
+    const double averageTime = knownTotal / double(knownCount);
+    List<Index> order;
+    for (Index i = 0; i < ioItems.getCount(); ++i)
+    {
+        if (times[i] < 0)
+            times[i] = averageTime;
+        order.add(i);
+    }
+    order.stableSort([&](Index a, Index b) { return times[a] > times[b]; });
+
+    List<T> sortedItems;
+    sortedItems.reserve(ioItems.getCount());
+    for (auto index : order)
+        sortedItems.add(_Move(ioItems[index]));
+    ioItems.swapWith(sortedItems);
+}
+
 template<typename F>
 void runTestsInParallel(TestContext* context, int count, const F& f)
 {
@@ -4473,6 +4833,14 @@ void runTestsInDirectory(TestContext* context, String directoryPath)
     }
     else
     {
+        _sortLongestFirst(
+            files,
+            [&](const String& file)
+            {
+                const double* time = context->historicalFileTimes.tryGetValue(file);
+                return time ? *time : -1.0;
+            });
+
         runTestsInParallel(
             context,
             (int)files.getCount(),
@@ -4561,6 +4929,11 @@ static SlangResult runUnitTestModule(
         auto testFunc = testModule->getTestFunc(i);
         auto testName = testModule->getTestName(i);
 
+        // Benchmarks are only run when asked for, and then nothing else is
+        const bool isBenchmark = UnownedStringSlice(testName).startsWith(kUnitBenchmarkPrefix);
+        if (isBenchmark != context->options.runBenchmarks)
+            continue;
+
         StringBuilder filePath;
         filePath << moduleName << "/" << testName << ".internal";
         auto command = filePath.produceString();
@@ -4643,6 +5016,14 @@ static SlangResult runUnitTestModule(
 
     if (useMultiThread)
     {
+        _sortLongestFirst(
+            tests,
+            [&](const TestItem& test)
+            {
+                const double* time = context->historicalTestTimes.tryGetValue(test.command);
+                return time ? *time : -1.0;
+            });
+
         runTestsInParallel(
             context,
             (int)tests.getCount(),
@@ -4786,6 +5167,20 @@ SlangResult innerMain(int argc, char** argv)
     // Set up the prelude/s
     TestToolUtil::setSessionDefaultPreludeFromExePath(argv[0], context.getSession());
 
+    if (options.scheduleTimingPath.getLength())
+    {
+        if (SLANG_FAILED(TestReporter::readTimingReport(
+                options.scheduleTimingPath,
+                context.historicalTestTimes)))
+        {
+            StdWriters::getError().print(
+                "warning: unable to read timing report '%s', tests run in the default order\n",
+                options.scheduleTimingPath.getBuffer());
+        }
+        for (const auto& [name, time] : context.historicalTestTimes)
+            context.historicalFileTimes[_getTestFilePath(name.getUnownedSlice())] += time;
+    }
+
     if (options.outputMode == TestOutputMode::TeamCity)
     {
         // On TeamCity CI there is an issue with unix/linux targets where test system may be
@@ -4859,9 +5254,11 @@ SlangResult innerMain(int argc, char** argv)
         context.setTestReporter(&reporter);
 
         reporter.m_dumpOutputOnFailure = options.dumpOutputOnFailure;
-        reporter.m_isVerbose = options.shouldBeVerbose;
+        // Benchmarks report their measurements as info messages
+        reporter.m_isVerbose = options.shouldBeVerbose || options.runBenchmarks;
         reporter.m_hideIgnored = options.hideIgnored;
 
+        if (!options.runBenchmarks)
         {
             TestReporter::SuiteScope suiteScope(&reporter, "tests");
             // Enumerate test files according to policy
@@ -4879,7 +5276,9 @@ SlangResult innerMain(int argc, char** argv)
             TestReporter::SuiteScope suiteScope(&reporter, "unit tests");
             TestReporter::set(&reporter);
 
-            const auto spawnType = context.getFinalSpawnType();
+            // Benchmarks run in process, so their measurements aren't skewed by the test server
+            const auto spawnType = options.runBenchmarks ? SpawnType::UseSharedLibrary
+                                                         : context.getFinalSpawnType();
 
             // Run the unit tests
             {
@@ -4932,7 +5331,28 @@ SlangResult innerMain(int argc, char** argv)
         }
 
         reporter.outputSummary();
-        return reporter.didAllSucceed() ? SLANG_OK : SLANG_FAIL;
+
+        if (options.timingReportPath.getLength() &&
+            SLANG_FAILED(reporter.writeTimingReport(options.timingReportPath)))
+        {
+            printf(
+                "error: unable to write timing report '%s'\n",
+                options.timingReportPath.getBuffer());
+            return SLANG_FAIL;
+        }
+
+        bool hasTimingRegression = false;
+        if (options.timingBaselinePath.getLength())
+        {
+            // Tests that take a few more milliseconds are mostly noise from the machine
+            const double kMinTimingIncrease = 0.05;
+            hasTimingRegression = reporter.compareTimingWithBaseline(
+                                      options.timingBaselinePath,
+                                      options.timingThreshold,
+                                      kMinTimingIncrease) != 0;
+        }
+
+        return (reporter.didAllSucceed() && !hasTimingRegression) ? SLANG_OK : SLANG_FAIL;
     }
 }
 
@@ -157,6 +157,11 @@ public:
     Slang::String dllDirectoryPath;
     Slang::String exePath;
 
+    /// Times in seconds of the tests, and of all the tests of each file, in the run given with
+    /// `-schedule-timing`. Empty if there is none.
+    Slang::Dictionary<Slang::String, double> historicalTestTimes;
+    Slang::Dictionary<Slang::String, double> historicalFileTimes;
+
     /// Timeout time for communication over connection.
     /// NOTE! If the timeout is hit, the connection will be destroyed, and then recreated.
     /// To test it, compile the core module, if it takes too much time, the core module will be
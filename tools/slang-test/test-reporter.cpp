@@ -1,13 +1,27 @@
 // test-reporter.cpp
 #include "test-reporter.h"
 
+#include "../../source/compiler-core/slang-json-rpc.h"
+#include "../../source/compiler-core/slang-json-value.h"
+#include "../../source/compiler-core/slang-source-loc.h"
+#include "../../source/core/slang-io.h"
 #include "../../source/core/slang-process-util.h"
+#include "../../source/core/slang-process.h"
+#include "../../source/core/slang-string-escape-util.h"
 #include "../../source/core/slang-string-util.h"
 
 #include <mutex>
 #include <stdio.h>
 #include <stdlib.h>
 
+#if SLANG_WINDOWS_FAMILY
+#include <windows.h>
+// Must come after windows.h
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
 using namespace Slang;
 
 /* static */ TestReporter* TestReporter::s_reporter = nullptr;
@@ -79,6 +93,27 @@ static void appendXmlEncode(const String& in, StringBuilder& out)
     }
 }
 
+/// The peak resident memory of the process so far in bytes, or 0 if it isn't available.
+static uint64_t _getPeakResidentMemory()
+{
+#if SLANG_WINDOWS_FAMILY
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        return 0;
+    return uint64_t(counters.PeakWorkingSetSize);
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+#if SLANG_APPLE_FAMILY
+    // Reported in bytes on macOS, and in kilobytes elsewhere
+    return uint64_t(usage.ru_maxrss);
+#else
+    return uint64_t(usage.ru_maxrss) * 1024;
+#endif
+#endif
+}
+
 TestReporter::TestReporter()
     : m_outputMode(TestOutputMode::Default)
 {
@@ -135,6 +170,9 @@ void TestReporter::startTest(const char* testName)
     m_currentInfo = TestInfo();
     m_currentInfo.name = testName;
     m_currentMessage.clear();
+
+    m_currentStartPeakMemory = _getPeakResidentMemory();
+    m_currentStartTick = Process::getClockTick();
 }
 
 void TestReporter::endTest()
@@ -143,6 +181,9 @@ void TestReporter::endTest()
     assert(m_inTest);
 
     m_currentInfo.message = m_currentMessage;
+    m_currentInfo.wallTime = double(Process::getClockTick() - m_currentStartTick) /
+                             double(Process::getClockFrequency());
+    m_currentInfo.peakMemoryIncrease = _getPeakResidentMemory() - m_currentStartPeakMemory;
 
     _addResult(m_currentInfo);
 
@@ -831,3 +872,112 @@ TestResult TestReporter::adjustResult(UnownedStringSlice testName, TestResult re
         result = TestResult::ExpectedFail;
     return result;
 }
+
+SlangResult TestReporter::writeTimingReport(const String& path)
+{
+    auto handler = StringEscapeUtil::getHandler(StringEscapeUtil::Style::JSON);
+
+    StringBuilder out;
+    out << "{\n";
+    out << "    \"version\": 1,\n";
+    out << "    \"tests\": [\n";
+    bool isFirst = true;
+    for (const auto& info : m_testInfos)
+    {
+        if (info.testResult == TestResult::Ignored)
+            continue;
+
+        if (!isFirst)
+            out << ",\n";
+        isFirst = false;
+
+        out << "        {\"name\": ";
+        StringEscapeUtil::appendQuoted(handler, info.name.getUnownedSlice(), out);
+        out << ", \"timeMs\": ";
+        out.append(info.wallTime * 1000.0, "%.3f");
+        out << ", \"peakMemoryIncreaseBytes\": " << info.peakMemoryIncrease << "}";
+    }
+    out << "\n    ]\n";
+    out << "}\n";
+    return File::writeAllText(path, out);
+}
+
+SlangResult TestReporter::readTimingReport(const String& path, Dictionary<String, double>& outTimes)
+{
+    String text;
+    SLANG_RETURN_ON_FAIL(File::readAllText(path, text));
+
+    SourceManager sourceManager;
+    sourceManager.initialize(nullptr, nullptr);
+    DiagnosticSink sink(&sourceManager, nullptr);
+    RefPtr<JSONContainer> container = new JSONContainer(&sourceManager);
+
+    JSONValue root;
+    SLANG_RETURN_ON_FAIL(JSONRPCUtil::parseJSON(text.getUnownedSlice(), container, &sink, root));
+    if (root.getKind() != JSONValue::Kind::Object)
+        return SLANG_FAIL;
+
+    const JSONValue tests =
+        container->findObjectValue(root, container->getKey(UnownedStringSlice("tests")));
+    if (tests.getKind() != JSONValue::Kind::Array)
+        return SLANG_FAIL;
+
+    const JSONKey nameKey = container->getKey(UnownedStringSlice("name"));
+    const JSONKey timeKey = container->getKey(UnownedStringSlice("timeMs"));
+    for (const auto& test : container->getArray(tests))
+    {
+        const JSONValue name = container->findObjectValue(test, nameKey);
+        const JSONValue time = container->findObjectValue(test, timeKey);
+        if (name.isValid() && time.isValid())
+            outTimes[container->getString(name)] = container->asFloat(time) / 1000.0;
+    }
+    return SLANG_OK;
+}
+
+Index TestReporter::compareTimingWithBaseline(
+    const String& path,
+    double threshold,
+    double minIncrease)
+{
+    Dictionary<String, double> baselineTimes;
+    if (SLANG_FAILED(readTimingReport(path, baselineTimes)))
+    {
+        messageFormat(
+            TestMessageType::RunError,
+            "unable to read timing baseline '%s'",
+            path.getBuffer());
+        return -1;
+    }
+
+    // A test that was retried is judged on its last run
+    Dictionary<String, double> times;
+    for (const auto& info : m_testInfos)
+    {
+        if (info.testResult != TestResult::Ignored)
+            times[info.name] = info.wallTime;
+    }
+
+    Index regressionCount = 0;
+    for (const auto& [name, time] : times)
+    {
+        const double* baselineTime = baselineTimes.tryGetValue(name);
+        if (!baselineTime || time - *baselineTime <= minIncrease ||
+            time <= *baselineTime * (1.0 + threshold))
+        {
+            continue;
+        }
+
+        if (regressionCount == 0)
+            printf("\ntests that got slower than in '%s':\n---\n", path.getBuffer());
+        printf(
+            "%s: %.1fms -> %.1fms (+%.0f%%)\n",
+            name.getBuffer(),
+            *baselineTime * 1000.0,
+            time * 1000.0,
+            (time / Math::Max(*baselineTime, 1e-9) - 1.0) * 100.0);
+        regressionCount++;
+    }
+    if (regressionCount)
+        printf("---\n");
+    return regressionCount;
+}
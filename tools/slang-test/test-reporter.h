@@ -30,6 +30,10 @@ public:
         Slang::String name;
         Slang::String message;      ///< Message that is specific for the testResult
         double executionTime = 0.0; ///< <= 0.0 if not defined. Time is in seconds.
+        double wallTime = 0.0;      ///< Time from the start to the end of the test in seconds
+        /// How much the test raised the peak resident memory of this process in bytes. Only
+        /// tests run in process contribute to it.
+        uint64_t peakMemoryIncrease = 0;
     };
 
     class TestScope
@@ -107,6 +111,23 @@ public:
 
     void outputSummary();
 
+    /// Write the time and memory used by every test that was run to `path` as JSON.
+    SlangResult writeTimingReport(const Slang::String& path);
+
+    /// Read the time of every test in a report written by `writeTimingReport`, in seconds.
+    static SlangResult readTimingReport(
+        const Slang::String& path,
+        Slang::Dictionary<Slang::String, double>& outTimes);
+
+    /// Compare the times of the tests that were run with a report written by
+    /// `writeTimingReport`, and report every test that got slower by more than `threshold` (a
+    /// fraction of its time in the baseline) and more than `minIncrease` seconds.
+    /// Returns the number of such tests, or -1 if the baseline can't be read.
+    Slang::Index compareTimingWithBaseline(
+        const Slang::String& path,
+        double threshold,
+        double minIncrease);
+
     SlangResult init(
         TestOutputMode outputMode,
         const Slang::HashSet<Slang::String>& expectedFailureList,
@@ -146,6 +167,8 @@ protected:
 
     Slang::StringBuilder m_currentMessage;
     TestInfo m_currentInfo;
+    uint64_t m_currentStartTick = 0;
+    uint64_t m_currentStartPeakMemory = 0;
     int m_numCurrentResults;
     int m_numFailResults;
 
@@ -0,0 +1,226 @@
+// unit-test-async-compile.cpp
+
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+using namespace Slang;
+
+namespace
+{
+
+// A scheduler that holds on to the tasks it is given until `runAll` is called.
+struct DeferredTaskScheduler : public slang::ITaskScheduler_Experimental
+{
+    SLANG_NO_THROW SlangResult SLANG_MCALL queryInterface(SlangUUID const& uuid, void** outObject)
+        SLANG_OVERRIDE
+    {
+        if (uuid == ISlangUnknown::getTypeGuid() ||
+            uuid == slang::ITaskScheduler_Experimental::getTypeGuid())
+        {
+            *outObject = static_cast<slang::ITaskScheduler_Experimental*>(this);
+            return SLANG_OK;
+        }
+        return SLANG_E_NO_INTERFACE;
+    }
+    // The scheduler lives on the stack, so there is no reference counting.
+    SLANG_NO_THROW uint32_t SLANG_MCALL addRef() SLANG_OVERRIDE { return 1; }
+    SLANG_NO_THROW uint32_t SLANG_MCALL release() SLANG_OVERRIDE { return 1; }
+
+    SLANG_NO_THROW void SLANG_MCALL scheduleTask(void (*task)(void* context), void* context)
+        SLANG_OVERRIDE
+    {
+        Task entry = {task, context};
+        m_tasks.add(entry);
+    }
+
+    void runAll()
+    {
+        for (auto& task : m_tasks)
+            task.func(task.context);
+        m_tasks.clear();
+    }
+
+    struct Task
+    {
+        void (*func)(void* context);
+        void* context;
+    };
+    List<Task> m_tasks;
+};
+
+} // namespace
+
+// Test that code can be generated asynchronously, and that a cancelled compile
+// produces no code.
+SLANG_UNIT_TEST(asyncCompile)
+{
+    const char* userSource = R"(
+        [shader("compute")]
+        [numthreads(1,1,1)]
+        void computeMain(uniform RWStructuredBuffer<float> buffer)
+        {
+            buffer[0] = sqrt(buffer[1]);
+        }
+        )";
+
+    auto globalSession = unitTestContext->slangGlobalSession;
+
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("sm_5_0");
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+
+    ComPtr<slang::ISession> session;
+    SLANG_CHECK_ABORT(
+        SLANG_SUCCEEDED(globalSession->createSession(sessionDesc, session.writeRef())));
+
+    ComPtr<slang::IBlob> diagnosticBlob;
+    auto module = session->loadModuleFromSourceString(
+        "m",
+        "m.slang",
+        userSource,
+        diagnosticBlob.writeRef());
+    SLANG_CHECK_ABORT(module != nullptr);
+
+    ComPtr<slang::IEntryPoint> entryPoint;
+    SLANG_CHECK_ABORT(
+        SLANG_SUCCEEDED(module->findEntryPointByName("computeMain", entryPoint.writeRef())));
+
+    slang::IComponentType* components[] = {module, entryPoint.get()};
+    ComPtr<slang::IComponentType> composedProgram;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(
+        session->createCompositeComponentType(components, 2, composedProgram.writeRef())));
+
+    ComPtr<slang::IComponentType> linkedProgram;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(composedProgram->link(linkedProgram.writeRef())));
+
+    ComPtr<slang::IComponentTypeAsync_Experimental> asyncProgram;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(linkedProgram->queryInterface(
+        slang::IComponentTypeAsync_Experimental::getTypeGuid(),
+        (void**)asyncProgram.writeRef())));
+
+    // A compile that is cancelled before it runs produces no code.
+    {
+        DeferredTaskScheduler scheduler;
+
+        ComPtr<slang::ICompileTask_Experimental> task;
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(
+            asyncProgram->getEntryPointCodeAsync(0, 0, &scheduler, task.writeRef())));
+        SLANG_CHECK(!task->isComplete());
+
+        task->cancel();
+        scheduler.runAll();
+        SLANG_CHECK(task->isComplete());
+
+        ComPtr<slang::IBlob> code;
+        SLANG_CHECK(task->waitForResult(code.writeRef(), nullptr) == SLANG_E_ABORT);
+        SLANG_CHECK(code == nullptr);
+    }
+
+    // A compile on a thread created by the task produces the same code as the
+    // blocking call.
+    {
+        ComPtr<slang::ICompileTask_Experimental> task;
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(
+            asyncProgram->getEntryPointCodeAsync(0, 0, nullptr, task.writeRef())));
+
+        ComPtr<slang::IBlob> code;
+        SLANG_CHECK_ABORT(
+            SLANG_SUCCEEDED(task->waitForResult(code.writeRef(), diagnosticBlob.writeRef())));
+        SLANG_CHECK(task->isComplete());
+
+        ComPtr<slang::IBlob> expectedCode;
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(linkedProgram->getEntryPointCode(
+            0,
+            0,
+            expectedCode.writeRef(),
+            diagnosticBlob.writeRef())));
+
+        SLANG_CHECK(code->getBufferSize() == expectedCode->getBufferSize());
+        SLANG_CHECK(
+            memcmp(
+                code->getBufferPointer(),
+                expectedCode->getBufferPointer(),
+                code->getBufferSize()) == 0);
+    }
+
+    // Invalid indices are reported up front.
+    {
+        ComPtr<slang::ICompileTask_Experimental> task;
+        SLANG_CHECK(
+            asyncProgram->getTargetCodeAsync(1, nullptr, task.writeRef()) == SLANG_E_INVALID_ARG);
+    }
+}
+
+// Test that a session's task scheduler is used for asynchronous compiles that don't
+// specify one.
+SLANG_UNIT_TEST(asyncCompileSessionScheduler)
+{
+    const char* userSource = R"(
+        [shader("compute")]
+        [numthreads(1,1,1)]
+        void computeMain(uniform RWStructuredBuffer<float> buffer)
+        {
+            buffer[0] = exp(buffer[1]);
+        }
+        )";
+
+    auto globalSession = unitTestContext->slangGlobalSession;
+
+    DeferredTaskScheduler scheduler;
+
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("sm_5_0");
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+    sessionDesc.taskScheduler = &scheduler;
+
+    ComPtr<slang::ISession> session;
+    SLANG_CHECK_ABORT(
+        SLANG_SUCCEEDED(globalSession->createSession(sessionDesc, session.writeRef())));
+
+    ComPtr<slang::IBlob> diagnosticBlob;
+    auto module = session->loadModuleFromSourceString(
+        "m",
+        "m.slang",
+        userSource,
+        diagnosticBlob.writeRef());
+    SLANG_CHECK_ABORT(module != nullptr);
+
+    ComPtr<slang::IEntryPoint> entryPoint;
+    SLANG_CHECK_ABORT(
+        SLANG_SUCCEEDED(module->findEntryPointByName("computeMain", entryPoint.writeRef())));
+
+    slang::IComponentType* components[] = {module, entryPoint.get()};
+    ComPtr<slang::IComponentType> linkedProgram;
+    {
+        ComPtr<slang::IComponentType> composedProgram;
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(
+            session->createCompositeComponentType(components, 2, composedProgram.writeRef())));
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(composedProgram->link(linkedProgram.writeRef())));
+    }
+
+    ComPtr<slang::IComponentTypeAsync_Experimental> asyncProgram;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(linkedProgram->queryInterface(
+        slang::IComponentTypeAsync_Experimental::getTypeGuid(),
+        (void**)asyncProgram.writeRef())));
+
+    ComPtr<slang::ICompileTask_Experimental> task;
+    SLANG_CHECK_ABORT(
+        SLANG_SUCCEEDED(asyncProgram->getTargetCodeAsync(0, nullptr, task.writeRef())));
+    SLANG_CHECK(scheduler.m_tasks.getCount() == 1);
+
+    scheduler.runAll();
+
+    ComPtr<slang::IBlob> code;
+    SLANG_CHECK(SLANG_SUCCEEDED(task->waitForResult(code.writeRef(), diagnosticBlob.writeRef())));
+    SLANG_CHECK(code && code->getBufferSize() != 0);
+}
@@ -0,0 +1,414 @@
+// unit-test-benchmarks.cpp
+
+// Microbenchmarks of the core containers and of the compiler, run with `slang-test -bench`.
+// Each reports the time per operation, so changes to the data structures can be compared.
+
+#include "../../source/core/slang-blob.h"
+#include "../../source/core/slang-crypto.h"
+#include "../../source/core/slang-dictionary.h"
+#include "../../source/core/slang-file-system.h"
+#include "../../source/core/slang-io.h"
+#include "../../source/core/slang-memory-arena.h"
+#include "../../source/core/slang-persistent-cache.h"
+#include "../../source/core/slang-process.h"
+#include "../../source/core/slang-string.h"
+#include "../../source/core/slang-uint-set.h"
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+namespace
+{
+static const Index kElementCount = 10000;
+
+/// A sequence of distinct keys that aren't in order, so hashing and probing are exercised.
+List<Int> _makeKeys(Index count)
+{
+    List<Int> keys;
+    keys.setCount(count);
+    uint64_t state = 0x9e3779b97f4a7c15ull;
+    for (Index i = 0; i < count; ++i)
+    {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        keys[i] = Int(state >> 17) * kElementCount + i;
+    }
+    return keys;
+}
+} // namespace
+
+SLANG_UNIT_BENCHMARK(dictionary)
+{
+    const List<Int> keys = _makeKeys(kElementCount);
+
+    Int sum = 0;
+    runUnitBenchmark(
+        "Dictionary<Int, Int>::add",
+        kElementCount,
+        [&]()
+        {
+            Dictionary<Int, Int> dict;
+            for (auto key : keys)
+                dict.add(key, key);
+            sum += dict.getCount();
+        });
+
+    Dictionary<Int, Int> dict;
+    for (auto key : keys)
+        dict.add(key, key);
+    runUnitBenchmark(
+        "Dictionary<Int, Int>::tryGetValue",
+        kElementCount,
+        [&]()
+        {
+            for (auto key : keys)
+            {
+                if (auto value = dict.tryGetValue(key))
+                    sum += *value;
+            }
+        });
+
+    List<String> names;
+    for (auto key : keys)
+        names.add(String("name") + String(key));
+    runUnitBenchmark(
+        "Dictionary<String, Int>::add",
+        kElementCount,
+        [&]()
+        {
+            Dictionary<String, Int> namesDict;
+            for (Index i = 0; i < names.getCount(); ++i)
+                namesDict.add(names[i], i);
+            sum += namesDict.getCount();
+        });
+
+    Dictionary<String, Int> namesDict;
+    for (Index i = 0; i < names.getCount(); ++i)
+        namesDict.add(names[i], i);
+    runUnitBenchmark(
+        "Dictionary<String, Int>::tryGetValue",
+        kElementCount,
+        [&]()
+        {
+            for (const auto& name : names)
+            {
+                if (auto value = namesDict.tryGetValue(name))
+                    sum += *value;
+            }
+        });
+
+    SLANG_CHECK(sum != 0);
+}
+
+SLANG_UNIT_BENCHMARK(stringBuilder)
+{
+    Index length = 0;
+    runUnitBenchmark(
+        "StringBuilder append",
+        kElementCount,
+        [&]()
+        {
+            StringBuilder builder;
+            for (Index i = 0; i < kElementCount; ++i)
+            {
+                builder << "value_" << i << " = ";
+                builder.append(double(i) * 0.5);
+                builder.appendChar('\n');
+            }
+            length += builder.getLength();
+        });
+
+    runUnitBenchmark(
+        "String concatenation",
+        kElementCount,
+        [&]()
+        {
+            for (Index i = 0; i < kElementCount; ++i)
+            {
+                String name = String("prefix_") + String(i) + "_suffix";
+                length += name.getLength();
+            }
+        });
+
+    SLANG_CHECK(length != 0);
+}
+
+SLANG_UNIT_BENCHMARK(uintSet)
+{
+    const UInt kMaxValue = 1 << 16;
+    const List<Int> keys = _makeKeys(kElementCount);
+
+    Index count = 0;
+    runUnitBenchmark(
+        "UIntSet::add",
+        kElementCount,
+        [&]()
+        {
+            UIntSet set(kMaxValue);
+            for (auto key : keys)
+                set.add(UInt(key) % kMaxValue);
+            count += set.countElements();
+        });
+
+    UIntSet a(kMaxValue);
+    UIntSet b(kMaxValue);
+    for (Index i = 0; i < keys.getCount(); ++i)
+        ((i & 1) ? a : b).add(UInt(keys[i]) % kMaxValue);
+
+    runUnitBenchmark(
+        "UIntSet::contains",
+        kElementCount,
+        [&]()
+        {
+            for (auto key : keys)
+                count += a.contains(UInt(key) % kMaxValue) ? 1 : 0;
+        });
+
+    runUnitBenchmark(
+        "UIntSet::unionWith/intersectWith",
+        2,
+        [&]()
+        {
+            UIntSet set = a;
+            set.unionWith(b);
+            set.intersectWith(a);
+            count += set.isEmpty() ? 0 : 1;
+        });
+
+    runUnitBenchmark(
+        "UIntSet iteration",
+        kElementCount / 2,
+        [&]()
+        {
+            for (auto value : a)
+                count += Index(value & 1);
+        });
+
+    SLANG_CHECK(count != 0);
+}
+
+SLANG_UNIT_BENCHMARK(memoryArena)
+{
+    size_t total = 0;
+    MemoryArena arena(4096);
+    runUnitBenchmark(
+        "MemoryArena::allocate",
+        kElementCount,
+        [&]()
+        {
+            for (Index i = 0; i < kElementCount; ++i)
+            {
+                const size_t size = 8 + (size_t(i) * 13) % 120;
+                total += size_t(arena.allocate(size)) & 1;
+            }
+            arena.reset();
+        });
+
+    runUnitBenchmark(
+        "MemoryArena::allocateString",
+        kElementCount,
+        [&]()
+        {
+            for (Index i = 0; i < kElementCount; ++i)
+                total += arena.allocateString("a string of moderate length")[0];
+            arena.reset();
+        });
+
+    SLANG_CHECK(total != 0);
+}
+
+SLANG_UNIT_BENCHMARK(persistentCache)
+{
+    const Index kEntryCount = 64;
+    const size_t kEntrySize = 16 * 1024;
+
+    const String directory = Path::simplify(
+        Path::getParentDirectory(Path::getExecutablePath()) + "/persistent-cache-bench" +
+        String(Process::getId()));
+
+    List<PersistentCache::Key> keys;
+    List<ComPtr<ISlangBlob>> blobs;
+    for (Index i = 0; i < kEntryCount; ++i)
+    {
+        List<uint8_t> data;
+        data.setCount(Index(kEntrySize));
+        for (Index j = 0; j < data.getCount(); ++j)
+            data[j] = uint8_t((i * 31 + j * 7) & 0xff);
+        keys.add(SHA1::compute(data.getBuffer(), data.getCount()));
+        blobs.add(ListBlob::moveCreate(data));
+    }
+
+    for (bool usePackFiles : {false, true})
+    {
+        PersistentCache::Desc desc;
+        desc.directory = directory.getBuffer();
+        desc.usePackFiles = usePackFiles;
+        RefPtr<PersistentCache> cache = new PersistentCache(desc);
+        const char* suffix = usePackFiles ? " (16KB, pack files)" : " (16KB)";
+        const String writeName = String("PersistentCache::writeEntry") + suffix;
+        const String readName = String("PersistentCache::readEntry") + suffix;
+
+        Index failureCount = 0;
+        runUnitBenchmark(
+            writeName.getBuffer(),
+            kEntryCount,
+            [&]()
+            {
+                for (Index i = 0; i < kEntryCount; ++i)
+                {
+                    if (SLANG_FAILED(cache->writeEntry(keys[i], blobs[i])))
+                        failureCount++;
+                }
+            });
+
+        runUnitBenchmark(
+            readName.getBuffer(),
+            kEntryCount,
+            [&]()
+            {
+                for (Index i = 0; i < kEntryCount; ++i)
+                {
+                    ComPtr<ISlangBlob> data;
+                    if (SLANG_FAILED(cache->readEntry(keys[i], data.writeRef())))
+                        failureCount++;
+                }
+            });
+
+        SLANG_CHECK(failureCount == 0);
+        cache->clear();
+    }
+    OSFileSystem::getMutableSingleton()->remove(directory.getBuffer());
+}
+
+// The IR builder isn't exported from the compiler, so IR emission is measured through
+// lowering, which builds the IR of every function in a module.
+SLANG_UNIT_BENCHMARK(irLowering)
+{
+    const Index kFunctionCount = 200;
+
+    StringBuilder source;
+    for (Index i = 0; i < kFunctionCount; ++i)
+    {
+        source << "float f" << i << "(float x, int n)\n";
+        source << "{\n";
+        source << "    float result = x;\n";
+        source << "    for (int i = 0; i < n; ++i)\n";
+        source << "        result = result * " << (i + 1) << ".0 + sin(result);\n";
+        source << "    return result > 1.0 ? result : x - result;\n";
+        source << "}\n";
+    }
+
+    auto globalSession = unitTestContext->slangGlobalSession;
+
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("sm_5_0");
+
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+
+    Index failureCount = 0;
+    runUnitBenchmark(
+        "loadModuleFromSourceString (per function)",
+        kFunctionCount,
+        [&]()
+        {
+            ComPtr<slang::ISession> session;
+            if (SLANG_FAILED(globalSession->createSession(sessionDesc, session.writeRef())))
+            {
+                failureCount++;
+                return;
+            }
+
+            ComPtr<slang::IBlob> diagnostics;
+            auto module = session->loadModuleFromSourceString(
+                "bench",
+                "bench.slang",
+                source.getBuffer(),
+                diagnostics.writeRef());
+            if (!module)
+                failureCount++;
+        });
+
+    SLANG_CHECK(failureCount == 0);
+}
+
+// Statements and preprocessor directives of every kind, to measure how quickly the front end
+// recognizes their keywords.
+SLANG_UNIT_BENCHMARK(frontEndKeywords)
+{
+    const Index kFunctionCount = 200;
+
+    StringBuilder source;
+    for (Index i = 0; i < kFunctionCount; ++i)
+    {
+        source << "#define VALUE_" << i << " " << i << "\n";
+        source << "float g" << i << "(float x)\n";
+        source << "{\n";
+        source << "#if VALUE_" << i << " > 100\n";
+        source << "    float r = x;\n";
+        source << "#elif defined(VALUE_" << i << ")\n";
+        source << "    float r = -x;\n";
+        source << "#else\n";
+        source << "    float r = 0.0;\n";
+        source << "#endif\n";
+        source << "    for (int j = 0; j < 4; ++j)\n";
+        source << "    {\n";
+        source << "        if (r > 1.0)\n";
+        source << "            break;\n";
+        source << "        r = r * 2.0;\n";
+        source << "    }\n";
+        source << "    while (r < 10.0)\n";
+        source << "    {\n";
+        source << "        r += 1.0;\n";
+        source << "        if (r == 5.0)\n";
+        source << "            continue;\n";
+        source << "    }\n";
+        source << "    do { r -= 0.5; } while (r > 20.0);\n";
+        source << "    switch (int(r))\n";
+        source << "    {\n";
+        source << "    case 0: r = 1.0; break;\n";
+        source << "    default: break;\n";
+        source << "    }\n";
+        source << "    return r;\n";
+        source << "}\n";
+        source << "#undef VALUE_" << i << "\n";
+    }
+
+    auto globalSession = unitTestContext->slangGlobalSession;
+
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("sm_5_0");
+
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+
+    Index failureCount = 0;
+    runUnitBenchmark(
+        "loadModuleFromSourceString keywords (per function)",
+        kFunctionCount,
+        [&]()
+        {
+            ComPtr<slang::ISession> session;
+            if (SLANG_FAILED(globalSession->createSession(sessionDesc, session.writeRef())))
+            {
+                failureCount++;
+                return;
+            }
+
+            ComPtr<slang::IBlob> diagnostics;
+            auto module = session->loadModuleFromSourceString(
+                "keywords",
+                "keywords.slang",
+                source.getBuffer(),
+                diagnostics.writeRef());
+            if (!module)
+                failureCount++;
+        });
+
+    SLANG_CHECK(failureCount == 0);
+}
@@ -0,0 +1,115 @@
+// unit-test-component-type-output.cpp
+
+#include "../../source/core/slang-writer.h"
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+#include <string.h>
+
+using namespace Slang;
+
+// Test that the code written to a writer or copied to a buffer through
+// `IComponentTypeOutput_Experimental` is the code returned in a blob.
+SLANG_UNIT_TEST(componentTypeOutput)
+{
+    const char* userSource = R"(
+        RWStructuredBuffer<float> outputBuffer;
+
+        [shader("compute")]
+        [numthreads(4,1,1)]
+        void computeMain(uint3 threadId : SV_DispatchThreadID)
+        {
+            outputBuffer[threadId.x] = 1.0;
+        }
+        )";
+
+    auto globalSession = unitTestContext->slangGlobalSession;
+
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("sm_5_0");
+
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+
+    ComPtr<slang::ISession> session;
+    SLANG_CHECK_ABORT(
+        SLANG_SUCCEEDED(globalSession->createSession(sessionDesc, session.writeRef())));
+
+    ComPtr<slang::IBlob> diagnosticBlob;
+    auto module = session->loadModuleFromSourceString(
+        "m",
+        "m.slang",
+        userSource,
+        diagnosticBlob.writeRef());
+    SLANG_CHECK_ABORT(module != nullptr);
+
+    ComPtr<slang::IEntryPoint> entryPoint;
+    SLANG_CHECK_ABORT(
+        SLANG_SUCCEEDED(module->findEntryPointByName("computeMain", entryPoint.writeRef())));
+
+    slang::IComponentType* components[] = {module, entryPoint.get()};
+    ComPtr<slang::IComponentType> composite;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(
+        session->createCompositeComponentType(components, 2, composite.writeRef())));
+    ComPtr<slang::IComponentType> program;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(composite->link(program.writeRef())));
+
+    ComPtr<slang::IComponentTypeOutput_Experimental> output;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(program->queryInterface(
+        slang::IComponentTypeOutput_Experimental::getTypeGuid(),
+        (void**)output.writeRef())));
+
+    ComPtr<slang::IBlob> code;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(program->getEntryPointCode(0, 0, code.writeRef())));
+    const size_t codeSize = code->getBufferSize();
+    SLANG_CHECK_ABORT(codeSize != 0);
+
+    // Writing to a writer
+    {
+        StringBuilder builder;
+        ComPtr<ISlangWriter> writer(new StringWriter(&builder, 0));
+        SLANG_CHECK(SLANG_SUCCEEDED(output->writeEntryPointCode(0, 0, writer)));
+        SLANG_CHECK(
+            builder.getLength() == Index(codeSize) &&
+            memcmp(builder.getBuffer(), code->getBufferPointer(), codeSize) == 0);
+    }
+
+    // Finding the size, then copying to a buffer of that size
+    {
+        size_t size = 0;
+        SLANG_CHECK(
+            output->copyEntryPointCode(0, 0, nullptr, 0, &size) == SLANG_E_BUFFER_TOO_SMALL);
+        SLANG_CHECK(size == codeSize);
+
+        List<uint8_t> buffer;
+        buffer.setCount(Index(size));
+        SLANG_CHECK(
+            output->copyEntryPointCode(0, 0, buffer.getBuffer(), size - 1, &size) ==
+            SLANG_E_BUFFER_TOO_SMALL);
+        SLANG_CHECK(SLANG_SUCCEEDED(
+            output->copyEntryPointCode(0, 0, buffer.getBuffer(), buffer.getCount(), &size)));
+        SLANG_CHECK(memcmp(buffer.getBuffer(), code->getBufferPointer(), codeSize) == 0);
+    }
+
+    // The whole target
+    {
+        ComPtr<slang::IBlob> targetCode;
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(program->getTargetCode(0, targetCode.writeRef())));
+
+        size_t size = 0;
+        SLANG_CHECK(output->copyTargetCode(0, nullptr, 0, &size) == SLANG_E_BUFFER_TOO_SMALL);
+        SLANG_CHECK(size == targetCode->getBufferSize());
+
+        StringBuilder builder;
+        ComPtr<ISlangWriter> writer(new StringWriter(&builder, 0));
+        SLANG_CHECK(SLANG_SUCCEEDED(output->writeTargetCode(0, writer)));
+        SLANG_CHECK(builder.getLength() == Index(targetCode->getBufferSize()));
+    }
+
+    // Invalid arguments
+    SLANG_CHECK(SLANG_FAILED(output->writeEntryPointCode(0, 0, nullptr)));
+    SLANG_CHECK(SLANG_FAILED(output->copyTargetCode(1, nullptr, 0, nullptr)));
+}
@@ -1,4 +1,5 @@
 // unit-compression.cpp
+#include "../../source/core/slang-block-compression-util.h"
 #include "../../source/core/slang-deflate-compression-system.h"
 #include "../../source/core/slang-lz4-compression-system.h"
 #include "unit-test/slang-unit-test.h"
@@ -56,3 +57,76 @@ SLANG_UNIT_TEST(compression)
         SLANG_CHECK(::memcmp(src, decompressedData.getBuffer(), srcSize) == 0);
     }
 }
+
+SLANG_UNIT_TEST(blockCompression)
+{
+    // Text that compresses, followed by bytes that don't, so some blocks are stored as is
+    const size_t kBlockSize = 4096;
+    List<uint8_t> src;
+    for (Index i = 0; i < 10000; ++i)
+    {
+        const char text[] = "Some text to compress. ";
+        src.addRange((const uint8_t*)text, Index(sizeof(text) - 1));
+    }
+    uint32_t state = 1;
+    for (Index i = 0; i < 20000; ++i)
+    {
+        state = state * 1664525 + 1013904223;
+        src.add(uint8_t(state >> 24));
+    }
+
+    CompressionStyle style;
+    for (Index i = 0; i < Count(CompressionSystemType::CountOf); ++i)
+    {
+        ICompressionSystem* system = _getCompressionSystem(CompressionSystemType(i));
+        if (!system)
+        {
+            continue;
+        }
+
+        List<uint8_t> compressed;
+        SLANG_CHECK(SLANG_SUCCEEDED(BlockCompressionUtil::compress(
+            system,
+            &style,
+            src.getBuffer(),
+            size_t(src.getCount()),
+            compressed,
+            kBlockSize)));
+        SLANG_CHECK(compressed.getCount() < src.getCount());
+
+        List<uint8_t> decompressed;
+        SLANG_CHECK(SLANG_SUCCEEDED(BlockCompressionUtil::decompress(
+            system,
+            compressed.getBuffer(),
+            size_t(compressed.getCount()),
+            decompressed)));
+        SLANG_CHECK(decompressed == src);
+
+        // Data that has been cut short can't be decompressed
+        SLANG_CHECK(SLANG_FAILED(BlockCompressionUtil::decompress(
+            system,
+            compressed.getBuffer(),
+            size_t(compressed.getCount() / 2),
+            decompressed)));
+
+        // Going through streams gives the same result
+        RefPtr<OwnedMemoryStream> srcStream(new OwnedMemoryStream(FileAccess::Read));
+        srcStream->setContent(src.getBuffer(), size_t(src.getCount()));
+        RefPtr<OwnedMemoryStream> compressedStream(new OwnedMemoryStream(FileAccess::ReadWrite));
+        SLANG_CHECK(SLANG_SUCCEEDED(BlockCompressionUtil::compress(
+            system,
+            &style,
+            srcStream,
+            compressedStream,
+            kBlockSize)));
+
+        compressedStream->seek(SeekOrigin::Start, 0);
+        RefPtr<OwnedMemoryStream> dstStream(new OwnedMemoryStream(FileAccess::ReadWrite));
+        SLANG_CHECK(
+            SLANG_SUCCEEDED(BlockCompressionUtil::decompress(system, compressedStream, dstStream)));
+
+        List<uint8_t> streamed;
+        dstStream->swapContents(streamed);
+        SLANG_CHECK(streamed == src);
+    }
+}
@@ -0,0 +1,91 @@
+// unit-test-concurrent-session.cpp
+
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+#include <atomic>
+#include <stdio.h>
+#include <stdlib.h>
+#include <thread>
+
+using namespace Slang;
+
+// Test that code can be generated for different component types of a single session
+// from multiple threads at the same time.
+SLANG_UNIT_TEST(concurrentSession)
+{
+    const char* userSource = R"(
+        [shader("compute")]
+        [numthreads(1,1,1)]
+        void computeA(uniform RWStructuredBuffer<float> buffer)
+        {
+            buffer[0] = sqrt(buffer[1]);
+        }
+
+        [shader("compute")]
+        [numthreads(1,1,1)]
+        void computeB(uniform RWStructuredBuffer<float> buffer)
+        {
+            buffer[0] = exp(buffer[1]);
+        }
+        )";
+
+    auto globalSession = unitTestContext->slangGlobalSession;
+
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("sm_5_0");
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+
+    ComPtr<slang::ISession> session;
+    SLANG_CHECK_ABORT(
+        SLANG_SUCCEEDED(globalSession->createSession(sessionDesc, session.writeRef())));
+
+    ComPtr<slang::IBlob> diagnosticBlob;
+    auto module = session->loadModuleFromSourceString(
+        "m",
+        "m.slang",
+        userSource,
+        diagnosticBlob.writeRef());
+    SLANG_CHECK_ABORT(module != nullptr);
+
+    const char* entryPointNames[] = {"computeA", "computeB"};
+    const Index kProgramCount = 2;
+
+    ComPtr<slang::IComponentType> linkedPrograms[kProgramCount];
+    for (Index i = 0; i < kProgramCount; ++i)
+    {
+        ComPtr<slang::IEntryPoint> entryPoint;
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(
+            module->findEntryPointByName(entryPointNames[i], entryPoint.writeRef())));
+
+        slang::IComponentType* components[] = {module, entryPoint.get()};
+        ComPtr<slang::IComponentType> composedProgram;
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(
+            session->createCompositeComponentType(components, 2, composedProgram.writeRef())));
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(composedProgram->link(linkedPrograms[i].writeRef())));
+    }
+
+    std::atomic<int> failureCount{0};
+    std::thread threads[kProgramCount];
+    for (Index i = 0; i < kProgramCount; ++i)
+    {
+        threads[i] = std::thread(
+            [&, i]()
+            {
+                ComPtr<slang::IBlob> code;
+                if (SLANG_FAILED(linkedPrograms[i]->getEntryPointCode(0, 0, code.writeRef())) ||
+                    !code || code->getBufferSize() == 0)
+                {
+                    failureCount++;
+                }
+            });
+    }
+    for (auto& thread : threads)
+        thread.join();
+
+    SLANG_CHECK(failureCount == 0);
+}
@@ -0,0 +1,77 @@
+// unit-test-container-pool.cpp
+
+#include "../../source/slang/slang-container-pool.h"
+#include "unit-test/slang-unit-test.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+using namespace Slang;
+
+namespace
+{
+struct Item
+{
+    int value;
+};
+} // namespace
+
+SLANG_UNIT_TEST(containerPool)
+{
+    Item items[16];
+
+    // A container that has been returned to the pool is handed out again empty, with its
+    // storage still allocated.
+    List<Item*>* firstList = nullptr;
+    Index firstCapacity = 0;
+    {
+        PooledList<Item> list;
+        for (auto& item : items)
+            list->add(&item);
+        firstList = &*list;
+        firstCapacity = list->getCapacity();
+    }
+    {
+        PooledList<Item> list;
+        SLANG_CHECK(&*list == firstList);
+        SLANG_CHECK(list->getCount() == 0);
+        SLANG_CHECK(list->getCapacity() == firstCapacity);
+
+        // Containers that are borrowed at the same time are distinct.
+        PooledList<Item> otherList;
+        SLANG_CHECK(&*otherList != &*list);
+    }
+
+    {
+        PooledHashSet<Item> set;
+        SLANG_CHECK(set->add(&items[0]));
+        SLANG_CHECK(!set->add(&items[0]));
+    }
+    {
+        PooledHashSet<Item> set;
+        SLANG_CHECK(set->getCount() == 0);
+        SLANG_CHECK(!set->contains(&items[0]));
+    }
+
+    {
+        PooledDictionary<Item, Item> dict;
+        (*dict)[&items[0]] = &items[1];
+        SLANG_CHECK(dict->getCount() == 1);
+    }
+    {
+        PooledDictionary<Item, Item> dict;
+        SLANG_CHECK(dict->getCount() == 0);
+    }
+
+    // Very large containers release their storage when they are returned.
+    {
+        PooledList<Item> list;
+        list->setCount(kContainerPoolMaxRetainedCount + 1);
+    }
+    {
+        PooledList<Item> list;
+        SLANG_CHECK(list->getCapacity() <= kContainerPoolMaxRetainedCount);
+    }
+
+    SLANG_CHECK(ContainerPool::getThreadLocal().calcMemoryUsed() > 0);
+}
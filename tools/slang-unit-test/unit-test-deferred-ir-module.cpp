@@ -0,0 +1,88 @@
+// unit-test-deferred-ir-module.cpp
+
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+using namespace Slang;
+
+static SlangResult _createSession(
+    slang::IGlobalSession* globalSession,
+    slang::ISession** outSession)
+{
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("sm_5_0");
+
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+    return globalSession->createSession(sessionDesc, outSession);
+}
+
+// Test that a module loaded from an IR blob, whose IR is only read when it is first
+// needed, can still be linked and used to generate code.
+SLANG_UNIT_TEST(deferredIRModule)
+{
+    const char* moduleSource = R"(
+        float scaleValue(float value) { return value * 3.0; }
+
+        [shader("compute")]
+        [numthreads(1,1,1)]
+        void computeMain(uniform RWStructuredBuffer<float> buffer)
+        {
+            buffer[0] = scaleValue(buffer[1]);
+        }
+        )";
+
+    auto globalSession = unitTestContext->slangGlobalSession;
+
+    ComPtr<slang::IBlob> moduleBlob;
+    {
+        ComPtr<slang::ISession> session;
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(_createSession(globalSession, session.writeRef())));
+
+        ComPtr<slang::IBlob> diagnosticBlob;
+        auto module = session->loadModuleFromSourceString(
+            "deferredIRModule",
+            "deferredIRModule.slang",
+            moduleSource,
+            diagnosticBlob.writeRef());
+        SLANG_CHECK_ABORT(module != nullptr);
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(module->serialize(moduleBlob.writeRef())));
+    }
+
+    ComPtr<slang::ISession> session;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(_createSession(globalSession, session.writeRef())));
+
+    ComPtr<slang::IBlob> diagnosticBlob;
+    auto module = session->loadModuleFromIRBlob(
+        "deferredIRModule",
+        "deferredIRModule.slang-module",
+        moduleBlob,
+        diagnosticBlob.writeRef());
+    SLANG_CHECK_ABORT(module != nullptr);
+
+    ComPtr<slang::IEntryPoint> entryPoint;
+    SLANG_CHECK_ABORT(
+        SLANG_SUCCEEDED(module->findEntryPointByName("computeMain", entryPoint.writeRef())));
+
+    slang::IComponentType* components[] = {module, entryPoint.get()};
+    ComPtr<slang::IComponentType> composedProgram;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(
+        session->createCompositeComponentType(components, 2, composedProgram.writeRef())));
+
+    ComPtr<slang::IComponentType> linkedProgram;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(composedProgram->link(linkedProgram.writeRef())));
+
+    ComPtr<slang::IBlob> code;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(
+        linkedProgram->getEntryPointCode(0, 0, code.writeRef(), diagnosticBlob.writeRef())));
+
+    const String text = String(
+        UnownedStringSlice((const char*)code->getBufferPointer(), code->getBufferSize()));
+    SLANG_CHECK(text.indexOf("computeMain") >= 0);
+}
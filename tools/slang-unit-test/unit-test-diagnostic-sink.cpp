@@ -0,0 +1,73 @@
+// unit-test-diagnostic-sink.cpp
+
+#include "../../source/compiler-core/slang-diagnostic-sink.h"
+#include "unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+namespace
+{
+const DiagnosticInfo kTestWarning = {1, Severity::Warning, "testWarning", "warning $0"};
+const DiagnosticInfo kTestError = {2, Severity::Error, "testError", "error $0"};
+const DiagnosticInfo kTestNote = {3, Severity::Note, "testNote", "note $0"};
+
+Index _countOccurrences(const StringBuilder& buffer, const char* text)
+{
+    const UnownedStringSlice slice(text);
+    Index count = 0;
+    for (UnownedStringSlice remaining = buffer.getUnownedSlice();;)
+    {
+        const Index index = remaining.indexOf(slice);
+        if (index < 0)
+            return count;
+        count++;
+        remaining = remaining.tail(index + slice.getLength());
+    }
+}
+} // namespace
+
+SLANG_UNIT_TEST(diagnosticSink)
+{
+    SourceManager sourceManager;
+    sourceManager.initialize(nullptr, nullptr);
+
+    // A warning repeated at the same location is only output once, along with its notes.
+    {
+        DiagnosticSink sink(&sourceManager, nullptr);
+        for (int i = 0; i < 3; ++i)
+        {
+            sink.diagnose(SourceLoc(), kTestWarning, "a");
+            sink.diagnose(SourceLoc(), kTestNote, "x");
+        }
+        SLANG_CHECK(_countOccurrences(sink.outputBuffer, "warning a") == 1);
+        SLANG_CHECK(_countOccurrences(sink.outputBuffer, "note x") == 1);
+
+        // A different warning keeps its notes, but not the same note twice.
+        sink.diagnose(SourceLoc(), kTestWarning, "b");
+        sink.diagnose(SourceLoc(), kTestNote, "x");
+        sink.diagnose(SourceLoc(), kTestNote, "x");
+        SLANG_CHECK(_countOccurrences(sink.outputBuffer, "warning b") == 1);
+        SLANG_CHECK(_countOccurrences(sink.outputBuffer, "note x") == 2);
+
+        // Errors are always output.
+        sink.diagnose(SourceLoc(), kTestError, "c");
+        sink.diagnose(SourceLoc(), kTestError, "c");
+        SLANG_CHECK(_countOccurrences(sink.outputBuffer, "error c") == 2);
+        SLANG_CHECK(sink.getErrorCount() == 2);
+
+        // Once reset, nothing has been output before.
+        sink.reset();
+        sink.diagnose(SourceLoc(), kTestWarning, "a");
+        SLANG_CHECK(_countOccurrences(sink.outputBuffer, "warning a") == 1);
+    }
+
+    // Without a blob to return, diagnostics are counted but not formatted.
+    {
+        DiagnosticSink sink(&sourceManager, nullptr);
+        sink.setCountOnlyIfNoBlob(nullptr);
+        sink.diagnose(SourceLoc(), kTestWarning, "a");
+        sink.diagnose(SourceLoc(), kTestError, "b");
+        SLANG_CHECK(sink.getErrorCount() == 1);
+        SLANG_CHECK(sink.outputBuffer.getLength() == 0);
+    }
+}
@@ -6,10 +6,14 @@
 #include "../../source/core/slang-io.h"
 #include "../../source/core/slang-lz4-compression-system.h"
 #include "../../source/core/slang-memory-file-system.h"
+#include "../../source/core/slang-process.h"
 #include "../../source/core/slang-riff-file-system.h"
 #include "../../source/core/slang-zip-file-system.h"
 #include "unit-test/slang-unit-test.h"
 
+#include <chrono>
+#include <filesystem>
+
 using namespace Slang;
 
 namespace
@@ -525,6 +529,48 @@ static SlangResult _test(FileSystemType type)
 
         // Check the file systems contents are the same
         SLANG_RETURN_ON_FAIL(_checkEqual(loadedFileSystem, fileSystem));
+
+        // Saving a file replaces the contents that were loaded from the archive
+        if (auto loadedMutableFileSystem = as<ISlangMutableFileSystem>(loadedFileSystem))
+        {
+            SLANG_RETURN_ON_FAIL(_createAndCheckFile(loadedMutableFileSystem, "a", bText));
+        }
+
+        // Loading the archive in place gives the same contents, and can still be modified
+        ComPtr<ISlangBlob> ownedArchiveBlob;
+        SLANG_RETURN_ON_FAIL(archiveFileSystem->storeArchive(true, ownedArchiveBlob.writeRef()));
+        {
+            ComPtr<ISlangFileSystemExt> inPlaceFileSystem;
+            SLANG_RETURN_ON_FAIL(loadArchiveFileSystem(ownedArchiveBlob, inPlaceFileSystem));
+            SLANG_RETURN_ON_FAIL(_checkEqual(inPlaceFileSystem, fileSystem));
+
+            if (auto inPlaceMutableFileSystem = as<ISlangMutableFileSystem>(inPlaceFileSystem))
+            {
+                SLANG_RETURN_ON_FAIL(_createAndCheckFile(inPlaceMutableFileSystem, "a", bText));
+            }
+        }
+
+        // As does loading it from a file mapped into memory
+        {
+            String archivePath;
+            SLANG_RETURN_ON_FAIL(File::generateTemporary(toSlice("archive"), archivePath));
+            SLANG_RETURN_ON_FAIL(File::writeAllBytes(
+                archivePath,
+                ownedArchiveBlob->getBufferPointer(),
+                ownedArchiveBlob->getBufferSize()));
+
+            ComPtr<ISlangFileSystemExt> mappedFileSystem;
+            SlangResult res = loadArchiveFileSystemFromFile(archivePath, mappedFileSystem);
+            if (SLANG_SUCCEEDED(res))
+            {
+                res = _checkEqual(mappedFileSystem, fileSystem);
+            }
+
+            // The file can't be removed on all platforms while it is mapped
+            mappedFileSystem.setNull();
+            File::remove(archivePath);
+            SLANG_RETURN_ON_FAIL(res);
+        }
     }
 
     SLANG_RETURN_ON_FAIL(fileSystem->remove("d/a"));
@@ -575,3 +621,49 @@ SLANG_UNIT_TEST(fileSystem)
         }
     }
 }
+
+// Check that a cache of the OS file system only keeps what is unchanged through
+// `invalidateChanged`.
+SLANG_UNIT_TEST(cacheFileSystemInvalidateChanged)
+{
+    const String directory = Path::simplify(
+        Path::getParentDirectory(Path::getExecutablePath()) + "/cache-file-system-test" +
+        String(Process::getId()));
+    SLANG_CHECK_ABORT(Path::createDirectory(directory));
+
+    const String filePath = directory + "/a.slang";
+    const String missingPath = directory + "/b.slang";
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(File::writeAllText(filePath, "first")));
+
+    ComPtr<CacheFileSystem> cache(new CacheFileSystem(OSFileSystem::getExtSingleton()));
+    cache->setTrackModificationTimes(true);
+
+    SLANG_CHECK(SLANG_SUCCEEDED(_checkFile(cache, filePath.getBuffer(), toSlice("first"))));
+    SlangPathType pathType;
+    SLANG_CHECK(SLANG_FAILED(cache->getPathType(missingPath.getBuffer(), &pathType)));
+
+    // Without invalidating, the cached results are used
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(File::writeAllText(missingPath, "created")));
+    SLANG_CHECK(SLANG_FAILED(cache->getPathType(missingPath.getBuffer(), &pathType)));
+
+    // Nothing changed about the file, so its contents are kept
+    cache->invalidateChanged();
+    SLANG_CHECK(SLANG_SUCCEEDED(_checkFile(cache, filePath.getBuffer(), toSlice("first"))));
+    SLANG_CHECK(SLANG_SUCCEEDED(_checkFile(cache, missingPath.getBuffer(), toSlice("created"))));
+
+    // Make sure the modification time changes, whatever the resolution of the file system
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(File::writeAllText(filePath, "second")));
+    {
+        const auto stdPath = std::filesystem::u8path(filePath.getBuffer());
+        std::filesystem::last_write_time(
+            stdPath,
+            std::filesystem::last_write_time(stdPath) + std::chrono::seconds(10));
+    }
+    SLANG_CHECK(SLANG_SUCCEEDED(_checkFile(cache, filePath.getBuffer(), toSlice("first"))));
+    cache->invalidateChanged();
+    SLANG_CHECK(SLANG_SUCCEEDED(_checkFile(cache, filePath.getBuffer(), toSlice("second"))));
+
+    File::remove(filePath);
+    File::remove(missingPath);
+    Path::remove(directory);
+}
@@ -0,0 +1,123 @@
+// unit-test-module-cache.cpp
+
+#include "../../source/core/slang-io.h"
+#include "../../source/core/slang-process.h"
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+using namespace Slang;
+
+static Index _countCachedModules(const String& cacheDir)
+{
+    struct Visitor : Path::Visitor
+    {
+        void accept(Path::Type type, const UnownedStringSlice& filename) SLANG_OVERRIDE
+        {
+            SLANG_UNUSED(filename);
+            if (type == Path::Type::File)
+                m_count++;
+        }
+        Index m_count = 0;
+    };
+
+    Visitor visitor;
+    Path::find(cacheDir, "*.slang-module", &visitor);
+    return visitor.m_count;
+}
+
+static SlangResult _compileWithModuleCache(
+    slang::IGlobalSession* globalSession,
+    const String& cacheDir,
+    const String& moduleName)
+{
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("sm_5_0");
+
+    slang::CompilerOptionEntry compilerOptionEntry = {};
+    compilerOptionEntry.name = slang::CompilerOptionName::ModuleCachePath;
+    compilerOptionEntry.value.kind = slang::CompilerOptionValueKind::String;
+    compilerOptionEntry.value.stringValue0 = cacheDir.getBuffer();
+
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+    sessionDesc.compilerOptionEntryCount = 1;
+    sessionDesc.compilerOptionEntries = &compilerOptionEntry;
+
+    ComPtr<slang::ISession> session;
+    SLANG_RETURN_ON_FAIL(globalSession->createSession(sessionDesc, session.writeRef()));
+
+    String userSource = "import " + moduleName + ";\n" + R"(
+        [shader("compute")]
+        [numthreads(4,1,1)]
+        void computeMain(
+            uint3 sv_dispatchThreadID : SV_DispatchThreadID,
+            uniform RWStructuredBuffer<int> buffer)
+        {
+            buffer[sv_dispatchThreadID.x] = f();
+        })";
+
+    ComPtr<slang::IBlob> diagnosticBlob;
+    auto module = session->loadModuleFromSourceString(
+        "userModule",
+        "userModule.slang",
+        userSource.getBuffer(),
+        diagnosticBlob.writeRef());
+    if (!module)
+        return SLANG_FAIL;
+
+    ComPtr<slang::IEntryPoint> entryPoint;
+    SLANG_RETURN_ON_FAIL(module->findEntryPointByName("computeMain", entryPoint.writeRef()));
+
+    slang::IComponentType* components[] = {module, entryPoint.get()};
+    ComPtr<slang::IComponentType> composedProgram;
+    SLANG_RETURN_ON_FAIL(session->createCompositeComponentType(
+        components,
+        2,
+        composedProgram.writeRef(),
+        diagnosticBlob.writeRef()));
+
+    ComPtr<slang::IComponentType> linkedProgram;
+    SLANG_RETURN_ON_FAIL(composedProgram->link(linkedProgram.writeRef(), diagnosticBlob.writeRef()));
+
+    ComPtr<slang::IBlob> code;
+    SLANG_RETURN_ON_FAIL(
+        linkedProgram->getEntryPointCode(0, 0, code.writeRef(), diagnosticBlob.writeRef()));
+    return code && code->getBufferSize() != 0 ? SLANG_OK : SLANG_FAIL;
+}
+
+// Test that imported modules are written to the module cache, and that
+// a later session can reuse the cached module.
+SLANG_UNIT_TEST(moduleCache)
+{
+    const char* moduleSource = R"(
+        public int f() { return 5; }
+        )";
+
+    auto moduleName = "moduleCache" + String(Process::getId());
+    auto cacheDir = "module-cache-" + String(Process::getId());
+    File::writeAllText(moduleName + ".slang", moduleSource);
+
+    auto globalSession = unitTestContext->slangGlobalSession;
+
+    // The first compilation checks the module from source and caches it.
+    SLANG_CHECK(SLANG_SUCCEEDED(_compileWithModuleCache(globalSession, cacheDir, moduleName)));
+    SLANG_CHECK(_countCachedModules(cacheDir) == 1);
+
+    // The second compilation loads the cached module, which must not
+    // create another cache entry.
+    SLANG_CHECK(SLANG_SUCCEEDED(_compileWithModuleCache(globalSession, cacheDir, moduleName)));
+    SLANG_CHECK(_countCachedModules(cacheDir) == 1);
+
+    // Changing the source invalidates the cached module.
+    File::writeAllText(moduleName + ".slang", "public int f() { return 6; }");
+    SLANG_CHECK(SLANG_SUCCEEDED(_compileWithModuleCache(globalSession, cacheDir, moduleName)));
+
+    File::remove(moduleName + ".slang");
+    Path::removeNonEmpty(cacheDir);
+}
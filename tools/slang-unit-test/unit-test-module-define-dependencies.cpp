@@ -0,0 +1,90 @@
+// unit-test-module-define-dependencies.cpp
+
+#include "../../source/core/slang-io.h"
+#include "../../source/core/slang-process.h"
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+using namespace Slang;
+
+static SlangResult _createSessionWithMacros(
+    slang::IGlobalSession* globalSession,
+    const slang::PreprocessorMacroDesc* macros,
+    SlangInt macroCount,
+    slang::ISession** outSession)
+{
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("sm_5_0");
+
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+    sessionDesc.preprocessorMacros = macros;
+    sessionDesc.preprocessorMacroCount = macroCount;
+    return globalSession->createSession(sessionDesc, outSession);
+}
+
+static bool _isUpToDateWithMacros(
+    slang::IGlobalSession* globalSession,
+    const String& modulePath,
+    slang::IBlob* moduleBlob,
+    const slang::PreprocessorMacroDesc* macros,
+    SlangInt macroCount)
+{
+    ComPtr<slang::ISession> session;
+    if (SLANG_FAILED(
+            _createSessionWithMacros(globalSession, macros, macroCount, session.writeRef())))
+        return false;
+    return session->isBinaryModuleUpToDate(modulePath.getBuffer(), moduleBlob);
+}
+
+// Test that a serialized module is only out of date with respect to the
+// preprocessor macros that it actually reads.
+SLANG_UNIT_TEST(moduleDefineDependencies)
+{
+    const char* moduleSource = R"(
+        #if USE_ONE
+        public int f() { return 1; }
+        #else
+        public int f() { return 2; }
+        #endif
+        )";
+
+    auto moduleName = "moduleDefineDependencies" + String(Process::getId());
+    auto modulePath = moduleName + ".slang";
+    File::writeAllText(modulePath, moduleSource);
+
+    auto globalSession = unitTestContext->slangGlobalSession;
+
+    const slang::PreprocessorMacroDesc compiledMacros[] = {{"USE_ONE", "1"}, {"UNUSED", "1"}};
+
+    ComPtr<slang::ISession> session;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(
+        _createSessionWithMacros(globalSession, compiledMacros, 2, session.writeRef())));
+
+    ComPtr<slang::IBlob> diagnosticBlob;
+    auto module = session->loadModule(moduleName.getBuffer(), diagnosticBlob.writeRef());
+    SLANG_CHECK_ABORT(module != nullptr);
+
+    ComPtr<slang::IBlob> moduleBlob;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(module->serialize(moduleBlob.writeRef())));
+
+    // Macros that the module never reads don't affect whether it is up to date.
+    const slang::PreprocessorMacroDesc otherUnusedMacros[] = {{"USE_ONE", "1"}, {"UNUSED", "2"}};
+    SLANG_CHECK(
+        _isUpToDateWithMacros(globalSession, modulePath, moduleBlob, otherUnusedMacros, 2));
+    SLANG_CHECK(
+        _isUpToDateWithMacros(globalSession, modulePath, moduleBlob, otherUnusedMacros, 1));
+
+    // Changing or removing a macro that the module reads does.
+    const slang::PreprocessorMacroDesc changedMacros[] = {{"USE_ONE", "0"}};
+    SLANG_CHECK(!_isUpToDateWithMacros(globalSession, modulePath, moduleBlob, changedMacros, 1));
+    SLANG_CHECK(!_isUpToDateWithMacros(globalSession, modulePath, moduleBlob, nullptr, 0));
+
+    File::remove(modulePath);
+}
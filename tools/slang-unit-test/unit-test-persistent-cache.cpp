@@ -82,7 +82,7 @@ struct PersistentCacheTest
     String cacheDirectory;
     RefPtr<PersistentCache> cache;
 
-    PersistentCacheTest(Count maxEntryCount = 0)
+    PersistentCacheTest(Count maxEntryCount = 0, size_t packFileSize = 0)
     {
         osFileSystem = OSFileSystem::getMutableSingleton();
         cacheDirectory = Path::simplify(
@@ -94,6 +94,11 @@ struct PersistentCacheTest
         PersistentCache::Desc desc;
         desc.directory = cacheDirectory.getBuffer();
         desc.maxEntryCount = maxEntryCount;
+        if (packFileSize)
+        {
+            desc.usePackFiles = true;
+            desc.packFileSize = packFileSize;
+        }
         cache = new PersistentCache(desc);
     }
 
@@ -157,6 +162,14 @@ struct PersistentCacheTest
 
     // Get the absolute filename of the cache index file.
     String getIndexFilename() { return cache->m_indexFileName; }
+
+    // Get the size of the cache index file in bytes.
+    size_t getIndexSize()
+    {
+        ComPtr<ISlangBlob> blob;
+        osFileSystem->loadFile(getIndexFilename().getBuffer(), blob.writeRef());
+        return blob ? blob->getBufferSize() : 0;
+    }
 };
 
 } // namespace Slang
@@ -303,6 +316,140 @@ struct EvictionTest : public PersistentCacheTest
     }
 };
 
+// Tests two caches sharing the same directory, as two processes would.
+// Each cache has to notice the entries the other one added or evicted, and the reads of
+// either cache count towards the eviction order.
+struct SharedIndexTest : public PersistentCacheTest
+{
+    SharedIndexTest()
+        : PersistentCacheTest(3)
+    {
+    }
+
+    void run()
+    {
+        List<Entry> entries;
+        for (size_t i = 0; i < 4; ++i)
+        {
+            auto data = createRandomBlob(4096);
+            auto key = SHA1::compute(data->getBufferPointer(), data->getBufferSize());
+            entries.add(Entry{key, data});
+        }
+
+        writeEntry(entries[0]);
+        writeEntry(entries[1]);
+        writeEntry(entries[2]);
+
+        PersistentCache::Desc desc;
+        desc.directory = cacheDirectory.getBuffer();
+        desc.maxEntryCount = 3;
+        RefPtr<PersistentCache> other = new PersistentCache(desc);
+        SLANG_CHECK(other->getStats().entryCount == 3);
+
+        // Reads don't change the size of the index.
+        const size_t indexSize = getIndexSize();
+        SLANG_CHECK(readEntry(entries[1]) == true);
+        {
+            ComPtr<ISlangBlob> data;
+            SLANG_CHECK(other->readEntry(entries[0].key, data.writeRef()) == SLANG_OK);
+            SLANG_CHECK(isBlobEqual(data, entries[0].data));
+        }
+        SLANG_CHECK(getIndexSize() == indexSize);
+
+        // Entry 2 is the least recently used by either cache, so it is evicted.
+        writeEntry(entries[3]);
+        {
+            ComPtr<ISlangBlob> data;
+            SLANG_CHECK(other->readEntry(entries[2].key, data.writeRef()) == SLANG_E_NOT_FOUND);
+            SLANG_CHECK(other->readEntry(entries[3].key, data.writeRef()) == SLANG_OK);
+            SLANG_CHECK(isBlobEqual(data, entries[3].data));
+        }
+        SLANG_CHECK(readEntry(entries[0]) == true);
+        SLANG_CHECK(readEntry(entries[1]) == true);
+        SLANG_CHECK(other->getStats().entryCount == 3);
+    }
+};
+
+// Tests storing the entries in pack files, and exporting and importing them.
+struct PackFileTest : public PersistentCacheTest
+{
+    static const size_t kEntrySize = 4096;
+
+    // Packs hold up to 3 entries.
+    PackFileTest()
+        : PersistentCacheTest(8, kEntrySize * 3)
+    {
+    }
+
+    Count countPackFiles()
+    {
+        Count count = 0;
+        osFileSystem->enumeratePathContents(
+            cacheDirectory.getBuffer(),
+            [](SlangPathType pathType, const char* fileName, void* userData)
+            {
+                if (pathType == SLANG_PATH_TYPE_FILE &&
+                    UnownedStringSlice(fileName).startsWith(toSlice("pack-")))
+                {
+                    ++*static_cast<Count*>(userData);
+                }
+            },
+            &count);
+        return count;
+    }
+
+    void run()
+    {
+        List<Entry> entries;
+        for (size_t i = 0; i < 15; ++i)
+        {
+            auto data = createRandomBlob(kEntrySize);
+            auto key = SHA1::compute(data->getBufferPointer(), data->getBufferSize());
+            entries.add(Entry{key, data});
+        }
+
+        for (Index i = 0; i < 8; ++i)
+        {
+            writeEntry(entries[i]);
+        }
+        SLANG_CHECK(countPackFiles() == 3);
+        for (Index i = 0; i < 8; ++i)
+        {
+            SLANG_CHECK(readEntry(entries[i]) == true);
+            SLANG_CHECK(!File::exists(getEntryFileName(entries[i])));
+        }
+
+        // Evict entries 0 to 5. The packs that held them are removed.
+        for (Index i = 8; i < 14; ++i)
+        {
+            writeEntry(entries[i]);
+        }
+        SLANG_CHECK(countPackFiles() == 3);
+        for (Index i = 0; i < 14; ++i)
+        {
+            SLANG_CHECK(readEntry(entries[i]) == (i >= 6));
+        }
+
+        // Export the entries, and import them into the emptied cache.
+        String exportFileName = cacheDirectory + "-export";
+        SLANG_CHECK(cache->exportEntries(exportFileName.getBuffer()) == SLANG_OK);
+        SLANG_CHECK(cache->clear() == SLANG_OK);
+        SLANG_CHECK(countPackFiles() == 0);
+        SLANG_CHECK(cache->importEntries(exportFileName.getBuffer()) == SLANG_OK);
+        osFileSystem->remove(exportFileName.getBuffer());
+        SLANG_CHECK(cache->getStats().entryCount == 8);
+        SLANG_CHECK(countPackFiles() == 3);
+
+        // The import keeps the order of use, so entry 6 is evicted first.
+        writeEntry(entries[14]);
+        SLANG_CHECK(readEntry(entries[6]) == false);
+        for (Index i = 7; i < 15; ++i)
+        {
+            SLANG_CHECK(readEntry(entries[i]) == true);
+        }
+    }
+};
+
 
 // Tests the cache to be robust against various corruptions.
 // These can happen if the cache files are manipulated externally.
@@ -625,6 +772,18 @@ SLANG_UNIT_TEST(persistentCacheEviction)
     test.run();
 }
 
+SLANG_UNIT_TEST(persistentCacheSharedIndex)
+{
+    SharedIndexTest test;
+    test.run();
+}
+
+SLANG_UNIT_TEST(persistentCachePackFiles)
+{
+    PackFileTest test;
+    test.run();
+}
+
 SLANG_UNIT_TEST(persistentCacheCorruption)
 {
     CorruptionTest test;
@@ -0,0 +1,61 @@
+// unit-test-profiler-trace.cpp
+
+#include "../../source/core/slang-performance-profiler.h"
+#include "unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+static void _profiledInner()
+{
+    SLANG_PROFILE_SECTION_TAGGED(inner, UnownedStringSlice("tag\"with quotes"));
+}
+
+static void _profiledOuter()
+{
+    SLANG_PROFILE_SECTION(outer);
+    _profiledInner();
+    _profiledInner();
+}
+
+SLANG_UNIT_TEST(profilerTrace)
+{
+    auto profiler = PerformanceProfiler::getProfiler();
+
+    // Nothing is recorded while tracing is disabled.
+    profiler->setTraceEnabled(false);
+    _profiledOuter();
+
+    profiler->setTraceEnabled(true);
+    SLANG_CHECK(profiler->getTraceEvents().getCount() == 0);
+
+    _profiledOuter();
+
+    const auto& events = profiler->getTraceEvents();
+    SLANG_CHECK_ABORT(events.getCount() == 3);
+
+    SLANG_CHECK(UnownedStringSlice(events[0].name) == "outer");
+    SLANG_CHECK(events[0].depth == 0);
+    SLANG_CHECK(events[0].tag.getLength() == 0);
+
+    for (Index i = 1; i < 3; ++i)
+    {
+        SLANG_CHECK(UnownedStringSlice(events[i].name) == "inner");
+        SLANG_CHECK(events[i].depth == 1);
+        SLANG_CHECK(events[i].tag == "tag\"with quotes");
+
+        // Nested spans lie within their parent span.
+        SLANG_CHECK(events[i].startTime >= events[0].startTime);
+        SLANG_CHECK(
+            events[i].startTime + events[i].duration <=
+            events[0].startTime + events[0].duration);
+    }
+
+    StringBuilder traceJSON;
+    profiler->getTraceJSON(traceJSON);
+    SLANG_CHECK(traceJSON.startsWith("{\"traceEvents\":["));
+    SLANG_CHECK(traceJSON.indexOf("\"name\":\"outer\"") >= 0);
+    SLANG_CHECK(traceJSON.indexOf("\"tag\":\"tag\\\"with quotes\"") >= 0);
+
+    profiler->setTraceEnabled(false);
+    profiler->clear();
+}
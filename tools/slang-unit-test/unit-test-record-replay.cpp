@@ -134,6 +134,12 @@ static bool disableRecordLayer()
     return retCode == 0;
 }
 
+static bool setRecordCompression(bool enable)
+{
+    int retCode = writeEnvironmentVariable("SLANG_RECORD_COMPRESS", enable ? "1" : "0");
+    return retCode == 0;
+}
+
 static bool enableLogInReplayer()
 {
     int retCode = writeEnvironmentVariable("SLANG_RECORD_LOG_LEVEL", "3");
@@ -450,4 +456,12 @@ SLANG_UNIT_TEST(RecordReplay)
     SLANG_CHECK(SLANG_SUCCEEDED(runTests(unitTestContext)));
 }
 
+// Record through the asynchronous, compressed writer, and check the replay reads it back.
+SLANG_UNIT_TEST(RecordReplayCompressed)
+{
+    SLANG_CHECK_ABORT(setRecordCompression(true));
+    SLANG_CHECK(SLANG_SUCCEEDED(runTest(unitTestContext, "cpu-hello-world")));
+    SLANG_CHECK(setRecordCompression(false));
+}
+
 #endif
@@ -0,0 +1,147 @@
+// unit-test-reflection-blob.cpp
+
+#include "slang-com-ptr.h"
+#include "slang-reflection-blob.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+using namespace Slang;
+
+// Test that the binary reflection blob can be read back with the header-only reader, and
+// matches the reflection API.
+SLANG_UNIT_TEST(reflectionBlob)
+{
+    const char* userSource = R"(
+        [__AttributeUsage(_AttributeTargets.Struct)]
+        struct MaterialTagAttribute
+        {
+            int id;
+        };
+
+        [MaterialTag(7)]
+        struct Material
+        {
+            float4 color;
+            float roughness;
+        };
+
+        ConstantBuffer<Material> material;
+        RWStructuredBuffer<float4> outputBuffer;
+
+        [shader("compute")]
+        [numthreads(4,2,1)]
+        void computeMain(uint3 threadId : SV_DispatchThreadID)
+        {
+            outputBuffer[threadId.x] = material.color * material.roughness;
+        }
+        )";
+
+    auto globalSession = unitTestContext->slangGlobalSession;
+
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("sm_5_0");
+
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+
+    ComPtr<slang::ISession> session;
+    SLANG_CHECK_ABORT(
+        SLANG_SUCCEEDED(globalSession->createSession(sessionDesc, session.writeRef())));
+
+    ComPtr<slang::IBlob> diagnosticBlob;
+    auto module = session->loadModuleFromSourceString(
+        "m",
+        "m.slang",
+        userSource,
+        diagnosticBlob.writeRef());
+    SLANG_CHECK_ABORT(module != nullptr);
+
+    ComPtr<slang::IEntryPoint> entryPoint;
+    SLANG_CHECK_ABORT(
+        SLANG_SUCCEEDED(module->findEntryPointByName("computeMain", entryPoint.writeRef())));
+
+    slang::IComponentType* components[] = {module, entryPoint.get()};
+    ComPtr<slang::IComponentType> composedProgram;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(
+        session->createCompositeComponentType(components, 2, composedProgram.writeRef())));
+
+    auto layout = composedProgram->getLayout(0, diagnosticBlob.writeRef());
+    SLANG_CHECK_ABORT(layout != nullptr);
+
+    ComPtr<ISlangBlob> reflectionBlob;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(layout->toBlob(reflectionBlob.writeRef())));
+
+    namespace Blob = slang::ReflectionBlob;
+    Blob::Reader reader;
+    SLANG_CHECK_ABORT(
+        reader.init(reflectionBlob->getBufferPointer(), reflectionBlob->getBufferSize()));
+
+    // A truncated blob must be rejected rather than read out of bounds.
+    Blob::Reader truncatedReader;
+    SLANG_CHECK(!truncatedReader.init(
+        reflectionBlob->getBufferPointer(),
+        reflectionBlob->getBufferSize() - 4));
+
+    SLANG_CHECK(reader.getParameterCount() == layout->getParameterCount());
+
+    auto outputBuffer = reader.findParameter("outputBuffer");
+    SLANG_CHECK_ABORT(outputBuffer != nullptr);
+    auto binding = reader.findBinding(outputBuffer, SLANG_PARAMETER_CATEGORY_UNORDERED_ACCESS);
+    SLANG_CHECK_ABORT(binding != nullptr);
+    SLANG_CHECK(binding->offset == 0);
+    SLANG_CHECK(binding->space == 0);
+
+    auto outputBufferType = reader.getTypeLayout(outputBuffer);
+    SLANG_CHECK_ABORT(outputBufferType != nullptr);
+    SLANG_CHECK(outputBufferType->kind == SLANG_TYPE_KIND_RESOURCE);
+    SLANG_CHECK((outputBufferType->resourceShape & SLANG_RESOURCE_BASE_SHAPE_MASK) ==
+                SLANG_STRUCTURED_BUFFER);
+
+    auto material = reader.findParameter("material");
+    SLANG_CHECK_ABORT(material != nullptr);
+    SLANG_CHECK(reader.findBinding(material, SLANG_PARAMETER_CATEGORY_CONSTANT_BUFFER));
+
+    auto materialType = reader.getTypeLayout(material);
+    SLANG_CHECK_ABORT(materialType != nullptr);
+    SLANG_CHECK(materialType->kind == SLANG_TYPE_KIND_CONSTANT_BUFFER);
+
+    auto materialStruct = reader.getTypeLayout(materialType->elementTypeLayout);
+    SLANG_CHECK_ABORT(materialStruct != nullptr);
+    SLANG_CHECK(UnownedStringSlice(reader.getString(materialStruct->name)) == "Material");
+    SLANG_CHECK(materialStruct->fields.count == 2);
+    SLANG_CHECK(reader.findSize(materialStruct, SLANG_PARAMETER_CATEGORY_UNIFORM) == 20);
+
+    auto materialTag = reader.getAttribute(materialStruct->attributes, 0);
+    SLANG_CHECK_ABORT(materialTag != nullptr);
+    SLANG_CHECK(UnownedStringSlice(reader.getString(materialTag->name)) == "MaterialTag");
+    auto materialTagArg = reader.getAttributeArg(materialTag->args, 0);
+    SLANG_CHECK_ABORT(materialTagArg != nullptr);
+    SLANG_CHECK(materialTagArg->kind == Blob::AttributeArgKind::Int);
+    SLANG_CHECK(materialTagArg->value == 7);
+
+    auto roughness = reader.findField(materialStruct, "roughness");
+    SLANG_CHECK_ABORT(roughness != nullptr);
+    auto roughnessOffset = reader.findBinding(roughness, SLANG_PARAMETER_CATEGORY_UNIFORM);
+    SLANG_CHECK_ABORT(roughnessOffset != nullptr);
+    SLANG_CHECK(roughnessOffset->offset == 16);
+
+    SLANG_CHECK_ABORT(reader.getEntryPointCount() == 1);
+    auto blobEntryPoint = reader.findEntryPoint("computeMain");
+    SLANG_CHECK_ABORT(blobEntryPoint != nullptr);
+    SLANG_CHECK(blobEntryPoint->stage == SLANG_STAGE_COMPUTE);
+    SLANG_CHECK(blobEntryPoint->threadGroupSize[0] == 4);
+    SLANG_CHECK(blobEntryPoint->threadGroupSize[1] == 2);
+    SLANG_CHECK(blobEntryPoint->threadGroupSize[2] == 1);
+    SLANG_CHECK(blobEntryPoint->parameters.count == 1);
+
+    auto threadId = reader.getVariable(blobEntryPoint->parameters, 0);
+    SLANG_CHECK_ABORT(threadId != nullptr);
+    SLANG_CHECK(UnownedStringSlice(reader.getString(threadId->name)) == "threadId");
+    SLANG_CHECK(
+        UnownedStringSlice(reader.getString(threadId->semanticName)) == "SV_DISPATCHTHREADID");
+}
@@ -0,0 +1,94 @@
+// unit-test-reflection-find-by-name.cpp
+
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+using namespace Slang;
+
+// Test that the cached and pre-hashed name lookups of the reflection API agree with the
+// plain lookups, including for names that aren't found.
+SLANG_UNIT_TEST(reflectionFindByName)
+{
+    const char* userSource = R"(
+        struct Material
+        {
+            float4 baseColor;
+        };
+
+        struct Box<T>
+        {
+            T value;
+        };
+
+        float4 shade(Material material)
+        {
+            return material.baseColor;
+        }
+
+        RWStructuredBuffer<float4> outputBuffer;
+
+        [shader("compute")]
+        [numthreads(1,1,1)]
+        void computeMain()
+        {
+            Material material = { float4(1) };
+            outputBuffer[0] = shade(material);
+        }
+        )";
+
+    auto globalSession = unitTestContext->slangGlobalSession;
+
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("sm_5_0");
+
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+
+    ComPtr<slang::ISession> session;
+    SLANG_CHECK_ABORT(
+        SLANG_SUCCEEDED(globalSession->createSession(sessionDesc, session.writeRef())));
+
+    ComPtr<slang::IBlob> diagnosticBlob;
+    auto module = session->loadModuleFromSourceString(
+        "m",
+        "m.slang",
+        userSource,
+        diagnosticBlob.writeRef());
+    SLANG_CHECK_ABORT(module != nullptr);
+
+    auto layout = module->getLayout(0, diagnosticBlob.writeRef());
+    SLANG_CHECK_ABORT(layout != nullptr);
+
+    auto hashOf = [](const char* name) { return spComputeStringHash(name, strlen(name)); };
+
+    const char* typeNames[] = {"Material", "Box<Material>"};
+    for (auto name : typeNames)
+    {
+        auto type = layout->findTypeByName(name);
+        SLANG_CHECK_ABORT(type != nullptr);
+        SLANG_CHECK(layout->findTypeByName(name) == type);
+        SLANG_CHECK(layout->findTypeByName(name, hashOf(name)) == type);
+    }
+    SLANG_CHECK(strcmp(layout->findTypeByName("Material")->getName(), "Material") == 0);
+
+    // Names that don't resolve stay unresolved, however often they are looked up.
+    SLANG_CHECK(layout->findTypeByName("NoSuchType") == nullptr);
+    SLANG_CHECK(layout->findTypeByName("NoSuchType", hashOf("NoSuchType")) == nullptr);
+
+    auto function = layout->findFunctionByName("shade");
+    SLANG_CHECK_ABORT(function != nullptr);
+    SLANG_CHECK(strcmp(function->getName(), "shade") == 0);
+    SLANG_CHECK(layout->findFunctionByName("shade", hashOf("shade")) == function);
+    SLANG_CHECK(layout->findFunctionByName("noSuchFunction") == nullptr);
+
+    // A lookup whose hash collides with an earlier one still compares the name.
+    SLANG_CHECK(layout->findTypeByName("NoSuchType", hashOf("Material")) == nullptr);
+    SLANG_CHECK(layout->findFunctionByName("shade", hashOf("Material")) == function);
+}
@@ -0,0 +1,187 @@
+// unit-test-reflection-flattened.cpp
+
+#include "core/slang-basic.h"
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+using namespace Slang;
+
+// Test that the batch reflection queries fill their arrays with the same information as the
+// per-field reflection API.
+SLANG_UNIT_TEST(reflectionFlattened)
+{
+    const char* userSource = R"(
+        struct Params
+        {
+            float4 color;
+            float2 offsets[3];
+            float scale;
+        };
+
+        ConstantBuffer<Params> params;
+        Texture2D tex;
+        RWStructuredBuffer<float4> outputBuffer;
+
+        [shader("compute")]
+        [numthreads(4,1,1)]
+        void computeMain(uint3 threadId : SV_DispatchThreadID, uniform float bias)
+        {
+            outputBuffer[threadId.x] = params.color * params.scale + tex.Load(int3(0)) + bias;
+        }
+        )";
+
+    auto globalSession = unitTestContext->slangGlobalSession;
+
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("sm_5_0");
+
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+
+    ComPtr<slang::ISession> session;
+    SLANG_CHECK_ABORT(
+        SLANG_SUCCEEDED(globalSession->createSession(sessionDesc, session.writeRef())));
+
+    ComPtr<slang::IBlob> diagnosticBlob;
+    auto module = session->loadModuleFromSourceString(
+        "m",
+        "m.slang",
+        userSource,
+        diagnosticBlob.writeRef());
+    SLANG_CHECK_ABORT(module != nullptr);
+
+    ComPtr<slang::IEntryPoint> entryPoint;
+    SLANG_CHECK_ABORT(
+        SLANG_SUCCEEDED(module->findEntryPointByName("computeMain", entryPoint.writeRef())));
+
+    slang::IComponentType* components[] = {module, entryPoint.get()};
+    ComPtr<slang::IComponentType> composedProgram;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(
+        session->createCompositeComponentType(components, 2, composedProgram.writeRef())));
+
+    auto layout = composedProgram->getLayout(0, diagnosticBlob.writeRef());
+    SLANG_CHECK_ABORT(layout != nullptr);
+
+    // Bindings: ask for the count first, then fill arrays of that size.
+    {
+        SlangReflectionFlattenedBindings bindings = {};
+        const SlangUInt count = layout->getFlattenedBindings(&bindings);
+        SLANG_CHECK_ABORT(count >= 4);
+
+        List<SlangReflectionVariableLayout*> parameters;
+        List<int32_t> entryPointIndices;
+        List<SlangParameterCategory> categories;
+        List<size_t> indices;
+        List<size_t> spaces;
+        List<size_t> counts;
+        parameters.setCount(Index(count));
+        entryPointIndices.setCount(Index(count));
+        categories.setCount(Index(count));
+        indices.setCount(Index(count));
+        spaces.setCount(Index(count));
+        counts.setCount(Index(count));
+
+        bindings.capacity = count;
+        bindings.parameters = parameters.getBuffer();
+        bindings.entryPointIndices = entryPointIndices.getBuffer();
+        bindings.categories = categories.getBuffer();
+        bindings.indices = indices.getBuffer();
+        bindings.spaces = spaces.getBuffer();
+        bindings.counts = counts.getBuffer();
+        SLANG_CHECK(layout->getFlattenedBindings(&bindings) == count);
+
+        // The globals come first, in declaration order.
+        const char* globalNames[] = {"params", "tex", "outputBuffer"};
+        const SlangParameterCategory globalCategories[] = {
+            SLANG_PARAMETER_CATEGORY_CONSTANT_BUFFER,
+            SLANG_PARAMETER_CATEGORY_SHADER_RESOURCE,
+            SLANG_PARAMETER_CATEGORY_UNORDERED_ACCESS};
+        for (Index i = 0; i < 3; ++i)
+        {
+            auto parameter = (slang::VariableLayoutReflection*)parameters[i];
+            SLANG_CHECK(strcmp(parameter->getName(), globalNames[i]) == 0);
+            SLANG_CHECK(entryPointIndices[i] == -1);
+            SLANG_CHECK(categories[i] == globalCategories[i]);
+            SLANG_CHECK(indices[i] == parameter->getOffset(globalCategories[i]));
+            SLANG_CHECK(spaces[i] == parameter->getBindingSpace(globalCategories[i]));
+            SLANG_CHECK(counts[i] == 1);
+        }
+
+        bool foundBias = false;
+        for (Index i = 3; i < Index(count); ++i)
+        {
+            auto parameter = (slang::VariableLayoutReflection*)parameters[i];
+            SLANG_CHECK(entryPointIndices[i] == 0);
+            if (strcmp(parameter->getName(), "bias") == 0 &&
+                categories[i] == SLANG_PARAMETER_CATEGORY_UNIFORM)
+            {
+                foundBias = true;
+                SLANG_CHECK(counts[i] == 4);
+            }
+        }
+        SLANG_CHECK(foundBias);
+
+        // A smaller capacity only writes the first entries.
+        bindings.capacity = 1;
+        categories[1] = SLANG_PARAMETER_CATEGORY_NONE;
+        SLANG_CHECK(layout->getFlattenedBindings(&bindings) == count);
+        SLANG_CHECK(categories[1] == SLANG_PARAMETER_CATEGORY_NONE);
+    }
+
+    // Type layout tree of `params`: the constant buffer, `Params`, and its fields, with the
+    // element of the `offsets` array after it.
+    {
+        auto paramsTypeLayout = layout->getParameterByIndex(0)->getTypeLayout();
+
+        SlangReflectionTypeLayout* typeLayouts[8] = {};
+        SlangReflectionVariableLayout* fields[8] = {};
+        int32_t parentIndices[8] = {};
+        SlangTypeKind kinds[8] = {};
+        size_t uniformOffsets[8] = {};
+        size_t elementCounts[8] = {};
+
+        SlangReflectionFlattenedTypeLayout tree = {};
+        tree.capacity = 8;
+        tree.typeLayouts = typeLayouts;
+        tree.fields = fields;
+        tree.parentIndices = parentIndices;
+        tree.kinds = kinds;
+        tree.uniformOffsets = uniformOffsets;
+        tree.elementCounts = elementCounts;
+        SLANG_CHECK_ABORT(paramsTypeLayout->getFlattenedTree(&tree) == 6);
+
+        SLANG_CHECK(typeLayouts[0] == (SlangReflectionTypeLayout*)paramsTypeLayout);
+        SLANG_CHECK(kinds[0] == SLANG_TYPE_KIND_CONSTANT_BUFFER);
+        SLANG_CHECK(parentIndices[0] == -1);
+
+        SLANG_CHECK(kinds[1] == SLANG_TYPE_KIND_STRUCT);
+        SLANG_CHECK(parentIndices[1] == 0);
+        SLANG_CHECK(fields[1] == nullptr);
+
+        const char* fieldNames[] = {"color", "offsets", "scale"};
+        const int32_t fieldNodes[] = {2, 3, 5};
+        const size_t fieldOffsets[] = {0, 16, 56};
+        for (int i = 0; i < 3; ++i)
+        {
+            auto field = (slang::VariableLayoutReflection*)fields[fieldNodes[i]];
+            SLANG_CHECK_ABORT(field != nullptr);
+            SLANG_CHECK(strcmp(field->getName(), fieldNames[i]) == 0);
+            SLANG_CHECK(parentIndices[fieldNodes[i]] == 1);
+            SLANG_CHECK(uniformOffsets[fieldNodes[i]] == fieldOffsets[i]);
+            SLANG_CHECK(uniformOffsets[fieldNodes[i]] == field->getOffset());
+        }
+
+        SLANG_CHECK(kinds[3] == SLANG_TYPE_KIND_ARRAY);
+        SLANG_CHECK(elementCounts[3] == 3);
+        SLANG_CHECK(kinds[4] == SLANG_TYPE_KIND_VECTOR);
+        SLANG_CHECK(parentIndices[4] == 3);
+        SLANG_CHECK(elementCounts[4] == 0);
+    }
+}
@@ -0,0 +1,90 @@
+// unit-test-reflection-only.cpp
+
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+using namespace Slang;
+
+// Test that `ReflectionOnly` still provides parameter binding information, and that
+// asking for target code reports an error instead.
+SLANG_UNIT_TEST(reflectionOnly)
+{
+    const char* userSource = R"(
+        Texture2D<float4> colorTexture;
+        SamplerState colorSampler;
+        RWStructuredBuffer<float4> outputBuffer;
+
+        [shader("compute")]
+        [numthreads(1,1,1)]
+        void computeMain()
+        {
+            outputBuffer[0] = colorTexture.SampleLevel(colorSampler, float2(0, 0), 0);
+        }
+        )";
+
+    auto globalSession = unitTestContext->slangGlobalSession;
+
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("sm_5_0");
+
+    slang::CompilerOptionEntry compilerOptionEntry = {};
+    compilerOptionEntry.name = slang::CompilerOptionName::ReflectionOnly;
+    compilerOptionEntry.value.kind = slang::CompilerOptionValueKind::Int;
+    compilerOptionEntry.value.intValue0 = 1;
+
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+    sessionDesc.compilerOptionEntryCount = 1;
+    sessionDesc.compilerOptionEntries = &compilerOptionEntry;
+
+    ComPtr<slang::ISession> session;
+    SLANG_CHECK_ABORT(
+        SLANG_SUCCEEDED(globalSession->createSession(sessionDesc, session.writeRef())));
+
+    ComPtr<slang::IBlob> diagnosticBlob;
+    auto module = session->loadModuleFromSourceString(
+        "m",
+        "m.slang",
+        userSource,
+        diagnosticBlob.writeRef());
+    SLANG_CHECK_ABORT(module != nullptr);
+
+    ComPtr<slang::IEntryPoint> entryPoint;
+    SLANG_CHECK_ABORT(
+        SLANG_SUCCEEDED(module->findEntryPointByName("computeMain", entryPoint.writeRef())));
+
+    slang::IComponentType* components[] = {module, entryPoint.get()};
+    ComPtr<slang::IComponentType> composedProgram;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(
+        session->createCompositeComponentType(components, 2, composedProgram.writeRef())));
+
+    ComPtr<slang::IComponentType> linkedProgram;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(composedProgram->link(linkedProgram.writeRef())));
+
+    auto layout = linkedProgram->getLayout(0, diagnosticBlob.writeRef());
+    SLANG_CHECK_ABORT(layout != nullptr);
+    SLANG_CHECK(layout->getParameterCount() == 3);
+    SLANG_CHECK(layout->getEntryPointCount() == 1);
+
+    auto outputBuffer = layout->getParameterByIndex(2);
+    SLANG_CHECK(UnownedStringSlice(outputBuffer->getName()) == "outputBuffer");
+    SLANG_CHECK(outputBuffer->getCategory() == slang::ParameterCategory::UnorderedAccess);
+    SLANG_CHECK(outputBuffer->getBindingIndex() == 0);
+
+    ComPtr<slang::IBlob> code;
+    diagnosticBlob.setNull();
+    SLANG_CHECK(SLANG_FAILED(
+        linkedProgram->getEntryPointCode(0, 0, code.writeRef(), diagnosticBlob.writeRef())));
+    SLANG_CHECK_ABORT(diagnosticBlob != nullptr);
+
+    const String diagnostics = String(UnownedStringSlice(
+        (const char*)diagnosticBlob->getBufferPointer(),
+        diagnosticBlob->getBufferSize()));
+    SLANG_CHECK(diagnostics.indexOf("reflection-only") >= 0);
+}
@@ -0,0 +1,79 @@
+// unit-test-report-pass-stats.cpp
+
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+using namespace Slang;
+
+// Test that `ReportPassStats` reports statistics for the IR passes run during code generation.
+SLANG_UNIT_TEST(reportPassStats)
+{
+    const char* userSource = R"(
+        [shader("compute")]
+        [numthreads(1,1,1)]
+        void computeMain(uniform RWStructuredBuffer<float> buffer)
+        {
+            buffer[0] = sqrt(buffer[1]);
+        }
+        )";
+
+    auto globalSession = unitTestContext->slangGlobalSession;
+
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("sm_5_0");
+
+    slang::CompilerOptionEntry compilerOptionEntry = {};
+    compilerOptionEntry.name = slang::CompilerOptionName::ReportPassStats;
+    compilerOptionEntry.value.kind = slang::CompilerOptionValueKind::Int;
+    compilerOptionEntry.value.intValue0 = 1;
+
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+    sessionDesc.compilerOptionEntryCount = 1;
+    sessionDesc.compilerOptionEntries = &compilerOptionEntry;
+
+    ComPtr<slang::ISession> session;
+    SLANG_CHECK_ABORT(
+        SLANG_SUCCEEDED(globalSession->createSession(sessionDesc, session.writeRef())));
+
+    ComPtr<slang::IBlob> diagnosticBlob;
+    auto module = session->loadModuleFromSourceString(
+        "m",
+        "m.slang",
+        userSource,
+        diagnosticBlob.writeRef());
+    SLANG_CHECK_ABORT(module != nullptr);
+
+    ComPtr<slang::IEntryPoint> entryPoint;
+    SLANG_CHECK_ABORT(
+        SLANG_SUCCEEDED(module->findEntryPointByName("computeMain", entryPoint.writeRef())));
+
+    slang::IComponentType* components[] = {module, entryPoint.get()};
+    ComPtr<slang::IComponentType> composedProgram;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(
+        session->createCompositeComponentType(components, 2, composedProgram.writeRef())));
+
+    ComPtr<slang::IComponentType> linkedProgram;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(composedProgram->link(linkedProgram.writeRef())));
+
+    ComPtr<slang::IBlob> code;
+    diagnosticBlob.setNull();
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(
+        linkedProgram->getEntryPointCode(0, 0, code.writeRef(), diagnosticBlob.writeRef())));
+    SLANG_CHECK_ABORT(diagnosticBlob != nullptr);
+
+    const String diagnostics = String(UnownedStringSlice(
+        (const char*)diagnosticBlob->getBufferPointer(),
+        diagnosticBlob->getBufferSize()));
+    SLANG_CHECK(diagnostics.indexOf("\"passes\"") >= 0);
+    SLANG_CHECK(diagnostics.indexOf("\"simplifyIR\"") >= 0);
+    SLANG_CHECK(diagnostics.indexOf("\"instCountAfter\"") >= 0);
+    SLANG_CHECK(diagnostics.indexOf("\"hoistableInstHits\"") >= 0);
+    SLANG_CHECK(diagnostics.indexOf("\"legalizedTypes\"") >= 0);
+}
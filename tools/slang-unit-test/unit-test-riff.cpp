@@ -110,6 +110,35 @@ SLANG_UNIT_TEST(riff)
                 // They should be the same
                 SLANG_CHECK(readBuilder == builder);
             }
+
+            // Reading in place should produce the same contents as reading from a stream.
+            {
+                OwnedMemoryStream stream(FileAccess::ReadWrite);
+                SLANG_CHECK(SLANG_SUCCEEDED(RiffUtil::write(container.getRoot(), true, &stream)));
+
+                const auto contents = stream.getContents();
+
+                RiffContainer readContainer;
+                SLANG_CHECK(SLANG_SUCCEEDED(RiffUtil::readInPlace(
+                    contents.getBuffer(),
+                    size_t(contents.getCount()),
+                    readContainer)));
+
+                StringBuilder readBuilder;
+                {
+                    StringWriter writer(&readBuilder, 0);
+                    RiffUtil::dump(readContainer.getRoot(), &writer);
+                }
+
+                SLANG_CHECK(readBuilder == builder);
+
+                // Truncated data must be rejected rather than referenced.
+                RiffContainer truncatedContainer;
+                SLANG_CHECK(SLANG_FAILED(RiffUtil::readInPlace(
+                    contents.getBuffer(),
+                    size_t(contents.getCount() - 4),
+                    truncatedContainer)));
+            }
         }
     }
 
@@ -0,0 +1,209 @@
+// unit-test-session-memory.cpp
+
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+using namespace Slang;
+
+// Test that a session with a memory budget evicts the code of the least recently used
+// programs, and compiles it again when it is requested later.
+SLANG_UNIT_TEST(sessionMemory)
+{
+    const char* userSource = R"(
+        RWStructuredBuffer<float> outputBuffer;
+
+        [shader("compute")]
+        [numthreads(4,1,1)]
+        void computeA(uint3 threadId : SV_DispatchThreadID)
+        {
+            outputBuffer[threadId.x] = 1.0;
+        }
+
+        [shader("compute")]
+        [numthreads(4,1,1)]
+        void computeB(uint3 threadId : SV_DispatchThreadID)
+        {
+            outputBuffer[threadId.x] = 2.0;
+        }
+        )";
+
+    auto globalSession = unitTestContext->slangGlobalSession;
+
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("sm_5_0");
+
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+
+    ComPtr<slang::ISession> session;
+    SLANG_CHECK_ABORT(
+        SLANG_SUCCEEDED(globalSession->createSession(sessionDesc, session.writeRef())));
+
+    ComPtr<slang::ISessionMemory_Experimental> sessionMemory;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(session->queryInterface(
+        slang::ISessionMemory_Experimental::getTypeGuid(),
+        (void**)sessionMemory.writeRef())));
+
+    ComPtr<slang::IBlob> diagnosticBlob;
+    auto module = session->loadModuleFromSourceString(
+        "m",
+        "m.slang",
+        userSource,
+        diagnosticBlob.writeRef());
+    SLANG_CHECK_ABORT(module != nullptr);
+
+    ComPtr<slang::IComponentType> programs[2];
+    const char* entryPointNames[] = {"computeA", "computeB"};
+    for (int i = 0; i < 2; ++i)
+    {
+        ComPtr<slang::IEntryPoint> entryPoint;
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(
+            module->findEntryPointByName(entryPointNames[i], entryPoint.writeRef())));
+
+        slang::IComponentType* components[] = {module, entryPoint.get()};
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(
+            session->createCompositeComponentType(components, 2, programs[i].writeRef())));
+    }
+
+    auto getStats = [&]()
+    {
+        slang::SessionMemoryStats stats;
+        SLANG_CHECK(SLANG_SUCCEEDED(sessionMemory->getMemoryStats(&stats)));
+        return stats;
+    };
+
+    // Without a budget, the code of both programs is kept.
+    ComPtr<slang::IBlob> codeA;
+    ComPtr<slang::IBlob> codeB;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(programs[0]->getEntryPointCode(0, 0, codeA.writeRef())));
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(programs[1]->getEntryPointCode(0, 0, codeB.writeRef())));
+    {
+        auto stats = getStats();
+        SLANG_CHECK(stats.memoryBudget == 0);
+        SLANG_CHECK(stats.cachedProgramCount == 2);
+        SLANG_CHECK(stats.targetCodeCount == 2);
+        SLANG_CHECK(stats.targetCodeBytes == codeA->getBufferSize() + codeB->getBufferSize());
+        SLANG_CHECK(stats.evictionCount == 0);
+        SLANG_CHECK(stats.loadedModuleCount >= 1);
+    }
+
+    // A budget smaller than both evicts the least recently used program, which is A.
+    sessionMemory->setMemoryBudget(codeB->getBufferSize() + 1);
+    {
+        auto stats = getStats();
+        SLANG_CHECK(stats.cachedProgramCount == 1);
+        SLANG_CHECK(stats.targetCodeBytes == codeB->getBufferSize());
+        SLANG_CHECK(stats.evictionCount == 1);
+    }
+
+    // Requesting A again compiles it again, and evicts B to make room for it.
+    ComPtr<slang::IBlob> codeAAgain;
+    SLANG_CHECK_ABORT(
+        SLANG_SUCCEEDED(programs[0]->getEntryPointCode(0, 0, codeAAgain.writeRef())));
+    SLANG_CHECK(codeAAgain->getBufferSize() == codeA->getBufferSize());
+    SLANG_CHECK(
+        memcmp(codeAAgain->getBufferPointer(), codeA->getBufferPointer(), codeA->getBufferSize()) ==
+        0);
+    {
+        auto stats = getStats();
+        SLANG_CHECK(stats.cachedProgramCount == 1);
+        SLANG_CHECK(stats.targetCodeBytes == codeA->getBufferSize());
+        SLANG_CHECK(stats.evictionCount == 2);
+    }
+
+    // Trimming drops everything, and releasing a program stops tracking it.
+    sessionMemory->trimMemory();
+    {
+        auto stats = getStats();
+        SLANG_CHECK(stats.cachedProgramCount == 0);
+        SLANG_CHECK(stats.targetCodeBytes == 0);
+    }
+
+    sessionMemory->setMemoryBudget(0);
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(programs[1]->getEntryPointCode(0, 0, codeB.writeRef())));
+    SLANG_CHECK(getStats().cachedProgramCount == 1);
+    programs[1].setNull();
+    SLANG_CHECK(getStats().cachedProgramCount == 0);
+}
+
+// Test that the memory stats of a session account for its modules and record the high
+// water marks of code generation.
+SLANG_UNIT_TEST(sessionMemoryAccounting)
+{
+    const char* userSource = R"(
+        RWStructuredBuffer<float> outputBuffer;
+
+        [shader("compute")]
+        [numthreads(4,1,1)]
+        void computeMain(uint3 threadId : SV_DispatchThreadID)
+        {
+            outputBuffer[threadId.x] = sqrt(float(threadId.x));
+        }
+        )";
+
+    auto globalSession = unitTestContext->slangGlobalSession;
+
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("sm_5_0");
+
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+
+    ComPtr<slang::ISession> session;
+    SLANG_CHECK_ABORT(
+        SLANG_SUCCEEDED(globalSession->createSession(sessionDesc, session.writeRef())));
+
+    ComPtr<slang::ISessionMemory_Experimental> sessionMemory;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(session->queryInterface(
+        slang::ISessionMemory_Experimental::getTypeGuid(),
+        (void**)sessionMemory.writeRef())));
+
+    ComPtr<slang::IBlob> diagnosticBlob;
+    auto module = session->loadModuleFromSourceString(
+        "m",
+        "m.slang",
+        userSource,
+        diagnosticBlob.writeRef());
+    SLANG_CHECK_ABORT(module != nullptr);
+
+    slang::SessionMemoryStats stats;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(sessionMemory->getMemoryStats(&stats)));
+    SLANG_CHECK(stats.astBytes > 0);
+    SLANG_CHECK(stats.irBytes > 0);
+    SLANG_CHECK(stats.peakCodeGenIRBytes == 0);
+    const size_t totalBytes = stats.astBytes + stats.irBytes + stats.irContainerPoolBytes +
+                              stats.stringPoolBytes + stats.targetCodeBytes;
+    SLANG_CHECK(stats.peakTotalBytes >= totalBytes);
+
+    ComPtr<slang::IEntryPoint> entryPoint;
+    SLANG_CHECK_ABORT(
+        SLANG_SUCCEEDED(module->findEntryPointByName("computeMain", entryPoint.writeRef())));
+
+    slang::IComponentType* components[] = {module, entryPoint.get()};
+    ComPtr<slang::IComponentType> program;
+    SLANG_CHECK_ABORT(
+        SLANG_SUCCEEDED(session->createCompositeComponentType(components, 2, program.writeRef())));
+
+    ComPtr<slang::IBlob> code;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(program->getEntryPointCode(0, 0, code.writeRef())));
+
+    // The IR linked for code generation counts towards the peaks, even though it has
+    // been released by now.
+    slang::SessionMemoryStats statsAfterCodeGen;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(sessionMemory->getMemoryStats(&statsAfterCodeGen)));
+    SLANG_CHECK(statsAfterCodeGen.peakCodeGenIRBytes > 0);
+    SLANG_CHECK(statsAfterCodeGen.peakTotalBytes >= stats.peakTotalBytes);
+    SLANG_CHECK(
+        statsAfterCodeGen.peakTotalBytes >=
+        statsAfterCodeGen.irBytes + statsAfterCodeGen.peakCodeGenIRBytes);
+    SLANG_CHECK(statsAfterCodeGen.targetCodeBytes == code->getBufferSize());
+}
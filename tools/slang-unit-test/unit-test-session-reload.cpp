@@ -0,0 +1,130 @@
+// unit-test-session-reload.cpp
+
+#include "../../source/core/slang-blob.h"
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+// Test that reloading a module unloads the modules that import it, keeps every other
+// module, and that programs composed again use the new version.
+SLANG_UNIT_TEST(sessionReload)
+{
+    const char* libSource = R"(
+        public float getValue() { return 1.0; }
+        )";
+    const char* newLibSource = R"(
+        public float getValue() { return 4.0; }
+        )";
+    const char* unrelatedSource = R"(
+        public float getOther() { return 3.0; }
+        )";
+    const char* mainSource = R"(
+        import lib;
+
+        RWStructuredBuffer<float> outputBuffer;
+
+        [shader("compute")]
+        [numthreads(4,1,1)]
+        void computeMain(uint3 threadId : SV_DispatchThreadID)
+        {
+            outputBuffer[threadId.x] = getValue();
+        }
+        )";
+
+    auto globalSession = unitTestContext->slangGlobalSession;
+
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("sm_5_0");
+
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+
+    ComPtr<slang::ISession> session;
+    SLANG_CHECK_ABORT(
+        SLANG_SUCCEEDED(globalSession->createSession(sessionDesc, session.writeRef())));
+
+    ComPtr<slang::ISessionReload_Experimental> sessionReload;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(session->queryInterface(
+        slang::ISessionReload_Experimental::getTypeGuid(),
+        (void**)sessionReload.writeRef())));
+
+    ComPtr<slang::IBlob> diagnosticBlob;
+    auto lib = session->loadModuleFromSourceString(
+        "lib",
+        "lib.slang",
+        libSource,
+        diagnosticBlob.writeRef());
+    SLANG_CHECK_ABORT(lib != nullptr);
+    auto unrelated = session->loadModuleFromSourceString(
+        "unrelated",
+        "unrelated.slang",
+        unrelatedSource,
+        diagnosticBlob.writeRef());
+    SLANG_CHECK_ABORT(unrelated != nullptr);
+
+    auto getCode = [&](slang::IModule* module, ISlangBlob** outCode)
+    {
+        ComPtr<slang::IEntryPoint> entryPoint;
+        SLANG_CHECK_ABORT(
+            SLANG_SUCCEEDED(module->findEntryPointByName("computeMain", entryPoint.writeRef())));
+
+        slang::IComponentType* components[] = {module, entryPoint.get()};
+        ComPtr<slang::IComponentType> program;
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(
+            session->createCompositeComponentType(components, 2, program.writeRef())));
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(program->getEntryPointCode(0, 0, outCode)));
+    };
+
+    auto main = session->loadModuleFromSourceString(
+        "main",
+        "main.slang",
+        mainSource,
+        diagnosticBlob.writeRef());
+    SLANG_CHECK_ABORT(main != nullptr);
+    ComPtr<ISlangBlob> code;
+    getCode(main, code.writeRef());
+
+    auto isLoaded = [&](slang::IModule* module)
+    {
+        for (SlangInt i = 0; i < session->getLoadedModuleCount(); ++i)
+        {
+            if (session->getLoadedModule(i) == module)
+                return true;
+        }
+        return false;
+    };
+    const SlangInt loadedModuleCount = session->getLoadedModuleCount();
+
+    // The unloaded modules are kept alive, so that their addresses aren't reused.
+    ComPtr<slang::IModule> previousLib(lib);
+    ComPtr<slang::IModule> previousMain(main);
+
+    // `main` imports `lib`, and so is unloaded with it, while `unrelated` is kept.
+    auto newLibBlob = StringBlob::create(UnownedStringSlice(newLibSource));
+    auto newLib = sessionReload->reloadModule("lib", newLibBlob, diagnosticBlob.writeRef());
+    SLANG_CHECK_ABORT(newLib != nullptr);
+    SLANG_CHECK(newLib != lib);
+    SLANG_CHECK(isLoaded(newLib));
+    SLANG_CHECK(isLoaded(unrelated));
+    SLANG_CHECK(!isLoaded(main));
+    SLANG_CHECK(session->getLoadedModuleCount() == loadedModuleCount - 1);
+
+    // Loading `main` again imports the new version of `lib`.
+    auto newMain = session->loadModuleFromSourceString(
+        "main",
+        "main.slang",
+        mainSource,
+        diagnosticBlob.writeRef());
+    SLANG_CHECK_ABORT(newMain != nullptr);
+    ComPtr<ISlangBlob> newCode;
+    getCode(newMain, newCode.writeRef());
+
+    UnownedStringSlice text(
+        (const char*)newCode->getBufferPointer(),
+        newCode->getBufferSize());
+    SLANG_CHECK(text.indexOf(UnownedStringSlice("4.0")) != -1);
+}
@@ -0,0 +1,64 @@
+// unit-test-shared-core-module.cpp
+
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+using namespace Slang;
+
+static SlangResult _compileWithNewGlobalSession()
+{
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_RETURN_ON_FAIL(slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()));
+
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("sm_5_0");
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+
+    ComPtr<slang::ISession> session;
+    SLANG_RETURN_ON_FAIL(globalSession->createSession(sessionDesc, session.writeRef()));
+
+    ComPtr<slang::IBlob> diagnosticBlob;
+    auto module = session->loadModuleFromSourceString(
+        "m",
+        "m.slang",
+        R"(
+        [shader("compute")]
+        [numthreads(1,1,1)]
+        void computeMain(uniform RWStructuredBuffer<float> buffer)
+        {
+            buffer[0] = sqrt(buffer[1]);
+        })",
+        diagnosticBlob.writeRef());
+    if (!module)
+        return SLANG_FAIL;
+
+    ComPtr<slang::IEntryPoint> entryPoint;
+    SLANG_RETURN_ON_FAIL(module->findEntryPointByName("computeMain", entryPoint.writeRef()));
+
+    slang::IComponentType* components[] = {module, entryPoint.get()};
+    ComPtr<slang::IComponentType> composedProgram;
+    SLANG_RETURN_ON_FAIL(
+        session->createCompositeComponentType(components, 2, composedProgram.writeRef()));
+
+    ComPtr<slang::IComponentType> linkedProgram;
+    SLANG_RETURN_ON_FAIL(composedProgram->link(linkedProgram.writeRef()));
+
+    ComPtr<slang::IBlob> code;
+    SLANG_RETURN_ON_FAIL(linkedProgram->getEntryPointCode(0, 0, code.writeRef()));
+    return code && code->getBufferSize() != 0 ? SLANG_OK : SLANG_FAIL;
+}
+
+// Test that global sessions created one after another in the same process, which
+// may share the extracted core module, can each compile code using the core module.
+SLANG_UNIT_TEST(sharedCoreModule)
+{
+    SLANG_CHECK(SLANG_SUCCEEDED(_compileWithNewGlobalSession()));
+    SLANG_CHECK(SLANG_SUCCEEDED(_compileWithNewGlobalSession()));
+}
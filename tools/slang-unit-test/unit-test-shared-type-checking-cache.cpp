@@ -0,0 +1,50 @@
+// unit-test-shared-type-checking-cache.cpp
+
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+using namespace Slang;
+
+static bool _checkModuleInNewSession(slang::IGlobalSession* globalSession, const char* source)
+{
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("sm_5_0");
+
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+
+    ComPtr<slang::ISession> session;
+    if (SLANG_FAILED(globalSession->createSession(sessionDesc, session.writeRef())))
+        return false;
+
+    ComPtr<slang::IBlob> diagnosticBlob;
+    auto module =
+        session->loadModuleFromSourceString("m", "m.slang", source, diagnosticBlob.writeRef());
+    return module != nullptr;
+}
+
+// Test that operator overloads resolved in one session are resolved the same way, and
+// diagnosed the same way, in a later session of the same global session.
+SLANG_UNIT_TEST(sharedTypeCheckingCache)
+{
+    const char* validSource = R"(
+        float3 f(float3 a, float3 b, int i) { return a * b + float3(i) - a / 2.0; }
+        )";
+    const char* invalidSource = R"(
+        struct S {}
+        float3 f(float3 a, S s) { return a + s; }
+        )";
+
+    auto globalSession = unitTestContext->slangGlobalSession;
+
+    SLANG_CHECK(_checkModuleInNewSession(globalSession, validSource));
+    SLANG_CHECK(_checkModuleInNewSession(globalSession, validSource));
+    SLANG_CHECK(!_checkModuleInNewSession(globalSession, invalidSource));
+    SLANG_CHECK(!_checkModuleInNewSession(globalSession, invalidSource));
+}
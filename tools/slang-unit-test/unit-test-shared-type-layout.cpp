@@ -0,0 +1,107 @@
+// unit-test-shared-type-layout.cpp
+
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+using namespace Slang;
+
+static slang::TypeLayoutReflection* _getLightTypeLayout(
+    slang::ISession* session,
+    slang::IModule* module,
+    const char* entryPointName,
+    ComPtr<slang::IComponentType>& outProgram)
+{
+    ComPtr<slang::IEntryPoint> entryPoint;
+    if (SLANG_FAILED(module->findEntryPointByName(entryPointName, entryPoint.writeRef())))
+        return nullptr;
+
+    slang::IComponentType* components[] = {module, entryPoint.get()};
+    if (SLANG_FAILED(session->createCompositeComponentType(components, 2, outProgram.writeRef())))
+        return nullptr;
+
+    ComPtr<slang::IBlob> diagnosticBlob;
+    auto layout = outProgram->getLayout(0, diagnosticBlob.writeRef());
+    if (!layout || layout->getParameterCount() != 2)
+        return nullptr;
+
+    auto sceneTypeLayout = layout->getParameterByIndex(0)->getTypeLayout();
+    auto light = sceneTypeLayout->getFieldByIndex(1);
+    if (!light || UnownedStringSlice(light->getName()) != "light")
+        return nullptr;
+    return light->getTypeLayout();
+}
+
+// Test that programs laid out for the same target share the layouts of the `struct` types
+// they have in common.
+SLANG_UNIT_TEST(sharedTypeLayout)
+{
+    const char* userSource = R"(
+        struct Light
+        {
+            float3 direction;
+            float intensity;
+            float4x4 shadowMatrix;
+        };
+
+        struct Scene
+        {
+            float4 ambient;
+            Light light;
+        };
+
+        uniform Scene scene;
+        RWStructuredBuffer<float4> outputBuffer;
+
+        [shader("compute")]
+        [numthreads(1,1,1)]
+        void ambientMain()
+        {
+            outputBuffer[0] = scene.ambient;
+        }
+
+        [shader("compute")]
+        [numthreads(1,1,1)]
+        void lightMain()
+        {
+            outputBuffer[0] = float4(scene.light.direction * scene.light.intensity, 1);
+        }
+        )";
+
+    auto globalSession = unitTestContext->slangGlobalSession;
+
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("sm_5_0");
+
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+
+    ComPtr<slang::ISession> session;
+    SLANG_CHECK_ABORT(
+        SLANG_SUCCEEDED(globalSession->createSession(sessionDesc, session.writeRef())));
+
+    ComPtr<slang::IBlob> diagnosticBlob;
+    auto module = session->loadModuleFromSourceString(
+        "m",
+        "m.slang",
+        userSource,
+        diagnosticBlob.writeRef());
+    SLANG_CHECK_ABORT(module != nullptr);
+
+    ComPtr<slang::IComponentType> ambientProgram;
+    ComPtr<slang::IComponentType> lightProgram;
+    auto ambientLight = _getLightTypeLayout(session, module, "ambientMain", ambientProgram);
+    auto lightLight = _getLightTypeLayout(session, module, "lightMain", lightProgram);
+    SLANG_CHECK_ABORT(ambientLight != nullptr);
+    SLANG_CHECK_ABORT(lightLight != nullptr);
+    SLANG_CHECK(ambientLight == lightLight);
+
+    SLANG_CHECK(ambientLight->getSize() == 80);
+    SLANG_CHECK(ambientLight->getFieldByIndex(1)->getOffset() == 12);
+    SLANG_CHECK(ambientLight->getFieldByIndex(2)->getOffset() == 16);
+}
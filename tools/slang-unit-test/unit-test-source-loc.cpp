@@ -0,0 +1,64 @@
+// unit-test-source-loc.cpp
+
+#include "../../source/compiler-core/slang-source-loc.h"
+#include "unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+SLANG_UNIT_TEST(sourceLocFindView)
+{
+    SourceManager sourceManager;
+    sourceManager.initialize(nullptr, nullptr);
+
+    // Views small enough for many to share a page, views larger than a page, and
+    // locations allocated without a view in between.
+    List<SourceView*> views;
+    for (Index i = 0; i < 200; ++i)
+    {
+        const Index size = (i % 7 == 0) ? 10000 + i : 1 + (i * 37) % 300;
+        StringBuilder content;
+        for (Index j = 0; j < size; ++j)
+            content.appendChar((j % 40 == 39) ? '\n' : 'a');
+
+        SourceFile* sourceFile =
+            sourceManager.createSourceFileWithString(PathInfo::makeUnknown(), content);
+        views.add(sourceManager.createSourceView(sourceFile, nullptr, SourceLoc()));
+
+        if (i % 11 == 0)
+            sourceManager.allocateSourceRange(5000);
+    }
+
+    for (Index i = 0; i < views.getCount(); ++i)
+    {
+        const SourceRange range = views[i]->getRange();
+        SLANG_CHECK(sourceManager.findSourceView(range.begin) == views[i]);
+        SLANG_CHECK(sourceManager.findSourceView(range.end) == views[i]);
+        SLANG_CHECK(
+            sourceManager.findSourceView(range.begin + (range.getSize() / 2)) == views[i]);
+
+        // The location after a view is either the start of the next view or unused
+        SourceView* nextView = sourceManager.findSourceView(range.end + 1);
+        SLANG_CHECK(nextView == nullptr || (i + 1 < views.getCount() && nextView == views[i + 1]));
+    }
+
+    SLANG_CHECK(sourceManager.findSourceView(SourceLoc()) == nullptr);
+    SLANG_CHECK(sourceManager.findSourceView(sourceManager.getNextRangeStart()) == nullptr);
+}
+
+SLANG_UNIT_TEST(sourceLocLineIndex)
+{
+    SourceManager sourceManager;
+    sourceManager.initialize(nullptr, nullptr);
+
+    SourceFile* sourceFile = sourceManager.createSourceFileWithString(
+        PathInfo::makeUnknown(),
+        "first\nsecond\n\nfourth\nlast");
+
+    // Lookups in order, repeated, and out of order must all agree with the line contents.
+    const int offsets[] = {0, 3, 5, 6, 12, 13, 14, 20, 21, 25, 2, 14, 6, 25, 0};
+    const int lines[] = {0, 0, 0, 1, 1, 2, 3, 3, 4, 4, 0, 3, 1, 4, 0};
+    for (Index i = 0; i < SLANG_COUNT_OF(offsets); ++i)
+    {
+        SLANG_CHECK(sourceFile->calcLineIndexFromOffset(offsets[i]) == lines[i]);
+    }
+}
@@ -0,0 +1,102 @@
+// unit-test-specialization-cache.cpp
+
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+using namespace Slang;
+
+static String _getEntryPointSource(slang::IComponentType* program, SlangInt entryPointIndex)
+{
+    ComPtr<slang::IBlob> code;
+    ComPtr<slang::IBlob> diagnosticBlob;
+    if (SLANG_FAILED(program->getEntryPointCode(
+            entryPointIndex,
+            0,
+            code.writeRef(),
+            diagnosticBlob.writeRef())))
+        return String();
+    return String(
+        UnownedStringSlice((const char*)code->getBufferPointer(), code->getBufferSize()));
+}
+
+// Test that entry points of a program that are compiled separately, and so can reuse
+// each other's specializations of a generic function, get correct code.
+SLANG_UNIT_TEST(specializationCache)
+{
+    const char* userSource = R"(
+        interface IMaterial { float eval(float x); }
+        struct Diffuse : IMaterial { float eval(float x) { return x * 0.5; } }
+
+        float shadeWith<T : IMaterial>(T material, float x) { return material.eval(x) + 1.0; }
+
+        RWStructuredBuffer<float> buffer;
+
+        [shader("compute")]
+        [numthreads(1,1,1)]
+        void computeMainA()
+        {
+            Diffuse material;
+            buffer[0] = shadeWith(material, buffer[1]);
+        }
+
+        [shader("compute")]
+        [numthreads(1,1,1)]
+        void computeMainB()
+        {
+            Diffuse material;
+            buffer[2] = shadeWith(material, buffer[3]);
+        }
+        )";
+
+    auto globalSession = unitTestContext->slangGlobalSession;
+
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("sm_5_0");
+
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+
+    ComPtr<slang::ISession> session;
+    SLANG_CHECK_ABORT(
+        SLANG_SUCCEEDED(globalSession->createSession(sessionDesc, session.writeRef())));
+
+    ComPtr<slang::IBlob> diagnosticBlob;
+    auto module = session->loadModuleFromSourceString(
+        "m",
+        "m.slang",
+        userSource,
+        diagnosticBlob.writeRef());
+    SLANG_CHECK_ABORT(module != nullptr);
+
+    ComPtr<slang::IEntryPoint> entryPointA;
+    SLANG_CHECK_ABORT(
+        SLANG_SUCCEEDED(module->findEntryPointByName("computeMainA", entryPointA.writeRef())));
+    ComPtr<slang::IEntryPoint> entryPointB;
+    SLANG_CHECK_ABORT(
+        SLANG_SUCCEEDED(module->findEntryPointByName("computeMainB", entryPointB.writeRef())));
+
+    slang::IComponentType* components[] = {module, entryPointA.get(), entryPointB.get()};
+    ComPtr<slang::IComponentType> composedProgram;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(
+        session->createCompositeComponentType(components, 3, composedProgram.writeRef())));
+
+    ComPtr<slang::IComponentType> linkedProgram;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(composedProgram->link(linkedProgram.writeRef())));
+
+    // The second entry point is compiled after `shadeWith<Diffuse>` has been
+    // specialized for the first one.
+    const String sourceA = _getEntryPointSource(linkedProgram, 0);
+    const String sourceB = _getEntryPointSource(linkedProgram, 1);
+
+    SLANG_CHECK(sourceA.indexOf("computeMainA") >= 0);
+    SLANG_CHECK(sourceA.indexOf("shadeWith") >= 0);
+    SLANG_CHECK(sourceB.indexOf("computeMainB") >= 0);
+    SLANG_CHECK(sourceB.indexOf("shadeWith") >= 0);
+    SLANG_CHECK(sourceB.indexOf("0.5") >= 0);
+}
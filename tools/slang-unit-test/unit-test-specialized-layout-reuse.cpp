@@ -0,0 +1,128 @@
+// unit-test-specialized-layout-reuse.cpp
+
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+using namespace Slang;
+
+// Test that laying out a specialization of a program reuses the type layouts of the parameters
+// that specialization doesn't change, and lays out the others again.
+SLANG_UNIT_TEST(specializedLayoutReuse)
+{
+    const char* userSource = R"(
+        interface ILight
+        {
+            float3 illuminate(float3 normal);
+        }
+
+        struct DirectionalLight : ILight
+        {
+            float3 direction;
+            float3 color;
+
+            float3 illuminate(float3 normal)
+            {
+                return color * saturate(dot(normal, direction));
+            }
+        };
+
+        struct Scene
+        {
+            float4x4 viewProj;
+            float4 ambient;
+        };
+
+        struct LightParams
+        {
+            ILight light;
+        };
+
+        ConstantBuffer<Scene> scene;
+        ConstantBuffer<LightParams> lightParams;
+        RWStructuredBuffer<float4> outputBuffer;
+
+        [shader("compute")]
+        [numthreads(4,1,1)]
+        void computeMain(uint3 threadId : SV_DispatchThreadID)
+        {
+            float3 lit = lightParams.light.illuminate(float3(0, 1, 0));
+            outputBuffer[threadId.x] = scene.ambient + float4(lit, 0);
+        }
+        )";
+
+    auto globalSession = unitTestContext->slangGlobalSession;
+
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("sm_5_0");
+
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+
+    ComPtr<slang::ISession> session;
+    SLANG_CHECK_ABORT(
+        SLANG_SUCCEEDED(globalSession->createSession(sessionDesc, session.writeRef())));
+
+    ComPtr<slang::IBlob> diagnosticBlob;
+    auto module = session->loadModuleFromSourceString(
+        "m",
+        "m.slang",
+        userSource,
+        diagnosticBlob.writeRef());
+    SLANG_CHECK_ABORT(module != nullptr);
+
+    ComPtr<slang::IEntryPoint> entryPoint;
+    SLANG_CHECK_ABORT(
+        SLANG_SUCCEEDED(module->findEntryPointByName("computeMain", entryPoint.writeRef())));
+
+    slang::IComponentType* components[] = {module, entryPoint.get()};
+    ComPtr<slang::IComponentType> composedProgram;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(
+        session->createCompositeComponentType(components, 2, composedProgram.writeRef())));
+
+    // Lay out the unspecialized program first, as an application reflecting over its
+    // specialization parameters would.
+    auto baseLayout = composedProgram->getLayout(0, diagnosticBlob.writeRef());
+    SLANG_CHECK_ABORT(baseLayout != nullptr);
+    SLANG_CHECK_ABORT(baseLayout->getParameterCount() == 3);
+
+    auto lightType = baseLayout->findTypeByName("DirectionalLight");
+    SLANG_CHECK_ABORT(lightType != nullptr);
+
+    slang::SpecializationArg specializationArg = slang::SpecializationArg::fromType(lightType);
+    ComPtr<slang::IComponentType> specializedProgram;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(composedProgram->specialize(
+        &specializationArg,
+        1,
+        specializedProgram.writeRef(),
+        diagnosticBlob.writeRef())));
+
+    auto specializedLayout = specializedProgram->getLayout(0, diagnosticBlob.writeRef());
+    SLANG_CHECK_ABORT(specializedLayout != nullptr);
+    SLANG_CHECK_ABORT(specializedLayout->getParameterCount() == 3);
+
+    for (unsigned i = 0; i < 3; ++i)
+    {
+        auto baseParam = baseLayout->getParameterByIndex(i);
+        auto specializedParam = specializedLayout->getParameterByIndex(i);
+        SLANG_CHECK(strcmp(baseParam->getName(), specializedParam->getName()) == 0);
+
+        // Only `lightParams` has a type plugged into it by specialization.
+        const bool isSpecialized = strcmp(baseParam->getName(), "lightParams") == 0;
+        SLANG_CHECK(
+            (baseParam->getTypeLayout() == specializedParam->getTypeLayout()) != isSpecialized);
+
+        // The bindings are allocated for each program, and are the same for both.
+        auto category = baseParam->getCategory();
+        SLANG_CHECK(specializedParam->getCategory() == category);
+        SLANG_CHECK(specializedParam->getOffset(category) == baseParam->getOffset(category));
+        SLANG_CHECK(
+            specializedParam->getBindingSpace(category) == baseParam->getBindingSpace(category));
+    }
+}
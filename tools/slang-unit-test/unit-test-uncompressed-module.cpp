@@ -0,0 +1,90 @@
+// unit-test-uncompressed-module.cpp
+
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+using namespace Slang;
+
+static SlangResult _createSession(
+    slang::IGlobalSession* globalSession,
+    bool compressed,
+    slang::ISession** outSession)
+{
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("sm_5_0");
+
+    slang::CompilerOptionEntry compilerOptionEntry = {};
+    compilerOptionEntry.name = slang::CompilerOptionName::IrCompression;
+    compilerOptionEntry.value.kind = slang::CompilerOptionValueKind::Int;
+    compilerOptionEntry.value.intValue0 = 0;
+
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+    if (!compressed)
+    {
+        sessionDesc.compilerOptionEntryCount = 1;
+        sessionDesc.compilerOptionEntries = &compilerOptionEntry;
+    }
+    return globalSession->createSession(sessionDesc, outSession);
+}
+
+static ComPtr<slang::IBlob> _serializeModule(slang::IGlobalSession* globalSession, bool compressed)
+{
+    const char* moduleSource = R"(
+        public float4 shade(float4 color, float scale)
+        {
+            return lerp(color, color * scale, 0.5) + float4(1, 2, 3, 4);
+        }
+        )";
+
+    ComPtr<slang::IBlob> moduleBlob;
+
+    ComPtr<slang::ISession> session;
+    if (SLANG_FAILED(_createSession(globalSession, compressed, session.writeRef())))
+        return moduleBlob;
+
+    ComPtr<slang::IBlob> diagnosticBlob;
+    auto module = session->loadModuleFromSourceString(
+        "uncompressedModule",
+        "uncompressedModule.slang",
+        moduleSource,
+        diagnosticBlob.writeRef());
+    if (!module)
+        return moduleBlob;
+
+    module->serialize(moduleBlob.writeRef());
+    return moduleBlob;
+}
+
+// Test that a module serialized without compression can be loaded back.
+SLANG_UNIT_TEST(uncompressedModule)
+{
+    auto globalSession = unitTestContext->slangGlobalSession;
+
+    auto compressedBlob = _serializeModule(globalSession, true);
+    auto uncompressedBlob = _serializeModule(globalSession, false);
+    SLANG_CHECK_ABORT(compressedBlob && uncompressedBlob);
+
+    // Not compressing the IR and AST makes the module larger.
+    SLANG_CHECK(uncompressedBlob->getBufferSize() > compressedBlob->getBufferSize());
+
+    ComPtr<slang::ISession> session;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(_createSession(globalSession, true, session.writeRef())));
+
+    ComPtr<slang::IBlob> diagnosticBlob;
+    auto module = session->loadModuleFromIRBlob(
+        "uncompressedModule",
+        "uncompressedModule.slang-module",
+        uncompressedBlob,
+        diagnosticBlob.writeRef());
+    SLANG_CHECK_ABORT(module != nullptr);
+
+    ComPtr<slang::IBlob> reserializedBlob;
+    SLANG_CHECK(SLANG_SUCCEEDED(module->serialize(reserializedBlob.writeRef())));
+}
@@ -521,6 +521,10 @@ SlangResult TestServer::_executeTool(const JSONRPCCall& call)
 
 SlangResult TestServer::execute()
 {
+    // Create the session, and so load the core module, before the first test arrives. The session
+    // is then shared by every test this server runs.
+    getOrCreateGlobalSession();
+
     while (m_connection->isActive() && !m_quit)
     {
         // Failure doesn't make the execution terminate
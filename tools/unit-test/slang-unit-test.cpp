@@ -3,6 +3,8 @@
 #include "core/slang-basic.h"
 #include "slang.h"
 
+#include <stdio.h>
+
 struct SlangUnitTest
 {
     const char* name;
@@ -53,6 +55,22 @@ extern "C"
     }
 }
 
+void reportUnitBenchmark(const char* name, SlangInt operationCount, double seconds)
+{
+    const double nanoseconds = seconds * 1e9 / double(operationCount > 0 ? operationCount : 1);
+    const double operationsPerSecond = seconds > 0 ? double(operationCount) / seconds : 0;
+
+    char buffer[256];
+    snprintf(
+        buffer,
+        sizeof(buffer),
+        "%-40s %12.1f ns/op %14.0f op/s\n",
+        name,
+        nanoseconds,
+        operationsPerSecond);
+    getTestReporter()->message(TestMessageType::Info, buffer);
+}
+
 UnitTestRegisterHelper::UnitTestRegisterHelper(const char* name, UnitTestFunc testFunc)
 {
     _getTestModule()->tests.add(SlangUnitTest{name, testFunc});
@@ -3,6 +3,8 @@
 #include "core/slang-render-api-util.h"
 #include "slang.h"
 
+#include <chrono>
+
 enum class TestResult
 {
     // NOTE! Must keep in order such that combine is meaningful. That is larger values are higher
@@ -84,6 +86,53 @@ typedef IUnitTestModule* (*UnitTestGetModuleFunc)();
     UnitTestRegisterHelper _##name##RegisterHelper(#name, name); \
     void _##name##_impl(UnitTestContext* unitTestContext)
 
+/// Benchmarks are unit tests that measure how fast something is, rather than check it is
+/// correct. Their names start with this prefix, and they are only run, in process, when
+/// slang-test is given `-bench`.
+static const char kUnitBenchmarkPrefix[] = "bench-";
+
+#define SLANG_UNIT_BENCHMARK(name)                                        \
+    void _##name##_impl(UnitTestContext* unitTestContext);                \
+    void name(UnitTestContext* unitTestContext)                           \
+    {                                                                     \
+        try                                                               \
+        {                                                                 \
+            _##name##_impl(unitTestContext);                              \
+        }                                                                 \
+        catch (AbortTestException&)                                       \
+        {                                                                 \
+        }                                                                 \
+    }                                                                     \
+    UnitTestRegisterHelper _##name##RegisterHelper("bench-" #name, name); \
+    void _##name##_impl(UnitTestContext* unitTestContext)
+
+/// Report that `operationCount` operations of the benchmark `name` took `seconds`.
+void reportUnitBenchmark(const char* name, SlangInt operationCount, double seconds);
+
+/// Call `func`, which performs `operationsPerCall` operations, until enough time has passed
+/// for a stable measurement, and report the time per operation.
+template<typename F>
+void runUnitBenchmark(const char* name, SlangInt operationsPerCall, const F& func)
+{
+    using Clock = std::chrono::steady_clock;
+    const double kMinSeconds = 0.25;
+
+    // Warm up caches and the allocator
+    func();
+
+    SlangInt callCount = 0;
+    double seconds = 0;
+    const auto start = Clock::now();
+    do
+    {
+        func();
+        callCount++;
+        seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    } while (seconds < kMinSeconds);
+
+    reportUnitBenchmark(name, callCount * operationsPerCall, seconds);
+}
+
 #define SLANG_CHECK(x) getTestReporter()->addResultWithLocation((x), #x, __FILE__, __LINE__);
 #define SLANG_CHECK_ABORT(x)                                                                   \
     {                                                                                          \